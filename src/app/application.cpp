@@ -90,6 +90,7 @@ namespace lfs::app {
                 .antialiasing = false,
                 .enable_cuda_interop = true,
                 .gut = params->optimization.gut,
+                .persist_thumbnails = params->optimization.persist_thumbnails,
             });
 
             viewer->setParameters(*params);
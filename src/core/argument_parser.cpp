@@ -6,6 +6,7 @@
 #include "core/logger.hpp"
 #include "core/parameters.hpp"
 #include "core/path_utils.hpp"
+#include "core/perf_trace.hpp"
 #include <algorithm>
 #include <args.hxx>
 #include <array>
@@ -63,6 +64,19 @@ namespace {
         return lfs::core::LogLevel::Info; // Default
     }
 
+    // Record from now on and write the Chrome trace at exit
+    void start_tracing(const std::string& path_str) {
+#if LFS_PERF_TRACING
+        const std::filesystem::path path = lfs::core::utf8_to_path(path_str);
+        lfs::core::trace::set_output(path);
+        lfs::core::trace::set_thread_name("main");
+        lfs::core::trace::start();
+        LOG_INFO("Performance trace will be written to {}", lfs::core::path_to_utf8(path));
+#else
+        LOG_WARN("--trace-out {} ignored: built with ENABLE_PERF_TRACING=OFF", path_str);
+#endif
+    }
+
     std::expected<std::tuple<ParseResult, std::function<void()>>, std::string> parse_arguments(
         const std::vector<std::string>& args,
         lfs::core::param::TrainingParameters& params) {
@@ -119,6 +133,7 @@ namespace {
             ::args::ValueFlag<std::string> log_level(parser, "level", "Log level: trace, debug, info, perf, warn, error, critical, off (default: info)", {"log-level"});
             ::args::ValueFlag<std::string> log_file(parser, "file", "Optional log file path", {"log-file"});
             ::args::ValueFlag<std::string> log_filter(parser, "pattern", "Filter log messages (glob: *foo*, regex: \\\\d+)", {"log-filter"});
+            ::args::ValueFlag<std::string> trace_out(parser, "file", "Record a performance trace and write it as Chrome trace JSON at exit", {"trace-out"});
 
             // Optional flag arguments
             ::args::Flag enable_mip(parser, "enable_mip", "Enable mip filter (anti-aliasing)", {"enable-mip"});
@@ -127,6 +142,7 @@ namespace {
             ::args::Flag headless(parser, "headless", "Disable visualization during training", {"headless"});
             ::args::Flag no_splash(parser, "no_splash", "Skip splash screen on startup", {"no-splash"});
             ::args::Flag no_interop(parser, "no_interop", "Disable CUDA-GL interop (use CPU fallback for display)", {"no-interop"});
+            ::args::Flag persist_thumbnails(parser, "persist_thumbnails", "Keep image preview thumbnails on disk between sessions", {"persist-thumbnails"});
             ::args::Flag enable_save_eval_images(parser, "save_eval_images", "Save eval images and depth maps", {"save-eval-images"});
             ::args::Flag save_depth(parser, "save_depth", "Save depth maps during training", {"save-depth"});
             ::args::Flag bg_modulation(parser, "bg_modulation", "Enable sinusoidal background modulation mixed with base background", {"bg-modulation"});
@@ -206,6 +222,10 @@ namespace {
                 }
             }
 
+            if (trace_out) {
+                start_tracing(::args::get(trace_out));
+            }
+
             // Check if explicitly displaying help
             if (help) {
                 return std::make_tuple(ParseResult::Help, std::function<void()>{});
@@ -406,6 +426,7 @@ namespace {
                                         headless_flag = bool(headless),
                                         no_splash_flag = bool(no_splash),
                                         no_interop_flag = bool(no_interop),
+                                        persist_thumbnails_flag = bool(persist_thumbnails),
                                         enable_save_eval_images_flag = bool(enable_save_eval_images),
                                         bg_modulation_flag = bool(bg_modulation),
                                         random_flag = bool(random),
@@ -458,6 +479,7 @@ namespace {
                 setFlag(headless_flag, opt.headless);
                 setFlag(no_splash_flag, opt.no_splash);
                 setFlag(no_interop_flag, opt.no_interop);
+                setFlag(persist_thumbnails_flag, opt.persist_thumbnails);
                 setFlag(enable_save_eval_images_flag, opt.enable_save_eval_images);
                 setFlag(bg_modulation_flag, opt.bg_modulation);
                 setFlag(random_flag, opt.random);
@@ -569,6 +591,8 @@ namespace {
         "  LichtFeld-Studio convert input.ply output.spz --sh-degree 0\n"
         "  LichtFeld-Studio convert input.ply -f html\n"
         "  LichtFeld-Studio convert ./splats/ -f sog --sh-degree 2\n"
+        "  LichtFeld-Studio convert ./splats/ ./out/ -f spz --jobs 8 -y\n"
+        "  LichtFeld-Studio convert ./splats/ ./out/ -f sog --cpu --writers 4\n"
         "\n"
         "SUPPORTED FORMATS:\n"
         "  Input:  .ply, .sog, .spz, .resume (checkpoint)\n"
@@ -622,6 +646,10 @@ lfs::core::args::parse_args(const int argc, const char* const argv[]) {
     ::args::ValueFlag<std::string> format(parser, "format", "Output format: ply, sog, spz, html", {'f', "format"});
     ::args::ValueFlag<int> sog_iter(parser, "iterations", "K-means iterations for SOG (default: 10)", {"sog-iterations"});
     ::args::Flag overwrite(parser, "overwrite", "Overwrite existing files without prompting", {'y', "overwrite"});
+    ::args::ValueFlag<int> jobs(parser, "jobs", "Files to convert concurrently (default: hardware threads)", {'j', "jobs"});
+    ::args::ValueFlag<int> writers(parser, "writers", "Files written concurrently (default: jobs, at most 2 for GPU SOG/HTML)", {"writers"});
+    ::args::Flag cpu(parser, "cpu", "Encode SOG/HTML on the CPU instead of the GPU", {"cpu"});
+    ::args::ValueFlag<std::string> trace_out(parser, "file", "Record a performance trace and write it as Chrome trace JSON at exit", {"trace-out"});
 
     std::vector<std::string> args_vec(argv + 1, argv + argc);
     args_vec[0] = std::string(argv[0]) + " convert";
@@ -640,6 +668,10 @@ lfs::core::args::parse_args(const int argc, const char* const argv[]) {
         return std::unexpected(std::format("Missing input path\n\n{}", parser.Help()));
     }
 
+    if (trace_out) {
+        start_tracing(::args::get(trace_out));
+    }
+
     param::ConvertParameters params;
     params.input_path = lfs::core::utf8_to_path(::args::get(input));
     params.sh_degree = sh_degree ? ::args::get(sh_degree) : -1;
@@ -657,6 +689,19 @@ lfs::core::args::parse_args(const int argc, const char* const argv[]) {
     if (sog_iter)
         params.sog_iterations = ::args::get(sog_iter);
     params.overwrite = overwrite;
+    if (jobs) {
+        params.jobs = ::args::get(jobs);
+        if (params.jobs < 1) {
+            return std::unexpected("--jobs must be at least 1");
+        }
+    }
+    if (writers) {
+        params.writers = ::args::get(writers);
+        if (params.writers < 1) {
+            return std::unexpected("--writers must be at least 1");
+        }
+    }
+    params.use_gpu = !cpu;
 
     if (format) {
         if (const auto fmt = parseFormat(::args::get(format))) {
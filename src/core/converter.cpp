@@ -8,15 +8,31 @@
 #include "core/splat_data.hpp"
 #include "io/exporter.hpp"
 #include "io/loader.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cuda_runtime.h>
+#include <deque>
+#include <exception>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <print>
+#include <set>
+#include <thread>
 
 namespace lfs::core {
 
     namespace {
 
         constexpr size_t SH_CHANNELS = 3;
+        // Decoded splats held between load and write across all workers. A file larger
+        // than the budget still runs, alone.
+        constexpr size_t CONVERT_MEMORY_BUDGET = 8ULL << 30;
+        // Each SOG/HTML writer runs k-means on the GPU; more than two only contend for it
+        constexpr size_t MAX_GPU_WRITERS = 2;
         constexpr const char* VALID_EXTENSIONS[] = {".ply", ".sog", ".spz", ".resume"};
 
         enum class OverwriteChoice { YES,
@@ -112,80 +128,389 @@ namespace lfs::core {
             return out.is_absolute() ? out : cwd / out;
         }
 
-        bool convertFile(
-            const std::filesystem::path& input,
-            const std::filesystem::path& output,
-            const param::ConvertParameters& params) {
+        using Clock = std::chrono::steady_clock;
+
+        double elapsed_ms(const Clock::time_point from, const Clock::time_point to = Clock::now()) {
+            return std::chrono::duration<double, std::milli>(to - from).count();
+        }
 
-            std::println("Converting: {} -> {}", lfs::core::path_to_utf8(input), lfs::core::path_to_utf8(output));
+        // Decoded size guess made before loading, from the on-disk size
+        size_t estimateLoadedBytes(const std::filesystem::path& path) {
+            std::error_code ec;
+            const auto file_size = static_cast<size_t>(std::filesystem::file_size(path, ec));
+            if (ec)
+                return 0;
+            const auto ext = path.extension().string();
+            if (ext == ".spz" || ext == ".sog")
+                return file_size * 10; // Quantized and entropy coded
+            return file_size;
+        }
 
-            const auto loader = lfs::io::Loader::create();
-            auto load_result = loader->load(input);
-            if (!load_result) {
-                LOG_ERROR("Load failed: {}", load_result.error().format());
-                std::println(stderr, "  Error: {}", load_result.error().message);
-                return false;
+        size_t splatBytes(const SplatData& splat) {
+            size_t bytes = 0;
+            for (const Tensor* t : {&splat.means_raw(), &splat.sh0_raw(), &splat.shN_raw(),
+                                    &splat.scaling_raw(), &splat.rotation_raw(), &splat.opacity_raw()}) {
+                if (t->is_valid())
+                    bytes += t->bytes();
             }
+            return bytes;
+        }
 
-            auto* splat_ptr = std::get_if<std::shared_ptr<SplatData>>(&load_result->data);
-            if (!splat_ptr || !*splat_ptr) {
-                LOG_ERROR("Not a splat file: {}", lfs::core::path_to_utf8(input));
-                std::println(stderr, "  Error: not a splat file");
-                return false;
+        /**
+         * @brief Byte budget for loaded splats; loaders wait here for writers to catch up
+         */
+        class MemoryBudget {
+        public:
+            explicit MemoryBudget(const size_t limit) : limit_(limit) {}
+
+            void acquire(const size_t bytes) {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [&] { return in_use_ == 0 || in_use_ + bytes <= limit_; });
+                in_use_ += bytes;
             }
 
-            auto splat = std::move(*splat_ptr);
-            std::println("  Loaded {} gaussians, SH degree {}", splat->size(), splat->get_max_sh_degree());
+            // Correct a reservation once the real size is known; never blocks
+            void adjust(const size_t reserved, const size_t actual) {
+                std::lock_guard lock(mutex_);
+                in_use_ = in_use_ - reserved + actual;
+                if (actual < reserved)
+                    cv_.notify_all();
+            }
 
-            if (params.sh_degree >= 0 && params.sh_degree < splat->get_max_sh_degree()) {
-                truncateSHDegree(*splat, params.sh_degree);
-                std::println("  Truncated to SH degree {}", params.sh_degree);
+            void release(const size_t bytes) {
+                {
+                    std::lock_guard lock(mutex_);
+                    in_use_ -= bytes;
+                }
+                cv_.notify_all();
             }
 
-            lfs::io::Result<void> result;
+        private:
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            const size_t limit_;
+            size_t in_use_ = 0;
+        };
+
+        /**
+         * @brief Bounded MPMC queue; push blocks while full, pop returns nullopt once closed and drained
+         */
+        template <typename T>
+        class BoundedQueue {
+        public:
+            explicit BoundedQueue(const size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+            void push(T item) {
+                std::unique_lock lock(mutex_);
+                not_full_.wait(lock, [&] { return items_.size() < capacity_; });
+                items_.push_back(std::move(item));
+                not_empty_.notify_one();
+            }
+
+            std::optional<T> pop() {
+                std::unique_lock lock(mutex_);
+                not_empty_.wait(lock, [&] { return !items_.empty() || closed_; });
+                if (items_.empty())
+                    return std::nullopt;
+                T item = std::move(items_.front());
+                items_.pop_front();
+                not_full_.notify_one();
+                return item;
+            }
+
+            void close() {
+                std::lock_guard lock(mutex_);
+                closed_ = true;
+                not_empty_.notify_all();
+            }
+
+        private:
+            std::mutex mutex_;
+            std::condition_variable not_empty_;
+            std::condition_variable not_full_;
+            std::deque<T> items_;
+            const size_t capacity_;
+            bool closed_ = false;
+        };
+
+        struct ConvertJob {
+            std::filesystem::path input;
+            std::filesystem::path output;
+        };
+
+        struct FileStats {
+            bool ok = false;
+            size_t gaussians = 0;
+            uintmax_t input_bytes = 0;
+            uintmax_t output_bytes = 0;
+            double load_ms = 0.0;
+            double transform_ms = 0.0;
+            double queued_ms = 0.0; // Waiting for a free writer
+            double write_ms = 0.0;
+            double latency_ms = 0.0; // Load start to write end
+        };
+
+        // A loaded, transformed splat on its way to a writer
+        struct PendingWrite {
+            size_t index;
+            std::shared_ptr<SplatData> splat;
+            size_t reserved_bytes;
+            Clock::time_point start;
+            Clock::time_point ready;
+        };
+
+        bool cudaDeviceAvailable() {
+            int device_count = 0;
+            return cudaGetDeviceCount(&device_count) == cudaSuccess && device_count > 0;
+        }
+
+        bool usesGpuEncoder(const param::ConvertParameters& params) {
+            return params.use_gpu &&
+                   (params.format == param::OutputFormat::SOG || params.format == param::OutputFormat::HTML);
+        }
+
+        lfs::io::Result<void> writeSplat(const SplatData& splat, const std::filesystem::path& output,
+                                         const param::ConvertParameters& params) {
             switch (params.format) {
             case param::OutputFormat::PLY:
-                result = lfs::io::save_ply(*splat, {.output_path = output, .binary = true});
-                break;
+                return lfs::io::save_ply(splat, {.output_path = output, .binary = true});
             case param::OutputFormat::SOG:
-                result = lfs::io::save_sog(*splat, {.output_path = output, .kmeans_iterations = params.sog_iterations});
-                break;
+                return lfs::io::save_sog(splat, {.output_path = output,
+                                                 .kmeans_iterations = params.sog_iterations,
+                                                 .use_gpu = params.use_gpu});
             case param::OutputFormat::SPZ:
-                result = lfs::io::save_spz(*splat, {.output_path = output});
-                break;
+                return lfs::io::save_spz(splat, {.output_path = output});
             case param::OutputFormat::HTML:
-                result = lfs::io::export_html(*splat, {.output_path = output, .kmeans_iterations = params.sog_iterations});
-                break;
+                return lfs::io::export_html(splat, {.output_path = output,
+                                                    .kmeans_iterations = params.sog_iterations,
+                                                    .use_gpu = params.use_gpu});
             }
+            return {};
+        }
 
-            if (!result) {
-                LOG_ERROR("Save failed: {}", result.error().format());
-                std::println(stderr, "  Error: {}", result.error().message);
-                return false;
+        /**
+         * @brief Load -> transform -> write pipeline over a batch of files
+         *
+         * Loader threads pull files in order, reserve memory, load on the host and
+         * truncate SH; a bounded queue hands results to the writer threads. Loaders
+         * stall on the queue or on the memory budget when writers fall behind.
+         * An exception from a loader or writer fails that file only.
+         */
+        class ConvertPipeline {
+        public:
+            ConvertPipeline(const std::vector<ConvertJob>& jobs, const param::ConvertParameters& params,
+                            const size_t loaders, const size_t writers)
+                : jobs_(jobs),
+                  params_(params),
+                  loaders_(loaders),
+                  writers_(writers),
+                  stats_(jobs.size()),
+                  budget_(CONVERT_MEMORY_BUDGET),
+                  queue_(writers) {}
+
+            const std::vector<FileStats>& run() {
+                std::vector<std::thread> loaders, writers;
+                for (size_t i = 0; i < loaders_; ++i) {
+                    loaders.emplace_back([this] { loaderLoop(); });
+                }
+                for (size_t i = 0; i < writers_; ++i) {
+                    writers.emplace_back([this] { writerLoop(); });
+                }
+                for (auto& t : loaders)
+                    t.join();
+                queue_.close();
+                for (auto& t : writers)
+                    t.join();
+                return stats_;
             }
 
-            std::println("  Done");
-            return true;
+        private:
+            void loaderLoop() {
+                for (size_t index = next_.fetch_add(1); index < jobs_.size(); index = next_.fetch_add(1)) {
+                    const auto& job = jobs_[index];
+                    auto& stats = stats_[index];
+
+                    std::error_code ec;
+                    stats.input_bytes = std::filesystem::file_size(job.input, ec);
+                    const size_t reserved = estimateLoadedBytes(job.input);
+                    budget_.acquire(reserved);
+
+                    const auto start = Clock::now();
+                    std::shared_ptr<SplatData> splat;
+                    std::string message;
+                    try {
+                        const auto loader = lfs::io::Loader::create();
+                        auto load_result = loader->load(job.input, {.device = Device::CPU});
+                        if (auto* splat_ptr = load_result ? std::get_if<std::shared_ptr<SplatData>>(&load_result->data) : nullptr) {
+                            splat = std::move(*splat_ptr);
+                        }
+                        if (!splat) {
+                            message = load_result ? std::string("not a splat file") : load_result.error().message;
+                        }
+                        stats.load_ms = elapsed_ms(start);
+
+                        if (splat) {
+                            const auto transform_start = Clock::now();
+                            stats.gaussians = splat->size();
+                            if (params_.sh_degree >= 0 && params_.sh_degree < splat->get_max_sh_degree()) {
+                                truncateSHDegree(*splat, params_.sh_degree);
+                            }
+                            stats.transform_ms = elapsed_ms(transform_start);
+                        }
+                    } catch (const std::exception& e) {
+                        splat.reset();
+                        message = e.what();
+                    }
+                    if (!splat) {
+                        budget_.release(reserved);
+                        LOG_ERROR("Load failed for {}: {}", lfs::core::path_to_utf8(job.input), message);
+                        report(index, message);
+                        continue;
+                    }
+
+                    const size_t actual = splatBytes(*splat);
+                    budget_.adjust(reserved, actual);
+                    queue_.push({index, std::move(splat), actual, start, Clock::now()});
+                }
+            }
+
+            void writerLoop() {
+                while (auto pending = queue_.pop()) {
+                    const auto& job = jobs_[pending->index];
+                    auto& stats = stats_[pending->index];
+                    stats.queued_ms = elapsed_ms(pending->ready);
+
+                    const auto write_start = Clock::now();
+                    lfs::io::Result<void> result;
+                    try {
+                        result = writeSplat(*pending->splat, job.output, params_);
+                    } catch (const std::exception& e) {
+                        result = lfs::io::make_error(lfs::io::ErrorCode::INTERNAL_ERROR, e.what(), job.output);
+                    }
+                    pending->splat.reset();
+                    budget_.release(pending->reserved_bytes);
+                    stats.write_ms = elapsed_ms(write_start);
+                    stats.latency_ms = elapsed_ms(pending->start);
+
+                    if (!result) {
+                        LOG_ERROR("Save failed for {}: {}", lfs::core::path_to_utf8(job.output), result.error().format());
+                        report(pending->index, result.error().message);
+                        continue;
+                    }
+                    std::error_code ec;
+                    stats.output_bytes = std::filesystem::file_size(job.output, ec);
+                    stats.ok = true;
+                    report(pending->index, {});
+                }
+            }
+
+            void report(const size_t index, const std::string& error) {
+                const auto& job = jobs_[index];
+                const auto& stats = stats_[index];
+                std::lock_guard lock(print_mutex_);
+                ++completed_;
+                if (!error.empty()) {
+                    std::println(stderr, "[{}/{}] {} failed: {}", completed_, jobs_.size(),
+                                 lfs::core::path_to_utf8(job.input.filename()), error);
+                    return;
+                }
+                const double mb_per_s = stats.latency_ms > 0.0 ? stats.input_bytes / (1024.0 * 1024.0) / (stats.latency_ms / 1000.0) : 0.0;
+                std::println("[{}/{}] {} -> {}: {} gaussians | load {:.0f} ms, write {:.0f} ms, total {:.0f} ms ({:.1f} MB/s)",
+                             completed_, jobs_.size(), lfs::core::path_to_utf8(job.input.filename()),
+                             lfs::core::path_to_utf8(job.output), stats.gaussians,
+                             stats.load_ms, stats.write_ms, stats.latency_ms, mb_per_s);
+            }
+
+            const std::vector<ConvertJob>& jobs_;
+            const param::ConvertParameters& params_;
+            const size_t loaders_;
+            const size_t writers_;
+            std::vector<FileStats> stats_;
+            MemoryBudget budget_;
+            BoundedQueue<PendingWrite> queue_;
+            std::atomic<size_t> next_{0};
+            std::mutex print_mutex_;
+            size_t completed_ = 0;
+        };
+
+        double percentile(std::vector<double> values, const double p) {
+            if (values.empty())
+                return 0.0;
+            const auto k = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+            std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(k), values.end());
+            return values[k];
+        }
+
+        void printSummary(const std::vector<FileStats>& stats, const double wall_ms, const size_t loaders,
+                          const size_t writers) {
+            std::vector<double> latencies;
+            double load = 0.0, transform = 0.0, queued = 0.0, write = 0.0;
+            uintmax_t bytes_in = 0, bytes_out = 0;
+            size_t gaussians = 0;
+            for (const auto& s : stats) {
+                if (!s.ok)
+                    continue;
+                latencies.push_back(s.latency_ms);
+                load += s.load_ms;
+                transform += s.transform_ms;
+                queued += s.queued_ms;
+                write += s.write_ms;
+                bytes_in += s.input_bytes;
+                bytes_out += s.output_bytes;
+                gaussians += s.gaussians;
+            }
+            if (latencies.empty() || wall_ms <= 0.0)
+                return;
+
+            const double n = static_cast<double>(latencies.size());
+            const double seconds = wall_ms / 1000.0;
+            constexpr double MB = 1024.0 * 1024.0;
+            std::println("\nThroughput: {:.1f} files/s, {:.2f} M gaussians/s, {:.1f} MB/s in, {:.1f} MB/s out ({:.2f} s, {} jobs, {} writers)",
+                         n / seconds, static_cast<double>(gaussians) / 1e6 / seconds,
+                         static_cast<double>(bytes_in) / MB / seconds, static_cast<double>(bytes_out) / MB / seconds,
+                         seconds, loaders, writers);
+            std::println("Latency per file: p50 {:.0f} ms, p95 {:.0f} ms, max {:.0f} ms",
+                         percentile(latencies, 0.5), percentile(latencies, 0.95),
+                         *std::max_element(latencies.begin(), latencies.end()));
+            std::println("Mean per stage: load {:.0f} ms, transform {:.1f} ms, queued {:.0f} ms, write {:.0f} ms",
+                         load / n, transform / n, queued / n, write / n);
         }
 
     } // namespace
 
-    int run_converter(const param::ConvertParameters& params) {
+    int run_converter(const param::ConvertParameters& requested) {
+        param::ConvertParameters params = requested;
+        if (usesGpuEncoder(params) && !cudaDeviceAvailable()) {
+            LOG_WARN("No CUDA device available, encoding on the CPU");
+            std::println("No CUDA device available, encoding on the CPU");
+            params.use_gpu = false;
+        }
+
         const auto files = getInputFiles(params.input_path);
         if (files.empty()) {
             LOG_ERROR("No convertible files in: {}", lfs::core::path_to_utf8(params.input_path));
-            std::println(stderr, "Error: No .ply, .sog, or .resume files found");
+            std::println(stderr, "Error: No .ply, .sog, .spz, or .resume files found");
             return 1;
         }
 
         std::println("Found {} file(s) to convert", files.size());
 
-        int succeeded = 0, skipped = 0, failed = 0;
+        // Overwrite prompts are interactive, so resolve them before any work starts
+        std::vector<ConvertJob> jobs;
+        std::set<std::filesystem::path> planned_outputs;
+        int skipped = 0, failed = 0;
         bool overwrite_all = false;
 
         for (const auto& input : files) {
             const auto output = generateOutputPath(input, params.output_path, params.format);
 
+            if (!planned_outputs.insert(output).second) {
+                std::println(stderr, "{} failed: output {} is already written by another input",
+                             lfs::core::path_to_utf8(input.filename()), lfs::core::path_to_utf8(output));
+                ++failed;
+                continue;
+            }
+
             if (std::filesystem::exists(output) && !overwrite_all && !params.overwrite) {
                 const auto choice = askOverwrite(output);
                 if (choice == OverwriteChoice::NO) {
@@ -198,11 +523,31 @@ namespace lfs::core {
                 }
             }
 
-            if (convertFile(input, output, params)) {
-                ++succeeded;
-            } else {
-                ++failed;
+            jobs.push_back({input, output});
+        }
+
+        const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        const size_t max_workers = std::max<size_t>(jobs.size(), 1);
+        const size_t loaders = std::clamp<size_t>(params.jobs > 0 ? static_cast<size_t>(params.jobs) : hardware,
+                                                  1, max_workers);
+        size_t writers = loaders;
+        if (params.writers > 0) {
+            writers = std::min<size_t>(static_cast<size_t>(params.writers), max_workers);
+        } else if (usesGpuEncoder(params)) {
+            writers = std::min(loaders, MAX_GPU_WRITERS);
+        }
+
+        int succeeded = 0;
+        if (!jobs.empty()) {
+            const auto start = Clock::now();
+            ConvertPipeline pipeline(jobs, params, loaders, writers);
+            const auto& stats = pipeline.run();
+            const double wall_ms = elapsed_ms(start);
+
+            for (const auto& s : stats) {
+                s.ok ? ++succeeded : ++failed;
             }
+            printSummary(stats, wall_ms, loaders, writers);
         }
 
         std::println("\nDone: {} succeeded, {} skipped, {} failed", succeeded, skipped, failed);
@@ -0,0 +1,110 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/cuda/spatial_index.cuh"
+#include "core/logger.hpp"
+#include <cuda_runtime.h>
+
+namespace lfs::core {
+
+    namespace {
+
+        constexpr int BLOCK_SIZE = 256;
+        constexpr int WARP_SIZE = 32;
+        static_assert(SPATIAL_LEAF_SIZE <= WARP_SIZE, "a leaf must fit in one warp");
+
+        // Component k of M * [x, y, z, 1], rounded like glm's (m0 x + m1 y) + (m2 z + m3).
+        // Explicit intrinsics keep -use_fast_math from fusing, so boundary points agree with the host.
+        __device__ __forceinline__ float transform_component(const float* m, const int k,
+                                                             const float x, const float y, const float z) {
+            const float a = __fadd_rn(__fmul_rn(m[k], x), __fmul_rn(m[4 + k], y));
+            const float b = __fadd_rn(__fmul_rn(m[8 + k], z), m[12 + k]);
+            return __fadd_rn(a, b);
+        }
+
+        __device__ __forceinline__ bool box_contains(const SpatialBoxQuery& box, const float x, const float y, const float z) {
+            for (int k = 0; k < 3; ++k) {
+                const float local = transform_component(box.world_to_box, k, x, y, z);
+                if (!(local >= box.min[k] && local <= box.max[k]))
+                    return false;
+            }
+            return true;
+        }
+
+        // 0 = outside, 1 = partial, 2 = inside; same bounds and slack as OrientedBox::classify
+        __device__ int box_classify(const SpatialBoxQuery& box, const SpatialIndexLeaf& leaf) {
+            const float* m = box.world_to_box;
+            float lo[3], hi[3];
+            float max_center = 0.0f, max_half = 0.0f, max_min = 0.0f, max_max = 0.0f;
+            const float cx = 0.5f * (leaf.min[0] + leaf.max[0]);
+            const float cy = 0.5f * (leaf.min[1] + leaf.max[1]);
+            const float cz = 0.5f * (leaf.min[2] + leaf.max[2]);
+            const float hx = 0.5f * (leaf.max[0] - leaf.min[0]);
+            const float hy = 0.5f * (leaf.max[1] - leaf.min[1]);
+            const float hz = 0.5f * (leaf.max[2] - leaf.min[2]);
+            for (int k = 0; k < 3; ++k) {
+                const float center = transform_component(m, k, cx, cy, cz);
+                const float half = fabsf(m[k]) * hx + fabsf(m[4 + k]) * hy + fabsf(m[8 + k]) * hz;
+                lo[k] = center - half;
+                hi[k] = center + half;
+                max_center = fmaxf(max_center, fabsf(center));
+                max_half = fmaxf(max_half, fabsf(half));
+                max_min = fmaxf(max_min, fabsf(box.min[k]));
+                max_max = fmaxf(max_max, fabsf(box.max[k]));
+            }
+            const float slack = SPATIAL_COVERAGE_EPS * (1.0f + max_center + max_half + max_min + max_max);
+
+            bool inside = true;
+            for (int k = 0; k < 3; ++k) {
+                if (hi[k] < box.min[k] - slack || lo[k] > box.max[k] + slack)
+                    return 0;
+                inside = inside && lo[k] >= box.min[k] + slack && hi[k] <= box.max[k] - slack;
+            }
+            return inside ? 2 : 1;
+        }
+
+        // One warp per leaf, one lane per point; every point belongs to exactly one leaf
+        __global__ void box_mask_kernel(const SpatialBoxQuery box,
+                                        const SpatialIndexLeaf* __restrict__ leaves,
+                                        const size_t num_leaves,
+                                        const float* __restrict__ points,
+                                        const int32_t* __restrict__ order,
+                                        bool* __restrict__ out) {
+            const size_t leaf_index = (static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x) / WARP_SIZE;
+            const uint32_t lane = threadIdx.x % WARP_SIZE;
+            if (leaf_index >= num_leaves)
+                return;
+
+            const SpatialIndexLeaf leaf = leaves[leaf_index];
+            if (lane >= leaf.count)
+                return;
+
+            const int coverage = box_classify(box, leaf);
+            const size_t i = leaf.first + lane;
+            bool inside = coverage == 2;
+            if (coverage == 1)
+                inside = box_contains(box, points[i * 3 + 0], points[i * 3 + 1], points[i * 3 + 2]);
+            out[order[i]] = inside;
+        }
+
+    } // namespace
+
+    void spatial_box_mask_cuda(const SpatialBoxQuery& box,
+                               const SpatialIndexLeaf* leaves,
+                               const size_t num_leaves,
+                               const float* points,
+                               const int32_t* order,
+                               bool* out) {
+        if (num_leaves == 0)
+            return;
+        constexpr size_t LEAVES_PER_BLOCK = BLOCK_SIZE / WARP_SIZE;
+        const auto num_blocks = static_cast<unsigned int>((num_leaves + LEAVES_PER_BLOCK - 1) / LEAVES_PER_BLOCK);
+        box_mask_kernel<<<num_blocks, BLOCK_SIZE>>>(box, leaves, num_leaves, points, order, out);
+        const cudaError_t err = cudaGetLastError();
+        if (err != cudaSuccess) {
+            LOG_ERROR("spatial_box_mask_cuda: {}", cudaGetErrorString(err));
+        }
+    }
+
+} // namespace lfs::core
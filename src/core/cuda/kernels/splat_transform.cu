@@ -0,0 +1,188 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/cuda/splat_transform.cuh"
+#include "core/logger.hpp"
+#include "core/tensor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cuda_runtime.h>
+#include <vector>
+
+namespace lfs::core {
+
+    namespace {
+
+        constexpr int BLOCK_SIZE = 256;
+        constexpr int RADIX_BITS = 8;
+        constexpr int RADIX_BINS = 1 << RADIX_BITS;
+        constexpr int MAX_HISTOGRAM_BLOCKS = 1024;
+
+        // One thread per gaussian; each block also writes the sum of its transformed means
+        __global__ void transform_gaussians_kernel(const SplatTransformParams params,
+                                                   float* __restrict__ means,
+                                                   float* __restrict__ rotation,
+                                                   float* __restrict__ scaling,
+                                                   float* __restrict__ shN,
+                                                   const size_t n,
+                                                   const int shN_coeffs,
+                                                   float* __restrict__ block_sums) {
+            __shared__ float partial[3][BLOCK_SIZE];
+
+            const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+            float sum[3] = {0.0f, 0.0f, 0.0f};
+            if (idx < n) {
+                float* mean = means + idx * 3;
+                transform_gaussian(params, mean, rotation + idx * 4, scaling + idx * 3,
+                                   shN ? shN + idx * shN_coeffs * 3 : nullptr);
+                sum[0] = mean[0];
+                sum[1] = mean[1];
+                sum[2] = mean[2];
+            }
+
+            for (int d = 0; d < 3; ++d)
+                partial[d][threadIdx.x] = sum[d];
+            __syncthreads();
+            for (int stride = BLOCK_SIZE / 2; stride > 0; stride >>= 1) {
+                if (threadIdx.x < stride) {
+                    for (int d = 0; d < 3; ++d)
+                        partial[d][threadIdx.x] += partial[d][threadIdx.x + stride];
+                }
+                __syncthreads();
+            }
+            if (threadIdx.x == 0) {
+                for (int d = 0; d < 3; ++d)
+                    block_sums[blockIdx.x * 3 + d] = partial[d][0];
+            }
+        }
+
+        // Single block: sums the per-block partials in double precision
+        __global__ void centroid_kernel(const float* __restrict__ block_sums,
+                                        const int num_blocks,
+                                        const size_t n,
+                                        float* __restrict__ centroid) {
+            __shared__ double partial[3][BLOCK_SIZE];
+
+            double sum[3] = {0.0, 0.0, 0.0};
+            for (int b = threadIdx.x; b < num_blocks; b += BLOCK_SIZE) {
+                for (int d = 0; d < 3; ++d)
+                    sum[d] += block_sums[b * 3 + d];
+            }
+            for (int d = 0; d < 3; ++d)
+                partial[d][threadIdx.x] = sum[d];
+            __syncthreads();
+            for (int stride = BLOCK_SIZE / 2; stride > 0; stride >>= 1) {
+                if (threadIdx.x < stride) {
+                    for (int d = 0; d < 3; ++d)
+                        partial[d][threadIdx.x] += partial[d][threadIdx.x + stride];
+                }
+                __syncthreads();
+            }
+            if (threadIdx.x == 0) {
+                for (int d = 0; d < 3; ++d)
+                    centroid[d] = static_cast<float>(partial[d][0] / static_cast<double>(n));
+            }
+        }
+
+        // Non-negative floats order the same as their bit patterns, so squared distances
+        // are stored as radix keys directly
+        __global__ void squared_distance_kernel(const float* __restrict__ means,
+                                                const float* __restrict__ centroid,
+                                                const size_t n,
+                                                uint32_t* __restrict__ keys) {
+            const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+            if (idx >= n)
+                return;
+            const float dx = means[idx * 3 + 0] - centroid[0];
+            const float dy = means[idx * 3 + 1] - centroid[1];
+            const float dz = means[idx * 3 + 2] - centroid[2];
+            keys[idx] = __float_as_uint(dx * dx + dy * dy + dz * dz);
+        }
+
+        // Histogram of one radix digit over the keys matching the digits selected so far
+        __global__ void radix_histogram_kernel(const uint32_t* __restrict__ keys,
+                                               const size_t n,
+                                               const uint32_t prefix,
+                                               const uint32_t prefix_mask,
+                                               const int shift,
+                                               int* __restrict__ histogram) {
+            __shared__ int bins[RADIX_BINS];
+            for (int i = threadIdx.x; i < RADIX_BINS; i += blockDim.x)
+                bins[i] = 0;
+            __syncthreads();
+
+            const size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+            for (size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x; idx < n; idx += stride) {
+                const uint32_t key = keys[idx];
+                if ((key & prefix_mask) == prefix)
+                    atomicAdd(&bins[(key >> shift) & (RADIX_BINS - 1)], 1);
+            }
+            __syncthreads();
+
+            for (int i = threadIdx.x; i < RADIX_BINS; i += blockDim.x) {
+                if (bins[i] != 0)
+                    atomicAdd(&histogram[i], bins[i]);
+            }
+        }
+
+    } // namespace
+
+    float transform_gaussians_cuda(const SplatTransformParams& params,
+                                   float* means,
+                                   float* rotation,
+                                   float* scaling,
+                                   float* shN,
+                                   const size_t n,
+                                   const int shN_coeffs) {
+        if (n == 0)
+            return 0.0f;
+
+        const int num_blocks = static_cast<int>((n + BLOCK_SIZE - 1) / BLOCK_SIZE);
+        auto block_sums = Tensor::empty({static_cast<size_t>(num_blocks) * 3}, Device::CUDA, DataType::Float32);
+        auto centroid = Tensor::empty({3}, Device::CUDA, DataType::Float32);
+        auto keys = Tensor::empty({n}, Device::CUDA, DataType::Int32);
+        auto histogram = Tensor::empty({RADIX_BINS}, Device::CUDA, DataType::Int32);
+        auto* const key_ptr = reinterpret_cast<uint32_t*>(keys.ptr<int>());
+
+        transform_gaussians_kernel<<<num_blocks, BLOCK_SIZE>>>(
+            params, means, rotation, scaling, shN, n, shN_coeffs, block_sums.ptr<float>());
+        centroid_kernel<<<1, BLOCK_SIZE>>>(block_sums.ptr<float>(), num_blocks, n, centroid.ptr<float>());
+        squared_distance_kernel<<<num_blocks, BLOCK_SIZE>>>(means, centroid.ptr<float>(), n, key_ptr);
+
+        // Select the key of rank n / 2, most significant digit first
+        size_t rank = n / 2;
+        uint32_t prefix = 0;
+        uint32_t prefix_mask = 0;
+        std::vector<int> counts(RADIX_BINS);
+        const int histogram_blocks = std::min(num_blocks, MAX_HISTOGRAM_BLOCKS);
+        for (int shift = 32 - RADIX_BITS; shift >= 0; shift -= RADIX_BITS) {
+            cudaMemsetAsync(histogram.ptr<int>(), 0, RADIX_BINS * sizeof(int));
+            radix_histogram_kernel<<<histogram_blocks, BLOCK_SIZE>>>(
+                key_ptr, n, prefix, prefix_mask, shift, histogram.ptr<int>());
+            cudaMemcpy(counts.data(), histogram.ptr<int>(), RADIX_BINS * sizeof(int), cudaMemcpyDeviceToHost);
+
+            uint32_t digit = 0;
+            for (; digit < RADIX_BINS - 1; ++digit) {
+                const auto count = static_cast<size_t>(counts[digit]);
+                if (rank < count)
+                    break;
+                rank -= count;
+            }
+            prefix |= digit << shift;
+            prefix_mask |= static_cast<uint32_t>(RADIX_BINS - 1) << shift;
+        }
+
+        if (const cudaError_t err = cudaGetLastError(); err != cudaSuccess) {
+            LOG_ERROR("CUDA error in transform_gaussians_cuda: {}", cudaGetErrorString(err));
+            return 0.0f;
+        }
+
+        float median_sq;
+        std::memcpy(&median_sq, &prefix, sizeof(median_sq));
+        return std::sqrt(median_sq);
+    }
+
+} // namespace lfs::core
@@ -12,15 +12,23 @@
 #include "core/path_utils.hpp"
 #include <algorithm>
 #include <condition_variable>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <stdexcept>
 #include <thread>
+#include <tuple>
 #include <vector>
 
+#include <jpeglib.h>
+
 namespace {
 
     // Run once: set global OIIO attributes (threading, etc.)
@@ -56,6 +64,234 @@ namespace {
         return out; // already filled
     }
 
+    // Final size for a res_div/max_width request, same rounding as the full-decode paths
+    std::pair<int, int> target_size(const int w, const int h, const int res_div, const int max_width) {
+        int nw = res_div > 1 ? std::max(1, w / res_div) : w;
+        int nh = res_div > 1 ? std::max(1, h / res_div) : h;
+        if (max_width > 0 && (nw > max_width || nh > max_width)) {
+            if (nw > nh) {
+                nh = std::max(1, max_width * nh / nw);
+                nw = std::max(1, max_width);
+            } else {
+                nw = std::max(1, max_width * nw / nh);
+                nh = std::max(1, max_width);
+            }
+        }
+        return {nw, nh};
+    }
+
+    bool is_jpeg_path(const std::filesystem::path& p) {
+        auto ext = p.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        return ext == ".jpg" || ext == ".jpeg";
+    }
+
+    // Enough to reach the frame header past typical EXIF/XMP segments
+    constexpr size_t JPEG_HEADER_PREFIX = 64 * 1024;
+
+    /**
+     * Frame size from the SOF marker of a JPEG prefix, without libjpeg.
+     * Returns nullopt if the prefix is not a JPEG or ends before the SOF.
+     */
+    std::optional<std::pair<int, int>> jpeg_frame_size(const unsigned char* data, const size_t size) {
+        if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+            return std::nullopt;
+        }
+        size_t pos = 2;
+        while (pos + 4 <= size) {
+            if (data[pos] != 0xFF) {
+                return std::nullopt;
+            }
+            const unsigned char marker = data[pos + 1];
+            if (marker == 0xFF) { // Fill byte
+                ++pos;
+                continue;
+            }
+            if (marker == 0xD8 || (marker >= 0xD0 && marker <= 0xD7) || marker == 0x01) { // No payload
+                pos += 2;
+                continue;
+            }
+            if (marker == 0xDA || marker == 0xD9) { // Scan or end before any frame header
+                return std::nullopt;
+            }
+            const size_t length = (static_cast<size_t>(data[pos + 2]) << 8) | data[pos + 3];
+            // SOF0..SOF15, excluding DHT, JPG and DAC
+            if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+                if (pos + 9 > size) {
+                    return std::nullopt;
+                }
+                const int h = (data[pos + 5] << 8) | data[pos + 6];
+                const int w = (data[pos + 7] << 8) | data[pos + 8];
+                if (w <= 0 || h <= 0) {
+                    return std::nullopt;
+                }
+                return std::pair{w, h};
+            }
+            pos += 2 + length;
+        }
+        return std::nullopt;
+    }
+
+    // Largest DCT scale denominator (1, 2, 4 or 8) whose output still covers tw x th
+    unsigned int dct_scale_denom(const int full_w, const int full_h, const int tw, const int th) {
+        unsigned int denom = 1;
+        while (denom < 8 &&
+               (static_cast<unsigned>(full_w) + denom * 2 - 1) / (denom * 2) >= static_cast<unsigned>(tw) &&
+               (static_cast<unsigned>(full_h) + denom * 2 - 1) / (denom * 2) >= static_cast<unsigned>(th)) {
+            denom *= 2;
+        }
+        return denom;
+    }
+
+    struct JpegError {
+        jpeg_error_mgr mgr;
+        std::jmp_buf jump;
+        char message[JMSG_LENGTH_MAX];
+    };
+
+    void jpeg_error_exit(j_common_ptr cinfo) {
+        auto* const err = reinterpret_cast<JpegError*>(cinfo->err);
+        (*cinfo->err->format_message)(cinfo, err->message);
+        std::longjmp(err->jump, 1);
+    }
+
+    void jpeg_silence(j_common_ptr, int) {}
+
+    // Plain C data only between setjmp and longjmp. Returns a malloc'ed RGB
+    // buffer, or nullptr on a libjpeg error or when no DCT scaling applies.
+    unsigned char* decode_jpeg_scaled(const unsigned char* data, const size_t size,
+                                      const int res_div, const int max_width,
+                                      int& full_w, int& full_h, int& out_w, int& out_h, char* error) {
+        jpeg_decompress_struct cinfo;
+        JpegError err;
+        cinfo.err = jpeg_std_error(&err.mgr);
+        err.mgr.error_exit = jpeg_error_exit;
+        err.mgr.emit_message = jpeg_silence;
+        unsigned char* volatile out = nullptr;
+
+        if (setjmp(err.jump)) {
+            std::snprintf(error, JMSG_LENGTH_MAX, "%s", err.message);
+            jpeg_destroy_decompress(&cinfo);
+            std::free(out);
+            return nullptr;
+        }
+
+        jpeg_create_decompress(&cinfo);
+        jpeg_mem_src(&cinfo, data, static_cast<unsigned long>(size));
+        jpeg_read_header(&cinfo, TRUE);
+        full_w = static_cast<int>(cinfo.image_width);
+        full_h = static_cast<int>(cinfo.image_height);
+
+        const auto [tw, th] = target_size(full_w, full_h, res_div, max_width);
+        const unsigned int denom = dct_scale_denom(full_w, full_h, tw, th);
+        if (denom == 1) {
+            jpeg_destroy_decompress(&cinfo);
+            std::snprintf(error, JMSG_LENGTH_MAX, "no reduction");
+            return nullptr;
+        }
+        cinfo.scale_num = 1;
+        cinfo.scale_denom = denom;
+        cinfo.out_color_space = JCS_RGB;
+
+        jpeg_start_decompress(&cinfo);
+        out_w = static_cast<int>(cinfo.output_width);
+        out_h = static_cast<int>(cinfo.output_height);
+        const size_t stride = static_cast<size_t>(out_w) * 3;
+        out = static_cast<unsigned char*>(std::malloc(stride * out_h));
+        if (!out) {
+            jpeg_destroy_decompress(&cinfo);
+            std::snprintf(error, JMSG_LENGTH_MAX, "out of memory");
+            return nullptr;
+        }
+
+        while (cinfo.output_scanline < cinfo.output_height) {
+            JSAMPROW row = out + stride * cinfo.output_scanline;
+            jpeg_read_scanlines(&cinfo, &row, 1);
+        }
+        jpeg_finish_decompress(&cinfo);
+        jpeg_destroy_decompress(&cinfo);
+        return out;
+    }
+
+    /**
+     * Reduced-size JPEG decode: libjpeg scales in the DCT domain by the
+     * largest of 1/2, 1/4, 1/8 that still covers the target, so only the
+     * remaining factor goes through the resampler and the full-resolution
+     * image is never materialized.
+     * Returns nullopt (caller falls back to OIIO) when no DCT scale applies
+     * or libjpeg rejects the file (e.g. CMYK). The first case is decided from
+     * a header prefix, so the file is only read in full when it will be used.
+     */
+    std::optional<std::tuple<unsigned char*, int, int, int>>
+    load_jpeg_reduced(const std::filesystem::path& p, const int res_div, const int max_width) {
+        std::ifstream file;
+        if (!lfs::core::open_file_for_read(p, std::ios::binary, file)) {
+            return std::nullopt;
+        }
+        std::vector<unsigned char> bytes(JPEG_HEADER_PREFIX);
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        bytes.resize(static_cast<size_t>(file.gcount()));
+
+        // An unparsable prefix is left to libjpeg below
+        if (const auto frame = jpeg_frame_size(bytes.data(), bytes.size())) {
+            const auto [tw, th] = target_size(frame->first, frame->second, res_div, max_width);
+            if (dct_scale_denom(frame->first, frame->second, tw, th) == 1) {
+                return std::nullopt;
+            }
+        }
+
+        if (bytes.size() == JPEG_HEADER_PREFIX) {
+            std::error_code ec;
+            const auto file_size = std::filesystem::file_size(p, ec);
+            if (!ec && file_size > bytes.size()) {
+                const size_t prefix = bytes.size();
+                bytes.resize(static_cast<size_t>(file_size));
+                file.read(reinterpret_cast<char*>(bytes.data() + prefix), static_cast<std::streamsize>(bytes.size() - prefix));
+                bytes.resize(prefix + static_cast<size_t>(file.gcount()));
+            }
+        }
+        file.close();
+
+        int full_w = 0, full_h = 0, w = 0, h = 0;
+        char error[JMSG_LENGTH_MAX] = {};
+        unsigned char* decoded = nullptr;
+        {
+            LOG_TIMER("libjpeg scaled decode");
+            decoded = decode_jpeg_scaled(bytes.data(), bytes.size(), res_div, max_width, full_w, full_h, w, h, error);
+        }
+        if (!decoded) {
+            LOG_DEBUG("libjpeg scaled decode skipped for {}: {}", lfs::core::path_to_utf8(p), error);
+            return std::nullopt;
+        }
+
+        const auto [tw, th] = target_size(full_w, full_h, res_div, max_width);
+        LOG_PERF("JPEG reduced decode: {}x{} -> {}x{} -> {}x{}", full_w, full_h, w, h, tw, th);
+        if (tw == w && th == h) {
+            return std::make_tuple(decoded, w, h, 3);
+        }
+        // DCT output rounds up, so it is never smaller than the target. One extra
+        // row or column is cropped, which beats a near-identity resample.
+        if (w - tw <= 1 && h - th <= 1) {
+            const size_t src_stride = static_cast<size_t>(w) * 3;
+            const size_t dst_stride = static_cast<size_t>(tw) * 3;
+            for (int y = 1; y < th; ++y) {
+                std::memmove(decoded + y * dst_stride, decoded + y * src_stride, dst_stride);
+            }
+            return std::make_tuple(decoded, tw, th, 3);
+        }
+
+        unsigned char* out = nullptr;
+        try {
+            LOG_TIMER("downscale_resample_direct (jpeg remainder)");
+            out = downscale_resample_direct(decoded, w, h, tw, th, 0);
+        } catch (...) {
+            std::free(decoded);
+            throw;
+        }
+        std::free(decoded);
+        return std::make_tuple(out, tw, th, 3);
+    }
+
 } // namespace
 
 namespace lfs::core {
@@ -155,6 +391,12 @@ namespace lfs::core {
             init_oiio();
         }
 
+        if ((res_div == 2 || res_div == 4 || res_div == 8 || max_width > 0) && is_jpeg_path(p)) {
+            if (auto reduced = load_jpeg_reduced(p, res_div, max_width)) {
+                return *reduced;
+            }
+        }
+
         const std::string path_utf8 = lfs::core::path_to_utf8(p);
         std::unique_ptr<OIIO::ImageInput> in;
         {
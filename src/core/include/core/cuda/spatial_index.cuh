@@ -0,0 +1,55 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lfs::core {
+
+    // Node tests leave this much relative slack so that a node is only accepted or
+    // rejected wholesale when every point test would agree
+    constexpr float SPATIAL_COVERAGE_EPS = 1e-5f;
+
+    // Points per leaf; one warp handles one leaf on the device
+    constexpr uint32_t SPATIAL_LEAF_SIZE = 32;
+
+    /**
+     * @brief Leaf of a SpatialIndex as uploaded to the device: bounds plus its run of tree-ordered points
+     */
+    struct SpatialIndexLeaf {
+        float min[3];
+        uint32_t first;
+        float max[3];
+        uint32_t count;
+    };
+
+    /**
+     * @brief OrientedBox flattened for the device
+     */
+    struct SpatialBoxQuery {
+        float world_to_box[16]; // Column-major 4x4, as glm stores it
+        float min[3];
+        float max[3];
+    };
+
+    /**
+     * @brief Bool mask of the points inside `box`, written for every point
+     *
+     * One warp per leaf: leaves entirely inside or outside the box are written without
+     * point tests, partial leaves test each point with the same arithmetic as
+     * OrientedBox::contains.
+     * @param points [N, 3] positions in tree order (CUDA)
+     * @param order [N] tree position -> original index (CUDA)
+     * @param out [N] mask by original index (CUDA)
+     */
+    void spatial_box_mask_cuda(const SpatialBoxQuery& box,
+                               const SpatialIndexLeaf* leaves,
+                               size_t num_leaves,
+                               const float* points,
+                               const int32_t* order,
+                               bool* out);
+
+} // namespace lfs::core
@@ -0,0 +1,131 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <cstddef>
+
+#ifndef HOST_DEVICE
+#ifdef __CUDACC__
+#define HOST_DEVICE __host__ __device__
+#else
+#define HOST_DEVICE
+#endif
+#endif
+
+namespace lfs::core {
+
+    constexpr int SPLAT_TRANSFORM_MAX_SH_BANDS = 3;
+    // Wigner-D blocks for bands 1..3 stored back to back: 3x3, 5x5, 7x7
+    constexpr int SH_ROTATION_FLOATS = 9 + 25 + 49;
+
+    /**
+     * @brief Everything one gaussian needs to be transformed, precomputed on the host
+     */
+    struct SplatTransformParams {
+        float affine[12];                      // Row-major 3x4, p' = A p + t
+        float quat[4];                         // (w, x, y, z), left-multiplied onto every rotation
+        float log_scale;                       // Added to every log-scale
+        float sh_rotation[SH_ROTATION_FLOATS]; // Row-major per band, c' = D c
+        int sh_bands;                          // Bands of shN to rotate (0 = none)
+        bool rotate;
+        bool rescale;
+    };
+
+    // Offset of band l's block in sh_rotation
+    HOST_DEVICE constexpr int sh_rotation_offset(const int band) {
+        return band == 1 ? 0 : (band == 2 ? 9 : 34);
+    }
+
+    /**
+     * @brief Rotate band BAND of the shN of LANES gaussians in place, c' = D c per channel
+     *
+     * Coefficients are lane-minor: value k of lane l is at coeffs[k * LANES + l], with
+     * k = row * 3 + channel counted from the band's first row. LANES = 1 is a single
+     * gaussian's shN; the CPU path rotates blocks of gaussians so the lane loops vectorise.
+     */
+    template <int BAND, int LANES>
+    HOST_DEVICE inline void rotate_sh_band(const SplatTransformParams& p, float* __restrict__ coeffs) {
+        constexpr int size = 2 * BAND + 1;
+        const float* D = p.sh_rotation + sh_rotation_offset(BAND);
+        for (int c = 0; c < 3; ++c) {
+            float out[size * LANES];
+            for (int i = 0; i < size; ++i) {
+                float* acc = out + i * LANES;
+                for (int l = 0; l < LANES; ++l)
+                    acc[l] = 0.0f;
+                for (int j = 0; j < size; ++j) {
+                    const float d = D[i * size + j];
+                    const float* in = coeffs + (j * 3 + c) * LANES;
+                    for (int l = 0; l < LANES; ++l)
+                        acc[l] += d * in[l];
+                }
+            }
+            for (int i = 0; i < size; ++i) {
+                for (int l = 0; l < LANES; ++l)
+                    coeffs[(i * 3 + c) * LANES + l] = out[i * LANES + l];
+            }
+        }
+    }
+
+    // Rotate the first p.sh_bands bands of LANES gaussians, laid out as in rotate_sh_band
+    template <int LANES>
+    HOST_DEVICE inline void rotate_sh(const SplatTransformParams& p, float* __restrict__ sh) {
+        if (p.sh_bands >= 1)
+            rotate_sh_band<1, LANES>(p, sh);
+        if (p.sh_bands >= 2)
+            rotate_sh_band<2, LANES>(p, sh + 3 * 3 * LANES);
+        if (p.sh_bands >= 3)
+            rotate_sh_band<3, LANES>(p, sh + 8 * 3 * LANES);
+    }
+
+    /**
+     * @brief Transform one gaussian in place
+     * @param sh shN coefficients of this gaussian, [sh_coeffs, 3] (may be null when sh_bands is 0)
+     */
+    HOST_DEVICE inline void transform_gaussian(const SplatTransformParams& p,
+                                               float* __restrict__ mean,
+                                               float* __restrict__ quat,
+                                               float* __restrict__ log_scale,
+                                               float* __restrict__ sh) {
+        const float x = mean[0], y = mean[1], z = mean[2];
+        mean[0] = p.affine[0] * x + p.affine[1] * y + p.affine[2] * z + p.affine[3];
+        mean[1] = p.affine[4] * x + p.affine[5] * y + p.affine[6] * z + p.affine[7];
+        mean[2] = p.affine[8] * x + p.affine[9] * y + p.affine[10] * z + p.affine[11];
+
+        if (p.rotate) {
+            const float w1 = p.quat[0], x1 = p.quat[1], y1 = p.quat[2], z1 = p.quat[3];
+            const float w2 = quat[0], x2 = quat[1], y2 = quat[2], z2 = quat[3];
+            quat[0] = w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2;
+            quat[1] = w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2;
+            quat[2] = w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2;
+            quat[3] = w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2;
+        }
+
+        if (p.rescale) {
+            log_scale[0] += p.log_scale;
+            log_scale[1] += p.log_scale;
+            log_scale[2] += p.log_scale;
+        }
+
+        rotate_sh<1>(p, sh);
+    }
+
+    /**
+     * @brief Transform n gaussians resident on CUDA in place
+     *
+     * One kernel transforms every gaussian and accumulates the new centroid; the median
+     * distance to it is then found by radix selection over the squared distances.
+     * @param shN [n, shN_coeffs, 3], may be null when params.sh_bands is 0
+     * @return Median distance of the transformed means to their centroid
+     */
+    float transform_gaussians_cuda(const SplatTransformParams& params,
+                                   float* means,
+                                   float* rotation,
+                                   float* scaling,
+                                   float* shN,
+                                   size_t n,
+                                   int shN_coeffs);
+
+} // namespace lfs::core
@@ -0,0 +1,51 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "core/tensor.hpp"
+
+#include <cstdint>
+
+namespace lfs::core {
+
+    enum class KnnMethod : uint8_t {
+        KdTree, // nanoflann tree built on all cores; robust to any density
+        Grid    // Uniform grid in Morton order for evenly spread points (k <= KNN_GRID_MAX_K);
+                // queries it cannot settle within a few cells fall back to the tree
+    };
+
+    constexpr int KNN_MAX_K = 32;
+    constexpr int KNN_GRID_MAX_K = 16;
+
+    struct KnnOptions {
+        KnnMethod method = KnnMethod::KdTree;
+        // Neighbors at or below this squared distance are skipped (e.g. duplicates); negative keeps them.
+        // The query point itself is always excluded.
+        float min_distance_sq = -1.0f;
+    };
+
+    struct KnnResult {
+        Tensor indices;      // Int32 [N, k], -1 where fewer than k neighbors exist
+        Tensor distances_sq; // Float32 [N, k], ascending, +inf where padded
+    };
+
+    /**
+     * @brief k nearest neighbors of every point among the other points of the set
+     *
+     * Input is a [N, 3] float32 tensor on any device; results are on the CPU.
+     * Queries run in parallel with fixed-size per-query state, so nothing is
+     * allocated per point. Both methods return the same distances; indices may
+     * differ only between equidistant neighbors.
+     */
+    KnnResult knn_self(const Tensor& points, int k, const KnnOptions& options = {});
+
+    /**
+     * @brief Mean distance to the k nearest non-coincident neighbors (initial gaussian scale)
+     *
+     * Neighbors closer than 1e-4 are ignored; points without any get 0.01.
+     * @return Float32 [N] on the device of `points`, or an invalid tensor for bad input
+     */
+    Tensor mean_neighbor_distance(const Tensor& points, int k = 3, KnnMethod method = KnnMethod::KdTree);
+
+} // namespace lfs::core
@@ -97,7 +97,7 @@ namespace lfs::core {
         std::array<std::atomic<uint8_t>, static_cast<size_t>(LogModule::Count)> module_level_{};
     };
 
-    // Scoped timer for performance measurement
+    // Scoped timer for performance measurement; also recorded as a trace event while tracing runs
     class ScopedTimer {
     public:
         explicit ScopedTimer(std::string name, LogLevel level = LogLevel::Performance,
@@ -105,7 +105,7 @@ namespace lfs::core {
         ~ScopedTimer();
 
     private:
-        std::chrono::high_resolution_clock::time_point start_;
+        std::chrono::steady_clock::time_point start_;
         std::string name_;
         LogLevel level_;
         std::source_location loc_;
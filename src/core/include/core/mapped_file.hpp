@@ -0,0 +1,58 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace lfs::core {
+
+    /**
+     * @brief Memory mapping of a whole file
+     *
+     * Pages are mapped copy-on-write: the mapping can back a tensor that is
+     * later modified in place without the write reaching the file. The file
+     * handle is closed right after mapping, so the file can be appended to or
+     * replaced while the mapping is alive; appended bytes are only visible
+     * through a new mapping.
+     *
+     * Held through shared_ptr so views (e.g. Tensor::from_blob with an owner)
+     * keep the pages mapped for as long as they exist.
+     */
+    class MappedFile {
+    public:
+        enum class Access {
+            Normal,
+            Sequential, // Single front-to-back pass (parsers)
+            Random      // Scattered lookups (caches, indexed containers)
+        };
+
+        /**
+         * @brief Map `path` in full
+         * @return nullptr if the file can't be opened or mapped (logged)
+         */
+        static std::shared_ptr<MappedFile> open(const std::filesystem::path& path,
+                                                Access access = Access::Normal);
+
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // nullptr for empty files
+        [[nodiscard]] std::byte* data() const { return static_cast<std::byte*>(data_); }
+        [[nodiscard]] size_t size() const { return size_; }
+        [[nodiscard]] std::span<const char> as_span() const {
+            return {static_cast<const char*>(data_), size_};
+        }
+
+    private:
+        MappedFile() = default;
+
+        void* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+} // namespace lfs::core
@@ -50,6 +50,7 @@ namespace lfs::core {
             bool headless = false;                            // Disable visualization during training
             bool no_splash = false;                           // Skip splash screen on startup
             bool no_interop = false;                          // Disable CUDA-GL interop (use CPU fallback)
+            bool persist_thumbnails = false;                  // Keep image preview thumbnails on disk
             std::string strategy = "mcmc";                    // Optimization strategy: mcmc, default.
 
             // Mask parameters
@@ -161,6 +162,9 @@ namespace lfs::core {
             int sh_degree = 3; // 0-3, -1 = keep original
             int sog_iterations = 10;
             bool overwrite = false; // Skip overwrite prompts
+            int jobs = 0;           // Files converted concurrently, 0 = one per hardware thread
+            int writers = 0;        // Concurrent writers, 0 = jobs, or at most 2 for GPU SOG/HTML encodes
+            bool use_gpu = true;    // false encodes SOG/HTML on the host; forced off without a CUDA device
         };
 
         // Modern C++23 functions returning expected values
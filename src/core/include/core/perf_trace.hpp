@@ -0,0 +1,116 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+// Tracing is compiled in unless the build sets LFS_DISABLE_PERF_TRACING (cmake -DENABLE_PERF_TRACING=OFF)
+#ifndef LFS_DISABLE_PERF_TRACING
+#define LFS_PERF_TRACING 1
+#else
+#define LFS_PERF_TRACING 0
+#endif
+
+namespace lfs::core::trace {
+
+    enum class Category : uint8_t {
+        Core = 0,
+        IO = 1,
+        Loader = 2,
+        Training = 3,
+        Export = 4,
+        Rendering = 5,
+        Count = 6
+    };
+
+    constexpr size_t DEFAULT_EVENTS_PER_THREAD = 1 << 16;
+    constexpr size_t MAX_EVENT_NAME = 46; // Longer names are truncated
+
+    const char* category_name(Category category);
+
+    namespace detail {
+        extern std::atomic<bool> g_enabled;
+    }
+
+    // Recording costs one relaxed load while tracing is off
+    inline bool enabled() { return detail::g_enabled.load(std::memory_order_relaxed); }
+
+    // Monotonic timestamp shared by all threads (steady_clock, nanoseconds)
+    inline int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /**
+     * @brief Start recording into per-thread ring buffers
+     *
+     * Each thread gets its own buffer of `events_per_thread` events the first time it
+     * records; when full, the oldest events are overwritten. Buffers outlive their
+     * threads until clear().
+     */
+    void start(size_t events_per_thread = DEFAULT_EVENTS_PER_THREAD);
+    void stop();
+    void clear();
+
+    // Path used by dump(); also written automatically at process exit
+    void set_output(const std::filesystem::path& path);
+
+    // Write everything recorded so far as Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+    bool write_chrome_trace(const std::filesystem::path& path);
+    // write_chrome_trace() to the set_output() path; false if none is set
+    bool dump();
+
+    // Label the calling thread in the exported timeline
+    void set_thread_name(std::string_view name);
+
+    void record(Category category, std::string_view name, int64_t start_ns, int64_t end_ns);
+
+    struct TraceStats {
+        size_t threads = 0;
+        size_t events = 0;  // Currently held in the ring buffers
+        size_t dropped = 0; // Overwritten because a ring buffer was full
+    };
+    TraceStats stats();
+
+    class Scope {
+    public:
+        Scope(const Category category, const char* name)
+            : name_(name),
+              start_ns_(enabled() ? now_ns() : -1),
+              category_(category) {}
+
+        ~Scope() {
+            if (start_ns_ >= 0)
+                record(category_, name_, start_ns_, now_ns());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name_;
+        int64_t start_ns_;
+        Category category_;
+    };
+
+} // namespace lfs::core::trace
+
+#define LFS_TRACE_CONCAT_IMPL(a, b) a##b
+#define LFS_TRACE_CONCAT(a, b)      LFS_TRACE_CONCAT_IMPL(a, b)
+
+#if LFS_PERF_TRACING
+// Records the enclosing scope, e.g. LFS_TRACE_SCOPE(IO, "load_image")
+#define LFS_TRACE_SCOPE(category, name) \
+    ::lfs::core::trace::Scope LFS_TRACE_CONCAT(_lfs_trace_scope_, __LINE__)(::lfs::core::trace::Category::category, name)
+#define LFS_TRACE_THREAD_NAME(name) ::lfs::core::trace::set_thread_name(name)
+#else
+#define LFS_TRACE_SCOPE(category, name) ((void)0)
+#define LFS_TRACE_THREAD_NAME(name)     ((void)0)
+#endif
@@ -0,0 +1,256 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace lfs::core {
+
+    struct SnapshotStats {
+        uint64_t publishes = 0;
+        uint64_t skipped = 0; // Publish dropped because both buffers were pinned
+        double last_publish_ms = 0.0;
+        double max_publish_ms = 0.0;
+        double avg_publish_ms = 0.0;
+        uint64_t pins = 0;
+        uint64_t pin_retries = 0; // Pins that raced a publish and loaded the index again
+        double max_reader_wait_us = 0.0;
+        double avg_reader_wait_us = 0.0;
+        double activate_wait_ms = 0.0; // Last wait for direct readers to leave when publishing started
+    };
+
+    /**
+     * @brief Double-buffered, epoch-style publication of a value owned by one writer thread
+     *
+     * The writer copies its state into whichever buffer no reader holds and makes it
+     * current; readers pin the current buffer with two atomic operations and never
+     * wait for the writer. If a slow reader still holds the other buffer the publish
+     * is skipped rather than blocking the writer.
+     *
+     * While inactive nothing is published and pin() returns a "live" pin, meaning the
+     * source may be read directly. activate() waits for those direct readers to leave,
+     * so the writer may mutate its source as soon as it returns.
+     *
+     * Each publish carries a sequence number that increases by one per publish, since
+     * the two buffers alternate and a buffer address alone cannot tell snapshots apart.
+     *
+     * Writer-side calls (activate, deactivate, publish, reset) must come from one thread.
+     */
+    template <typename T>
+    class SnapshotPublisher {
+        struct Slot {
+            T value{};
+            uint64_t sequence = 0;
+            std::atomic<uint32_t> readers{0};
+        };
+
+    public:
+        class Pin {
+        public:
+            Pin() = default;
+            ~Pin() { release(); }
+
+            Pin(const Pin&) = delete;
+            Pin& operator=(const Pin&) = delete;
+
+            Pin(Pin&& other) noexcept
+                : readers_(std::exchange(other.readers_, nullptr)),
+                  value_(std::exchange(other.value_, nullptr)),
+                  sequence_(std::exchange(other.sequence_, 0)) {}
+
+            Pin& operator=(Pin&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    readers_ = std::exchange(other.readers_, nullptr);
+                    value_ = std::exchange(other.value_, nullptr);
+                    sequence_ = std::exchange(other.sequence_, 0);
+                }
+                return *this;
+            }
+
+            // Pinned snapshot, or nullptr when live or when nothing has been published yet
+            [[nodiscard]] const T* get() const { return value_; }
+            const T* operator->() const { return value_; }
+            // Publish number of the pinned snapshot, starting at 1; 0 when there is none
+            [[nodiscard]] uint64_t sequence() const { return sequence_; }
+            // Publishing is inactive and the source may be read directly while this pin is held
+            [[nodiscard]] bool live() const { return readers_ && !value_; }
+
+        private:
+            friend class SnapshotPublisher;
+
+            Pin(std::atomic<uint32_t>* readers, const T* value, const uint64_t sequence = 0)
+                : readers_(readers),
+                  value_(value),
+                  sequence_(sequence) {}
+
+            void release() {
+                if (readers_) {
+                    readers_->fetch_sub(1);
+                    readers_ = nullptr;
+                    value_ = nullptr;
+                    sequence_ = 0;
+                }
+            }
+
+            std::atomic<uint32_t>* readers_ = nullptr;
+            const T* value_ = nullptr;
+            uint64_t sequence_ = 0;
+        };
+
+        SnapshotPublisher() = default;
+        SnapshotPublisher(const SnapshotPublisher&) = delete;
+        SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+        // ========== Reader side (any thread) ==========
+
+        [[nodiscard]] Pin pin() const {
+            const auto start = std::chrono::steady_clock::now();
+            Pin result;
+            // Each attempt increments a counter and then re-checks the state it was chosen
+            // from; the writer changes that state before checking the counter (seq_cst),
+            // so one of the two always sees the other
+            for (;;) {
+                if (!active_.load()) {
+                    live_readers_.fetch_add(1);
+                    if (!active_.load()) {
+                        result = Pin(&live_readers_, nullptr);
+                        break;
+                    }
+                    live_readers_.fetch_sub(1);
+                } else {
+                    const int index = current_.load();
+                    if (index < 0)
+                        break;
+                    Slot& slot = slots_[index];
+                    slot.readers.fetch_add(1);
+                    if (current_.load() == index) {
+                        result = Pin(&slot.readers, &slot.value, slot.sequence);
+                        break;
+                    }
+                    slot.readers.fetch_sub(1);
+                }
+                pin_retries_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            const uint64_t wait_ns = elapsed_ns(start);
+            pins_.fetch_add(1, std::memory_order_relaxed);
+            reader_wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+            update_max(max_reader_wait_ns_, wait_ns);
+            return result;
+        }
+
+        // Ask the writer for a fresh snapshot at its next safe point
+        void request() const { requested_.store(true, std::memory_order_relaxed); }
+        [[nodiscard]] bool requested() const { return requested_.load(std::memory_order_relaxed); }
+        [[nodiscard]] bool active() const { return active_.load(); }
+
+        [[nodiscard]] SnapshotStats stats() const {
+            SnapshotStats s;
+            s.publishes = publishes_.load(std::memory_order_relaxed);
+            s.skipped = skipped_.load(std::memory_order_relaxed);
+            s.last_publish_ms = last_publish_ns_.load(std::memory_order_relaxed) * 1e-6;
+            s.max_publish_ms = max_publish_ns_.load(std::memory_order_relaxed) * 1e-6;
+            s.avg_publish_ms = s.publishes ? publish_ns_.load(std::memory_order_relaxed) * 1e-6 / s.publishes : 0.0;
+            s.pins = pins_.load(std::memory_order_relaxed);
+            s.pin_retries = pin_retries_.load(std::memory_order_relaxed);
+            s.max_reader_wait_us = max_reader_wait_ns_.load(std::memory_order_relaxed) * 1e-3;
+            s.avg_reader_wait_us = s.pins ? reader_wait_ns_.load(std::memory_order_relaxed) * 1e-3 / s.pins : 0.0;
+            s.activate_wait_ms = activate_wait_ns_.load(std::memory_order_relaxed) * 1e-6;
+            return s;
+        }
+
+        // ========== Writer side (one thread) ==========
+
+        // Start publishing; returns once no reader is using the source directly
+        void activate() {
+            const auto start = std::chrono::steady_clock::now();
+            active_.store(true);
+            while (live_readers_.load() != 0)
+                std::this_thread::yield();
+            activate_wait_ns_.store(elapsed_ns(start), std::memory_order_relaxed);
+        }
+
+        // Readers go back to the source; pinned snapshots stay valid until released
+        void deactivate() { active_.store(false); }
+
+        /**
+         * @brief Fill the free buffer with `fill(T&)` and make it current
+         *
+         * The buffer keeps its previous contents, so `fill` can update it in place.
+         * @return false if a reader still holds the free buffer (nothing published)
+         */
+        template <typename Fill>
+        bool publish(Fill&& fill) {
+            const auto start = std::chrono::steady_clock::now();
+            const int next = current_.load() == 0 ? 1 : 0;
+            Slot& slot = slots_[next];
+            if (slot.readers.load() != 0) {
+                skipped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            requested_.store(false, std::memory_order_relaxed);
+            std::forward<Fill>(fill)(slot.value);
+            slot.sequence = ++sequence_;
+            current_.store(next);
+
+            const uint64_t publish_ns = elapsed_ns(start);
+            publishes_.fetch_add(1, std::memory_order_relaxed);
+            publish_ns_.fetch_add(publish_ns, std::memory_order_relaxed);
+            last_publish_ns_.store(publish_ns, std::memory_order_relaxed);
+            update_max(max_publish_ns_, publish_ns);
+            return true;
+        }
+
+        // Drop both buffers (e.g. to free memory); waits for outstanding pins to be released
+        void reset() {
+            current_.store(-1);
+            for (auto& slot : slots_) {
+                while (slot.readers.load() != 0)
+                    std::this_thread::yield();
+                slot.value = T{};
+                slot.sequence = 0;
+            }
+        }
+
+    private:
+        static uint64_t elapsed_ns(const std::chrono::steady_clock::time_point start) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now() - start)
+                                             .count());
+        }
+
+        static void update_max(std::atomic<uint64_t>& target, const uint64_t value) {
+            uint64_t current = target.load(std::memory_order_relaxed);
+            while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        mutable std::array<Slot, 2> slots_;
+        std::atomic<int> current_{-1};
+        std::atomic<bool> active_{false};
+        uint64_t sequence_ = 0; // Last published sequence, writer only
+        mutable std::atomic<uint32_t> live_readers_{0};
+        mutable std::atomic<bool> requested_{false};
+
+        std::atomic<uint64_t> publishes_{0};
+        std::atomic<uint64_t> skipped_{0};
+        std::atomic<uint64_t> publish_ns_{0};
+        std::atomic<uint64_t> last_publish_ns_{0};
+        std::atomic<uint64_t> max_publish_ns_{0};
+        std::atomic<uint64_t> activate_wait_ns_{0};
+        mutable std::atomic<uint64_t> pins_{0};
+        mutable std::atomic<uint64_t> pin_retries_{0};
+        mutable std::atomic<uint64_t> reader_wait_ns_{0};
+        mutable std::atomic<uint64_t> max_reader_wait_ns_{0};
+    };
+
+} // namespace lfs::core
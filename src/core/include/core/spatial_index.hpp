@@ -0,0 +1,160 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "core/cuda/spatial_index.cuh"
+#include "core/tensor.hpp"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace lfs::core {
+
+    // How a query region relates to a node's bounds
+    enum class Coverage : uint8_t {
+        Outside,
+        Partial,
+        Inside
+    };
+
+    /// Box [min, max] in the frame given by `world_to_box` (affine; may include scale)
+    struct OrientedBox {
+        glm::mat4 world_to_box{1.0f};
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+
+        [[nodiscard]] bool contains(const glm::vec3& p) const;
+        [[nodiscard]] Coverage classify(const glm::vec3& bmin, const glm::vec3& bmax) const;
+    };
+
+    struct Sphere {
+        glm::vec3 center{0.0f};
+        float radius = 0.0f;
+
+        [[nodiscard]] bool contains(const glm::vec3& p) const;
+        [[nodiscard]] Coverage classify(const glm::vec3& bmin, const glm::vec3& bmax) const;
+    };
+
+    /// Six inward-facing planes (xyz = normal, w = offset); a point is inside when all are >= 0
+    struct Frustum {
+        glm::vec4 planes[6];
+
+        /// Extract planes from an OpenGL-convention view-projection matrix
+        static Frustum from_view_projection(const glm::mat4& view_projection);
+
+        [[nodiscard]] bool contains(const glm::vec3& p) const;
+        [[nodiscard]] Coverage classify(const glm::vec3& bmin, const glm::vec3& bmax) const;
+    };
+
+    struct RayHit {
+        uint32_t index;  // Gaussian index
+        float t;         // Distance along the (normalized) ray to the closest approach
+        float distance;  // Perpendicular distance from the ray
+    };
+
+    /**
+     * @brief Bounding volume hierarchy over gaussian means for region and picking queries
+     *
+     * Built on the host from a [N, 3] float tensor (downloaded if it lives on
+     * CUDA) by median splits along the longest axis, with up to LEAF_SIZE points
+     * per leaf. Points are stored in tree order, so every subtree covers one
+     * contiguous run and nodes fully inside a query are emitted without per-point
+     * tests.
+     *
+     * refit() keeps the topology and recomputes bounds for moved points, which
+     * is cheaper than a rebuild and stays correct, though queries slow down if
+     * points drift far. The point count must not change.
+     *
+     * Box masks requested on CUDA are answered on the device: the leaves, the
+     * tree-ordered points and the order are uploaded once per build or refit,
+     * and a kernel writes whole leaves inside or outside the box without point
+     * tests. Other queries run on the host.
+     *
+     * Queries are read-only and may run concurrently; build and refit may not.
+     */
+    class SpatialIndex {
+    public:
+        static constexpr uint32_t LEAF_SIZE = SPATIAL_LEAF_SIZE;
+
+        SpatialIndex() = default;
+        explicit SpatialIndex(const Tensor& means);
+
+        /**
+         * @brief Recompute bounds from `means`, keeping the tree
+         * @return false if the point count differs (rebuild instead)
+         */
+        bool refit(const Tensor& means);
+
+        // True if this index was built or last refit from the storage behind `means`
+        [[nodiscard]] bool built_from(const Tensor& means) const;
+
+        [[nodiscard]] size_t size() const { return order_.size(); }
+        [[nodiscard]] size_t node_count() const { return nodes_.size(); }
+        [[nodiscard]] bool empty() const { return order_.empty(); }
+
+        // Mean of all points, kept up to date by build and refit
+        [[nodiscard]] glm::vec3 centroid() const;
+
+        // Indices of all points inside the region, in no particular order
+        [[nodiscard]] std::vector<uint32_t> query(const OrientedBox& box) const;
+        [[nodiscard]] std::vector<uint32_t> query(const Sphere& sphere) const;
+        [[nodiscard]] std::vector<uint32_t> query(const Frustum& frustum) const;
+
+        // Bool [N] membership mask on `device`
+        [[nodiscard]] Tensor query_mask(const OrientedBox& box, Device device = Device::CPU) const;
+        [[nodiscard]] Tensor query_mask(const Sphere& sphere, Device device = Device::CPU) const;
+        [[nodiscard]] Tensor query_mask(const Frustum& frustum, Device device = Device::CPU) const;
+
+        /**
+         * @brief Nearest point along a ray within `radius` of it
+         * @param direction Need not be normalized
+         * @param max_t Ignore points farther along the ray than this
+         */
+        [[nodiscard]] std::optional<RayHit> raycast(const glm::vec3& origin, const glm::vec3& direction,
+                                                    float radius, float max_t = 1e30f) const;
+
+    private:
+        struct Node {
+            glm::vec3 min;
+            uint32_t first; // First point (in tree order) of the subtree
+            glm::vec3 max;
+            uint32_t count; // Points in the subtree
+            uint32_t left;  // Children are left and left + 1; 0 for leaves
+
+            [[nodiscard]] bool is_leaf() const { return left == 0; }
+        };
+
+        void build(const float* xyz, size_t n);
+        void refit_bounds();
+        void update_sum();
+        // Upload the device mirror used by CUDA box queries; false if it can't hold this index
+        bool upload_to_device() const;
+
+        template <typename Region, typename Sink>
+        void traverse(const Region& region, uint32_t root, Sink&& sink) const;
+
+        template <typename Region>
+        std::vector<uint32_t> collect(const Region& region) const;
+
+        template <typename Region>
+        Tensor mask(const Region& region, Device device) const;
+
+        std::vector<Node> nodes_;
+        std::vector<glm::vec3> points_; // Positions in tree order
+        std::vector<uint32_t> order_;   // Tree order -> original index
+        Tensor source_;                 // Keeps the source storage alive so its address stays unique
+        glm::dvec3 sum_{0.0};
+
+        // Device mirror for query_mask(OrientedBox, CUDA), dropped by build and refit
+        mutable std::mutex device_mutex_;
+        mutable Tensor device_leaves_; // SpatialIndexLeaf records as Int32 [leaves, 8]
+        mutable Tensor device_points_; // Float32 [N, 3] in tree order
+        mutable Tensor device_order_;  // Int32 [N]
+        mutable size_t device_leaf_count_ = 0;
+    };
+
+} // namespace lfs::core
@@ -10,6 +10,7 @@
 #include <expected>
 #include <filesystem>
 #include <glm/fwd.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -23,6 +24,8 @@ namespace lfs::core {
         struct TrainingParameters;
     }
 
+    class SpatialIndex;
+
     /**
      * @brief Core data structure for Gaussian splat representation
      *
@@ -106,6 +109,16 @@ namespace lfs::core {
         // Returns number of gaussians removed
         size_t apply_deleted();
 
+        // ========== Spatial queries ==========
+        // BVH over the means, built on first use and rebuilt when they are replaced.
+        // Not thread-safe: do not call while another thread modifies this SplatData.
+        const SpatialIndex& spatial_index() const;
+        // True if spatial_index() would return without building or refitting
+        bool has_spatial_index() const;
+        // Call after moving means in place (optimizer step, mirror) so the next query refits
+        void mark_positions_changed() { _spatial_index_stale = true; }
+        void invalidate_spatial_index() { _spatial_index.reset(); }
+
         // ========== Capacity management ==========
         // Reserve capacity for parameter tensors (for MCMC densification)
         void reserve_capacity(size_t capacity);
@@ -117,7 +130,7 @@ namespace lfs::core {
 
         // ========== Serialization ==========
         void serialize(std::ostream& os) const;
-        void deserialize(std::istream& is);
+        void deserialize(std::istream& is, Device device = Device::CUDA);
 
     public:
         // Holds the magnitude of the screen space gradient (used for densification)
@@ -139,6 +152,10 @@ namespace lfs::core {
         // Soft deletion mask: bool tensor [N], true = hidden from rendering
         Tensor _deleted;
 
+        // Lazily built, see spatial_index()
+        mutable std::shared_ptr<SpatialIndex> _spatial_index;
+        mutable bool _spatial_index_stale = false;
+
         // Allow free functions in splat_data_export.cpp and splat_data_transform.cpp
         // to access private members
         friend void save_ply(const SplatData&, const std::filesystem::path&, int, bool, std::string);
@@ -19,6 +19,10 @@ namespace lfs::core {
 
     /**
      * @brief Apply a transformation matrix to SplatData
+     *
+     * Means, rotations, log-scales and shN are rewritten in place in a single pass on the
+     * tensors' device, so other tensors sharing their storage see the change. Non-uniform
+     * scale is applied to means only; gaussians get the average scale.
      * @param splat_data The splat data to transform (modified in-place)
      * @param transform_matrix 4x4 transformation matrix
      * @return Reference to the modified splat_data
@@ -0,0 +1,141 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "core/tensor.hpp"
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lfs::core {
+
+    class MappedFile;
+
+    /**
+     * @file tensor_archive.hpp
+     * @brief Indexed container of named tensors with a footer table of contents
+     *
+     * Layout:
+     * ┌─────────────────────────────────────────────────────────────────┐
+     * │ [Optional] prefix written by the caller (e.g. a file header)   │
+     * ├─────────────────────────────────────────────────────────────────┤
+     * │ Entry data, each starting on a 64-byte file offset             │
+     * ├─────────────────────────────────────────────────────────────────┤
+     * │ TOC, one record per entry                                      │
+     * │   - name_len: uint16, name: char[name_len]                     │
+     * │   - dtype: uint8, codec: uint8 (0 = stored, 1 = zstd)          │
+     * │   - rank: uint16, dims: uint64[rank]                           │
+     * │   - offset, stored_size, raw_size: uint64                      │
+     * │   - crc32 of the raw bytes: uint32                             │
+     * ├─────────────────────────────────────────────────────────────────┤
+     * │ Footer (24 bytes)                                              │
+     * │   - toc_offset, toc_size: uint64                               │
+     * │   - version: uint32 = 1, magic: uint32 = 0x4C465441 ("LFTA")   │
+     * └─────────────────────────────────────────────────────────────────┘
+     *
+     * Offsets are absolute file offsets, so the TOC is found from the end
+     * of the file and any entry can be read without touching the others.
+     */
+
+    constexpr uint32_t TENSOR_ARCHIVE_MAGIC = 0x4C465441; // "LFTA"
+    constexpr uint32_t TENSOR_ARCHIVE_VERSION = 1;
+    constexpr size_t TENSOR_ARCHIVE_ALIGNMENT = 64;
+
+    enum class TensorCodec : uint8_t {
+        Stored = 0,
+        Zstd = 1,
+    };
+
+    struct TensorArchiveEntry {
+        std::string name;
+        DataType dtype = DataType::UInt8;
+        std::vector<size_t> shape; // Raw byte entries are UInt8 [raw_size]
+        TensorCodec codec = TensorCodec::Stored;
+        uint64_t offset = 0;
+        uint64_t stored_size = 0;
+        uint64_t raw_size = 0;
+        uint32_t crc32 = 0;
+    };
+
+    struct TensorArchiveWriteOptions {
+        bool compress = false;     // zstd per entry; stored entries can be mapped without a copy
+        int compression_level = 1;
+    };
+
+    /**
+     * @brief Appends entries to a stream and writes the TOC on finish()
+     *
+     * The stream must be seekable for tellp(); anything already written to it
+     * is left in front of the first entry.
+     */
+    class TensorArchiveWriter {
+    public:
+        explicit TensorArchiveWriter(std::ostream& os, TensorArchiveWriteOptions options = {});
+
+        /// Store a CPU tensor (made contiguous if needed)
+        const TensorArchiveEntry& add(std::string name, const Tensor& tensor);
+
+        /// Store raw bytes; `compress` further restricts the writer's option
+        const TensorArchiveEntry& add_bytes(std::string name, std::span<const char> bytes, bool compress = true);
+
+        /// Write TOC and footer; returns false if any write failed
+        bool finish();
+
+        [[nodiscard]] const std::vector<TensorArchiveEntry>& entries() const { return entries_; }
+        [[nodiscard]] uint64_t stored_bytes() const { return stored_bytes_; }
+
+    private:
+        const TensorArchiveEntry& write_entry(TensorArchiveEntry entry, const char* data, bool compress);
+
+        std::ostream& os_;
+        TensorArchiveWriteOptions options_;
+        std::vector<TensorArchiveEntry> entries_;
+        std::vector<char> scratch_;
+        uint64_t stored_bytes_ = 0;
+    };
+
+    /**
+     * @brief Read-only view of an archive through a memory mapping
+     *
+     * Only the footer and TOC are parsed on open. Stored entries load as
+     * zero-copy CPU tensors that keep the mapping alive; compressed entries
+     * are decoded into fresh memory. Every load verifies the entry's CRC.
+     *
+     * Implements TensorRecordSource with the entry index, so streams holding
+     * TENSOR_REF_VERSION records can be deserialized straight from it.
+     */
+    class TensorArchive : public TensorRecordSource {
+    public:
+        static std::expected<std::shared_ptr<TensorArchive>, std::string> open(const std::filesystem::path& path);
+
+        [[nodiscard]] const std::vector<TensorArchiveEntry>& entries() const { return entries_; }
+        [[nodiscard]] const TensorArchiveEntry* find(std::string_view name) const;
+
+        /// Bytes in front of the first entry (caller's prefix)
+        [[nodiscard]] std::span<const char> prefix() const;
+
+        /// Throws std::runtime_error on a bad index or a corrupt entry
+        Tensor load(size_t index) const;
+        std::vector<char> read_bytes(size_t index) const;
+        std::vector<char> read_bytes(std::string_view name) const;
+
+        Tensor get(uint64_t index) override { return load(static_cast<size_t>(index)); }
+
+    private:
+        TensorArchive() = default;
+
+        std::span<const char> stored_span(const TensorArchiveEntry& entry) const;
+
+        std::shared_ptr<MappedFile> file_;
+        std::vector<TensorArchiveEntry> entries_;
+        uint64_t data_begin_ = 0;
+    };
+
+} // namespace lfs::core
@@ -0,0 +1,483 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/knn.hpp"
+#include "core/logger.hpp"
+#include "nanoflann.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_sort.h>
+
+namespace lfs::core {
+
+    namespace {
+
+        // Shells of cells searched around a query before it is handed to the tree
+        constexpr int GRID_MAX_RING = 3;
+        // Points expected in the cell of a typical point, itself included
+        constexpr double GRID_CELL_OCCUPANCY = 3.0;
+        // Morton keys interleave 21 bits per axis
+        constexpr uint32_t GRID_AXIS_CELLS = 1u << 21;
+        constexpr size_t QUERY_GRAIN = 1024;
+
+        /// Ascending fixed-capacity neighbor list; doubles as a nanoflann result set
+        class NeighborSet {
+        public:
+            using DistanceType = float;
+
+            NeighborSet(const int k, const size_t self, const float min_distance_sq)
+                : k_(k),
+                  self_(self),
+                  min_distance_sq_(min_distance_sq) {}
+
+            bool addPoint(const float d2, const size_t index) {
+                // Rejects NaN as well as anything not closer than the current worst
+                if (index == self_ || d2 <= min_distance_sq_ || !(d2 < worstDist()))
+                    return true;
+                int i = count_ < k_ ? count_++ : k_ - 1;
+                while (i > 0 && dist_[i - 1] > d2) {
+                    dist_[i] = dist_[i - 1];
+                    index_[i] = index_[i - 1];
+                    --i;
+                }
+                dist_[i] = d2;
+                index_[i] = static_cast<uint32_t>(index);
+                return true;
+            }
+
+            [[nodiscard]] float worstDist() const {
+                return count_ < k_ ? std::numeric_limits<float>::max() : dist_[k_ - 1];
+            }
+            [[nodiscard]] bool full() const { return count_ == k_; }
+            void sort() {} // Always sorted
+
+            [[nodiscard]] int size() const { return count_; }
+            [[nodiscard]] float distance_sq(const int i) const { return dist_[i]; }
+            [[nodiscard]] uint32_t index(const int i) const { return index_[i]; }
+
+        private:
+            std::array<float, KNN_MAX_K> dist_;
+            std::array<uint32_t, KNN_MAX_K> index_;
+            int count_ = 0;
+            int k_;
+            size_t self_;
+            float min_distance_sq_;
+        };
+
+        struct CloudAdaptor {
+            const float* xyz;
+            size_t n;
+
+            [[nodiscard]] size_t kdtree_get_point_count() const { return n; }
+            [[nodiscard]] float kdtree_get_pt(const size_t idx, const size_t dim) const { return xyz[idx * 3 + dim]; }
+            template <class BBOX>
+            bool kdtree_get_bbox(BBOX& /* bb */) const { return false; }
+        };
+
+        using KdTree = nanoflann::KDTreeSingleIndexAdaptor<
+            nanoflann::L2_Simple_Adaptor<float, CloudAdaptor>, CloudAdaptor, 3>;
+
+        std::unique_ptr<KdTree> build_tree(const CloudAdaptor& cloud) {
+            LOG_TIMER_TRACE("knn: k-d tree build");
+            // The constructor builds the index; n_thread_build = 0 uses every core
+            return std::make_unique<KdTree>(
+                3, cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10, nanoflann::KDTreeSingleIndexAdaptorFlags::None, 0));
+        }
+
+        uint64_t spread_bits(uint64_t v) {
+            v &= 0x1fffff;
+            v = (v | v << 32) & 0x1f00000000ffffull;
+            v = (v | v << 16) & 0x1f0000ff0000ffull;
+            v = (v | v << 8) & 0x100f00f00f00f00full;
+            v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+            v = (v | v << 2) & 0x1249249249249249ull;
+            return v;
+        }
+
+        uint64_t morton_key(const uint32_t x, const uint32_t y, const uint32_t z) {
+            return spread_bits(x) | spread_bits(y) << 1 | spread_bits(z) << 2;
+        }
+
+        struct Bounds {
+            std::array<float, 3> lo{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                                    std::numeric_limits<float>::max()};
+            std::array<float, 3> hi{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                                    std::numeric_limits<float>::lowest()};
+        };
+
+        bool is_finite_point(const float* p) {
+            return std::isfinite(p[0]) && std::isfinite(p[1]) && std::isfinite(p[2]);
+        }
+
+        /**
+         * Points bucketed into uniform cells and stored in Morton order of their
+         * cell, with an open-addressing table from cell key to its run. Queries
+         * visit shells of cells outward until no unvisited cell can hold a closer
+         * point than the current k-th neighbor.
+         */
+        class UniformGrid {
+        public:
+            struct Point {
+                float x, y, z;
+                uint32_t index;
+            };
+
+            UniformGrid(const float* xyz, const size_t n) {
+                const auto bounds = tbb::parallel_reduce(
+                    tbb::blocked_range<size_t>(0, n), Bounds{},
+                    [&](const tbb::blocked_range<size_t>& range, Bounds b) {
+                        for (size_t i = range.begin(); i < range.end(); ++i) {
+                            const float* const p = xyz + i * 3;
+                            if (!is_finite_point(p))
+                                continue;
+                            for (int a = 0; a < 3; ++a) {
+                                b.lo[a] = std::min(b.lo[a], p[a]);
+                                b.hi[a] = std::max(b.hi[a], p[a]);
+                            }
+                        }
+                        return b;
+                    },
+                    [](Bounds a, const Bounds& b) {
+                        for (int i = 0; i < 3; ++i) {
+                            a.lo[i] = std::min(a.lo[i], b.lo[i]);
+                            a.hi[i] = std::max(a.hi[i], b.hi[i]);
+                        }
+                        return a;
+                    });
+
+                double full_extent = 0.0;
+                for (int a = 0; a < 3; ++a) {
+                    origin_[a] = bounds.lo[a] <= bounds.hi[a] ? bounds.lo[a] : 0.0;
+                    full_extent = std::max(full_extent, static_cast<double>(bounds.hi[a]) - bounds.lo[a]);
+                }
+                cell_size_ = choose_cell_size(xyz, n, full_extent);
+                inv_cell_size_ = 1.0 / cell_size_;
+
+                std::vector<std::pair<uint64_t, uint32_t>> keyed(n);
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+                    for (size_t i = range.begin(); i < range.end(); ++i) {
+                        const auto c = cell_of(xyz + i * 3);
+                        keyed[i] = {morton_key(c[0], c[1], c[2]), static_cast<uint32_t>(i)};
+                    }
+                });
+                tbb::parallel_sort(keyed.begin(), keyed.end());
+
+                points_.resize(n);
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+                    for (size_t i = range.begin(); i < range.end(); ++i) {
+                        const float* const p = xyz + static_cast<size_t>(keyed[i].second) * 3;
+                        points_[i] = {p[0], p[1], p[2], keyed[i].second};
+                    }
+                });
+
+                std::vector<uint64_t> cell_keys;
+                for (size_t i = 0; i < n; ++i) {
+                    if (i == 0 || keyed[i].first != keyed[i - 1].first) {
+                        cell_keys.push_back(keyed[i].first);
+                        cell_start_.push_back(static_cast<uint32_t>(i));
+                    }
+                }
+                cell_start_.push_back(static_cast<uint32_t>(n));
+                keyed = {};
+
+                const size_t capacity = std::bit_ceil(std::max<size_t>(2 * cell_keys.size(), 16));
+                slot_mask_ = capacity - 1;
+                slot_shift_ = 64 - std::countr_zero(capacity);
+                slot_keys_.assign(capacity, 0);
+                slot_cells_.resize(capacity);
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, cell_keys.size()), [&](const tbb::blocked_range<size_t>& range) {
+                    for (size_t c = range.begin(); c < range.end(); ++c) {
+                        const uint64_t stored = cell_keys[c] + 1; // 0 marks an empty slot
+                        for (uint64_t slot = hash(cell_keys[c]);; slot = (slot + 1) & slot_mask_) {
+                            uint64_t expected = 0;
+                            if (std::atomic_ref(slot_keys_[slot]).compare_exchange_strong(expected, stored)) {
+                                slot_cells_[slot] = static_cast<uint32_t>(c);
+                                break;
+                            }
+                        }
+                    }
+                });
+
+                LOG_DEBUG("knn grid: {} points, {} cells, cell size {:.4g}", n, cell_keys.size(), cell_size_);
+            }
+
+            [[nodiscard]] const std::vector<Point>& points() const { return points_; }
+
+            /// Fills `set` for `p`; false if the answer is not certain within GRID_MAX_RING shells
+            bool query(const Point& p, NeighborSet& set) const {
+                if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z))
+                    return false;
+
+                const float q[3] = {p.x, p.y, p.z};
+                const auto center = cell_of(q);
+
+                // Distance from the query to the nearest face of its own cell
+                double gap = cell_size_;
+                for (int a = 0; a < 3; ++a) {
+                    const double f = (q[a] - origin_[a]) * inv_cell_size_ - center[a];
+                    gap = std::min(gap, std::min(f, 1.0 - f) * cell_size_);
+                }
+                gap = std::max(gap, 0.0);
+                for (int r = 0; r <= GRID_MAX_RING; ++r) {
+                    for (int dz = -r; dz <= r; ++dz) {
+                        for (int dy = -r; dy <= r; ++dy) {
+                            // Interior rows of the shell only contribute their two end cells
+                            const int step = (std::abs(dz) == r || std::abs(dy) == r) ? 1 : std::max(2 * r, 1);
+                            for (int dx = -r; dx <= r; dx += step) {
+                                const int64_t x = static_cast<int64_t>(center[0]) + dx;
+                                const int64_t y = static_cast<int64_t>(center[1]) + dy;
+                                const int64_t z = static_cast<int64_t>(center[2]) + dz;
+                                if (x < 0 || y < 0 || z < 0 || x >= GRID_AXIS_CELLS || y >= GRID_AXIS_CELLS || z >= GRID_AXIS_CELLS)
+                                    continue;
+                                visit_cell(morton_key(static_cast<uint32_t>(x), static_cast<uint32_t>(y), static_cast<uint32_t>(z)), q, set);
+                            }
+                        }
+                    }
+
+                    // Every unvisited cell is at least r cells beyond the query's own
+                    const double bound = (r * cell_size_ + gap) * (1.0 - 1e-6);
+                    if (set.full() && set.worstDist() <= bound * bound)
+                        return true;
+                }
+                return false;
+            }
+
+        private:
+            static double choose_cell_size(const float* xyz, const size_t n, const double full_extent) {
+                if (!(full_extent > 0.0))
+                    return 1.0;
+                const double min_cell = full_extent / (GRID_AXIS_CELLS - 1);
+
+                constexpr size_t MAX_SAMPLES = 1 << 16;
+                const size_t stride = std::max<size_t>(1, n / MAX_SAMPLES);
+                std::vector<std::array<float, 3>> samples;
+                samples.reserve(n / stride + 1);
+                for (size_t i = 0; i < n; i += stride) {
+                    const float* const p = xyz + i * 3;
+                    if (is_finite_point(p))
+                        samples.push_back({p[0], p[1], p[2]});
+                }
+                if (samples.size() < 2)
+                    return std::max(1.0, min_cell);
+
+                // Captures are dense surfaces with sparse surroundings, so size cells by the
+                // occupancy a typical point sees (estimated on the sample), not by volume
+                const double scale = static_cast<double>(n - 1) / static_cast<double>(samples.size() - 1);
+                double cell = full_extent / std::cbrt(static_cast<double>(n) / GRID_CELL_OCCUPANCY);
+                std::unordered_map<uint64_t, uint32_t> counts;
+                for (int iteration = 0; iteration < 8 && cell > min_cell; ++iteration) {
+                    counts.clear();
+                    const double inv_cell = 1.0 / cell;
+                    for (const auto& p : samples) {
+                        const auto x = static_cast<uint64_t>(static_cast<int64_t>(std::floor(p[0] * inv_cell)));
+                        const auto y = static_cast<uint64_t>(static_cast<int64_t>(std::floor(p[1] * inv_cell)));
+                        const auto z = static_cast<uint64_t>(static_cast<int64_t>(std::floor(p[2] * inv_cell)));
+                        ++counts[x * 0x9E3779B97F4A7C15ull ^ y * 0xC2B2AE3D27D4EB4Full ^ z * 0x165667B19E3779F9ull];
+                    }
+                    double pairs = 0.0;
+                    for (const auto& [key, count] : counts)
+                        pairs += static_cast<double>(count) * (count - 1);
+                    // Expected points in the cell of a random point, itself included
+                    const double occupancy = 1.0 + pairs / static_cast<double>(samples.size()) * scale;
+                    const double factor = std::clamp(std::cbrt(GRID_CELL_OCCUPANCY / occupancy), 0.125, 2.0);
+                    cell *= factor;
+                    if (std::abs(factor - 1.0) < 0.1)
+                        break;
+                }
+                return std::max(cell, min_cell);
+            }
+
+            [[nodiscard]] std::array<uint32_t, 3> cell_of(const float* p) const {
+                std::array<uint32_t, 3> c{};
+                for (int a = 0; a < 3; ++a) {
+                    const double f = std::floor((p[a] - origin_[a]) * inv_cell_size_);
+                    // Also maps NaN to cell 0
+                    c[a] = f > 0.0 ? static_cast<uint32_t>(std::min(f, static_cast<double>(GRID_AXIS_CELLS - 1))) : 0u;
+                }
+                return c;
+            }
+
+            [[nodiscard]] uint64_t hash(const uint64_t key) const {
+                return key * 0x9E3779B97F4A7C15ull >> slot_shift_;
+            }
+
+            void visit_cell(const uint64_t key, const float* q, NeighborSet& set) const {
+                for (uint64_t slot = hash(key);; slot = (slot + 1) & slot_mask_) {
+                    const uint64_t stored = slot_keys_[slot];
+                    if (stored == 0)
+                        return;
+                    if (stored == key + 1) {
+                        const uint32_t cell = slot_cells_[slot];
+                        for (uint32_t i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+                            const Point& p = points_[i];
+                            // Same evaluation order as nanoflann's L2_Simple_Adaptor
+                            const float d0 = q[0] - p.x;
+                            const float d1 = q[1] - p.y;
+                            const float d2 = q[2] - p.z;
+                            set.addPoint(d0 * d0 + d1 * d1 + d2 * d2, p.index);
+                        }
+                        return;
+                    }
+                }
+            }
+
+            std::array<double, 3> origin_{};
+            double cell_size_ = 1.0;
+            double inv_cell_size_ = 1.0;
+            std::vector<Point> points_;        // Sorted by cell key
+            std::vector<uint32_t> cell_start_; // Cell c holds points_[cell_start_[c], cell_start_[c + 1])
+            std::vector<uint64_t> slot_keys_;  // Cell key + 1, 0 when empty
+            std::vector<uint32_t> slot_cells_;
+            uint64_t slot_mask_ = 0;
+            int slot_shift_ = 64;
+        };
+
+        template <typename Sink>
+        void search_tree(const KdTree& tree, const float* xyz, const size_t num_queries, const uint32_t* query_indices,
+                         const int k, const float min_distance_sq, Sink& sink) {
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, num_queries, QUERY_GRAIN), [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t q = range.begin(); q < range.end(); ++q) {
+                    const size_t i = query_indices ? query_indices[q] : q;
+                    NeighborSet set(k, i, min_distance_sq);
+                    tree.findNeighbors(set, xyz + i * 3);
+                    sink(i, set);
+                }
+            });
+        }
+
+        /// Calls sink(i, set) once per point, concurrently for different points
+        template <typename Sink>
+        void search(const float* xyz, const size_t n, const int k, const KnnOptions& options, Sink&& sink) {
+            const auto start = std::chrono::steady_clock::now();
+            const CloudAdaptor cloud{xyz, n};
+
+            const bool use_grid = options.method == KnnMethod::Grid && k <= KNN_GRID_MAX_K && n > static_cast<size_t>(k);
+
+            size_t tree_queries = n;
+            if (use_grid) {
+                const UniformGrid grid(xyz, n);
+                const auto& points = grid.points();
+                std::vector<uint8_t> unresolved(n, 0);
+
+                // Grid order keeps neighboring queries on the same cells
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, n, QUERY_GRAIN), [&](const tbb::blocked_range<size_t>& range) {
+                    for (size_t j = range.begin(); j < range.end(); ++j) {
+                        const auto& p = points[j];
+                        NeighborSet set(k, p.index, options.min_distance_sq);
+                        if (grid.query(p, set)) {
+                            sink(p.index, set);
+                        } else {
+                            unresolved[p.index] = 1;
+                        }
+                    }
+                });
+
+                std::vector<uint32_t> remaining;
+                for (size_t i = 0; i < n; ++i) {
+                    if (unresolved[i])
+                        remaining.push_back(static_cast<uint32_t>(i));
+                }
+                tree_queries = remaining.size();
+                if (!remaining.empty()) {
+                    const auto tree = build_tree(cloud);
+                    search_tree(*tree, xyz, remaining.size(), remaining.data(), k, options.min_distance_sq, sink);
+                }
+            } else {
+                const auto tree = build_tree(cloud);
+                search_tree(*tree, xyz, n, nullptr, k, options.min_distance_sq, sink);
+            }
+
+            LOG_PERF("kNN ({}, k={}): {} points in {:.1f} ms, {} via k-d tree",
+                     use_grid ? "grid" : "k-d tree", k, n,
+                     std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                     tree_queries);
+        }
+
+        Tensor host_points(const Tensor& points) {
+            if (!points.is_valid() || points.ndim() != 2 || points.size(1) != 3) {
+                LOG_ERROR("Input points must have shape [N, 3], got {}", points.is_valid() ? points.shape().str() : "invalid");
+                return {};
+            }
+            if (points.dtype() != DataType::Float32) {
+                LOG_ERROR("Input points must be float32");
+                return {};
+            }
+            if (points.size(0) >= std::numeric_limits<uint32_t>::max()) {
+                LOG_ERROR("kNN: {} points exceed the 32-bit index range", points.size(0));
+                return {};
+            }
+            return points.device() == Device::CPU ? points.contiguous() : points.cpu().contiguous();
+        }
+
+    } // namespace
+
+    KnnResult knn_self(const Tensor& points, const int k, const KnnOptions& options) {
+        if (k < 1 || k > KNN_MAX_K) {
+            LOG_ERROR("knn_self: k must be in [1, {}], got {}", KNN_MAX_K, k);
+            return {};
+        }
+        const auto host = host_points(points);
+        if (!host.is_valid())
+            return {};
+
+        const size_t n = host.size(0);
+        KnnResult result{
+            Tensor::empty({n, static_cast<size_t>(k)}, Device::CPU, DataType::Int32),
+            Tensor::empty({n, static_cast<size_t>(k)}, Device::CPU, DataType::Float32)};
+        if (n == 0)
+            return result;
+
+        int32_t* const indices = result.indices.ptr<int32_t>();
+        float* const distances = result.distances_sq.ptr<float>();
+        search(host.ptr<float>(), n, k, options, [&](const size_t i, const NeighborSet& set) {
+            int32_t* const row_indices = indices + i * k;
+            float* const row_distances = distances + i * k;
+            for (int j = 0; j < k; ++j) {
+                const bool found = j < set.size();
+                row_indices[j] = found ? static_cast<int32_t>(set.index(j)) : -1;
+                row_distances[j] = found ? set.distance_sq(j) : std::numeric_limits<float>::infinity();
+            }
+        });
+        return result;
+    }
+
+    Tensor mean_neighbor_distance(const Tensor& points, const int k, const KnnMethod method) {
+        if (k < 1 || k > KNN_MAX_K) {
+            LOG_ERROR("mean_neighbor_distance: k must be in [1, {}], got {}", KNN_MAX_K, k);
+            return {};
+        }
+        const auto host = host_points(points);
+        if (!host.is_valid())
+            return {};
+
+        const size_t n = host.size(0);
+        if (n <= 1)
+            return Tensor::full({n}, 0.01f, points.device());
+
+        auto result = Tensor::empty({n}, Device::CPU, DataType::Float32);
+        float* const out = result.ptr<float>();
+        search(host.ptr<float>(), n, k, {.method = method, .min_distance_sq = 1e-8f},
+               [&](const size_t i, const NeighborSet& set) {
+                   float sum = 0.0f;
+                   for (int j = 0; j < set.size(); ++j)
+                       sum += std::sqrt(set.distance_sq(j));
+                   out[i] = set.size() > 0 ? sum / static_cast<float>(set.size()) : 0.01f;
+               });
+        return result.to(points.device());
+    }
+
+} // namespace lfs::core
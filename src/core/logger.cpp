@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "core/logger.hpp"
+#include "core/perf_trace.hpp"
 #include <array>
 #include <cstdio>
 #include <mutex>
@@ -197,6 +198,24 @@ namespace lfs::core {
             return LogModule::Unknown;
         }
 
+#if LFS_PERF_TRACING
+        trace::Category trace_category(const std::string_view path) {
+            switch (detect_module(path)) {
+            case LogModule::Rendering:
+            case LogModule::Visualizer:
+            case LogModule::GUI:
+            case LogModule::Window: return trace::Category::Rendering;
+            case LogModule::Loader: return trace::Category::Loader;
+            case LogModule::Training: return trace::Category::Training;
+            default: break;
+            }
+            if (path.find("/io/") != std::string_view::npos || path.find("\\io\\") != std::string_view::npos ||
+                path.find("image_io") != std::string_view::npos)
+                return trace::Category::IO;
+            return trace::Category::Core;
+        }
+#endif
+
         constexpr spdlog::level::level_enum to_spdlog_level(const LogLevel level) {
             switch (level) {
             case LogLevel::Trace: return spdlog::level::trace;
@@ -309,13 +328,22 @@ namespace lfs::core {
     }
 
     ScopedTimer::ScopedTimer(std::string name, const LogLevel level, const std::source_location loc)
-        : start_(std::chrono::high_resolution_clock::now()),
+        : start_(std::chrono::steady_clock::now()),
           name_(std::move(name)),
           level_(level),
           loc_(loc) {}
 
     ScopedTimer::~ScopedTimer() {
-        const auto duration = std::chrono::high_resolution_clock::now() - start_;
+        const auto end = std::chrono::steady_clock::now();
+#if LFS_PERF_TRACING
+        if (trace::enabled()) {
+            const auto to_ns = [](const auto t) {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+            };
+            trace::record(trace_category(loc_.file_name()), name_, to_ns(start_), to_ns(end));
+        }
+#endif
+        const auto duration = end - start_;
         const auto ms = std::chrono::duration<double, std::milli>(duration).count();
         char buf[64];
         std::snprintf(buf, sizeof(buf), "%s took %.2fms", name_.c_str(), ms);
@@ -0,0 +1,112 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/mapped_file.hpp"
+#include "core/logger.hpp"
+#include "core/path_utils.hpp"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lfs::core {
+
+#ifdef _WIN32
+    std::shared_ptr<MappedFile> MappedFile::open(const std::filesystem::path& path, Access access) {
+        const DWORD flags = access == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                            : access == Access::Random   ? FILE_FLAG_RANDOM_ACCESS
+                                                         : FILE_ATTRIBUTE_NORMAL;
+        HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                  nullptr, OPEN_EXISTING, flags, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            LOG_ERROR("Failed to open file for mapping: {}", path_to_utf8(path));
+            return nullptr;
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size)) {
+            LOG_ERROR("Failed to get file size: {}", path_to_utf8(path));
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        std::shared_ptr<MappedFile> mapped(new MappedFile());
+        mapped->size_ = static_cast<size_t>(file_size.QuadPart);
+        if (mapped->size_ == 0) {
+            // Zero-length mappings are rejected by Windows
+            CloseHandle(file);
+            return mapped;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            LOG_ERROR("Failed to create file mapping: {}", path_to_utf8(path));
+            return nullptr;
+        }
+
+        // The view keeps the mapping object alive
+        mapped->data_ = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!mapped->data_) {
+            LOG_ERROR("Failed to map view of file: {}", path_to_utf8(path));
+            return nullptr;
+        }
+        return mapped;
+    }
+
+    MappedFile::~MappedFile() {
+        if (data_)
+            UnmapViewOfFile(data_);
+    }
+#else
+    std::shared_ptr<MappedFile> MappedFile::open(const std::filesystem::path& path, Access access) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            LOG_ERROR("Failed to open file for mapping: {}", path_to_utf8(path));
+            return nullptr;
+        }
+
+        struct stat st {};
+        if (fstat(fd, &st) < 0) {
+            LOG_ERROR("Failed to stat file: {}", path_to_utf8(path));
+            close(fd);
+            return nullptr;
+        }
+
+        std::shared_ptr<MappedFile> mapped(new MappedFile());
+        mapped->size_ = static_cast<size_t>(st.st_size);
+        if (mapped->size_ == 0) {
+            close(fd);
+            return mapped;
+        }
+
+        void* data = mmap(nullptr, mapped->size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd); // The mapping holds its own reference to the file
+        if (data == MAP_FAILED) {
+            LOG_ERROR("Failed to mmap file: {}", path_to_utf8(path));
+            return nullptr;
+        }
+        mapped->data_ = data;
+
+        if (access == Access::Sequential) {
+            madvise(data, mapped->size_, MADV_SEQUENTIAL);
+        } else if (access == Access::Random) {
+            madvise(data, mapped->size_, MADV_RANDOM);
+        }
+        return mapped;
+    }
+
+    MappedFile::~MappedFile() {
+        if (data_)
+            munmap(data_, size_);
+    }
+#endif
+
+} // namespace lfs::core
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <string>
@@ -172,4 +173,23 @@ namespace lfs::core {
         return open_file_for_read(path, std::ios::in, stream);
     }
 
+    /**
+     * @brief Root of LichtFeld's scratch files: caches, decoded packs, thumbnails
+     *
+     * %TEMP% (or %TMP%) on Windows, /tmp elsewhere, plus "LichtFeld". The folder
+     * is not created here.
+     */
+    inline std::filesystem::path lichtfeld_temp_folder() {
+        std::filesystem::path temp_base;
+#ifdef _WIN32
+        const char* temp = std::getenv("TEMP");
+        if (!temp)
+            temp = std::getenv("TMP");
+        temp_base = temp ? temp : "C:/Temp";
+#else
+        temp_base = "/tmp";
+#endif
+        return temp_base / "LichtFeld";
+    }
+
 } // namespace lfs::core
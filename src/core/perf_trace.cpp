@@ -0,0 +1,275 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/perf_trace.hpp"
+#include "core/logger.hpp"
+#include "core/path_utils.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lfs::core::trace {
+
+    namespace detail {
+        std::atomic<bool> g_enabled{false};
+    }
+
+    namespace {
+
+        constexpr int TRACE_PID = 1;
+
+        struct Event {
+            int64_t start_ns;
+            int64_t duration_ns;
+            char name[MAX_EVENT_NAME];
+            Category category;
+            uint8_t name_length;
+        };
+        static_assert(sizeof(Event) == 64);
+
+        // Written only by its owning thread; the spin lock is uncontended except while a dump copies it out
+        struct ThreadBuffer {
+            std::vector<Event> ring;
+            uint64_t written = 0;
+            uint32_t tid = 0;
+            std::string name;
+            std::atomic<bool> locked{false};
+
+            void lock() {
+                while (locked.exchange(true, std::memory_order_acquire))
+                    std::this_thread::yield();
+            }
+            void unlock() { locked.store(false, std::memory_order_release); }
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+            size_t events_per_thread = DEFAULT_EVENTS_PER_THREAD;
+            uint32_t next_tid = 1;
+            int64_t epoch_ns = 0;
+            std::filesystem::path output;
+            bool exit_hook_installed = false;
+        };
+
+        Registry& registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        // Bumped by clear() so threads drop their cached buffer
+        std::atomic<uint32_t> g_generation{0};
+
+        thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+        thread_local uint32_t t_generation = 0;
+        thread_local std::string t_name;
+
+        ThreadBuffer& thread_buffer() {
+            const uint32_t generation = g_generation.load(std::memory_order_relaxed);
+            if (t_buffer && t_generation == generation)
+                return *t_buffer;
+
+            auto buffer = std::make_shared<ThreadBuffer>();
+            auto& reg = registry();
+            std::lock_guard lock(reg.mutex);
+            buffer->ring.resize(std::max<size_t>(reg.events_per_thread, 1));
+            buffer->tid = reg.next_tid++;
+            buffer->name = t_name.empty() ? std::format("thread {}", buffer->tid) : t_name;
+            reg.buffers.push_back(buffer);
+            t_buffer = std::move(buffer);
+            t_generation = generation;
+            return *t_buffer;
+        }
+
+        std::string escape_json(const std::string_view s) {
+            std::string out;
+            out.reserve(s.size());
+            for (const char c : s) {
+                switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        out += std::format("\\u{:04x}", static_cast<int>(c));
+                    } else {
+                        out += c;
+                    }
+                }
+            }
+            return out;
+        }
+
+        void dump_at_exit() {
+            if (stats().events > 0)
+                dump();
+        }
+
+    } // namespace
+
+    const char* category_name(const Category category) {
+        switch (category) {
+        case Category::Core: return "core";
+        case Category::IO: return "io";
+        case Category::Loader: return "loader";
+        case Category::Training: return "training";
+        case Category::Export: return "export";
+        case Category::Rendering: return "rendering";
+        default: return "unknown";
+        }
+    }
+
+    void start(const size_t events_per_thread) {
+        auto& reg = registry();
+        {
+            std::lock_guard lock(reg.mutex);
+            reg.events_per_thread = events_per_thread;
+            if (reg.epoch_ns == 0)
+                reg.epoch_ns = now_ns();
+        }
+        detail::g_enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void stop() {
+        detail::g_enabled.store(false, std::memory_order_relaxed);
+    }
+
+    void clear() {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        reg.buffers.clear();
+        reg.epoch_ns = now_ns();
+        g_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void set_output(const std::filesystem::path& path) {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        reg.output = path;
+        // registry() is constructed first, so it is still alive when the hook runs
+        if (!reg.exit_hook_installed) {
+            std::atexit(dump_at_exit);
+            reg.exit_hook_installed = true;
+        }
+    }
+
+    void set_thread_name(const std::string_view name) {
+        t_name = name;
+        if (t_buffer && t_generation == g_generation.load(std::memory_order_relaxed)) {
+            t_buffer->lock();
+            t_buffer->name = t_name;
+            t_buffer->unlock();
+        }
+    }
+
+    void record(const Category category, const std::string_view name, const int64_t start_ns, const int64_t end_ns) {
+        if (!enabled())
+            return;
+
+        ThreadBuffer& buffer = thread_buffer();
+        const size_t length = std::min(name.size(), MAX_EVENT_NAME);
+
+        buffer.lock();
+        Event& event = buffer.ring[buffer.written % buffer.ring.size()];
+        event.start_ns = start_ns;
+        event.duration_ns = end_ns - start_ns;
+        std::memcpy(event.name, name.data(), length);
+        event.name_length = static_cast<uint8_t>(length);
+        event.category = category;
+        ++buffer.written;
+        buffer.unlock();
+    }
+
+    TraceStats stats() {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        TraceStats s;
+        s.threads = reg.buffers.size();
+        for (const auto& buffer : reg.buffers) {
+            buffer->lock();
+            const size_t held = std::min<uint64_t>(buffer->written, buffer->ring.size());
+            s.events += held;
+            s.dropped += buffer->written - held;
+            buffer->unlock();
+        }
+        return s;
+    }
+
+    bool write_chrome_trace(const std::filesystem::path& path) {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        int64_t epoch_ns = 0;
+        {
+            auto& reg = registry();
+            std::lock_guard lock(reg.mutex);
+            buffers = reg.buffers;
+            epoch_ns = reg.epoch_ns;
+        }
+
+        std::ofstream out;
+        if (!open_file_for_write(path, std::ios::binary, out)) {
+            LOG_ERROR("Failed to open trace output: {}", path_to_utf8(path));
+            return false;
+        }
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << std::format("{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":{},\"args\":{{\"name\":\"LichtFeld Studio\"}}}}",
+                           TRACE_PID);
+
+        size_t total = 0;
+        std::vector<Event> events;
+        for (const auto& buffer : buffers) {
+            // Copy out under the lock, then format without holding up the recording thread
+            buffer->lock();
+            const size_t capacity = buffer->ring.size();
+            const size_t held = std::min<uint64_t>(buffer->written, capacity);
+            const size_t first = static_cast<size_t>((buffer->written - held) % capacity);
+            events.resize(held);
+            for (size_t i = 0; i < held; ++i)
+                events[i] = buffer->ring[(first + i) % capacity];
+            const std::string name = buffer->name;
+            buffer->unlock();
+
+            out << std::format(",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+                               TRACE_PID, buffer->tid, escape_json(name));
+            for (const auto& event : events) {
+                out << std::format(",\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":{},\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                   escape_json({event.name, event.name_length}), category_name(event.category),
+                                   TRACE_PID, buffer->tid,
+                                   static_cast<double>(event.start_ns - epoch_ns) * 1e-3,
+                                   static_cast<double>(event.duration_ns) * 1e-3);
+            }
+            total += held;
+        }
+        out << "\n]}\n";
+        out.close();
+
+        if (!out) {
+            LOG_ERROR("Failed to write trace: {}", path_to_utf8(path));
+            return false;
+        }
+        LOG_INFO("Trace written: {} ({} events, {} threads)", path_to_utf8(path), total, buffers.size());
+        return true;
+    }
+
+    bool dump() {
+        std::filesystem::path output;
+        {
+            auto& reg = registry();
+            std::lock_guard lock(reg.mutex);
+            output = reg.output;
+        }
+        if (output.empty())
+            return false;
+        return write_chrome_trace(output);
+    }
+
+} // namespace lfs::core::trace
@@ -0,0 +1,517 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/spatial_index.hpp"
+#include "core/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace lfs::core {
+
+    namespace {
+
+        // Subtrees at least this large are built as separate OpenMP tasks
+        constexpr uint32_t PARALLEL_BUILD_MIN = 1u << 16;
+        // Queries fan out over about this many subtrees
+        constexpr size_t QUERY_SUBTREES = 256;
+        constexpr float COVERAGE_EPS = SPATIAL_COVERAGE_EPS;
+
+        struct BuildItem {
+            glm::vec3 p;
+            uint32_t index;
+        };
+
+        float max_abs(const glm::vec3& v) {
+            return std::max({std::abs(v.x), std::abs(v.y), std::abs(v.z)});
+        }
+
+        Tensor host_means(const Tensor& means) {
+            if (!means.is_valid() || means.ndim() != 2 || means.size(1) != 3 || means.dtype() != DataType::Float32) {
+                LOG_ERROR("SpatialIndex expects [N, 3] float32 means");
+                return {};
+            }
+            return means.device() == Device::CPU ? means.contiguous() : means.cpu().contiguous();
+        }
+
+    } // namespace
+
+    // ========== Regions ==========
+
+    bool OrientedBox::contains(const glm::vec3& p) const {
+        // Same evaluation order as the tensor path: M * [x, y, z, 1]
+        const glm::vec3 local(world_to_box * glm::vec4(p, 1.0f));
+        return local.x >= min.x && local.y >= min.y && local.z >= min.z &&
+               local.x <= max.x && local.y <= max.y && local.z <= max.z;
+    }
+
+    Coverage OrientedBox::classify(const glm::vec3& bmin, const glm::vec3& bmax) const {
+        // Bounds of the node in box space: transformed center +- projected half extents
+        const glm::vec3 center = 0.5f * (bmin + bmax);
+        const glm::vec3 half = 0.5f * (bmax - bmin);
+        const glm::vec3 local_center(world_to_box * glm::vec4(center, 1.0f));
+        const glm::mat3 linear(world_to_box);
+        const glm::vec3 local_half = glm::abs(linear[0]) * half.x + glm::abs(linear[1]) * half.y + glm::abs(linear[2]) * half.z;
+        const glm::vec3 lo = local_center - local_half;
+        const glm::vec3 hi = local_center + local_half;
+        const float slack = COVERAGE_EPS * (1.0f + max_abs(local_center) + max_abs(local_half) + max_abs(min) + max_abs(max));
+
+        if (glm::any(glm::lessThan(hi, min - slack)) || glm::any(glm::greaterThan(lo, max + slack)))
+            return Coverage::Outside;
+        if (glm::all(glm::greaterThanEqual(lo, min + slack)) && glm::all(glm::lessThanEqual(hi, max - slack)))
+            return Coverage::Inside;
+        return Coverage::Partial;
+    }
+
+    bool Sphere::contains(const glm::vec3& p) const {
+        const glm::vec3 d = p - center;
+        return glm::dot(d, d) <= radius * radius;
+    }
+
+    Coverage Sphere::classify(const glm::vec3& bmin, const glm::vec3& bmax) const {
+        const float r2 = radius * radius;
+        const float slack = COVERAGE_EPS * (r2 + 1.0f);
+
+        const glm::vec3 nearest = glm::clamp(center, bmin, bmax) - center;
+        if (glm::dot(nearest, nearest) > r2 + slack)
+            return Coverage::Outside;
+
+        const glm::vec3 farthest = glm::max(glm::abs(bmin - center), glm::abs(bmax - center));
+        if (glm::dot(farthest, farthest) < r2 - slack)
+            return Coverage::Inside;
+        return Coverage::Partial;
+    }
+
+    Frustum Frustum::from_view_projection(const glm::mat4& vp) {
+        // Gribb-Hartmann: combine rows of the clip matrix (glm is column-major)
+        const auto row = [&](const int i) { return glm::vec4(vp[0][i], vp[1][i], vp[2][i], vp[3][i]); };
+        Frustum f{};
+        f.planes[0] = row(3) + row(0); // Left
+        f.planes[1] = row(3) - row(0); // Right
+        f.planes[2] = row(3) + row(1); // Bottom
+        f.planes[3] = row(3) - row(1); // Top
+        f.planes[4] = row(3) + row(2); // Near
+        f.planes[5] = row(3) - row(2); // Far
+        for (auto& plane : f.planes) {
+            const float len = glm::length(glm::vec3(plane));
+            if (len > 0.0f)
+                plane /= len;
+        }
+        return f;
+    }
+
+    bool Frustum::contains(const glm::vec3& p) const {
+        for (const auto& plane : planes) {
+            if (glm::dot(glm::vec3(plane), p) + plane.w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    Coverage Frustum::classify(const glm::vec3& bmin, const glm::vec3& bmax) const {
+        const glm::vec3 extent = glm::max(glm::abs(bmin), glm::abs(bmax));
+        bool inside = true;
+        for (const auto& plane : planes) {
+            const glm::vec3 n(plane);
+            const float slack = COVERAGE_EPS * (1.0f + std::abs(plane.w) + glm::dot(glm::abs(n), extent));
+            // Corners farthest along and against the normal
+            const glm::vec3 positive = glm::mix(bmin, bmax, glm::vec3(glm::greaterThanEqual(n, glm::vec3(0.0f))));
+            const glm::vec3 negative = glm::mix(bmax, bmin, glm::vec3(glm::greaterThanEqual(n, glm::vec3(0.0f))));
+            if (glm::dot(n, positive) + plane.w < -slack)
+                return Coverage::Outside;
+            if (glm::dot(n, negative) + plane.w < slack)
+                inside = false;
+        }
+        return inside ? Coverage::Inside : Coverage::Partial;
+    }
+
+    // ========== Build ==========
+
+    SpatialIndex::SpatialIndex(const Tensor& means) {
+        LOG_TIMER_TRACE("SpatialIndex::build");
+        const auto host = host_means(means);
+        if (!host.is_valid())
+            return;
+        if (host.size(0) >= std::numeric_limits<uint32_t>::max()) {
+            LOG_ERROR("SpatialIndex: {} points exceed the 32-bit index range", host.size(0));
+            return;
+        }
+        source_ = means;
+        build(host.ptr<float>(), host.size(0));
+    }
+
+    void SpatialIndex::build(const float* xyz, const size_t n) {
+        if (n == 0)
+            return;
+
+        std::vector<BuildItem> items(n);
+        const auto num = static_cast<int64_t>(n);
+#pragma omp parallel for if (num > 65536)
+        for (int64_t i = 0; i < num; ++i) {
+            items[i] = {{xyz[i * 3 + 0], xyz[i * 3 + 1], xyz[i * 3 + 2]}, static_cast<uint32_t>(i)};
+        }
+
+        // Every leaf holds at least LEAF_SIZE / 2 points, so this bounds the node count
+        nodes_.resize(2 * (2 * n / LEAF_SIZE + 1) + 1);
+        std::atomic<uint32_t> next_node{1};
+
+        // Median split along the longest axis of the node's bounds
+        const auto build_node = [&](auto&& self, const uint32_t node_index, const uint32_t first, const uint32_t count) -> void {
+            glm::vec3 lo(std::numeric_limits<float>::max());
+            glm::vec3 hi(std::numeric_limits<float>::lowest());
+            for (uint32_t i = first; i < first + count; ++i) {
+                lo = glm::min(lo, items[i].p);
+                hi = glm::max(hi, items[i].p);
+            }
+
+            Node& node = nodes_[node_index];
+            node = {lo, first, hi, count, 0};
+            if (count <= LEAF_SIZE)
+                return;
+
+            const glm::vec3 extent = hi - lo;
+            const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+            const uint32_t half = count / 2;
+            std::nth_element(items.begin() + first, items.begin() + first + half, items.begin() + first + count,
+                             [axis](const BuildItem& a, const BuildItem& b) { return a.p[axis] < b.p[axis]; });
+
+            const uint32_t left = next_node.fetch_add(2);
+            node.left = left;
+
+            if (count >= PARALLEL_BUILD_MIN) {
+#pragma omp task default(shared) firstprivate(left, first, half)
+                self(self, left, first, half);
+#pragma omp task default(shared) firstprivate(left, first, half, count)
+                self(self, left + 1, first + half, count - half);
+#pragma omp taskwait
+            } else {
+                self(self, left, first, half);
+                self(self, left + 1, first + half, count - half);
+            }
+        };
+
+#pragma omp parallel if (n >= PARALLEL_BUILD_MIN)
+#pragma omp single
+        build_node(build_node, 0, 0, static_cast<uint32_t>(n));
+
+        nodes_.resize(next_node.load());
+        nodes_.shrink_to_fit();
+
+        points_.resize(n);
+        order_.resize(n);
+#pragma omp parallel for if (num > 65536)
+        for (int64_t i = 0; i < num; ++i) {
+            points_[i] = items[i].p;
+            order_[i] = items[i].index;
+        }
+        update_sum();
+
+        LOG_DEBUG("SpatialIndex: {} points, {} nodes", n, nodes_.size());
+    }
+
+    bool SpatialIndex::refit(const Tensor& means) {
+        LOG_TIMER_TRACE("SpatialIndex::refit");
+        const auto host = host_means(means);
+        if (!host.is_valid() || host.size(0) != order_.size())
+            return false;
+
+        const float* const xyz = host.ptr<float>();
+        const auto num = static_cast<int64_t>(order_.size());
+#pragma omp parallel for if (num > 65536)
+        for (int64_t i = 0; i < num; ++i) {
+            const size_t src = order_[i];
+            points_[i] = {xyz[src * 3 + 0], xyz[src * 3 + 1], xyz[src * 3 + 2]};
+        }
+
+        refit_bounds();
+        update_sum();
+        source_ = means;
+        return true;
+    }
+
+    void SpatialIndex::refit_bounds() {
+        const auto num_nodes = static_cast<int64_t>(nodes_.size());
+#pragma omp parallel for schedule(dynamic, 256) if (num_nodes > 1024)
+        for (int64_t i = 0; i < num_nodes; ++i) {
+            Node& node = nodes_[i];
+            if (!node.is_leaf())
+                continue;
+            glm::vec3 lo(std::numeric_limits<float>::max());
+            glm::vec3 hi(std::numeric_limits<float>::lowest());
+            for (uint32_t j = node.first; j < node.first + node.count; ++j) {
+                lo = glm::min(lo, points_[j]);
+                hi = glm::max(hi, points_[j]);
+            }
+            node.min = lo;
+            node.max = hi;
+        }
+
+        // Children are always allocated after their parent
+        for (int64_t i = num_nodes - 1; i >= 0; --i) {
+            Node& node = nodes_[i];
+            if (node.is_leaf())
+                continue;
+            node.min = glm::min(nodes_[node.left].min, nodes_[node.left + 1].min);
+            node.max = glm::max(nodes_[node.left].max, nodes_[node.left + 1].max);
+        }
+    }
+
+    void SpatialIndex::update_sum() {
+        const auto num = static_cast<int64_t>(points_.size());
+        double sx = 0.0, sy = 0.0, sz = 0.0;
+#pragma omp parallel for reduction(+ : sx, sy, sz) if (num > 65536)
+        for (int64_t i = 0; i < num; ++i) {
+            sx += points_[i].x;
+            sy += points_[i].y;
+            sz += points_[i].z;
+        }
+        sum_ = {sx, sy, sz};
+
+        std::lock_guard lock(device_mutex_);
+        device_leaves_ = Tensor();
+        device_points_ = Tensor();
+        device_order_ = Tensor();
+        device_leaf_count_ = 0;
+    }
+
+    glm::vec3 SpatialIndex::centroid() const {
+        return order_.empty() ? glm::vec3(0.0f) : glm::vec3(sum_ / static_cast<double>(order_.size()));
+    }
+
+    bool SpatialIndex::built_from(const Tensor& means) const {
+        return means.is_valid() && source_.is_valid() && means.data_ptr() == source_.data_ptr() &&
+               means.device() == source_.device() && means.ndim() == 2 && means.size(0) == order_.size();
+    }
+
+    // ========== Queries ==========
+
+    template <typename Region, typename Sink>
+    void SpatialIndex::traverse(const Region& region, const uint32_t root, Sink&& sink) const {
+        uint32_t stack[64];
+        int top = 0;
+        stack[top++] = root;
+        while (top > 0) {
+            const Node& node = nodes_[stack[--top]];
+            const Coverage coverage = region.classify(node.min, node.max);
+            if (coverage == Coverage::Outside)
+                continue;
+            if (coverage == Coverage::Inside) {
+                sink(node.first, node.first + node.count);
+                continue;
+            }
+            if (node.is_leaf()) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    if (region.contains(points_[i]))
+                        sink(i, i + 1);
+                }
+                continue;
+            }
+            stack[top++] = node.left;
+            stack[top++] = node.left + 1;
+        }
+    }
+
+    namespace {
+
+        // Disjoint subtrees covering all points, for splitting a query across threads
+        template <typename Nodes>
+        std::vector<uint32_t> split_subtrees(const Nodes& nodes) {
+            std::vector<uint32_t> frontier = {0};
+            while (frontier.size() < QUERY_SUBTREES) {
+                std::vector<uint32_t> next;
+                next.reserve(frontier.size() * 2);
+                bool expanded = false;
+                for (const uint32_t i : frontier) {
+                    if (nodes[i].is_leaf()) {
+                        next.push_back(i);
+                    } else {
+                        next.push_back(nodes[i].left);
+                        next.push_back(nodes[i].left + 1);
+                        expanded = true;
+                    }
+                }
+                frontier = std::move(next);
+                if (!expanded)
+                    break;
+            }
+            return frontier;
+        }
+
+    } // namespace
+
+    template <typename Region>
+    std::vector<uint32_t> SpatialIndex::collect(const Region& region) const {
+        if (nodes_.empty())
+            return {};
+
+        const auto subtrees = split_subtrees(nodes_);
+        std::vector<std::vector<uint32_t>> partial(subtrees.size());
+#pragma omp parallel for schedule(dynamic)
+        for (int64_t s = 0; s < static_cast<int64_t>(subtrees.size()); ++s) {
+            auto& out = partial[s];
+            traverse(region, subtrees[s], [&](const uint32_t begin, const uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i)
+                    out.push_back(order_[i]);
+            });
+        }
+
+        size_t total = 0;
+        for (const auto& p : partial)
+            total += p.size();
+        std::vector<uint32_t> result;
+        result.reserve(total);
+        for (const auto& p : partial)
+            result.insert(result.end(), p.begin(), p.end());
+        return result;
+    }
+
+    template <typename Region>
+    Tensor SpatialIndex::mask(const Region& region, const Device device) const {
+        auto result = Tensor::zeros({order_.size()}, Device::CPU, DataType::Bool);
+        if (nodes_.empty())
+            return device == Device::CPU ? result : result.to(device);
+
+        bool* const out = result.ptr<bool>();
+        const auto subtrees = split_subtrees(nodes_);
+#pragma omp parallel for schedule(dynamic)
+        for (int64_t s = 0; s < static_cast<int64_t>(subtrees.size()); ++s) {
+            traverse(region, subtrees[s], [&](const uint32_t begin, const uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i)
+                    out[order_[i]] = true;
+            });
+        }
+        return device == Device::CPU ? result : result.to(device);
+    }
+
+    std::vector<uint32_t> SpatialIndex::query(const OrientedBox& box) const { return collect(box); }
+    std::vector<uint32_t> SpatialIndex::query(const Sphere& sphere) const { return collect(sphere); }
+    std::vector<uint32_t> SpatialIndex::query(const Frustum& frustum) const { return collect(frustum); }
+
+    bool SpatialIndex::upload_to_device() const {
+        static_assert(sizeof(glm::vec3) == 3 * sizeof(float));
+        static_assert(sizeof(SpatialIndexLeaf) == 8 * sizeof(int32_t));
+
+        std::lock_guard lock(device_mutex_);
+        if (device_order_.is_valid())
+            return true;
+        if (order_.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+            return false;
+
+        std::vector<SpatialIndexLeaf> leaves;
+        leaves.reserve(nodes_.size() / 2 + 1);
+        for (const Node& node : nodes_) {
+            if (node.is_leaf())
+                leaves.push_back({{node.min.x, node.min.y, node.min.z}, node.first,
+                                  {node.max.x, node.max.y, node.max.z}, node.count});
+        }
+
+        const size_t n = order_.size();
+        device_leaves_ = Tensor::from_blob(leaves.data(), TensorShape({leaves.size(), 8}), Device::CPU, DataType::Int32)
+                             .to(Device::CUDA);
+        device_points_ = Tensor::from_blob(const_cast<glm::vec3*>(points_.data()), TensorShape({n, 3}), Device::CPU,
+                                           DataType::Float32)
+                             .to(Device::CUDA);
+        // Original indices fit in int32 after the size check above
+        device_order_ = Tensor::from_blob(const_cast<uint32_t*>(order_.data()), TensorShape({n}), Device::CPU,
+                                          DataType::Int32)
+                            .to(Device::CUDA);
+        device_leaf_count_ = leaves.size();
+        return true;
+    }
+
+    Tensor SpatialIndex::query_mask(const OrientedBox& box, const Device device) const {
+        if (device != Device::CUDA || nodes_.empty() || !upload_to_device())
+            return mask(box, device);
+
+        SpatialBoxQuery query{};
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r)
+                query.world_to_box[c * 4 + r] = box.world_to_box[c][r];
+        }
+        for (int k = 0; k < 3; ++k) {
+            query.min[k] = box.min[k];
+            query.max[k] = box.max[k];
+        }
+
+        auto result = Tensor::empty({order_.size()}, Device::CUDA, DataType::Bool);
+        spatial_box_mask_cuda(query, reinterpret_cast<const SpatialIndexLeaf*>(device_leaves_.ptr<int32_t>()),
+                              device_leaf_count_, device_points_.ptr<float>(), device_order_.ptr<int32_t>(),
+                              result.ptr<bool>());
+        return result;
+    }
+    Tensor SpatialIndex::query_mask(const Sphere& sphere, const Device device) const { return mask(sphere, device); }
+    Tensor SpatialIndex::query_mask(const Frustum& frustum, const Device device) const { return mask(frustum, device); }
+
+    std::optional<RayHit> SpatialIndex::raycast(const glm::vec3& origin, const glm::vec3& direction,
+                                                const float radius, const float max_t) const {
+        const float len = glm::length(direction);
+        if (nodes_.empty() || len == 0.0f)
+            return std::nullopt;
+        const glm::vec3 dir = direction / len;
+        // Huge instead of inf keeps 0 * inv finite for axis-parallel rays
+        glm::vec3 inv_dir;
+        for (int k = 0; k < 3; ++k)
+            inv_dir[k] = dir[k] != 0.0f ? 1.0f / dir[k] : 1e30f;
+        const float r2 = radius * radius;
+
+        // Entry distance into a node's bounds grown by the pick radius, or +inf on a miss
+        const auto enter = [&](const Node& node, const float limit) {
+            const glm::vec3 t0 = (node.min - radius - origin) * inv_dir;
+            const glm::vec3 t1 = (node.max + radius - origin) * inv_dir;
+            const glm::vec3 near = glm::min(t0, t1);
+            const glm::vec3 far = glm::max(t0, t1);
+            const float t_enter = std::max({near.x, near.y, near.z, 0.0f});
+            const float t_exit = std::min({far.x, far.y, far.z, limit});
+            return t_enter <= t_exit ? t_enter : std::numeric_limits<float>::infinity();
+        };
+
+        std::optional<RayHit> best;
+        float best_t = max_t;
+
+        struct Entry {
+            uint32_t node;
+            float t;
+        };
+        Entry stack[64];
+        int top = 0;
+        if (const float t = enter(nodes_[0], best_t); t != std::numeric_limits<float>::infinity())
+            stack[top++] = {0, t};
+
+        while (top > 0) {
+            const Entry entry = stack[--top];
+            if (entry.t > best_t)
+                continue;
+            const Node& node = nodes_[entry.node];
+
+            if (node.is_leaf()) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    const glm::vec3 v = points_[i] - origin;
+                    const float t = glm::dot(v, dir);
+                    if (t < 0.0f || t > best_t)
+                        continue;
+                    const float perp2 = std::max(glm::dot(v, v) - t * t, 0.0f);
+                    if (perp2 <= r2 && (!best || t < best_t || (t == best_t && order_[i] < best->index))) {
+                        best = RayHit{order_[i], t, std::sqrt(perp2)};
+                        best_t = t;
+                    }
+                }
+                continue;
+            }
+
+            // Push the farther child first so the nearer one is visited next
+            const float t_left = enter(nodes_[node.left], best_t);
+            const float t_right = enter(nodes_[node.left + 1], best_t);
+            const bool left_first = t_left <= t_right;
+            const Entry near_child{left_first ? node.left : node.left + 1, left_first ? t_left : t_right};
+            const Entry far_child{left_first ? node.left + 1 : node.left, left_first ? t_right : t_left};
+            if (far_child.t != std::numeric_limits<float>::infinity())
+                stack[top++] = far_child;
+            if (near_child.t != std::numeric_limits<float>::infinity())
+                stack[top++] = near_child;
+        }
+        return best;
+    }
+
+} // namespace lfs::core
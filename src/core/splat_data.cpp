@@ -3,106 +3,18 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "core/splat_data.hpp"
+#include "core/knn.hpp"
 #include "core/logger.hpp"
 #include "core/parameters.hpp"
 #include "core/point_cloud.hpp"
+#include "core/spatial_index.hpp"
 #include "core/tensor/internal/tensor_serialization.hpp"
-#include "nanoflann.hpp"
 
 #include <cmath>
 #include <expected>
 #include <format>
 #include <vector>
 
-namespace {
-
-    // Point cloud adaptor for nanoflann
-    struct PointCloudAdaptor {
-        const float* points;
-        size_t num_points;
-
-        PointCloudAdaptor(const float* pts, size_t n)
-            : points(pts),
-              num_points(n) {}
-
-        inline size_t kdtree_get_point_count() const { return num_points; }
-
-        inline float kdtree_get_pt(const size_t idx, const size_t dim) const {
-            return points[idx * 3 + dim];
-        }
-
-        template <class BBOX>
-        bool kdtree_get_bbox(BBOX& /* bb */) const { return false; }
-    };
-
-    using KDTree = nanoflann::KDTreeSingleIndexAdaptor<
-        nanoflann::L2_Simple_Adaptor<float, PointCloudAdaptor>,
-        PointCloudAdaptor,
-        3>;
-
-    /**
-     * @brief Compute mean distance to 3 nearest neighbors for each point
-     */
-    lfs::core::Tensor compute_mean_neighbor_distances(const lfs::core::Tensor& points) {
-        auto cpu_points = points.cpu();
-        const int num_points = cpu_points.size(0);
-
-        if (cpu_points.ndim() != 2 || cpu_points.size(1) != 3) {
-            LOG_ERROR("Input points must have shape [N, 3], got {}", cpu_points.shape().str());
-            return lfs::core::Tensor();
-        }
-
-        if (cpu_points.dtype() != lfs::core::DataType::Float32) {
-            LOG_ERROR("Input points must be float32");
-            return lfs::core::Tensor();
-        }
-
-        if (num_points <= 1) {
-            return lfs::core::Tensor::full({static_cast<size_t>(num_points)}, 0.01f, points.device());
-        }
-
-        const float* data = cpu_points.ptr<float>();
-
-        PointCloudAdaptor cloud(data, num_points);
-        KDTree index(3, cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10));
-        index.buildIndex();
-
-        auto result = lfs::core::Tensor::zeros({static_cast<size_t>(num_points)}, lfs::core::Device::CPU);
-        float* result_data = result.ptr<float>();
-
-#pragma omp parallel for if (num_points > 1000)
-        for (int i = 0; i < num_points; i++) {
-            const float query_pt[3] = {
-                data[i * 3 + 0],
-                data[i * 3 + 1],
-                data[i * 3 + 2]};
-
-            const size_t num_results = std::min(4, num_points);
-            std::vector<size_t> ret_indices(num_results);
-            std::vector<float> out_dists_sqr(num_results);
-
-            nanoflann::KNNResultSet<float> resultSet(num_results);
-            resultSet.init(&ret_indices[0], &out_dists_sqr[0]);
-            index.findNeighbors(resultSet, &query_pt[0], nanoflann::SearchParameters(10));
-
-            float sum_dist = 0.0f;
-            int valid_neighbors = 0;
-
-            for (size_t j = 0; j < num_results && valid_neighbors < 3; j++) {
-                if (out_dists_sqr[j] > 1e-8f) {
-                    sum_dist += std::sqrt(out_dists_sqr[j]);
-                    valid_neighbors++;
-                }
-            }
-
-            result_data[i] = (valid_neighbors > 0) ? (sum_dist / valid_neighbors) : 0.01f;
-        }
-
-        return result.to(points.device());
-    }
-
-} // anonymous namespace
-
 namespace lfs::core {
 
     // ========== CONSTRUCTOR & DESTRUCTOR ==========
@@ -141,7 +53,9 @@ namespace lfs::core {
           _rotation(std::move(other._rotation)),
           _opacity(std::move(other._opacity)),
           _densification_info(std::move(other._densification_info)),
-          _deleted(std::move(other._deleted)) {
+          _deleted(std::move(other._deleted)),
+          _spatial_index(std::move(other._spatial_index)),
+          _spatial_index_stale(other._spatial_index_stale) {
         // Reset the moved-from object
         other._active_sh_degree = 0;
         other._max_sh_degree = 0;
@@ -164,6 +78,8 @@ namespace lfs::core {
             _opacity = std::move(other._opacity);
             _densification_info = std::move(other._densification_info);
             _deleted = std::move(other._deleted);
+            _spatial_index = std::move(other._spatial_index);
+            _spatial_index_stale = other._spatial_index_stale;
         }
         return *this;
     }
@@ -348,6 +264,7 @@ namespace lfs::core {
         }
 
         // Commit the changes
+        invalidate_spatial_index();
         _means = std::move(new_means);
         _sh0 = std::move(new_sh0);
         _scaling = std::move(new_scaling);
@@ -369,6 +286,22 @@ namespace lfs::core {
         return removed;
     }
 
+    // ========== SPATIAL QUERIES ==========
+
+    const SpatialIndex& SplatData::spatial_index() const {
+        if (!_spatial_index || !_spatial_index->built_from(_means)) {
+            _spatial_index = std::make_shared<SpatialIndex>(_means);
+        } else if (_spatial_index_stale && !_spatial_index->refit(_means)) {
+            _spatial_index = std::make_shared<SpatialIndex>(_means);
+        }
+        _spatial_index_stale = false;
+        return *_spatial_index;
+    }
+
+    bool SplatData::has_spatial_index() const {
+        return _spatial_index && !_spatial_index_stale && _spatial_index->built_from(_means);
+    }
+
     // ========== SERIALIZATION ==========
 
     namespace {
@@ -405,7 +338,7 @@ namespace lfs::core {
         LOG_DEBUG("Serialized SplatData: {} Gaussians, SH {}/{}", size(), _active_sh_degree, _max_sh_degree);
     }
 
-    void SplatData::deserialize(std::istream& is) {
+    void SplatData::deserialize(std::istream& is, const Device device) {
         uint32_t magic = 0, version = 0;
         is.read(reinterpret_cast<char*>(&magic), sizeof(magic));
         is.read(reinterpret_cast<char*>(&version), sizeof(version));
@@ -426,11 +359,15 @@ namespace lfs::core {
         Tensor means, sh0, scaling, rotation, opacity;
         is >> means >> sh0 >> scaling >> rotation >> opacity;
 
-        _means = std::move(means).cuda();
-        _sh0 = std::move(sh0).cuda();
-        _scaling = std::move(scaling).cuda();
-        _rotation = std::move(rotation).cuda();
-        _opacity = std::move(opacity).cuda();
+        // Tensors are read into host memory; .to() would clone when already there
+        const auto place = [device](Tensor&& t) { return device == Device::CPU ? std::move(t) : t.to(device); };
+
+        invalidate_spatial_index();
+        _means = place(std::move(means));
+        _sh0 = place(std::move(sh0));
+        _scaling = place(std::move(scaling));
+        _rotation = place(std::move(rotation));
+        _opacity = place(std::move(opacity));
         _active_sh_degree = active_sh;
         _max_sh_degree = max_sh;
         _scene_scale = scene_scale;
@@ -438,7 +375,7 @@ namespace lfs::core {
         if (max_sh > 0) {
             Tensor shN;
             is >> shN;
-            _shN = std::move(shN).cuda();
+            _shN = place(std::move(shN));
         }
 
         uint8_t has_deleted = 0;
@@ -446,7 +383,7 @@ namespace lfs::core {
         if (has_deleted) {
             Tensor deleted;
             is >> deleted;
-            _deleted = std::move(deleted).cuda();
+            _deleted = place(std::move(deleted));
         }
 
         uint8_t has_densification = 0;
@@ -454,7 +391,7 @@ namespace lfs::core {
         if (has_densification) {
             Tensor densification;
             is >> densification;
-            _densification_info = std::move(densification).cuda();
+            _densification_info = place(std::move(densification));
         }
 
         LOG_DEBUG("Deserialized SplatData: {} Gaussians, SH {}/{}", size(), active_sh, max_sh);
@@ -621,7 +558,9 @@ namespace lfs::core {
 
                 // Compute scaling on CPU
                 LOG_DEBUG("  Computing neighbor distances...");
-                auto nn_dist = compute_mean_neighbor_distances(means_cpu).clamp_min(1e-7f);
+                // Random init is evenly spread, which suits the grid; captured points may cluster
+                const auto knn_method = params.optimization.random ? KnnMethod::Grid : KnnMethod::KdTree;
+                auto nn_dist = mean_neighbor_distance(means_cpu, 3, knn_method).clamp_min(1e-7f);
                 LOG_DEBUG("  nn_dist computed: is_valid={}, shape={}, numel={}",
                           nn_dist.is_valid(), nn_dist.shape().str(), nn_dist.numel());
 
@@ -818,7 +757,8 @@ namespace lfs::core {
                     means_temp = positions.cuda();
                 }
 
-                auto nn_dist = compute_mean_neighbor_distances(means_temp).clamp_min(1e-7f);
+                const auto knn_method = params.optimization.random ? KnnMethod::Grid : KnnMethod::KdTree;
+                auto nn_dist = mean_neighbor_distance(means_temp, 3, knn_method).clamp_min(1e-7f);
                 std::vector<int> scale_expand_shape = {static_cast<int>(num_points), 3};
                 auto scaling_temp = nn_dist.sqrt()
                                         .mul(params.optimization.init_scaling)
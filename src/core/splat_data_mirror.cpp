@@ -4,6 +4,7 @@
 
 #include "core/splat_data_mirror.hpp"
 #include "core/logger.hpp"
+#include "core/spatial_index.hpp"
 #include "core/splat_data.hpp"
 #include <mutex>
 
@@ -83,6 +84,10 @@ namespace lfs::core {
         if (count == 0)
             return glm::vec3(0.0f);
 
+        // Whole-model selections read the centroid the spatial index keeps, when it is current
+        if (static_cast<size_t>(count) == static_cast<size_t>(means.size(0)) && splat_data.has_spatial_index())
+            return splat_data.spatial_index().centroid();
+
         // Masked sum on GPU, only transfer 3 floats
         const auto mask_f = selected.to(DataType::Float32).unsqueeze(1);
         const auto masked = means * mask_f;
@@ -124,6 +129,7 @@ namespace lfs::core {
             const auto offset = Tensor::from_vector(
                 {a == 0 ? off : 0.0f, a == 1 ? off : 0.0f, a == 2 ? off : 0.0f}, {1, 3}, device);
             means.index_copy_(0, indices, sel * g_cache.pos_mult[a] + offset);
+            splat_data.mark_positions_changed();
         }
 
         // Quaternion
@@ -3,20 +3,220 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "core/splat_data_transform.hpp"
+#include "core/cuda/splat_transform.cuh"
 #include "core/logger.hpp"
 #include "core/point_cloud.hpp"
+#include "core/spatial_index.hpp"
 #include "core/splat_data.hpp"
 #include "geometry/bounding_box.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <numeric>
 #include <random>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
 #include <vector>
 
 namespace lfs::core {
 
+    namespace {
+
+        constexpr size_t TRANSFORM_GRAIN = 4096;
+        // Directions sampled when fitting the SH rotation; well above the 7 a band needs
+        constexpr int SH_FIT_DIRECTIONS = 32;
+
+        // Real SH basis of one band, in the rasterizer's coefficient order and sign convention
+        void eval_sh_band(const int band, const glm::dvec3& d, double* out) {
+            const double x = d.x, y = d.y, z = d.z;
+            const double fC1 = x * x - y * y;
+            const double fS1 = 2.0 * x * y;
+            switch (band) {
+            case 1: {
+                constexpr double C1 = 0.48860251190292;
+                out[0] = -C1 * y;
+                out[1] = C1 * z;
+                out[2] = -C1 * x;
+                break;
+            }
+            case 2: {
+                const double fTmp0B = -1.092548430592079 * z;
+                out[0] = 0.5462742152960395 * fS1;
+                out[1] = fTmp0B * y;
+                out[2] = 0.9461746957575601 * z * z - 0.3153915652525201;
+                out[3] = fTmp0B * x;
+                out[4] = 0.5462742152960395 * fC1;
+                break;
+            }
+            default: {
+                const double z2 = z * z;
+                const double fTmp0C = -2.285228997322329 * z2 + 0.4570457994644658;
+                const double fTmp1B = 1.445305721320277 * z;
+                const double fC2 = x * fC1 - y * fS1;
+                const double fS2 = x * fS1 + y * fC1;
+                out[0] = -0.5900435899266435 * fS2;
+                out[1] = fTmp1B * fS1;
+                out[2] = fTmp0C * y;
+                out[3] = z * (1.865881662950577 * z2 - 1.119528997770346);
+                out[4] = fTmp0C * x;
+                out[5] = fTmp1B * fC1;
+                out[6] = -0.5900435899266435 * fC2;
+                break;
+            }
+            }
+        }
+
+        /**
+         * Wigner-D blocks for bands 1..3: coefficients D c evaluated at R d give the same
+         * value as c at d. Each band spans a rotation-invariant space, so a least-squares fit
+         * over sample directions recovers D exactly without per-band recurrences.
+         */
+        void compute_sh_rotation(const glm::mat3& rotation, float* out) {
+            const glm::dmat3 inverse = glm::transpose(glm::dmat3(rotation));
+            for (int band = 1; band <= SPLAT_TRANSFORM_MAX_SH_BANDS; ++band) {
+                const int size = 2 * band + 1;
+                // Normal equations: (A^T A) D = A^T B with A = Y(d_k), B = Y(R^T d_k)
+                double ata[7][7] = {};
+                double atb[7][7] = {};
+                for (int k = 0; k < SH_FIT_DIRECTIONS; ++k) {
+                    // Golden-angle spiral
+                    const double z = 1.0 - (2.0 * k + 1.0) / SH_FIT_DIRECTIONS;
+                    const double r = std::sqrt(1.0 - z * z);
+                    const double phi = k * 2.399963229728653;
+                    const glm::dvec3 d(r * std::cos(phi), r * std::sin(phi), z);
+
+                    double a[7], b[7];
+                    eval_sh_band(band, d, a);
+                    eval_sh_band(band, inverse * d, b);
+                    for (int i = 0; i < size; ++i) {
+                        for (int j = 0; j < size; ++j) {
+                            ata[i][j] += a[i] * a[j];
+                            atb[i][j] += a[i] * b[j];
+                        }
+                    }
+                }
+
+                // Gauss-Jordan with partial pivoting; atb becomes D
+                for (int col = 0; col < size; ++col) {
+                    int pivot = col;
+                    for (int row = col + 1; row < size; ++row) {
+                        if (std::abs(ata[row][col]) > std::abs(ata[pivot][col]))
+                            pivot = row;
+                    }
+                    std::swap(ata[col], ata[pivot]);
+                    std::swap(atb[col], atb[pivot]);
+                    const double inv = 1.0 / ata[col][col];
+                    for (int j = 0; j < size; ++j) {
+                        ata[col][j] *= inv;
+                        atb[col][j] *= inv;
+                    }
+                    for (int row = 0; row < size; ++row) {
+                        if (row == col)
+                            continue;
+                        const double f = ata[row][col];
+                        for (int j = 0; j < size; ++j) {
+                            ata[row][j] -= f * ata[col][j];
+                            atb[row][j] -= f * atb[col][j];
+                        }
+                    }
+                }
+
+                float* block = out + sh_rotation_offset(band);
+                for (int i = 0; i < size; ++i) {
+                    for (int j = 0; j < size; ++j)
+                        block[i * size + j] = static_cast<float>(atb[i][j]);
+                }
+            }
+        }
+
+        // Gaussians whose SH are rotated together on the CPU; one AVX register of floats
+        constexpr int SH_BLOCK = 8;
+        constexpr int SH_MAX_ROTATED_FLOATS =
+            ((SPLAT_TRANSFORM_MAX_SH_BANDS + 1) * (SPLAT_TRANSFORM_MAX_SH_BANDS + 1) - 1) * 3;
+
+        // Rotate the shN of SH_BLOCK consecutive gaussians. Their rotated coefficients are
+        // transposed to lane-minor order so rotate_sh vectorises across the block.
+        void rotate_sh_block(const SplatTransformParams& params, float* shN, const int shN_coeffs) {
+            const int floats = ((params.sh_bands + 1) * (params.sh_bands + 1) - 1) * 3;
+            const size_t stride = static_cast<size_t>(shN_coeffs) * 3;
+            alignas(32) float block[SH_MAX_ROTATED_FLOATS * SH_BLOCK];
+            for (int l = 0; l < SH_BLOCK; ++l) {
+                for (int k = 0; k < floats; ++k)
+                    block[k * SH_BLOCK + l] = shN[l * stride + k];
+            }
+            rotate_sh<SH_BLOCK>(params, block);
+            for (int l = 0; l < SH_BLOCK; ++l) {
+                for (int k = 0; k < floats; ++k)
+                    shN[l * stride + k] = block[k * SH_BLOCK + l];
+            }
+        }
+
+        // CPU counterpart of transform_gaussians_cuda(); the SH rotation, which dominates,
+        // runs in blocks of SH_BLOCK gaussians
+        float transform_gaussians_cpu(const SplatTransformParams& params,
+                                      float* means,
+                                      float* rotation,
+                                      float* scaling,
+                                      float* shN,
+                                      const size_t n,
+                                      const int shN_coeffs) {
+            struct Sum {
+                double v[3] = {0.0, 0.0, 0.0};
+            };
+            // Mean, rotation and scale only; blocks rotate their SH separately
+            SplatTransformParams frame_params = params;
+            frame_params.sh_bands = 0;
+            const Sum total = tbb::parallel_reduce(
+                tbb::blocked_range<size_t>(0, n, TRANSFORM_GRAIN), Sum{},
+                [&](const tbb::blocked_range<size_t>& range, Sum sum) {
+                    size_t i = range.begin();
+                    if (shN) {
+                        for (; i + SH_BLOCK <= range.end(); i += SH_BLOCK) {
+                            for (size_t g = i; g < i + SH_BLOCK; ++g)
+                                transform_gaussian(frame_params, means + g * 3, rotation + g * 4, scaling + g * 3, nullptr);
+                            rotate_sh_block(params, shN + i * shN_coeffs * 3, shN_coeffs);
+                        }
+                    }
+                    for (; i < range.end(); ++i) {
+                        transform_gaussian(params, means + i * 3, rotation + i * 4, scaling + i * 3,
+                                           shN ? shN + i * shN_coeffs * 3 : nullptr);
+                    }
+                    for (size_t g = range.begin(); g < range.end(); ++g) {
+                        sum.v[0] += means[g * 3 + 0];
+                        sum.v[1] += means[g * 3 + 1];
+                        sum.v[2] += means[g * 3 + 2];
+                    }
+                    return sum;
+                },
+                [](Sum a, const Sum& b) {
+                    for (int d = 0; d < 3; ++d)
+                        a.v[d] += b.v[d];
+                    return a;
+                });
+
+            const float cx = static_cast<float>(total.v[0] / n);
+            const float cy = static_cast<float>(total.v[1] / n);
+            const float cz = static_cast<float>(total.v[2] / n);
+            std::vector<float> dist_sq(n);
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, n, TRANSFORM_GRAIN), [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); ++i) {
+                    const float dx = means[i * 3 + 0] - cx;
+                    const float dy = means[i * 3 + 1] - cy;
+                    const float dz = means[i * 3 + 2] - cz;
+                    dist_sq[i] = dx * dx + dy * dy + dz * dz;
+                }
+            });
+
+            const auto median = dist_sq.begin() + n / 2;
+            std::nth_element(dist_sq.begin(), median, dist_sq.end());
+            return std::sqrt(*median);
+        }
+
+    } // namespace
+
     SplatData& transform(SplatData& splat_data, const glm::mat4& transform_matrix) {
         LOG_TIMER("transform");
 
@@ -25,26 +225,25 @@ namespace lfs::core {
             return splat_data;
         }
 
-        const int num_points = splat_data._means.size(0);
-        auto device = splat_data._means.device();
+        const size_t num_points = splat_data._means.size(0);
+        const Device device = splat_data._means.device();
 
-        // GLM uses column-major storage: mat[col][row], so mat[3] is the translation column.
-        // Our tensor MM expects row-major, so we transpose during construction.
-        // Final transform: M * p^T where p is [N,4] homogeneous points.
-        const std::vector<float> transform_data = {
-            transform_matrix[0][0], transform_matrix[1][0], transform_matrix[2][0], transform_matrix[3][0],
-            transform_matrix[0][1], transform_matrix[1][1], transform_matrix[2][1], transform_matrix[3][1],
-            transform_matrix[0][2], transform_matrix[1][2], transform_matrix[2][2], transform_matrix[3][2],
-            transform_matrix[0][3], transform_matrix[1][3], transform_matrix[2][3], transform_matrix[3][3]};
+        for (const Tensor* t : {&splat_data._means, &splat_data._rotation, &splat_data._scaling}) {
+            if (t->dtype() != DataType::Float32 || t->device() != device || t->size(0) != num_points) {
+                LOG_ERROR("transform: means, rotation and scaling must be Float32 [N, ...] on one device");
+                return splat_data;
+            }
+        }
 
-        const auto transform_tensor = Tensor::from_vector(transform_data, TensorShape({4, 4}), device);
-        const auto ones = Tensor::ones({static_cast<size_t>(num_points), 1}, device);
-        const auto means_homo = splat_data._means.cat(ones, 1);
-        const auto transformed_means = transform_tensor.mm(means_homo.t()).t();
+        SplatTransformParams params{};
 
-        splat_data._means = transformed_means.slice(1, 0, 3).contiguous();
+        // GLM is column-major: mat[col][row], so mat[3] is the translation column
+        for (int row = 0; row < 3; ++row) {
+            for (int col = 0; col < 4; ++col)
+                params.affine[row * 4 + col] = transform_matrix[col][row];
+        }
 
-        // 2. Extract rotation from transform matrix
+        // Split the linear part into rotation and per-axis scale
         glm::mat3 rot_mat(transform_matrix);
         glm::vec3 scale;
         for (int i = 0; i < 3; ++i) {
@@ -54,54 +253,52 @@ namespace lfs::core {
             }
         }
 
-        glm::quat rotation_quat = glm::quat_cast(rot_mat);
-
-        // 3. Transform rotations (quaternions) if there's rotation
-        if (std::abs(rotation_quat.w - 1.0f) > 1e-6f) {
-            std::vector<float> rot_data = {rotation_quat.w, rotation_quat.x, rotation_quat.y, rotation_quat.z};
-            auto rot_tensor = Tensor::from_vector(rot_data, TensorShape({4}), device);
-
-            auto q = splat_data._rotation;
-            std::vector<int> expand_shape = {num_points, 4};
-            auto q_rot = rot_tensor.unsqueeze(0).expand(std::span<const int>(expand_shape));
-
-            auto w1 = q_rot.slice(1, 0, 1).squeeze(1);
-            auto x1 = q_rot.slice(1, 1, 2).squeeze(1);
-            auto y1 = q_rot.slice(1, 2, 3).squeeze(1);
-            auto z1 = q_rot.slice(1, 3, 4).squeeze(1);
-
-            auto w2 = q.slice(1, 0, 1).squeeze(1);
-            auto x2 = q.slice(1, 1, 2).squeeze(1);
-            auto y2 = q.slice(1, 2, 3).squeeze(1);
-            auto z2 = q.slice(1, 3, 4).squeeze(1);
-
-            auto w_new = w1.mul(w2).sub(x1.mul(x2)).sub(y1.mul(y2)).sub(z1.mul(z2));
-            auto x_new = w1.mul(x2).add(x1.mul(w2)).add(y1.mul(z2)).sub(z1.mul(y2));
-            auto y_new = w1.mul(y2).sub(x1.mul(z2)).add(y1.mul(w2)).add(z1.mul(x2));
-            auto z_new = w1.mul(z2).add(x1.mul(y2)).sub(y1.mul(x2)).add(z1.mul(w2));
-
-            std::vector<Tensor> components = {
-                w_new.unsqueeze(1),
-                x_new.unsqueeze(1),
-                y_new.unsqueeze(1),
-                z_new.unsqueeze(1)};
-            splat_data._rotation = Tensor::cat(components, 1);
-        }
-
-        // 4. Transform scaling
-        if (std::abs(scale.x - 1.0f) > 1e-6f ||
-            std::abs(scale.y - 1.0f) > 1e-6f ||
-            std::abs(scale.z - 1.0f) > 1e-6f) {
-
-            float avg_scale = (scale.x + scale.y + scale.z) / 3.0f;
-            splat_data._scaling = splat_data._scaling.add(std::log(avg_scale));
+        const glm::quat rotation_quat = glm::quat_cast(rot_mat);
+        params.rotate = std::abs(rotation_quat.w - 1.0f) > 1e-6f;
+        params.quat[0] = rotation_quat.w;
+        params.quat[1] = rotation_quat.x;
+        params.quat[2] = rotation_quat.y;
+        params.quat[3] = rotation_quat.z;
+
+        // Gaussians only carry an isotropic scale change
+        params.rescale = std::abs(scale.x - 1.0f) > 1e-6f ||
+                         std::abs(scale.y - 1.0f) > 1e-6f ||
+                         std::abs(scale.z - 1.0f) > 1e-6f;
+        params.log_scale = std::log((scale.x + scale.y + scale.z) / 3.0f);
+
+        // View-dependent color turns with the gaussians
+        Tensor& shN = splat_data._shN;
+        int shN_coeffs = 0;
+        if (params.rotate && shN.is_valid() && shN.ndim() == 3 && shN.size(0) == num_points &&
+            shN.size(2) == 3 && shN.dtype() == DataType::Float32 && shN.device() == device) {
+            shN_coeffs = static_cast<int>(shN.size(1));
+            while (params.sh_bands < SPLAT_TRANSFORM_MAX_SH_BANDS &&
+                   (params.sh_bands + 2) * (params.sh_bands + 2) - 1 <= shN_coeffs) {
+                ++params.sh_bands;
+            }
+            if (params.sh_bands > 0)
+                compute_sh_rotation(glm::mat3_cast(rotation_quat), params.sh_rotation);
         }
 
-        // 5. Update scene scale
-        Tensor scene_center = splat_data._means.mean({0}, false);
-        Tensor dists = splat_data._means.sub(scene_center).norm(2.0f, {1}, false);
-        auto sorted_dists = dists.sort(0, false);
-        float new_scene_scale = sorted_dists.first[num_points / 2].item();
+        // The pass writes through raw pointers, so views are materialized first
+        const auto make_contiguous = [](Tensor& t) {
+            if (!t.is_contiguous())
+                t = t.contiguous();
+        };
+        make_contiguous(splat_data._means);
+        make_contiguous(splat_data._rotation);
+        make_contiguous(splat_data._scaling);
+        if (params.sh_bands > 0)
+            make_contiguous(shN);
+
+        float* const shN_ptr = params.sh_bands > 0 ? shN.ptr<float>() : nullptr;
+        const float new_scene_scale =
+            device == Device::CUDA
+                ? transform_gaussians_cuda(params, splat_data._means.ptr<float>(), splat_data._rotation.ptr<float>(),
+                                           splat_data._scaling.ptr<float>(), shN_ptr, num_points, shN_coeffs)
+                : transform_gaussians_cpu(params, splat_data._means.ptr<float>(), splat_data._rotation.ptr<float>(),
+                                          splat_data._scaling.ptr<float>(), shN_ptr, num_points, shN_coeffs);
+        splat_data.mark_positions_changed();
 
         if (std::abs(new_scene_scale - splat_data._scene_scale) > splat_data._scene_scale * 0.1f) {
             splat_data._scene_scale = new_scene_scale;
@@ -111,9 +308,13 @@ namespace lfs::core {
         return splat_data;
     }
 
-    // Helper: compute inside-cropbox mask for given means and bounding box
-    static Tensor compute_cropbox_mask(const Tensor& means,
+    // Below this many gaussians testing every point is cheaper than building the spatial index
+    constexpr size_t SPATIAL_INDEX_MIN_POINTS = 65536;
+
+    // Helper: compute inside-cropbox mask for the gaussians of splat_data
+    static Tensor compute_cropbox_mask(const SplatData& splat_data,
                                        const lfs::geometry::BoundingBox& bounding_box) {
+        const auto& means = splat_data.means();
         const auto bbox_min = bounding_box.getMinBounds();
         const auto bbox_max = bounding_box.getMaxBounds();
 
@@ -124,6 +325,14 @@ namespace lfs::core {
                                                    ? bounding_box.getworld2BBoxMat4()
                                                    : bounding_box.getworld2BBox().toMat4();
 
+        // Large scenes: whole leaves inside or outside the box skip per-point tests, on the
+        // device for CUDA-resident means. The index stays cached on the SplatData until its
+        // means change, so repeated crop queries only pay for the traversal.
+        if (static_cast<size_t>(num_points) >= SPATIAL_INDEX_MIN_POINTS) {
+            const OrientedBox box{world_to_bbox_matrix, bbox_min, bbox_max};
+            return splat_data.spatial_index().query_mask(box, means.device());
+        }
+
         const std::vector<float> transform_data = {
             world_to_bbox_matrix[0][0], world_to_bbox_matrix[1][0], world_to_bbox_matrix[2][0], world_to_bbox_matrix[3][0],
             world_to_bbox_matrix[0][1], world_to_bbox_matrix[1][1], world_to_bbox_matrix[2][1], world_to_bbox_matrix[3][1],
@@ -166,7 +375,7 @@ namespace lfs::core {
 
         const int num_points = splat_data._means.size(0);
 
-        auto inside_mask = compute_cropbox_mask(splat_data._means, bounding_box);
+        auto inside_mask = compute_cropbox_mask(splat_data, bounding_box);
 
         // Invert mask if inverse mode
         auto selection_mask = inverse ? inside_mask.logical_not() : inside_mask;
@@ -196,8 +405,7 @@ namespace lfs::core {
 
         float new_scene_scale = splat_data._scene_scale;
         if (points_selected > 1) {
-            auto sorted_dists = dists.sort(0, false);
-            new_scene_scale = sorted_dists.first[points_selected / 2].item();
+            new_scene_scale = dists.kthvalue(static_cast<size_t>(points_selected / 2) + 1, 0).first.item();
         }
 
         SplatData cropped_splat(
@@ -231,7 +439,7 @@ namespace lfs::core {
             return Tensor();
         }
 
-        const auto inside_mask = compute_cropbox_mask(means, bounding_box);
+        const auto inside_mask = compute_cropbox_mask(splat_data, bounding_box);
         const auto delete_mask = inverse ? inside_mask : inside_mask.logical_not();
         const int points_to_delete = delete_mask.sum_scalar();
 
@@ -332,10 +540,11 @@ namespace lfs::core {
             // Exclude 2% outliers (1% each end)
             const int64_t lo = n / 100;
             const int64_t hi = n - 1 - lo;
+            const auto lo_values = visible_means.kthvalue(static_cast<size_t>(lo) + 1, 0).first.to_vector();
+            const auto hi_values = visible_means.kthvalue(static_cast<size_t>(hi) + 1, 0).first.to_vector();
             for (int i = 0; i < 3; ++i) {
-                const auto sorted = visible_means.slice(1, i, i + 1).squeeze(1).sort(0, false).first;
-                min_bounds[i] = sorted[lo].item() - padding;
-                max_bounds[i] = sorted[hi].item() + padding;
+                min_bounds[i] = lo_values[i] - padding;
+                max_bounds[i] = hi_values[i] + padding;
             }
         } else {
             for (int i = 0; i < 3; ++i) {
@@ -364,10 +573,11 @@ namespace lfs::core {
             // Exclude 2% outliers (1% each end)
             const int64_t lo = n / 100;
             const int64_t hi = n - 1 - lo;
+            const auto lo_values = means.kthvalue(static_cast<size_t>(lo) + 1, 0).first.to_vector();
+            const auto hi_values = means.kthvalue(static_cast<size_t>(hi) + 1, 0).first.to_vector();
             for (int i = 0; i < 3; ++i) {
-                const auto sorted = means.slice(1, i, i + 1).squeeze(1).sort(0, false).first;
-                min_bounds[i] = sorted[lo].item() - padding;
-                max_bounds[i] = sorted[hi].item() + padding;
+                min_bounds[i] = lo_values[i] - padding;
+                max_bounds[i] = hi_values[i] + padding;
             }
         } else {
             for (int i = 0; i < 3; ++i) {
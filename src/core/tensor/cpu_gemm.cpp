@@ -0,0 +1,416 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "internal/cpu_gemm.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+// SIMD intrinsics for CPU optimization
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// OpenMP for multi-threading
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace lfs::core::cpu_gemm {
+
+    namespace {
+
+        // ============= SIMD abstraction =============
+        // Microkernel shapes follow the BLIS convention: MR rows of A are broadcast
+        // against NR columns of B, keeping MR * (NR / WIDTH) accumulators in registers.
+
+#if defined(__AVX512F__)
+        struct Simd {
+            using vec = __m512;
+            static constexpr size_t WIDTH = 16;
+            static vec zero() { return _mm512_setzero_ps(); }
+            static vec load(const float* p) { return _mm512_loadu_ps(p); }
+            static void store(float* p, vec v) { _mm512_storeu_ps(p, v); }
+            static vec set1(float x) { return _mm512_set1_ps(x); }
+            static vec add(vec a, vec b) { return _mm512_add_ps(a, b); }
+            static vec fmadd(vec a, vec b, vec c) { return _mm512_fmadd_ps(a, b, c); }
+            static float hsum(vec v) { return _mm512_reduce_add_ps(v); }
+        };
+        constexpr size_t MR = 12; // 24 zmm accumulators
+        constexpr size_t NR = 32;
+#elif defined(__AVX2__) && defined(__FMA__)
+        struct Simd {
+            using vec = __m256;
+            static constexpr size_t WIDTH = 8;
+            static vec zero() { return _mm256_setzero_ps(); }
+            static vec load(const float* p) { return _mm256_loadu_ps(p); }
+            static void store(float* p, vec v) { _mm256_storeu_ps(p, v); }
+            static vec set1(float x) { return _mm256_set1_ps(x); }
+            static vec add(vec a, vec b) { return _mm256_add_ps(a, b); }
+            static vec fmadd(vec a, vec b, vec c) { return _mm256_fmadd_ps(a, b, c); }
+            static float hsum(vec v) {
+                __m128 lo = _mm256_castps256_ps128(v);
+                __m128 hi = _mm256_extractf128_ps(v, 1);
+                lo = _mm_add_ps(lo, hi);
+                lo = _mm_hadd_ps(lo, lo);
+                lo = _mm_hadd_ps(lo, lo);
+                return _mm_cvtss_f32(lo);
+            }
+        };
+        constexpr size_t MR = 6; // 12 ymm accumulators
+        constexpr size_t NR = 16;
+#else
+        // Scalar fallback - small tiles the compiler can still auto-vectorize
+        struct Simd {
+            using vec = float;
+            static constexpr size_t WIDTH = 1;
+            static vec zero() { return 0.0f; }
+            static vec load(const float* p) { return *p; }
+            static void store(float* p, vec v) { *p = v; }
+            static vec set1(float x) { return x; }
+            static vec add(vec a, vec b) { return a + b; }
+            static vec fmadd(vec a, vec b, vec c) { return a * b + c; }
+            static float hsum(vec v) { return v; }
+        };
+        constexpr size_t MR = 4;
+        constexpr size_t NR = 4;
+#endif
+
+        static_assert(NR % Simd::WIDTH == 0, "NR must be a multiple of the SIMD width");
+
+        // Cache blocking: A block (MC x KC) stays in L2, B micro-panel (KC x NR) in L1
+        constexpr size_t KC = 256;
+        constexpr size_t MC = MR * 16;
+        constexpr size_t NC = NR * 64;
+
+        // Tiny-K direct path (e.g. [4,4] @ [4,N] homogeneous transforms)
+        constexpr size_t SMALL_K = 8;
+        constexpr size_t SMALL_K_COL_CHUNK = 2048;
+        constexpr size_t SMALL_K_ROW_BLOCK = 64;
+
+        // Below this many FLOPs, thread startup costs more than it saves
+        constexpr size_t PARALLEL_FLOP_THRESHOLD = size_t{1} << 20;
+        constexpr size_t DOT_PARALLEL_THRESHOLD = size_t{1} << 16;
+        constexpr size_t DOT_BLOCK = 4096;
+
+        int max_threads() {
+#ifdef _OPENMP
+            return omp_get_max_threads();
+#else
+            return 1;
+#endif
+        }
+
+        size_t ceil_div(size_t a, size_t b) { return (a + b - 1) / b; }
+
+        // ============= Packing =============
+
+        // Pack an mc x kc block of A into MR-row panels: panel p holds A[p*MR + i, l] at [l * MR + i]
+        void pack_a(const float* a, std::ptrdiff_t rs, std::ptrdiff_t cs,
+                    size_t mc, size_t kc, float* dst) {
+            for (size_t ir = 0; ir < mc; ir += MR) {
+                const size_t mr = std::min(MR, mc - ir);
+                float* panel = dst + ir * kc;
+                if (mr < MR) {
+                    std::memset(panel, 0, MR * kc * sizeof(float));
+                }
+                for (size_t i = 0; i < mr; ++i) {
+                    const float* src = a + static_cast<std::ptrdiff_t>(ir + i) * rs;
+                    for (size_t l = 0; l < kc; ++l) {
+                        panel[l * MR + i] = src[static_cast<std::ptrdiff_t>(l) * cs];
+                    }
+                }
+            }
+        }
+
+        // Pack a kc x nc block of B into NR-column panels: panel p holds B[l, p*NR + j] at [l * NR + j]
+        void pack_b(const float* b, std::ptrdiff_t rs, std::ptrdiff_t cs,
+                    size_t kc, size_t nc, float* dst) {
+            for (size_t jr = 0; jr < nc; jr += NR) {
+                const size_t nr = std::min(NR, nc - jr);
+                float* panel = dst + jr * kc;
+                const float* src = b + static_cast<std::ptrdiff_t>(jr) * cs;
+                for (size_t l = 0; l < kc; ++l) {
+                    const float* row = src + static_cast<std::ptrdiff_t>(l) * rs;
+                    float* out = panel + l * NR;
+                    if (cs == 1 && nr == NR) {
+                        std::memcpy(out, row, NR * sizeof(float));
+                    } else {
+                        size_t j = 0;
+                        for (; j < nr; ++j) {
+                            out[j] = row[static_cast<std::ptrdiff_t>(j) * cs];
+                        }
+                        for (; j < NR; ++j) {
+                            out[j] = 0.0f;
+                        }
+                    }
+                }
+            }
+        }
+
+        // ============= Microkernel =============
+
+        // C[mr, nr] (+)= A_panel[MR, kc] @ B_panel[kc, NR]
+        inline void micro_kernel(size_t kc, const float* __restrict ap, const float* __restrict bp,
+                                 float* c, size_t ldc, size_t mr, size_t nr, bool accumulate) {
+            constexpr size_t NV = NR / Simd::WIDTH;
+            typename Simd::vec acc[MR][NV];
+            for (size_t i = 0; i < MR; ++i) {
+                for (size_t j = 0; j < NV; ++j) {
+                    acc[i][j] = Simd::zero();
+                }
+            }
+
+            for (size_t l = 0; l < kc; ++l) {
+                typename Simd::vec bv[NV];
+                for (size_t j = 0; j < NV; ++j) {
+                    bv[j] = Simd::load(bp + j * Simd::WIDTH);
+                }
+                for (size_t i = 0; i < MR; ++i) {
+                    const typename Simd::vec av = Simd::set1(ap[i]);
+                    for (size_t j = 0; j < NV; ++j) {
+                        acc[i][j] = Simd::fmadd(av, bv[j], acc[i][j]);
+                    }
+                }
+                ap += MR;
+                bp += NR;
+            }
+
+            if (mr == MR && nr == NR) {
+                for (size_t i = 0; i < MR; ++i) {
+                    float* crow = c + i * ldc;
+                    for (size_t j = 0; j < NV; ++j) {
+                        float* cp = crow + j * Simd::WIDTH;
+                        Simd::store(cp, accumulate ? Simd::add(Simd::load(cp), acc[i][j]) : acc[i][j]);
+                    }
+                }
+                return;
+            }
+
+            // Edge tile: spill to a local buffer and copy the valid region
+            alignas(64) float tile[MR * NR];
+            for (size_t i = 0; i < MR; ++i) {
+                for (size_t j = 0; j < NV; ++j) {
+                    Simd::store(tile + i * NR + j * Simd::WIDTH, acc[i][j]);
+                }
+            }
+            for (size_t i = 0; i < mr; ++i) {
+                float* crow = c + i * ldc;
+                for (size_t j = 0; j < nr; ++j) {
+                    crow[j] = accumulate ? crow[j] + tile[i * NR + j] : tile[i * NR + j];
+                }
+            }
+        }
+
+        // ============= Tiny-K direct path =============
+
+        // Each output row is a k-term linear combination of rows of B. Rows of B are
+        // streamed with vector loads; a B with non-unit column stride (e.g. points.t())
+        // is first gathered one column chunk at a time into a thread-local panel.
+        void small_k_gemm(const float* a, std::ptrdiff_t rs_a, std::ptrdiff_t cs_a,
+                          const float* b, std::ptrdiff_t rs_b, std::ptrdiff_t cs_b,
+                          float* c, size_t m, size_t k, size_t n, bool allow_parallel) {
+            const int64_t row_blocks = static_cast<int64_t>(ceil_div(m, SMALL_K_ROW_BLOCK));
+            const int64_t col_chunks = static_cast<int64_t>(ceil_div(n, SMALL_K_COL_CHUNK));
+            const bool use_parallel = allow_parallel && 2 * m * n * k >= PARALLEL_FLOP_THRESHOLD &&
+                                      row_blocks * col_chunks > 1;
+            const bool gather_b = cs_b != 1;
+
+#pragma omp parallel if (use_parallel)
+            {
+                std::unique_ptr<float[]> panel(gather_b ? new float[k * std::min(n, SMALL_K_COL_CHUNK)] : nullptr);
+
+#pragma omp for collapse(2) schedule(static)
+                for (int64_t rb = 0; rb < row_blocks; ++rb) {
+                    for (int64_t cb = 0; cb < col_chunks; ++cb) {
+                        const size_t i0 = static_cast<size_t>(rb) * SMALL_K_ROW_BLOCK;
+                        const size_t i1 = std::min(m, i0 + SMALL_K_ROW_BLOCK);
+                        const size_t j0 = static_cast<size_t>(cb) * SMALL_K_COL_CHUNK;
+                        const size_t width = std::min(n, j0 + SMALL_K_COL_CHUNK) - j0;
+
+                        // Chunk of B with unit column stride: B(l, j0 + j) = bp[l * rs_bp + j]
+                        const float* bp = b + static_cast<std::ptrdiff_t>(j0) * cs_b;
+                        std::ptrdiff_t rs_bp = rs_b;
+                        if (gather_b) {
+                            for (size_t l = 0; l < k; ++l) {
+                                const float* src = bp + static_cast<std::ptrdiff_t>(l) * rs_b;
+                                float* dst = panel.get() + l * width;
+                                for (size_t j = 0; j < width; ++j) {
+                                    dst[j] = src[static_cast<std::ptrdiff_t>(j) * cs_b];
+                                }
+                            }
+                            bp = panel.get();
+                            rs_bp = static_cast<std::ptrdiff_t>(width);
+                        }
+
+                        for (size_t i = i0; i < i1; ++i) {
+                            float coef[SMALL_K];
+                            typename Simd::vec coef_v[SMALL_K];
+                            for (size_t l = 0; l < k; ++l) {
+                                coef[l] = a[static_cast<std::ptrdiff_t>(i) * rs_a + static_cast<std::ptrdiff_t>(l) * cs_a];
+                                coef_v[l] = Simd::set1(coef[l]);
+                            }
+
+                            float* crow = c + i * n + j0;
+                            size_t j = 0;
+                            for (; j + Simd::WIDTH <= width; j += Simd::WIDTH) {
+                                typename Simd::vec acc = Simd::zero();
+                                for (size_t l = 0; l < k; ++l) {
+                                    acc = Simd::fmadd(coef_v[l], Simd::load(bp + static_cast<std::ptrdiff_t>(l) * rs_bp + j), acc);
+                                }
+                                Simd::store(crow + j, acc);
+                            }
+                            for (; j < width; ++j) {
+                                float sum = 0.0f;
+                                for (size_t l = 0; l < k; ++l) {
+                                    sum += coef[l] * bp[static_cast<std::ptrdiff_t>(l) * rs_bp + j];
+                                }
+                                crow[j] = sum;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // ============= Packed, blocked path =============
+
+        void packed_gemm(const float* a, std::ptrdiff_t rs_a, std::ptrdiff_t cs_a,
+                         const float* b, std::ptrdiff_t rs_b, std::ptrdiff_t cs_b,
+                         float* c, size_t m, size_t k, size_t n, bool allow_parallel) {
+            const int64_t m_tiles = static_cast<int64_t>(ceil_div(m, MC));
+            const int64_t n_tiles = static_cast<int64_t>(ceil_div(n, NC));
+            const bool use_parallel = allow_parallel && 2 * m * n * k >= PARALLEL_FLOP_THRESHOLD &&
+                                      m_tiles * n_tiles > 1;
+
+            // Packing buffers sized to the actual problem so small GEMMs stay cheap
+            const size_t kc_max = std::min(KC, k);
+            const size_t a_pack_size = std::min(MC, ceil_div(m, MR) * MR) * kc_max;
+            const size_t b_pack_size = std::min(NC, ceil_div(n, NR) * NR) * kc_max;
+
+#pragma omp parallel if (use_parallel)
+            {
+                // Thread-local packed blocks
+                std::unique_ptr<float[]> a_pack(new float[a_pack_size]);
+                std::unique_ptr<float[]> b_pack(new float[b_pack_size]);
+
+#pragma omp for collapse(2) schedule(dynamic)
+                for (int64_t mt = 0; mt < m_tiles; ++mt) {
+                    for (int64_t nt = 0; nt < n_tiles; ++nt) {
+                        const size_t ic = static_cast<size_t>(mt) * MC;
+                        const size_t mc = std::min(MC, m - ic);
+                        const size_t jc = static_cast<size_t>(nt) * NC;
+                        const size_t nc = std::min(NC, n - jc);
+
+                        for (size_t pc = 0; pc < k; pc += KC) {
+                            const size_t kc = std::min(KC, k - pc);
+
+                            pack_b(b + static_cast<std::ptrdiff_t>(pc) * rs_b + static_cast<std::ptrdiff_t>(jc) * cs_b,
+                                   rs_b, cs_b, kc, nc, b_pack.get());
+                            pack_a(a + static_cast<std::ptrdiff_t>(ic) * rs_a + static_cast<std::ptrdiff_t>(pc) * cs_a,
+                                   rs_a, cs_a, mc, kc, a_pack.get());
+
+                            // jr outer keeps the B micro-panel hot in L1 across all A panels
+                            for (size_t jr = 0; jr < nc; jr += NR) {
+                                for (size_t ir = 0; ir < mc; ir += MR) {
+                                    micro_kernel(kc,
+                                                 a_pack.get() + ir * kc,
+                                                 b_pack.get() + jr * kc,
+                                                 c + (ic + ir) * n + jc + jr, n,
+                                                 std::min(MR, mc - ir), std::min(NR, nc - jr),
+                                                 pc > 0);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void sgemm_impl(const float* a, std::ptrdiff_t rs_a, std::ptrdiff_t cs_a,
+                        const float* b, std::ptrdiff_t rs_b, std::ptrdiff_t cs_b,
+                        float* c, size_t m, size_t k, size_t n, bool allow_parallel) {
+            if (m == 0 || n == 0) {
+                return;
+            }
+            if (k == 0) {
+                std::memset(c, 0, m * n * sizeof(float));
+                return;
+            }
+
+            if (k <= SMALL_K) {
+                small_k_gemm(a, rs_a, cs_a, b, rs_b, cs_b, c, m, k, n, allow_parallel);
+                return;
+            }
+
+            packed_gemm(a, rs_a, cs_a, b, rs_b, cs_b, c, m, k, n, allow_parallel);
+        }
+
+    } // namespace
+
+    void sgemm(const float* a, std::ptrdiff_t rs_a, std::ptrdiff_t cs_a,
+               const float* b, std::ptrdiff_t rs_b, std::ptrdiff_t cs_b,
+               float* c, size_t m, size_t k, size_t n) {
+        sgemm_impl(a, rs_a, cs_a, b, rs_b, cs_b, c, m, k, n, true);
+    }
+
+    void sgemm_batched(const float* a, const float* b, float* c,
+                       size_t batch, size_t m, size_t k, size_t n) {
+        const size_t a_stride = m * k;
+        const size_t b_stride = k * n;
+        const size_t c_stride = m * n;
+        const auto lda = static_cast<std::ptrdiff_t>(k);
+        const auto ldb = static_cast<std::ptrdiff_t>(n);
+
+        // Many small matrices: one batch per task, serial GEMM inside
+        const size_t flops_per_batch = 2 * m * n * k;
+        if (batch > 1 && flops_per_batch < PARALLEL_FLOP_THRESHOLD * static_cast<size_t>(max_threads())) {
+            const bool use_parallel = flops_per_batch * batch >= PARALLEL_FLOP_THRESHOLD;
+#pragma omp parallel for if (use_parallel) schedule(static)
+            for (int64_t bi = 0; bi < static_cast<int64_t>(batch); ++bi) {
+                const auto i = static_cast<size_t>(bi);
+                sgemm_impl(a + i * a_stride, lda, 1, b + i * b_stride, ldb, 1,
+                           c + i * c_stride, m, k, n, false);
+            }
+            return;
+        }
+
+        // Few large matrices: parallelize inside each GEMM
+        for (size_t i = 0; i < batch; ++i) {
+            sgemm_impl(a + i * a_stride, lda, 1, b + i * b_stride, ldb, 1,
+                       c + i * c_stride, m, k, n, true);
+        }
+    }
+
+    float sdot(const float* a, const float* b, size_t n) {
+        const int64_t blocks = static_cast<int64_t>(ceil_div(n, DOT_BLOCK));
+        const bool use_parallel = n >= DOT_PARALLEL_THRESHOLD;
+        float sum = 0.0f;
+
+#pragma omp parallel for reduction(+ : sum) if (use_parallel) schedule(static)
+        for (int64_t blk = 0; blk < blocks; ++blk) {
+            const size_t begin = static_cast<size_t>(blk) * DOT_BLOCK;
+            const size_t end = std::min(n, begin + DOT_BLOCK);
+
+            // 4 independent accumulators hide FMA latency
+            typename Simd::vec acc0 = Simd::zero(), acc1 = Simd::zero();
+            typename Simd::vec acc2 = Simd::zero(), acc3 = Simd::zero();
+            size_t i = begin;
+            for (; i + 4 * Simd::WIDTH <= end; i += 4 * Simd::WIDTH) {
+                acc0 = Simd::fmadd(Simd::load(a + i), Simd::load(b + i), acc0);
+                acc1 = Simd::fmadd(Simd::load(a + i + Simd::WIDTH), Simd::load(b + i + Simd::WIDTH), acc1);
+                acc2 = Simd::fmadd(Simd::load(a + i + 2 * Simd::WIDTH), Simd::load(b + i + 2 * Simd::WIDTH), acc2);
+                acc3 = Simd::fmadd(Simd::load(a + i + 3 * Simd::WIDTH), Simd::load(b + i + 3 * Simd::WIDTH), acc3);
+            }
+            float partial = Simd::hsum(Simd::add(Simd::add(acc0, acc1), Simd::add(acc2, acc3)));
+            for (; i < end; ++i) {
+                partial += a[i] * b[i];
+            }
+            sum += partial;
+        }
+
+        return sum;
+    }
+
+} // namespace lfs::core::cpu_gemm
@@ -0,0 +1,59 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "internal/cpu_parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+// OpenMP for multi-threading
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace lfs::core::cpu_parallel {
+
+    namespace {
+        std::atomic<int> g_thread_cap{0};
+    } // namespace
+
+    void set_num_threads(int n) {
+        g_thread_cap.store(std::max(n, 0), std::memory_order_relaxed);
+    }
+
+    int num_threads() {
+        const int cap = g_thread_cap.load(std::memory_order_relaxed);
+#ifdef _OPENMP
+        // Nested calls (e.g. from inside a batched kernel) stay on the current thread
+        if (omp_in_parallel()) {
+            return 1;
+        }
+        return cap > 0 ? cap : omp_get_max_threads();
+#else
+        (void)cap;
+        return 1;
+#endif
+    }
+
+    void parallel_for_impl(size_t n, size_t grain,
+                           void (*fn)(void* ctx, size_t begin, size_t end), void* ctx) {
+        const size_t chunk = std::max<size_t>(grain, 1);
+        const auto num_chunks = static_cast<int64_t>((n + chunk - 1) / chunk);
+        const int threads = static_cast<int>(std::min<int64_t>(num_threads(), num_chunks));
+
+        if (threads <= 1) {
+            for (int64_t c = 0; c < num_chunks; ++c) {
+                const size_t begin = static_cast<size_t>(c) * chunk;
+                fn(ctx, begin, std::min(n, begin + chunk));
+            }
+            return;
+        }
+
+#pragma omp parallel for num_threads(threads) schedule(static)
+        for (int64_t c = 0; c < num_chunks; ++c) {
+            const size_t begin = static_cast<size_t>(c) * chunk;
+            fn(ctx, begin, std::min(n, begin + chunk));
+        }
+    }
+
+} // namespace lfs::core::cpu_parallel
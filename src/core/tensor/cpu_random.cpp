@@ -0,0 +1,175 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+// Built with -ffp-contract=off: the philox transforms must round exactly like the device.
+
+#include "internal/cpu_random.hpp"
+#include "internal/cpu_parallel.hpp"
+#include "internal/cpu_sort.hpp"
+#include "internal/philox.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace lfs::core::cpu_random {
+
+    namespace {
+
+        // Philox blocks (four words each) per parallel task
+        constexpr size_t BLOCK_GRAIN = size_t{1} << 13;
+        // Blocks generated side by side, one per SIMD lane
+        constexpr size_t BATCH = 16;
+        // CDF blocks per parallel task
+        constexpr size_t CDF_GRAIN = 32;
+
+        // Ten Philox rounds over BATCH counters held as four word arrays. Every lane runs the
+        // same 32x32->64 multiplies and xors, which the compiler turns into vector multiplies.
+        void philox_rounds(uint32_t* __restrict c0, uint32_t* __restrict c1, uint32_t* __restrict c2,
+                           uint32_t* __restrict c3, uint32_t k0, uint32_t k1) {
+            for (int round = 0; round < 10; ++round) {
+                for (size_t j = 0; j < BATCH; ++j) {
+                    const uint64_t p0 = static_cast<uint64_t>(philox::detail::M0) * c0[j];
+                    const uint64_t p1 = static_cast<uint64_t>(philox::detail::M1) * c2[j];
+                    const uint32_t x0 = static_cast<uint32_t>(p1 >> 32) ^ c1[j] ^ k0;
+                    const uint32_t x2 = static_cast<uint32_t>(p0 >> 32) ^ c3[j] ^ k1;
+                    c0[j] = x0;
+                    c1[j] = static_cast<uint32_t>(p1);
+                    c2[j] = x2;
+                    c3[j] = static_cast<uint32_t>(p0);
+                }
+                k0 += philox::detail::W0;
+                k1 += philox::detail::W1;
+            }
+        }
+
+        // Blocks [first, first + BATCH) of stream (seed, offset); equal to philox::block() of each
+        void philox_batch(const uint64_t first, const uint64_t seed, const uint64_t offset,
+                          philox::Block (&out)[BATCH]) {
+            uint32_t c0[BATCH], c1[BATCH], c2[BATCH], c3[BATCH];
+            for (size_t j = 0; j < BATCH; ++j) {
+                const uint64_t index = first + j;
+                c0[j] = static_cast<uint32_t>(index);
+                c1[j] = static_cast<uint32_t>(index >> 32);
+                c2[j] = static_cast<uint32_t>(offset);
+                c3[j] = static_cast<uint32_t>(offset >> 32);
+            }
+            philox_rounds(c0, c1, c2, c3, static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32));
+            for (size_t j = 0; j < BATCH; ++j)
+                out[j] = {{c0[j], c1[j], c2[j], c3[j]}};
+        }
+
+        // fn(first_element, lanes, block) for every block covering elements [0, n)
+        template <typename BlockFn>
+        void for_each_block(const size_t n, const uint64_t seed, const uint64_t offset, BlockFn&& fn) {
+            const size_t blocks = (n + 3) / 4;
+            cpu_parallel::parallel_for(blocks, BLOCK_GRAIN, [&](const size_t begin, const size_t end) {
+                philox::Block batch[BATCH];
+                for (size_t b = begin; b < end; b += BATCH) {
+                    philox_batch(b, seed, offset, batch);
+                    const size_t count = std::min(BATCH, end - b);
+                    for (size_t j = 0; j < count; ++j) {
+                        const size_t first = (b + j) * 4;
+                        fn(first, std::min<size_t>(4, n - first), batch[j]);
+                    }
+                }
+            });
+        }
+
+        // fn(i, word) for every element i in [0, n)
+        template <typename WordFn>
+        void for_each_word(const size_t n, const uint64_t seed, const uint64_t offset, WordFn&& fn) {
+            for_each_block(n, seed, offset, [&](const size_t first, const size_t lanes, const philox::Block& block) {
+                for (size_t lane = 0; lane < lanes; ++lane)
+                    fn(first + lane, block.x[lane]);
+            });
+        }
+
+        template <typename T>
+        void randint_impl(T* out, const size_t n, const int low, const int high, const uint64_t seed,
+                          const uint64_t offset) {
+            for_each_word(n, seed, offset, [&](const size_t i, const uint32_t w) {
+                out[i] = static_cast<T>(philox::to_int(w, low, high));
+            });
+        }
+
+        // Blockwise CDF, rounding exactly as the device builds it
+        void build_cdf(const float* weights, const size_t n, float* cdf) {
+            const size_t blocks = (n + philox::CDF_BLOCK - 1) / philox::CDF_BLOCK;
+            std::vector<float> offsets(blocks);
+            cpu_parallel::parallel_for(blocks, CDF_GRAIN, [&](const size_t begin, const size_t end) {
+                for (size_t b = begin; b < end; ++b) {
+                    const size_t first = b * philox::CDF_BLOCK;
+                    offsets[b] = philox::cdf_block_scan(weights, cdf, first, std::min(n, first + philox::CDF_BLOCK));
+                }
+            });
+            philox::cdf_block_offsets(offsets.data(), blocks);
+            cpu_parallel::parallel_for(n, cpu_parallel::DEFAULT_GRAIN, [&](const size_t begin, const size_t end) {
+                for (size_t i = std::max(begin, philox::CDF_BLOCK); i < end; ++i)
+                    cdf[i] = philox::cdf_add_offset(cdf[i], offsets[i / philox::CDF_BLOCK]);
+            });
+        }
+
+    } // namespace
+
+    void uniform(float* out, const size_t n, const float low, const float high, const uint64_t seed,
+                 const uint64_t offset) {
+        for_each_word(n, seed, offset, [&](const size_t i, const uint32_t w) {
+            out[i] = philox::to_uniform(w, low, high);
+        });
+    }
+
+    void normal(float* out, const size_t n, const float mean, const float std, const uint64_t seed,
+                const uint64_t offset) {
+        for_each_block(n, seed, offset, [&](const size_t first, const size_t lanes, const philox::Block& block) {
+            float values[4];
+            philox::to_normal(block, mean, std, values);
+            std::copy_n(values, lanes, out + first);
+        });
+    }
+
+    void bernoulli(float* out, const size_t n, const float p, const uint64_t seed, const uint64_t offset) {
+        for_each_word(n, seed, offset, [&](const size_t i, const uint32_t w) {
+            out[i] = philox::to_uniform(w) < p ? 1.0f : 0.0f;
+        });
+    }
+
+    void randint(int32_t* out, const size_t n, const int low, const int high, const uint64_t seed,
+                 const uint64_t offset) {
+        randint_impl(out, n, low, high, seed, offset);
+    }
+
+    void randint(float* out, const size_t n, const int low, const int high, const uint64_t seed,
+                 const uint64_t offset) {
+        randint_impl(out, n, low, high, seed, offset);
+    }
+
+    void randint(uint8_t* out, const size_t n, const int low, const int high, const uint64_t seed,
+                 const uint64_t offset) {
+        randint_impl(out, n, low, high, seed, offset);
+    }
+
+    bool multinomial(const float* weights, const size_t n, int64_t* samples, const size_t num_samples,
+                     const bool replacement, const uint64_t seed, const uint64_t offset) {
+        if (n == 0 || std::none_of(weights, weights + n, [](const float w) { return w > 0.0f; }))
+            return false;
+
+        if (replacement) {
+            std::vector<float> cdf(n);
+            build_cdf(weights, n, cdf.data());
+            for_each_word(num_samples, seed, offset, [&](const size_t i, const uint32_t w) {
+                samples[i] = philox::sample_cdf(cdf.data(), n, w);
+            });
+            return true;
+        }
+
+        std::vector<float> keys(n);
+        for_each_word(n, seed, offset, [&](const size_t i, const uint32_t w) {
+            keys[i] = philox::gumbel_key(w, weights[i]);
+        });
+        std::vector<int64_t> order(n);
+        cpu_sort::sort_rows(keys.data(), 1, n, /*descending=*/true, nullptr, order.data());
+        std::copy_n(order.begin(), std::min(num_samples, n), samples);
+        return true;
+    }
+
+} // namespace lfs::core::cpu_random
@@ -0,0 +1,380 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "internal/cpu_reduce.hpp"
+#include "internal/cpu_parallel.hpp"
+#include "internal/tensor_impl.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// SIMD intrinsics for CPU optimization
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace lfs::core::cpu_reduce {
+
+    namespace {
+
+        constexpr size_t REDUCE_GRAIN = 65536; // Input elements per reduction task
+        constexpr size_t INNER_CHUNK = 256;    // Output lanes per task for strided (inner > 1) reductions
+
+        // ============= Reducers =============
+        // Each reducer defines identity / accumulate / combine / finalize over an accumulator type.
+
+        template <typename T, typename AccT, typename OutT>
+        struct SumReducer {
+            using In = T;
+            using Acc = AccT;
+            using Out = OutT;
+            bool mean = false;
+
+            Acc identity() const { return Acc(0); }
+            void accumulate(Acc& acc, T v, int64_t) const { acc += static_cast<Acc>(v); }
+            Acc combine(Acc a, Acc b) const { return a + b; }
+            Out finalize(Acc acc, size_t count) const {
+                return static_cast<Out>(mean ? acc / static_cast<Acc>(count) : acc);
+            }
+        };
+
+        template <typename T, typename AccT, typename OutT>
+        struct ProdReducer {
+            using In = T;
+            using Acc = AccT;
+            using Out = OutT;
+
+            Acc identity() const { return Acc(1); }
+            void accumulate(Acc& acc, T v, int64_t) const { acc *= static_cast<Acc>(v); }
+            Acc combine(Acc a, Acc b) const { return a * b; }
+            Out finalize(Acc acc, size_t) const { return static_cast<Out>(acc); }
+        };
+
+        template <typename T, typename OutT, bool IsMax>
+        struct ExtremumReducer {
+            using In = T;
+            using Acc = T;
+            using Out = OutT;
+
+            Acc identity() const {
+                if constexpr (std::is_floating_point_v<T>) {
+                    return IsMax ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+                } else {
+                    return IsMax ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+                }
+            }
+            void accumulate(Acc& acc, T v, int64_t) const { acc = IsMax ? std::max(acc, v) : std::min(acc, v); }
+            Acc combine(Acc a, Acc b) const { return IsMax ? std::max(a, b) : std::min(a, b); }
+            Out finalize(Acc acc, size_t) const { return static_cast<Out>(acc); }
+        };
+
+        template <typename T>
+        struct ArgState {
+            T value;
+            int64_t index; // -1 = empty
+        };
+
+        // First occurrence wins on ties (partials are always merged left-to-right)
+        template <typename T, bool IsMax>
+        struct ArgReducer {
+            using In = T;
+            using Acc = ArgState<T>;
+            using Out = int64_t;
+
+            Acc identity() const { return {T{}, -1}; }
+            void accumulate(Acc& acc, T v, int64_t idx) const {
+                if (acc.index < 0 || (IsMax ? v > acc.value : v < acc.value)) {
+                    acc = {v, idx};
+                }
+            }
+            Acc combine(Acc a, Acc b) const {
+                if (b.index < 0) {
+                    return a;
+                }
+                if (a.index < 0) {
+                    return b;
+                }
+                return (IsMax ? b.value > a.value : b.value < a.value) ? b : a;
+            }
+            Out finalize(Acc acc, size_t) const { return acc.index < 0 ? 0 : acc.index; }
+        };
+
+        template <typename T, bool IsAll>
+        struct LogicalReducer {
+            using In = T;
+            using Acc = unsigned char;
+            using Out = unsigned char;
+
+            Acc identity() const { return IsAll ? 1 : 0; }
+            void accumulate(Acc& acc, T v, int64_t) const {
+                const bool nz = v != T(0);
+                acc = IsAll ? (acc && nz) : (acc || nz);
+            }
+            Acc combine(Acc a, Acc b) const { return IsAll ? (a && b) : (a || b); }
+            Out finalize(Acc acc, size_t) const { return acc; }
+        };
+
+        struct WelfordState {
+            double count;
+            double mean;
+            double m2;
+        };
+
+        struct VarianceReducer {
+            using In = float;
+            using Acc = WelfordState;
+            using Out = float;
+            bool unbiased = true;
+            bool take_sqrt = false;
+
+            Acc identity() const { return {0.0, 0.0, 0.0}; }
+            void accumulate(Acc& acc, float v, int64_t) const {
+                acc.count += 1.0;
+                const double delta = v - acc.mean;
+                acc.mean += delta / acc.count;
+                acc.m2 += delta * (v - acc.mean);
+            }
+            Acc combine(Acc a, Acc b) const {
+                if (b.count == 0.0) {
+                    return a;
+                }
+                if (a.count == 0.0) {
+                    return b;
+                }
+                const double count = a.count + b.count;
+                const double delta = b.mean - a.mean;
+                return {count,
+                        a.mean + delta * (b.count / count),
+                        a.m2 + b.m2 + delta * delta * (a.count * b.count / count)};
+            }
+            Out finalize(Acc acc, size_t count) const {
+                // Bessel's correction only when N > 1, matching the CUDA path
+                const double denom = (unbiased && count > 1) ? static_cast<double>(count - 1) : static_cast<double>(count);
+                const double var = acc.m2 / denom;
+                return static_cast<float>(take_sqrt ? std::sqrt(var) : var);
+            }
+        };
+
+        // ============= Contiguous segment kernels =============
+
+        template <typename R>
+        typename R::Acc segment(const R& r, const typename R::In* p, size_t n, int64_t base_index) {
+            using T = typename R::In;
+            using Acc = typename R::Acc;
+
+#if defined(__AVX2__)
+            if constexpr (std::is_same_v<R, SumReducer<float, double, float>>) {
+                // Widen to double in-register: 2 x 4 lanes per 8 floats
+                __m256d acc0 = _mm256_setzero_pd();
+                __m256d acc1 = _mm256_setzero_pd();
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    const __m256 v = _mm256_loadu_ps(p + i);
+                    acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+                    acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+                }
+                alignas(32) double lanes[4];
+                _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+                double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+                for (; i < n; ++i) {
+                    sum += p[i];
+                }
+                return sum;
+            } else if constexpr (std::is_same_v<R, ExtremumReducer<float, float, true>> ||
+                                 std::is_same_v<R, ExtremumReducer<float, float, false>>) {
+                // max_ps(x, acc) == std::max(acc, x) including NaN handling
+                constexpr bool is_max = std::is_same_v<R, ExtremumReducer<float, float, true>>;
+                __m256 acc = _mm256_set1_ps(r.identity());
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    const __m256 v = _mm256_loadu_ps(p + i);
+                    acc = is_max ? _mm256_max_ps(v, acc) : _mm256_min_ps(v, acc);
+                }
+                alignas(32) float lanes[8];
+                _mm256_store_ps(lanes, acc);
+                Acc result = r.identity();
+                for (float lane : lanes) {
+                    result = r.combine(result, lane);
+                }
+                for (; i < n; ++i) {
+                    r.accumulate(result, p[i], 0);
+                }
+                return result;
+            }
+#endif
+            Acc acc = r.identity();
+            for (size_t i = 0; i < n; ++i) {
+                r.accumulate(acc, static_cast<T>(p[i]), base_index + static_cast<int64_t>(i));
+            }
+            return acc;
+        }
+
+        // ============= Drivers =============
+
+        template <typename R>
+        void run(const R& r, const typename R::In* src, typename R::Out* dst,
+                 size_t outer, size_t reduce_size, size_t inner) {
+            using Acc = typename R::Acc;
+            const auto threads = static_cast<size_t>(cpu_parallel::num_threads());
+
+            if (inner == 1) {
+                if (outer >= 2 * threads || reduce_size <= REDUCE_GRAIN) {
+                    // Many independent segments: one or more whole segments per task
+                    const size_t grain = std::max<size_t>(1, REDUCE_GRAIN / reduce_size);
+                    cpu_parallel::parallel_for(outer, grain, [&](size_t begin, size_t end) {
+                        for (size_t o = begin; o < end; ++o) {
+                            dst[o] = r.finalize(segment(r, src + o * reduce_size, reduce_size, 0), reduce_size);
+                        }
+                    });
+                } else {
+                    // Few long segments: tree-reduce inside each segment
+                    for (size_t o = 0; o < outer; ++o) {
+                        const auto* seg = src + o * reduce_size;
+                        const Acc acc = cpu_parallel::parallel_reduce(
+                            reduce_size, REDUCE_GRAIN, r.identity(),
+                            [&](size_t begin, size_t end) {
+                                return segment(r, seg + begin, end - begin, static_cast<int64_t>(begin));
+                            },
+                            [&](const Acc& a, const Acc& b) { return r.combine(a, b); });
+                        dst[o] = r.finalize(acc, reduce_size);
+                    }
+                }
+                return;
+            }
+
+            // Strided reduction: accumulate INNER_CHUNK output lanes at once over contiguous rows
+            const size_t inner_chunks = (inner + INNER_CHUNK - 1) / INNER_CHUNK;
+            const size_t tasks = outer * inner_chunks;
+
+            if (tasks >= 2 * threads || reduce_size * inner <= REDUCE_GRAIN) {
+                const size_t per_task = reduce_size * std::min(inner, INNER_CHUNK);
+                const size_t grain = std::max<size_t>(1, REDUCE_GRAIN / per_task);
+                cpu_parallel::parallel_for(tasks, grain, [&](size_t begin, size_t end) {
+                    Acc acc[INNER_CHUNK];
+                    for (size_t t = begin; t < end; ++t) {
+                        const size_t o = t / inner_chunks;
+                        const size_t i0 = (t % inner_chunks) * INNER_CHUNK;
+                        const size_t width = std::min(INNER_CHUNK, inner - i0);
+                        const auto* base = src + o * reduce_size * inner + i0;
+
+                        std::fill_n(acc, width, r.identity());
+                        for (size_t k = 0; k < reduce_size; ++k) {
+                            const auto* row = base + k * inner;
+                            for (size_t i = 0; i < width; ++i) {
+                                r.accumulate(acc[i], row[i], static_cast<int64_t>(k));
+                            }
+                        }
+                        auto* out = dst + o * inner + i0;
+                        for (size_t i = 0; i < width; ++i) {
+                            out[i] = r.finalize(acc[i], reduce_size);
+                        }
+                    }
+                });
+                return;
+            }
+
+            // Few outputs, long reduced axis (e.g. [N, 3] reduced over N): split the
+            // reduced axis across threads and merge per-lane partials
+            for (size_t o = 0; o < outer; ++o) {
+                const auto* base = src + o * reduce_size * inner;
+                const size_t grain = std::max<size_t>(1, REDUCE_GRAIN / inner);
+                const std::vector<Acc> lanes = cpu_parallel::parallel_reduce(
+                    reduce_size, grain, std::vector<Acc>(inner, r.identity()),
+                    [&](size_t begin, size_t end) {
+                        std::vector<Acc> acc(inner, r.identity());
+                        for (size_t k = begin; k < end; ++k) {
+                            const auto* row = base + k * inner;
+                            for (size_t i = 0; i < inner; ++i) {
+                                r.accumulate(acc[i], row[i], static_cast<int64_t>(k));
+                            }
+                        }
+                        return acc;
+                    },
+                    [&](std::vector<Acc> a, const std::vector<Acc>& b) {
+                        for (size_t i = 0; i < inner; ++i) {
+                            a[i] = r.combine(a[i], b[i]);
+                        }
+                        return a;
+                    });
+                auto* out = dst + o * inner;
+                for (size_t i = 0; i < inner; ++i) {
+                    out[i] = r.finalize(lanes[i], reduce_size);
+                }
+            }
+        }
+
+        template <typename R>
+        bool dispatch(const R& r, const void* src, void* dst, size_t outer, size_t reduce_size, size_t inner) {
+            run(r, static_cast<const typename R::In*>(src), static_cast<typename R::Out*>(dst),
+                outer, reduce_size, inner);
+            return true;
+        }
+
+        // Integer inputs: sums and products accumulate in int64
+        template <typename T>
+        bool reduce_integer(const void* src, void* dst, ReduceOp op,
+                            size_t outer, size_t reduce_size, size_t inner) {
+            switch (op) {
+            case ReduceOp::Sum: return dispatch(SumReducer<T, int64_t, T>{false}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Mean: return dispatch(SumReducer<T, int64_t, T>{true}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Prod: return dispatch(ProdReducer<T, int64_t, T>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Max: return dispatch(ExtremumReducer<T, T, true>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Min: return dispatch(ExtremumReducer<T, T, false>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Argmax: return dispatch(ArgReducer<T, true>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Argmin: return dispatch(ArgReducer<T, false>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Any: return dispatch(LogicalReducer<T, false>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::All: return dispatch(LogicalReducer<T, true>{}, src, dst, outer, reduce_size, inner);
+            default: return false;
+            }
+        }
+
+    } // namespace
+
+    bool reduce(const void* src, void* dst, DataType dtype, ReduceOp op,
+                size_t outer, size_t reduce_size, size_t inner, bool unbiased) {
+        if (outer * inner == 0) {
+            return true;
+        }
+
+        switch (dtype) {
+        case DataType::Float32:
+            switch (op) {
+            case ReduceOp::Sum: return dispatch(SumReducer<float, double, float>{false}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Mean: return dispatch(SumReducer<float, double, float>{true}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Prod: return dispatch(ProdReducer<float, float, float>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Max: return dispatch(ExtremumReducer<float, float, true>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Min: return dispatch(ExtremumReducer<float, float, false>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Argmax: return dispatch(ArgReducer<float, true>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Argmin: return dispatch(ArgReducer<float, false>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Any: return dispatch(LogicalReducer<float, false>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::All: return dispatch(LogicalReducer<float, true>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Var: return dispatch(VarianceReducer{unbiased, false}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Std: return dispatch(VarianceReducer{unbiased, true}, src, dst, outer, reduce_size, inner);
+            default: return false;
+            }
+        case DataType::Int32:
+            return reduce_integer<int32_t>(src, dst, op, outer, reduce_size, inner);
+        case DataType::Int64:
+            return reduce_integer<int64_t>(src, dst, op, outer, reduce_size, inner);
+        case DataType::Bool:
+            // Bool reductions produce Int64 counts (PyTorch behavior), Any/All stay Bool
+            switch (op) {
+            case ReduceOp::Sum: return dispatch(SumReducer<unsigned char, int64_t, int64_t>{false}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Mean: return dispatch(SumReducer<unsigned char, int64_t, int64_t>{true}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Prod:
+            case ReduceOp::Min: return dispatch(ExtremumReducer<unsigned char, int64_t, false>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Max: return dispatch(ExtremumReducer<unsigned char, int64_t, true>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Argmax: return dispatch(ArgReducer<unsigned char, true>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Argmin: return dispatch(ArgReducer<unsigned char, false>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::Any: return dispatch(LogicalReducer<unsigned char, false>{}, src, dst, outer, reduce_size, inner);
+            case ReduceOp::All: return dispatch(LogicalReducer<unsigned char, true>{}, src, dst, outer, reduce_size, inner);
+            default: return false;
+            }
+        default:
+            return false;
+        }
+    }
+
+} // namespace lfs::core::cpu_reduce
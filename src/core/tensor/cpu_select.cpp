@@ -0,0 +1,292 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "internal/cpu_select.hpp"
+#include "internal/cpu_parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace lfs::core::cpu_select {
+
+    namespace {
+
+        // Keys per task in the parallel passes
+        constexpr size_t SELECT_GRAIN = size_t{1} << 16;
+        // Rows shorter than this are selected on one thread
+        constexpr size_t PARALLEL_MIN = size_t{1} << 17;
+        // Rows per task when many rows run in parallel, scaled by row length
+        constexpr size_t ROW_GRAIN_ELEMENTS = size_t{1} << 15;
+        // Buckets this small finish with nth_element
+        constexpr size_t NTH_ELEMENT_MAX = 4096;
+
+        constexpr int DIGIT_BITS = 11;
+        constexpr size_t BINS = size_t{1} << DIGIT_BITS;
+        constexpr std::array<int, 3> DIGIT_SHIFTS = {21, 10, 0};
+
+        size_t num_chunks(const size_t n) { return (n + SELECT_GRAIN - 1) / SELECT_GRAIN; }
+
+        // Exact finish on a small candidate set; less/equal are counted within it
+        Selection select_small(std::vector<uint32_t>& keys, const size_t rank) {
+            std::nth_element(keys.begin(), keys.begin() + rank, keys.end());
+            Selection s;
+            s.key = keys[rank];
+            for (const uint32_t k : keys) {
+                s.less += k < s.key;
+                s.equal += k == s.key;
+            }
+            return s;
+        }
+
+        Selection select_parallel(const uint32_t* keys, const size_t n, size_t rank) {
+            const uint32_t* candidates = keys;
+            size_t count = n;
+            std::vector<uint32_t> buffer;
+            std::vector<uint32_t> histograms;
+            size_t less = 0;
+
+            for (size_t level = 0; level < DIGIT_SHIFTS.size(); ++level) {
+                const int shift = DIGIT_SHIFTS[level];
+                const size_t chunks = num_chunks(count);
+
+                // Per-chunk histograms; the chunk layout is reused for the gather below
+                histograms.assign(chunks * BINS, 0);
+                cpu_parallel::parallel_for(chunks, 1, [&](const size_t c_begin, const size_t c_end) {
+                    for (size_t c = c_begin; c < c_end; ++c) {
+                        uint32_t* const hist = histograms.data() + c * BINS;
+                        const size_t end = std::min(count, (c + 1) * SELECT_GRAIN);
+                        for (size_t i = c * SELECT_GRAIN; i < end; ++i)
+                            ++hist[(candidates[i] >> shift) & (BINS - 1)];
+                    }
+                });
+
+                std::vector<size_t> totals(BINS, 0);
+                for (size_t c = 0; c < chunks; ++c) {
+                    for (size_t b = 0; b < BINS; ++b)
+                        totals[b] += histograms[c * BINS + b];
+                }
+                size_t bucket = 0;
+                while (rank >= totals[bucket]) {
+                    rank -= totals[bucket];
+                    less += totals[bucket];
+                    ++bucket;
+                }
+
+                // Keep only the bucket holding the rank, in order
+                std::vector<size_t> offsets(chunks + 1, 0);
+                for (size_t c = 0; c < chunks; ++c)
+                    offsets[c + 1] = offsets[c] + histograms[c * BINS + bucket];
+                std::vector<uint32_t> next(totals[bucket]);
+                cpu_parallel::parallel_for(chunks, 1, [&](const size_t c_begin, const size_t c_end) {
+                    for (size_t c = c_begin; c < c_end; ++c) {
+                        uint32_t* out = next.data() + offsets[c];
+                        const size_t end = std::min(count, (c + 1) * SELECT_GRAIN);
+                        for (size_t i = c * SELECT_GRAIN; i < end; ++i) {
+                            if (((candidates[i] >> shift) & (BINS - 1)) == bucket)
+                                *out++ = candidates[i];
+                        }
+                    }
+                });
+
+                buffer = std::move(next);
+                candidates = buffer.data();
+                count = buffer.size();
+                if (count <= NTH_ELEMENT_MAX || level + 1 == DIGIT_SHIFTS.size())
+                    break;
+            }
+
+            Selection s = select_small(buffer, rank);
+            s.less += less;
+            return s;
+        }
+
+        // Row keys, flipped so that the wanted end of the order comes first
+        void make_keys(const float* src, const size_t len, const uint32_t flip, const bool parallel,
+                       std::vector<uint32_t>& keys) {
+            keys.resize(len);
+            const auto convert = [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    keys[i] = float_to_key(src[i]) ^ flip;
+            };
+            if (parallel) {
+                cpu_parallel::parallel_for(len, SELECT_GRAIN, convert);
+            } else {
+                convert(0, len);
+            }
+        }
+
+        Selection select_row(const std::vector<uint32_t>& keys, const size_t rank, const bool parallel) {
+            if (parallel)
+                return select_parallel(keys.data(), keys.size(), rank);
+            std::vector<uint32_t> copy(keys);
+            return select_small(copy, rank);
+        }
+
+        /**
+         * Stable three-way split of indices around `pivot`; the equal group is capped at
+         * `equal_cap`. Null outputs are skipped.
+         */
+        void partition_indices(const std::vector<uint32_t>& keys, const uint32_t pivot, const size_t equal_cap,
+                               int64_t* less_out, int64_t* equal_out, int64_t* greater_out, const bool parallel) {
+            const size_t n = keys.size();
+            const auto scatter = [&](const size_t begin, const size_t end,
+                                     size_t less_pos, size_t equal_pos, size_t greater_pos) {
+                for (size_t i = begin; i < end; ++i) {
+                    const uint32_t k = keys[i];
+                    if (k < pivot) {
+                        if (less_out)
+                            less_out[less_pos] = static_cast<int64_t>(i);
+                        ++less_pos;
+                    } else if (k == pivot) {
+                        if (equal_out && equal_pos < equal_cap)
+                            equal_out[equal_pos] = static_cast<int64_t>(i);
+                        ++equal_pos;
+                    } else {
+                        if (greater_out)
+                            greater_out[greater_pos] = static_cast<int64_t>(i);
+                        ++greater_pos;
+                    }
+                }
+            };
+
+            if (!parallel) {
+                scatter(0, n, 0, 0, 0);
+                return;
+            }
+
+            struct Counts {
+                size_t less = 0, equal = 0, greater = 0;
+            };
+            const size_t chunks = num_chunks(n);
+            std::vector<Counts> offsets(chunks + 1);
+            cpu_parallel::parallel_for(chunks, 1, [&](const size_t c_begin, const size_t c_end) {
+                for (size_t c = c_begin; c < c_end; ++c) {
+                    Counts counts;
+                    const size_t end = std::min(n, (c + 1) * SELECT_GRAIN);
+                    for (size_t i = c * SELECT_GRAIN; i < end; ++i) {
+                        counts.less += keys[i] < pivot;
+                        counts.equal += keys[i] == pivot;
+                    }
+                    counts.greater = end - c * SELECT_GRAIN - counts.less - counts.equal;
+                    offsets[c + 1] = counts;
+                }
+            });
+            for (size_t c = 0; c < chunks; ++c) {
+                offsets[c + 1].less += offsets[c].less;
+                offsets[c + 1].equal += offsets[c].equal;
+                offsets[c + 1].greater += offsets[c].greater;
+            }
+            cpu_parallel::parallel_for(chunks, 1, [&](const size_t c_begin, const size_t c_end) {
+                for (size_t c = c_begin; c < c_end; ++c) {
+                    scatter(c * SELECT_GRAIN, std::min(n, (c + 1) * SELECT_GRAIN),
+                            offsets[c].less, offsets[c].equal, offsets[c].greater);
+                }
+            });
+        }
+
+        // Runs fn(row, parallel): many rows in parallel, or one row split internally
+        template <typename Fn>
+        void for_each_row(const size_t rows, const size_t len, Fn&& fn) {
+            if (rows == 1) {
+                fn(size_t{0}, len >= PARALLEL_MIN);
+                return;
+            }
+            const size_t grain = std::max<size_t>(1, ROW_GRAIN_ELEMENTS / std::max<size_t>(len, 1));
+            cpu_parallel::parallel_for(rows, grain, [&](const size_t begin, const size_t end) {
+                for (size_t r = begin; r < end; ++r)
+                    fn(r, false);
+            });
+        }
+
+    } // namespace
+
+    Selection select(const uint32_t* keys, const size_t n, const size_t rank) {
+        if (n >= PARALLEL_MIN)
+            return select_parallel(keys, n, rank);
+        std::vector<uint32_t> copy(keys, keys + n);
+        return select_small(copy, rank);
+    }
+
+    void topk(const float* src, const size_t rows, const size_t len, const size_t k, const bool largest,
+              const bool sorted, float* values, int64_t* indices) {
+        if (k == 0)
+            return;
+        const uint32_t flip = largest ? 0xFFFFFFFFu : 0u;
+        for_each_row(rows, len, [&](const size_t row, const bool parallel) {
+            std::vector<uint32_t> keys;
+            make_keys(src + row * len, len, flip, parallel, keys);
+            const Selection s = select_row(keys, k - 1, parallel);
+
+            int64_t* const out_idx = indices + row * k;
+            partition_indices(keys, s.key, k - s.less, out_idx, out_idx + s.less, nullptr, parallel);
+
+            if (sorted) {
+                std::sort(out_idx, out_idx + k, [&](const int64_t a, const int64_t b) {
+                    return keys[a] != keys[b] ? keys[a] < keys[b] : a < b;
+                });
+            }
+            float* const out_val = values + row * k;
+            for (size_t i = 0; i < k; ++i)
+                out_val[i] = key_to_float(keys[out_idx[i]] ^ flip);
+        });
+    }
+
+    void kthvalue(const float* src, const size_t rows, const size_t len, const size_t k, float* values,
+                  int64_t* indices) {
+        for_each_row(rows, len, [&](const size_t row, const bool parallel) {
+            std::vector<uint32_t> keys;
+            make_keys(src + row * len, len, 0u, parallel, keys);
+            const Selection s = select_row(keys, k, parallel);
+            values[row] = key_to_float(s.key);
+            indices[row] = std::find(keys.begin(), keys.end(), s.key) - keys.begin();
+        });
+    }
+
+    void quantile(const float* src, const size_t rows, const size_t len, const double q, float* out) {
+        const double pos = q * static_cast<double>(len - 1);
+        const auto lo = static_cast<size_t>(std::floor(pos));
+        const size_t hi = std::min(lo + 1, len - 1);
+        const double frac = pos - static_cast<double>(lo);
+
+        for_each_row(rows, len, [&](const size_t row, const bool parallel) {
+            std::vector<uint32_t> keys;
+            make_keys(src + row * len, len, 0u, parallel, keys);
+            const Selection s = select_row(keys, lo, parallel);
+            const double lo_value = key_to_float(s.key);
+
+            // The next rank is either another copy of the same key or the smallest key above it
+            double hi_value = lo_value;
+            if (hi >= s.less + s.equal) {
+                const auto smallest_above = [&](const size_t begin, const size_t end) {
+                    uint32_t next = 0xFFFFFFFFu;
+                    for (size_t i = begin; i < end; ++i) {
+                        if (keys[i] > s.key && keys[i] < next)
+                            next = keys[i];
+                    }
+                    return next;
+                };
+                const uint32_t next = parallel
+                                          ? cpu_parallel::parallel_reduce(
+                                                len, SELECT_GRAIN, 0xFFFFFFFFu, smallest_above,
+                                                [](const uint32_t a, const uint32_t b) { return std::min(a, b); })
+                                          : smallest_above(0, len);
+                hi_value = key_to_float(next);
+            }
+            out[row] = static_cast<float>(lo_value + (hi_value - lo_value) * frac);
+        });
+    }
+
+    void argpartition(const float* src, const size_t rows, const size_t len, const size_t kth,
+                      int64_t* indices) {
+        for_each_row(rows, len, [&](const size_t row, const bool parallel) {
+            std::vector<uint32_t> keys;
+            make_keys(src + row * len, len, 0u, parallel, keys);
+            const Selection s = select_row(keys, kth, parallel);
+            int64_t* const out = indices + row * len;
+            partition_indices(keys, s.key, s.equal, out, out + s.less, out + s.less + s.equal, parallel);
+        });
+    }
+
+} // namespace lfs::core::cpu_select
@@ -0,0 +1,286 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "internal/cpu_sort.hpp"
+#include "internal/cpu_select.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace lfs::core::cpu_sort {
+
+    namespace {
+
+        // Items per chunk in the parallel histogram/scatter passes
+        constexpr size_t SORT_GRAIN = size_t{1} << 16;
+        // Rows shorter than this are sorted on one thread
+        constexpr size_t PARALLEL_MIN = size_t{1} << 17;
+        // Rows shorter than this use std::sort, which beats the fixed cost of 256-bin passes
+        constexpr size_t RADIX_MIN = 256;
+        // Rows per task when many rows run in parallel, scaled by row length
+        constexpr size_t ROW_GRAIN_ELEMENTS = size_t{1} << 15;
+
+        constexpr size_t BINS = 256;
+
+        // Unsigned keys with the order of the source type. All NaNs share the largest key and
+        // -0 sorts as +0, so both compare equal like the values they come from.
+        uint32_t sort_key(const float v) {
+            if (std::isnan(v))
+                return std::numeric_limits<uint32_t>::max();
+            return cpu_select::float_to_key(v == 0.0f ? 0.0f : v);
+        }
+        uint32_t sort_key(const int32_t v) { return static_cast<uint32_t>(v) ^ 0x80000000u; }
+        uint64_t sort_key(const int64_t v) { return static_cast<uint64_t>(v) ^ (uint64_t{1} << 63); }
+
+        struct KeyIndex {
+            uint64_t key;
+            int64_t index;
+        };
+
+        /**
+         * LSD radix sort over `passes` 8-bit digits; digit(item, pass) extracts one. Each pass
+         * is stable, so items end up ordered by the full digit sequence and keep their input
+         * order on ties. Passes where every item has the same digit are skipped.
+         */
+        template <typename Item, typename DigitFn>
+        void radix_sort(std::vector<Item>& items, std::vector<Item>& tmp, const int passes, DigitFn digit,
+                        const bool parallel) {
+            const size_t n = items.size();
+            tmp.resize(n);
+            Item* src = items.data();
+            Item* dst = tmp.data();
+
+            if (!parallel) {
+                std::array<size_t, BINS> hist;
+                for (int pass = 0; pass < passes; ++pass) {
+                    hist.fill(0);
+                    for (size_t i = 0; i < n; ++i)
+                        ++hist[digit(src[i], pass)];
+                    if (std::find(hist.begin(), hist.end(), n) != hist.end())
+                        continue;
+                    size_t sum = 0;
+                    for (size_t& h : hist)
+                        sum += std::exchange(h, sum);
+                    for (size_t i = 0; i < n; ++i)
+                        dst[hist[digit(src[i], pass)]++] = src[i];
+                    std::swap(src, dst);
+                }
+            } else {
+                const size_t chunks = (n + SORT_GRAIN - 1) / SORT_GRAIN;
+                std::vector<size_t> hist(chunks * BINS);
+                for (int pass = 0; pass < passes; ++pass) {
+                    std::fill(hist.begin(), hist.end(), 0);
+                    cpu_parallel::parallel_for(chunks, 1, [&](const size_t c_begin, const size_t c_end) {
+                        for (size_t c = c_begin; c < c_end; ++c) {
+                            size_t* const h = hist.data() + c * BINS;
+                            const size_t end = std::min(n, (c + 1) * SORT_GRAIN);
+                            for (size_t i = c * SORT_GRAIN; i < end; ++i)
+                                ++h[digit(src[i], pass)];
+                        }
+                    });
+
+                    // Bucket-major exclusive scan turns counts into per-chunk write offsets
+                    size_t sum = 0;
+                    bool single_bucket = false;
+                    for (size_t b = 0; b < BINS && !single_bucket; ++b) {
+                        const size_t bucket_begin = sum;
+                        for (size_t c = 0; c < chunks; ++c)
+                            sum += std::exchange(hist[c * BINS + b], sum);
+                        single_bucket = (sum - bucket_begin == n);
+                    }
+                    if (single_bucket)
+                        continue;
+
+                    cpu_parallel::parallel_for(chunks, 1, [&](const size_t c_begin, const size_t c_end) {
+                        for (size_t c = c_begin; c < c_end; ++c) {
+                            size_t* const offsets = hist.data() + c * BINS;
+                            const size_t end = std::min(n, (c + 1) * SORT_GRAIN);
+                            for (size_t i = c * SORT_GRAIN; i < end; ++i)
+                                dst[offsets[digit(src[i], pass)]++] = src[i];
+                        }
+                    });
+                    std::swap(src, dst);
+                }
+            }
+
+            if (src != items.data())
+                items.swap(tmp);
+        }
+
+        template <typename Fn>
+        void for_range(const size_t n, const bool parallel, Fn&& fn) {
+            if (parallel) {
+                cpu_parallel::parallel_for(n, SORT_GRAIN, fn);
+            } else {
+                fn(size_t{0}, n);
+            }
+        }
+
+        // 32-bit keys: (key << 32 | index) words, so ordering the words orders by key, then index
+        template <typename T>
+        void sort_row_packed(const T* src, const size_t len, const bool descending, T* values, int64_t* indices,
+                             const bool parallel) {
+            const uint32_t flip = descending ? 0xFFFFFFFFu : 0u;
+            std::vector<uint64_t> items(len);
+            for_range(len, parallel, [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    items[i] = (static_cast<uint64_t>(sort_key(src[i]) ^ flip) << 32) | i;
+            });
+
+            if (len < RADIX_MIN) {
+                std::sort(items.begin(), items.end());
+            } else {
+                std::vector<uint64_t> tmp;
+                radix_sort(
+                    items, tmp, 4,
+                    [](const uint64_t item, const int pass) { return static_cast<size_t>((item >> (32 + 8 * pass)) & 0xFF); },
+                    parallel);
+            }
+
+            for_range(len, parallel, [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const auto index = static_cast<int64_t>(items[i] & 0xFFFFFFFFu);
+                    indices[i] = index;
+                    if (values)
+                        values[i] = src[index];
+                }
+            });
+        }
+
+        // 64-bit keys (or rows too long to pack an index): separate key and index fields
+        template <typename T>
+        void sort_row_pairs(const T* src, const size_t len, const bool descending, T* values, int64_t* indices,
+                            const bool parallel) {
+            const uint64_t flip = descending ? ~uint64_t{0} : 0u;
+            std::vector<KeyIndex> items(len);
+            for_range(len, parallel, [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    items[i] = {static_cast<uint64_t>(sort_key(src[i])) ^ flip, static_cast<int64_t>(i)};
+            });
+
+            if (len < RADIX_MIN) {
+                std::sort(items.begin(), items.end(), [](const KeyIndex& a, const KeyIndex& b) {
+                    return a.key != b.key ? a.key < b.key : a.index < b.index;
+                });
+            } else {
+                constexpr int passes = static_cast<int>(sizeof(decltype(sort_key(T{}))));
+                std::vector<KeyIndex> tmp;
+                radix_sort(
+                    items, tmp, passes,
+                    [](const KeyIndex& item, const int pass) { return static_cast<size_t>((item.key >> (8 * pass)) & 0xFF); },
+                    parallel);
+            }
+
+            for_range(len, parallel, [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    indices[i] = items[i].index;
+                    if (values)
+                        values[i] = src[items[i].index];
+                }
+            });
+        }
+
+        // Runs fn(row, parallel): many rows in parallel, or one row split internally
+        template <typename Fn>
+        void for_each_row(const size_t rows, const size_t len, Fn&& fn) {
+            if (rows == 1) {
+                fn(size_t{0}, len >= PARALLEL_MIN);
+                return;
+            }
+            const size_t grain = std::max<size_t>(1, ROW_GRAIN_ELEMENTS / std::max<size_t>(len, 1));
+            cpu_parallel::parallel_for(rows, grain, [&](const size_t begin, const size_t end) {
+                for (size_t r = begin; r < end; ++r)
+                    fn(r, false);
+            });
+        }
+
+        template <typename T>
+        void sort_rows_impl(const T* src, const size_t rows, const size_t len, const bool descending, T* values,
+                            int64_t* indices) {
+            if (len == 0)
+                return;
+            for_each_row(rows, len, [&](const size_t row, const bool parallel) {
+                const T* const in = src + row * len;
+                T* const out_values = values ? values + row * len : nullptr;
+                int64_t* const out_indices = indices + row * len;
+                if constexpr (sizeof(sort_key(T{})) == 4) {
+                    if (len <= std::numeric_limits<uint32_t>::max()) {
+                        sort_row_packed(in, len, descending, out_values, out_indices, parallel);
+                        return;
+                    }
+                }
+                sort_row_pairs(in, len, descending, out_values, out_indices, parallel);
+            });
+        }
+
+        template <typename T>
+        size_t unique_impl(const T* src, const size_t n, T* out, int64_t* inverse, int64_t* counts) {
+            if (n == 0)
+                return 0;
+
+            std::vector<T> sorted(n);
+            std::vector<int64_t> order(n);
+            sort_rows_impl(src, 1, n, false, sorted.data(), order.data());
+
+            // Each distinct value starts where its sort key differs from the previous one
+            std::vector<size_t> starts(n);
+            const size_t count = compact(
+                n,
+                [&](const size_t i) { return i == 0 || sort_key(sorted[i]) != sort_key(sorted[i - 1]); },
+                [&](const size_t i, const size_t pos) {
+                    starts[pos] = i;
+                    out[pos] = sorted[i];
+                });
+
+            if (counts) {
+                for (size_t j = 0; j < count; ++j)
+                    counts[j] = static_cast<int64_t>((j + 1 < count ? starts[j + 1] : n) - starts[j]);
+            }
+            if (inverse) {
+                cpu_parallel::parallel_for(n, COMPACT_GRAIN, [&](const size_t begin, const size_t end) {
+                    size_t j = static_cast<size_t>(std::upper_bound(starts.begin(), starts.begin() + count, begin) -
+                                                   starts.begin()) -
+                               1;
+                    for (size_t i = begin; i < end; ++i) {
+                        while (j + 1 < count && starts[j + 1] <= i)
+                            ++j;
+                        inverse[order[i]] = static_cast<int64_t>(j);
+                    }
+                });
+            }
+            return count;
+        }
+
+    } // namespace
+
+    void sort_rows(const float* src, const size_t rows, const size_t len, const bool descending, float* values,
+                   int64_t* indices) {
+        sort_rows_impl(src, rows, len, descending, values, indices);
+    }
+
+    void sort_rows(const int32_t* src, const size_t rows, const size_t len, const bool descending, int32_t* values,
+                   int64_t* indices) {
+        sort_rows_impl(src, rows, len, descending, values, indices);
+    }
+
+    void sort_rows(const int64_t* src, const size_t rows, const size_t len, const bool descending, int64_t* values,
+                   int64_t* indices) {
+        sort_rows_impl(src, rows, len, descending, values, indices);
+    }
+
+    size_t unique(const float* src, const size_t n, float* out, int64_t* inverse, int64_t* counts) {
+        return unique_impl(src, n, out, inverse, counts);
+    }
+
+    size_t unique(const int32_t* src, const size_t n, int32_t* out, int64_t* inverse, int64_t* counts) {
+        return unique_impl(src, n, out, inverse, counts);
+    }
+
+    size_t unique(const int64_t* src, const size_t n, int64_t* out, int64_t* inverse, int64_t* counts) {
+        return unique_impl(src, n, out, inverse, counts);
+    }
+
+} // namespace lfs::core::cpu_sort
@@ -0,0 +1,258 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "internal/host_arena_allocator.hpp"
+#include "core/logger.hpp"
+#include "internal/allocation_profiler.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+namespace lfs::core {
+
+    namespace {
+        constexpr size_t align_up(size_t bytes, size_t alignment) {
+            return (bytes + alignment - 1) & ~(alignment - 1);
+        }
+
+        void* system_alloc(size_t bytes) {
+#ifdef _WIN32
+            return _aligned_malloc(bytes, HOST_ALLOC_ALIGNMENT);
+#else
+            return std::aligned_alloc(HOST_ALLOC_ALIGNMENT, align_up(bytes, HOST_ALLOC_ALIGNMENT));
+#endif
+        }
+
+        void system_free(void* ptr) {
+#ifdef _WIN32
+            _aligned_free(ptr);
+#else
+            std::free(ptr);
+#endif
+        }
+    } // namespace
+
+    HostArenaAllocator& HostArenaAllocator::instance() {
+        // Intentionally leaked: CPU tensors with static storage duration may be
+        // released after function-local statics are destroyed
+        static auto* allocator = new HostArenaAllocator();
+        return *allocator;
+    }
+
+    size_t HostArenaAllocator::round_block_size(size_t bytes) {
+        // Quarter power-of-two classes: at most 25% slack, few distinct classes
+        const size_t msb = std::bit_floor(bytes);
+        const size_t step = std::max<size_t>(msb / 4, HOST_ALLOC_ALIGNMENT);
+        return align_up(bytes, step);
+    }
+
+    void* HostArenaAllocator::allocate_from_arenas(size_t bytes, Record& record) {
+        const auto size = static_cast<uint32_t>(align_up(bytes, HOST_ALLOC_ALIGNMENT));
+
+        for (size_t i = 0; i < arenas_.size(); ++i) {
+            auto& arena = arenas_[i];
+            const auto alloc = arena.allocator->allocate(size);
+            if (alloc.offset != OffsetAllocator::Allocation::NO_SPACE) {
+                ++arena.live;
+                ++stats_.cache_hits;
+                record = {Source::Arena, static_cast<uint32_t>(i), alloc, size, bytes};
+                return static_cast<char*>(arena.base) + alloc.offset;
+            }
+        }
+
+        if (arenas_.size() >= HOST_MAX_ARENAS) {
+            return nullptr;
+        }
+
+        Arena arena;
+        arena.base = system_alloc(HOST_ARENA_CHUNK_SIZE);
+        if (!arena.base) {
+            return nullptr;
+        }
+        arena.allocator = std::make_unique<OffsetAllocator::Allocator>(static_cast<uint32_t>(HOST_ARENA_CHUNK_SIZE));
+        const auto alloc = arena.allocator->allocate(size);
+        arena.live = 1;
+        arenas_.push_back(std::move(arena));
+
+        ++stats_.cache_misses;
+        stats_.reserved_bytes += HOST_ARENA_CHUNK_SIZE;
+        stats_.num_arenas = arenas_.size();
+        LOG_DEBUG("Host arena {} created ({} MB)", arenas_.size() - 1, HOST_ARENA_CHUNK_SIZE >> 20);
+
+        record = {Source::Arena, static_cast<uint32_t>(arenas_.size() - 1), alloc, size, bytes};
+        return arenas_.back().base;
+    }
+
+    void* HostArenaAllocator::allocate_block(size_t bytes, Record& record) {
+        const size_t size = round_block_size(bytes);
+
+        if (auto it = block_cache_.find(size); it != block_cache_.end() && !it->second.empty()) {
+            void* ptr = it->second.back();
+            it->second.pop_back();
+            ++stats_.cache_hits;
+            stats_.cached_bytes -= size;
+            record = {Source::Block, 0, {}, size, bytes};
+            return ptr;
+        }
+
+        void* ptr = system_alloc(size);
+        if (!ptr && stats_.cached_bytes > 0) {
+            // Give cached blocks back to the OS and retry once
+            for (auto& [block_size, blocks] : block_cache_) {
+                for (void* block : blocks) {
+                    system_free(block);
+                    stats_.reserved_bytes -= block_size;
+                }
+            }
+            block_cache_.clear();
+            stats_.cached_bytes = 0;
+            ptr = system_alloc(size);
+        }
+        if (!ptr) {
+            return nullptr;
+        }
+
+        ++stats_.cache_misses;
+        stats_.reserved_bytes += size;
+        record = {Source::Block, 0, {}, size, bytes};
+        return ptr;
+    }
+
+    void* HostArenaAllocator::allocate(size_t bytes) {
+        if (bytes == 0) {
+            return nullptr;
+        }
+
+        void* ptr = nullptr;
+        Record record{};
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (!enabled_) {
+                ptr = system_alloc(bytes);
+                record = {Source::System, 0, {}, bytes, bytes};
+            } else if (bytes < HOST_ARENA_THRESHOLD) {
+                ptr = allocate_from_arenas(bytes, record);
+                if (!ptr) {
+                    // Arenas exhausted or fragmented: fall back to a standalone block
+                    ptr = allocate_block(bytes, record);
+                }
+            } else {
+                ptr = allocate_block(bytes, record);
+            }
+
+            if (!ptr) {
+                return nullptr;
+            }
+
+            records_[ptr] = record;
+            ++stats_.num_allocs;
+            stats_.allocated_bytes += bytes;
+            stats_.peak_allocated_bytes = std::max(stats_.peak_allocated_bytes, stats_.allocated_bytes);
+        }
+
+        AllocationProfiler::instance().record_allocation(bytes, 3);
+        return ptr;
+    }
+
+    void HostArenaAllocator::deallocate(void* ptr) {
+        if (!ptr) {
+            return;
+        }
+
+        if constexpr (ENABLE_ALLOCATION_PROFILING) {
+            AllocationProfiler::instance().record_deallocation(ptr);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = records_.find(ptr);
+        if (it == records_.end()) {
+            LOG_ERROR("Attempted to free pointer not allocated by host pool: {}", ptr);
+            return;
+        }
+        const Record record = it->second;
+        records_.erase(it);
+
+        ++stats_.num_deallocs;
+        stats_.allocated_bytes -= record.requested;
+
+        switch (record.source) {
+        case Source::Arena: {
+            auto& arena = arenas_[record.arena];
+            arena.allocator->free(record.allocation);
+            if (--arena.live == 0) {
+                release_idle_arenas(HOST_MAX_IDLE_ARENAS);
+            }
+            break;
+        }
+        case Source::Block:
+            if (stats_.cached_bytes + record.size <= HOST_MAX_CACHED_BYTES) {
+                block_cache_[record.size].push_back(ptr);
+                stats_.cached_bytes += record.size;
+            } else {
+                system_free(ptr);
+                stats_.reserved_bytes -= record.size;
+            }
+            break;
+        case Source::System:
+            system_free(ptr);
+            break;
+        }
+    }
+
+    void HostArenaAllocator::trim() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto& [size, blocks] : block_cache_) {
+            for (void* block : blocks) {
+                system_free(block);
+                stats_.reserved_bytes -= size;
+            }
+        }
+        block_cache_.clear();
+        stats_.cached_bytes = 0;
+
+        release_idle_arenas(0);
+    }
+
+    void HostArenaAllocator::release_idle_arenas(const size_t keep) {
+        // Only trailing arenas can go: records_ refer to arenas by index
+        size_t idle = 0;
+        while (idle < arenas_.size() && arenas_[arenas_.size() - 1 - idle].live == 0) {
+            ++idle;
+        }
+        for (; idle > keep; --idle) {
+            system_free(arenas_.back().base);
+            arenas_.pop_back();
+            stats_.reserved_bytes -= HOST_ARENA_CHUNK_SIZE;
+        }
+        stats_.num_arenas = arenas_.size();
+    }
+
+    HostArenaAllocator::Stats HostArenaAllocator::get_stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void HostArenaAllocator::reset_stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Keep gauges, reset counters
+        stats_.peak_allocated_bytes = stats_.allocated_bytes;
+        stats_.num_allocs = 0;
+        stats_.num_deallocs = 0;
+        stats_.cache_hits = 0;
+        stats_.cache_misses = 0;
+    }
+
+    void HostArenaAllocator::set_enabled(bool enabled) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enabled_ = enabled;
+    }
+
+    bool HostArenaAllocator::is_enabled() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return enabled_;
+    }
+
+} // namespace lfs::core
@@ -0,0 +1,299 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "cpu_parallel.hpp"
+#include "tensor_functors.hpp"
+#include <cstdint>
+#include <type_traits>
+
+// SIMD intrinsics for CPU optimization (host compiler only)
+#if !defined(__CUDACC__) && defined(__AVX2__)
+#include <immintrin.h>
+#define LFS_CPU_ELEMENTWISE_AVX2 1
+#endif
+
+namespace lfs::core::cpu_elementwise {
+
+    namespace detail {
+
+#ifdef LFS_CPU_ELEMENTWISE_AVX2
+        // Functors with an exact AVX2 equivalent. Operand order of max/min matches
+        // std::max(a, b) / std::min(a, b) so NaN propagation is unchanged.
+        template <typename Op>
+        struct f32_binary : std::false_type {};
+        template <>
+        struct f32_binary<ops::add_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+        };
+        template <>
+        struct f32_binary<ops::sub_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+        };
+        template <>
+        struct f32_binary<ops::mul_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+        };
+        template <>
+        struct f32_binary<ops::div_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_div_ps(a, b); }
+        };
+        template <>
+        struct f32_binary<ops::maximum_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_max_ps(b, a); }
+        };
+        template <>
+        struct f32_binary<ops::minimum_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_min_ps(b, a); }
+        };
+
+        template <typename Op>
+        struct i32_binary : std::false_type {};
+        template <>
+        struct i32_binary<ops::add_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+        };
+        template <>
+        struct i32_binary<ops::sub_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); }
+        };
+        template <>
+        struct i32_binary<ops::mul_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return _mm256_mullo_epi32(a, b); }
+        };
+
+        template <typename Op>
+        struct f32_unary : std::false_type {};
+        template <>
+        struct f32_unary<ops::neg_op> : std::true_type {
+            static __m256 apply(const ops::neg_op&, __m256 x) { return _mm256_xor_ps(x, _mm256_set1_ps(-0.0f)); }
+        };
+        template <>
+        struct f32_unary<ops::abs_op> : std::true_type {
+            static __m256 apply(const ops::abs_op&, __m256 x) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x); }
+        };
+        template <>
+        struct f32_unary<ops::square_op> : std::true_type {
+            static __m256 apply(const ops::square_op&, __m256 x) { return _mm256_mul_ps(x, x); }
+        };
+        template <>
+        struct f32_unary<ops::relu_op> : std::true_type {
+            static __m256 apply(const ops::relu_op&, __m256 x) { return _mm256_max_ps(_mm256_setzero_ps(), x); }
+        };
+        template <>
+        struct f32_unary<ops::sqrt_op> : std::true_type {
+            static __m256 apply(const ops::sqrt_op&, __m256 x) {
+                return _mm256_sqrt_ps(_mm256_max_ps(_mm256_setzero_ps(), x));
+            }
+        };
+        template <typename BinOp>
+        struct f32_unary<ops::scalar_right_op<BinOp, float>> : f32_binary<BinOp> {
+            static __m256 apply(const ops::scalar_right_op<BinOp, float>& op, __m256 x) {
+                return f32_binary<BinOp>::apply(x, _mm256_set1_ps(op.scalar));
+            }
+        };
+        template <typename BinOp>
+        struct f32_unary<ops::scalar_left_op<BinOp, float>> : f32_binary<BinOp> {
+            static __m256 apply(const ops::scalar_left_op<BinOp, float>& op, __m256 x) {
+                return f32_binary<BinOp>::apply(_mm256_set1_ps(op.scalar), x);
+            }
+        };
+
+        // Float comparisons producing Bool. Predicates are ordered except !=, which is true
+        // for NaN like the scalar functor.
+        template <typename Op>
+        struct f32_compare : std::false_type {};
+        template <>
+        struct f32_compare<ops::equal_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        };
+        template <>
+        struct f32_compare<ops::not_equal_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+        };
+        template <>
+        struct f32_compare<ops::less_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        };
+        template <>
+        struct f32_compare<ops::less_equal_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        };
+        template <>
+        struct f32_compare<ops::greater_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        };
+        template <>
+        struct f32_compare<ops::greater_equal_op> : std::true_type {
+            static __m256 apply(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        };
+
+        template <typename Op>
+        struct f32_compare_unary : std::false_type {};
+        template <typename BinOp>
+        struct f32_compare_unary<ops::scalar_right_op<BinOp, float>> : f32_compare<BinOp> {
+            static __m256 apply(const ops::scalar_right_op<BinOp, float>& op, __m256 x) {
+                return f32_compare<BinOp>::apply(x, _mm256_set1_ps(op.scalar));
+            }
+        };
+        template <typename BinOp>
+        struct f32_compare_unary<ops::scalar_left_op<BinOp, float>> : f32_compare<BinOp> {
+            static __m256 apply(const ops::scalar_left_op<BinOp, float>& op, __m256 x) {
+                return f32_compare<BinOp>::apply(_mm256_set1_ps(op.scalar), x);
+            }
+        };
+
+        // Narrows four all-ones/zero float masks (32 lanes) to 0/1 bytes in element order
+        inline __m256i pack_masks_u8(__m256 m0, __m256 m1, __m256 m2, __m256 m3) {
+            const __m256i w01 = _mm256_packs_epi32(_mm256_castps_si256(m0), _mm256_castps_si256(m1));
+            const __m256i w23 = _mm256_packs_epi32(_mm256_castps_si256(m2), _mm256_castps_si256(m3));
+            const __m256i bytes = _mm256_packs_epi16(w01, w23);
+            const __m256i ordered = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+            return _mm256_and_si256(ordered, _mm256_set1_epi8(1));
+        }
+
+        // Bool/UInt8 functors. Comparisons are unsigned; logical ops treat any non-zero
+        // byte as true and, like the scalar functors, produce 0/1.
+        inline __m256i u8_is_zero(__m256i x) { return _mm256_cmpeq_epi8(x, _mm256_setzero_si256()); }
+        inline __m256i u8_mask_to_bool(__m256i mask) { return _mm256_and_si256(mask, _mm256_set1_epi8(1)); }
+        inline __m256i u8_not_mask_to_bool(__m256i mask) { return _mm256_andnot_si256(mask, _mm256_set1_epi8(1)); }
+
+        template <typename Op>
+        struct u8_binary : std::false_type {};
+        template <>
+        struct u8_binary<ops::equal_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return u8_mask_to_bool(_mm256_cmpeq_epi8(a, b)); }
+        };
+        template <>
+        struct u8_binary<ops::not_equal_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return u8_not_mask_to_bool(_mm256_cmpeq_epi8(a, b)); }
+        };
+        template <>
+        struct u8_binary<ops::less_op> : std::true_type { // a < b  <=>  max(a, b) != a
+            static __m256i apply(__m256i a, __m256i b) { return u8_not_mask_to_bool(_mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a)); }
+        };
+        template <>
+        struct u8_binary<ops::less_equal_op> : std::true_type { // a <= b  <=>  min(a, b) == a
+            static __m256i apply(__m256i a, __m256i b) { return u8_mask_to_bool(_mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a)); }
+        };
+        template <>
+        struct u8_binary<ops::greater_op> : std::true_type { // a > b  <=>  min(a, b) != a
+            static __m256i apply(__m256i a, __m256i b) { return u8_not_mask_to_bool(_mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a)); }
+        };
+        template <>
+        struct u8_binary<ops::greater_equal_op> : std::true_type { // a >= b  <=>  max(a, b) == a
+            static __m256i apply(__m256i a, __m256i b) { return u8_mask_to_bool(_mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a)); }
+        };
+        template <>
+        struct u8_binary<ops::logical_and_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return u8_not_mask_to_bool(_mm256_or_si256(u8_is_zero(a), u8_is_zero(b))); }
+        };
+        template <>
+        struct u8_binary<ops::logical_or_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return u8_not_mask_to_bool(_mm256_and_si256(u8_is_zero(a), u8_is_zero(b))); }
+        };
+        template <>
+        struct u8_binary<ops::logical_xor_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return u8_mask_to_bool(_mm256_xor_si256(u8_is_zero(a), u8_is_zero(b))); }
+        };
+        template <>
+        struct u8_binary<ops::maximum_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return _mm256_max_epu8(a, b); }
+        };
+        template <>
+        struct u8_binary<ops::minimum_op> : std::true_type {
+            static __m256i apply(__m256i a, __m256i b) { return _mm256_min_epu8(a, b); }
+        };
+
+        template <typename Op>
+        struct u8_unary : std::false_type {};
+        template <>
+        struct u8_unary<ops::logical_not_op> : std::true_type {
+            static __m256i apply(const ops::logical_not_op&, __m256i x) { return u8_mask_to_bool(u8_is_zero(x)); }
+        };
+#endif
+
+    } // namespace detail
+
+    // Serial kernel over [begin, end). Output may alias input (in-place ops).
+    template <typename T, typename OutT, typename Op>
+    inline void unary_range(const T* in, OutT* out, size_t begin, size_t end, const Op& op) {
+        size_t i = begin;
+#ifdef LFS_CPU_ELEMENTWISE_AVX2
+        if constexpr (std::is_same_v<T, float> && std::is_same_v<OutT, float> && detail::f32_unary<Op>::value) {
+            for (; i + 8 <= end; i += 8) {
+                _mm256_storeu_ps(out + i, detail::f32_unary<Op>::apply(op, _mm256_loadu_ps(in + i)));
+            }
+        } else if constexpr (std::is_same_v<T, float> && std::is_same_v<OutT, unsigned char> && detail::f32_compare_unary<Op>::value) {
+            using C = detail::f32_compare_unary<Op>;
+            for (; i + 32 <= end; i += 32) {
+                const __m256i bytes = detail::pack_masks_u8(C::apply(op, _mm256_loadu_ps(in + i)), C::apply(op, _mm256_loadu_ps(in + i + 8)),
+                                                            C::apply(op, _mm256_loadu_ps(in + i + 16)), C::apply(op, _mm256_loadu_ps(in + i + 24)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), bytes);
+            }
+        } else if constexpr (std::is_same_v<T, unsigned char> && std::is_same_v<OutT, unsigned char> && detail::u8_unary<Op>::value) {
+            for (; i + 32 <= end; i += 32) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), detail::u8_unary<Op>::apply(op, v));
+            }
+        }
+#endif
+        for (; i < end; ++i) {
+            out[i] = op(in[i]);
+        }
+    }
+
+    // Serial kernel over [begin, end). Output may alias either input (in-place ops).
+    template <typename T, typename OutT, typename Op>
+    inline void binary_range(const T* a, const T* b, OutT* out, size_t begin, size_t end, const Op& op) {
+        size_t i = begin;
+#ifdef LFS_CPU_ELEMENTWISE_AVX2
+        if constexpr (std::is_same_v<T, float> && std::is_same_v<OutT, float> && detail::f32_binary<Op>::value) {
+            for (; i + 8 <= end; i += 8) {
+                _mm256_storeu_ps(out + i, detail::f32_binary<Op>::apply(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+            }
+        } else if constexpr (std::is_same_v<T, int> && std::is_same_v<OutT, int> && detail::i32_binary<Op>::value) {
+            for (; i + 8 <= end; i += 8) {
+                const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), detail::i32_binary<Op>::apply(va, vb));
+            }
+        } else if constexpr (std::is_same_v<T, float> && std::is_same_v<OutT, unsigned char> && detail::f32_compare<Op>::value) {
+            using C = detail::f32_compare<Op>;
+            for (; i + 32 <= end; i += 32) {
+                const __m256i bytes = detail::pack_masks_u8(C::apply(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)),
+                                                            C::apply(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)),
+                                                            C::apply(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16)),
+                                                            C::apply(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), bytes);
+            }
+        } else if constexpr (std::is_same_v<T, unsigned char> && std::is_same_v<OutT, unsigned char> && detail::u8_binary<Op>::value) {
+            for (; i + 32 <= end; i += 32) {
+                const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), detail::u8_binary<Op>::apply(va, vb));
+            }
+        }
+#endif
+        for (; i < end; ++i) {
+            out[i] = op(a[i], b[i]);
+        }
+    }
+
+    // Chunked across the CPU thread pool, SIMD within each chunk
+    template <typename T, typename OutT, typename Op>
+    void unary(const T* in, OutT* out, size_t n, const Op& op) {
+        cpu_parallel::parallel_for(n, cpu_parallel::DEFAULT_GRAIN, [&](size_t begin, size_t end) {
+            unary_range(in, out, begin, end, op);
+        });
+    }
+
+    template <typename T, typename OutT, typename Op>
+    void binary(const T* a, const T* b, OutT* out, size_t n, const Op& op) {
+        cpu_parallel::parallel_for(n, cpu_parallel::DEFAULT_GRAIN, [&](size_t begin, size_t end) {
+            binary_range(a, b, out, begin, end, op);
+        });
+    }
+
+} // namespace lfs::core::cpu_elementwise
@@ -0,0 +1,53 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <cstddef>
+
+namespace lfs::core::cpu_gemm {
+
+    /**
+     * @brief Single-precision CPU GEMM: C = A @ B
+     *
+     * A is [m, k], B is [k, n], C is [m, n] (row-major, contiguous).
+     * A and B are addressed through explicit element strides so transposed
+     * or sliced views can be consumed without materializing them first:
+     *   A(i, l) = a[i * rs_a + l * cs_a]
+     *   B(l, j) = b[l * rs_b + j * cs_b]
+     *
+     * Dispatch:
+     * - Tiny K (k <= SMALL_K): direct broadcast-FMA over rows of B (e.g. [4,4] @
+     *   [4,N] homogeneous transforms); a strided B such as points.t() is gathered
+     *   into a contiguous panel per column chunk first
+     * - Everything else: packed, cache-blocked GEMM with an MR x NR register-
+     *   blocked microkernel (AVX-512 / AVX2+FMA / scalar), parallelized over
+     *   (MC x NC) macro tiles with OpenMP
+     *
+     * C is fully overwritten (beta = 0).
+     */
+    void sgemm(const float* a, std::ptrdiff_t rs_a, std::ptrdiff_t cs_a,
+               const float* b, std::ptrdiff_t rs_b, std::ptrdiff_t cs_b,
+               float* c, size_t m, size_t k, size_t n);
+
+    // Convenience overload for contiguous row-major A and B
+    inline void sgemm(const float* a, const float* b, float* c,
+                      size_t m, size_t k, size_t n) {
+        sgemm(a, static_cast<std::ptrdiff_t>(k), 1,
+              b, static_cast<std::ptrdiff_t>(n), 1,
+              c, m, k, n);
+    }
+
+    /**
+     * @brief Batched GEMM over contiguous [batch, m, k] @ [batch, k, n]
+     *
+     * Many small matrices are distributed across threads one batch per task;
+     * few large matrices run sequentially with the parallel sgemm above.
+     */
+    void sgemm_batched(const float* a, const float* b, float* c,
+                       size_t batch, size_t m, size_t k, size_t n);
+
+    // SIMD + multi-threaded dot product
+    float sdot(const float* a, const float* b, size_t n);
+
+} // namespace lfs::core::cpu_gemm
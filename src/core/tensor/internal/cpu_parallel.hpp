@@ -0,0 +1,86 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lfs::core::cpu_parallel {
+
+    // Elements per task for memory-bound element-wise kernels (~128KB of floats).
+    // Inputs smaller than one grain run inline on the calling thread.
+    constexpr size_t DEFAULT_GRAIN = 32768;
+
+    /**
+     * @brief Cap on worker threads used by CPU tensor kernels
+     *
+     * 0 (default) uses the OpenMP runtime default. Mainly intended for
+     * scaling benchmarks and for callers that already run their own pool.
+     */
+    void set_num_threads(int n);
+    int num_threads();
+
+    // Type-erased entry point, implemented in cpu_parallel.cpp (OpenMP)
+    void parallel_for_impl(size_t n, size_t grain,
+                           void (*fn)(void* ctx, size_t begin, size_t end), void* ctx);
+
+    /**
+     * @brief Split [0, n) into chunks of at least `grain` and run fn(begin, end) on each
+     *
+     * Chunk boundaries depend only on n and grain, never on the thread count,
+     * so per-chunk results are reproducible across machines.
+     */
+    template <typename Fn>
+    void parallel_for(size_t n, size_t grain, Fn&& fn) {
+        if (n == 0) {
+            return;
+        }
+        if (n <= grain) {
+            fn(size_t{0}, n);
+            return;
+        }
+        using FnT = std::remove_reference_t<Fn>;
+        parallel_for_impl(
+            n, grain,
+            [](void* ctx, size_t begin, size_t end) { (*static_cast<FnT*>(ctx))(begin, end); },
+            const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+    /**
+     * @brief Deterministic parallel tree reduction over [0, n)
+     *
+     * chunk(begin, end) -> T reduces one chunk; combine(T, T) -> T merges two
+     * partials. Partials are merged pairwise in a fixed tree, so the result is
+     * bit-identical for any thread count.
+     */
+    template <typename T, typename ChunkFn, typename CombineFn>
+    T parallel_reduce(size_t n, size_t grain, T identity, ChunkFn&& chunk, CombineFn&& combine) {
+        if (n == 0) {
+            return identity;
+        }
+        if (n <= grain) {
+            return chunk(size_t{0}, n);
+        }
+
+        const size_t num_chunks = (n + grain - 1) / grain;
+        std::vector<T> partials(num_chunks, identity);
+        parallel_for(num_chunks, 1, [&](size_t c_begin, size_t c_end) {
+            for (size_t c = c_begin; c < c_end; ++c) {
+                const size_t begin = c * grain;
+                const size_t end = begin + grain < n ? begin + grain : n;
+                partials[c] = chunk(begin, end);
+            }
+        });
+
+        for (size_t stride = 1; stride < num_chunks; stride *= 2) {
+            for (size_t i = 0; i + stride < num_chunks; i += 2 * stride) {
+                partials[i] = combine(partials[i], partials[i + stride]);
+            }
+        }
+        return partials[0];
+    }
+
+} // namespace lfs::core::cpu_parallel
@@ -0,0 +1,38 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lfs::core::cpu_random {
+
+    // All functions fill element i from word i of the Philox stream (seed, offset) defined in
+    // internal/philox.hpp, the same stream the CUDA kernels read, so results match the device
+    // bit for bit. Counter ranges are split across threads; each task runs batches of Philox
+    // blocks laid out so the rounds vectorise.
+
+    void uniform(float* out, size_t n, float low, float high, uint64_t seed, uint64_t offset);
+
+    // Box-Muller; each block of four words yields four normals
+    void normal(float* out, size_t n, float mean, float std, uint64_t seed, uint64_t offset);
+
+    void bernoulli(float* out, size_t n, float p, uint64_t seed, uint64_t offset);
+
+    void randint(int32_t* out, size_t n, int low, int high, uint64_t seed, uint64_t offset);
+    void randint(float* out, size_t n, int low, int high, uint64_t seed, uint64_t offset);
+    void randint(uint8_t* out, size_t n, int low, int high, uint64_t seed, uint64_t offset);
+
+    /**
+     * @brief Draw num_samples indices with probability proportional to weights
+     *
+     * With replacement, sample i searches the blockwise CDF with word i. Without replacement,
+     * element i gets the Gumbel key from word i and the largest keys win (ties by index).
+     *
+     * @return false if no weight is positive
+     */
+    bool multinomial(const float* weights, size_t n, int64_t* samples, size_t num_samples, bool replacement,
+                     uint64_t seed, uint64_t offset);
+
+} // namespace lfs::core::cpu_random
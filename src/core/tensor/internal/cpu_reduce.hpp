@@ -0,0 +1,36 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lfs::core {
+    enum class DataType : uint8_t;
+    enum class ReduceOp : uint8_t;
+} // namespace lfs::core
+
+namespace lfs::core::cpu_reduce {
+
+    /**
+     * @brief Parallel tree reduction of a contiguous tensor viewed as [outer, reduce, inner]
+     *
+     * Reduces along the middle axis and writes outer * inner results to dst.
+     * Output element types follow Tensor::reduce:
+     *   Float32: Sum/Mean/Max/Min/Prod/Std/Var -> float, Argmax/Argmin -> int64, Any/All -> bool
+     *   Int32:   Sum/Mean/Max/Min/Prod -> int32, Argmax/Argmin -> int64, Any/All -> bool
+     *   Int64:   Sum/Mean/Max/Min/Prod -> int64, Argmax/Argmin -> int64, Any/All -> bool
+     *   Bool:    Sum/Mean/Max/Min/Prod -> int64, Any/All -> bool, Argmax/Argmin -> int64
+     *
+     * Sum/Mean accumulate in double (float input) or int64 (integer input).
+     * Std/Var use a single-pass Welford update with Chan's parallel merge.
+     * Partials are combined in a fixed order, so results do not depend on
+     * the number of threads.
+     *
+     * @return false if the dtype/op combination has no CPU kernel
+     */
+    bool reduce(const void* src, void* dst, DataType dtype, ReduceOp op,
+                size_t outer, size_t reduce_size, size_t inner, bool unbiased = true);
+
+} // namespace lfs::core::cpu_reduce
@@ -0,0 +1,63 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace lfs::core::cpu_select {
+
+    // Float32 <-> uint32 keys with the same ordering (negative values flipped, NaN above +inf)
+    inline uint32_t float_to_key(const float v) {
+        const uint32_t bits = std::bit_cast<uint32_t>(v);
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    inline float key_to_float(const uint32_t key) {
+        return std::bit_cast<float>((key & 0x80000000u) ? (key & 0x7FFFFFFFu) : ~key);
+    }
+
+    struct Selection {
+        uint32_t key = 0;  // Key of the requested rank
+        size_t less = 0;   // Keys strictly below it
+        size_t equal = 0;  // Keys equal to it (the rank falls inside [less, less + equal))
+    };
+
+    /**
+     * @brief Key of ascending rank `rank` (0-based) among n keys, without sorting
+     *
+     * Large inputs run a parallel MSD radix select: an 11-bit histogram per pass, after
+     * which only the bucket holding the rank is kept, so each pass touches a fraction of
+     * the previous one. Small inputs use std::nth_element.
+     */
+    Selection select(const uint32_t* keys, size_t n, size_t rank);
+
+    // All row functions take a contiguous [rows, len] Float32 input and select along len.
+    // Rows run in parallel; a single long row is split internally instead.
+
+    /**
+     * @brief k largest (or smallest) values per row with their Int64 indices, [rows, k]
+     *
+     * Ties at the cut-off keep the lowest indices. When `sorted`, each row is ordered
+     * best-first (ties by index); otherwise selected elements appear in index order.
+     */
+    void topk(const float* src, size_t rows, size_t len, size_t k, bool largest, bool sorted,
+              float* values, int64_t* indices);
+
+    // Value of ascending rank k (0-based) per row and the lowest index holding it
+    void kthvalue(const float* src, size_t rows, size_t len, size_t k, float* values, int64_t* indices);
+
+    // q-quantile per row with linear interpolation between the neighbouring ranks
+    void quantile(const float* src, size_t rows, size_t len, double q, float* out);
+
+    /**
+     * @brief Indices that put the element of rank kth at position kth in each row, [rows, len]
+     *
+     * Elements before it compare less or equal, elements after it greater or equal; each
+     * group keeps index order.
+     */
+    void argpartition(const float* src, size_t rows, size_t len, size_t kth, int64_t* indices);
+
+} // namespace lfs::core::cpu_select
@@ -0,0 +1,88 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "cpu_parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lfs::core::cpu_sort {
+
+    /**
+     * @brief Stable sort of each contiguous row of a [rows, len] input
+     *
+     * Keys are mapped to unsigned integers with the same order and sorted with an LSD
+     * radix sort (8-bit digits; passes where all keys share a digit are skipped). 32-bit
+     * keys travel packed with their index in one 64-bit word. One long row is sorted with
+     * parallel histogram/scatter passes; many rows are sorted in parallel, one per task.
+     * Equal keys keep index order in both directions; float NaN sorts above +inf.
+     *
+     * @param values Sorted values, [rows, len]; may be null for an argsort
+     * @param indices Int64 source index of each sorted value, [rows, len]
+     */
+    void sort_rows(const float* src, size_t rows, size_t len, bool descending, float* values, int64_t* indices);
+    void sort_rows(const int32_t* src, size_t rows, size_t len, bool descending, int32_t* values, int64_t* indices);
+    void sort_rows(const int64_t* src, size_t rows, size_t len, bool descending, int64_t* values, int64_t* indices);
+
+    /**
+     * @brief Sorted distinct values of n elements
+     *
+     * @param inverse Optional, for each input element the index of its value in `out`
+     * @param counts Optional, occurrences of each distinct value
+     * @return Number of distinct values written to `out` (sized n by the caller)
+     */
+    size_t unique(const float* src, size_t n, float* out, int64_t* inverse, int64_t* counts);
+    size_t unique(const int32_t* src, size_t n, int32_t* out, int64_t* inverse, int64_t* counts);
+    size_t unique(const int64_t* src, size_t n, int64_t* out, int64_t* inverse, int64_t* counts);
+
+    // Elements per chunk of the parallel stream compaction
+    constexpr size_t COMPACT_GRAIN = size_t{1} << 16;
+
+    /**
+     * @brief Order-preserving parallel stream compaction of [0, n)
+     *
+     * keep(i) is evaluated twice per element: once to count each chunk, then again to
+     * emit(i, out_pos) at the chunk's prefix-sum offset. Returns the number kept.
+     */
+    template <typename KeepFn, typename EmitFn>
+    size_t compact(const size_t n, KeepFn&& keep, EmitFn&& emit) {
+        if (n <= COMPACT_GRAIN) {
+            size_t pos = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (keep(i))
+                    emit(i, pos++);
+            }
+            return pos;
+        }
+
+        const size_t chunks = (n + COMPACT_GRAIN - 1) / COMPACT_GRAIN;
+        std::vector<size_t> offsets(chunks + 1, 0);
+        cpu_parallel::parallel_for(chunks, 1, [&](const size_t c_begin, const size_t c_end) {
+            for (size_t c = c_begin; c < c_end; ++c) {
+                const size_t end = (c + 1) * COMPACT_GRAIN < n ? (c + 1) * COMPACT_GRAIN : n;
+                size_t count = 0;
+                for (size_t i = c * COMPACT_GRAIN; i < end; ++i)
+                    count += keep(i) ? 1 : 0;
+                offsets[c + 1] = count;
+            }
+        });
+        for (size_t c = 0; c < chunks; ++c)
+            offsets[c + 1] += offsets[c];
+
+        cpu_parallel::parallel_for(chunks, 1, [&](const size_t c_begin, const size_t c_end) {
+            for (size_t c = c_begin; c < c_end; ++c) {
+                const size_t end = (c + 1) * COMPACT_GRAIN < n ? (c + 1) * COMPACT_GRAIN : n;
+                size_t pos = offsets[c];
+                for (size_t i = c * COMPACT_GRAIN; i < end; ++i) {
+                    if (keep(i))
+                        emit(i, pos++);
+                }
+            }
+        });
+        return offsets[chunks];
+    }
+
+} // namespace lfs::core::cpu_sort
@@ -0,0 +1,128 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "offset_allocator.hpp"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace lfs::core {
+
+    // Allocations below this size are sub-allocated from host arenas,
+    // larger ones go through the size-class block cache
+    static constexpr size_t HOST_ARENA_THRESHOLD = 16 * 1024 * 1024;     // 16MB
+    static constexpr size_t HOST_ARENA_CHUNK_SIZE = 256 * 1024 * 1024;   // 256MB per arena
+    static constexpr size_t HOST_MAX_ARENAS = 8;                         // 2GB of arenas at most
+    static constexpr size_t HOST_MAX_IDLE_ARENAS = 1;                    // Empty trailing arenas kept warm
+    static constexpr size_t HOST_MAX_CACHED_BYTES = 512 * 1024 * 1024;   // 512MB of cached large blocks
+    static constexpr size_t HOST_ALLOC_ALIGNMENT = 64;                   // Cache line / AVX-512
+
+    /**
+     * @brief Pooled allocator for regular (non-pinned) CPU tensor memory
+     *
+     * CPU temporaries (PLY load, SOG export, crop, CPU reductions) used to hit
+     * malloc/free on every op, paying a fresh page fault for each new buffer.
+     * This pool keeps freed memory warm and hands it back to the next tensor:
+     *
+     * - Small/medium (<16MB): O(1) sub-allocation from 256MB host arenas via
+     *   OffsetAllocator (same TLSF-like allocator as GPUArenaAllocator)
+     * - Large (>=16MB): size-class cache of whole blocks, sizes rounded to a
+     *   quarter power of two so slightly different shapes still reuse a block
+     *
+     * All pointers are 64-byte aligned. Idle memory is bounded: empty trailing
+     * arenas beyond HOST_MAX_IDLE_ARENAS and blocks past HOST_MAX_CACHED_BYTES
+     * go back to the OS on free, and trim() releases the rest. Callers that
+     * budget against OS-available memory (the image cache) trim after evicting.
+     *
+     * Thread safety: Protected by mutex
+     */
+    class HostArenaAllocator {
+    public:
+        static HostArenaAllocator& instance();
+
+        /**
+         * @brief Allocate host memory
+         * @return 64-byte aligned pointer, or nullptr on failure
+         */
+        void* allocate(size_t bytes);
+
+        /**
+         * @brief Return memory to the pool
+         *
+         * Pointers not allocated by this pool are ignored with an error.
+         */
+        void deallocate(void* ptr);
+
+        /**
+         * @brief Release cached blocks and empty arenas back to the OS
+         */
+        void trim();
+
+        struct Stats {
+            size_t allocated_bytes{0};      ///< Bytes currently handed out to tensors
+            size_t peak_allocated_bytes{0}; ///< High-water mark of allocated_bytes
+            size_t reserved_bytes{0};       ///< Bytes held from the OS (arenas + large blocks)
+            size_t cached_bytes{0};         ///< Large blocks waiting for reuse
+            size_t num_arenas{0};           ///< Live host arenas
+            size_t num_allocs{0};           ///< Number of allocations
+            size_t num_deallocs{0};         ///< Number of deallocations
+            size_t cache_hits{0};           ///< Served from arena or block cache without the OS
+            size_t cache_misses{0};         ///< Required a new arena or block from the OS
+        };
+
+        Stats get_stats() const;
+        void reset_stats();
+
+        /**
+         * @brief Enable/disable pooling (for testing/debugging)
+         *
+         * When disabled, allocations go straight to the system allocator.
+         */
+        void set_enabled(bool enabled);
+        bool is_enabled() const;
+
+        HostArenaAllocator(const HostArenaAllocator&) = delete;
+        HostArenaAllocator& operator=(const HostArenaAllocator&) = delete;
+
+    private:
+        HostArenaAllocator() = default;
+        ~HostArenaAllocator() = default;
+
+        enum class Source : uint8_t {
+            Arena,  // Sub-allocation from arenas_[arena]
+            Block,  // Whole block, cached by size class on free
+            System  // Pooling disabled, freed immediately
+        };
+
+        struct Record {
+            Source source;
+            uint32_t arena;
+            OffsetAllocator::Allocation allocation;
+            size_t size;      // Bytes reserved for this pointer
+            size_t requested; // Bytes requested by the caller
+        };
+
+        struct Arena {
+            void* base{nullptr};
+            std::unique_ptr<OffsetAllocator::Allocator> allocator;
+            size_t live{0}; // Active sub-allocations
+        };
+
+        static size_t round_block_size(size_t bytes);
+        void* allocate_from_arenas(size_t bytes, Record& record);
+        void* allocate_block(size_t bytes, Record& record);
+        void release_idle_arenas(size_t keep);
+
+        std::vector<Arena> arenas_;
+        std::unordered_map<size_t, std::vector<void*>> block_cache_; // Size class -> free blocks
+        std::unordered_map<void*, Record> records_;
+        mutable std::mutex mutex_;
+        Stats stats_;
+        bool enabled_{true};
+    };
+
+} // namespace lfs::core
@@ -0,0 +1,306 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifndef HOST_DEVICE
+#ifdef __CUDACC__
+#define HOST_DEVICE __host__ __device__
+#else
+#define HOST_DEVICE
+#endif
+#endif
+
+/**
+ * Philox4x32-10 counter-based generator shared by the CPU and CUDA random ops.
+ *
+ * A stream is identified by (seed, offset). Word i of a stream is lane i % 4 of the Philox
+ * block with key = seed and counter = (i / 4, offset), each as two 32-bit halves, so any
+ * range of words can be generated independently and in any order.
+ *
+ * The float transforms below use only correctly rounded add/mul/fma/div/sqrt (explicit _rn
+ * intrinsics on the device, so -use_fast_math cannot change them), with their own log and
+ * sin/cos polynomials. Host code including this header must be built without FP contraction
+ * (-ffp-contract=off) for its results to match the device bit for bit.
+ */
+namespace lfs::core::philox {
+
+    struct Block {
+        uint32_t x[4];
+    };
+
+    namespace detail {
+
+        constexpr uint32_t M0 = 0xD2511F53u;
+        constexpr uint32_t M1 = 0xCD9E8D57u;
+        constexpr uint32_t W0 = 0x9E3779B9u; // Golden ratio
+        constexpr uint32_t W1 = 0xBB67AE85u; // sqrt(3) - 1
+
+        HOST_DEVICE inline uint32_t mulhi(const uint32_t a, const uint32_t b) {
+#ifdef __CUDA_ARCH__
+            return __umulhi(a, b);
+#else
+            return static_cast<uint32_t>((static_cast<uint64_t>(a) * b) >> 32);
+#endif
+        }
+
+        HOST_DEVICE inline float add(const float a, const float b) {
+#ifdef __CUDA_ARCH__
+            return __fadd_rn(a, b);
+#else
+            return a + b;
+#endif
+        }
+
+        HOST_DEVICE inline float mul(const float a, const float b) {
+#ifdef __CUDA_ARCH__
+            return __fmul_rn(a, b);
+#else
+            return a * b;
+#endif
+        }
+
+        HOST_DEVICE inline float fma(const float a, const float b, const float c) {
+#ifdef __CUDA_ARCH__
+            return __fmaf_rn(a, b, c);
+#else
+            return std::fma(a, b, c);
+#endif
+        }
+
+        HOST_DEVICE inline float div(const float a, const float b) {
+#ifdef __CUDA_ARCH__
+            return __fdiv_rn(a, b);
+#else
+            return a / b;
+#endif
+        }
+
+        HOST_DEVICE inline float sqrt(const float a) {
+#ifdef __CUDA_ARCH__
+            return __fsqrt_rn(a);
+#else
+            return std::sqrt(a);
+#endif
+        }
+
+        HOST_DEVICE inline uint32_t float_bits(const float v) {
+#ifdef __CUDA_ARCH__
+            return __float_as_uint(v);
+#else
+            uint32_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            return bits;
+#endif
+        }
+
+        HOST_DEVICE inline float bits_float(const uint32_t bits) {
+#ifdef __CUDA_ARCH__
+            return __uint_as_float(bits);
+#else
+            float v;
+            std::memcpy(&v, &bits, sizeof(v));
+            return v;
+#endif
+        }
+
+    } // namespace detail
+
+    HOST_DEVICE inline Block philox4x32_10(Block ctr, uint32_t k0, uint32_t k1) {
+        for (int round = 0; round < 10; ++round) {
+            const uint32_t hi0 = detail::mulhi(detail::M0, ctr.x[0]);
+            const uint32_t lo0 = detail::M0 * ctr.x[0];
+            const uint32_t hi1 = detail::mulhi(detail::M1, ctr.x[2]);
+            const uint32_t lo1 = detail::M1 * ctr.x[2];
+            ctr = {{hi1 ^ ctr.x[1] ^ k0, lo1, hi0 ^ ctr.x[3] ^ k1, lo0}};
+            k0 += detail::W0;
+            k1 += detail::W1;
+        }
+        return ctr;
+    }
+
+    // Block holding words [4 * index, 4 * index + 4) of stream (seed, offset)
+    HOST_DEVICE inline Block block(const uint64_t seed, const uint64_t offset, const uint64_t index) {
+        const Block ctr = {{static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+                            static_cast<uint32_t>(offset), static_cast<uint32_t>(offset >> 32)}};
+        return philox4x32_10(ctr, static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32));
+    }
+
+    HOST_DEVICE inline uint32_t word(const uint64_t seed, const uint64_t offset, const uint64_t index) {
+        return block(seed, offset, index / 4).x[index % 4];
+    }
+
+    // ============= Transforms =============
+
+    // [0, 1) in steps of 2^-24
+    HOST_DEVICE inline float to_uniform(const uint32_t w) {
+        return static_cast<float>(w >> 8) * 0x1.0p-24f;
+    }
+
+    // (0, 1): odd multiples of 2^-24, safe to take the log of
+    HOST_DEVICE inline float to_uniform_open(const uint32_t w) {
+        return static_cast<float>((w >> 8) | 1u) * 0x1.0p-24f;
+    }
+
+    HOST_DEVICE inline float to_uniform(const uint32_t w, const float low, const float high) {
+        return detail::fma(to_uniform(w), detail::add(high, -low), low);
+    }
+
+    // Integer in [low, high) by multiply-shift; low when the range is empty
+    HOST_DEVICE inline int to_int(const uint32_t w, const int low, const int high) {
+        const int64_t range = static_cast<int64_t>(high) - low;
+        if (range <= 0)
+            return low;
+        return static_cast<int>(low + static_cast<int64_t>((static_cast<uint64_t>(w) * static_cast<uint64_t>(range)) >> 32));
+    }
+
+    // Natural log of a positive normal float (fdlibm's logf reduction and polynomial)
+    HOST_DEVICE inline float log(const float v) {
+        using namespace detail;
+        constexpr float LN2_HI = 6.9313812256e-01f;
+        constexpr float LN2_LO = 9.0580006145e-06f;
+        constexpr float LG1 = 0.66666662693f;
+        constexpr float LG2 = 0.40000972152f;
+        constexpr float LG3 = 0.28498786688f;
+        constexpr float LG4 = 0.24279078841f;
+
+        // v = m * 2^k with m in [sqrt(2)/2, sqrt(2))
+        uint32_t ix = float_bits(v) + (0x3F800000u - 0x3F3504F3u);
+        const int k = static_cast<int>(ix >> 23) - 0x7F;
+        ix = (ix & 0x007FFFFFu) + 0x3F3504F3u;
+
+        const float f = add(bits_float(ix), -1.0f);
+        const float s = div(f, add(2.0f, f));
+        const float z = mul(s, s);
+        const float w = mul(z, z);
+        const float t1 = mul(w, add(LG2, mul(w, LG4)));
+        const float t2 = mul(z, add(LG1, mul(w, LG3)));
+        const float r = add(t2, t1);
+        const float hfsq = mul(mul(0.5f, f), f);
+        const float dk = static_cast<float>(k);
+        const float lo = add(add(mul(s, add(hfsq, r)), mul(dk, LN2_LO)), -hfsq);
+        return add(add(lo, f), mul(dk, LN2_HI));
+    }
+
+    // (cos, sin) of 2*pi*to_uniform(w), reduced exactly to a quadrant and |r| <= pi/4
+    HOST_DEVICE inline void cos_sin_2pi(const uint32_t w, float& c, float& s) {
+        using namespace detail;
+        const int32_t m = static_cast<int32_t>(w >> 8);
+        const int32_t q = (m + (1 << 21)) >> 22;
+        const float r = mul(static_cast<float>(m - (q << 22)), 1.57079632679489662f * 0x1.0p-22f);
+
+        // Cephes sinf/cosf polynomials
+        const float z = mul(r, r);
+        const float sr = fma(mul(fma(fma(-1.9515295891e-4f, z, 8.3321608736e-3f), z, -1.6666654611e-1f), z), r, r);
+        const float cr = add(fma(mul(fma(fma(2.443315711809948e-5f, z, -1.388731625493765e-3f), z, 4.166664568298827e-2f), z), z,
+                                 mul(-0.5f, z)),
+                             1.0f);
+
+        switch (q & 3) {
+        case 0:
+            c = cr;
+            s = sr;
+            break;
+        case 1:
+            c = -sr;
+            s = cr;
+            break;
+        case 2:
+            c = -cr;
+            s = -sr;
+            break;
+        default:
+            c = sr;
+            s = -cr;
+            break;
+        }
+    }
+
+    // Box-Muller: two standard normals from two words
+    HOST_DEVICE inline void to_normal_pair(const uint32_t w0, const uint32_t w1, float& z0, float& z1) {
+        const float radius = detail::sqrt(detail::mul(-2.0f, philox::log(to_uniform_open(w0))));
+        float c, s;
+        cos_sin_2pi(w1, c, s);
+        z0 = detail::mul(radius, c);
+        z1 = detail::mul(radius, s);
+    }
+
+    // Normals for all four lanes of a block: lanes (0, 1) and (2, 3) are Box-Muller pairs
+    HOST_DEVICE inline void to_normal(const Block& b, const float mean, const float std, float out[4]) {
+        float z[4];
+        to_normal_pair(b.x[0], b.x[1], z[0], z[1]);
+        to_normal_pair(b.x[2], b.x[3], z[2], z[3]);
+        for (int lane = 0; lane < 4; ++lane)
+            out[lane] = detail::fma(z[lane], std, mean);
+    }
+
+    // Gumbel-max key log(w) + G for multinomial sampling without replacement
+    HOST_DEVICE inline float gumbel_key(const uint32_t w, const float weight) {
+        const float gumbel = -philox::log(-philox::log(to_uniform_open(w)));
+        return detail::add(philox::log(weight > 1e-10f ? weight : 1e-10f), gumbel);
+    }
+
+    // ============= Multinomial CDF =============
+
+    // Weights per sequentially summed CDF block
+    constexpr size_t CDF_BLOCK = 1024;
+
+    /**
+     * The multinomial CDF is defined blockwise so that it can be built in parallel and still
+     * round the same everywhere: each CDF_BLOCK run of weights is prefix-summed left to right,
+     * block totals are scanned left to right, and each entry adds its block's offset.
+     */
+    HOST_DEVICE inline float cdf_block_scan(const float* weights, float* cdf, const size_t begin, const size_t end) {
+        float sum = 0.0f;
+        for (size_t i = begin; i < end; ++i) {
+            sum = detail::add(sum, weights[i]);
+            cdf[i] = sum;
+        }
+        return sum;
+    }
+
+    // Block totals -> exclusive block offsets, in place
+    HOST_DEVICE inline void cdf_block_offsets(float* totals, const size_t blocks) {
+        float offset = 0.0f;
+        for (size_t b = 0; b < blocks; ++b) {
+            const float total = totals[b];
+            totals[b] = offset;
+            offset = detail::add(offset, total);
+        }
+    }
+
+    HOST_DEVICE inline float cdf_add_offset(const float local, const float block_offset) {
+        return detail::add(block_offset, local);
+    }
+
+    // Index drawn by word w: the first entry above u * total, else the first reaching total
+    HOST_DEVICE inline int64_t sample_cdf(const float* cdf, const size_t n, const uint32_t w) {
+        const float total = cdf[n - 1];
+        const float target = detail::mul(to_uniform(w), total);
+        size_t lo = 0, hi = n;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (cdf[mid] > target)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        if (lo == n) {
+            lo = 0, hi = n - 1;
+            while (lo < hi) {
+                const size_t mid = lo + (hi - lo) / 2;
+                if (cdf[mid] >= total)
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+        }
+        return static_cast<int64_t>(lo);
+    }
+
+} // namespace lfs::core::philox
@@ -53,9 +53,7 @@ namespace lfs::core {
                         const int* in_ptr = input_tensor.template ptr<int>();
                         int* out_ptr = result.template ptr<int>();
                         size_t n = result.numel();
-                        for (size_t i = 0; i < n; ++i) {
-                            out_ptr[i] = op(in_ptr[i]);
-                        }
+                        apply_unary_cpu(in_ptr, out_ptr, n, op);
                     }
                 } else {
                     // Float -> Float operations (default case)
@@ -69,9 +67,7 @@ namespace lfs::core {
                         const float* in_ptr = input_tensor.template ptr<float>();
                         float* out_ptr = result.template ptr<float>();
                         size_t n = result.numel();
-                        for (size_t i = 0; i < n; ++i) {
-                            out_ptr[i] = op(in_ptr[i]);
-                        }
+                        apply_unary_cpu(in_ptr, out_ptr, n, op);
                     }
                 }
 
@@ -104,9 +100,7 @@ namespace lfs::core {
                         const unsigned char* in_ptr = input_tensor.template ptr<unsigned char>();
                         unsigned char* out_ptr = result.template ptr<unsigned char>();
                         size_t n = result.numel();
-                        for (size_t i = 0; i < n; ++i) {
-                            out_ptr[i] = op(in_ptr[i]);
-                        }
+                        apply_unary_cpu(in_ptr, out_ptr, n, op);
                     }
                 } else if (input_tensor.dtype() == DataType::UInt8) {
                     // UInt8 input -> Bool output (e.g., comparisons on UInt8 tensor)
@@ -119,9 +113,7 @@ namespace lfs::core {
                         const uint8_t* in_ptr = input_tensor.template ptr<uint8_t>();
                         unsigned char* out_ptr = result.template ptr<unsigned char>();
                         const size_t n = result.numel();
-                        for (size_t i = 0; i < n; ++i) {
-                            out_ptr[i] = op(in_ptr[i]);
-                        }
+                        apply_unary_cpu(in_ptr, out_ptr, n, op);
                     }
                 } else if (input_tensor.dtype() == DataType::Int32) {
                     // Int32 input -> Bool output (e.g., comparisons on Int32 tensor)
@@ -134,9 +126,7 @@ namespace lfs::core {
                         const int* in_ptr = input_tensor.template ptr<int>();
                         unsigned char* out_ptr = result.template ptr<unsigned char>();
                         const size_t n = result.numel();
-                        for (size_t i = 0; i < n; ++i) {
-                            out_ptr[i] = op(in_ptr[i]);
-                        }
+                        apply_unary_cpu(in_ptr, out_ptr, n, op);
                     }
                 } else {
                     // Float input -> Bool output (e.g., isnan, isinf, isfinite)
@@ -150,9 +140,7 @@ namespace lfs::core {
                         const float* in_ptr = input_tensor.template ptr<float>();
                         unsigned char* out_ptr = result.template ptr<unsigned char>();
                         size_t n = result.numel();
-                        for (size_t i = 0; i < n; ++i) {
-                            out_ptr[i] = op(in_ptr[i]);
-                        }
+                        apply_unary_cpu(in_ptr, out_ptr, n, op);
                     }
                 }
 
@@ -198,9 +186,7 @@ namespace lfs::core {
             const float* in_ptr = base.template ptr<float>();
             float* out_ptr = result.template ptr<float>();
             size_t n = result.numel();
-            for (size_t i = 0; i < n; ++i) {
-                out_ptr[i] = fused_op(in_ptr[i]);
-            }
+            apply_unary_cpu(in_ptr, out_ptr, n, fused_op);
         }
 
         return result;
@@ -308,9 +294,7 @@ namespace lfs::core {
                             const int64_t* right_ptr = right_tensor.template ptr<int64_t>();
                             int64_t* out_ptr = result.template ptr<int64_t>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         } else {
                             Tensor left_broadcast = left_tensor;
                             Tensor right_broadcast = right_tensor;
@@ -324,9 +308,7 @@ namespace lfs::core {
                             const int64_t* right_ptr = right_broadcast.template ptr<int64_t>();
                             int64_t* out_ptr = result.template ptr<int64_t>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         }
                     }
                 } else if (left_tensor.dtype() == DataType::UInt8 && right_tensor.dtype() == DataType::UInt8) {
@@ -356,9 +338,7 @@ namespace lfs::core {
                             const uint8_t* right_ptr = right_tensor.template ptr<uint8_t>();
                             uint8_t* out_ptr = result.template ptr<uint8_t>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         } else {
                             Tensor left_broadcast = left_tensor;
                             Tensor right_broadcast = right_tensor;
@@ -372,9 +352,7 @@ namespace lfs::core {
                             const uint8_t* right_ptr = right_broadcast.template ptr<uint8_t>();
                             uint8_t* out_ptr = result.template ptr<uint8_t>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         }
                     }
                 } else if (left_tensor.dtype() == DataType::Int32 && right_tensor.dtype() == DataType::Int32) {
@@ -404,9 +382,7 @@ namespace lfs::core {
                             const int* right_ptr = right_tensor.template ptr<int>();
                             int* out_ptr = result.template ptr<int>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         } else {
                             Tensor left_broadcast = left_tensor;
                             Tensor right_broadcast = right_tensor;
@@ -420,9 +396,7 @@ namespace lfs::core {
                             const int* right_ptr = right_broadcast.template ptr<int>();
                             int* out_ptr = result.template ptr<int>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         }
                     }
                 } else {
@@ -455,9 +429,7 @@ namespace lfs::core {
                             const float* right_ptr = right_tensor.template ptr<float>();
                             float* out_ptr = result.template ptr<float>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         } else {
                             // Broadcasting required - fallback to CPU broadcast logic
                             Tensor left_broadcast = left_tensor;
@@ -472,9 +444,7 @@ namespace lfs::core {
                             const float* right_ptr = right_broadcast.template ptr<float>();
                             float* out_ptr = result.template ptr<float>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         }
                     }
                 }
@@ -528,9 +498,7 @@ namespace lfs::core {
                             const unsigned char* right_ptr = right_tensor.template ptr<unsigned char>();
                             unsigned char* out_ptr = result.template ptr<unsigned char>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         } else {
                             Tensor left_broadcast = left_tensor;
                             Tensor right_broadcast = right_tensor;
@@ -544,9 +512,7 @@ namespace lfs::core {
                             const unsigned char* right_ptr = right_broadcast.template ptr<unsigned char>();
                             unsigned char* out_ptr = result.template ptr<unsigned char>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         }
                     }
                 } else if (left_tensor.dtype() == DataType::Float16 && right_tensor.dtype() == DataType::Float16) {
@@ -628,9 +594,7 @@ namespace lfs::core {
                             const int64_t* right_ptr = right_tensor.template ptr<int64_t>();
                             unsigned char* out_ptr = result.template ptr<unsigned char>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         } else {
                             Tensor left_broadcast = left_tensor;
                             Tensor right_broadcast = right_tensor;
@@ -644,9 +608,7 @@ namespace lfs::core {
                             const int64_t* right_ptr = right_broadcast.template ptr<int64_t>();
                             unsigned char* out_ptr = result.template ptr<unsigned char>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         }
                     }
                 } else if (left_tensor.dtype() == DataType::Int32 && right_tensor.dtype() == DataType::Int32) {
@@ -676,9 +638,7 @@ namespace lfs::core {
                             const int* right_ptr = right_tensor.template ptr<int>();
                             unsigned char* out_ptr = result.template ptr<unsigned char>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         } else {
                             Tensor left_broadcast = left_tensor;
                             Tensor right_broadcast = right_tensor;
@@ -692,9 +652,7 @@ namespace lfs::core {
                             const int* right_ptr = right_broadcast.template ptr<int>();
                             unsigned char* out_ptr = result.template ptr<unsigned char>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         }
                     }
                 } else {
@@ -724,9 +682,7 @@ namespace lfs::core {
                             const float* right_ptr = right_tensor.template ptr<float>();
                             unsigned char* out_ptr = result.template ptr<unsigned char>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         } else {
                             Tensor left_broadcast = left_tensor;
                             Tensor right_broadcast = right_tensor;
@@ -740,9 +696,7 @@ namespace lfs::core {
                             const float* right_ptr = right_broadcast.template ptr<float>();
                             unsigned char* out_ptr = result.template ptr<unsigned char>();
                             size_t n = result.numel();
-                            for (size_t i = 0; i < n; ++i) {
-                                out_ptr[i] = op(left_ptr[i], right_ptr[i]);
-                            }
+                            apply_binary_cpu(left_ptr, right_ptr, out_ptr, n, op);
                         }
                     }
                 }
@@ -778,9 +732,7 @@ namespace lfs::core {
             const float* in_ptr = input_tensor.template ptr<float>();
             float* out_ptr = result.template ptr<float>();
             size_t n = result.numel();
-            for (size_t i = 0; i < n; ++i) {
-                out_ptr[i] = op_(in_ptr[i]);
-            }
+            apply_unary_cpu(in_ptr, out_ptr, n, op_);
         }
 
         return result;
@@ -239,23 +239,26 @@ namespace lfs::core {
             args;
     };
 
+    // Philox stream (see internal/philox.hpp) reserved for one random op
+    struct PhiloxState {
+        uint64_t seed;
+        uint64_t offset;
+    };
+
     class RandomGenerator {
     public:
         static RandomGenerator& instance();
         void manual_seed(uint64_t seed);
         uint64_t get_seed() const { return seed_; }
-        void* get_generator(Device device);
-        uint64_t get_next_cuda_seed();
-        uint64_t get_next_cuda_offset(); // Get next offset for cuRAND generator
-        void* get_impl() { return impl_; }
-        const void* get_impl() const { return impl_; }
+        // Every op takes the next offset under the current seed, on CPU and CUDA alike,
+        // so the same sequence of ops yields the same values on either device
+        PhiloxState next_philox_state();
 
     private:
-        RandomGenerator();
-        ~RandomGenerator();
-        uint64_t seed_;
-        void* impl_ = nullptr;
-        std::mt19937_64 cpu_generator_;
+        RandomGenerator() = default;
+        ~RandomGenerator() = default;
+        uint64_t seed_ = 42;
+        std::atomic<uint64_t> offset_{0};
         RandomGenerator(const RandomGenerator&) = delete;
         RandomGenerator& operator=(const RandomGenerator&) = delete;
     };
@@ -415,23 +418,17 @@ namespace lfs::core {
                     const int* src = ptr<int>();
                     int scalar_int = static_cast<int>(scalar);
                     if (out_dtype == DataType::Bool) {
-                        unsigned char* dst = result.ptr<unsigned char>();
-                        for (size_t i = 0; i < numel(); ++i) {
-                            dst[i] = op(src[i], scalar_int);
-                        }
+                        apply_unary_cpu(src, result.ptr<unsigned char>(), numel(),
+                                        ops::scalar_right_op<Op, int>(scalar_int));
                     } else {
-                        int* dst = result.ptr<int>();
-                        for (size_t i = 0; i < numel(); ++i) {
-                            dst[i] = op(src[i], scalar_int);
-                        }
+                        apply_unary_cpu(src, result.ptr<int>(), numel(),
+                                        ops::scalar_right_op<Op, int>(scalar_int));
                     }
                 } else { // Float32
                     const float* src = ptr<float>();
                     if (out_dtype == DataType::Bool) {
-                        unsigned char* dst = result.ptr<unsigned char>();
-                        for (size_t i = 0; i < numel(); ++i) {
-                            dst[i] = op(src[i], scalar);
-                        }
+                        apply_unary_cpu(src, result.ptr<unsigned char>(), numel(),
+                                        ops::scalar_right_op<Op, float>(scalar));
                     } else {
                         float* dst = result.ptr<float>();
                         apply_unary_cpu(src, dst, numel(), ops::scalar_right_op<Op, float>(scalar));
@@ -455,9 +452,7 @@ namespace lfs::core {
             } else {
                 // CPU implementation
                 float* dst = ptr<float>();
-                for (size_t i = 0; i < numel(); ++i) {
-                    dst[i] = op(dst[i], scalar);
-                }
+                apply_unary_cpu(dst, dst, numel(), ops::scalar_right_op<Op, float>(scalar));
             }
 
             return *this;
@@ -732,6 +727,14 @@ namespace lfs::core {
             return Tensor(data, shape, device, dtype);
         }
 
+        // View whose backing memory (e.g. a MappedFile) stays alive as long as the tensor or its views
+        static Tensor from_blob(void* data, TensorShape shape, Device device, DataType dtype,
+                                std::shared_ptr<void> owner) {
+            Tensor tensor(data, shape, device, dtype);
+            tensor.data_owner_ = std::move(owner);
+            return tensor;
+        }
+
         static Tensor from_vector(const std::vector<float>& data, TensorShape shape,
                                   Device device = Device::CUDA);
         static Tensor from_vector(const std::vector<int>& data, TensorShape shape,
@@ -1589,12 +1592,52 @@ namespace lfs::core {
          *   // sorted_vals: [1.0, 2.0, 3.0] (Float32)
          *   // sorted_idx:  [1, 0, 2]       (Int64)
          *
+         * On CPU, Float32/Int32/Int64 are sorted with a stable parallel radix sort (equal
+         * values keep index order, NaN counts as the largest value); CUDA supports Float32.
+         *
          * @param dim Dimension to sort along (default: -1, last dimension)
          * @param descending If true, sort in descending order (default: false)
          * @return Pair of (sorted_values, indices). Indices are always Int64 dtype.
          */
         std::pair<Tensor, Tensor> sort(int dim = -1, bool descending = false) const;
 
+        // Int64 indices that sort along `dim`; on CPU this skips gathering the values
+        Tensor argsort(int dim = -1, bool descending = false) const;
+
+        /**
+         * Sorted distinct values of the flattened tensor (Float32, Int32 or Int64).
+         * Float -0 and +0 count as one value, and so do all NaNs.
+         */
+        Tensor unique() const;
+
+        /**
+         * unique() plus, for each input element, the Int64 index of its value in the result
+         * (same shape as the input), and the Int64 number of occurrences of each value.
+         */
+        std::tuple<Tensor, Tensor, Tensor> unique_with_inverse_counts() const;
+
+        // ============= SELECTION (Float32, radix select without a full sort) =============
+
+        /**
+         * k largest (or smallest) values along `dim` and their Int64 indices; `dim` gets size k.
+         * When `sorted`, results are ordered best-first. Which of several values equal to the
+         * cut-off are kept is unspecified on CUDA; the CPU keeps the lowest indices.
+         */
+        std::pair<Tensor, Tensor> topk(size_t k, int dim = -1, bool largest = true, bool sorted = true) const;
+
+        // k-th smallest value along `dim` (1-based, as in PyTorch) and an index holding it
+        std::pair<Tensor, Tensor> kthvalue(size_t k, int dim = -1, bool keepdim = false) const;
+
+        // q-quantile along `dim`, linearly interpolated between neighbouring ranks (q in [0, 1])
+        Tensor quantile(float q, int dim = -1, bool keepdim = false) const;
+        float quantile_scalar(float q) const;
+
+        /**
+         * Int64 indices that place the element of rank `kth` (0-based) at position `kth`
+         * along `dim`, with no greater element before it and no smaller element after it.
+         */
+        Tensor argpartition(size_t kth, int dim = -1) const;
+
         // Scalar boolean reductions
         bool any_scalar() const;
         bool all_scalar() const;
@@ -1954,6 +1997,9 @@ namespace lfs::core {
         static MemoryInfo cuda();
         static MemoryInfo cpu();
 
+        // Return pooled host memory that no tensor uses to the OS
+        static void trim_cpu();
+
         void log() const;
     };
 
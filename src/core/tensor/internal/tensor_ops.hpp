@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "cpu_elementwise.hpp"
 #include "tensor_functors.hpp"
 #include <cuda_runtime.h>
 #include <vector>
@@ -41,20 +42,16 @@ namespace lfs::core::tensor_ops {
 
 // ============= CPU Helpers (Generic, Header-Only) =============
 namespace lfs::core {
-    // CPU helper for unary operations
+    // CPU helper for unary operations (multi-threaded, SIMD where the functor allows)
     template <typename T, typename OutT, typename Op>
     void apply_unary_cpu(const T* input, OutT* output, size_t n, Op op) {
-        for (size_t i = 0; i < n; ++i) {
-            output[i] = op(input[i]);
-        }
+        cpu_elementwise::unary(input, output, n, op);
     }
 
-    // CPU helper for binary operations
+    // CPU helper for binary operations (multi-threaded, SIMD where the functor allows)
     template <typename T, typename OutputT, typename Op>
     void apply_binary_cpu(const T* a, const T* b, OutputT* c, size_t n, Op op) {
-        for (size_t i = 0; i < n; ++i) {
-            c[i] = op(a[i], b[i]);
-        }
+        cpu_elementwise::binary(a, b, c, n, op);
     }
 } // namespace lfs::core
 
@@ -203,21 +200,22 @@ namespace lfs::core::tensor_ops {
                             size_t n, cudaStream_t stream);
 
     // ============= Random Operations =============
+    // Element i reads word i of the Philox stream (seed, offset), see internal/philox.hpp
     void launch_uniform(float* data, size_t n, float low, float high,
-                        unsigned long long seed, cudaStream_t stream);
+                        uint64_t seed, uint64_t offset, cudaStream_t stream);
 
     void launch_normal(float* data, size_t n, float mean, float std,
-                       unsigned long long seed, cudaStream_t stream);
+                       uint64_t seed, uint64_t offset, cudaStream_t stream);
 
     void launch_bernoulli(float* data, size_t n, float p,
-                          unsigned long long seed, cudaStream_t stream);
+                          uint64_t seed, uint64_t offset, cudaStream_t stream);
 
     void launch_randint(int* data, size_t n, int low, int high,
-                        unsigned long long seed, cudaStream_t stream);
+                        uint64_t seed, uint64_t offset, cudaStream_t stream);
 
     void launch_multinomial(const float* weights, int64_t* samples,
                             unsigned long n, unsigned long num_samples, bool replacement,
-                            unsigned long long seed, cudaStream_t stream);
+                            uint64_t seed, uint64_t offset, cudaStream_t stream);
 
     // ============= Matrix Creation Operations =============
     void launch_eye(float* data, size_t m, size_t n, cudaStream_t stream);
@@ -359,6 +357,20 @@ namespace lfs::core::tensor_ops {
                         size_t outer_size, size_t dim_size, size_t inner_size,
                         int dim, bool descending, cudaStream_t stream);
 
+    // ============= Selection Operations =============
+    // Batched radix select over a contiguous [rows, len] Float32 input, along len
+    void launch_topk(const float* src, float* values, int64_t* indices, size_t rows, size_t len, size_t k,
+                     bool largest, bool sorted, cudaStream_t stream);
+
+    // k is the 0-based ascending rank
+    void launch_kthvalue(const float* src, float* values, int64_t* indices, size_t rows, size_t len, size_t k,
+                         cudaStream_t stream);
+
+    void launch_quantile(const float* src, float* out, size_t rows, size_t len, double q, cudaStream_t stream);
+
+    void launch_argpartition(const float* src, int64_t* indices, size_t rows, size_t len, size_t kth,
+                             cudaStream_t stream);
+
     // ============= Concatenation Operations =============
     void launch_cat_last_dim(void* output, const std::vector<Tensor>& tensors, size_t num_rows,
                              size_t row_size, size_t element_size, cudaStream_t stream);
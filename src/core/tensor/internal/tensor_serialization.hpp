@@ -9,7 +9,8 @@
 namespace lfs::core {
 
     constexpr uint32_t TENSOR_FILE_MAGIC = 0x4C465354;
-    constexpr uint32_t TENSOR_FILE_VERSION = 1;
+    constexpr uint32_t TENSOR_FILE_VERSION = 1; // Data follows the header inline
+    constexpr uint32_t TENSOR_REF_VERSION = 2;  // Header is followed by an index into an attached store
 
     struct TensorFileHeader {
         uint32_t magic;
@@ -20,14 +21,58 @@ namespace lfs::core {
         uint64_t numel;
     };
 
+    /**
+     * @brief Out-of-line storage for tensor records
+     *
+     * When a sink is attached to an output stream, operator<< hands the tensor
+     * to it and writes a TENSOR_REF_VERSION record (header, dims, uint64 index)
+     * instead of the data. operator>> resolves such records through the source
+     * attached to the input stream. Streams without one keep using inline
+     * TENSOR_FILE_VERSION records, which are always readable.
+     */
+    class TensorRecordSink {
+    public:
+        virtual ~TensorRecordSink() = default;
+        virtual uint64_t put(const Tensor& tensor) = 0;
+    };
+
+    class TensorRecordSource {
+    public:
+        virtual ~TensorRecordSource() = default;
+        virtual Tensor get(uint64_t index) = 0;
+    };
+
+    namespace detail {
+        inline int tensor_sink_slot() {
+            static const int slot = std::ios_base::xalloc();
+            return slot;
+        }
+
+        inline int tensor_source_slot() {
+            static const int slot = std::ios_base::xalloc();
+            return slot;
+        }
+    } // namespace detail
+
+    // The stream does not own the sink/source; detach (nullptr) before it is destroyed
+    inline void attach_tensor_sink(std::ostream& os, TensorRecordSink* sink) {
+        os.pword(detail::tensor_sink_slot()) = sink;
+    }
+
+    inline void attach_tensor_source(std::istream& is, TensorRecordSource* source) {
+        is.pword(detail::tensor_source_slot()) = source;
+    }
+
     inline std::ostream& operator<<(std::ostream& os, const Tensor& tensor) {
         if (!tensor.is_valid()) {
             throw std::runtime_error("Cannot serialize invalid tensor");
         }
 
+        auto* const sink = static_cast<TensorRecordSink*>(os.pword(detail::tensor_sink_slot()));
+
         const TensorFileHeader header{
             TENSOR_FILE_MAGIC,
-            TENSOR_FILE_VERSION,
+            sink ? TENSOR_REF_VERSION : TENSOR_FILE_VERSION,
             static_cast<uint8_t>(tensor.dtype()),
             static_cast<uint8_t>(tensor.device()),
             static_cast<uint16_t>(tensor.ndim()),
@@ -39,6 +84,15 @@ namespace lfs::core {
             os.write(reinterpret_cast<const char*>(&d), sizeof(d));
         }
 
+        if (sink) {
+            const uint64_t index = sink->put(tensor);
+            os.write(reinterpret_cast<const char*>(&index), sizeof(index));
+            if (!os) {
+                throw std::runtime_error("Failed to write tensor reference");
+            }
+            return os;
+        }
+
         Tensor src = tensor.device() == Device::CUDA ? tensor.cpu() : tensor;
         if (!src.is_contiguous()) {
             src = src.contiguous();
@@ -58,7 +112,7 @@ namespace lfs::core {
         if (header.magic != TENSOR_FILE_MAGIC) {
             throw std::runtime_error("Invalid tensor file: wrong magic number");
         }
-        if (header.version != TENSOR_FILE_VERSION) {
+        if (header.version != TENSOR_FILE_VERSION && header.version != TENSOR_REF_VERSION) {
             throw std::runtime_error("Unsupported tensor file version");
         }
 
@@ -76,6 +130,23 @@ namespace lfs::core {
             throw std::runtime_error("Shape elements mismatch");
         }
 
+        if (header.version == TENSOR_REF_VERSION) {
+            auto* const source = static_cast<TensorRecordSource*>(is.pword(detail::tensor_source_slot()));
+            if (!source) {
+                throw std::runtime_error("Tensor reference without an attached tensor source");
+            }
+            uint64_t index = 0;
+            is.read(reinterpret_cast<char*>(&index), sizeof(index));
+            if (!is) {
+                throw std::runtime_error("Failed to read tensor reference");
+            }
+            tensor = source->get(index);
+            if (tensor.shape() != shape || tensor.dtype() != dtype) {
+                throw std::runtime_error("Referenced tensor does not match its record");
+            }
+            return is;
+        }
+
         tensor = Tensor::empty(shape, Device::CPU, dtype);
         is.read(reinterpret_cast<char*>(tensor.data_ptr()), tensor.bytes());
 
@@ -2,6 +2,8 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "core/logger.hpp"
+#include "internal/cpu_select.hpp"
+#include "internal/cpu_sort.hpp"
 #include "internal/tensor_impl.hpp"
 #include "internal/tensor_ops.hpp"
 #include <algorithm>
@@ -494,6 +496,62 @@ namespace lfs::core {
     }
 
     // ============= SORTING =============
+    namespace {
+        // Sorting and selection run over contiguous rows, so the chosen dimension is moved last
+        struct DimRows {
+            Tensor input;
+            size_t rows = 0;
+            size_t len = 0;
+        };
+
+        DimRows to_dim_rows(const Tensor& t, const int dim) {
+            const int last = static_cast<int>(t.ndim()) - 1;
+            DimRows r;
+            r.input = (dim == last) ? t.contiguous() : t.transpose(dim, last).contiguous();
+            r.len = t.size(dim);
+            r.rows = t.numel() / r.len;
+            return r;
+        }
+
+        // Shape of the moved input with the last dimension resized to `size`
+        TensorShape rows_shape(const Tensor& moved, const size_t size) {
+            auto dims = moved.shape().dims();
+            dims.back() = size;
+            return TensorShape(dims);
+        }
+
+        // Undoes the move of `dim` to the last position
+        Tensor from_dim_rows(const Tensor& t, const int dim) {
+            const int last = static_cast<int>(t.ndim()) - 1;
+            return (dim == last) ? t : t.transpose(dim, last).contiguous();
+        }
+
+        // CPU sort along `dim` (Float32, Int32 or Int64); values are skipped for an argsort
+        std::pair<Tensor, Tensor> sort_cpu(const Tensor& t, const int dim, const bool descending,
+                                           const bool with_values) {
+            if (t.numel() == 0)
+                return {t.clone(), Tensor::empty(t.shape(), Device::CPU, DataType::Int64)};
+
+            const auto r = to_dim_rows(t, dim);
+            auto indices = Tensor::empty(r.input.shape(), Device::CPU, DataType::Int64);
+            Tensor values = with_values ? Tensor::empty(r.input.shape(), Device::CPU, t.dtype()) : Tensor();
+
+            const auto run = [&]<typename T>(const T* src) {
+                cpu_sort::sort_rows(src, r.rows, r.len, descending, with_values ? values.ptr<T>() : nullptr,
+                                    indices.ptr<int64_t>());
+            };
+            switch (t.dtype()) {
+            case DataType::Float32: run(r.input.ptr<float>()); break;
+            case DataType::Int32: run(r.input.ptr<int32_t>()); break;
+            case DataType::Int64: run(r.input.ptr<int64_t>()); break;
+            default:
+                LOG_ERROR("sort on CPU does not support dtype {}", dtype_name(t.dtype()));
+                return {Tensor(), Tensor()};
+            }
+            return {with_values ? from_dim_rows(values, dim) : Tensor(), from_dim_rows(indices, dim)};
+        }
+    } // namespace
+
     std::pair<Tensor, Tensor> Tensor::sort(int dim, bool descending) const {
         if (!is_valid()) {
             LOG_ERROR("sort on invalid tensor");
@@ -506,40 +564,24 @@ namespace lfs::core {
             return {Tensor(), Tensor()};
         }
 
+        if (device_ == Device::CPU)
+            return sort_cpu(*this, dim, descending, /*with_values=*/true);
+
+        if (dtype_ != DataType::Float32) {
+            LOG_ERROR("sort on CUDA supports Float32 only, got {}", dtype_name(dtype_));
+            return {Tensor(), Tensor()};
+        }
+
         // Create output tensors on same device
         auto sorted = clone();
         auto indices = Tensor::empty(shape_, device_, DataType::Int64);
 
         // 1D case - optimized path
         if (ndim() == 1 && dim == 0) {
-            if (device_ == Device::CUDA) {
-                tensor_ops::launch_sort_1d(sorted.ptr<float>(),
-                                           reinterpret_cast<int64_t*>(indices.data_ptr()),
-                                           numel(), descending, 0);
-                // No sync - returns tensors
-            } else {
-                // CPU fallback
-                auto values_vec = to_vector();
-                std::vector<size_t> idx_vec(values_vec.size());
-                std::iota(idx_vec.begin(), idx_vec.end(), 0);
-
-                if (descending) {
-                    std::sort(idx_vec.begin(), idx_vec.end(),
-                              [&](size_t a, size_t b) { return values_vec[a] > values_vec[b]; });
-                } else {
-                    std::sort(idx_vec.begin(), idx_vec.end(),
-                              [&](size_t a, size_t b) { return values_vec[a] < values_vec[b]; });
-                }
-
-                float* sorted_data = sorted.ptr<float>();
-                int64_t* idx_data = reinterpret_cast<int64_t*>(indices.data_ptr());
-
-                for (size_t i = 0; i < idx_vec.size(); ++i) {
-                    sorted_data[i] = values_vec[idx_vec[i]];
-                    idx_data[i] = static_cast<int64_t>(idx_vec[i]);
-                }
-            }
-
+            tensor_ops::launch_sort_1d(sorted.ptr<float>(),
+                                       reinterpret_cast<int64_t*>(indices.data_ptr()),
+                                       numel(), descending, 0);
+            // No sync - returns tensors
             return {sorted, indices};
         }
 
@@ -555,48 +597,214 @@ namespace lfs::core {
             inner_size *= size(i);
         }
 
+        tensor_ops::launch_sort_2d(sorted.ptr<float>(),
+                                   reinterpret_cast<int64_t*>(indices.data_ptr()),
+                                   outer_size, dim_size, inner_size,
+                                   dim, descending, 0);
+        // No sync - returns tensors
+
+        return {sorted, indices};
+    }
+
+    Tensor Tensor::argsort(int dim, bool descending) const {
+        if (!is_valid()) {
+            LOG_ERROR("argsort on invalid tensor");
+            return Tensor();
+        }
+
+        dim = resolve_dim(dim);
+        if (dim < 0 || dim >= static_cast<int>(ndim())) {
+            LOG_ERROR("Invalid dimension for argsort: {}", dim);
+            return Tensor();
+        }
+
+        if (device_ == Device::CPU)
+            return sort_cpu(*this, dim, descending, /*with_values=*/false).second;
+        return sort(dim, descending).second;
+    }
+
+    // ============= UNIQUE =============
+    namespace {
+        // Sorted distinct values of a CPU tensor; inverse and counts are skipped unless requested
+        std::tuple<Tensor, Tensor, Tensor> unique_cpu(const Tensor& t, const bool with_inverse_counts) {
+            const auto flat = t.contiguous();
+            const size_t n = t.numel();
+            auto values = Tensor::empty({n}, Device::CPU, t.dtype());
+            Tensor inverse, counts;
+            if (with_inverse_counts) {
+                inverse = Tensor::empty(t.shape(), Device::CPU, DataType::Int64);
+                counts = Tensor::empty({n}, Device::CPU, DataType::Int64);
+            }
+
+            size_t count = 0;
+            const auto run = [&]<typename T>(const T* src) {
+                count = cpu_sort::unique(src, n, values.ptr<T>(),
+                                         with_inverse_counts ? inverse.ptr<int64_t>() : nullptr,
+                                         with_inverse_counts ? counts.ptr<int64_t>() : nullptr);
+            };
+            switch (t.dtype()) {
+            case DataType::Float32: run(flat.ptr<float>()); break;
+            case DataType::Int32: run(flat.ptr<int32_t>()); break;
+            case DataType::Int64: run(flat.ptr<int64_t>()); break;
+            default:
+                LOG_ERROR("unique does not support dtype {}", dtype_name(t.dtype()));
+                return {Tensor(), Tensor(), Tensor()};
+            }
+
+            if (count < n) {
+                values = values.slice(0, 0, count).contiguous();
+                if (with_inverse_counts)
+                    counts = counts.slice(0, 0, count).contiguous();
+            }
+            return {values, inverse, counts};
+        }
+
+        // No CUDA kernel yet; CUDA tensors round-trip through the parallel CPU path
+        std::tuple<Tensor, Tensor, Tensor> unique_any(const Tensor& t, const bool with_inverse_counts) {
+            if (t.device() == Device::CPU)
+                return unique_cpu(t, with_inverse_counts);
+            auto [values, inverse, counts] = unique_cpu(t.to(Device::CPU), with_inverse_counts);
+            if (!values.is_valid())
+                return {Tensor(), Tensor(), Tensor()};
+            return {values.to(Device::CUDA),
+                    inverse.is_valid() ? inverse.to(Device::CUDA) : Tensor(),
+                    counts.is_valid() ? counts.to(Device::CUDA) : Tensor()};
+        }
+    } // namespace
+
+    Tensor Tensor::unique() const {
+        if (!is_valid()) {
+            LOG_ERROR("unique on invalid tensor");
+            return Tensor();
+        }
+        return std::get<0>(unique_any(*this, /*with_inverse_counts=*/false));
+    }
+
+    std::tuple<Tensor, Tensor, Tensor> Tensor::unique_with_inverse_counts() const {
+        if (!is_valid()) {
+            LOG_ERROR("unique on invalid tensor");
+            return {Tensor(), Tensor(), Tensor()};
+        }
+        return unique_any(*this, /*with_inverse_counts=*/true);
+    }
+
+    // ============= SELECTION =============
+    namespace {
+        bool check_select_input(const Tensor& t, const int dim, const char* op) {
+            if (!t.is_valid() || t.numel() == 0) {
+                LOG_ERROR("{} on invalid or empty tensor", op);
+                return false;
+            }
+            if (t.dtype() != DataType::Float32) {
+                LOG_ERROR("{} requires Float32, got {}", op, dtype_name(t.dtype()));
+                return false;
+            }
+            if (dim < 0 || dim >= static_cast<int>(t.ndim())) {
+                LOG_ERROR("Invalid dimension for {}: {}", op, dim);
+                return false;
+            }
+            return true;
+        }
+
+        // Drops the reduced (size 1, last) dimension unless keepdim
+        Tensor finish_reduced(const Tensor& t, const int dim, const bool keepdim) {
+            auto moved_back = from_dim_rows(t, dim);
+            return keepdim ? moved_back : moved_back.squeeze(dim);
+        }
+    } // namespace
+
+    std::pair<Tensor, Tensor> Tensor::topk(const size_t k, int dim, const bool largest, const bool sorted) const {
+        dim = resolve_dim(dim);
+        if (!check_select_input(*this, dim, "topk"))
+            return {Tensor(), Tensor()};
+        if (k > size(dim)) {
+            LOG_ERROR("topk: k={} exceeds dimension size {}", k, size(dim));
+            return {Tensor(), Tensor()};
+        }
+
+        const auto r = to_dim_rows(*this, dim);
+        auto values = Tensor::empty(rows_shape(r.input, k), device_, DataType::Float32);
+        auto indices = Tensor::empty(rows_shape(r.input, k), device_, DataType::Int64);
+        if (k == 0)
+            return {values, indices};
+
         if (device_ == Device::CUDA) {
-            tensor_ops::launch_sort_2d(sorted.ptr<float>(),
-                                       reinterpret_cast<int64_t*>(indices.data_ptr()),
-                                       outer_size, dim_size, inner_size,
-                                       dim, descending, 0);
-            // No sync - returns tensors
+            tensor_ops::launch_topk(r.input.ptr<float>(), values.ptr<float>(), indices.ptr<int64_t>(),
+                                    r.rows, r.len, k, largest, sorted, stream());
         } else {
-            // CPU implementation
-            const float* src_data = ptr<float>();
-            float* sorted_data = sorted.ptr<float>();
-            int64_t* idx_data = reinterpret_cast<int64_t*>(indices.data_ptr());
+            cpu_select::topk(r.input.ptr<float>(), r.rows, r.len, k, largest, sorted,
+                             values.ptr<float>(), indices.ptr<int64_t>());
+        }
+        return {from_dim_rows(values, dim), from_dim_rows(indices, dim)};
+    }
 
-            // Sort each slice independently
-            for (size_t outer = 0; outer < outer_size; ++outer) {
-                for (size_t inner = 0; inner < inner_size; ++inner) {
-                    // Extract values for this slice
-                    std::vector<std::pair<float, size_t>> slice_data(dim_size);
-                    for (size_t d = 0; d < dim_size; ++d) {
-                        size_t src_idx = outer * dim_size * inner_size + d * inner_size + inner;
-                        slice_data[d] = {src_data[src_idx], d};
-                    }
+    std::pair<Tensor, Tensor> Tensor::kthvalue(const size_t k, int dim, const bool keepdim) const {
+        dim = resolve_dim(dim);
+        if (!check_select_input(*this, dim, "kthvalue"))
+            return {Tensor(), Tensor()};
+        if (k == 0 || k > size(dim)) {
+            LOG_ERROR("kthvalue: k={} out of range [1, {}]", k, size(dim));
+            return {Tensor(), Tensor()};
+        }
 
-                    // Sort the slice
-                    if (descending) {
-                        std::sort(slice_data.begin(), slice_data.end(),
-                                  [](const auto& a, const auto& b) { return a.first > b.first; });
-                    } else {
-                        std::sort(slice_data.begin(), slice_data.end(),
-                                  [](const auto& a, const auto& b) { return a.first < b.first; });
-                    }
+        const auto r = to_dim_rows(*this, dim);
+        auto values = Tensor::empty(rows_shape(r.input, 1), device_, DataType::Float32);
+        auto indices = Tensor::empty(rows_shape(r.input, 1), device_, DataType::Int64);
+        if (device_ == Device::CUDA) {
+            tensor_ops::launch_kthvalue(r.input.ptr<float>(), values.ptr<float>(), indices.ptr<int64_t>(),
+                                        r.rows, r.len, k - 1, stream());
+        } else {
+            cpu_select::kthvalue(r.input.ptr<float>(), r.rows, r.len, k - 1,
+                                 values.ptr<float>(), indices.ptr<int64_t>());
+        }
+        return {finish_reduced(values, dim, keepdim), finish_reduced(indices, dim, keepdim)};
+    }
 
-                    // Write back sorted values and indices
-                    for (size_t d = 0; d < dim_size; ++d) {
-                        size_t dst_idx = outer * dim_size * inner_size + d * inner_size + inner;
-                        sorted_data[dst_idx] = slice_data[d].first;
-                        idx_data[dst_idx] = static_cast<int64_t>(slice_data[d].second);
-                    }
-                }
-            }
+    Tensor Tensor::quantile(const float q, int dim, const bool keepdim) const {
+        dim = resolve_dim(dim);
+        if (!check_select_input(*this, dim, "quantile"))
+            return Tensor();
+        if (!(q >= 0.0f && q <= 1.0f)) {
+            LOG_ERROR("quantile: q={} must be in [0, 1]", q);
+            return Tensor();
         }
 
-        return {sorted, indices};
+        const auto r = to_dim_rows(*this, dim);
+        auto out = Tensor::empty(rows_shape(r.input, 1), device_, DataType::Float32);
+        if (device_ == Device::CUDA) {
+            tensor_ops::launch_quantile(r.input.ptr<float>(), out.ptr<float>(), r.rows, r.len, q, stream());
+        } else {
+            cpu_select::quantile(r.input.ptr<float>(), r.rows, r.len, q, out.ptr<float>());
+        }
+        return finish_reduced(out, dim, keepdim);
+    }
+
+    float Tensor::quantile_scalar(const float q) const {
+        if (!is_valid() || numel() == 0) {
+            LOG_ERROR("quantile_scalar on invalid or empty tensor");
+            return 0.0f;
+        }
+        return flatten().quantile(q, 0).item();
+    }
+
+    Tensor Tensor::argpartition(const size_t kth, int dim) const {
+        dim = resolve_dim(dim);
+        if (!check_select_input(*this, dim, "argpartition"))
+            return Tensor();
+        if (kth >= size(dim)) {
+            LOG_ERROR("argpartition: kth={} out of range for dimension size {}", kth, size(dim));
+            return Tensor();
+        }
+
+        const auto r = to_dim_rows(*this, dim);
+        auto indices = Tensor::empty(r.input.shape(), device_, DataType::Int64);
+        if (device_ == Device::CUDA) {
+            tensor_ops::launch_argpartition(r.input.ptr<float>(), indices.ptr<int64_t>(),
+                                            r.rows, r.len, kth, stream());
+        } else {
+            cpu_select::argpartition(r.input.ptr<float>(), r.rows, r.len, kth, indices.ptr<int64_t>());
+        }
+        return from_dim_rows(indices, dim);
     }
 
     // ============= SCALAR BOOLEAN REDUCTIONS =============
@@ -2,6 +2,8 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "core/logger.hpp"
+#include "internal/cpu_parallel.hpp"
+#include "internal/cpu_sort.hpp"
 #include "internal/tensor_impl.hpp"
 #include "internal/tensor_ops.hpp"
 #include <algorithm>
@@ -63,18 +65,14 @@ namespace lfs::core {
                                              result.ptr<float>(), numel(), output_size, 0);
             // No sync - tensor operation
         } else {
-            // CPU implementation - FIXED to respect mask
+            // CPU implementation - parallel prefix-sum compaction, keeps input order
             const float* src = ptr<float>();
             const unsigned char* mask_data = mask.ptr<unsigned char>();
             float* dst = result.ptr<float>();
 
-            size_t write_idx = 0;
-            for (size_t i = 0; i < numel(); ++i) {
-                // Only copy when mask is TRUE
-                if (mask_data[i]) {
-                    dst[write_idx++] = src[i];
-                }
-            }
+            const size_t write_idx = cpu_sort::compact(
+                numel(), [&](const size_t i) { return mask_data[i] != 0; },
+                [&](const size_t i, const size_t pos) { dst[pos] = src[i]; });
 
             LOG_DEBUG("masked_select CPU: wrote {} elements", write_idx);
         }
@@ -222,10 +220,13 @@ namespace lfs::core {
                 return sel;
             };
 
-            // Templated copy for all dtypes
+            // Templated copy for all dtypes; output rows are independent and copied in parallel
             const auto copy_selected = [&]<typename T>(const T* src, T* dst) {
-                for (size_t o = 0; o < outer; ++o) {
-                    for (size_t i = 0; i < n_indices; ++i) {
+                const size_t grain = std::max<size_t>(1, cpu_parallel::DEFAULT_GRAIN / std::max<size_t>(inner, 1));
+                cpu_parallel::parallel_for(outer * n_indices, grain, [&](const size_t begin, const size_t end) {
+                    for (size_t r = begin; r < end; ++r) {
+                        const size_t o = r / n_indices;
+                        const size_t i = r % n_indices;
                         const int sel = process_idx(idx[i]);
                         if (sel >= 0 && sel < static_cast<int>(dim_size)) {
                             std::copy_n(src + (o * dim_size + sel) * inner,
@@ -233,7 +234,7 @@ namespace lfs::core {
                                         dst + (o * n_indices + i) * inner);
                         }
                     }
-                }
+                });
             };
 
             if (dtype_ == DataType::Float32) {
@@ -1207,6 +1208,24 @@ namespace lfs::core {
         }
     }
 
+    namespace {
+        // Parallel prefix-sum scan of the non-zero elements of a contiguous CPU tensor;
+        // emit(i, pos) receives each flat index with its output position, in order
+        template <typename EmitFn>
+        size_t cpu_nonzero(const Tensor& t, EmitFn&& emit) {
+            const auto scan = [&]<typename T>(const T* data) {
+                return cpu_sort::compact(
+                    t.numel(), [&](const size_t i) { return data[i] != T{0}; }, emit);
+            };
+            switch (t.dtype()) {
+            case DataType::Bool: return scan(t.ptr<unsigned char>());
+            case DataType::Float32: return scan(t.ptr<float>());
+            case DataType::Int32: return scan(t.ptr<int>());
+            default: return size_t{0};
+            }
+        }
+    } // namespace
+
     Tensor Tensor::nonzero() const {
         if (!is_valid()) {
             LOG_ERROR("nonzero() on invalid tensor");
@@ -1259,30 +1278,9 @@ namespace lfs::core {
                 // No sync - tensor operation
             } else {
                 int64_t* indices = reinterpret_cast<int64_t*>(temp.data_ptr());
-                size_t write_idx = 0;
-
-                if (dtype_ == DataType::Bool) {
-                    const unsigned char* data = ptr<unsigned char>();
-                    for (size_t i = 0; i < numel(); ++i) {
-                        if (data[i]) {
-                            indices[write_idx++] = static_cast<int64_t>(i);
-                        }
-                    }
-                } else if (dtype_ == DataType::Float32) {
-                    const float* data = ptr<float>();
-                    for (size_t i = 0; i < numel(); ++i) {
-                        if (data[i] != 0.0f) {
-                            indices[write_idx++] = static_cast<int64_t>(i);
-                        }
-                    }
-                } else if (dtype_ == DataType::Int32) {
-                    const int* data = ptr<int>();
-                    for (size_t i = 0; i < numel(); ++i) {
-                        if (data[i] != 0) {
-                            indices[write_idx++] = static_cast<int64_t>(i);
-                        }
-                    }
-                }
+                const size_t write_idx = cpu_nonzero(*this, [&](const size_t i, const size_t pos) {
+                    indices[pos] = static_cast<int64_t>(i);
+                });
 
                 // Update actual_count from write_idx (CPU path)
                 actual_count = write_idx;
@@ -1310,50 +1308,15 @@ namespace lfs::core {
             result = cpu_result.to(Device::CUDA);
         } else {
             int64_t* indices = reinterpret_cast<int64_t*>(result.data_ptr());
-            size_t write_idx = 0;
+            const auto strides = shape_.strides();
 
-            auto strides = shape_.strides();
-
-            if (dtype_ == DataType::Bool) {
-                const unsigned char* data = ptr<unsigned char>();
-                for (size_t i = 0; i < numel(); ++i) {
-                    if (data[i]) {
-                        size_t temp = i;
-                        for (size_t dim = 0; dim < n_dims; ++dim) {
-                            size_t coord = temp / strides[dim];
-                            temp %= strides[dim];
-                            indices[write_idx * n_dims + dim] = static_cast<int64_t>(coord);
-                        }
-                        write_idx++;
-                    }
+            cpu_nonzero(*this, [&](const size_t i, const size_t pos) {
+                size_t temp = i;
+                for (size_t dim = 0; dim < n_dims; ++dim) {
+                    indices[pos * n_dims + dim] = static_cast<int64_t>(temp / strides[dim]);
+                    temp %= strides[dim];
                 }
-            } else if (dtype_ == DataType::Float32) {
-                const float* data = ptr<float>();
-                for (size_t i = 0; i < numel(); ++i) {
-                    if (data[i] != 0.0f) {
-                        size_t temp = i;
-                        for (size_t dim = 0; dim < n_dims; ++dim) {
-                            size_t coord = temp / strides[dim];
-                            temp %= strides[dim];
-                            indices[write_idx * n_dims + dim] = static_cast<int64_t>(coord);
-                        }
-                        write_idx++;
-                    }
-                }
-            } else if (dtype_ == DataType::Int32) {
-                const int* data = ptr<int>();
-                for (size_t i = 0; i < numel(); ++i) {
-                    if (data[i] != 0) {
-                        size_t temp = i;
-                        for (size_t dim = 0; dim < n_dims; ++dim) {
-                            size_t coord = temp / strides[dim];
-                            temp %= strides[dim];
-                            indices[write_idx * n_dims + dim] = static_cast<int64_t>(coord);
-                        }
-                        write_idx++;
-                    }
-                }
-            }
+            });
         }
 
         return result;
@@ -3,29 +3,11 @@
 
 #include "core/logger.hpp"
 #include "core/tensor_trace.hpp"
+#include "internal/cpu_gemm.hpp"
 #include "internal/tensor_impl.hpp"
 
 namespace lfs::core {
 
-    namespace {
-
-        // CPU matrix multiply: C = A @ B
-        // A: [m, k], B: [k, n], C: [m, n]
-        void cpu_matmul(const float* a, const float* b, float* c,
-                        size_t m, size_t k, size_t n) {
-            for (size_t i = 0; i < m; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    float sum = 0.0f;
-                    for (size_t l = 0; l < k; ++l) {
-                        sum += a[i * k + l] * b[l * n + j];
-                    }
-                    c[i * n + j] = sum;
-                }
-            }
-        }
-
-    } // namespace
-
     Tensor Tensor::mm(const Tensor& other) const {
         if (!is_valid() || !other.is_valid()) {
             LOG_ERROR("Invalid tensors for matrix multiplication");
@@ -57,11 +39,13 @@ namespace lfs::core {
             return cpu().contiguous().mm(other.cpu().contiguous()).cuda();
         }
 
-        const Tensor& a = is_contiguous() ? *this : contiguous();
-        const Tensor& b = other.is_contiguous() ? other : other.contiguous();
-
+        // Strided 2D views (e.g. x.t()) are consumed directly by the packing stage
         auto result = empty({m, n}, Device::CPU, dtype_);
-        cpu_matmul(a.ptr<float>(), b.ptr<float>(), result.ptr<float>(), m, k, n);
+        cpu_gemm::sgemm(ptr<float>(),
+                        static_cast<std::ptrdiff_t>(strides_[0]), static_cast<std::ptrdiff_t>(strides_[1]),
+                        other.ptr<float>(),
+                        static_cast<std::ptrdiff_t>(other.strides_[0]), static_cast<std::ptrdiff_t>(other.strides_[1]),
+                        result.ptr<float>(), m, k, n);
         return result;
     }
 
@@ -106,22 +90,8 @@ namespace lfs::core {
         const Tensor& b = other.is_contiguous() ? other : other.contiguous();
 
         auto result = empty({batch_size, m, n}, Device::CPU, dtype_);
-
-        const float* a_data = a.ptr<float>();
-        const float* b_data = b.ptr<float>();
-        float* c_data = result.ptr<float>();
-
-        const size_t a_stride = m * k;
-        const size_t b_stride = k * n;
-        const size_t c_stride = m * n;
-
-        for (size_t batch = 0; batch < batch_size; ++batch) {
-            cpu_matmul(a_data + batch * a_stride,
-                       b_data + batch * b_stride,
-                       c_data + batch * c_stride,
-                       m, k, n);
-        }
-
+        cpu_gemm::sgemm_batched(a.ptr<float>(), b.ptr<float>(), result.ptr<float>(),
+                                batch_size, m, k, n);
         return result;
     }
 
@@ -240,12 +210,7 @@ namespace lfs::core {
 
         const Tensor& a = is_contiguous() ? *this : contiguous();
         const Tensor& b = other.is_contiguous() ? other : other.contiguous();
-        const size_t n = a.shape_[0];
-
-        float sum = 0.0f;
-        for (size_t i = 0; i < n; ++i) {
-            sum += a.ptr<float>()[i] * b.ptr<float>()[i];
-        }
+        const float sum = cpu_gemm::sdot(a.ptr<float>(), b.ptr<float>(), a.shape_[0]);
 
         auto result = empty({1}, Device::CPU, dtype_);
         *result.ptr<float>() = sum;
@@ -1,16 +1,16 @@
 /* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
+#include "internal/memory_pool.hpp"
+#include "internal/philox.hpp"
 #include "internal/tensor_functors.hpp"
 #include "internal/tensor_ops.hpp"
 #include <cuda_runtime.h>
-#include <curand_kernel.h>
 
 // Thrust headers for multinomial without replacement
 #include <thrust/copy.h>
 #include <thrust/device_vector.h>
 #include <thrust/execution_policy.h>
-#include <thrust/reduce.h>
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
 
@@ -19,201 +19,199 @@ namespace lfs::core::tensor_ops {
     // Note: run_with_thrust_policy is now in include/core/tensor_generic_ops.cuh
 
     // ============= Random Operations Kernels =============
+    //
+    // Every kernel reads the Philox stream (seed, offset) from internal/philox.hpp: thread t
+    // generates block t and writes elements [4t, 4t + 4), exactly as cpu_random does on the host.
+
+    namespace {
+
+        constexpr int RANDOM_BLOCK_SIZE = 256;
+
+        int philox_grid(const size_t n) {
+            const size_t blocks = (n + 3) / 4;
+            return static_cast<int>((blocks + RANDOM_BLOCK_SIZE - 1) / RANDOM_BLOCK_SIZE);
+        }
+
+        __device__ inline size_t philox_thread() {
+            return static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+        }
+
+    } // namespace
 
     // Uniform random generation
     __global__ void uniform_kernel(float* data, size_t n, float low, float high,
-                                   unsigned long long seed) {
-        int idx = blockIdx.x * blockDim.x + threadIdx.x;
-
-        if (idx < n) {
-            curandState state;
-            curand_init(seed, idx, 0, &state);
-            float val = curand_uniform(&state);
-            data[idx] = val * (high - low) + low;
-        }
+                                   uint64_t seed, uint64_t offset) {
+        const size_t t = philox_thread();
+        if (t * 4 >= n)
+            return;
+
+        const philox::Block block = philox::block(seed, offset, t);
+        for (int lane = 0; lane < 4 && t * 4 + lane < n; ++lane)
+            data[t * 4 + lane] = philox::to_uniform(block.x[lane], low, high);
     }
 
-    // Normal random generation
+    // Normal random generation (Box-Muller over lane pairs)
     __global__ void normal_kernel(float* data, size_t n, float mean, float std,
-                                  unsigned long long seed) {
-        int idx = blockIdx.x * blockDim.x + threadIdx.x;
+                                  uint64_t seed, uint64_t offset) {
+        const size_t t = philox_thread();
+        if (t * 4 >= n)
+            return;
 
-        if (idx < n) {
-            curandState state;
-            curand_init(seed, idx, 0, &state);
-            data[idx] = curand_normal(&state) * std + mean;
-        }
+        float values[4];
+        philox::to_normal(philox::block(seed, offset, t), mean, std, values);
+        for (int lane = 0; lane < 4 && t * 4 + lane < n; ++lane)
+            data[t * 4 + lane] = values[lane];
     }
 
     // Bernoulli random generation
     __global__ void bernoulli_kernel(float* data, size_t n, float p,
-                                     unsigned long long seed) {
-        int idx = blockIdx.x * blockDim.x + threadIdx.x;
-
-        if (idx < n) {
-            curandState state;
-            curand_init(seed, idx, 0, &state);
-            float val = curand_uniform(&state);
-            data[idx] = (val < p) ? 1.0f : 0.0f;
-        }
+                                     uint64_t seed, uint64_t offset) {
+        const size_t t = philox_thread();
+        if (t * 4 >= n)
+            return;
+
+        const philox::Block block = philox::block(seed, offset, t);
+        for (int lane = 0; lane < 4 && t * 4 + lane < n; ++lane)
+            data[t * 4 + lane] = philox::to_uniform(block.x[lane]) < p ? 1.0f : 0.0f;
     }
 
     // Random integer generation
     __global__ void randint_kernel(int* data, size_t n, int low, int high,
-                                   unsigned long long seed) {
-        int idx = blockIdx.x * blockDim.x + threadIdx.x;
-
-        if (idx < n) {
-            curandState state;
-            curand_init(seed, idx, 0, &state);
+                                   uint64_t seed, uint64_t offset) {
+        const size_t t = philox_thread();
+        if (t * 4 >= n)
+            return;
 
-            float val = curand_uniform(&state);
-            int range = high - low;
+        const philox::Block block = philox::block(seed, offset, t);
+        for (int lane = 0; lane < 4 && t * 4 + lane < n; ++lane)
+            data[t * 4 + lane] = philox::to_int(block.x[lane], low, high);
+    }
 
-            int result = low + static_cast<int>(val * range);
+    // Multinomial CDF, pass 1: sequential prefix sum of one CDF_BLOCK per thread
+    __global__ void cdf_block_scan_kernel(const float* weights, float* cdf, float* block_totals, size_t n) {
+        const size_t b = philox_thread();
+        const size_t first = b * philox::CDF_BLOCK;
+        if (first >= n)
+            return;
+        const size_t end = first + philox::CDF_BLOCK < n ? first + philox::CDF_BLOCK : n;
+        block_totals[b] = philox::cdf_block_scan(weights, cdf, first, end);
+    }
 
-            if (result >= high)
-                result = high - 1;
-            if (result < low)
-                result = low;
+    // Pass 2: block totals -> block offsets, in one thread so the rounding matches the host
+    __global__ void cdf_block_offsets_kernel(float* block_totals, size_t blocks) {
+        philox::cdf_block_offsets(block_totals, blocks);
+    }
 
-            data[idx] = result;
-        }
+    // Pass 3: add each block's offset (block 0 has none)
+    __global__ void cdf_add_offsets_kernel(float* cdf, const float* block_offsets, size_t n) {
+        const size_t i = philox::CDF_BLOCK + philox_thread();
+        if (i < n)
+            cdf[i] = philox::cdf_add_offset(cdf[i], block_offsets[i / philox::CDF_BLOCK]);
     }
 
-    // Kernel for multinomial sampling with replacement
-    __global__ void multinomial_with_replacement_kernel(const float* weights, int64_t* samples,
+    // Kernel for multinomial sampling with replacement: binary search of the CDF per sample
+    __global__ void multinomial_with_replacement_kernel(const float* cdf, int64_t* samples,
                                                         unsigned long n, unsigned long num_samples,
-                                                        float sum, unsigned long long seed) {
-        int idx = blockIdx.x * blockDim.x + threadIdx.x;
-
-        if (idx >= num_samples)
+                                                        uint64_t seed, uint64_t offset) {
+        const size_t t = philox_thread();
+        if (t * 4 >= num_samples)
             return;
 
-        curandState state;
-        curand_init(seed, idx, 0, &state);
-
-        float u = curand_uniform(&state) * sum;
-
-        float cumsum = 0.0f;
-        for (unsigned long i = 0; i < n; ++i) {
-            cumsum += weights[i];
-            if (u <= cumsum) {
-                samples[idx] = static_cast<int64_t>(i);
-                return;
-            }
-        }
-
-        samples[idx] = static_cast<int64_t>(n - 1);
+        const bool positive = cdf[n - 1] > 0.0f;
+        const philox::Block block = philox::block(seed, offset, t);
+        for (int lane = 0; lane < 4 && t * 4 + lane < num_samples; ++lane)
+            samples[t * 4 + lane] = positive ? philox::sample_cdf(cdf, n, block.x[lane]) : 0;
     }
 
     // Kernel to generate random keys for each index (Gumbel-max trick)
     __global__ void generate_gumbel_keys_kernel(const float* weights, float* keys,
-                                                unsigned long n, unsigned long long seed) {
-        int idx = blockIdx.x * blockDim.x + threadIdx.x;
-
-        if (idx >= n)
+                                                unsigned long n, uint64_t seed, uint64_t offset) {
+        const size_t t = philox_thread();
+        if (t * 4 >= n)
             return;
 
-        curandState state;
-        curand_init(seed, idx, 0, &state);
-
-        float u = curand_uniform(&state);
-
-        u = fmaxf(u, 1e-10f);
-        u = fminf(u, 1.0f - 1e-10f);
-
-        float gumbel = -logf(-logf(u));
-
-        float log_weight = logf(fmaxf(weights[idx], 1e-10f));
-        keys[idx] = log_weight + gumbel;
+        const philox::Block block = philox::block(seed, offset, t);
+        for (int lane = 0; lane < 4 && t * 4 + lane < n; ++lane)
+            keys[t * 4 + lane] = philox::gumbel_key(block.x[lane], weights[t * 4 + lane]);
     }
 
     // ============= Launch Functions =============
 
     void launch_uniform(float* data, size_t n, float low, float high,
-                        unsigned long long seed, cudaStream_t stream) {
+                        uint64_t seed, uint64_t offset, cudaStream_t stream) {
         if (n == 0)
             return;
-
-        int block_size = 256;
-        int grid_size = (n + block_size - 1) / block_size;
-        uniform_kernel<<<grid_size, block_size, 0, stream>>>(data, n, low, high, seed);
+        uniform_kernel<<<philox_grid(n), RANDOM_BLOCK_SIZE, 0, stream>>>(data, n, low, high, seed, offset);
     }
 
     void launch_normal(float* data, size_t n, float mean, float std,
-                       unsigned long long seed, cudaStream_t stream) {
+                       uint64_t seed, uint64_t offset, cudaStream_t stream) {
         if (n == 0)
             return;
-
-        int block_size = 256;
-        int grid_size = (n + block_size - 1) / block_size;
-        normal_kernel<<<grid_size, block_size, 0, stream>>>(data, n, mean, std, seed);
+        normal_kernel<<<philox_grid(n), RANDOM_BLOCK_SIZE, 0, stream>>>(data, n, mean, std, seed, offset);
     }
 
     void launch_bernoulli(float* data, size_t n, float p,
-                          unsigned long long seed, cudaStream_t stream) {
+                          uint64_t seed, uint64_t offset, cudaStream_t stream) {
         if (n == 0)
             return;
-
-        int block_size = 256;
-        int grid_size = (n + block_size - 1) / block_size;
-        bernoulli_kernel<<<grid_size, block_size, 0, stream>>>(data, n, p, seed);
+        bernoulli_kernel<<<philox_grid(n), RANDOM_BLOCK_SIZE, 0, stream>>>(data, n, p, seed, offset);
     }
 
     void launch_randint(int* data, size_t n, int low, int high,
-                        unsigned long long seed, cudaStream_t stream) {
+                        uint64_t seed, uint64_t offset, cudaStream_t stream) {
         if (n == 0)
             return;
-
-        int block_size = 256;
-        int grid_size = (n + block_size - 1) / block_size;
-        randint_kernel<<<grid_size, block_size, 0, stream>>>(data, n, low, high, seed);
+        randint_kernel<<<philox_grid(n), RANDOM_BLOCK_SIZE, 0, stream>>>(data, n, low, high, seed, offset);
     }
 
     void launch_multinomial(const float* weights, int64_t* samples,
                             unsigned long n, unsigned long num_samples, bool replacement,
-                            unsigned long long seed, cudaStream_t stream) {
+                            uint64_t seed, uint64_t offset, cudaStream_t stream) {
         if (n == 0 || num_samples == 0)
             return;
 
-        // Compute sum of weights using Thrust with centralized sum_op
-        auto weights_ptr = thrust::device_pointer_cast(weights);
-
-        float sum;
-        run_with_thrust_policy(stream, [&](auto policy) {
-            sum = thrust::reduce(
-                policy,
-                weights_ptr, weights_ptr + n,
-                0.0f,
-                ops::sum_op());
-        });
+        if (replacement) {
+            const size_t cdf_blocks = (n + philox::CDF_BLOCK - 1) / philox::CDF_BLOCK;
+            auto& pool = CudaMemoryPool::instance();
+            float* const cdf = static_cast<float*>(pool.allocate(n * sizeof(float), stream));
+            float* const block_totals = static_cast<float*>(pool.allocate(cdf_blocks * sizeof(float), stream));
+            if (!cdf || !block_totals) {
+                if (cdf)
+                    pool.deallocate(cdf, stream);
+                if (block_totals)
+                    pool.deallocate(block_totals, stream);
+                cudaMemsetAsync(samples, 0, num_samples * sizeof(int64_t), stream);
+                return;
+            }
 
-        if (sum <= 0) {
-            cudaMemsetAsync(samples, 0, num_samples * sizeof(int64_t), stream);
-            return;
-        }
+            const int scan_grid = static_cast<int>((cdf_blocks + RANDOM_BLOCK_SIZE - 1) / RANDOM_BLOCK_SIZE);
+            cdf_block_scan_kernel<<<scan_grid, RANDOM_BLOCK_SIZE, 0, stream>>>(weights, cdf, block_totals, n);
+            if (cdf_blocks > 1) {
+                cdf_block_offsets_kernel<<<1, 1, 0, stream>>>(block_totals, cdf_blocks);
+                const size_t rest = n - philox::CDF_BLOCK;
+                const int add_grid = static_cast<int>((rest + RANDOM_BLOCK_SIZE - 1) / RANDOM_BLOCK_SIZE);
+                cdf_add_offsets_kernel<<<add_grid, RANDOM_BLOCK_SIZE, 0, stream>>>(cdf, block_totals, n);
+            }
+            multinomial_with_replacement_kernel<<<philox_grid(num_samples), RANDOM_BLOCK_SIZE, 0, stream>>>(
+                cdf, samples, n, num_samples, seed, offset);
 
-        if (replacement) {
-            int block_size = 256;
-            int grid_size = (num_samples + block_size - 1) / block_size;
-            multinomial_with_replacement_kernel<<<grid_size, block_size, 0, stream>>>(
-                weights, samples, n, num_samples, sum, seed);
+            pool.deallocate(block_totals, stream);
+            pool.deallocate(cdf, stream);
         } else {
             thrust::device_vector<float> keys(n);
             thrust::device_vector<int64_t> indices(n);
 
-            int block_size = 256;
-            int grid_size = (n + block_size - 1) / block_size;
-            generate_gumbel_keys_kernel<<<grid_size, block_size, 0, stream>>>(
-                weights, thrust::raw_pointer_cast(keys.data()), n, seed);
+            generate_gumbel_keys_kernel<<<philox_grid(n), RANDOM_BLOCK_SIZE, 0, stream>>>(
+                weights, thrust::raw_pointer_cast(keys.data()), n, seed, offset);
 
+            // Stable, so equal keys keep index order like the CPU radix sort
             run_with_thrust_policy(stream, [&](auto policy) {
                 thrust::sequence(
                     policy,
                     indices.begin(), indices.end());
 
-                thrust::sort_by_key(
+                thrust::stable_sort_by_key(
                     policy,
                     keys.begin(), keys.end(),
                     indices.begin(),
@@ -228,4 +226,4 @@ namespace lfs::core::tensor_ops {
         }
     }
 
-} // namespace lfs::core::tensor_ops
\ No newline at end of file
+} // namespace lfs::core::tensor_ops
@@ -0,0 +1,369 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/logger.hpp"
+#include "internal/memory_pool.hpp"
+#include "internal/tensor_ops.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cuda_runtime.h>
+#include <thrust/device_ptr.h>
+#include <thrust/execution_policy.h>
+#include <thrust/sort.h>
+#include <vector>
+
+namespace lfs::core::tensor_ops {
+
+    namespace {
+
+        constexpr int SELECT_BLOCK = 256;
+        constexpr int RADIX_BITS = 8;
+        constexpr int RADIX_BINS = 1 << RADIX_BITS;
+        // Upper bound on blocks sharing one row in a pass
+        constexpr int MAX_BLOCKS_PER_ROW = 1024;
+
+        __device__ __forceinline__ uint32_t float_to_key(const float v) {
+            const uint32_t bits = __float_as_uint(v);
+            return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        }
+
+        __device__ __forceinline__ float key_to_float(const uint32_t key) {
+            return __uint_as_float((key & 0x80000000u) ? (key & 0x7FFFFFFFu) : ~key);
+        }
+
+        float key_to_float_host(const uint32_t key) {
+            const uint32_t bits = (key & 0x80000000u) ? (key & 0x7FFFFFFFu) : ~key;
+            float v;
+            std::memcpy(&v, &bits, sizeof(v));
+            return v;
+        }
+
+        // Selected key per row and how many keys in the row lie below and at it
+        struct RowSelection {
+            uint32_t key;
+            unsigned long long less;
+            unsigned long long equal;
+        };
+
+        __global__ void make_keys_kernel(const float* __restrict__ src, uint32_t* __restrict__ keys,
+                                         const size_t n, const uint32_t flip) {
+            const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+            if (idx < n)
+                keys[idx] = float_to_key(src[idx]) ^ flip;
+        }
+
+        // blockIdx.x is the row, blockIdx.y a slice of it
+        __global__ void radix_histogram_kernel(const uint32_t* __restrict__ keys, const size_t len,
+                                               const uint32_t* __restrict__ prefixes, const uint32_t prefix_mask,
+                                               const int shift, unsigned int* __restrict__ histograms) {
+            __shared__ unsigned int bins[RADIX_BINS];
+            for (int i = threadIdx.x; i < RADIX_BINS; i += blockDim.x)
+                bins[i] = 0;
+            __syncthreads();
+
+            const size_t row = blockIdx.x;
+            const uint32_t prefix = prefixes[row];
+            const uint32_t* row_keys = keys + row * len;
+            const size_t stride = static_cast<size_t>(gridDim.y) * blockDim.x;
+            for (size_t i = static_cast<size_t>(blockIdx.y) * blockDim.x + threadIdx.x; i < len; i += stride) {
+                const uint32_t key = row_keys[i];
+                if ((key & prefix_mask) == prefix)
+                    atomicAdd(&bins[(key >> shift) & (RADIX_BINS - 1)], 1u);
+            }
+            __syncthreads();
+
+            for (int i = threadIdx.x; i < RADIX_BINS; i += blockDim.x) {
+                if (bins[i] != 0)
+                    atomicAdd(&histograms[row * RADIX_BINS + i], bins[i]);
+            }
+        }
+
+        /**
+         * Three-way split of each row around its selected key. Less and equal elements go
+         * to the front of the row's output (equal ones after the `less` block, capped at
+         * `equal_cap[row]`), greater ones fill from the back when `row_stride` covers them.
+         */
+        __global__ void partition_kernel(const uint32_t* __restrict__ keys, const size_t len,
+                                         const RowSelection* __restrict__ selections,
+                                         const unsigned long long* __restrict__ equal_caps,
+                                         unsigned long long* __restrict__ counters,
+                                         int64_t* __restrict__ out, const size_t row_stride,
+                                         const bool write_greater) {
+            const size_t row = blockIdx.x;
+            const RowSelection sel = selections[row];
+            const uint32_t* row_keys = keys + row * len;
+            int64_t* row_out = out + row * row_stride;
+            unsigned long long* row_counters = counters + row * 3;
+
+            const size_t stride = static_cast<size_t>(gridDim.y) * blockDim.x;
+            for (size_t i = static_cast<size_t>(blockIdx.y) * blockDim.x + threadIdx.x; i < len; i += stride) {
+                const uint32_t key = row_keys[i];
+                if (key < sel.key) {
+                    row_out[atomicAdd(&row_counters[0], 1ull)] = static_cast<int64_t>(i);
+                } else if (key == sel.key) {
+                    const unsigned long long pos = atomicAdd(&row_counters[1], 1ull);
+                    if (pos < equal_caps[row])
+                        row_out[sel.less + pos] = static_cast<int64_t>(i);
+                } else if (write_greater) {
+                    row_out[row_stride - 1 - atomicAdd(&row_counters[2], 1ull)] = static_cast<int64_t>(i);
+                }
+            }
+        }
+
+        // Lowest index per row holding the selected key
+        __global__ void first_index_kernel(const uint32_t* __restrict__ keys, const size_t len,
+                                           const RowSelection* __restrict__ selections,
+                                           unsigned long long* __restrict__ indices) {
+            const size_t row = blockIdx.x;
+            const uint32_t target = selections[row].key;
+            const size_t stride = static_cast<size_t>(gridDim.y) * blockDim.x;
+            for (size_t i = static_cast<size_t>(blockIdx.y) * blockDim.x + threadIdx.x; i < len; i += stride) {
+                if (keys[row * len + i] == target)
+                    atomicMin(&indices[row], static_cast<unsigned long long>(i));
+            }
+        }
+
+        // Smallest key per row above the selected one
+        __global__ void next_key_kernel(const uint32_t* __restrict__ keys, const size_t len,
+                                        const RowSelection* __restrict__ selections,
+                                        unsigned int* __restrict__ next) {
+            const size_t row = blockIdx.x;
+            const uint32_t target = selections[row].key;
+            uint32_t best = 0xFFFFFFFFu;
+            const size_t stride = static_cast<size_t>(gridDim.y) * blockDim.x;
+            for (size_t i = static_cast<size_t>(blockIdx.y) * blockDim.x + threadIdx.x; i < len; i += stride) {
+                const uint32_t key = keys[row * len + i];
+                if (key > target && key < best)
+                    best = key;
+            }
+            if (best != 0xFFFFFFFFu)
+                atomicMin(&next[row], best);
+        }
+
+        // Row id in the high word keeps rows apart when all selections are sorted at once
+        __global__ void gather_sort_keys_kernel(const uint32_t* __restrict__ keys, const size_t len,
+                                                const int64_t* __restrict__ indices, const size_t k,
+                                                const size_t total, unsigned long long* __restrict__ sort_keys) {
+            const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+            if (idx >= total)
+                return;
+            const size_t row = idx / k;
+            sort_keys[idx] = (static_cast<unsigned long long>(row) << 32) | keys[row * len + indices[idx]];
+        }
+
+        __global__ void gather_values_kernel(const uint32_t* __restrict__ keys, const size_t len,
+                                             const int64_t* __restrict__ indices, const size_t k,
+                                             const size_t total, const uint32_t flip, float* __restrict__ values) {
+            const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+            if (idx >= total)
+                return;
+            const size_t row = idx / k;
+            values[idx] = key_to_float(keys[row * len + indices[idx]] ^ flip);
+        }
+
+        int blocks_for(const size_t n) {
+            return static_cast<int>((n + SELECT_BLOCK - 1) / SELECT_BLOCK);
+        }
+
+        dim3 row_grid(const size_t rows, const size_t len) {
+            const int per_row = std::clamp(blocks_for(len), 1, MAX_BLOCKS_PER_ROW);
+            return dim3(static_cast<unsigned int>(rows), static_cast<unsigned int>(per_row));
+        }
+
+        // Pool-backed scratch buffer released at scope exit
+        class Scratch {
+        public:
+            Scratch(const size_t bytes, cudaStream_t stream)
+                : ptr_(CudaMemoryPool::instance().allocate(std::max<size_t>(bytes, 1), stream)),
+                  stream_(stream) {}
+            ~Scratch() {
+                if (ptr_)
+                    CudaMemoryPool::instance().deallocate(ptr_, stream_);
+            }
+            Scratch(const Scratch&) = delete;
+            Scratch& operator=(const Scratch&) = delete;
+
+            template <typename T>
+            T* as() const { return static_cast<T*>(ptr_); }
+
+        private:
+            void* ptr_;
+            cudaStream_t stream_;
+        };
+
+        class SelectionContext {
+        public:
+            SelectionContext(const float* src, const size_t rows, const size_t len, const uint32_t flip,
+                             cudaStream_t stream)
+                : rows_(rows),
+                  len_(len),
+                  stream_(stream),
+                  keys_(rows * len * sizeof(uint32_t), stream),
+                  selections_(rows * sizeof(RowSelection), stream) {
+                const size_t n = rows * len;
+                make_keys_kernel<<<blocks_for(n), SELECT_BLOCK, 0, stream>>>(src, keys(), n, flip);
+            }
+
+            uint32_t* keys() const { return keys_.as<uint32_t>(); }
+            RowSelection* device_selections() const { return selections_.as<RowSelection>(); }
+
+            /**
+             * Batched MSD radix select: every row runs the same four 8-bit passes, and the
+             * host narrows each row's prefix from one small histogram download per pass.
+             * The result is also uploaded for the follow-up kernels.
+             */
+            std::vector<RowSelection> select(const std::vector<size_t>& ranks) {
+                Scratch histograms(rows_ * RADIX_BINS * sizeof(unsigned int), stream_);
+                Scratch prefixes(rows_ * sizeof(uint32_t), stream_);
+
+                std::vector<size_t> remaining(ranks);
+                std::vector<uint32_t> prefix(rows_, 0);
+                std::vector<RowSelection> result(rows_, RowSelection{0, 0, 0});
+                std::vector<unsigned int> counts(rows_ * RADIX_BINS);
+                uint32_t prefix_mask = 0;
+
+                for (int shift = 32 - RADIX_BITS; shift >= 0; shift -= RADIX_BITS) {
+                    cudaMemsetAsync(histograms.as<void>(), 0, rows_ * RADIX_BINS * sizeof(unsigned int), stream_);
+                    cudaMemcpyAsync(prefixes.as<void>(), prefix.data(), rows_ * sizeof(uint32_t),
+                                    cudaMemcpyHostToDevice, stream_);
+                    radix_histogram_kernel<<<row_grid(rows_, len_), SELECT_BLOCK, 0, stream_>>>(
+                        keys(), len_, prefixes.as<uint32_t>(), prefix_mask, shift, histograms.as<unsigned int>());
+                    cudaMemcpyAsync(counts.data(), histograms.as<void>(), counts.size() * sizeof(unsigned int),
+                                    cudaMemcpyDeviceToHost, stream_);
+                    cudaStreamSynchronize(stream_);
+
+                    for (size_t r = 0; r < rows_; ++r) {
+                        const unsigned int* row_counts = counts.data() + r * RADIX_BINS;
+                        uint32_t digit = 0;
+                        while (digit < RADIX_BINS - 1 && remaining[r] >= row_counts[digit]) {
+                            remaining[r] -= row_counts[digit];
+                            result[r].less += row_counts[digit];
+                            ++digit;
+                        }
+                        prefix[r] |= digit << shift;
+                        result[r].equal = row_counts[digit]; // Exact after the last pass
+                    }
+                    prefix_mask |= static_cast<uint32_t>(RADIX_BINS - 1) << shift;
+                }
+
+                for (size_t r = 0; r < rows_; ++r)
+                    result[r].key = prefix[r];
+                cudaMemcpyAsync(device_selections(), result.data(), rows_ * sizeof(RowSelection),
+                                cudaMemcpyHostToDevice, stream_);
+                return result;
+            }
+
+            void partition(const std::vector<unsigned long long>& equal_caps, int64_t* out, const size_t row_stride,
+                           const bool write_greater) {
+                Scratch caps(rows_ * sizeof(unsigned long long), stream_);
+                Scratch counters(rows_ * 3 * sizeof(unsigned long long), stream_);
+                cudaMemcpyAsync(caps.as<void>(), equal_caps.data(), rows_ * sizeof(unsigned long long),
+                                cudaMemcpyHostToDevice, stream_);
+                cudaMemsetAsync(counters.as<void>(), 0, rows_ * 3 * sizeof(unsigned long long), stream_);
+                partition_kernel<<<row_grid(rows_, len_), SELECT_BLOCK, 0, stream_>>>(
+                    keys(), len_, device_selections(), caps.as<unsigned long long>(),
+                    counters.as<unsigned long long>(), out, row_stride, write_greater);
+            }
+
+        private:
+            size_t rows_;
+            size_t len_;
+            cudaStream_t stream_;
+            Scratch keys_;
+            Scratch selections_;
+        };
+
+    } // namespace
+
+    void launch_topk(const float* src, float* values, int64_t* indices, size_t rows, size_t len, size_t k,
+                     bool largest, bool sorted, cudaStream_t stream) {
+        if (rows == 0 || k == 0)
+            return;
+        const uint32_t flip = largest ? 0xFFFFFFFFu : 0u;
+        SelectionContext ctx(src, rows, len, flip, stream);
+        const auto selections = ctx.select(std::vector<size_t>(rows, k - 1));
+
+        std::vector<unsigned long long> caps(rows);
+        for (size_t r = 0; r < rows; ++r)
+            caps[r] = k - selections[r].less;
+        ctx.partition(caps, indices, k, false);
+
+        const size_t total = rows * k;
+        if (sorted) {
+            Scratch sort_keys(total * sizeof(unsigned long long), stream);
+            gather_sort_keys_kernel<<<blocks_for(total), SELECT_BLOCK, 0, stream>>>(
+                ctx.keys(), len, indices, k, total, sort_keys.as<unsigned long long>());
+            auto keys_ptr = thrust::device_pointer_cast(sort_keys.as<unsigned long long>());
+            auto idx_ptr = thrust::device_pointer_cast(indices);
+            thrust::sort_by_key(thrust::cuda::par_nosync.on(stream), keys_ptr, keys_ptr + total, idx_ptr);
+        }
+        gather_values_kernel<<<blocks_for(total), SELECT_BLOCK, 0, stream>>>(
+            ctx.keys(), len, indices, k, total, flip, values);
+    }
+
+    void launch_kthvalue(const float* src, float* values, int64_t* indices, size_t rows, size_t len, size_t k,
+                         cudaStream_t stream) {
+        if (rows == 0)
+            return;
+        SelectionContext ctx(src, rows, len, 0u, stream);
+        const auto selections = ctx.select(std::vector<size_t>(rows, k));
+
+        std::vector<float> host_values(rows);
+        for (size_t r = 0; r < rows; ++r)
+            host_values[r] = key_to_float_host(selections[r].key);
+        const std::vector<int64_t> init_indices(rows, static_cast<int64_t>(len));
+        cudaMemcpyAsync(values, host_values.data(), rows * sizeof(float), cudaMemcpyHostToDevice, stream);
+        cudaMemcpyAsync(indices, init_indices.data(), rows * sizeof(int64_t), cudaMemcpyHostToDevice, stream);
+        first_index_kernel<<<row_grid(rows, len), SELECT_BLOCK, 0, stream>>>(
+            ctx.keys(), len, ctx.device_selections(), reinterpret_cast<unsigned long long*>(indices));
+        // The host vectors above are pageable, so their copies have completed on return
+    }
+
+    void launch_quantile(const float* src, float* out, size_t rows, size_t len, double q, cudaStream_t stream) {
+        if (rows == 0 || len == 0)
+            return;
+        const double pos = q * static_cast<double>(len - 1);
+        const auto lo = static_cast<size_t>(std::floor(pos));
+        const size_t hi = std::min(lo + 1, len - 1);
+        const double frac = pos - static_cast<double>(lo);
+
+        SelectionContext ctx(src, rows, len, 0u, stream);
+        const auto selections = ctx.select(std::vector<size_t>(rows, lo));
+
+        // Rank hi holds the same key unless the selected key's run ends at lo
+        std::vector<unsigned int> next_keys(rows, 0xFFFFFFFFu);
+        const bool need_next = std::any_of(selections.begin(), selections.end(), [&](const RowSelection& sel) {
+            return hi >= sel.less + sel.equal;
+        });
+        if (need_next) {
+            Scratch next(rows * sizeof(unsigned int), stream);
+            cudaMemsetAsync(next.as<void>(), 0xFF, rows * sizeof(unsigned int), stream);
+            next_key_kernel<<<row_grid(rows, len), SELECT_BLOCK, 0, stream>>>(
+                ctx.keys(), len, ctx.device_selections(), next.as<unsigned int>());
+            cudaMemcpyAsync(next_keys.data(), next.as<void>(), rows * sizeof(unsigned int), cudaMemcpyDeviceToHost,
+                            stream);
+            cudaStreamSynchronize(stream);
+        }
+
+        std::vector<float> host_out(rows);
+        for (size_t r = 0; r < rows; ++r) {
+            const double lo_value = key_to_float_host(selections[r].key);
+            const double hi_value = hi >= selections[r].less + selections[r].equal
+                                        ? key_to_float_host(next_keys[r])
+                                        : lo_value;
+            host_out[r] = static_cast<float>(lo_value + (hi_value - lo_value) * frac);
+        }
+        cudaMemcpyAsync(out, host_out.data(), rows * sizeof(float), cudaMemcpyHostToDevice, stream);
+    }
+
+    void launch_argpartition(const float* src, int64_t* indices, size_t rows, size_t len, size_t kth,
+                             cudaStream_t stream) {
+        if (rows == 0 || len == 0)
+            return;
+        SelectionContext ctx(src, rows, len, 0u, stream);
+        const auto selections = ctx.select(std::vector<size_t>(rows, kth));
+        ctx.partition(std::vector<unsigned long long>(rows, len), indices, len, true);
+    }
+
+} // namespace lfs::core::tensor_ops
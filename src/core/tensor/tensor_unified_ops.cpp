@@ -4,6 +4,9 @@
 #include "core/logger.hpp"
 #include "core/pinned_memory_allocator.hpp"
 #include "core/tensor_trace.hpp"
+#include "internal/cpu_random.hpp"
+#include "internal/cpu_reduce.hpp"
+#include "internal/host_arena_allocator.hpp"
 #include "internal/memory_pool.hpp"
 #include "internal/tensor_broadcast.hpp"
 #include "internal/tensor_functors.hpp"
@@ -13,7 +16,6 @@
 #include <cmath>
 #include <cstring>
 #include <cuda_runtime.h>
-#include <curand.h>
 #include <format>
 #include <numeric>
 
@@ -94,9 +96,9 @@ namespace lfs::core {
                                 PinnedMemoryAllocator::instance().deallocate(p, stream);
                         });
                     } else {
-                        dummy = std::malloc(1);
+                        dummy = HostArenaAllocator::instance().allocate(1);
                         result.data_owner_ = std::shared_ptr<void>(dummy, [](void* p) {
-                            std::free(p);
+                            HostArenaAllocator::instance().deallocate(p);
                         });
                     }
                 }
@@ -140,19 +142,25 @@ namespace lfs::core {
                             PinnedMemoryAllocator::instance().deallocate(p, stream);
                     });
                 } else {
-                    // Use regular malloc for CPU memory
-                    ptr = std::malloc(bytes);
+                    // Pooled host memory: reuses warm pages instead of a fresh malloc per tensor
+                    ptr = HostArenaAllocator::instance().allocate(bytes);
                     if (!ptr) {
                         LOG_ERROR("Failed to allocate {} bytes of regular CPU memory", bytes);
                         return Tensor();
                     }
                     result.data_owner_ = std::shared_ptr<void>(ptr, [](void* p) {
-                        std::free(p);
+                        HostArenaAllocator::instance().deallocate(p);
                     });
                 }
 
                 result.data_ = result.data_owner_.get();
                 result.compute_alignment(); // Compute alignment flags once
+
+                if constexpr (ENABLE_ALLOCATION_PROFILING) {
+                    AllocationProfiler::instance().record_tensor_allocation(
+                        result.data_, result.shape().dims(), bytes,
+                        std::string("cpu:") + dtype_name(result.dtype_), 2);
+                }
             }
             break;
         }
@@ -322,34 +330,22 @@ namespace lfs::core {
             if (!result.is_valid() || result.numel() == 0)
                 return result;
 
+            const auto [seed, offset] = RandomGenerator::instance().next_philox_state();
             if (result.device_ == Device::CUDA) {
                 if (result.dtype_ == DataType::Float32) {
-                    tensor_ops::launch_uniform(result.ptr<float>(), result.numel(), low, high,
-                                               RandomGenerator::instance().get_next_cuda_seed(), 0);
+                    tensor_ops::launch_uniform(result.ptr<float>(), result.numel(), low, high, seed, offset, 0);
                     // No sync - tensor operation
                 } else if (result.dtype_ == DataType::Int32) {
                     tensor_ops::launch_randint(result.ptr<int>(), result.numel(),
-                                               static_cast<int>(low), static_cast<int>(high),
-                                               RandomGenerator::instance().get_next_cuda_seed(), 0);
+                                               static_cast<int>(low), static_cast<int>(high), seed, offset, 0);
                     // No sync - tensor operation
                 }
             } else {
-                auto& gen = *static_cast<std::mt19937_64*>(
-                    RandomGenerator::instance().get_generator(Device::CPU));
-
                 if (result.dtype_ == DataType::Float32) {
-                    std::uniform_real_distribution<float> dist(low, high);
-                    float* data = result.ptr<float>();
-                    for (size_t i = 0; i < result.numel(); ++i) {
-                        data[i] = dist(gen);
-                    }
+                    cpu_random::uniform(result.ptr<float>(), result.numel(), low, high, seed, offset);
                 } else if (result.dtype_ == DataType::Int32) {
-                    std::uniform_int_distribution<int> dist(static_cast<int>(low),
-                                                            static_cast<int>(high) - 1);
-                    int* data = result.ptr<int>();
-                    for (size_t i = 0; i < result.numel(); ++i) {
-                        data[i] = dist(gen);
-                    }
+                    cpu_random::randint(result.ptr<int>(), result.numel(),
+                                        static_cast<int>(low), static_cast<int>(high), seed, offset);
                 }
             }
             break;
@@ -361,26 +357,12 @@ namespace lfs::core {
             if (!result.is_valid() || result.numel() == 0)
                 return result;
 
+            const auto [seed, offset] = RandomGenerator::instance().next_philox_state();
             if (result.device_ == Device::CUDA) {
-                // Use Philox RNG without resetting offset (stateful like PyTorch - much faster!)
-                curandGenerator_t* gen = static_cast<curandGenerator_t*>(
-                    RandomGenerator::instance().get_generator(Device::CUDA));
-
-                size_t n = result.numel();
-                if (n % 2 == 1) {
-                    curandGenerateNormal(*gen, result.ptr<float>(), n + 1, mean, std);
-                } else {
-                    curandGenerateNormal(*gen, result.ptr<float>(), n, mean, std);
-                }
-                // curandGenerateNormal is blocking, no need for explicit sync
+                tensor_ops::launch_normal(result.ptr<float>(), result.numel(), mean, std, seed, offset, 0);
+                // No sync - tensor operation
             } else {
-                auto& gen = *static_cast<std::mt19937_64*>(
-                    RandomGenerator::instance().get_generator(Device::CPU));
-                std::normal_distribution<float> dist(mean, std);
-                float* data = result.ptr<float>();
-                for (size_t i = 0; i < result.numel(); ++i) {
-                    data[i] = dist(gen);
-                }
+                cpu_random::normal(result.ptr<float>(), result.numel(), mean, std, seed, offset);
             }
             break;
         }
@@ -391,18 +373,17 @@ namespace lfs::core {
             if (!result.is_valid() || result.numel() == 0)
                 return result;
 
+            const auto [seed, offset] = RandomGenerator::instance().next_philox_state();
             if (result.device_ == Device::CUDA) {
                 if (result.dtype_ == DataType::Int32) {
-                    tensor_ops::launch_randint(result.ptr<int>(), result.numel(), low, high,
-                                               RandomGenerator::instance().get_next_cuda_seed(), 0);
+                    tensor_ops::launch_randint(result.ptr<int>(), result.numel(), low, high, seed, offset, 0);
                     // No sync - tensor operation
                 } else if (result.dtype_ == DataType::Float32) {
                     int* temp_buffer = static_cast<int*>(
                         CudaMemoryPool::instance().allocate(result.numel() * sizeof(int), nullptr));
 
                     if (temp_buffer) {
-                        tensor_ops::launch_randint(temp_buffer, result.numel(), low, high,
-                                                   RandomGenerator::instance().get_next_cuda_seed(), 0);
+                        tensor_ops::launch_randint(temp_buffer, result.numel(), low, high, seed, offset, 0);
 
                         tensor_ops::launch_convert_type<int, float>(temp_buffer, result.ptr<float>(),
                                                                     result.numel(), 0);
@@ -417,8 +398,7 @@ namespace lfs::core {
                         CudaMemoryPool::instance().allocate(result.numel() * sizeof(int), nullptr));
 
                     if (temp_buffer) {
-                        tensor_ops::launch_randint(temp_buffer, result.numel(), low, high,
-                                                   RandomGenerator::instance().get_next_cuda_seed(), 0);
+                        tensor_ops::launch_randint(temp_buffer, result.numel(), low, high, seed, offset, 0);
 
                         tensor_ops::launch_convert_type<int, uint8_t>(temp_buffer, result.ptr<uint8_t>(),
                                                                       result.numel(), 0);
@@ -430,25 +410,12 @@ namespace lfs::core {
                     }
                 }
             } else {
-                auto& gen = *static_cast<std::mt19937_64*>(
-                    RandomGenerator::instance().get_generator(Device::CPU));
-                std::uniform_int_distribution<int> dist(low, high - 1);
-
                 if (result.dtype_ == DataType::Int32) {
-                    int* data = result.ptr<int>();
-                    for (size_t i = 0; i < result.numel(); ++i) {
-                        data[i] = dist(gen);
-                    }
+                    cpu_random::randint(result.ptr<int>(), result.numel(), low, high, seed, offset);
                 } else if (result.dtype_ == DataType::Float32) {
-                    float* data = result.ptr<float>();
-                    for (size_t i = 0; i < result.numel(); ++i) {
-                        data[i] = static_cast<float>(dist(gen));
-                    }
+                    cpu_random::randint(result.ptr<float>(), result.numel(), low, high, seed, offset);
                 } else if (result.dtype_ == DataType::UInt8) {
-                    uint8_t* data = result.ptr<uint8_t>();
-                    for (size_t i = 0; i < result.numel(); ++i) {
-                        data[i] = static_cast<uint8_t>(dist(gen));
-                    }
+                    cpu_random::randint(result.ptr<uint8_t>(), result.numel(), low, high, seed, offset);
                 }
             }
             break;
@@ -460,18 +427,12 @@ namespace lfs::core {
             if (!result.is_valid() || result.numel() == 0)
                 return result;
 
+            const auto [seed, offset] = RandomGenerator::instance().next_philox_state();
             if (result.device_ == Device::CUDA) {
-                tensor_ops::launch_bernoulli(result.ptr<float>(), result.numel(), p,
-                                             RandomGenerator::instance().get_next_cuda_seed(), 0);
+                tensor_ops::launch_bernoulli(result.ptr<float>(), result.numel(), p, seed, offset, 0);
                 // No sync - tensor operation
             } else {
-                auto& gen = *static_cast<std::mt19937_64*>(
-                    RandomGenerator::instance().get_generator(Device::CPU));
-                std::bernoulli_distribution dist(p);
-                float* data = result.ptr<float>();
-                for (size_t i = 0; i < result.numel(); ++i) {
-                    data[i] = dist(gen) ? 1.0f : 0.0f;
-                }
+                cpu_random::bernoulli(result.ptr<float>(), result.numel(), p, seed, offset);
             }
             break;
         }
@@ -492,56 +453,18 @@ namespace lfs::core {
             if (!result.is_valid())
                 return result;
 
+            const auto [seed, offset] = RandomGenerator::instance().next_philox_state();
             if (weights->device() == Device::CUDA) {
                 tensor_ops::launch_multinomial(weights->ptr<float>(), result.ptr<int64_t>(),
-                                               n, num_samples, replacement,
-                                               RandomGenerator::instance().get_next_cuda_seed(), 0);
+                                               n, num_samples, replacement, seed, offset, 0);
                 // No sync - tensor operation
             } else {
-                auto weights_data = weights->to_vector();
-
-                float sum = std::accumulate(weights_data.begin(), weights_data.end(), 0.0f);
-                if (sum <= 0) {
+                const auto weights_data = weights->to_vector();
+                if (!cpu_random::multinomial(weights_data.data(), n, result.ptr<int64_t>(), num_samples,
+                                             replacement, seed, offset)) {
                     LOG_ERROR("Weights must sum to positive value");
                     return Tensor();
                 }
-
-                std::vector<float> cdf(n);
-                cdf[0] = weights_data[0] / sum;
-                for (size_t i = 1; i < n; ++i) {
-                    cdf[i] = cdf[i - 1] + weights_data[i] / sum;
-                }
-
-                auto& gen = *static_cast<std::mt19937_64*>(
-                    RandomGenerator::instance().get_generator(Device::CPU));
-                std::uniform_real_distribution<float> dis(0.0f, 1.0f);
-
-                int64_t* samples = result.ptr<int64_t>();
-
-                if (replacement) {
-                    for (size_t i = 0; i < num_samples; ++i) {
-                        float u = dis(gen);
-                        auto it = std::lower_bound(cdf.begin(), cdf.end(), u);
-                        samples[i] = static_cast<int64_t>(std::distance(cdf.begin(), it));
-                    }
-                } else {
-                    std::vector<std::pair<float, int64_t>> keys(n);
-
-                    for (size_t i = 0; i < n; ++i) {
-                        float u = dis(gen);
-                        u = std::clamp(u, 1e-10f, 1.0f - 1e-10f);
-                        float gumbel = -std::log(-std::log(u));
-                        float log_weight = std::log(std::max(weights_data[i], 1e-10f));
-                        keys[i] = {log_weight + gumbel, static_cast<int64_t>(i)};
-                    }
-
-                    std::sort(keys.begin(), keys.end(),
-                              [](const auto& a, const auto& b) { return a.first > b.first; });
-
-                    for (size_t i = 0; i < num_samples; ++i) {
-                        samples[i] = keys[i].second;
-                    }
-                }
             }
             break;
         }
@@ -618,6 +541,33 @@ namespace lfs::core {
         return load(LoadOp::Multinomial, args);
     }
 
+    namespace {
+        // Express a reduction over `axes` as [outer, reduce, inner] on a contiguous tensor.
+        // Fails when the reduced axes are separated by a kept axis of size > 1.
+        bool collapse_reduce_axes(const TensorShape& shape, const std::vector<int>& axes,
+                                  size_t& outer, size_t& reduce_size, size_t& inner) {
+            outer = reduce_size = inner = 1;
+            if (shape.rank() == 0 || axes.empty()) {
+                return shape.rank() == 0;
+            }
+            const int first = *std::min_element(axes.begin(), axes.end());
+            const int last = *std::max_element(axes.begin(), axes.end());
+            for (int i = 0; i < static_cast<int>(shape.rank()); ++i) {
+                const bool reduced = std::find(axes.begin(), axes.end(), i) != axes.end();
+                if (i < first) {
+                    outer *= shape[i];
+                } else if (i > last) {
+                    inner *= shape[i];
+                } else if (reduced) {
+                    reduce_size *= shape[i];
+                } else if (shape[i] != 1) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    } // namespace
+
     Tensor Tensor::reduce(ReduceOp op, const ReduceArgs& args) const {
         static const char* op_names[] = {"sum", "mean", "max", "min", "prod", "any", "all", "argmax", "argmin", "std", "var"};
         const char* op_name = (static_cast<int>(op) < 11) ? op_names[static_cast<int>(op)] : "reduce";
@@ -633,8 +583,10 @@ namespace lfs::core {
             input = &contiguous_copy;
         }
 
-        // Special handling for Std and Var
-        if (op == ReduceOp::Std || op == ReduceOp::Var) {
+        // Std and Var are composed from mean/sum, except on CPU Float32 where the
+        // reduction kernel computes them in a single Welford pass
+        const bool fused_variance = input->device_ == Device::CPU && input->dtype_ == DataType::Float32;
+        if ((op == ReduceOp::Std || op == ReduceOp::Var) && !fused_variance) {
             // Use the dedicated unbiased field from ReduceArgs
             bool unbiased = args.unbiased;
 
@@ -770,221 +722,36 @@ namespace lfs::core {
                 input->dtype_, nullptr);
             // No sync - tensor operation
         } else {
-            // CPU implementation
-
-            // Handle Int32 dtype
-            if (input->dtype_ == DataType::Int32) {
-                const int* src = static_cast<const int*>(input->data_ptr());
-                int* dst = static_cast<int*>(result.data_ptr());
-
-                // Full reduction to scalar (only mode supported for Int32)
-                if (axes.size() == input->shape_.rank()) {
-                    if (op == ReduceOp::Sum) {
-                        int sum = 0;
-                        for (size_t i = 0; i < input->numel(); ++i) {
-                            sum += src[i];
-                        }
-                        dst[0] = sum;
-                    } else if (op == ReduceOp::Mean) {
-                        int sum = 0;
-                        for (size_t i = 0; i < input->numel(); ++i) {
-                            sum += src[i];
-                        }
-                        dst[0] = sum / static_cast<int>(input->numel());
-                    } else if (op == ReduceOp::Max) {
-                        int max_val = src[0];
-                        for (size_t i = 1; i < input->numel(); ++i) {
-                            max_val = std::max(max_val, src[i]);
-                        }
-                        dst[0] = max_val;
-                    } else if (op == ReduceOp::Min) {
-                        int min_val = src[0];
-                        for (size_t i = 1; i < input->numel(); ++i) {
-                            min_val = std::min(min_val, src[i]);
-                        }
-                        dst[0] = min_val;
-                    } else if (op == ReduceOp::Prod) {
-                        int prod = 1;
-                        for (size_t i = 0; i < input->numel(); ++i) {
-                            prod *= src[i];
-                        }
-                        dst[0] = prod;
-                    }
-                    return result;
-                }
-                // Partial reductions not supported for Int32
-                return result;
-            }
-
-            // Float32 implementation
-            const float* src = static_cast<const float*>(input->data_ptr());
-            float* dst = static_cast<float*>(result.data_ptr());
-
-            // Full reduction to scalar
-            if (axes.size() == input->shape_.rank()) {
-                if (op == ReduceOp::Sum) {
-                    // Use double accumulation to avoid FP32 precision loss
-                    double sum = 0.0;
-                    for (size_t i = 0; i < input->numel(); ++i) {
-                        sum += src[i];
-                    }
-                    dst[0] = static_cast<float>(sum);
-                } else if (op == ReduceOp::Mean) {
-                    // Use double accumulation to avoid FP32 precision loss
-                    double sum = 0.0;
-                    for (size_t i = 0; i < input->numel(); ++i) {
-                        sum += src[i];
-                    }
-                    dst[0] = static_cast<float>(sum / input->numel());
-                } else if (op == ReduceOp::Max) {
-                    float max_val = src[0];
-                    for (size_t i = 1; i < input->numel(); ++i) {
-                        max_val = std::max(max_val, src[i]);
-                    }
-                    dst[0] = max_val;
-                } else if (op == ReduceOp::Min) {
-                    float min_val = src[0];
-                    for (size_t i = 1; i < input->numel(); ++i) {
-                        min_val = std::min(min_val, src[i]);
-                    }
-                    dst[0] = min_val;
-                } else if (op == ReduceOp::Prod) {
-                    float prod = 1.0f;
-                    for (size_t i = 0; i < input->numel(); ++i) {
-                        prod *= src[i];
-                    }
-                    dst[0] = prod;
-                }
-                return result;
-            }
-
-            // Axis-specific reduction - general implementation
-            // Build mask of which dimensions are reduced
-            std::vector<bool> is_reduced_dim(input->shape_.rank(), false);
-            for (int ax : axes) {
-                int resolved = input->resolve_dim(ax);
-                if (resolved >= 0 && resolved < static_cast<int>(input->shape_.rank())) {
-                    is_reduced_dim[resolved] = true;
-                }
-            }
-
-            // Calculate input strides
-            auto input_strides = input->shape_.strides();
-
-            // Calculate output strides
-            std::vector<size_t> out_shape_vec;
-            for (size_t i = 0; i < input->shape_.rank(); ++i) {
-                if (!is_reduced_dim[i]) {
-                    out_shape_vec.push_back(input->shape_[i]);
-                }
-            }
-
-            std::vector<size_t> output_strides;
-            if (!out_shape_vec.empty()) {
-                output_strides.resize(out_shape_vec.size());
-                output_strides.back() = 1;
-                for (int i = static_cast<int>(out_shape_vec.size()) - 2; i >= 0; --i) {
-                    output_strides[i] = output_strides[i + 1] * out_shape_vec[i + 1];
-                }
-            }
-
-            size_t output_elements = result.numel();
-
-            // Calculate how many elements to reduce per output element
-            size_t reduce_count = 1;
-            std::vector<size_t> reduced_dims;
-            for (size_t i = 0; i < input->shape_.rank(); ++i) {
-                if (is_reduced_dim[i]) {
-                    reduced_dims.push_back(i);
-                    reduce_count *= input->shape_[i];
-                }
-            }
-
-            // Perform reduction
-            for (size_t out_idx = 0; out_idx < output_elements; ++out_idx) {
-                // Convert output linear index to coordinates in output space
-                std::vector<size_t> out_coords;
-                if (!out_shape_vec.empty()) {
-                    out_coords.resize(out_shape_vec.size());
-                    size_t temp = out_idx;
-                    for (size_t i = 0; i < out_shape_vec.size(); ++i) {
-                        out_coords[i] = temp / output_strides[i];
-                        temp %= output_strides[i];
-                    }
-                }
-
-                // Map output coords back to base input coords
-                std::vector<size_t> base_input_coords(input->shape_.rank());
-                size_t out_coord_idx = 0;
+            // CPU: view the input as [outer, reduce, inner]. Non-adjacent reduced axes are
+            // permuted to the back first, so every reduction runs through the same kernels.
+            const Tensor* src_tensor = input;
+            Tensor permuted;
+            size_t outer = 1, reduce_size = 1, inner = 1;
+            if (!collapse_reduce_axes(input->shape_, axes, outer, reduce_size, inner)) {
+                std::vector<int> perm;
+                reduce_size = 1;
                 for (size_t i = 0; i < input->shape_.rank(); ++i) {
-                    if (!is_reduced_dim[i]) {
-                        base_input_coords[i] = out_coords[out_coord_idx++];
-                    } else {
-                        base_input_coords[i] = 0;
+                    if (std::find(axes.begin(), axes.end(), static_cast<int>(i)) == axes.end()) {
+                        perm.push_back(static_cast<int>(i));
                     }
                 }
-
-                // Initialize result with identity value for this output element
-                // Use double for sum/mean to avoid FP32 precision loss
-                double result_val_double = 0.0;
-                float result_val_float = 0.0f;
-
-                if (op == ReduceOp::Max) {
-                    result_val_float = -std::numeric_limits<float>::infinity();
-                } else if (op == ReduceOp::Min) {
-                    result_val_float = std::numeric_limits<float>::infinity();
-                } else if (op == ReduceOp::Prod) {
-                    result_val_float = 1.0f;
-                }
-
-                // Iterate through all combinations of reduced dimensions
-                for (size_t r = 0; r < reduce_count; ++r) {
-                    // Compute coordinates in the reduced dimensions
-                    size_t temp_r = r;
-                    std::vector<size_t> full_input_coords = base_input_coords;
-
-                    // Fill in reduced dimensions - work backwards for row-major order
-                    for (int rd_idx = static_cast<int>(reduced_dims.size()) - 1; rd_idx >= 0; --rd_idx) {
-                        size_t dim = reduced_dims[rd_idx];
-                        full_input_coords[dim] = temp_r % shape_[dim];
-                        temp_r /= shape_[dim];
-                    }
-
-                    // Calculate linear input index
-                    size_t in_idx = 0;
-                    for (size_t i = 0; i < shape_.rank(); ++i) {
-                        in_idx += full_input_coords[i] * input_strides[i];
-                    }
-
-                    // Apply reduction operation
-                    float val = src[in_idx];
-                    switch (op) {
-                    case ReduceOp::Sum:
-                    case ReduceOp::Mean:          // Mean accumulates like sum, then divides at end
-                        result_val_double += val; // Use double accumulation
-                        break;
-                    case ReduceOp::Max:
-                        result_val_float = std::max(result_val_float, val);
-                        break;
-                    case ReduceOp::Min:
-                        result_val_float = std::min(result_val_float, val);
-                        break;
-                    case ReduceOp::Prod:
-                        result_val_float *= val;
-                        break;
-                    default:
-                        break;
+                for (size_t i = 0; i < input->shape_.rank(); ++i) {
+                    if (std::find(axes.begin(), axes.end(), static_cast<int>(i)) != axes.end()) {
+                        perm.push_back(static_cast<int>(i));
+                        reduce_size *= input->shape_[i];
                     }
                 }
+                permuted = input->permute(perm).contiguous();
+                src_tensor = &permuted;
+                outer = result.numel();
+                inner = 1;
+            }
 
-                // Store result (apply mean if needed)
-                if (op == ReduceOp::Sum) {
-                    dst[out_idx] = static_cast<float>(result_val_double);
-                } else if (op == ReduceOp::Mean) {
-                    dst[out_idx] = static_cast<float>(result_val_double / reduce_count);
-                } else {
-                    dst[out_idx] = result_val_float;
-                }
+            if (!cpu_reduce::reduce(src_tensor->data_ptr(), result.data_ptr(), input->dtype_, op,
+                                    outer, reduce_size, inner, args.unbiased)) {
+                LOG_ERROR("Reduce op {} not supported on CPU for dtype {}",
+                          static_cast<int>(op), dtype_name(input->dtype_));
+                return Tensor();
             }
         }
 
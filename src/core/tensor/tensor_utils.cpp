@@ -2,6 +2,7 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "core/logger.hpp"
+#include "internal/host_arena_allocator.hpp"
 #include "internal/tensor_impl.hpp"
 #include "internal/tensor_ops.hpp"
 #include <algorithm>
@@ -96,14 +97,23 @@ namespace lfs::core {
     }
 
     MemoryInfo MemoryInfo::cpu() {
+        // Reports the pooled host allocator (pinned memory is tracked separately)
+        const auto stats = HostArenaAllocator::instance().get_stats();
+
         MemoryInfo info;
-        info.free_bytes = 0;
-        info.total_bytes = 0;
-        info.allocated_bytes = 0;
+        info.allocated_bytes = stats.allocated_bytes;
+        info.total_bytes = stats.reserved_bytes;
+        info.free_bytes = stats.reserved_bytes > stats.allocated_bytes
+                              ? stats.reserved_bytes - stats.allocated_bytes
+                              : 0;
         info.device_id = -1;
         return info;
     }
 
+    void MemoryInfo::trim_cpu() {
+        HostArenaAllocator::instance().trim();
+    }
+
     void MemoryInfo::log() const {
         LOG_INFO("Memory Info - Device: {}, Allocated: {:.2f} MB, Free: {:.2f} MB, Total: {:.2f} MB",
                  device_id,
@@ -0,0 +1,296 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor_archive.hpp"
+#include "core/mapped_file.hpp"
+#include "core/path_utils.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+#include <zstd.h>
+
+namespace lfs::core {
+
+    namespace {
+
+        struct ArchiveFooter {
+            uint64_t toc_offset = 0;
+            uint64_t toc_size = 0;
+            uint32_t version = TENSOR_ARCHIVE_VERSION;
+            uint32_t magic = TENSOR_ARCHIVE_MAGIC;
+        };
+        static_assert(sizeof(ArchiveFooter) == 24);
+
+        uint32_t checksum(const char* data, const size_t size) {
+            return static_cast<uint32_t>(crc32_z(0L, reinterpret_cast<const Bytef*>(data), size));
+        }
+
+        template <typename T>
+        void append_pod(std::vector<char>& out, const T& value) {
+            const auto* const bytes = reinterpret_cast<const char*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(value));
+        }
+
+        // Bounds-checked cursor over the TOC
+        class TocReader {
+        public:
+            explicit TocReader(std::span<const char> data) : data_(data) {}
+
+            template <typename T>
+            T pod() {
+                T value{};
+                std::memcpy(&value, take(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            std::string string(const size_t size) {
+                const char* const p = take(size);
+                return {p, size};
+            }
+
+            [[nodiscard]] bool done() const { return pos_ == data_.size(); }
+
+        private:
+            const char* take(const size_t size) {
+                if (size > data_.size() - pos_) {
+                    throw std::runtime_error("Truncated tensor archive TOC");
+                }
+                const char* const p = data_.data() + pos_;
+                pos_ += size;
+                return p;
+            }
+
+            std::span<const char> data_;
+            size_t pos_ = 0;
+        };
+
+        bool valid_dtype(const uint8_t dtype) {
+            return dtype <= static_cast<uint8_t>(DataType::Bool);
+        }
+
+    } // namespace
+
+    TensorArchiveWriter::TensorArchiveWriter(std::ostream& os, TensorArchiveWriteOptions options)
+        : os_(os),
+          options_(options) {}
+
+    const TensorArchiveEntry& TensorArchiveWriter::add(std::string name, const Tensor& tensor) {
+        if (tensor.device() != Device::CPU) {
+            throw std::runtime_error("TensorArchiveWriter: '" + name + "' is not a CPU tensor");
+        }
+        const Tensor host = tensor.is_contiguous() ? tensor : tensor.contiguous();
+
+        TensorArchiveEntry entry;
+        entry.name = std::move(name);
+        entry.dtype = host.dtype();
+        entry.shape = host.shape().dims();
+        entry.raw_size = host.bytes();
+        return write_entry(std::move(entry), static_cast<const char*>(host.data_ptr()), options_.compress);
+    }
+
+    const TensorArchiveEntry& TensorArchiveWriter::add_bytes(std::string name, const std::span<const char> bytes,
+                                                             const bool compress) {
+        TensorArchiveEntry entry;
+        entry.name = std::move(name);
+        entry.dtype = DataType::UInt8;
+        entry.shape = {bytes.size()};
+        entry.raw_size = bytes.size();
+        return write_entry(std::move(entry), bytes.data(), options_.compress && compress);
+    }
+
+    const TensorArchiveEntry& TensorArchiveWriter::write_entry(TensorArchiveEntry entry, const char* const data,
+                                                               const bool compress) {
+        // Pad so stored entries can be viewed in place with any dtype's alignment
+        const auto pos = static_cast<uint64_t>(os_.tellp());
+        const uint64_t padding = (TENSOR_ARCHIVE_ALIGNMENT - pos % TENSOR_ARCHIVE_ALIGNMENT) % TENSOR_ARCHIVE_ALIGNMENT;
+        static constexpr char ZEROS[TENSOR_ARCHIVE_ALIGNMENT] = {};
+        os_.write(ZEROS, static_cast<std::streamsize>(padding));
+        entry.offset = pos + padding;
+        entry.crc32 = checksum(data, entry.raw_size);
+
+        size_t packed = 0;
+        if (compress && entry.raw_size > 0) {
+            scratch_.resize(ZSTD_compressBound(entry.raw_size));
+            packed = ZSTD_compress(scratch_.data(), scratch_.size(), data, entry.raw_size, options_.compression_level);
+        }
+        if (compress && packed > 0 && !ZSTD_isError(packed) && packed < entry.raw_size) {
+            entry.codec = TensorCodec::Zstd;
+            entry.stored_size = packed;
+            os_.write(scratch_.data(), static_cast<std::streamsize>(packed));
+        } else {
+            entry.codec = TensorCodec::Stored;
+            entry.stored_size = entry.raw_size;
+            os_.write(data, static_cast<std::streamsize>(entry.raw_size));
+        }
+
+        stored_bytes_ += entry.stored_size;
+        entries_.push_back(std::move(entry));
+        return entries_.back();
+    }
+
+    bool TensorArchiveWriter::finish() {
+        std::vector<char> toc;
+        for (const auto& entry : entries_) {
+            append_pod(toc, static_cast<uint16_t>(entry.name.size()));
+            toc.insert(toc.end(), entry.name.begin(), entry.name.end());
+            append_pod(toc, static_cast<uint8_t>(entry.dtype));
+            append_pod(toc, static_cast<uint8_t>(entry.codec));
+            append_pod(toc, static_cast<uint16_t>(entry.shape.size()));
+            for (const size_t dim : entry.shape) {
+                append_pod(toc, static_cast<uint64_t>(dim));
+            }
+            append_pod(toc, entry.offset);
+            append_pod(toc, entry.stored_size);
+            append_pod(toc, entry.raw_size);
+            append_pod(toc, entry.crc32);
+        }
+
+        ArchiveFooter footer;
+        footer.toc_offset = static_cast<uint64_t>(os_.tellp());
+        footer.toc_size = toc.size();
+        os_.write(toc.data(), static_cast<std::streamsize>(toc.size()));
+        os_.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+        return static_cast<bool>(os_);
+    }
+
+    std::expected<std::shared_ptr<TensorArchive>, std::string> TensorArchive::open(const std::filesystem::path& path) {
+        auto file = MappedFile::open(path, MappedFile::Access::Random);
+        if (!file) {
+            return std::unexpected("Failed to map: " + path_to_utf8(path));
+        }
+
+        const auto bytes = file->as_span();
+        ArchiveFooter footer;
+        if (bytes.size() < sizeof(footer)) {
+            return std::unexpected("Not a tensor archive: " + path_to_utf8(path));
+        }
+        std::memcpy(&footer, bytes.data() + bytes.size() - sizeof(footer), sizeof(footer));
+        if (footer.magic != TENSOR_ARCHIVE_MAGIC) {
+            return std::unexpected("Not a tensor archive: " + path_to_utf8(path));
+        }
+        if (footer.version != TENSOR_ARCHIVE_VERSION) {
+            return std::unexpected("Unsupported tensor archive version: " + std::to_string(footer.version));
+        }
+        const uint64_t toc_limit = bytes.size() - sizeof(footer);
+        if (footer.toc_offset > toc_limit || footer.toc_size != toc_limit - footer.toc_offset) {
+            return std::unexpected("Corrupt tensor archive: bad TOC location");
+        }
+
+        std::shared_ptr<TensorArchive> archive(new TensorArchive());
+        archive->data_begin_ = footer.toc_offset;
+        try {
+            TocReader toc(bytes.subspan(footer.toc_offset, footer.toc_size));
+            while (!toc.done()) {
+                TensorArchiveEntry entry;
+                entry.name = toc.string(toc.pod<uint16_t>());
+                const auto dtype = toc.pod<uint8_t>();
+                const auto codec = toc.pod<uint8_t>();
+                if (!valid_dtype(dtype) || codec > static_cast<uint8_t>(TensorCodec::Zstd)) {
+                    return std::unexpected("Corrupt tensor archive: bad record for '" + entry.name + "'");
+                }
+                entry.dtype = static_cast<DataType>(dtype);
+                entry.codec = static_cast<TensorCodec>(codec);
+                entry.shape.resize(toc.pod<uint16_t>());
+                uint64_t numel = 1;
+                for (auto& dim : entry.shape) {
+                    dim = static_cast<size_t>(toc.pod<uint64_t>());
+                    numel *= dim;
+                }
+                entry.offset = toc.pod<uint64_t>();
+                entry.stored_size = toc.pod<uint64_t>();
+                entry.raw_size = toc.pod<uint64_t>();
+                entry.crc32 = toc.pod<uint32_t>();
+
+                if (entry.offset > footer.toc_offset || entry.stored_size > footer.toc_offset - entry.offset ||
+                    entry.raw_size != numel * dtype_size(entry.dtype) ||
+                    (entry.codec == TensorCodec::Stored && entry.stored_size != entry.raw_size)) {
+                    return std::unexpected("Corrupt tensor archive: entry '" + entry.name + "' out of bounds");
+                }
+                archive->data_begin_ = std::min(archive->data_begin_, entry.offset);
+                archive->entries_.push_back(std::move(entry));
+            }
+        } catch (const std::exception& e) {
+            return std::unexpected(std::string("Corrupt tensor archive: ") + e.what());
+        }
+
+        archive->file_ = std::move(file);
+        return archive;
+    }
+
+    const TensorArchiveEntry* TensorArchive::find(const std::string_view name) const {
+        for (const auto& entry : entries_) {
+            if (entry.name == name) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    std::span<const char> TensorArchive::prefix() const {
+        return file_->as_span().first(data_begin_);
+    }
+
+    std::span<const char> TensorArchive::stored_span(const TensorArchiveEntry& entry) const {
+        return file_->as_span().subspan(entry.offset, entry.stored_size);
+    }
+
+    Tensor TensorArchive::load(const size_t index) const {
+        if (index >= entries_.size()) {
+            throw std::runtime_error("Tensor archive index out of range: " + std::to_string(index));
+        }
+        const auto& entry = entries_[index];
+        const TensorShape shape(entry.shape);
+
+        if (entry.codec == TensorCodec::Stored) {
+            const auto stored = stored_span(entry);
+            if (checksum(stored.data(), stored.size()) != entry.crc32) {
+                throw std::runtime_error("Tensor archive checksum mismatch in '" + entry.name + "'");
+            }
+            // The mapping is copy-on-write, so callers may modify the view in place
+            return Tensor::from_blob(file_->data() + entry.offset, shape, Device::CPU, entry.dtype, file_);
+        }
+
+        auto tensor = Tensor::empty(shape, Device::CPU, entry.dtype);
+        const auto stored = stored_span(entry);
+        const size_t decoded = ZSTD_decompress(tensor.data_ptr(), entry.raw_size, stored.data(), stored.size());
+        if (ZSTD_isError(decoded) || decoded != entry.raw_size) {
+            throw std::runtime_error("Tensor archive entry '" + entry.name + "' failed to decompress");
+        }
+        if (checksum(static_cast<const char*>(tensor.data_ptr()), entry.raw_size) != entry.crc32) {
+            throw std::runtime_error("Tensor archive checksum mismatch in '" + entry.name + "'");
+        }
+        return tensor;
+    }
+
+    std::vector<char> TensorArchive::read_bytes(const size_t index) const {
+        if (index >= entries_.size()) {
+            throw std::runtime_error("Tensor archive index out of range: " + std::to_string(index));
+        }
+        const auto& entry = entries_[index];
+        const auto stored = stored_span(entry);
+
+        std::vector<char> bytes(entry.raw_size);
+        if (entry.codec == TensorCodec::Stored) {
+            std::memcpy(bytes.data(), stored.data(), stored.size());
+        } else {
+            const size_t decoded = ZSTD_decompress(bytes.data(), bytes.size(), stored.data(), stored.size());
+            if (ZSTD_isError(decoded) || decoded != entry.raw_size) {
+                throw std::runtime_error("Tensor archive entry '" + entry.name + "' failed to decompress");
+            }
+        }
+        if (checksum(bytes.data(), bytes.size()) != entry.crc32) {
+            throw std::runtime_error("Tensor archive checksum mismatch in '" + entry.name + "'");
+        }
+        return bytes;
+    }
+
+    std::vector<char> TensorArchive::read_bytes(const std::string_view name) const {
+        const auto* const entry = find(name);
+        if (!entry) {
+            throw std::runtime_error("Tensor archive has no entry '" + std::string(name) + "'");
+        }
+        return read_bytes(static_cast<size_t>(entry - entries_.data()));
+    }
+
+} // namespace lfs::core
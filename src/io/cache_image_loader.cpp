@@ -11,7 +11,6 @@
 
 #include <algorithm>
 #include <fstream>
-#include <random>
 
 #ifdef __linux__
 #include <sys/sysinfo.h>
@@ -22,37 +21,6 @@
 
 namespace lfs::io {
 
-    namespace {
-        std::filesystem::path get_lichtfeld_temp_folder() {
-            std::filesystem::path temp_base;
-#ifdef _WIN32
-            const char* temp = std::getenv("TEMP");
-            if (!temp)
-                temp = std::getenv("TMP");
-            temp_base = temp ? temp : "C:/Temp";
-#else
-            temp_base = "/tmp";
-#endif
-            return temp_base / "LichtFeld";
-        }
-
-        std::string generate_short_hash() {
-            static constexpr char hex_chars[] = "0123456789abcdef";
-
-            // Thread-safe: use local RNG objects to avoid data races
-            thread_local std::random_device rd;
-            thread_local std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dis(0, 15);
-
-            std::string hash;
-            hash.reserve(8);
-            for (int i = 0; i < 8; ++i) {
-                hash += hex_chars[dis(gen)];
-            }
-            return hash;
-        }
-    } // anonymous namespace
-
     std::size_t get_total_physical_memory() {
 #ifdef __linux__
         struct sysinfo info;
@@ -145,80 +113,27 @@ namespace lfs::io {
         return *instance_;
     }
 
-    namespace {
-
-        bool create_done_file(const std::filesystem::path& img_path) {
-            auto done_path = img_path;
-            done_path += ".done";
-            std::ofstream ofs;
-            return lfs::core::open_file_for_write(done_path, std::ios::trunc, ofs) && ofs.good();
-        }
-
-        bool does_cache_image_exist(const std::filesystem::path& img_path) {
-            auto done_path = img_path;
-            done_path += ".done";
-            return std::filesystem::exists(img_path) && std::filesystem::exists(done_path);
-        }
-
-    } // anonymous namespace
-
     CacheLoader::CacheLoader(bool use_cpu_memory, bool use_fs_cache)
         : use_cpu_memory_(use_cpu_memory),
           use_fs_cache_(use_fs_cache) {
-        create_new_cache_folder();
         min_cpu_free_memory_ratio_ = std::clamp(min_cpu_free_memory_ratio_, 0.0f, 1.0f);
     }
 
-    void CacheLoader::create_new_cache_folder() {
-        if (!use_fs_cache_)
-            return;
-
-        const auto cache_base = get_lichtfeld_temp_folder() / "cache";
-        const std::string unique_cache_path = std::string(CACHE_PREFIX) + generate_short_hash();
-        const std::filesystem::path cache_folder = cache_base / unique_cache_path;
-        std::error_code ec;
-
-        // Create LichtFeld temp folder if it doesn't exist
-        if (!std::filesystem::exists(cache_base.parent_path())) {
-            std::filesystem::create_directories(cache_base.parent_path(), ec);
-            if (ec) {
-                LOG_ERROR("Failed to create cache base path: {} - {}", lfs::core::path_to_utf8(cache_base.parent_path()), ec.message());
-                use_fs_cache_ = false;
-                return;
-            }
-            LOG_DEBUG("Created cache base path: {}", lfs::core::path_to_utf8(cache_base.parent_path()));
-        }
-
-        if (std::filesystem::exists(cache_folder)) {
-            std::filesystem::remove_all(cache_folder, ec);
-            if (ec) {
-                LOG_ERROR("Failed to wipe cache folder: {}", ec.message());
-                use_fs_cache_ = false;
-                return;
-            }
-        }
-
-        std::filesystem::create_directories(cache_folder, ec);
-        if (ec) {
-            LOG_ERROR("Failed to create cache directory: {}", ec.message());
-            use_fs_cache_ = false;
-            return;
-        }
-
-        cache_folder_ = cache_folder;
-        LOG_DEBUG("Cache directory: {}", lfs::core::path_to_utf8(cache_folder));
-    }
-
     void CacheLoader::reset_cache() {
         clear_cpu_cache();
+        {
+            // Packs stay on disk for the next run; open views keep their own mappings
+            std::lock_guard lock(decoded_packs_mutex_);
+            decoded_packs_.clear();
+        }
         clean_cache_folders();
-        create_new_cache_folder();
         cache_mode_ = CacheMode::Undetermined;
         num_expected_images_ = 0;
     }
 
+    // Removes the legacy per-run folders; decoded packs are bounded by DECODED_CACHE_MAX_BYTES instead
     void CacheLoader::clean_cache_folders() {
-        const auto cache_base = get_lichtfeld_temp_folder() / "cache";
+        const auto cache_base = lfs::core::lichtfeld_temp_folder() / "cache";
         if (!std::filesystem::exists(cache_base) || !std::filesystem::is_directory(cache_base)) {
             return;
         }
@@ -242,58 +157,37 @@ namespace lfs::io {
     }
 
     void CacheLoader::clear_cpu_cache() {
-        {
-            std::lock_guard lock(cpu_cache_mutex_);
-            cpu_cache_.clear();
-        }
-        {
-            std::lock_guard lock(jpeg_blob_mutex_);
-            jpeg_blob_cache_.clear();
-        }
+        cpu_cache_.clear();
+        jpeg_blob_cache_.clear();
     }
 
     bool CacheLoader::has_sufficient_memory(std::size_t required_bytes) const {
+        return memory_deficit(required_bytes) == 0;
+    }
+
+    std::size_t CacheLoader::memory_deficit(std::size_t required_bytes) const {
         const std::size_t available = get_available_physical_memory();
         const std::size_t total = get_total_physical_memory();
         const std::size_t min_free_bytes = (std::max)(
             static_cast<std::size_t>(total * min_cpu_free_memory_ratio_),
             static_cast<std::size_t>(min_cpu_free_GB_ * BYTES_PER_GB));
-        return available > required_bytes + min_free_bytes;
+        const std::size_t wanted = required_bytes + min_free_bytes;
+        return available > wanted ? 0 : wanted - available + 1;
     }
 
+    // Eviction is byte-budgeted: the deficit is measured once and the LRU tail is
+    // dropped until that many bytes are released. Freed tensors go back to the host
+    // pool, so the pool is trimmed afterwards for the OS to see the memory again.
     void CacheLoader::evict_until_satisfied() {
-        const std::size_t total = get_total_physical_memory();
-        const std::size_t min_free_bytes = (std::max)(
-            static_cast<std::size_t>(total * min_cpu_free_memory_ratio_),
-            static_cast<std::size_t>(min_cpu_free_GB_ * BYTES_PER_GB));
-
-        while (get_available_physical_memory() <= min_free_bytes) {
-            std::lock_guard lock(cpu_cache_mutex_);
-            if (cpu_cache_.empty())
-                break;
-
-            auto oldest = std::min_element(cpu_cache_.begin(), cpu_cache_.end(),
-                                           [](const auto& a, const auto& b) { return a.second.last_access < b.second.last_access; });
-            cpu_cache_.erase(oldest);
-        }
+        evict_if_needed(0);
     }
 
     void CacheLoader::evict_if_needed(std::size_t required_bytes) {
-        while (!cpu_cache_.empty() && !has_sufficient_memory(required_bytes)) {
-            auto oldest = std::min_element(cpu_cache_.begin(), cpu_cache_.end(),
-                                           [](const auto& a, const auto& b) { return a.second.last_access < b.second.last_access; });
-            if (oldest == cpu_cache_.end())
-                break;
-            cpu_cache_.erase(oldest);
-        }
-    }
-
-    std::size_t CacheLoader::get_cpu_cache_size() const {
-        std::size_t total = 0;
-        for (const auto& [key, data] : cpu_cache_) {
-            total += data.size_bytes;
+        if (const std::size_t deficit = memory_deficit(required_bytes); deficit > 0) {
+            if (cpu_cache_.evict_bytes(deficit) > 0) {
+                lfs::core::MemoryInfo::trim_cpu();
+            }
         }
-        return total;
     }
 
     std::string CacheLoader::generate_cache_key(const std::filesystem::path& path, const LoadParams& params) const {
@@ -307,15 +201,11 @@ namespace lfs::io {
         const std::string cache_key = generate_cache_key(path, params);
 
         // Check cache
-        {
-            std::lock_guard lock(cpu_cache_mutex_);
-            if (auto it = cpu_cache_.find(cache_key); it != cpu_cache_.end()) {
-                it->second.last_access = std::chrono::steady_clock::now();
-                const auto& cached = *it->second.tensor;
-                auto pinned = Tensor::empty(cached.shape(), Device::CPU, cached.dtype(), true);
-                std::memcpy(pinned.ptr<float>(), cached.ptr<float>(), cached.bytes());
-                return pinned;
-            }
+        if (auto hit = cpu_cache_.get(cache_key)) {
+            const auto& cached = *hit->tensor;
+            auto pinned = Tensor::empty(cached.shape(), Device::CPU, cached.dtype(), true);
+            std::memcpy(pinned.ptr<float>(), cached.ptr<float>(), cached.bytes());
+            return pinned;
         }
 
         // Check if another thread is loading
@@ -358,21 +248,22 @@ namespace lfs::io {
         const std::size_t tensor_bytes = tensor.numel() * sizeof(float);
 
         // Cache if memory available
+        if (has_sufficient_memory(tensor_bytes)) {
+            evict_if_needed(tensor_bytes);
+            auto unpinned = Tensor::empty_unpinned(tensor.shape(), DataType::Float32);
+            std::memcpy(unpinned.ptr<float>(), tensor.ptr<float>(), tensor_bytes);
+
+            cpu_cache_.put(cache_key,
+                           CachedImageData{
+                               .tensor = std::make_shared<Tensor>(std::move(unpinned)),
+                               .width = width,
+                               .height = height,
+                               .channels = channels,
+                               .size_bytes = tensor_bytes},
+                           tensor_bytes);
+        }
         {
             std::lock_guard lock(cpu_cache_mutex_);
-            if (has_sufficient_memory(tensor_bytes)) {
-                evict_if_needed(tensor_bytes);
-                auto unpinned = Tensor::empty_unpinned(tensor.shape(), DataType::Float32);
-                std::memcpy(unpinned.ptr<float>(), tensor.ptr<float>(), tensor_bytes);
-
-                cpu_cache_[cache_key] = CachedImageData{
-                    .tensor = std::make_shared<Tensor>(std::move(unpinned)),
-                    .width = width,
-                    .height = height,
-                    .channels = channels,
-                    .size_bytes = tensor_bytes,
-                    .last_access = std::chrono::steady_clock::now()};
-            }
             image_being_loaded_cpu_.erase(cache_key);
         }
 
@@ -380,58 +271,90 @@ namespace lfs::io {
         return tensor;
     }
 
+    DecodedImagePackStats CacheLoader::get_decoded_cache_stats() const {
+        std::lock_guard lock(decoded_packs_mutex_);
+        DecodedImagePackStats total;
+        for (const auto& [name, pack] : decoded_packs_) {
+            const auto stats = pack->stats();
+            total.entries += stats.entries;
+            total.live_bytes += stats.live_bytes;
+            total.pack_bytes += stats.pack_bytes;
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+            total.stale += stats.stale;
+            total.insertions += stats.insertions;
+            total.rejected += stats.rejected;
+        }
+        return total;
+    }
+
+    DecodedImagePack& CacheLoader::get_decoded_pack(const std::filesystem::path& image_path) {
+        const std::string name = DecodedImagePack::name_for(image_path.parent_path());
+        std::lock_guard lock(decoded_packs_mutex_);
+        auto& pack = decoded_packs_[name];
+        if (!pack) {
+            const auto decoded_dir = lfs::core::lichtfeld_temp_folder() / "decoded";
+            std::set<std::string> in_use;
+            for (const auto& [open_name, open_pack] : decoded_packs_) {
+                in_use.insert(open_name);
+            }
+            // Packs of other datasets make room first; this one may grow into what is left
+            const std::size_t total = DecodedImagePack::evict(decoded_dir, DECODED_CACHE_MAX_BYTES, in_use);
+            std::error_code ec;
+            const std::size_t own = std::filesystem::file_size(decoded_dir / (name + ".pack"), ec);
+            const std::size_t others = total - (ec ? 0 : (std::min)(own, total));
+            const std::size_t budget = DECODED_CACHE_MAX_BYTES - (std::min)(others, DECODED_CACHE_MAX_BYTES);
+            pack = std::make_unique<DecodedImagePack>(decoded_dir, name, budget);
+        }
+        return *pack;
+    }
+
+    // Decoded, resized pixels persist in a memory-mapped pack across runs, invalidated per
+    // image by source mtime and size. A warm load skips OIIO entirely and converts straight
+    // from the mapped pages.
     lfs::core::Tensor CacheLoader::load_cached_image_from_fs(
         const std::filesystem::path& path, const LoadParams& params) {
         using namespace lfs::core;
 
-        auto load_and_preprocess = [](unsigned char* data, int width, int height, int channels) {
-            auto tensor = Tensor::from_blob(data,
-                                            TensorShape({static_cast<size_t>(height), static_cast<size_t>(width), static_cast<size_t>(channels)}),
-                                            Device::CPU, DataType::UInt8);
-            tensor = tensor.to(DataType::Float32) / 255.0f;
-            tensor = tensor.permute({2, 0, 1}).contiguous();
-            free_image(data);
-            return tensor;
+        auto to_float_chw = [](const Tensor& hwc) {
+            return (hwc.to(DataType::Float32) / 255.0f).permute({2, 0, 1}).contiguous();
         };
 
-        if (cache_folder_.empty()) {
-            auto [data, w, h, c] = load_image(path, params.resize_factor, params.max_width);
-            return load_and_preprocess(data, w, h, c);
+        DecodedImagePack& pack = get_decoded_pack(path);
+        if (auto view = pack.find(path, params.resize_factor, params.max_width)) {
+            const auto pixels = Tensor::from_blob(const_cast<uint8_t*>(view->data),
+                                                  TensorShape({static_cast<size_t>(view->height),
+                                                               static_cast<size_t>(view->width),
+                                                               static_cast<size_t>(view->channels)}),
+                                                  Device::CPU, DataType::UInt8, std::move(view->owner));
+            return to_float_chw(pixels);
         }
 
-        const std::string unique_name = std::format("rf{}_mw{}_{}", params.resize_factor, params.max_width, lfs::core::path_to_utf8(path.filename()));
-        const auto cache_img_path = cache_folder_ / unique_name;
-
-        std::tuple<unsigned char*, int, int, int> result;
-        if (does_cache_image_exist(cache_img_path)) {
-            result = load_image(cache_img_path);
-        } else {
-            result = load_image(path, params.resize_factor, params.max_width);
-
-            bool is_being_saved = false;
-            const std::string path_key = lfs::core::path_to_utf8(path);
-            {
-                std::lock_guard lock(cache_mutex_);
-                is_being_saved = image_being_saved_.contains(path_key);
-                if (!is_being_saved) {
-                    image_being_saved_.insert(path_key);
-                }
-            }
+        auto [data, w, h, c] = load_image(path, params.resize_factor, params.max_width);
+        if (!data) {
+            throw std::runtime_error("Failed to load: " + lfs::core::path_to_utf8(path));
+        }
 
+        bool is_being_saved = false;
+        const std::string path_key = generate_cache_key(path, params);
+        {
+            std::lock_guard lock(cache_mutex_);
+            is_being_saved = image_being_saved_.contains(path_key);
             if (!is_being_saved) {
-                if (!save_img_data(cache_img_path, result)) {
-                    throw std::runtime_error("Failed to save cache: " + lfs::core::path_to_utf8(cache_img_path));
-                }
-                if (!create_done_file(cache_img_path)) {
-                    throw std::runtime_error("Failed to create .done: " + lfs::core::path_to_utf8(cache_img_path));
-                }
-                std::lock_guard lock(cache_mutex_);
-                image_being_saved_.erase(path_key);
+                image_being_saved_.insert(path_key);
             }
         }
+        if (!is_being_saved) {
+            pack.insert(path, params.resize_factor, params.max_width, data, w, h, c);
+            std::lock_guard lock(cache_mutex_);
+            image_being_saved_.erase(path_key);
+        }
 
-        auto [data, w, h, c] = result;
-        return load_and_preprocess(data, w, h, c);
+        auto tensor = to_float_chw(Tensor::from_blob(data,
+                                                     TensorShape({static_cast<size_t>(h), static_cast<size_t>(w), static_cast<size_t>(c)}),
+                                                     Device::CPU, DataType::UInt8));
+        free_image(data);
+        return tensor;
     }
 
     void CacheLoader::determine_cache_mode(const std::filesystem::path& path, const LoadParams& params) {
@@ -518,11 +441,15 @@ namespace lfs::io {
 
         load_counter_ = 0;
         const double total_gb = static_cast<double>(get_total_physical_memory()) / BYTES_PER_GB;
-        const double cache_pct = 100.0 * get_cpu_cache_size() / get_total_physical_memory();
-        const double jpeg_pct = 100.0 * get_jpeg_blob_cache_size() / get_total_physical_memory();
-
-        LOG_TRACE("Cache: {} images, {} JPEG blobs | {:.1f}GB total | cache {:.1f}% | JPEG {:.1f}%",
-                  cpu_cache_.size(), jpeg_blob_cache_.size(), total_gb, cache_pct, jpeg_pct);
+        const auto cpu_stats = cpu_cache_.stats();
+        const auto jpeg_stats = jpeg_blob_cache_.stats();
+        const double cache_pct = 100.0 * cpu_stats.bytes / get_total_physical_memory();
+        const double jpeg_pct = 100.0 * jpeg_stats.bytes / get_total_physical_memory();
+
+        LOG_TRACE("Cache: {} images, {} JPEG blobs | {:.1f}GB total | cache {:.1f}% | JPEG {:.1f}% | hits {} misses {} evictions {}",
+                  cpu_stats.entries, jpeg_stats.entries, total_gb, cache_pct, jpeg_pct,
+                  cpu_stats.hits + jpeg_stats.hits, cpu_stats.misses + jpeg_stats.misses,
+                  cpu_stats.evictions + jpeg_stats.evictions);
     }
 
     bool CacheLoader::is_jpeg_format(const std::filesystem::path& path) const {
@@ -531,21 +458,9 @@ namespace lfs::io {
         return ext == ".jpg" || ext == ".jpeg" || ext == ".jp2";
     }
 
-    std::size_t CacheLoader::get_jpeg_blob_cache_size() const {
-        std::size_t total = 0;
-        for (const auto& [key, data] : jpeg_blob_cache_) {
-            total += data.size_bytes;
-        }
-        return total;
-    }
-
     void CacheLoader::evict_jpeg_blobs_if_needed(std::size_t required_bytes) {
-        while (!jpeg_blob_cache_.empty() && !has_sufficient_memory(required_bytes)) {
-            auto oldest = std::min_element(jpeg_blob_cache_.begin(), jpeg_blob_cache_.end(),
-                                           [](const auto& a, const auto& b) { return a.second.last_access < b.second.last_access; });
-            if (oldest == jpeg_blob_cache_.end())
-                break;
-            jpeg_blob_cache_.erase(oldest);
+        if (const std::size_t deficit = memory_deficit(required_bytes); deficit > 0) {
+            jpeg_blob_cache_.evict_bytes(deficit);
         }
     }
 
@@ -597,13 +512,9 @@ namespace lfs::io {
         std::vector<uint8_t> jpeg_bytes;
         bool from_cache = false;
 
-        {
-            std::lock_guard lock(jpeg_blob_mutex_);
-            if (auto it = jpeg_blob_cache_.find(cache_key); it != jpeg_blob_cache_.end()) {
-                it->second.last_access = std::chrono::steady_clock::now();
-                jpeg_bytes = it->second.compressed_data;
-                from_cache = true;
-            }
+        if (auto blob = jpeg_blob_cache_.get(cache_key)) {
+            jpeg_bytes = (*blob)->compressed_data;
+            from_cache = true;
         }
 
         if (!from_cache) {
@@ -661,19 +572,17 @@ namespace lfs::io {
                     }
 
                     const std::size_t cache_size = cache_bytes.size();
-                    std::lock_guard lock(jpeg_blob_mutex_);
                     if (has_sufficient_memory(cache_size)) {
                         evict_jpeg_blobs_if_needed(cache_size);
-                        jpeg_blob_cache_[cache_key] = CachedJpegBlob{
-                            .compressed_data = std::move(cache_bytes),
-                            .size_bytes = cache_size,
-                            .last_access = std::chrono::steady_clock::now()};
-                        // Only remove from tracking set after successful caching
-                        jpeg_being_loaded_.erase(cache_key);
-                    } else {
-                        // Memory insufficient - remove from tracking to allow retry later
-                        jpeg_being_loaded_.erase(cache_key);
+                        jpeg_blob_cache_.put(cache_key,
+                                             std::make_shared<const CachedJpegBlob>(CachedJpegBlob{
+                                                 .compressed_data = std::move(cache_bytes),
+                                                 .size_bytes = cache_size}),
+                                             cache_size);
                     }
+                    // Insufficient memory leaves the key uncached so a later load can retry
+                    std::lock_guard lock(jpeg_blob_mutex_);
+                    jpeg_being_loaded_.erase(cache_key);
                 }
                 return tensor;
             } catch (const std::exception& e) {
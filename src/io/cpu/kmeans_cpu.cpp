@@ -0,0 +1,507 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "kmeans_cpu.hpp"
+#include "core/logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <tbb/blocked_range.h>
+#include <tbb/combinable.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace lfs::io {
+
+    using lfs::core::DataType;
+    using lfs::core::Device;
+
+    namespace {
+
+        constexpr int LANES = 8; // Centroids compared per vector step
+        constexpr int NUM_SUPER_CLUSTERS = 256;
+        constexpr int NUM_NEAREST_SUPERS = 4;
+        constexpr int HIERARCHICAL_MIN_K = 4096;
+        constexpr int SUPER_INIT_ITERATIONS = 5;
+        constexpr int KMEANS_PP_MAX_K = 1024;
+        constexpr size_t KMEANS_PP_SAMPLES_PER_CLUSTER = 16;
+        constexpr uint32_t SEED = 0x5eed1234u;
+        constexpr float PADDING = 1e18f; // Coordinate of unused lanes, never the nearest
+        constexpr size_t POINT_GRAIN = 2048;
+
+        Tensor to_host_f32(const Tensor& t) {
+            auto host = t.device() == Device::CPU ? t : t.cpu();
+            if (host.dtype() != DataType::Float32)
+                host = host.to(DataType::Float32);
+            return host.contiguous();
+        }
+
+        Tensor make_labels(const size_t n) {
+            return Tensor::zeros({n}, Device::CPU, DataType::Int32);
+        }
+
+        /**
+         * Centroids regrouped into blocks of LANES, dimension-major inside a block,
+         * so the distances from one point to LANES centroids are a single vector
+         * subtract/multiply/add per dimension.
+         */
+        class CentroidBlocks {
+        public:
+            // `ids` selects which rows of `centroids` to include; nullptr means all of them
+            void build(const float* const centroids, const int* const ids, const int count, const int dims) {
+                dims_ = dims;
+                const size_t num_blocks = (static_cast<size_t>(count) + LANES - 1) / LANES;
+                lanes_.assign(num_blocks * dims * LANES, PADDING);
+                ids_.assign(num_blocks * LANES, -1);
+                for (int i = 0; i < count; ++i) {
+                    const int id = ids ? ids[i] : i;
+                    const float* const c = centroids + static_cast<size_t>(id) * dims;
+                    float* const block = lanes_.data() + static_cast<size_t>(i / LANES) * dims * LANES;
+                    for (int d = 0; d < dims; ++d)
+                        block[d * LANES + i % LANES] = c[d];
+                    ids_[i] = id;
+                }
+            }
+
+            [[nodiscard]] size_t num_blocks() const { return ids_.size() / LANES; }
+            [[nodiscard]] int id(const size_t block, const int lane) const { return ids_[block * LANES + lane]; }
+
+            void block_distances(const float* const point, const size_t block_index, float* const dist) const {
+                const float* const block = lanes_.data() + block_index * dims_ * LANES;
+#if defined(__AVX2__)
+                __m256 acc = _mm256_setzero_ps();
+                for (int d = 0; d < dims_; ++d) {
+                    const __m256 diff = _mm256_sub_ps(_mm256_set1_ps(point[d]), _mm256_loadu_ps(block + d * LANES));
+                    acc = _mm256_add_ps(acc, _mm256_mul_ps(diff, diff));
+                }
+                _mm256_storeu_ps(dist, acc);
+#else
+                for (int l = 0; l < LANES; ++l)
+                    dist[l] = 0.0f;
+                for (int d = 0; d < dims_; ++d) {
+                    const float p = point[d];
+                    const float* const c = block + d * LANES;
+                    for (int l = 0; l < LANES; ++l) {
+                        const float diff = p - c[l];
+                        dist[l] += diff * diff;
+                    }
+                }
+#endif
+            }
+
+            void nearest(const float* const point, float& best_dist, int& best_id) const {
+                alignas(32) float dist[LANES];
+                for (size_t b = 0; b < num_blocks(); ++b) {
+                    block_distances(point, b, dist);
+                    for (int l = 0; l < LANES; ++l) {
+                        if (dist[l] < best_dist && id(b, l) >= 0) {
+                            best_dist = dist[l];
+                            best_id = id(b, l);
+                        }
+                    }
+                }
+            }
+
+        private:
+            int dims_ = 0;
+            std::vector<float> lanes_;
+            std::vector<int> ids_; // -1 marks padding lanes
+        };
+
+        void assign_bruteforce(const float* const data, const size_t n, const int dims,
+                               const CentroidBlocks& blocks, int* const labels) {
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, n, POINT_GRAIN),
+                              [&](const tbb::blocked_range<size_t>& range) {
+                                  for (size_t i = range.begin(); i < range.end(); ++i) {
+                                      float best_dist = std::numeric_limits<float>::max();
+                                      int best_id = 0;
+                                      blocks.nearest(data + i * dims, best_dist, best_id);
+                                      labels[i] = best_id;
+                                  }
+                              });
+        }
+
+        // Mean of each cluster; empty clusters are reseeded from a random point.
+        // Returns the largest squared centroid movement.
+        float update_centroids(const float* const data, const size_t n, const int dims,
+                               const int* const labels, float* const centroids, const int k,
+                               const uint32_t seed) {
+            std::vector<size_t> offsets(static_cast<size_t>(k) + 1, 0);
+            for (size_t i = 0; i < n; ++i)
+                ++offsets[labels[i] + 1];
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            std::vector<uint32_t> members(n);
+            {
+                std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < n; ++i)
+                    members[cursor[labels[i]]++] = static_cast<uint32_t>(i);
+            }
+
+            return tbb::parallel_reduce(
+                tbb::blocked_range<int>(0, k, 64), 0.0f,
+                [&](const tbb::blocked_range<int>& range, float max_shift) {
+                    std::vector<double> sum(dims);
+                    for (int c = range.begin(); c < range.end(); ++c) {
+                        float* const centroid = centroids + static_cast<size_t>(c) * dims;
+                        const size_t begin = offsets[c];
+                        const size_t end = offsets[c + 1];
+
+                        if (begin == end) {
+                            std::mt19937 gen(seed ^ (static_cast<uint32_t>(c) * 2654435761u));
+                            const float* const row = data + (gen() % n) * dims;
+                            std::copy(row, row + dims, centroid);
+                            max_shift = std::numeric_limits<float>::infinity();
+                            continue;
+                        }
+
+                        std::fill(sum.begin(), sum.end(), 0.0);
+                        for (size_t m = begin; m < end; ++m) {
+                            const float* const row = data + static_cast<size_t>(members[m]) * dims;
+                            for (int d = 0; d < dims; ++d)
+                                sum[d] += row[d];
+                        }
+
+                        const double inv_count = 1.0 / static_cast<double>(end - begin);
+                        float shift = 0.0f;
+                        for (int d = 0; d < dims; ++d) {
+                            const auto value = static_cast<float>(sum[d] * inv_count);
+                            shift += (value - centroid[d]) * (value - centroid[d]);
+                            centroid[d] = value;
+                        }
+                        max_shift = std::max(max_shift, shift);
+                    }
+                    return max_shift;
+                },
+                [](const float a, const float b) { return std::max(a, b); });
+        }
+
+        // First `count` entries of a random permutation of [0, n)
+        std::vector<uint32_t> random_subset(const size_t n, const size_t count, std::mt19937& gen) {
+            std::vector<uint32_t> perm(n);
+            std::iota(perm.begin(), perm.end(), 0u);
+            for (size_t i = 0; i < count; ++i) {
+                std::uniform_int_distribution<size_t> pick(i, n - 1);
+                std::swap(perm[i], perm[pick(gen)]);
+            }
+            perm.resize(count);
+            return perm;
+        }
+
+        // k-means++ over a sample of the data, or a random subset for large k
+        std::vector<float> seed_centroids(const float* const data, const size_t n, const int dims,
+                                          const int k, std::mt19937& gen) {
+            std::vector<float> centroids(static_cast<size_t>(k) * dims);
+
+            if (k > KMEANS_PP_MAX_K) {
+                const auto subset = random_subset(n, k, gen);
+                for (int c = 0; c < k; ++c)
+                    std::copy_n(data + static_cast<size_t>(subset[c]) * dims, dims, centroids.data() + static_cast<size_t>(c) * dims);
+                return centroids;
+            }
+
+            const size_t m = std::min(n, static_cast<size_t>(k) * KMEANS_PP_SAMPLES_PER_CLUSTER);
+            const auto sample = random_subset(n, m, gen);
+            std::vector<float> min_dist(m, std::numeric_limits<float>::max());
+
+            size_t chosen = 0;
+            for (int c = 0; c < k; ++c) {
+                const float* const row = data + static_cast<size_t>(sample[chosen]) * dims;
+                std::copy_n(row, dims, centroids.data() + static_cast<size_t>(c) * dims);
+                if (c + 1 == k)
+                    break;
+
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, m, POINT_GRAIN),
+                                  [&](const tbb::blocked_range<size_t>& range) {
+                                      for (size_t s = range.begin(); s < range.end(); ++s) {
+                                          const float* const p = data + static_cast<size_t>(sample[s]) * dims;
+                                          float dist = 0.0f;
+                                          for (int d = 0; d < dims; ++d)
+                                              dist += (p[d] - row[d]) * (p[d] - row[d]);
+                                          min_dist[s] = std::min(min_dist[s], dist);
+                                      }
+                                  });
+
+                const double total = std::accumulate(min_dist.begin(), min_dist.end(), 0.0);
+                if (total <= 0.0) {
+                    chosen = std::uniform_int_distribution<size_t>(0, m - 1)(gen);
+                    continue;
+                }
+                double target = std::uniform_real_distribution<double>(0.0, total)(gen);
+                chosen = m - 1;
+                for (size_t s = 0; s < m; ++s) {
+                    target -= min_dist[s];
+                    if (target <= 0.0) {
+                        chosen = s;
+                        break;
+                    }
+                }
+            }
+            return centroids;
+        }
+
+        /**
+         * Two-level search for large k: centroids are grouped under 256
+         * super-clusters and a point only scans the members of its 4 nearest
+         * super-clusters. Approximate, as on the GPU.
+         */
+        class SuperClusterIndex {
+        public:
+            void init(const float* const centroids, const int k, const int dims, std::mt19937& gen) {
+                dims_ = dims;
+                supers_.resize(static_cast<size_t>(NUM_SUPER_CLUSTERS) * dims);
+                const auto subset = random_subset(k, NUM_SUPER_CLUSTERS, gen);
+                for (int s = 0; s < NUM_SUPER_CLUSTERS; ++s)
+                    std::copy_n(centroids + static_cast<size_t>(subset[s]) * dims, dims, supers_.data() + static_cast<size_t>(s) * dims);
+                membership_.resize(k);
+                fit(centroids, k, SUPER_INIT_ITERATIONS);
+            }
+
+            // One refinement step after the centroids moved
+            void refine(const float* const centroids, const int k, const uint32_t seed) {
+                fit(centroids, k, 1, seed);
+            }
+
+            [[nodiscard]] int nearest(const float* const point) const {
+                alignas(32) float dist[LANES];
+                float best_dists[NUM_NEAREST_SUPERS];
+                int best_supers[NUM_NEAREST_SUPERS];
+                std::fill_n(best_dists, NUM_NEAREST_SUPERS, std::numeric_limits<float>::max());
+                std::fill_n(best_supers, NUM_NEAREST_SUPERS, -1);
+
+                for (size_t b = 0; b < super_blocks_.num_blocks(); ++b) {
+                    super_blocks_.block_distances(point, b, dist);
+                    for (int l = 0; l < LANES; ++l) {
+                        const int s = super_blocks_.id(b, l);
+                        if (s < 0 || dist[l] >= best_dists[NUM_NEAREST_SUPERS - 1])
+                            continue;
+                        int pos = NUM_NEAREST_SUPERS - 1;
+                        for (; pos > 0 && dist[l] < best_dists[pos - 1]; --pos) {
+                            best_dists[pos] = best_dists[pos - 1];
+                            best_supers[pos] = best_supers[pos - 1];
+                        }
+                        best_dists[pos] = dist[l];
+                        best_supers[pos] = s;
+                    }
+                }
+
+                float best_dist = std::numeric_limits<float>::max();
+                int best_id = 0;
+                for (const int s : best_supers) {
+                    if (s >= 0)
+                        members_[s].nearest(point, best_dist, best_id);
+                }
+                return best_id;
+            }
+
+        private:
+            void fit(const float* const centroids, const int k, const int iterations, const uint32_t seed = SEED) {
+                for (int iter = 0; iter < iterations; ++iter) {
+                    super_blocks_.build(supers_.data(), nullptr, NUM_SUPER_CLUSTERS, dims_);
+                    assign_bruteforce(centroids, k, dims_, super_blocks_, membership_.data());
+                    update_centroids(centroids, k, dims_, membership_.data(), supers_.data(), NUM_SUPER_CLUSTERS,
+                                     seed + static_cast<uint32_t>(iter));
+                }
+                super_blocks_.build(supers_.data(), nullptr, NUM_SUPER_CLUSTERS, dims_);
+                assign_bruteforce(centroids, k, dims_, super_blocks_, membership_.data());
+
+                std::vector<int> offsets(NUM_SUPER_CLUSTERS + 1, 0);
+                for (int c = 0; c < k; ++c)
+                    ++offsets[membership_[c] + 1];
+                std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+                std::vector<int> grouped(k);
+                {
+                    std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+                    for (int c = 0; c < k; ++c)
+                        grouped[cursor[membership_[c]]++] = c;
+                }
+
+                members_.resize(NUM_SUPER_CLUSTERS);
+                tbb::parallel_for(0, NUM_SUPER_CLUSTERS, [&](const int s) {
+                    members_[s].build(centroids, grouped.data() + offsets[s], offsets[s + 1] - offsets[s], dims_);
+                });
+            }
+
+            int dims_ = 0;
+            std::vector<float> supers_;
+            std::vector<int> membership_;
+            CentroidBlocks super_blocks_;
+            std::vector<CentroidBlocks> members_;
+        };
+
+    } // anonymous namespace
+
+    std::tuple<Tensor, Tensor> kmeans_cpu(
+        const Tensor& data,
+        int k,
+        int iterations,
+        float tolerance) {
+        if (!data.is_valid() || data.ndim() != 2) {
+            LOG_ERROR("kmeans_cpu expects 2D input [n_points, n_dims]");
+            return {Tensor(), Tensor()};
+        }
+        if (k <= 0) {
+            LOG_ERROR("kmeans_cpu: k must be positive, got {}", k);
+            return {Tensor(), Tensor()};
+        }
+
+        const int dims = static_cast<int>(data.shape()[1]);
+        if (dims == 1) {
+            return kmeans_1d_cpu(data, k, iterations);
+        }
+
+        const auto host = to_host_f32(data);
+        const float* const points = host.ptr<float>();
+        const size_t n = host.shape()[0];
+
+        auto labels = make_labels(n);
+        int* const labels_ptr = labels.ptr<int>();
+
+        if (n <= static_cast<size_t>(k)) {
+            std::iota(labels_ptr, labels_ptr + n, 0);
+            return {host.clone(), labels};
+        }
+
+        std::mt19937 gen(SEED);
+        auto centroids = seed_centroids(points, n, dims, k, gen);
+
+        const bool hierarchical = k >= HIERARCHICAL_MIN_K;
+        SuperClusterIndex supers;
+        CentroidBlocks blocks;
+        if (hierarchical) {
+            supers.init(centroids.data(), k, dims, gen);
+        }
+
+        const float tolerance_sq = tolerance * tolerance;
+        for (int iter = 0; iter < iterations; ++iter) {
+            if (hierarchical) {
+                if (iter > 0) {
+                    supers.refine(centroids.data(), k, SEED + static_cast<uint32_t>(iter));
+                }
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, n, POINT_GRAIN),
+                                  [&](const tbb::blocked_range<size_t>& range) {
+                                      for (size_t i = range.begin(); i < range.end(); ++i)
+                                          labels_ptr[i] = supers.nearest(points + i * dims);
+                                  });
+            } else {
+                blocks.build(centroids.data(), nullptr, k, dims);
+                assign_bruteforce(points, n, dims, blocks, labels_ptr);
+            }
+
+            const float shift = update_centroids(points, n, dims, labels_ptr, centroids.data(), k,
+                                                 SEED + static_cast<uint32_t>(iter) * 12345u);
+            if (shift <= tolerance_sq) {
+                LOG_DEBUG("kmeans_cpu converged after {} iterations", iter + 1);
+                break;
+            }
+        }
+
+        return {Tensor::from_vector(centroids, {static_cast<size_t>(k), static_cast<size_t>(dims)}, Device::CPU),
+                labels};
+    }
+
+    std::tuple<Tensor, Tensor> kmeans_1d_cpu(
+        const Tensor& data,
+        int k,
+        int iterations) {
+        if (!data.is_valid() || !(data.ndim() == 1 || (data.ndim() == 2 && data.shape()[1] == 1))) {
+            LOG_ERROR("kmeans_1d_cpu expects 1D data");
+            return {Tensor(), Tensor()};
+        }
+        if (k <= 0) {
+            LOG_ERROR("kmeans_1d_cpu: k must be positive, got {}", k);
+            return {Tensor(), Tensor()};
+        }
+
+        const auto host = to_host_f32(data);
+        const float* const values = host.ptr<float>();
+        const size_t n = host.shape()[0];
+
+        auto labels = make_labels(n);
+        int* const labels_ptr = labels.ptr<int>();
+        std::vector<float> centroids(k);
+
+        if (n <= static_cast<size_t>(k)) {
+            // Every value is its own centroid; the unused tail repeats the largest
+            std::vector<int> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return values[a] < values[b]; });
+            for (size_t r = 0; r < n; ++r) {
+                centroids[r] = values[order[r]];
+                labels_ptr[order[r]] = static_cast<int>(r);
+            }
+            std::fill(centroids.begin() + n, centroids.end(), n > 0 ? centroids[n - 1] : 0.0f);
+            return {Tensor::from_vector(centroids, {static_cast<size_t>(k), 1}, Device::CPU), labels};
+        }
+
+        const auto [min_it, max_it] = std::minmax_element(values, values + n);
+        const float step = (k > 1) ? (*max_it - *min_it) / (k - 1) : 0.0f;
+        for (int i = 0; i < k; ++i) {
+            centroids[i] = *min_it + i * step;
+        }
+
+        // Centroids are kept sorted, so the nearest is next to the insertion point
+        const auto assign = [&] {
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, n, POINT_GRAIN * 8),
+                              [&](const tbb::blocked_range<size_t>& range) {
+                                  for (size_t i = range.begin(); i < range.end(); ++i) {
+                                      const float v = values[i];
+                                      int lo = static_cast<int>(std::lower_bound(centroids.begin(), centroids.end(), v) - centroids.begin());
+                                      lo = std::min(lo, k - 1);
+                                      if (lo > 0 && std::abs(v - centroids[lo - 1]) < std::abs(v - centroids[lo]))
+                                          --lo;
+                                      labels_ptr[i] = lo;
+                                  }
+                              });
+        };
+
+        struct Accumulator {
+            std::vector<double> sums;
+            std::vector<int64_t> counts;
+        };
+
+        for (int iter = 0; iter < iterations; ++iter) {
+            assign();
+
+            tbb::combinable<Accumulator> partial([k] {
+                return Accumulator{std::vector<double>(k, 0.0), std::vector<int64_t>(k, 0)};
+            });
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, n, POINT_GRAIN * 8),
+                              [&](const tbb::blocked_range<size_t>& range) {
+                                  auto& acc = partial.local();
+                                  for (size_t i = range.begin(); i < range.end(); ++i) {
+                                      acc.sums[labels_ptr[i]] += values[i];
+                                      ++acc.counts[labels_ptr[i]];
+                                  }
+                              });
+
+            Accumulator total{std::vector<double>(k, 0.0), std::vector<int64_t>(k, 0)};
+            partial.combine_each([&](const Accumulator& acc) {
+                for (int c = 0; c < k; ++c) {
+                    total.sums[c] += acc.sums[c];
+                    total.counts[c] += acc.counts[c];
+                }
+            });
+
+            for (int c = 0; c < k; ++c) {
+                if (total.counts[c] > 0) {
+                    centroids[c] = static_cast<float>(total.sums[c] / static_cast<double>(total.counts[c]));
+                }
+            }
+            std::sort(centroids.begin(), centroids.end());
+        }
+
+        assign();
+        return {Tensor::from_vector(centroids, {static_cast<size_t>(k), 1}, Device::CPU), labels};
+    }
+
+} // namespace lfs::io
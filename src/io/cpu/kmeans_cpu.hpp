@@ -0,0 +1,50 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "core/tensor.hpp"
+#include <tuple>
+
+namespace lfs::io {
+
+    using lfs::core::Tensor;
+
+    /**
+     * @brief Multithreaded k-means on the host, same contract as kmeans()
+     *
+     * Seeds with k-means++ over a sample of the data for small k and with a
+     * random subset otherwise. For k >= 4096 each point only searches the
+     * centroids of its nearest super-clusters, like the GPU hierarchical path.
+     * Seeding is deterministic, so repeated exports produce identical files.
+     *
+     * @param data Input data [n_points, n_dims] (Float32, any device)
+     * @param k Number of clusters
+     * @param iterations Maximum iterations
+     * @param tolerance Stops early once no centroid moves more than this
+     * @return Tuple of (centroids [k, n_dims], labels Int32 [n_points]), both on CPU
+     */
+    std::tuple<Tensor, Tensor> kmeans_cpu(
+        const Tensor& data,
+        int k,
+        int iterations = 10,
+        float tolerance = 1e-4f);
+
+    /**
+     * @brief 1D k-means on the host using binary search for O(n log k) assignment
+     *
+     * Always returns k centroids; labels are the nearest of the returned
+     * centroids.
+     *
+     * @param data Input data [n_points] or [n_points, 1] (Float32, any device)
+     * @param k Number of clusters
+     * @param iterations Maximum iterations
+     * @return Tuple of (sorted centroids [k, 1], labels Int32 [n_points]), both on CPU
+     */
+    std::tuple<Tensor, Tensor> kmeans_1d_cpu(
+        const Tensor& data,
+        int k,
+        int iterations = 10);
+
+} // namespace lfs::io
@@ -0,0 +1,151 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "morton_encoding_cpu.hpp"
+#include "core/logger.hpp"
+#include "core/tensor/internal/cpu_sort.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+namespace lfs::io {
+
+    using lfs::core::DataType;
+    using lfs::core::Device;
+
+    namespace {
+
+        constexpr size_t ENCODE_GRAIN = 16384;
+
+        // Same bit spreading as the CUDA kernel (Part1By2 from splat-transform)
+        inline uint32_t part1_by_2(uint32_t x) {
+            x &= 0x000003ff;
+            x = (x ^ (x << 16)) & 0xff0000ff;
+            x = (x ^ (x << 8)) & 0x0300f00f;
+            x = (x ^ (x << 4)) & 0x030c30c3;
+            x = (x ^ (x << 2)) & 0x09249249;
+            return x;
+        }
+
+        inline uint32_t encode_morton3(const uint32_t x, const uint32_t y, const uint32_t z) {
+            return (part1_by_2(z) << 2) + (part1_by_2(y) << 1) + part1_by_2(x);
+        }
+
+        struct Bounds {
+            std::array<float, 3> min{std::numeric_limits<float>::infinity(),
+                                     std::numeric_limits<float>::infinity(),
+                                     std::numeric_limits<float>::infinity()};
+            std::array<float, 3> max{-std::numeric_limits<float>::infinity(),
+                                     -std::numeric_limits<float>::infinity(),
+                                     -std::numeric_limits<float>::infinity()};
+
+            void merge(const Bounds& other) {
+                for (int d = 0; d < 3; ++d) {
+                    min[d] = std::min(min[d], other.min[d]);
+                    max[d] = std::max(max[d], other.max[d]);
+                }
+            }
+        };
+
+    } // anonymous namespace
+
+    Tensor morton_encode_cpu(const Tensor& positions) {
+        if (!positions.is_valid()) {
+            LOG_ERROR("morton_encode_cpu: Invalid input tensor");
+            return Tensor();
+        }
+
+        if (positions.ndim() != 2 || positions.size(1) != 3) {
+            LOG_ERROR("morton_encode_cpu: Positions must have shape [N, 3], got {}", positions.shape().str());
+            return Tensor();
+        }
+
+        if (positions.dtype() != DataType::Float32) {
+            LOG_ERROR("morton_encode_cpu: Positions must be Float32");
+            return Tensor();
+        }
+
+        if (positions.device() != Device::CPU) {
+            LOG_ERROR("morton_encode_cpu: Positions must be on CPU");
+            return Tensor();
+        }
+
+        const auto host = positions.contiguous();
+        const float* const pos = host.ptr<float>();
+        const size_t n = host.size(0);
+
+        const Bounds bbox = tbb::parallel_reduce(
+            tbb::blocked_range<size_t>(0, n, ENCODE_GRAIN), Bounds{},
+            [&](const tbb::blocked_range<size_t>& range, Bounds local) {
+                for (size_t i = range.begin(); i < range.end(); ++i) {
+                    for (int d = 0; d < 3; ++d) {
+                        local.min[d] = std::min(local.min[d], pos[i * 3 + d]);
+                        local.max[d] = std::max(local.max[d], pos[i * 3 + d]);
+                    }
+                }
+                return local;
+            },
+            [](Bounds a, const Bounds& b) {
+                a.merge(b);
+                return a;
+            });
+
+        std::array<float, 3> mul{};
+        for (int d = 0; d < 3; ++d) {
+            const float len = bbox.max[d] - bbox.min[d];
+            mul[d] = (len == 0.0f) ? 0.0f : 1024.0f / len;
+        }
+
+        auto morton_codes = Tensor::empty({n}, Device::CPU, DataType::Int64);
+        int64_t* const codes = morton_codes.ptr<int64_t>();
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n, ENCODE_GRAIN),
+                          [&](const tbb::blocked_range<size_t>& range) {
+                              for (size_t i = range.begin(); i < range.end(); ++i) {
+                                  // Normalize to [0, 1023] range per-axis, as the CUDA kernel does
+                                  const uint32_t ix = std::min(1023u, static_cast<uint32_t>((pos[i * 3 + 0] - bbox.min[0]) * mul[0]));
+                                  const uint32_t iy = std::min(1023u, static_cast<uint32_t>((pos[i * 3 + 1] - bbox.min[1]) * mul[1]));
+                                  const uint32_t iz = std::min(1023u, static_cast<uint32_t>((pos[i * 3 + 2] - bbox.min[2]) * mul[2]));
+                                  codes[i] = static_cast<int64_t>(encode_morton3(ix, iy, iz));
+                              }
+                          });
+
+        return morton_codes;
+    }
+
+    Tensor morton_sort_indices_cpu(const Tensor& morton_codes) {
+        if (!morton_codes.is_valid()) {
+            LOG_ERROR("morton_sort_indices_cpu: Invalid input tensor");
+            return Tensor();
+        }
+
+        if (morton_codes.ndim() != 1) {
+            LOG_ERROR("morton_sort_indices_cpu: Morton codes must be 1D tensor");
+            return Tensor();
+        }
+
+        if (morton_codes.dtype() != DataType::Int64) {
+            LOG_ERROR("morton_sort_indices_cpu: Morton codes must be Int64");
+            return Tensor();
+        }
+
+        if (morton_codes.device() != Device::CPU) {
+            LOG_ERROR("morton_sort_indices_cpu: Morton codes must be on CPU");
+            return Tensor();
+        }
+
+        // Codes are non-negative, so the shared signed radix sort orders them as unsigned
+        const auto host = morton_codes.contiguous();
+        const size_t n = host.numel();
+        auto indices = Tensor::empty({n}, Device::CPU, DataType::Int64);
+        lfs::core::cpu_sort::sort_rows(host.ptr<int64_t>(), 1, n, /*descending=*/false, nullptr,
+                                       indices.ptr<int64_t>());
+        return indices;
+    }
+
+} // namespace lfs::io
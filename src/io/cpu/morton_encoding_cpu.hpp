@@ -0,0 +1,36 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "core/tensor.hpp"
+
+namespace lfs::io {
+
+    using lfs::core::Tensor;
+
+    /**
+     * @brief Host version of morton_encode()
+     *
+     * Uses the same bounding box quantization (10 bits per axis) as the CUDA
+     * kernel, so both paths produce identical codes for the same positions.
+     *
+     * @param positions Tensor of shape [N, 3] containing 3D positions (Float32, CPU)
+     * @return Tensor of shape [N] containing Morton codes as Int64 (CPU)
+     */
+    Tensor morton_encode_cpu(const Tensor& positions);
+
+    /**
+     * @brief Stable argsort of Morton codes with the shared CPU radix sort
+     *
+     * cpu_sort::sort_rows skips digits all codes share, so 30-bit codes take
+     * four 8-bit passes. Equal codes keep their input order, which matches the
+     * order thrust::sort_by_key produces on the GPU.
+     *
+     * @param morton_codes Non-negative Morton codes (Int64, CPU)
+     * @return Tensor of indices that would sort the Morton codes (Int64, CPU)
+     */
+    Tensor morton_sort_indices_cpu(const Tensor& morton_codes);
+
+} // namespace lfs::io
@@ -0,0 +1,346 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "dataset_index.hpp"
+#include "core/image_io.hpp"
+#include "core/logger.hpp"
+#include "core/path_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace lfs::io {
+
+    namespace fs = std::filesystem;
+
+    namespace {
+
+        constexpr std::array MASK_FOLDERS = {"masks", "mask", "segmentation"};
+        constexpr std::array MASK_EXTENSIONS = {".png", ".jpg", ".jpeg", ".PNG", ".JPG", ".JPEG", ".mask.png"};
+        constexpr int INDEX_VERSION = 1;
+
+        constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+        constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+        uint64_t fnv1a(const std::string_view data) {
+            uint64_t hash = FNV_OFFSET;
+            for (const char c : data) {
+                hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+            }
+            return hash;
+        }
+
+        std::string generic_utf8(const fs::path& path) {
+            const auto u8 = path.lexically_normal().generic_u8string();
+            return {u8.begin(), u8.end()};
+        }
+
+        // Lookup key for a path relative to a listed folder; matches what exists() would find.
+        // Only ASCII is folded, which covers the extension variants exists() used to hide.
+        std::string listing_key(const fs::path& relative, const bool fold_case) {
+            std::string key = generic_utf8(relative);
+            if (fold_case) {
+                std::transform(key.begin(), key.end(), key.begin(),
+                               [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            }
+            return key;
+        }
+
+        // Default NTFS and APFS volumes ignore case, but either may be configured not to,
+        // so ask the filesystem: the upper-cased folder name resolves to the folder itself
+        bool is_case_insensitive(const fs::path& dir) {
+            std::string name = generic_utf8(dir.filename());
+            std::transform(name.begin(), name.end(), name.begin(),
+                           [](const unsigned char c) { return static_cast<char>(std::toupper(c)); });
+            std::error_code ec;
+            const auto upper = dir.parent_path() / lfs::core::utf8_to_path(name);
+            return upper != dir && fs::equivalent(upper, dir, ec) && !ec;
+        }
+
+        struct MaskFolder {
+            fs::path dir;
+            bool fold_case = false;
+            std::unordered_set<std::string> files;
+
+            bool contains(const fs::path& relative) const {
+                return files.contains(listing_key(relative, fold_case));
+            }
+        };
+
+        // One directory walk per mask folder instead of up to 15 exists() probes per image
+        std::vector<MaskFolder> list_mask_folders(const fs::path& base_path) {
+            std::vector<MaskFolder> folders;
+            for (const auto* const name : MASK_FOLDERS) {
+                std::error_code ec;
+                MaskFolder folder{base_path / name, false, {}};
+                if (!fs::is_directory(folder.dir, ec)) {
+                    continue;
+                }
+                folder.fold_case = is_case_insensitive(folder.dir);
+                for (fs::recursive_directory_iterator it(folder.dir, fs::directory_options::skip_permission_denied, ec), end;
+                     !ec && it != end; it.increment(ec)) {
+                    if (it->is_regular_file(ec)) {
+                        folder.files.insert(listing_key(it->path().lexically_relative(folder.dir), folder.fold_case));
+                    }
+                }
+                if (ec) {
+                    LOG_WARN("Failed to list mask folder {}: {}", lfs::core::path_to_utf8(folder.dir), ec.message());
+                }
+                folders.push_back(std::move(folder));
+            }
+            return folders;
+        }
+
+        // Priority: exact match, stem+ext (e.g., img.png), full+ext (e.g., img.jpg.png)
+        fs::path find_mask_path(const std::vector<MaskFolder>& folders, const std::string& image_name) {
+            const fs::path img_path = lfs::core::utf8_to_path(image_name);
+            const fs::path stem_path = img_path.parent_path() / img_path.stem();
+
+            for (const auto& folder : folders) {
+                if (folder.contains(img_path)) {
+                    return folder.dir / img_path;
+                }
+                for (const auto* const ext : MASK_EXTENSIONS) {
+                    auto candidate = stem_path;
+                    candidate += ext;
+                    if (folder.contains(candidate)) {
+                        return folder.dir / candidate;
+                    }
+                }
+                for (const auto* const ext : MASK_EXTENSIONS) {
+                    auto candidate = img_path;
+                    candidate += ext;
+                    if (folder.contains(candidate)) {
+                        return folder.dir / candidate;
+                    }
+                }
+            }
+            return {};
+        }
+
+        struct FileStamp {
+            uintmax_t size = 0;
+            int64_t mtime = 0;
+
+            bool operator==(const FileStamp&) const = default;
+        };
+
+        std::optional<FileStamp> stamp(const fs::path& path) {
+            std::error_code ec;
+            const auto size = fs::file_size(path, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            const auto mtime = fs::last_write_time(path, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            return FileStamp{size, static_cast<int64_t>(mtime.time_since_epoch().count())};
+        }
+
+        struct CachedProbe {
+            std::string mask; // Relative to the dataset root
+            FileStamp image;
+            FileStamp mask_file;
+            int width = 0, height = 0, mask_width = 0, mask_height = 0;
+        };
+
+        std::unordered_map<std::string, CachedProbe> read_sidecar(const fs::path& path) {
+            std::unordered_map<std::string, CachedProbe> cache;
+            std::ifstream file;
+            if (!lfs::core::open_file_for_read(path, file)) {
+                return cache;
+            }
+            try {
+                const auto json = nlohmann::json::parse(file);
+                if (json.value("version", 0) != INDEX_VERSION) {
+                    return cache;
+                }
+                for (const auto& [name, e] : json.at("images").items()) {
+                    cache.emplace(name, CachedProbe{
+                                            .mask = e.at("mask").get<std::string>(),
+                                            .image = {e.at("image_size").get<uintmax_t>(), e.at("image_mtime").get<int64_t>()},
+                                            .mask_file = {e.at("mask_size").get<uintmax_t>(), e.at("mask_mtime").get<int64_t>()},
+                                            .width = e.at("width").get<int>(),
+                                            .height = e.at("height").get<int>(),
+                                            .mask_width = e.at("mask_width").get<int>(),
+                                            .mask_height = e.at("mask_height").get<int>()});
+                }
+            } catch (const std::exception& e) {
+                LOG_DEBUG("Ignoring dataset index {}: {}", lfs::core::path_to_utf8(path), e.what());
+                cache.clear();
+            }
+            return cache;
+        }
+
+        void write_sidecar(const fs::path& path, const std::unordered_map<std::string, CachedProbe>& cache) {
+            nlohmann::json images = nlohmann::json::object();
+            for (const auto& [name, probe] : cache) {
+                images[name] = {{"mask", probe.mask},
+                                {"image_size", probe.image.size},
+                                {"image_mtime", probe.image.mtime},
+                                {"mask_size", probe.mask_file.size},
+                                {"mask_mtime", probe.mask_file.mtime},
+                                {"width", probe.width},
+                                {"height", probe.height},
+                                {"mask_width", probe.mask_width},
+                                {"mask_height", probe.mask_height}};
+            }
+            const nlohmann::json json = {{"version", INDEX_VERSION}, {"images", std::move(images)}};
+
+            // The index is only an accelerator, so failing to write it is not an error
+            std::error_code ec;
+            fs::create_directories(path.parent_path(), ec);
+            auto temp_path = path;
+            temp_path += ".tmp";
+            {
+                std::ofstream file;
+                if (!lfs::core::open_file_for_write(temp_path, file)) {
+                    LOG_DEBUG("Dataset index not written, {} is not writable", lfs::core::path_to_utf8(temp_path));
+                    return;
+                }
+                file << json.dump();
+                if (!file) {
+                    file.close();
+                    fs::remove(temp_path, ec);
+                    return;
+                }
+            }
+            fs::rename(temp_path, path, ec);
+            if (ec) {
+                LOG_DEBUG("Dataset index not written: {}", ec.message());
+                fs::remove(temp_path, ec);
+            }
+        }
+
+    } // namespace
+
+    fs::path dataset_index_path(const fs::path& base_path, const DatasetIndexOptions& options) {
+        std::error_code ec;
+        const auto absolute = fs::absolute(base_path, ec);
+        const std::string root = generic_utf8(ec ? base_path : absolute);
+        const fs::path dir = options.index_dir.empty() ? lfs::core::lichtfeld_temp_folder() / "dataset_index"
+                                                       : options.index_dir;
+        return dir / std::format("{:016x}.json", fnv1a(root));
+    }
+
+    Result<std::vector<IndexedImage>> index_dataset_images(
+        const fs::path& base_path,
+        const std::span<const DatasetImage> images,
+        const DatasetIndexOptions& options) {
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto folders = list_mask_folders(base_path);
+
+        std::vector<IndexedImage> result(images.size());
+        if (folders.empty()) {
+            return result;
+        }
+
+        const fs::path sidecar_path = dataset_index_path(base_path, options);
+        const auto cache = options.use_sidecar ? read_sidecar(sidecar_path)
+                                               : std::unordered_map<std::string, CachedProbe>{};
+
+        // Per image: nullopt when no mask, otherwise the probe to store in the index
+        std::vector<std::optional<CachedProbe>> probes(images.size());
+        std::vector<std::exception_ptr> failures(images.size());
+        std::atomic<size_t> cache_hits{0};
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, images.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                const auto& image = images[i];
+                auto& entry = result[i];
+                entry.mask_path = find_mask_path(folders, image.name);
+                if (entry.mask_path.empty()) {
+                    continue;
+                }
+
+                try {
+                    CachedProbe probe;
+                    probe.mask = generic_utf8(entry.mask_path.lexically_relative(base_path));
+                    const auto image_stamp = stamp(image.path);
+                    const auto mask_stamp = stamp(entry.mask_path);
+                    probe.image = image_stamp.value_or(FileStamp{});
+                    probe.mask_file = mask_stamp.value_or(FileStamp{});
+
+                    const auto cached = cache.find(image.name);
+                    if (image_stamp && mask_stamp && cached != cache.end() && cached->second.mask == probe.mask &&
+                        cached->second.image == probe.image && cached->second.mask_file == probe.mask_file) {
+                        probe = cached->second;
+                        cache_hits.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::tie(probe.width, probe.height, std::ignore) = lfs::core::get_image_info(image.path);
+                        std::tie(probe.mask_width, probe.mask_height, std::ignore) = lfs::core::get_image_info(entry.mask_path);
+                    }
+
+                    entry.width = probe.width;
+                    entry.height = probe.height;
+                    entry.mask_width = probe.mask_width;
+                    entry.mask_height = probe.mask_height;
+                    probes[i] = std::move(probe);
+                } catch (...) {
+                    failures[i] = std::current_exception();
+                }
+            }
+        });
+
+        // Report the first problem in dataset order, as the serial loop did
+        size_t masked = 0;
+        for (size_t i = 0; i < images.size(); ++i) {
+            if (failures[i]) {
+                try {
+                    std::rethrow_exception(failures[i]);
+                } catch (const std::exception& e) {
+                    return make_error(ErrorCode::READ_FAILURE, e.what(), result[i].mask_path);
+                }
+            }
+            const auto& entry = result[i];
+            if (entry.mask_path.empty()) {
+                continue;
+            }
+            ++masked;
+            if (entry.width != entry.mask_width || entry.height != entry.mask_height) {
+                return make_error(ErrorCode::MASK_SIZE_MISMATCH,
+                                  std::format("Mask '{}' is {}x{} but image '{}' is {}x{}",
+                                              lfs::core::path_to_utf8(entry.mask_path.filename()),
+                                              entry.mask_width, entry.mask_height,
+                                              images[i].name, entry.width, entry.height),
+                                  entry.mask_path);
+            }
+        }
+
+        const size_t hits = cache_hits.load();
+        if (options.use_sidecar && (hits != masked || cache.size() != masked)) {
+            std::unordered_map<std::string, CachedProbe> updated;
+            updated.reserve(masked);
+            for (size_t i = 0; i < images.size(); ++i) {
+                if (probes[i]) {
+                    updated.emplace(images[i].name, std::move(*probes[i]));
+                }
+            }
+            write_sidecar(sidecar_path, updated);
+        }
+
+        LOG_PERF("Dataset index: {} images, {} masks ({} cached) in {:.1f} ms",
+                 images.size(), masked, hits,
+                 std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        return result;
+    }
+
+} // namespace lfs::io
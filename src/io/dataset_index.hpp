@@ -0,0 +1,58 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "io/error.hpp"
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace lfs::io {
+
+    struct DatasetImage {
+        std::string name;           // As listed by the dataset (UTF-8, may contain subfolders)
+        std::filesystem::path path; // Full path of the image file
+    };
+
+    struct IndexedImage {
+        std::filesystem::path mask_path; // Empty when the image has no mask
+        int width = 0;                   // Image and mask header sizes, only probed for masked images
+        int height = 0;
+        int mask_width = 0;
+        int mask_height = 0;
+    };
+
+    struct DatasetIndexOptions {
+        bool use_sidecar = true;       // Read and refresh the index file of the dataset
+        std::filesystem::path index_dir; // Empty uses the LichtFeld temp folder; datasets are never written to
+    };
+
+    /// Index file of a dataset, named after a hash of its absolute root so warm reloads skip the header probes
+    std::filesystem::path dataset_index_path(const std::filesystem::path& base_path,
+                                             const DatasetIndexOptions& options = {});
+
+    /**
+     * @brief Finds masks and validates their size for every image of a dataset
+     *
+     * Each mask folder ("masks", "mask", "segmentation") is listed once into a
+     * hash set instead of probing candidate names with exists(), and image/mask
+     * headers are read concurrently. Names are compared case-insensitively when
+     * the mask folder lives on a case-insensitive filesystem, as exists() did.
+     * Header sizes are cached in dataset_index_path(), keyed by image name and
+     * invalidated by file size and mtime.
+     *
+     * Mask priority per folder is unchanged: exact name, stem + extension
+     * (img.png), full name + extension (img.jpg.png).
+     *
+     * @return One entry per image, in input order; MASK_SIZE_MISMATCH for the
+     *         first image (by index) whose mask differs in size
+     */
+    Result<std::vector<IndexedImage>> index_dataset_images(
+        const std::filesystem::path& base_path,
+        std::span<const DatasetImage> images,
+        const DatasetIndexOptions& options = {});
+
+} // namespace lfs::io
@@ -0,0 +1,446 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "io/decoded_image_pack.hpp"
+#include "core/logger.hpp"
+#include "core/mapped_file.hpp"
+#include "core/path_utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <type_traits>
+#include <vector>
+
+namespace lfs::io {
+
+    namespace {
+        constexpr std::array<char, 8> PACK_MAGIC = {'L', 'F', 'S', 'D', 'P', 'A', 'K', '\0'};
+        constexpr std::array<char, 8> INDEX_MAGIC = {'L', 'F', 'S', 'D', 'I', 'D', 'X', '\0'};
+        constexpr uint32_t FORMAT_VERSION = 1;
+        constexpr uint64_t PACK_HEADER_SIZE = DECODED_PACK_ALIGNMENT;
+
+        struct FileHeader {
+            std::array<char, 8> magic;
+            uint32_t version;
+            uint32_t reserved;
+        };
+        static_assert(sizeof(FileHeader) == 16);
+
+        // Followed by key_length bytes of key. The checksum covers everything after itself.
+        struct IndexRecord {
+            uint32_t key_length;
+            uint32_t checksum;
+            int64_t mtime;
+            uint64_t source_size;
+            uint64_t offset;
+            int32_t width;
+            int32_t height;
+            int32_t channels;
+            int32_t reserved;
+        };
+        static_assert(sizeof(IndexRecord) == 48);
+        static_assert(std::is_trivially_copyable_v<IndexRecord>);
+
+        constexpr uint64_t align_up(uint64_t value, uint64_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+        constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+        uint64_t fnv1a(const void* data, size_t size, uint64_t hash = FNV_OFFSET) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * FNV_PRIME;
+            }
+            return hash;
+        }
+
+        uint32_t record_checksum(const IndexRecord& record, std::string_view key) {
+            constexpr size_t SKIP = offsetof(IndexRecord, mtime);
+            const uint64_t hash = fnv1a(reinterpret_cast<const char*>(&record) + SKIP, sizeof(IndexRecord) - SKIP,
+                                        fnv1a(key.data(), key.size()));
+            return static_cast<uint32_t>(hash ^ (hash >> 32));
+        }
+
+        std::string normalized_utf8(const std::filesystem::path& path) {
+            std::error_code ec;
+            auto absolute = std::filesystem::absolute(path, ec);
+            return lfs::core::path_to_utf8(ec ? path.lexically_normal() : absolute.lexically_normal());
+        }
+
+        // Replaces the file rather than truncating it: views may still map the old
+        // pages, and touching a truncated mapping raises SIGBUS
+        bool write_header(const std::filesystem::path& path, const std::array<char, 8>& magic, uint64_t total_size) {
+            auto temp_path = path;
+            temp_path += ".tmp";
+            std::error_code ec;
+            {
+                std::ofstream out;
+                if (!lfs::core::open_file_for_write(temp_path, std::ios::binary | std::ios::trunc, out)) {
+                    return false;
+                }
+                const FileHeader header{magic, FORMAT_VERSION, 0};
+                out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                const std::vector<char> padding(total_size - sizeof(header), 0);
+                out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+                if (!out.good()) {
+                    out.close();
+                    std::filesystem::remove(temp_path, ec);
+                    return false;
+                }
+            }
+            std::filesystem::rename(temp_path, path, ec);
+            if (ec) {
+                LOG_ERROR("Failed to replace {}: {}", lfs::core::path_to_utf8(path), ec.message());
+                std::filesystem::remove(temp_path, ec);
+                return false;
+            }
+            return true;
+        }
+
+        bool has_header(const std::filesystem::path& path, const std::array<char, 8>& magic) {
+            std::ifstream in;
+            if (!lfs::core::open_file_for_read(path, std::ios::binary, in)) {
+                return false;
+            }
+            FileHeader header{};
+            in.read(reinterpret_cast<char*>(&header), sizeof(header));
+            return in.good() && header.magic == magic && header.version == FORMAT_VERSION;
+        }
+    } // namespace
+
+    DecodedImagePack::DecodedImagePack(std::filesystem::path directory, std::string name, const std::size_t max_bytes)
+        : pack_path_(directory / (name + ".pack")),
+          index_path_(directory / (name + ".idx")),
+          max_bytes_(max_bytes) {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec) {
+            LOG_ERROR("Failed to create decoded image cache directory {}: {}",
+                      lfs::core::path_to_utf8(directory), ec.message());
+            return;
+        }
+
+        std::lock_guard lock(mutex_);
+        if (!load_index() && !reset_files()) {
+            LOG_ERROR("Failed to initialize decoded image pack: {}", lfs::core::path_to_utf8(pack_path_));
+            return;
+        }
+        open_ = open_files();
+        if (open_) {
+            // The index mtime orders packs for evict()
+            std::filesystem::last_write_time(index_path_, std::filesystem::file_time_type::clock::now(), ec);
+            LOG_DEBUG("Decoded image pack {}: {} images, {:.1f} MB",
+                      lfs::core::path_to_utf8(pack_path_), entries_.size(), live_bytes_ / (1024.0 * 1024.0));
+        }
+    }
+
+    DecodedImagePack::~DecodedImagePack() {
+        std::lock_guard lock(mutex_);
+        close_streams();
+    }
+
+    std::string DecodedImagePack::name_for(const std::filesystem::path& image_dir) {
+        const std::string dir = normalized_utf8(image_dir);
+        return std::format("{:016x}", fnv1a(dir.data(), dir.size()));
+    }
+
+    std::size_t DecodedImagePack::evict(const std::filesystem::path& directory, const std::size_t max_bytes,
+                                        const std::set<std::string>& in_use) {
+        struct Candidate {
+            std::string name;
+            std::filesystem::file_time_type used;
+            std::size_t bytes = 0;
+        };
+        std::vector<Candidate> candidates;
+        std::size_t total = 0;
+
+        std::error_code ec;
+        for (const auto& file : std::filesystem::directory_iterator(directory, ec)) {
+            if (file.path().extension() != ".pack") {
+                continue;
+            }
+            const auto index = std::filesystem::path(file.path()).replace_extension(".idx");
+            std::error_code size_ec;
+            const std::size_t bytes = file.file_size(size_ec) + std::filesystem::file_size(index, size_ec);
+            total += bytes;
+            std::string name = lfs::core::path_to_utf8(file.path().stem());
+            if (in_use.contains(name)) {
+                continue;
+            }
+            const auto used = std::filesystem::last_write_time(index, size_ec);
+            candidates.push_back({std::move(name), size_ec ? std::filesystem::file_time_type::min() : used, bytes});
+        }
+
+        std::ranges::sort(candidates, {}, &Candidate::used);
+        for (const auto& candidate : candidates) {
+            if (total <= max_bytes) {
+                break;
+            }
+            std::error_code remove_ec;
+            std::filesystem::remove(directory / (candidate.name + ".pack"), remove_ec);
+            std::filesystem::remove(directory / (candidate.name + ".idx"), remove_ec);
+            if (remove_ec) {
+                LOG_WARN("Failed to evict decoded image pack {}: {}", candidate.name, remove_ec.message());
+                continue;
+            }
+            LOG_DEBUG("Evicted decoded image pack {} ({:.1f} MB)", candidate.name, candidate.bytes / (1024.0 * 1024.0));
+            total -= candidate.bytes;
+        }
+        return total;
+    }
+
+    std::optional<DecodedImagePack::SourceStamp> DecodedImagePack::stamp_source(const std::filesystem::path& source) {
+        std::error_code ec;
+        const auto mtime = std::filesystem::last_write_time(source, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        const auto size = std::filesystem::file_size(source, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        return SourceStamp{static_cast<int64_t>(mtime.time_since_epoch().count()), static_cast<uint64_t>(size)};
+    }
+
+    std::string DecodedImagePack::make_key(const std::filesystem::path& source, int resize_factor, int max_width) {
+        return std::format("{}:rf{}_mw{}", normalized_utf8(source), resize_factor, max_width);
+    }
+
+    bool DecodedImagePack::load_index() {
+        if (!has_header(pack_path_, PACK_MAGIC)) {
+            return false;
+        }
+
+        std::ifstream in;
+        if (!lfs::core::open_file_for_read(index_path_, std::ios::binary | std::ios::ate, in)) {
+            return false;
+        }
+        const auto index_size = static_cast<size_t>(in.tellg());
+        std::vector<char> buffer(index_size);
+        in.seekg(0);
+        if (index_size < sizeof(FileHeader) || !in.read(buffer.data(), static_cast<std::streamsize>(index_size))) {
+            return false;
+        }
+        in.close();
+        FileHeader header;
+        std::memcpy(&header, buffer.data(), sizeof(header));
+        if (header.magic != INDEX_MAGIC || header.version != FORMAT_VERSION) {
+            return false;
+        }
+
+        std::error_code ec;
+        const uint64_t pack_size = std::filesystem::file_size(pack_path_, ec);
+        if (ec) {
+            return false;
+        }
+
+        entries_.clear();
+        size_t pos = sizeof(FileHeader);
+        while (pos + sizeof(IndexRecord) <= index_size) {
+            IndexRecord record;
+            std::memcpy(&record, buffer.data() + pos, sizeof(record));
+            const size_t record_end = pos + sizeof(IndexRecord) + record.key_length;
+            if (record_end > index_size) {
+                break;
+            }
+            const std::string_view key(buffer.data() + pos + sizeof(IndexRecord), record.key_length);
+            if (record.checksum != record_checksum(record, key)) {
+                break;
+            }
+
+            const Entry entry{{record.mtime, record.source_size}, record.offset,
+                              record.width, record.height, record.channels};
+            // Pixels are written first, so a record past the end of the pack means it was truncated
+            if (entry.offset < PACK_HEADER_SIZE || entry.offset + entry.bytes() > pack_size) {
+                break;
+            }
+            entries_.insert_or_assign(std::string(key), entry);
+            pos = record_end;
+        }
+
+        if (pos < index_size) {
+            LOG_WARN("Decoded image index {} has a damaged tail, dropping {} bytes",
+                     lfs::core::path_to_utf8(index_path_), index_size - pos);
+            std::filesystem::resize_file(index_path_, pos, ec);
+            if (ec) {
+                return false;
+            }
+        }
+
+        live_bytes_ = 0;
+        for (const auto& [key, entry] : entries_) {
+            live_bytes_ += entry.bytes();
+        }
+        pack_end_ = pack_size;
+
+        const uint64_t dead_bytes = pack_end_ - PACK_HEADER_SIZE - live_bytes_;
+        if (dead_bytes > live_bytes_ && dead_bytes > DECODED_PACK_MIN_COMPACT_BYTES) {
+            LOG_INFO("Decoded image pack {} is mostly stale ({:.1f} MB dead), resetting",
+                     lfs::core::path_to_utf8(pack_path_), dead_bytes / (1024.0 * 1024.0));
+            return false;
+        }
+        return true;
+    }
+
+    bool DecodedImagePack::reset_files() {
+        close_streams();
+        mapping_.reset();
+        entries_.clear();
+        live_bytes_ = 0;
+        pack_end_ = PACK_HEADER_SIZE;
+        return write_header(pack_path_, PACK_MAGIC, PACK_HEADER_SIZE) &&
+               write_header(index_path_, INDEX_MAGIC, sizeof(FileHeader));
+    }
+
+    bool DecodedImagePack::open_files() {
+        constexpr auto mode = std::ios::binary | std::ios::app;
+        if (!lfs::core::open_file_for_write(pack_path_, mode, pack_out_) ||
+            !lfs::core::open_file_for_write(index_path_, mode, index_out_)) {
+            LOG_ERROR("Failed to open decoded image pack for writing: {}", lfs::core::path_to_utf8(pack_path_));
+            close_streams();
+            return false;
+        }
+        return true;
+    }
+
+    void DecodedImagePack::close_streams() {
+        if (pack_out_.is_open())
+            pack_out_.close();
+        if (index_out_.is_open())
+            index_out_.close();
+    }
+
+    std::optional<DecodedImageView> DecodedImagePack::find(const std::filesystem::path& source,
+                                                           int resize_factor, int max_width) {
+        const std::string key = make_key(source, resize_factor, max_width);
+        const auto stamp = stamp_source(source);
+
+        std::lock_guard lock(mutex_);
+        const auto it = entries_.find(key);
+        if (it == entries_.end() || !stamp) {
+            ++misses_;
+            return std::nullopt;
+        }
+        const Entry& entry = it->second;
+        if (entry.stamp != *stamp) {
+            ++stale_;
+            ++misses_;
+            return std::nullopt;
+        }
+
+        if (!mapping_ || mapping_->size() < entry.offset + entry.bytes()) {
+            // Earlier mappings stay valid for views that still reference them
+            mapping_ = core::MappedFile::open(pack_path_);
+            if (!mapping_ || mapping_->size() < entry.offset + entry.bytes()) {
+                mapping_.reset();
+                ++misses_;
+                return std::nullopt;
+            }
+        }
+
+        ++hits_;
+        return DecodedImageView{
+            .data = reinterpret_cast<const uint8_t*>(mapping_->data() + entry.offset),
+            .width = entry.width,
+            .height = entry.height,
+            .channels = entry.channels,
+            .owner = mapping_};
+    }
+
+    bool DecodedImagePack::insert(const std::filesystem::path& source, int resize_factor, int max_width,
+                                  const uint8_t* pixels, int width, int height, int channels) {
+        if (!pixels || width <= 0 || height <= 0 || channels <= 0) {
+            return false;
+        }
+        const auto stamp = stamp_source(source);
+        if (!stamp) {
+            return false;
+        }
+
+        const std::string key = make_key(source, resize_factor, max_width);
+        Entry entry{*stamp, 0, width, height, channels};
+        const uint64_t bytes = entry.bytes();
+
+        std::lock_guard lock(mutex_);
+        if (!open_) {
+            return false;
+        }
+
+        const uint64_t offset = align_up(pack_end_, DECODED_PACK_ALIGNMENT);
+        if (offset + bytes > max_bytes_) {
+            if (rejected_++ == 0) {
+                LOG_INFO("Decoded image pack {} reached its {:.1f} GB limit, not caching further images",
+                         lfs::core::path_to_utf8(pack_path_), max_bytes_ / (1024.0 * 1024.0 * 1024.0));
+            }
+            return false;
+        }
+        static constexpr std::array<char, DECODED_PACK_ALIGNMENT> zeros{};
+        pack_out_.write(zeros.data(), static_cast<std::streamsize>(offset - pack_end_));
+        pack_out_.write(reinterpret_cast<const char*>(pixels), static_cast<std::streamsize>(bytes));
+        pack_out_.flush();
+        if (!pack_out_) {
+            // Disk full or similar: stop writing, keep serving what's already cached
+            LOG_ERROR("Failed to append to decoded image pack {}, disabling writes", lfs::core::path_to_utf8(pack_path_));
+            pack_out_.clear();
+            open_ = false;
+            return false;
+        }
+        pack_end_ = offset + bytes;
+        entry.offset = offset;
+
+        IndexRecord record{};
+        record.key_length = static_cast<uint32_t>(key.size());
+        record.mtime = stamp->mtime;
+        record.source_size = stamp->size;
+        record.offset = offset;
+        record.width = width;
+        record.height = height;
+        record.channels = channels;
+        record.checksum = record_checksum(record, key);
+
+        index_out_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        index_out_.write(key.data(), static_cast<std::streamsize>(key.size()));
+        index_out_.flush();
+        if (!index_out_) {
+            LOG_ERROR("Failed to append to decoded image index {}, disabling writes", lfs::core::path_to_utf8(index_path_));
+            index_out_.clear();
+            open_ = false;
+            return false;
+        }
+
+        if (const auto it = entries_.find(key); it != entries_.end()) {
+            live_bytes_ -= it->second.bytes();
+        }
+        entries_.insert_or_assign(key, entry);
+        live_bytes_ += bytes;
+        ++insertions_;
+        return true;
+    }
+
+    void DecodedImagePack::clear() {
+        std::lock_guard lock(mutex_);
+        open_ = reset_files() && open_files();
+        if (!open_) {
+            LOG_ERROR("Failed to reset decoded image pack: {}", lfs::core::path_to_utf8(pack_path_));
+        }
+    }
+
+    DecodedImagePackStats DecodedImagePack::stats() const {
+        std::lock_guard lock(mutex_);
+        return DecodedImagePackStats{
+            .entries = entries_.size(),
+            .live_bytes = live_bytes_,
+            .pack_bytes = pack_end_,
+            .hits = hits_,
+            .misses = misses_,
+            .stale = stale_,
+            .insertions = insertions_,
+            .rejected = rejected_};
+    }
+
+} // namespace lfs::io
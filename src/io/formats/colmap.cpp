@@ -3,11 +3,13 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "colmap.hpp"
-#include "core/image_io.hpp"
 #include "core/logger.hpp"
+#include "core/mapped_file.hpp"
 #include "core/path_utils.hpp"
+#include "dataset_index.hpp"
 #include "io/filesystem_utils.hpp"
 #include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <cstring>
 #include <exception>
@@ -15,9 +17,12 @@
 #include <fstream>
 #include <memory>
 #include <stdexcept>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include <tbb/parallel_for.h>
+
 namespace lfs::io {
 
     // Import types from lfs::core for convenience
@@ -156,28 +161,22 @@ namespace lfs::io {
         {"THIN_PRISM_FISHEYE", CAMERA_MODEL::THIN_PRISM_FISHEYE}};
 
     // -----------------------------------------------------------------------------
-    //  Binary-file loader
+    //  Memory-mapped input
     // -----------------------------------------------------------------------------
-    static std::unique_ptr<std::vector<char>>
-    read_binary(const std::filesystem::path& p) {
-        LOG_TRACE("Reading binary file: {}", lfs::core::path_to_utf8(p));
-        std::ifstream f(p, std::ios::binary | std::ios::ate);
-        if (!f) {
-            LOG_ERROR("Failed to open binary file: {}", lfs::core::path_to_utf8(p));
+    static std::shared_ptr<lfs::core::MappedFile> map_file(const std::filesystem::path& p) {
+        auto mapped = lfs::core::MappedFile::open(p, lfs::core::MappedFile::Access::Sequential);
+        if (!mapped) {
             throw std::runtime_error("Failed to open " + lfs::core::path_to_utf8(p));
         }
+        LOG_TRACE("Mapped {} bytes from {}", mapped->size(), lfs::core::path_to_utf8(p));
+        return mapped;
+    }
 
-        auto sz = static_cast<std::streamsize>(f.tellg());
-        auto buf = std::make_unique<std::vector<char>>(static_cast<size_t>(sz));
-
-        f.seekg(0, std::ios::beg);
-        f.read(buf->data(), sz);
-        if (!f) {
-            LOG_ERROR("Short read on binary file: {}", lfs::core::path_to_utf8(p));
-            throw std::runtime_error("Short read on " + lfs::core::path_to_utf8(p));
+    static inline void require_bytes(const char* cur, const char* end, uint64_t n, const char* file) {
+        if (static_cast<uint64_t>(end - cur) < n) {
+            LOG_ERROR("{} is truncated", file);
+            throw std::runtime_error(std::string(file) + ": truncated");
         }
-        LOG_TRACE("Read {} bytes from {}", sz, lfs::core::path_to_utf8(p));
-        return buf;
     }
 
     // -----------------------------------------------------------------------------
@@ -269,16 +268,22 @@ namespace lfs::io {
     // -----------------------------------------------------------------------------
     std::vector<ImageData> read_images_binary(const std::filesystem::path& file_path) {
         LOG_TIMER_TRACE("Read images.bin");
-        auto buf_owner = read_binary(file_path);
-        const char* cur = buf_owner->data();
-        const char* end = cur + buf_owner->size();
+        const auto mapped = map_file(file_path);
+        const char* cur = mapped->as_span().data();
+        const char* end = cur + mapped->size();
 
+        require_bytes(cur, end, sizeof(uint64_t), "images.bin");
         uint64_t n_images = read_u64(cur);
         LOG_DEBUG("Reading {} images from binary file", n_images);
         std::vector<ImageData> images;
-        images.reserve(n_images);
+        images.reserve(std::min<uint64_t>(n_images, mapped->size()));
+
+        constexpr size_t IMAGE_HEADER_BYTES = sizeof(uint32_t) + 7 * sizeof(double) + sizeof(uint32_t);
+        constexpr size_t POINT2D_BYTES = sizeof(double) * 2 + sizeof(uint64_t);
 
         for (uint64_t i = 0; i < n_images; ++i) {
+            require_bytes(cur, end, IMAGE_HEADER_BYTES, "images.bin");
+
             ImageData img;
             img.image_id = read_u32(cur);
 
@@ -294,11 +299,21 @@ namespace lfs::io {
 
             img.camera_id = read_u32(cur);
 
-            img.name.assign(cur);
-            cur += img.name.size() + 1;
-
-            uint64_t npts = read_u64(cur);
-            cur += npts * (sizeof(double) * 2 + sizeof(uint64_t));
+            const char* name_end = static_cast<const char*>(std::memchr(cur, '\0', end - cur));
+            if (!name_end) {
+                LOG_ERROR("images.bin has an unterminated image name");
+                throw std::runtime_error("images.bin: truncated");
+            }
+            img.name.assign(cur, name_end);
+            cur = name_end + 1;
+
+            require_bytes(cur, end, sizeof(uint64_t), "images.bin");
+            const uint64_t npts = read_u64(cur);
+            if (npts > static_cast<uint64_t>(end - cur) / POINT2D_BYTES) {
+                LOG_ERROR("images.bin is truncated");
+                throw std::runtime_error("images.bin: truncated");
+            }
+            cur += npts * POINT2D_BYTES;
 
             images.push_back(std::move(img));
         }
@@ -316,18 +331,23 @@ namespace lfs::io {
     std::unordered_map<uint32_t, CameraDataIntermediate>
     read_cameras_binary(const std::filesystem::path& file_path, float scale_factor = 1.0f) {
         LOG_TIMER_TRACE("Read cameras.bin");
-        auto buf_owner = read_binary(file_path);
-        const char* cur = buf_owner->data();
-        const char* end = cur + buf_owner->size();
+        const auto mapped = map_file(file_path);
+        const char* cur = mapped->as_span().data();
+        const char* end = cur + mapped->size();
 
+        require_bytes(cur, end, sizeof(uint64_t), "cameras.bin");
         uint64_t n_cams = read_u64(cur);
         LOG_DEBUG("Reading {} cameras from binary file{}", n_cams,
                   scale_factor != 1.0f ? std::format(" with scale factor {}", scale_factor) : "");
 
         std::unordered_map<uint32_t, CameraDataIntermediate> cams;
-        cams.reserve(n_cams);
+        cams.reserve(std::min<uint64_t>(n_cams, mapped->size()));
+
+        constexpr size_t CAMERA_HEADER_BYTES = sizeof(uint32_t) + sizeof(int32_t) + 2 * sizeof(uint64_t);
 
         for (uint64_t i = 0; i < n_cams; ++i) {
+            require_bytes(cur, end, CAMERA_HEADER_BYTES, "cameras.bin");
+
             CameraDataIntermediate cam;
             cam.camera_id = read_u32(cur);
             cam.model_id = read_i32(cur);
@@ -346,6 +366,7 @@ namespace lfs::io {
             }
 
             int32_t param_cnt = it->second.second;
+            require_bytes(cur, end, param_cnt * sizeof(double), "cameras.bin");
             cam.params.resize(param_cnt);
 
             for (int j = 0; j < param_cnt; j++) {
@@ -369,32 +390,47 @@ namespace lfs::io {
     // -----------------------------------------------------------------------------
     //  points3D.bin
     // -----------------------------------------------------------------------------
-    PointCloud read_point3D_binary(const std::filesystem::path& file_path) {
+    namespace {
+        // id (u64), xyz (3 x f64), rgb (3 x u8), error (f64), track length (u64)
+        constexpr size_t POINT3D_FIXED_BYTES = 8 + 24 + 3 + 8 + 8;
+        constexpr size_t POINT3D_TRACK_LENGTH_OFFSET = 8 + 24 + 3 + 8;
+        constexpr size_t TRACK_ELEMENT_BYTES = sizeof(uint32_t) * 2;
+        constexpr size_t POINTS_PER_CHUNK = 16384;
+
+        inline uint64_t point3d_record_bytes(const char* record) {
+            uint64_t track_length;
+            std::memcpy(&track_length, record + POINT3D_TRACK_LENGTH_OFFSET, sizeof(track_length));
+            return POINT3D_FIXED_BYTES + track_length * TRACK_ELEMENT_BYTES;
+        }
+    } // namespace
+
+    PointCloud read_point3D_binary(const std::filesystem::path& file_path, const Device device) {
         LOG_TIMER_TRACE("Read points3D.bin");
-        auto buf_owner = read_binary(file_path);
-        const char* cur = buf_owner->data();
-        const char* end = cur + buf_owner->size();
+        const auto mapped = map_file(file_path);
+        const char* cur = mapped->as_span().data();
+        const char* end = cur + mapped->size();
 
+        require_bytes(cur, end, sizeof(uint64_t), "points3D.bin");
         uint64_t N = read_u64(cur);
         LOG_DEBUG("Reading {} 3D points from binary file", N);
 
-        std::vector<float> positions(N * 3);
-        std::vector<uint8_t> colors(N * 3);
-
+        // Pass 1: records are variable length (tracks), so walk the track lengths
+        // once and remember where every chunk of POINTS_PER_CHUNK points starts
+        std::vector<const char*> chunk_starts;
+        chunk_starts.reserve(std::min<uint64_t>(N, mapped->size()) / POINTS_PER_CHUNK + 1);
         for (uint64_t i = 0; i < N; ++i) {
-            cur += 8; // skip point ID
-
-            positions[i * 3 + 0] = static_cast<float>(read_f64(cur));
-            positions[i * 3 + 1] = static_cast<float>(read_f64(cur));
-            positions[i * 3 + 2] = static_cast<float>(read_f64(cur));
-
-            // Store colors as uint8 [0,255] to match old loader
-            colors[i * 3 + 0] = static_cast<uint8_t>(*cur++);
-            colors[i * 3 + 1] = static_cast<uint8_t>(*cur++);
-            colors[i * 3 + 2] = static_cast<uint8_t>(*cur++);
-
-            cur += 8;                                    // skip reprojection error
-            cur += read_u64(cur) * sizeof(uint32_t) * 2; // skip track
+            if (i % POINTS_PER_CHUNK == 0) {
+                chunk_starts.push_back(cur);
+            }
+            require_bytes(cur, end, POINT3D_FIXED_BYTES, "points3D.bin");
+            uint64_t track_length;
+            std::memcpy(&track_length, cur + POINT3D_TRACK_LENGTH_OFFSET, sizeof(track_length));
+            cur += POINT3D_FIXED_BYTES;
+            if (track_length > static_cast<uint64_t>(end - cur) / TRACK_ELEMENT_BYTES) {
+                LOG_ERROR("points3D.bin is truncated");
+                throw std::runtime_error("points3D.bin: truncated");
+            }
+            cur += track_length * TRACK_ELEMENT_BYTES;
         }
 
         if (cur != end) {
@@ -402,102 +438,176 @@ namespace lfs::io {
             throw std::runtime_error("points3D.bin: trailing bytes");
         }
 
-        Tensor means = Tensor::from_vector(positions, {N, 3}, Device::CUDA);
-        Tensor colors_tensor = Tensor::from_blob(colors.data(), {N, 3}, Device::CPU, DataType::UInt8)
-                                   .to(Device::CUDA)
-                                   .contiguous();
-
-        return PointCloud(std::move(means), std::move(colors_tensor));
+        // Pass 2: decode chunks in parallel straight into pinned upload buffers
+        Tensor means = Tensor::empty({N, 3}, Device::CPU, DataType::Float32);
+        Tensor colors = Tensor::empty({N, 3}, Device::CPU, DataType::UInt8);
+        float* const positions = means.ptr<float>();
+        uint8_t* const rgb = colors.ptr<uint8_t>();
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, chunk_starts.size()),
+                          [&](const tbb::blocked_range<size_t>& range) {
+                              for (size_t chunk = range.begin(); chunk < range.end(); ++chunk) {
+                                  const char* p = chunk_starts[chunk];
+                                  const uint64_t first = chunk * POINTS_PER_CHUNK;
+                                  const uint64_t last = std::min<uint64_t>(N, first + POINTS_PER_CHUNK);
+                                  for (uint64_t i = first; i < last; ++i) {
+                                      double xyz[3];
+                                      std::memcpy(xyz, p + 8, sizeof(xyz));
+                                      positions[i * 3 + 0] = static_cast<float>(xyz[0]);
+                                      positions[i * 3 + 1] = static_cast<float>(xyz[1]);
+                                      positions[i * 3 + 2] = static_cast<float>(xyz[2]);
+
+                                      // Store colors as uint8 [0,255] to match old loader
+                                      std::memcpy(rgb + i * 3, p + 32, 3);
+                                      p += point3d_record_bytes(p);
+                                  }
+                              }
+                          });
+
+        if (device != Device::CPU) {
+            means = means.to(device);
+            colors = colors.to(device);
+        }
+        return PointCloud(std::move(means), std::move(colors));
     }
 
     // -----------------------------------------------------------------------------
     //  Text-file helpers
     // -----------------------------------------------------------------------------
-    std::vector<std::string> read_text_file(const std::filesystem::path& file_path) {
-        LOG_TRACE("Reading text file: {}", lfs::core::path_to_utf8(file_path));
-        std::ifstream file(file_path);
-        if (!file.is_open()) {
-            LOG_ERROR("Failed to open text file: {}", lfs::core::path_to_utf8(file_path));
-            throw std::runtime_error("Failed to open " + lfs::core::path_to_utf8(file_path));
-        }
+    namespace {
+        // Iterates the lines of a mapped text file without copying them
+        class TextLines {
+        public:
+            TextLines(const char* begin, const char* end) : cur_(begin),
+                                                            end_(end) {}
+
+            // Any line, including empty ones; '\r' is stripped
+            bool next_raw(std::string_view& line) {
+                if (cur_ >= end_) {
+                    return false;
+                }
+                const char* nl = static_cast<const char*>(std::memchr(cur_, '\n', end_ - cur_));
+                const char* line_end = nl ? nl : end_;
+                line = std::string_view(cur_, line_end - cur_);
+                if (!line.empty() && line.back() == '\r') {
+                    line.remove_suffix(1);
+                }
+                cur_ = nl ? nl + 1 : end_;
+                return true;
+            }
 
-        std::vector<std::string> lines;
-        std::string line;
-        while (std::getline(file, line)) {
-            if (line.starts_with("#"))
-                continue;
-            if (!line.empty() && line.back() == '\r')
-                line.pop_back();
-            // Skip empty lines
-            if (line.empty())
-                continue;
-            lines.push_back(line);
-        }
+            // Next line that is neither empty nor a '#' comment
+            bool next(std::string_view& line) {
+                while (next_raw(line)) {
+                    if (!line.empty() && line.front() != '#') {
+                        return true;
+                    }
+                }
+                return false;
+            }
 
-        if (lines.empty()) {
-            LOG_ERROR("File is empty: {}", lfs::core::path_to_utf8(file_path));
-            throw std::runtime_error("File is empty");
-        }
+            [[nodiscard]] const char* position() const { return cur_; }
 
-        if (lines.back().empty())
-            lines.pop_back();
+        private:
+            const char* cur_;
+            const char* end_;
+        };
 
-        LOG_TRACE("Read {} lines from text file", lines.size());
-        return lines;
-    }
+        // Whitespace-separated tokens of a single line
+        class Tokens {
+        public:
+            explicit Tokens(std::string_view line) : rest_(line) {}
 
-    std::vector<std::string> split_string(const std::string& s, char delimiter) {
-        std::vector<std::string> tokens;
-        size_t start = 0;
-        size_t end = s.find(delimiter);
+            std::string_view next() {
+                const size_t begin = rest_.find_first_not_of(" \t");
+                if (begin == std::string_view::npos) {
+                    rest_ = {};
+                    return {};
+                }
+                const size_t end = std::min(rest_.find_first_of(" \t", begin), rest_.size());
+                const auto token = rest_.substr(begin, end - begin);
+                rest_.remove_prefix(end);
+                return token;
+            }
 
-        while (end != std::string::npos) {
-            tokens.push_back(s.substr(start, end - start));
-            start = end + 1;
-            end = s.find(delimiter, start);
+            // Everything after the tokens consumed so far, trimmed
+            [[nodiscard]] std::string_view remainder() const {
+                const size_t begin = rest_.find_first_not_of(" \t");
+                if (begin == std::string_view::npos) {
+                    return {};
+                }
+                return rest_.substr(begin, rest_.find_last_not_of(" \t") - begin + 1);
+            }
+
+        private:
+            std::string_view rest_;
+        };
+
+        template <typename T>
+        T parse_number(std::string_view token, const char* file) {
+            T value{};
+            const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+            if (ec != std::errc{} || ptr != token.data() + token.size()) {
+                LOG_ERROR("Invalid number '{}' in {}", token, file);
+                throw std::runtime_error(std::format("Invalid format in {}", file));
+            }
+            return value;
         }
-        tokens.push_back(s.substr(start));
 
-        return tokens;
-    }
+        std::shared_ptr<lfs::core::MappedFile> map_text_file(const std::filesystem::path& file_path) {
+            auto mapped = map_file(file_path);
+            const char* begin = mapped->as_span().data();
+            TextLines lines(begin, begin + mapped->size());
+            std::string_view line;
+            if (!lines.next(line)) {
+                LOG_ERROR("File is empty: {}", lfs::core::path_to_utf8(file_path));
+                throw std::runtime_error("File is empty");
+            }
+            return mapped;
+        }
+    } // namespace
 
     // -----------------------------------------------------------------------------
     //  images.txt
     // -----------------------------------------------------------------------------
     std::vector<ImageData> read_images_text(const std::filesystem::path& file_path) {
         LOG_TIMER_TRACE("Read images.txt");
-        auto lines = read_text_file(file_path);
-
-        if (lines.size() % 2 != 0) {
-            LOG_ERROR("images.txt should have an even number of lines");
-            throw std::runtime_error("images.txt should have an even number of lines");
-        }
+        const auto mapped = map_text_file(file_path);
+        const char* begin = mapped->as_span().data();
+        TextLines lines(begin, begin + mapped->size());
 
-        uint64_t n_images = lines.size() / 2;
-        LOG_DEBUG("Reading {} images from text file", n_images);
         std::vector<ImageData> images;
-        images.reserve(n_images);
-
-        for (uint64_t i = 0; i < n_images; ++i) {
-            const auto& line = lines[i * 2];
-            const auto tokens = split_string(line, ' ');
-
-            if (tokens.size() != 10) {
-                LOG_ERROR("Invalid format in images.txt line {}", i * 2 + 1);
+        std::string_view line;
+        while (lines.next(line)) {
+            Tokens tokens(line);
+            std::string_view fields[9];
+            for (auto& field : fields) {
+                field = tokens.next();
+            }
+            const std::string_view name = tokens.remainder();
+            if (fields[8].empty() || name.empty()) {
+                LOG_ERROR("Invalid format in images.txt entry {}", images.size() + 1);
                 throw std::runtime_error("Invalid format in images.txt");
             }
 
             ImageData img;
-            img.image_id = std::stoul(tokens[0]);
-            img.qvec = {std::stof(tokens[1]), std::stof(tokens[2]),
-                        std::stof(tokens[3]), std::stof(tokens[4])};
-            img.tvec = {std::stof(tokens[5]), std::stof(tokens[6]), std::stof(tokens[7])};
-            img.camera_id = std::stoul(tokens[8]);
-            img.name = tokens[9];
-
+            img.image_id = parse_number<uint32_t>(fields[0], "images.txt");
+            for (int k = 0; k < 4; ++k) {
+                img.qvec[k] = parse_number<float>(fields[1 + k], "images.txt");
+            }
+            for (int k = 0; k < 3; ++k) {
+                img.tvec[k] = parse_number<float>(fields[5 + k], "images.txt");
+            }
+            img.camera_id = parse_number<uint32_t>(fields[8], "images.txt");
+            img.name = name;
             images.push_back(std::move(img));
+
+            // The POINTS2D line follows every image line and is blank for images without observations
+            std::string_view points2d;
+            lines.next_raw(points2d);
         }
 
+        LOG_DEBUG("Read {} images from text file", images.size());
         return images;
     }
 
@@ -507,39 +617,44 @@ namespace lfs::io {
     std::unordered_map<uint32_t, CameraDataIntermediate>
     read_cameras_text(const std::filesystem::path& file_path, float scale_factor = 1.0f) {
         LOG_TIMER_TRACE("Read cameras.txt");
-        auto lines = read_text_file(file_path);
-
-        LOG_DEBUG("Reading {} cameras from text file{}", lines.size(),
-                  scale_factor != 1.0f ? std::format(" with scale factor {}", scale_factor) : "");
+        const auto mapped = map_text_file(file_path);
+        const char* begin = mapped->as_span().data();
+        TextLines lines(begin, begin + mapped->size());
 
         std::unordered_map<uint32_t, CameraDataIntermediate> cams;
 
-        for (const auto& line : lines) {
-            const auto tokens = split_string(line, ' ');
-            if (tokens.size() < 4) {
+        std::string_view line;
+        while (lines.next(line)) {
+            Tokens tokens(line);
+            const auto id = tokens.next();
+            const auto model_name = tokens.next();
+            const auto width = tokens.next();
+            const auto height = tokens.next();
+            if (height.empty()) {
                 LOG_ERROR("Invalid format in cameras.txt: {}", line);
                 throw std::runtime_error("Invalid format in cameras.txt");
             }
 
             CameraDataIntermediate cam;
-            cam.camera_id = std::stoul(tokens[0]);
+            cam.camera_id = parse_number<uint32_t>(id, "cameras.txt");
 
-            if (!camera_model_names.contains(tokens[1])) {
-                LOG_ERROR("Unknown camera model: {}", tokens[1]);
+            const auto model_it = camera_model_names.find(std::string(model_name));
+            if (model_it == camera_model_names.end()) {
+                LOG_ERROR("Unknown camera model: {}", model_name);
                 throw std::runtime_error("Unknown camera model");
             }
 
-            cam.model_id = static_cast<int>(camera_model_names.at(tokens[1]));
-            cam.width = std::stoi(tokens[2]);
-            cam.height = std::stoi(tokens[3]);
+            cam.model_id = static_cast<int>(model_it->second);
+            cam.width = parse_number<int>(width, "cameras.txt");
+            cam.height = parse_number<int>(height, "cameras.txt");
 
             if (scale_factor != 1.0f) {
                 cam.width = static_cast<int>(cam.width / scale_factor);
                 cam.height = static_cast<int>(cam.height / scale_factor);
             }
 
-            for (size_t j = 4; j < tokens.size(); ++j) {
-                cam.params.push_back(std::stof(tokens[j]));
+            for (auto token = tokens.next(); !token.empty(); token = tokens.next()) {
+                cam.params.push_back(parse_number<float>(token, "cameras.txt"));
             }
 
             auto it = camera_model_ids.find(cam.model_id);
@@ -550,88 +665,104 @@ namespace lfs::io {
             cams.emplace(cam.camera_id, std::move(cam));
         }
 
+        LOG_DEBUG("Read {} cameras from text file{}", cams.size(),
+                  scale_factor != 1.0f ? std::format(" with scale factor {}", scale_factor) : "");
         return cams;
     }
 
     // -----------------------------------------------------------------------------
     //  points3D.txt
     // -----------------------------------------------------------------------------
-    PointCloud read_point3D_text(const std::filesystem::path& file_path) {
-        LOG_TIMER_TRACE("Read points3D.txt");
-        auto lines = read_text_file(file_path);
-        uint64_t N = lines.size();
-        LOG_DEBUG("Reading {} 3D points from text file", N);
-
-        std::vector<float> positions(N * 3);
-        std::vector<uint8_t> colors(N * 3);
-
-        for (uint64_t i = 0; i < N; ++i) {
-            const auto& line = lines[i];
-            const auto tokens = split_string(line, ' ');
+    namespace {
+        constexpr size_t TEXT_CHUNK_BYTES = 1 << 20;
+    } // namespace
 
-            if (tokens.size() < 8) {
-                LOG_ERROR("Invalid format in points3D.txt: {}", line);
-                throw std::runtime_error("Invalid format in points3D.txt");
+    PointCloud read_point3D_text(const std::filesystem::path& file_path, const Device device) {
+        LOG_TIMER_TRACE("Read points3D.txt");
+        const auto mapped = map_text_file(file_path);
+        const char* begin = mapped->as_span().data();
+        const char* end = begin + mapped->size();
+
+        // Split at line boundaries into ~1MB chunks; a line belongs to the chunk it starts in
+        std::vector<const char*> bounds = {begin};
+        for (const char* target = begin + TEXT_CHUNK_BYTES; target < end; target += TEXT_CHUNK_BYTES) {
+            const char* from = std::max(target, bounds.back());
+            const char* nl = static_cast<const char*>(std::memchr(from, '\n', end - from));
+            if (!nl || nl + 1 >= end) {
+                break;
+            }
+            if (nl + 1 > bounds.back()) {
+                bounds.push_back(nl + 1);
             }
-
-            positions[i * 3 + 0] = std::stof(tokens[1]);
-            positions[i * 3 + 1] = std::stof(tokens[2]);
-            positions[i * 3 + 2] = std::stof(tokens[3]);
-
-            // Store colors as uint8 [0,255] to match old loader
-            colors[i * 3 + 0] = static_cast<uint8_t>(std::stoi(tokens[4]));
-            colors[i * 3 + 1] = static_cast<uint8_t>(std::stoi(tokens[5]));
-            colors[i * 3 + 2] = static_cast<uint8_t>(std::stoi(tokens[6]));
         }
+        bounds.push_back(end);
+        const size_t num_chunks = bounds.size() - 1;
+
+        // Pass 1: count points per chunk, then prefix-sum into output offsets
+        std::vector<uint64_t> first_point(num_chunks + 1, 0);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks),
+                          [&](const tbb::blocked_range<size_t>& range) {
+                              for (size_t c = range.begin(); c < range.end(); ++c) {
+                                  TextLines lines(bounds[c], bounds[c + 1]);
+                                  std::string_view line;
+                                  uint64_t count = 0;
+                                  while (lines.next(line)) {
+                                      ++count;
+                                  }
+                                  first_point[c + 1] = count;
+                              }
+                          });
+        for (size_t c = 0; c < num_chunks; ++c) {
+            first_point[c + 1] += first_point[c];
+        }
+        const uint64_t N = first_point.back();
+        LOG_DEBUG("Reading {} 3D points from text file", N);
 
-        Tensor means = Tensor::from_vector(positions, {N, 3}, Device::CUDA);
-        Tensor colors_tensor = Tensor::from_blob(colors.data(), {N, 3}, Device::CPU, DataType::UInt8)
-                                   .to(Device::CUDA)
-                                   .contiguous();
-
-        return PointCloud(std::move(means), std::move(colors_tensor));
+        // Pass 2: parse every chunk in parallel into its slice of the output
+        Tensor means = Tensor::empty({N, 3}, Device::CPU, DataType::Float32);
+        Tensor colors = Tensor::empty({N, 3}, Device::CPU, DataType::UInt8);
+        float* const positions = means.ptr<float>();
+        uint8_t* const rgb = colors.ptr<uint8_t>();
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks),
+                          [&](const tbb::blocked_range<size_t>& range) {
+                              for (size_t c = range.begin(); c < range.end(); ++c) {
+                                  TextLines lines(bounds[c], bounds[c + 1]);
+                                  std::string_view line;
+                                  for (uint64_t i = first_point[c]; lines.next(line); ++i) {
+                                      // POINT3D_ID X Y Z R G B ERROR TRACK[]
+                                      Tokens tokens(line);
+                                      std::string_view fields[8];
+                                      for (auto& field : fields) {
+                                          field = tokens.next();
+                                      }
+                                      if (fields[7].empty()) {
+                                          LOG_ERROR("Invalid format in points3D.txt: {}", line);
+                                          throw std::runtime_error("Invalid format in points3D.txt");
+                                      }
+
+                                      positions[i * 3 + 0] = parse_number<float>(fields[1], "points3D.txt");
+                                      positions[i * 3 + 1] = parse_number<float>(fields[2], "points3D.txt");
+                                      positions[i * 3 + 2] = parse_number<float>(fields[3], "points3D.txt");
+
+                                      // Store colors as uint8 [0,255] to match old loader
+                                      rgb[i * 3 + 0] = static_cast<uint8_t>(parse_number<int>(fields[4], "points3D.txt"));
+                                      rgb[i * 3 + 1] = static_cast<uint8_t>(parse_number<int>(fields[5], "points3D.txt"));
+                                      rgb[i * 3 + 2] = static_cast<uint8_t>(parse_number<int>(fields[6], "points3D.txt"));
+                                  }
+                              }
+                          });
+
+        if (device != Device::CPU) {
+            means = means.to(device);
+            colors = colors.to(device);
+        }
+        return PointCloud(std::move(means), std::move(colors));
     }
 
     // -----------------------------------------------------------------------------
     //  Assemble cameras with dimension verification
     // -----------------------------------------------------------------------------
-    namespace {
-        constexpr std::array MASK_FOLDERS = {"masks", "mask", "segmentation"};
-        constexpr std::array MASK_EXTENSIONS = {".png", ".jpg", ".jpeg", ".PNG", ".JPG", ".JPEG", ".mask.png"};
-    } // namespace
-
-    // Searches for mask file matching image_name in mask folders.
-    // Priority: exact match, stem+ext (e.g., img.png), full+ext (e.g., img.jpg.png)
-    static std::filesystem::path find_mask_path(const std::filesystem::path& base_path,
-                                                const std::string& image_name) {
-        const std::filesystem::path img_path = lfs::core::utf8_to_path(image_name);
-        const std::filesystem::path stem_path = img_path.parent_path() / img_path.stem();
-
-        for (const auto& folder : MASK_FOLDERS) {
-            const std::filesystem::path mask_dir = base_path / folder;
-            if (!std::filesystem::exists(mask_dir))
-                continue;
-
-            if (const auto exact = mask_dir / img_path; std::filesystem::exists(exact))
-                return exact;
-
-            for (const auto& ext : MASK_EXTENSIONS) {
-                auto path = mask_dir / stem_path;
-                path += ext;
-                if (std::filesystem::exists(path))
-                    return path;
-            }
-
-            for (const auto& ext : MASK_EXTENSIONS) {
-                auto path = mask_dir / img_path;
-                path += ext;
-                if (std::filesystem::exists(path))
-                    return path;
-            }
-        }
-        return {};
-    }
-
     Result<std::tuple<std::vector<std::shared_ptr<Camera>>, Tensor>>
     assemble_colmap_cameras(const std::filesystem::path& base_path,
                             const std::unordered_map<uint32_t, CameraDataIntermediate>& cam_map,
@@ -647,6 +778,17 @@ namespace lfs::io {
                               "Images folder does not exist", images_path);
         }
 
+        // Masks and their header sizes for all images at once
+        std::vector<DatasetImage> dataset_images;
+        dataset_images.reserve(images.size());
+        for (const auto& img : images) {
+            dataset_images.push_back({img.name, images_path / img.name});
+        }
+        auto indexed = index_dataset_images(base_path, dataset_images);
+        if (!indexed) {
+            return std::unexpected(indexed.error());
+        }
+
         std::vector<std::shared_ptr<Camera>> cameras;
         cameras.reserve(images.size());
 
@@ -818,20 +960,8 @@ namespace lfs::io {
                                   images_path / img.name);
             }
 
-            std::filesystem::path mask_path = find_mask_path(base_path, img.name);
-
-            // Validate mask dimensions match image dimensions
-            if (!mask_path.empty()) {
-                auto [img_w, img_h, img_c] = lfs::core::get_image_info(images_path / img.name);
-                auto [mask_w, mask_h, mask_c] = lfs::core::get_image_info(mask_path);
-                if (img_w != mask_w || img_h != mask_h) {
-                    return make_error(ErrorCode::MASK_SIZE_MISMATCH,
-                                      std::format("Mask '{}' is {}x{} but image '{}' is {}x{}",
-                                                  lfs::core::path_to_utf8(mask_path.filename()), mask_w, mask_h,
-                                                  img.name, img_w, img_h),
-                                      mask_path);
-                }
-            }
+            // Mask sizes were validated by the index
+            const std::filesystem::path& mask_path = (*indexed)[i].mask_path;
 
             // Create Camera
             auto camera = std::make_shared<Camera>(
@@ -879,10 +1009,10 @@ namespace lfs::io {
         throw std::runtime_error(error_msg);
     }
 
-    PointCloud read_colmap_point_cloud(const std::filesystem::path& filepath) {
+    PointCloud read_colmap_point_cloud(const std::filesystem::path& filepath, const Device device) {
         LOG_TIMER_TRACE("Read COLMAP point cloud");
         fs::path points3d_file = get_sparse_file_path(filepath, "points3D.bin");
-        return read_point3D_binary(points3d_file);
+        return read_point3D_binary(points3d_file, device);
     }
 
     Result<std::tuple<std::vector<std::shared_ptr<Camera>>, Tensor>>
@@ -904,10 +1034,10 @@ namespace lfs::io {
         return assemble_colmap_cameras(base, cam_map, images, images_folder);
     }
 
-    PointCloud read_colmap_point_cloud_text(const std::filesystem::path& filepath) {
+    PointCloud read_colmap_point_cloud_text(const std::filesystem::path& filepath, const Device device) {
         LOG_TIMER_TRACE("Read COLMAP point cloud (text)");
         fs::path points3d_file = get_sparse_file_path(filepath, "points3D.txt");
-        return read_point3D_text(points3d_file);
+        return read_point3D_text(points3d_file, device);
     }
 
     Result<std::tuple<std::vector<std::shared_ptr<Camera>>, Tensor>>
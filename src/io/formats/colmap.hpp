@@ -63,9 +63,11 @@ namespace lfs::io {
     /**
      * @brief Read COLMAP point cloud (binary format)
      * @param filepath Base directory containing points3D.bin
+     * @param device Device the returned tensors live on
      * @return PointCloud
      */
-    PointCloud read_colmap_point_cloud(const std::filesystem::path& filepath);
+    PointCloud read_colmap_point_cloud(const std::filesystem::path& filepath,
+                                       lfs::core::Device device = lfs::core::Device::CUDA);
 
     /**
      * @brief Read COLMAP cameras and images from text files
@@ -81,8 +83,10 @@ namespace lfs::io {
     /**
      * @brief Read COLMAP point cloud from text file
      * @param filepath Base directory containing points3D.txt
+     * @param device Device the returned tensors live on
      * @return PointCloud
      */
-    PointCloud read_colmap_point_cloud_text(const std::filesystem::path& filepath);
+    PointCloud read_colmap_point_cloud_text(const std::filesystem::path& filepath,
+                                            lfs::core::Device device = lfs::core::Device::CUDA);
 
 } // namespace lfs::io
\ No newline at end of file
@@ -5,13 +5,22 @@
 #include "html.hpp"
 #include "core/logger.hpp"
 #include "core/path_utils.hpp"
+#include "core/perf_trace.hpp"
 #include "html_viewer_resources.hpp"
 #include "io/error.hpp"
 #include "sogs.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <fstream>
-#include <sstream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace lfs::io {
 
@@ -20,52 +29,75 @@ namespace lfs::io {
         constexpr char BASE64_CHARS[] =
             "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-        std::string base64_encode(const std::vector<uint8_t>& data) {
-            std::string result;
-            result.reserve(((data.size() + 2) / 3) * 4);
-
-            for (size_t i = 0; i < data.size(); i += 3) {
-                const uint32_t b0 = data[i];
-                const uint32_t b1 = (i + 1 < data.size()) ? data[i + 1] : 0;
-                const uint32_t b2 = (i + 2 < data.size()) ? data[i + 2] : 0;
-
-                result += BASE64_CHARS[(b0 >> 2) & 0x3F];
-                result += BASE64_CHARS[((b0 << 4) | (b1 >> 4)) & 0x3F];
-                result += (i + 1 < data.size()) ? BASE64_CHARS[((b1 << 2) | (b2 >> 6)) & 0x3F] : '=';
-                result += (i + 2 < data.size()) ? BASE64_CHARS[b2 & 0x3F] : '=';
-            }
-            return result;
+        // Input bytes per streamed base64 block (multiple of 3, so only the last block pads)
+        constexpr size_t BASE64_BLOCK = 3 * 64 * 1024;
+
+#if defined(__AVX2__)
+        // 24 input bytes -> 32 characters. Each 128-bit lane holds 12 input bytes,
+        // which are split into 6-bit indices and mapped to ASCII by offset lookup.
+        inline __m256i base64_encode_avx2(const uint8_t* src) {
+            const __m256i in = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12)), 1);
+
+            const __m256i shuffled = _mm256_shuffle_epi8(in, _mm256_set_epi8(
+                                                                 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                                                 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+            const __m256i hi = _mm256_mulhi_epu16(_mm256_and_si256(shuffled, _mm256_set1_epi32(0x0fc0fc00)),
+                                                  _mm256_set1_epi32(0x04000040));
+            const __m256i lo = _mm256_mullo_epi16(_mm256_and_si256(shuffled, _mm256_set1_epi32(0x003f03f0)),
+                                                  _mm256_set1_epi32(0x01000010));
+            const __m256i indices = _mm256_or_si256(hi, lo);
+
+            // Offsets for 'A'-'Z', 'a'-'z', '0'-'9', '+' and '/'
+            const __m256i offsets = _mm256_setr_epi8(
+                65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+            __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+            range = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+            return _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range));
         }
+#endif
+
+        // Encodes data into dst, which must hold ((data.size() + 2) / 3) * 4 characters
+        size_t base64_encode(std::span<const uint8_t> data, char* dst) {
+            const uint8_t* src = data.data();
+            const size_t size = data.size();
+            size_t i = 0;
+            char* out = dst;
+
+#if defined(__AVX2__)
+            // The second lane load reads 4 bytes past each 24-byte group
+            for (; i + 28 <= size; i += 24, out += 32) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), base64_encode_avx2(src + i));
+            }
+#endif
+
+            for (; i + 3 <= size; i += 3) {
+                const uint32_t triple = (uint32_t{src[i]} << 16) | (uint32_t{src[i + 1]} << 8) | src[i + 2];
+                *out++ = BASE64_CHARS[(triple >> 18) & 0x3F];
+                *out++ = BASE64_CHARS[(triple >> 12) & 0x3F];
+                *out++ = BASE64_CHARS[(triple >> 6) & 0x3F];
+                *out++ = BASE64_CHARS[triple & 0x3F];
+            }
 
-        std::vector<uint8_t> read_file_binary(const std::filesystem::path& path) {
-            std::ifstream file;
-            if (!lfs::core::open_file_for_read(path, std::ios::binary | std::ios::ate, file))
-                return {};
-
-            const auto size = file.tellg();
-            file.seekg(0, std::ios::beg);
-
-            std::vector<uint8_t> buffer(size);
-            file.read(reinterpret_cast<char*>(buffer.data()), size);
-            return buffer;
+            if (i < size) {
+                const uint32_t b0 = src[i];
+                const uint32_t b1 = (i + 1 < size) ? src[i + 1] : 0;
+                *out++ = BASE64_CHARS[(b0 >> 2) & 0x3F];
+                *out++ = BASE64_CHARS[((b0 << 4) | (b1 >> 4)) & 0x3F];
+                *out++ = (i + 1 < size) ? BASE64_CHARS[(b1 << 2) & 0x3F] : '=';
+                *out++ = '=';
+            }
+            return static_cast<size_t>(out - dst);
         }
 
-        std::string replace_placeholder(std::string_view input, std::string_view placeholder, std::string_view replacement) {
-            std::string result;
-            result.reserve(input.size() + replacement.size());
-
-            size_t pos = 0;
-            while (pos < input.size()) {
-                const size_t found = input.find(placeholder, pos);
-                if (found == std::string_view::npos) {
-                    result.append(input.substr(pos));
-                    break;
-                }
-                result.append(input.substr(pos, found - pos));
-                result.append(replacement);
-                pos = found + placeholder.size();
+        void write_base64(std::ostream& out, std::span<const uint8_t> data) {
+            std::vector<char> buffer(BASE64_BLOCK / 3 * 4);
+            for (size_t offset = 0; offset < data.size() && out.good(); offset += BASE64_BLOCK) {
+                const auto block = data.subspan(offset, std::min(BASE64_BLOCK, data.size() - offset));
+                out.write(buffer.data(), static_cast<std::streamsize>(base64_encode(block, buffer.data())));
             }
-            return result;
         }
 
         std::string pad_text(std::string_view text, int spaces) {
@@ -86,36 +118,96 @@ namespace lfs::io {
             return result;
         }
 
-        std::string generate_html(const std::string& base64_sog) {
-            const auto tmpl = get_viewer_template();
-            const auto css = get_viewer_css();
-            const auto js = get_viewer_js();
-
-            std::string html{tmpl};
-
-            const std::string style_link = R"(<link rel="stylesheet" href="./index.css">)";
-            const std::string inline_style = "<style>\n" + pad_text(css, 12) + "\n        </style>";
-            html = replace_placeholder(html, style_link, inline_style);
-
-            const std::string js_import = "import { main } from './index.js';";
-            html = replace_placeholder(html, js_import, js);
-
-            const std::string settings_fetch = "settings: fetch(settingsUrl).then(response => response.json())";
-            const std::string inline_settings = R"(settings: {"camera":{"fov":50,"position":[2,2,-2],"target":[0,0,0],"startAnim":"none"},"background":{"color":[0,0,0]},"animTracks":[]})";
-            html = replace_placeholder(html, settings_fetch, inline_settings);
+        // What replaces each placeholder of the supersplat-viewer template
+        enum class Insert {
+            None,
+            Css,
+            Js,
+            Settings,
+            SogData,
+            SogExtension
+        };
+
+        struct Placeholder {
+            std::string_view text;
+            Insert insert;
+        };
+
+        constexpr std::array PLACEHOLDERS = {
+            Placeholder{R"(<link rel="stylesheet" href="./index.css">)", Insert::Css},
+            Placeholder{"import { main } from './index.js';", Insert::Js},
+            Placeholder{"settings: fetch(settingsUrl).then(response => response.json())", Insert::Settings},
+            Placeholder{"fetch(contentUrl)", Insert::SogData},
+            Placeholder{".compressed.ply", Insert::SogExtension},
+        };
+
+        // Template text up to a placeholder, followed by what replaces it
+        struct TemplateChunk {
+            std::string_view text;
+            Insert insert;
+        };
+
+        // The template is split at its placeholders once, the chunks view the static template string
+        const std::vector<TemplateChunk>& template_chunks() {
+            static const std::vector<TemplateChunk> chunks = [] {
+                const std::string_view tmpl = get_viewer_template();
+
+                std::vector<std::pair<size_t, const Placeholder*>> found;
+                for (const auto& placeholder : PLACEHOLDERS) {
+                    for (size_t pos = tmpl.find(placeholder.text); pos != std::string_view::npos;
+                         pos = tmpl.find(placeholder.text, pos + placeholder.text.size())) {
+                        found.emplace_back(pos, &placeholder);
+                    }
+                }
+                std::ranges::sort(found, {}, &std::pair<size_t, const Placeholder*>::first);
 
-            const std::string content_fetch = "fetch(contentUrl)";
-            const std::string base64_fetch = "fetch(\"data:application/octet-stream;base64," + base64_sog + "\")";
-            html = replace_placeholder(html, content_fetch, base64_fetch);
+                std::vector<TemplateChunk> result;
+                size_t pos = 0;
+                for (const auto& [offset, placeholder] : found) {
+                    result.push_back({tmpl.substr(pos, offset - pos), placeholder->insert});
+                    pos = offset + placeholder->text.size();
+                }
+                result.push_back({tmpl.substr(pos), Insert::None});
+                return result;
+            }();
+            return chunks;
+        }
 
-            html = replace_placeholder(html, ".compressed.ply", ".sog");
+        void write_html(std::ostream& out, std::span<const uint8_t> sog_data) {
+            constexpr std::string_view INLINE_SETTINGS =
+                R"(settings: {"camera":{"fov":50,"position":[2,2,-2],"target":[0,0,0],"startAnim":"none"},"background":{"color":[0,0,0]},"animTracks":[]})";
 
-            return html;
+            for (const auto& chunk : template_chunks()) {
+                out << chunk.text;
+                switch (chunk.insert) {
+                case Insert::None:
+                    break;
+                case Insert::Css:
+                    out << "<style>\n"
+                        << pad_text(get_viewer_css(), 12) << "\n        </style>";
+                    break;
+                case Insert::Js:
+                    out << get_viewer_js();
+                    break;
+                case Insert::Settings:
+                    out << INLINE_SETTINGS;
+                    break;
+                case Insert::SogData:
+                    out << "fetch(\"data:application/octet-stream;base64,";
+                    write_base64(out, sog_data);
+                    out << "\")";
+                    break;
+                case Insert::SogExtension:
+                    out << ".sog";
+                    break;
+                }
+            }
         }
 
     } // anonymous namespace
 
     Result<void> export_html(const SplatData& splat_data, const HtmlExportOptions& options) {
+        LFS_TRACE_SCOPE(Export, "export_html");
         if (options.progress_callback) {
             options.progress_callback(0.0f, "Exporting SOG...");
         }
@@ -140,57 +232,42 @@ namespace lfs::io {
             return std::unexpected(writable_check.error());
         }
 
-        const auto temp_sog = std::filesystem::temp_directory_path() / "lfs_html_export_temp.sog";
         const SogSaveOptions sog_options{
-            .output_path = temp_sog,
+            .output_path = options.output_path,
             .kmeans_iterations = options.kmeans_iterations,
-            .use_gpu = true,
+            .use_gpu = options.use_gpu,
             .progress_callback = [&](float p, const std::string& stage) {
                 if (options.progress_callback) {
-                    options.progress_callback(p * 0.5f, stage);
+                    options.progress_callback(p * 0.8f, stage);
                 }
                 return true;
             }};
 
-        if (auto result = save_sog(splat_data, sog_options); !result) {
+        // The SOG stays in memory and is base64 encoded while the HTML streams to disk
+        const auto sog_data = save_sog_to_memory(splat_data, sog_options);
+        if (!sog_data) {
             // Propagate the SOG error with context
-            return make_error(result.error().code,
-                              std::format("Failed to create SOG for HTML export: {}", result.error().message),
+            return make_error(sog_data.error().code,
+                              std::format("Failed to create SOG for HTML export: {}", sog_data.error().message),
                               options.output_path);
         }
 
         if (options.progress_callback) {
-            options.progress_callback(0.5f, "Encoding data...");
-        }
-
-        const auto sog_data = read_file_binary(temp_sog);
-        std::error_code ec;
-        std::filesystem::remove(temp_sog, ec); // Best effort cleanup
-
-        if (sog_data.empty()) {
-            return make_error(ErrorCode::READ_FAILURE,
-                              "Failed to read temporary SOG file", temp_sog);
-        }
-
-        const auto base64_data = base64_encode(sog_data);
-
-        if (options.progress_callback) {
-            options.progress_callback(0.8f, "Generating HTML...");
+            options.progress_callback(0.8f, "Writing HTML...");
         }
 
-        const auto html = generate_html(base64_data);
-
         std::ofstream out;
         if (!lfs::core::open_file_for_write(options.output_path, out)) {
             return make_error(ErrorCode::WRITE_FAILURE,
                               "Failed to open output file for writing", options.output_path);
         }
-        out << html;
+        write_html(out, *sog_data);
 
         if (!out.good()) {
             return make_error(ErrorCode::WRITE_FAILURE,
                               "Failed to write HTML content (possibly disk full)", options.output_path);
         }
+        const auto html_size = static_cast<float>(out.tellp());
         out.close();
 
         if (options.progress_callback) {
@@ -199,7 +276,7 @@ namespace lfs::io {
 
         LOG_INFO("Exported HTML viewer: {} ({:.1f} MB)",
                  lfs::core::path_to_utf8(options.output_path),
-                 static_cast<float>(html.size()) / (1024 * 1024));
+                 html_size / (1024 * 1024));
 
         return {};
     }
@@ -5,6 +5,7 @@
 #include "ply.hpp"
 #include "core/logger.hpp"
 #include "core/path_utils.hpp"
+#include "core/perf_trace.hpp"
 #include "core/tensor.hpp"
 #include "io/error.hpp"
 #include "tinyply.hpp"
@@ -501,7 +502,7 @@ namespace lfs::io {
 
     // Main function - returns SplatData
     [[nodiscard]] std::expected<SplatData, std::string>
-    load_ply(const std::filesystem::path& filepath) {
+    load_ply(const std::filesystem::path& filepath, lfs::core::Device device) {
         try {
             LOG_TIMER("PLY File Loading");
             auto start_time = std::chrono::high_resolution_clock::now();
@@ -618,15 +619,15 @@ namespace lfs::io {
                 }
             }
 
-            LOG_DEBUG("Creating Tensor objects and uploading to CUDA");
+            LOG_DEBUG("Creating Tensor objects on {}", device == Device::CUDA ? "CUDA" : "CPU");
 
-            // Create Tensors directly from vectors (uploads to CUDA)
-            Tensor means = Tensor::from_vector(host_means, {N, 3}, Device::CUDA);
-            Tensor sh0 = Tensor::from_vector(host_sh0, {N, static_cast<size_t>(sh0_dim1), static_cast<size_t>(sh0_dim2)}, Device::CUDA);
-            Tensor shN = Tensor::from_vector(host_shN, {N, static_cast<size_t>(shN_dim1), static_cast<size_t>(shN_dim2)}, Device::CUDA);
-            Tensor scaling = Tensor::from_vector(host_scaling, {N, 3}, Device::CUDA);
-            Tensor rotation = Tensor::from_vector(host_rotation, {N, 4}, Device::CUDA);
-            Tensor opacity = Tensor::from_vector(host_opacity, {N, 1}, Device::CUDA);
+            // Create Tensors directly from vectors (uploads when device is CUDA)
+            Tensor means = Tensor::from_vector(host_means, {N, 3}, device);
+            Tensor sh0 = Tensor::from_vector(host_sh0, {N, static_cast<size_t>(sh0_dim1), static_cast<size_t>(sh0_dim2)}, device);
+            Tensor shN = Tensor::from_vector(host_shN, {N, static_cast<size_t>(shN_dim1), static_cast<size_t>(shN_dim2)}, device);
+            Tensor scaling = Tensor::from_vector(host_scaling, {N, 3}, device);
+            Tensor rotation = Tensor::from_vector(host_rotation, {N, 4}, device);
+            Tensor opacity = Tensor::from_vector(host_opacity, {N, 1}, device);
 
             // Calculate SH degree
             int sh_degree = static_cast<int>(std::sqrt(shN_dim1 + ply_constants::SH_DEGREE_OFFSET)) - ply_constants::SH_DEGREE_OFFSET;
@@ -677,6 +678,7 @@ namespace lfs::io {
         }
 
         void write_ply_binary(const PointCloud& pc, const std::filesystem::path& output_path) {
+            LFS_TRACE_SCOPE(Export, "write_ply");
             std::vector<Tensor> tensors;
             tensors.push_back(pc.means.cpu().contiguous());
 
@@ -795,6 +797,7 @@ namespace lfs::io {
     }
 
     Result<void> save_ply(const SplatData& splat_data, const PlySaveOptions& options) {
+        LFS_TRACE_SCOPE(Export, "save_ply");
         auto pc = lfs::io::to_point_cloud(splat_data);
         return save_ply(pc, options);
     }
@@ -899,7 +902,7 @@ namespace lfs::io {
         return has_opacity && has_scale && has_rotation;
     }
 
-    std::expected<lfs::core::PointCloud, std::string> load_ply_point_cloud(const std::filesystem::path& filepath) {
+    std::expected<lfs::core::PointCloud, std::string> load_ply_point_cloud(const std::filesystem::path& filepath, lfs::core::Device device) {
         constexpr uint8_t DEFAULT_COLOR = 255;
 
         if (!std::filesystem::exists(filepath)) {
@@ -964,6 +967,10 @@ namespace lfs::io {
                 color_tensor = Tensor::full({N, 3}, DEFAULT_COLOR, Device::CPU, DataType::UInt8);
             }
 
+            if (device != Device::CPU) {
+                positions = positions.to(device);
+                color_tensor = color_tensor.to(device);
+            }
             return PointCloud(std::move(positions), std::move(color_tensor));
         } catch (const std::exception& e) {
             return std::unexpected(std::format("Load failed: {}", e.what()));
@@ -14,10 +14,12 @@ namespace lfs::io {
     bool is_gaussian_splat_ply(const std::filesystem::path& filepath);
 
     // Load PLY as Gaussian splat (with opacity, scaling, rotation, SH)
-    std::expected<SplatData, std::string> load_ply(const std::filesystem::path& filepath);
+    std::expected<SplatData, std::string> load_ply(const std::filesystem::path& filepath,
+                                                   lfs::core::Device device = lfs::core::Device::CUDA);
 
     // Load PLY as simple point cloud (xyz + optional colors)
-    std::expected<lfs::core::PointCloud, std::string> load_ply_point_cloud(const std::filesystem::path& filepath);
+    std::expected<lfs::core::PointCloud, std::string> load_ply_point_cloud(const std::filesystem::path& filepath,
+                                                                           lfs::core::Device device = lfs::core::Device::CPU);
 
     // Alias for backward compatibility
     using SaveProgressCallback = ExportProgressCallback;
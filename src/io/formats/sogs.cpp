@@ -9,18 +9,29 @@
 #include "sogs.hpp"
 #include "core/logger.hpp"
 #include "core/path_utils.hpp"
+#include "core/perf_trace.hpp"
 #include "core/tensor.hpp"
+#include "cpu/kmeans_cpu.hpp"
+#include "cpu/morton_encoding_cpu.hpp"
 #include "cuda/kmeans.hpp"
 #include "cuda/morton_encoding.hpp"
 #include "io/error.hpp"
 #include <archive.h>
 #include <archive_entry.h>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <sstream>
+#include <thread>
+#include <tbb/parallel_invoke.h>
+#include <tbb/task_group.h>
 #include <unordered_map>
 #include <vector>
 #include <webp/decode.h>
@@ -241,7 +252,8 @@ namespace lfs::io {
 
         std::expected<SplatData, std::string> reconstruct_splat_data(
             const SogMetadata& meta,
-            const std::unordered_map<std::string, std::vector<uint8_t>>& images) {
+            const std::unordered_map<std::string, std::vector<uint8_t>>& images,
+            const Device device) {
 
             const int num_splats = meta.count;
 
@@ -481,20 +493,20 @@ namespace lfs::io {
                 }
             }
 
-            // Create Tensors directly from host vectors (uploads to CUDA)
+            // Create Tensors directly from host vectors (uploads when device is CUDA)
             const size_t N = num_splats;
 
-            Tensor means = Tensor::from_vector(host_means, {N, 3}, Device::CUDA);
-            Tensor scales = Tensor::from_vector(host_scales, {N, 3}, Device::CUDA);
-            Tensor rotations = Tensor::from_vector(host_rotations, {N, 4}, Device::CUDA);
-            Tensor opacity = Tensor::from_vector(host_opacity, {N, 1}, Device::CUDA);
-            Tensor sh0 = Tensor::from_vector(host_sh0, {N, static_cast<size_t>(sh0_dim1), static_cast<size_t>(sh0_dim2)}, Device::CUDA);
+            Tensor means = Tensor::from_vector(host_means, {N, 3}, device);
+            Tensor scales = Tensor::from_vector(host_scales, {N, 3}, device);
+            Tensor rotations = Tensor::from_vector(host_rotations, {N, 4}, device);
+            Tensor opacity = Tensor::from_vector(host_opacity, {N, 1}, device);
+            Tensor sh0 = Tensor::from_vector(host_sh0, {N, static_cast<size_t>(sh0_dim1), static_cast<size_t>(sh0_dim2)}, device);
 
             Tensor shN;
             if (shN_dim1 > 0) {
-                shN = Tensor::from_vector(host_shN, {N, static_cast<size_t>(shN_dim1), static_cast<size_t>(shN_dim2)}, Device::CUDA);
+                shN = Tensor::from_vector(host_shN, {N, static_cast<size_t>(shN_dim1), static_cast<size_t>(shN_dim2)}, device);
             } else {
-                shN = Tensor::zeros({N, 0, 3}, Device::CUDA);
+                shN = Tensor::zeros({N, 0, 3}, device);
             }
 
             // Calculate SH degree
@@ -517,7 +529,7 @@ namespace lfs::io {
         }
 
         std::expected<SplatData, std::string> read_sog_bundle(
-            const std::filesystem::path& path) {
+            const std::filesystem::path& path, const Device device) {
 
             LOG_INFO("Reading SOG bundle: {}", lfs::core::path_to_utf8(path));
 
@@ -584,11 +596,11 @@ namespace lfs::io {
             }
 
             // Reconstruct SplatData
-            return reconstruct_splat_data(meta_result.value(), images);
+            return reconstruct_splat_data(meta_result.value(), images, device);
         }
 
         std::expected<SplatData, std::string> read_sog_directory(
-            const std::filesystem::path& path) {
+            const std::filesystem::path& path, const Device device) {
 
             LOG_INFO("Reading SOG from directory: {}", lfs::core::path_to_utf8(path));
 
@@ -684,12 +696,12 @@ namespace lfs::io {
             }
 
             // Reconstruct SplatData
-            return reconstruct_splat_data(meta, images);
+            return reconstruct_splat_data(meta, images, device);
         }
 
     } // anonymous namespace
 
-    std::expected<SplatData, std::string> load_sog(const std::filesystem::path& path) {
+    std::expected<SplatData, std::string> load_sog(const std::filesystem::path& path, const Device device) {
         LOG_TIMER("SOG File Loading");
 
         if (!std::filesystem::exists(path)) {
@@ -702,15 +714,15 @@ namespace lfs::io {
 
         // Check if it's a .sog bundle
         if (path.extension() == ".sog") {
-            result = read_sog_bundle(path);
+            result = read_sog_bundle(path, device);
         }
         // Check if it's a meta.json file
         else if (path.filename() == "meta.json") {
-            result = read_sog_directory(path.parent_path());
+            result = read_sog_directory(path.parent_path(), device);
         }
         // Check if it's a directory
         else if (std::filesystem::is_directory(path)) {
-            result = read_sog_directory(path);
+            result = read_sog_directory(path, device);
         } else {
             return std::unexpected(std::format("Unknown SOG format: {}", lfs::core::path_to_utf8(path)));
         }
@@ -738,18 +750,32 @@ namespace lfs::io {
             std::string last_error_;
             bool valid_ = false;
 
-        public:
-            explicit SogArchive(const std::filesystem::path& output_path)
-                : output_path_(output_path) {
+            static la_ssize_t append_to_sink(struct archive*, void* client_data, const void* buffer, size_t length) {
+                auto* sink = static_cast<std::vector<uint8_t>*>(client_data);
+                const auto* bytes = static_cast<const uint8_t*>(buffer);
+                sink->insert(sink->end(), bytes, bytes + length);
+                return static_cast<la_ssize_t>(length);
+            }
+
+            bool create_zip_writer() {
                 a_ = archive_write_new();
                 if (!a_) {
                     last_error_ = "Failed to allocate archive structure";
-                    return;
+                    return false;
                 }
 
                 if (archive_write_set_format_zip(a_) != ARCHIVE_OK) {
                     last_error_ = std::format("Failed to set ZIP format: {}",
                                               archive_error_string(a_) ? archive_error_string(a_) : "unknown error");
+                    return false;
+                }
+                return true;
+            }
+
+        public:
+            explicit SogArchive(const std::filesystem::path& output_path)
+                : output_path_(output_path) {
+                if (!create_zip_writer()) {
                     return;
                 }
 
@@ -770,6 +796,24 @@ namespace lfs::io {
                 valid_ = true;
             }
 
+            // Appends the archive to sink; output_path is only used in error reports
+            SogArchive(std::vector<uint8_t>& sink, const std::filesystem::path& output_path)
+                : output_path_(output_path) {
+                if (!create_zip_writer()) {
+                    return;
+                }
+
+                // No padding of the final block, the sink receives exactly the ZIP bytes
+                archive_write_set_bytes_in_last_block(a_, 1);
+                if (archive_write_open(a_, &sink, nullptr, &SogArchive::append_to_sink, nullptr) != ARCHIVE_OK) {
+                    last_error_ = std::format("Failed to create in-memory archive: {}",
+                                              archive_error_string(a_) ? archive_error_string(a_) : "unknown error");
+                    return;
+                }
+
+                valid_ = true;
+            }
+
             ~SogArchive() {
                 if (a_) {
                     if (valid_) {
@@ -788,6 +832,21 @@ namespace lfs::io {
             [[nodiscard]] bool is_valid() const { return valid_; }
             [[nodiscard]] const std::string& last_error() const { return last_error_; }
 
+            // Writes the central directory; an in-memory archive is only complete after this
+            [[nodiscard]] Result<void> close() {
+                if (!valid_) {
+                    return make_error(ErrorCode::ARCHIVE_CREATION_FAILED, last_error_, output_path_);
+                }
+                valid_ = false;
+                if (archive_write_close(a_) != ARCHIVE_OK) {
+                    const char* err = archive_error_string(a_);
+                    return make_error(ErrorCode::WRITE_FAILURE,
+                                      std::format("Failed to finalize archive: {}", err ? err : "unknown error"),
+                                      output_path_);
+                }
+                return {};
+            }
+
             [[nodiscard]] Result<void> add_file(const std::string& filename, const void* data, size_t size) {
                 if (!valid_) {
                     return make_error(ErrorCode::ARCHIVE_CREATION_FAILED, last_error_, output_path_);
@@ -837,30 +896,131 @@ namespace lfs::io {
 
                 return {};
             }
+        };
 
-            [[nodiscard]] Result<void> add_webp(const std::string& filename,
-                                                const uint8_t* data, int width, int height) {
-                if (!valid_) {
-                    return make_error(ErrorCode::ARCHIVE_CREATION_FAILED, last_error_, output_path_);
+        // Lossless WebP. effort 0-9 trades speed for size; negative keeps libwebp's default settings
+        Result<std::vector<uint8_t>> encode_webp(const std::string& filename, const uint8_t* data,
+                                                 const int width, const int height, const int effort,
+                                                 const std::filesystem::path& output_path) {
+            uint8_t* output = nullptr;
+            size_t output_size = 0;
+
+            if (effort < 0) {
+                output_size = WebPEncodeLosslessRGBA(data, width, height, width * 4, &output);
+            } else {
+                WebPConfig config;
+                WebPPicture picture;
+                if (!WebPConfigInit(&config) || !WebPConfigLosslessPreset(&config, std::min(effort, 9)) ||
+                    !WebPPictureInit(&picture)) {
+                    return make_error(ErrorCode::ENCODING_FAILED, "WebP encoder initialization failed", output_path);
+                }
+                config.exact = 1; // Alpha carries data (opacity), keep RGB under transparent pixels
+                picture.use_argb = 1;
+                picture.width = width;
+                picture.height = height;
+
+                WebPMemoryWriter writer;
+                WebPMemoryWriterInit(&writer);
+                picture.writer = WebPMemoryWrite;
+                picture.custom_ptr = &writer;
+
+                const bool ok = WebPPictureImportRGBA(&picture, data, width * 4) && WebPEncode(&config, &picture);
+                WebPPictureFree(&picture);
+                if (ok) {
+                    output = writer.mem;
+                    output_size = writer.size;
+                } else {
+                    WebPMemoryWriterClear(&writer);
+                }
+            }
+
+            if (output_size == 0 || !output) {
+                if (output) {
+                    WebPFree(output);
                 }
+                return make_error(ErrorCode::ENCODING_FAILED,
+                                  std::format("WebP encoding failed for '{}' ({}x{} image)",
+                                              filename, width, height),
+                                  output_path);
+            }
 
-                uint8_t* output = nullptr;
-                const size_t output_size = WebPEncodeLosslessRGBA(data, width, height, width * 4, &output);
+            std::vector<uint8_t> bytes(output, output + output_size);
+            WebPFree(output);
+            return bytes;
+        }
 
-                if (output_size == 0 || !output) {
-                    if (output) {
-                        WebPFree(output);
+        // Encoded archive entries handed from worker tasks to the writer, which takes them in slot order
+        class OrderedFiles {
+        public:
+            explicit OrderedFiles(std::vector<std::string> names) {
+                slots_.resize(names.size());
+                for (size_t i = 0; i < names.size(); ++i) {
+                    slots_[i].name = std::move(names[i]);
+                }
+            }
+
+            [[nodiscard]] size_t size() const { return slots_.size(); }
+            [[nodiscard]] const std::string& name(const size_t slot) const { return slots_[slot].name; }
+
+            // The first value set for a slot wins
+            void set(const size_t slot, Result<std::vector<uint8_t>> bytes) {
+                {
+                    std::lock_guard lock(mutex_);
+                    if (slots_[slot].bytes) {
+                        return;
+                    }
+                    slots_[slot].bytes = std::move(bytes);
+                }
+                ready_.notify_all();
+            }
+
+            // Blocks until the slot is set
+            [[nodiscard]] Result<std::vector<uint8_t>> take(const size_t slot) {
+                std::unique_lock lock(mutex_);
+                ready_.wait(lock, [&] { return slots_[slot].bytes.has_value(); });
+                auto bytes = std::move(*slots_[slot].bytes);
+                slots_[slot].bytes = Result<std::vector<uint8_t>>(); // Release memory, keep the slot marked as set
+                return bytes;
+            }
+
+        private:
+            struct Slot {
+                std::string name;
+                std::optional<Result<std::vector<uint8_t>>> bytes;
+            };
+
+            std::mutex mutex_;
+            std::condition_variable ready_;
+            std::vector<Slot> slots_;
+        };
+
+        // Wall time per export stage; stages run concurrently, so the entries overlap
+        class StageTimes {
+        public:
+            void add(std::string stage, const std::chrono::steady_clock::time_point start) {
+                const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                std::lock_guard lock(mutex_);
+                for (auto& [name, total] : entries_) {
+                    if (name == stage) {
+                        total += ms;
+                        return;
                     }
-                    return make_error(ErrorCode::ENCODING_FAILED,
-                                      std::format("WebP encoding failed for '{}' ({}x{} image)",
-                                                  filename, width, height),
-                                      output_path_);
                 }
+                entries_.emplace_back(std::move(stage), ms);
+            }
 
-                auto result = add_file(filename, output, output_size);
-                WebPFree(output);
-                return result;
+            [[nodiscard]] std::string summary() const {
+                std::lock_guard lock(mutex_);
+                std::string text;
+                for (const auto& [name, ms] : entries_) {
+                    text += std::format("{}{} {:.1f} ms", text.empty() ? "" : ", ", name, ms);
+                }
+                return text;
             }
+
+        private:
+            mutable std::mutex mutex_;
+            std::vector<std::pair<std::string, double>> entries_;
         };
 
         struct Cluster1dResult {
@@ -868,7 +1028,7 @@ namespace lfs::io {
             std::vector<uint8_t> labels;
         };
 
-        Cluster1dResult cluster1d(const float* data, int num_rows, int num_columns, int iterations) {
+        Cluster1dResult cluster1d(const float* data, int num_rows, int num_columns, int iterations, bool use_gpu) {
             const int total_points = num_rows * num_columns;
             std::vector<float> flat_data(total_points);
 
@@ -879,9 +1039,10 @@ namespace lfs::io {
             }
 
             auto data_tensor = Tensor::from_blob(flat_data.data(), {static_cast<size_t>(total_points), 1},
-                                                 Device::CPU, DataType::Float32)
-                                   .cuda();
-            auto [centroids_tensor, labels_tensor] = lfs::io::kmeans(data_tensor, 256, iterations);
+                                                 Device::CPU, DataType::Float32);
+            auto [centroids_tensor, labels_tensor] = use_gpu
+                                                         ? lfs::io::kmeans(data_tensor.cuda(), 256, iterations)
+                                                         : lfs::io::kmeans_1d_cpu(data_tensor, 256, iterations);
 
             auto centroids_cpu = centroids_tensor.cpu();
             auto labels_cpu = labels_tensor.cpu();
@@ -915,336 +1076,459 @@ namespace lfs::io {
             return result;
         }
 
-    } // anonymous namespace
-
-    Result<void> save_sog(const SplatData& splat_data, const SogSaveOptions& options) {
-        LOG_INFO("SOG write: {}", lfs::core::path_to_utf8(options.output_path));
+        // Writes to the file at options.output_path, or appends the archive to sink when given
+        Result<void> write_sog_archive(const SplatData& splat_data, const SogSaveOptions& options,
+                                       std::vector<uint8_t>* sink) {
+            LOG_INFO("SOG write: {}", sink ? "in memory" : lfs::core::path_to_utf8(options.output_path));
 
-        const auto report_progress = [&](float progress, const std::string& stage) -> bool {
-            return !options.progress_callback || options.progress_callback(progress, stage);
-        };
+            const auto report_progress = [&](float progress, const std::string& stage) -> bool {
+                return !options.progress_callback || options.progress_callback(progress, stage);
+            };
 
-        if (!report_progress(0.0f, "Initializing")) {
-            return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
-        }
+            if (!report_progress(0.0f, "Initializing")) {
+                return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
+            }
 
-        const int64_t num_rows = splat_data.size();
-        if (num_rows == 0) {
-            return make_error(ErrorCode::EMPTY_DATASET, "No splats to write", options.output_path);
-        }
+            const int64_t num_rows = splat_data.size();
+            if (num_rows == 0) {
+                return make_error(ErrorCode::EMPTY_DATASET, "No splats to write", options.output_path);
+            }
 
-        // Estimate output size: 5 base textures + optional SH, ~40% compression
-        const int width = static_cast<int>(std::ceil(std::sqrt(num_rows) / 4.0)) * 4;
-        const int height = static_cast<int>(std::ceil(static_cast<double>(num_rows) / width / 4.0)) * 4;
-        constexpr int CHANNELS = 4;
-        constexpr double COMPRESSION_RATIO = 0.4;
-        constexpr size_t OVERHEAD = 4096;
+            // Estimate output size: 5 base textures + optional SH, ~40% compression
+            const int width = static_cast<int>(std::ceil(std::sqrt(num_rows) / 4.0)) * 4;
+            const int height = static_cast<int>(std::ceil(static_cast<double>(num_rows) / width / 4.0)) * 4;
+            constexpr int CHANNELS = 4;
+            constexpr double COMPRESSION_RATIO = 0.4;
+            constexpr size_t OVERHEAD = 4096;
 
-        const size_t texture_size = static_cast<size_t>(width) * height * CHANNELS;
-        const int sh_degree = splat_data.get_max_sh_degree();
+            const size_t texture_size = static_cast<size_t>(width) * height * CHANNELS;
+            const int sh_degree = splat_data.get_max_sh_degree();
 
-        size_t estimated_size = texture_size * 5;
-        if (sh_degree > 0) {
-            estimated_size += texture_size * 2;
-        }
-        estimated_size = static_cast<size_t>(estimated_size * COMPRESSION_RATIO) + OVERHEAD;
+            size_t estimated_size = texture_size * 5;
+            if (sh_degree > 0) {
+                estimated_size += texture_size * 2;
+            }
+            estimated_size = static_cast<size_t>(estimated_size * COMPRESSION_RATIO) + OVERHEAD;
 
-        if (auto result = check_disk_space(options.output_path, estimated_size); !result) {
-            return std::unexpected(result.error());
-        }
+            if (!sink) {
+                if (auto result = check_disk_space(options.output_path, estimated_size); !result) {
+                    return std::unexpected(result.error());
+                }
 
-        if (auto result = verify_writable(options.output_path); !result) {
-            return std::unexpected(result.error());
-        }
+                if (auto result = verify_writable(options.output_path); !result) {
+                    return std::unexpected(result.error());
+                }
+            }
 
-        auto means_cuda = splat_data.means_raw().cuda();
-        auto morton_codes = morton_encode(means_cuda);
-        auto sort_indices_tensor = morton_sort_indices(morton_codes);
-        auto sort_indices_cpu = sort_indices_tensor.cpu();
-        const auto* indices = sort_indices_cpu.ptr<int64_t>();
+            StageTimes times;
+            auto stage_start = std::chrono::steady_clock::now();
+
+            // With use_gpu off the whole encode stays on the host and never touches CUDA
+            Tensor means_cpu;
+            Tensor sort_indices_cpu;
+            if (options.use_gpu) {
+                auto means_cuda = splat_data.means_raw().cuda();
+                auto morton_codes = morton_encode(means_cuda);
+                sort_indices_cpu = morton_sort_indices(morton_codes).cpu();
+                means_cpu = means_cuda.cpu();
+            } else {
+                means_cpu = splat_data.means_raw().cpu().contiguous();
+                auto morton_codes = morton_encode_cpu(means_cpu);
+                sort_indices_cpu = morton_sort_indices_cpu(morton_codes);
+            }
+            if (!sort_indices_cpu.is_valid()) {
+                return make_error(ErrorCode::INTERNAL_ERROR, "Morton sort failed", options.output_path);
+            }
+            const auto* indices = sort_indices_cpu.ptr<int64_t>();
+            times.add("Morton sort", stage_start);
+            stage_start = std::chrono::steady_clock::now();
+
+            // Host copies are taken up front so worker tasks only touch host memory
+            const auto rotations = splat_data.rotation_raw().cpu();
+            const auto scales = splat_data.scaling_raw().cpu();
+            const auto sh0 = splat_data.sh0_raw().cpu();
+            const auto opacity = splat_data.opacity_raw().cpu();
+            const Tensor shN = sh_degree > 0 ? splat_data.shN_raw().cpu() : Tensor();
+            times.add("Download", stage_start);
+
+            const auto archive = sink ? std::make_unique<SogArchive>(*sink, options.output_path)
+                                      : std::make_unique<SogArchive>(options.output_path);
+
+            // Check archive was created successfully
+            if (!archive->is_valid()) {
+                return make_error(ErrorCode::ARCHIVE_CREATION_FAILED, archive->last_error(), options.output_path);
+            }
 
-        auto means_cpu = means_cuda.cpu();
-        SogArchive archive(options.output_path);
+            enum Slot : size_t { MEANS_L, MEANS_U, QUATS, SCALES, SH0, SHN_CENTROIDS, SHN_LABELS };
+            std::vector<std::string> file_names = {"means_l.webp", "means_u.webp", "quats.webp", "scales.webp", "sh0.webp"};
+            if (sh_degree > 0) {
+                file_names.insert(file_names.end(), {"shN_centroids.webp", "shN_labels.webp"});
+            }
+            OrderedFiles files(file_names);
 
-        // Check archive was created successfully
-        if (!archive.is_valid()) {
-            return make_error(ErrorCode::ARCHIVE_CREATION_FAILED, archive.last_error(), options.output_path);
-        }
+            std::atomic<bool> cancelled{false};
+            std::mutex gpu_mutex; // GPU k-means calls are not made concurrently
 
-        const auto write_webp = [&](const std::string& filename,
-                                    const uint8_t* data, int w, int h) -> Result<void> {
-            return archive.add_webp(filename, data, w, h);
-        };
+            const auto encode = [&](const size_t slot, const std::vector<uint8_t>& rgba, const int w, const int h) {
+                if (cancelled) {
+                    files.set(slot, make_error(ErrorCode::CANCELLED, "Export cancelled by user"));
+                    return;
+                }
+                const auto start = std::chrono::steady_clock::now();
+                files.set(slot, encode_webp(files.name(slot), rgba.data(), w, h, options.webp_effort, options.output_path));
+                times.add("WebP " + files.name(slot), start);
+            };
 
-        if (!report_progress(0.10f, "Positions")) {
-            return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
-        }
+            const auto cluster = [&](const float* data, const int rows, const int columns) {
+                if (!options.use_gpu) {
+                    return cluster1d(data, rows, columns, options.kmeans_iterations, false);
+                }
+                std::lock_guard lock(gpu_mutex);
+                return cluster1d(data, rows, columns, options.kmeans_iterations, true);
+            };
 
-        const auto* means_ptr = means_cpu.ptr<float>();
+            if (!report_progress(0.10f, "Encoding textures")) {
+                return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
+            }
 
-        std::array<std::array<double, 2>, 3> means_min_max = {{{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()},
-                                                               {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()},
-                                                               {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()}}};
+            tbb::task_group tasks;
 
-        for (int64_t i = 0; i < num_rows; ++i) {
-            const int64_t idx = indices[i];
-            for (int d = 0; d < 3; ++d) {
-                const double v = log_transform(static_cast<double>(means_ptr[idx * 3 + d]));
-                means_min_max[d][0] = std::min(means_min_max[d][0], v);
-                means_min_max[d][1] = std::max(means_min_max[d][1], v);
-            }
-        }
+            // Each task fills its slots; anything it leaves unset (exception, cancel) is failed so the writer never blocks
+            const auto spawn = [&](const std::initializer_list<size_t> slots, auto body) {
+                tasks.run([&files, &cancelled, owned = std::vector<size_t>(slots), body] {
+                    try {
+                        if (!cancelled) {
+                            body();
+                        }
+                    } catch (const std::exception& e) {
+                        for (const size_t slot : owned) {
+                            files.set(slot, make_error(ErrorCode::INTERNAL_ERROR,
+                                                       std::format("Failed to build '{}': {}", files.name(slot), e.what())));
+                        }
+                    }
+                    for (const size_t slot : owned) {
+                        files.set(slot, make_error(ErrorCode::CANCELLED, "Export cancelled by user"));
+                    }
+                });
+            };
 
-        std::vector<uint8_t> means_l(width * height * CHANNELS, 0);
-        std::vector<uint8_t> means_u(width * height * CHANNELS, 0);
-
-        for (int64_t i = 0; i < num_rows; ++i) {
-            const int64_t idx = indices[i];
-            const double x = 65535.0 * (log_transform(static_cast<double>(means_ptr[idx * 3 + 0])) - means_min_max[0][0]) /
-                             (means_min_max[0][1] - means_min_max[0][0]);
-            const double y = 65535.0 * (log_transform(static_cast<double>(means_ptr[idx * 3 + 1])) - means_min_max[1][0]) /
-                             (means_min_max[1][1] - means_min_max[1][0]);
-            const double z = 65535.0 * (log_transform(static_cast<double>(means_ptr[idx * 3 + 2])) - means_min_max[2][0]) /
-                             (means_min_max[2][1] - means_min_max[2][0]);
-
-            const auto x16 = static_cast<uint16_t>(std::clamp(x, 0.0, 65535.0));
-            const auto y16 = static_cast<uint16_t>(std::clamp(y, 0.0, 65535.0));
-            const auto z16 = static_cast<uint16_t>(std::clamp(z, 0.0, 65535.0));
-
-            const auto ti = static_cast<int>(i);
-            means_l[ti * 4 + 0] = x16 & 0xff;
-            means_l[ti * 4 + 1] = y16 & 0xff;
-            means_l[ti * 4 + 2] = z16 & 0xff;
-            means_l[ti * 4 + 3] = 0xff;
-
-            means_u[ti * 4 + 0] = (x16 >> 8) & 0xff;
-            means_u[ti * 4 + 1] = (y16 >> 8) & 0xff;
-            means_u[ti * 4 + 2] = (z16 >> 8) & 0xff;
-            means_u[ti * 4 + 3] = 0xff;
-        }
+            const auto* means_ptr = means_cpu.ptr<float>();
 
-        if (auto result = write_webp("means_l.webp", means_l.data(), width, height); !result) {
-            return std::unexpected(result.error());
-        }
-        if (auto result = write_webp("means_u.webp", means_u.data(), width, height); !result) {
-            return std::unexpected(result.error());
-        }
+            std::array<std::array<double, 2>, 3> means_min_max = {{{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()},
+                                                                   {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()},
+                                                                   {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()}}};
 
-        if (!report_progress(0.20f, "Rotations")) {
-            return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
-        }
+            spawn({MEANS_L, MEANS_U}, [&] {
+                const auto start = std::chrono::steady_clock::now();
+                for (int64_t i = 0; i < num_rows; ++i) {
+                    const int64_t idx = indices[i];
+                    for (int d = 0; d < 3; ++d) {
+                        const double v = log_transform(static_cast<double>(means_ptr[idx * 3 + d]));
+                        means_min_max[d][0] = std::min(means_min_max[d][0], v);
+                        means_min_max[d][1] = std::max(means_min_max[d][1], v);
+                    }
+                }
 
-        auto rotations = splat_data.rotation_raw().cpu();
-        const auto* rot_ptr = rotations.ptr<float>();
+                std::vector<uint8_t> means_l(width * height * CHANNELS, 0);
+                std::vector<uint8_t> means_u(width * height * CHANNELS, 0);
+
+                for (int64_t i = 0; i < num_rows; ++i) {
+                    const int64_t idx = indices[i];
+                    const double x = 65535.0 * (log_transform(static_cast<double>(means_ptr[idx * 3 + 0])) - means_min_max[0][0]) /
+                                     (means_min_max[0][1] - means_min_max[0][0]);
+                    const double y = 65535.0 * (log_transform(static_cast<double>(means_ptr[idx * 3 + 1])) - means_min_max[1][0]) /
+                                     (means_min_max[1][1] - means_min_max[1][0]);
+                    const double z = 65535.0 * (log_transform(static_cast<double>(means_ptr[idx * 3 + 2])) - means_min_max[2][0]) /
+                                     (means_min_max[2][1] - means_min_max[2][0]);
+
+                    const auto x16 = static_cast<uint16_t>(std::clamp(x, 0.0, 65535.0));
+                    const auto y16 = static_cast<uint16_t>(std::clamp(y, 0.0, 65535.0));
+                    const auto z16 = static_cast<uint16_t>(std::clamp(z, 0.0, 65535.0));
+
+                    const auto ti = static_cast<int>(i);
+                    means_l[ti * 4 + 0] = x16 & 0xff;
+                    means_l[ti * 4 + 1] = y16 & 0xff;
+                    means_l[ti * 4 + 2] = z16 & 0xff;
+                    means_l[ti * 4 + 3] = 0xff;
+
+                    means_u[ti * 4 + 0] = (x16 >> 8) & 0xff;
+                    means_u[ti * 4 + 1] = (y16 >> 8) & 0xff;
+                    means_u[ti * 4 + 2] = (z16 >> 8) & 0xff;
+                    means_u[ti * 4 + 3] = 0xff;
+                }
+                times.add("Positions", start);
 
-        std::vector<uint8_t> quats(width * height * CHANNELS, 0);
+                tbb::parallel_invoke([&] { encode(MEANS_L, means_l, width, height); },
+                                     [&] { encode(MEANS_U, means_u, width, height); });
+            });
 
-        for (int64_t i = 0; i < num_rows; ++i) {
-            const int64_t idx = indices[i];
-            float q[4] = {rot_ptr[idx * 4 + 0], rot_ptr[idx * 4 + 1], rot_ptr[idx * 4 + 2], rot_ptr[idx * 4 + 3]};
+            spawn({QUATS}, [&] {
+                const auto start = std::chrono::steady_clock::now();
+                const auto* rot_ptr = rotations.ptr<float>();
 
-            const float len = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
-            for (float& j : q)
-                j /= len;
+                std::vector<uint8_t> quats(width * height * CHANNELS, 0);
 
-            int max_comp = 0;
-            for (int j = 1; j < 4; ++j) {
-                if (std::abs(q[j]) > std::abs(q[max_comp]))
-                    max_comp = j;
-            }
+                for (int64_t i = 0; i < num_rows; ++i) {
+                    const int64_t idx = indices[i];
+                    float q[4] = {rot_ptr[idx * 4 + 0], rot_ptr[idx * 4 + 1], rot_ptr[idx * 4 + 2], rot_ptr[idx * 4 + 3]};
 
-            if (q[max_comp] < 0) {
-                for (float& j : q)
-                    j *= -1;
-            }
+                    const float len = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+                    for (float& j : q)
+                        j /= len;
 
-            constexpr float SQRT2 = 1.41421356237f;
-            for (float& j : q)
-                j *= SQRT2;
+                    int max_comp = 0;
+                    for (int j = 1; j < 4; ++j) {
+                        if (std::abs(q[j]) > std::abs(q[max_comp]))
+                            max_comp = j;
+                    }
 
-            static const int IDX_TABLE[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
-            const int* other_idx = IDX_TABLE[max_comp];
+                    if (q[max_comp] < 0) {
+                        for (float& j : q)
+                            j *= -1;
+                    }
 
-            const auto ti = static_cast<int>(i);
-            quats[ti * 4 + 0] = static_cast<uint8_t>(255.0f * (q[other_idx[0]] * 0.5f + 0.5f));
-            quats[ti * 4 + 1] = static_cast<uint8_t>(255.0f * (q[other_idx[1]] * 0.5f + 0.5f));
-            quats[ti * 4 + 2] = static_cast<uint8_t>(255.0f * (q[other_idx[2]] * 0.5f + 0.5f));
-            quats[ti * 4 + 3] = 252 + max_comp;
-        }
+                    constexpr float SQRT2 = 1.41421356237f;
+                    for (float& j : q)
+                        j *= SQRT2;
 
-        if (auto result = write_webp("quats.webp", quats.data(), width, height); !result) {
-            return std::unexpected(result.error());
-        }
+                    static const int IDX_TABLE[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+                    const int* other_idx = IDX_TABLE[max_comp];
 
-        if (!report_progress(0.30f, "Scales k-means")) {
-            return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
-        }
+                    const auto ti = static_cast<int>(i);
+                    quats[ti * 4 + 0] = static_cast<uint8_t>(255.0f * (q[other_idx[0]] * 0.5f + 0.5f));
+                    quats[ti * 4 + 1] = static_cast<uint8_t>(255.0f * (q[other_idx[1]] * 0.5f + 0.5f));
+                    quats[ti * 4 + 2] = static_cast<uint8_t>(255.0f * (q[other_idx[2]] * 0.5f + 0.5f));
+                    quats[ti * 4 + 3] = 252 + max_comp;
+                }
+                times.add("Rotations", start);
 
-        auto scales = splat_data.scaling_raw().cpu();
-        const auto* scales_ptr = scales.ptr<float>();
+                encode(QUATS, quats, width, height);
+            });
 
-        auto scale_result = cluster1d(scales_ptr, num_rows, 3, options.kmeans_iterations);
+            Cluster1dResult scale_result;
+            spawn({SCALES}, [&] {
+                const auto start = std::chrono::steady_clock::now();
+                scale_result = cluster(scales.ptr<float>(), num_rows, 3);
 
-        std::vector<uint8_t> scales_data(width * height * CHANNELS, 0);
-        for (int64_t i = 0; i < num_rows; ++i) {
-            const int64_t idx = indices[i];
-            const auto ti = static_cast<int>(i);
+                std::vector<uint8_t> scales_data(width * height * CHANNELS, 0);
+                for (int64_t i = 0; i < num_rows; ++i) {
+                    const int64_t idx = indices[i];
+                    const auto ti = static_cast<int>(i);
 
-            scales_data[ti * 4 + 0] = scale_result.labels[0 * num_rows + idx];
-            scales_data[ti * 4 + 1] = scale_result.labels[1 * num_rows + idx];
-            scales_data[ti * 4 + 2] = scale_result.labels[2 * num_rows + idx];
-            scales_data[ti * 4 + 3] = 0xff;
-        }
+                    scales_data[ti * 4 + 0] = scale_result.labels[0 * num_rows + idx];
+                    scales_data[ti * 4 + 1] = scale_result.labels[1 * num_rows + idx];
+                    scales_data[ti * 4 + 2] = scale_result.labels[2 * num_rows + idx];
+                    scales_data[ti * 4 + 3] = 0xff;
+                }
+                times.add("Scales k-means", start);
 
-        if (auto result = write_webp("scales.webp", scales_data.data(), width, height); !result) {
-            return std::unexpected(result.error());
-        }
+                encode(SCALES, scales_data, width, height);
+            });
 
-        if (!report_progress(0.45f, "Colors k-means")) {
-            return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
-        }
+            Cluster1dResult color_result;
+            spawn({SH0}, [&] {
+                const auto start = std::chrono::steady_clock::now();
+                color_result = cluster(sh0.ptr<float>(), num_rows, 3);
+                const auto* opacity_ptr = opacity.ptr<float>();
+
+                std::vector<uint8_t> sh0_data(width * height * CHANNELS, 0);
+                for (int64_t i = 0; i < num_rows; ++i) {
+                    const int64_t idx = indices[i];
+                    const auto ti = static_cast<int>(i);
+
+                    sh0_data[ti * 4 + 0] = color_result.labels[0 * num_rows + idx];
+                    sh0_data[ti * 4 + 1] = color_result.labels[1 * num_rows + idx];
+                    sh0_data[ti * 4 + 2] = color_result.labels[2 * num_rows + idx];
+                    sh0_data[ti * 4 + 3] = static_cast<uint8_t>(
+                        std::max(0.0, std::min(255.0, sigmoid(static_cast<double>(opacity_ptr[idx])) * 255.0)));
+                }
+                times.add("Colors k-means", start);
 
-        auto sh0 = splat_data.sh0_raw().cpu();
-        const auto* sh0_ptr = sh0.ptr<float>();
+                encode(SH0, sh0_data, width, height);
+            });
 
-        auto color_result = cluster1d(sh0_ptr, num_rows, 3, options.kmeans_iterations);
+            nlohmann::json sh_n_meta;
 
-        auto opacity = splat_data.opacity_raw().cpu();
-        const auto* opacity_ptr = opacity.ptr<float>();
+            if (sh_degree > 0) {
+                spawn({SHN_CENTROIDS, SHN_LABELS}, [&] {
+                    const auto start = std::chrono::steady_clock::now();
+                    const auto* shN_ptr = shN.ptr<float>();
 
-        std::vector<uint8_t> sh0_data(width * height * CHANNELS, 0);
-        for (int64_t i = 0; i < num_rows; ++i) {
-            const int64_t idx = indices[i];
-            const auto ti = static_cast<int>(i);
+                    static const int SH_COEFFS_TABLE[] = {0, 3, 8, 15};
+                    const int sh_coeffs = SH_COEFFS_TABLE[sh_degree];
+                    const int sh_dims = sh_coeffs * 3;
 
-            sh0_data[ti * 4 + 0] = color_result.labels[0 * num_rows + idx];
-            sh0_data[ti * 4 + 1] = color_result.labels[1 * num_rows + idx];
-            sh0_data[ti * 4 + 2] = color_result.labels[2 * num_rows + idx];
-            sh0_data[ti * 4 + 3] = static_cast<uint8_t>(
-                std::max(0.0, std::min(255.0, sigmoid(static_cast<double>(opacity_ptr[idx])) * 255.0)));
-        }
+                    int palette_size = std::min(64, static_cast<int>(std::pow(2, std::floor(std::log2(num_rows / 1024.0))))) * 1024;
+                    palette_size = std::clamp(palette_size, 1024, static_cast<int>(num_rows));
 
-        if (auto result = write_webp("sh0.webp", sh0_data.data(), width, height); !result) {
-            return std::unexpected(result.error());
-        }
+                    std::vector<float> shN_flat(num_rows * sh_dims);
+                    for (int64_t i = 0; i < num_rows; ++i) {
+                        for (int c = 0; c < 3; ++c) {
+                            for (int j = 0; j < sh_coeffs; ++j) {
+                                const int their_col = c * sh_coeffs + j;
+                                shN_flat[i * sh_dims + their_col] = shN_ptr[i * sh_coeffs * 3 + j * 3 + c];
+                            }
+                        }
+                    }
 
-        nlohmann::json sh_n_meta;
+                    auto shN_tensor = Tensor::from_blob(shN_flat.data(),
+                                                        {static_cast<size_t>(num_rows), static_cast<size_t>(sh_dims)}, Device::CPU, DataType::Float32);
+                    Tensor sh_centroids_cpu;
+                    Tensor sh_labels_cpu;
+                    if (options.use_gpu) {
+                        std::lock_guard lock(gpu_mutex);
+                        auto [sh_centroids, sh_labels] = lfs::io::kmeans(shN_tensor.cuda(), palette_size, options.kmeans_iterations);
+                        sh_centroids_cpu = sh_centroids.cpu();
+                        sh_labels_cpu = sh_labels.cpu();
+                    } else {
+                        std::tie(sh_centroids_cpu, sh_labels_cpu) = lfs::io::kmeans_cpu(shN_tensor, palette_size, options.kmeans_iterations);
+                    }
 
-        if (sh_degree > 0) {
-            if (!report_progress(0.60f, "SH k-means")) {
-                return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
-            }
+                    const auto* sh_centroids_ptr = static_cast<const float*>(sh_centroids_cpu.data_ptr());
+                    const int actual_palette_size = sh_centroids_cpu.size(0);
 
-            auto shN = splat_data.shN_raw().cpu();
-            const auto* shN_ptr = shN.ptr<float>();
+                    auto codebook_result = cluster(sh_centroids_ptr, actual_palette_size, sh_dims);
 
-            static const int SH_COEFFS_TABLE[] = {0, 3, 8, 15};
-            const int sh_coeffs = SH_COEFFS_TABLE[sh_degree];
-            const int sh_dims = sh_coeffs * 3;
+                    const int centroids_width = 64 * sh_coeffs;
+                    const int centroids_height = (actual_palette_size + 63) / 64;
 
-            int palette_size = std::min(64, static_cast<int>(std::pow(2, std::floor(std::log2(num_rows / 1024.0))))) * 1024;
-            palette_size = std::clamp(palette_size, 1024, static_cast<int>(num_rows));
+                    std::vector<uint8_t> centroids_buf(centroids_width * centroids_height * CHANNELS, 0);
 
-            std::vector<float> shN_flat(num_rows * sh_dims);
-            for (int64_t i = 0; i < num_rows; ++i) {
-                for (int c = 0; c < 3; ++c) {
-                    for (int j = 0; j < sh_coeffs; ++j) {
-                        const int their_col = c * sh_coeffs + j;
-                        shN_flat[i * sh_dims + their_col] = shN_ptr[i * sh_coeffs * 3 + j * 3 + c];
+                    for (int i = 0; i < actual_palette_size; ++i) {
+                        for (int j = 0; j < sh_coeffs; ++j) {
+                            const int pixel_idx = i * sh_coeffs + j;
+                            for (int c = 0; c < 3; ++c) {
+                                const int col_idx = sh_coeffs * c + j;
+                                const int label_idx = col_idx * actual_palette_size + i;
+                                centroids_buf[pixel_idx * 4 + c] = codebook_result.labels[label_idx];
+                            }
+                            centroids_buf[pixel_idx * 4 + 3] = 0xff;
+                        }
                     }
-                }
-            }
 
-            auto shN_tensor = Tensor::from_blob(shN_flat.data(),
-                                                {static_cast<size_t>(num_rows), static_cast<size_t>(sh_dims)}, Device::CPU, DataType::Float32)
-                                  .cuda();
-            auto [sh_centroids, sh_labels] = lfs::io::kmeans(shN_tensor, palette_size, options.kmeans_iterations);
+                    const auto* sh_labels_ptr = static_cast<const int32_t*>(sh_labels_cpu.data_ptr());
 
-            auto sh_centroids_cpu = sh_centroids.cpu();
-            const auto* sh_centroids_ptr = static_cast<const float*>(sh_centroids_cpu.data_ptr());
-            const int actual_palette_size = sh_centroids.size(0);
+                    std::vector<uint8_t> labels_buf(width * height * CHANNELS, 0);
+                    for (int64_t i = 0; i < num_rows; ++i) {
+                        const int64_t idx = indices[i];
+                        const int32_t label = sh_labels_ptr[idx];
+                        const auto ti = static_cast<int>(i);
 
-            auto codebook_result = cluster1d(sh_centroids_ptr, actual_palette_size, sh_dims, options.kmeans_iterations);
+                        labels_buf[ti * 4 + 0] = label & 0xff;
+                        labels_buf[ti * 4 + 1] = (label >> 8) & 0xff;
+                        labels_buf[ti * 4 + 2] = 0;
+                        labels_buf[ti * 4 + 3] = 0xff;
+                    }
+                    times.add("SH k-means", start);
 
-            const int centroids_width = 64 * sh_coeffs;
-            const int centroids_height = (actual_palette_size + 63) / 64;
+                    sh_n_meta["count"] = actual_palette_size;
+                    sh_n_meta["bands"] = sh_degree;
+                    sh_n_meta["codebook"] = codebook_result.centroids;
+                    sh_n_meta["files"] = {"shN_centroids.webp", "shN_labels.webp"};
 
-            std::vector<uint8_t> centroids_buf(centroids_width * centroids_height * CHANNELS, 0);
+                    tbb::parallel_invoke([&] { encode(SHN_CENTROIDS, centroids_buf, centroids_width, centroids_height); },
+                                         [&] { encode(SHN_LABELS, labels_buf, width, height); });
+                });
+            }
 
-            for (int i = 0; i < actual_palette_size; ++i) {
-                for (int j = 0; j < sh_coeffs; ++j) {
-                    const int pixel_idx = i * sh_coeffs + j;
-                    for (int c = 0; c < 3; ++c) {
-                        const int col_idx = sh_coeffs * c + j;
-                        const int label_idx = col_idx * actual_palette_size + i;
-                        centroids_buf[pixel_idx * 4 + c] = codebook_result.labels[label_idx];
+            // Stream files into the archive in a fixed order as they become ready. The writer gets its
+            // own thread so that this one can run encode tasks in tasks.wait(): the producers must never
+            // depend on TBB workers (there may be none, or the exporter may itself be running on one).
+            // Progress is therefore reported from the writer thread.
+            Result<void> status;
+            std::jthread writer([&] {
+                try {
+                    for (size_t slot = 0; slot < files.size(); ++slot) {
+                        auto encoded = files.take(slot);
+                        if (!encoded) {
+                            status = std::unexpected(encoded.error());
+                            break;
+                        }
+                        const auto start = std::chrono::steady_clock::now();
+                        status = archive->add_file(files.name(slot), encoded->data(), encoded->size());
+                        times.add("Archive write", start);
+                        if (!status) {
+                            break;
+                        }
+                        const float progress = 0.10f + 0.80f * static_cast<float>(slot + 1) / static_cast<float>(files.size());
+                        if (!report_progress(progress, files.name(slot))) {
+                            status = make_error(ErrorCode::CANCELLED, "Export cancelled by user");
+                            break;
+                        }
                     }
-                    centroids_buf[pixel_idx * 4 + 3] = 0xff;
+                } catch (const std::exception& e) {
+                    status = make_error(ErrorCode::INTERNAL_ERROR, std::format("Archive writer failed: {}", e.what()));
+                }
+                if (!status) {
+                    cancelled = true;
+                }
+            });
+
+            tasks.wait();
+            writer.join();
+            if (!status) {
+                auto error = status.error();
+                if (error.path.empty()) {
+                    error.path = options.output_path;
                 }
+                return std::unexpected(std::move(error));
             }
 
-            if (auto result = write_webp("shN_centroids.webp", centroids_buf.data(), centroids_width, centroids_height); !result) {
-                return std::unexpected(result.error());
+            if (!report_progress(0.90f, "Writing meta")) {
+                return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
             }
 
-            auto sh_labels_cpu = sh_labels.cpu();
-            const auto* sh_labels_ptr = static_cast<const int32_t*>(sh_labels_cpu.data_ptr());
+            nlohmann::json meta;
+            meta["version"] = 2;
+            meta["asset"]["generator"] = "LichtFeld Studio";
+            meta["count"] = num_rows;
+
+            meta["means"]["mins"] = {means_min_max[0][0], means_min_max[1][0], means_min_max[2][0]};
+            meta["means"]["maxs"] = {means_min_max[0][1], means_min_max[1][1], means_min_max[2][1]};
+            meta["means"]["files"] = {"means_l.webp", "means_u.webp"};
+
+            meta["scales"]["codebook"] = scale_result.centroids;
+            meta["scales"]["files"] = {"scales.webp"};
 
-            std::vector<uint8_t> labels_buf(width * height * CHANNELS, 0);
-            for (int64_t i = 0; i < num_rows; ++i) {
-                const int64_t idx = indices[i];
-                const int32_t label = sh_labels_ptr[idx];
-                const auto ti = static_cast<int>(i);
+            meta["quats"]["files"] = {"quats.webp"};
 
-                labels_buf[ti * 4 + 0] = label & 0xff;
-                labels_buf[ti * 4 + 1] = (label >> 8) & 0xff;
-                labels_buf[ti * 4 + 2] = 0;
-                labels_buf[ti * 4 + 3] = 0xff;
+            meta["sh0"]["codebook"] = color_result.centroids;
+            meta["sh0"]["files"] = {"sh0.webp"};
+
+            if (sh_degree > 0) {
+                meta["shN"] = sh_n_meta;
             }
 
-            if (auto result = write_webp("shN_labels.webp", labels_buf.data(), width, height); !result) {
+            std::string meta_json = meta.dump();
+            if (auto result = archive->add_file("meta.json", meta_json.c_str(), meta_json.size()); !result) {
                 return std::unexpected(result.error());
             }
 
-            sh_n_meta["count"] = actual_palette_size;
-            sh_n_meta["bands"] = sh_degree;
-            sh_n_meta["codebook"] = codebook_result.centroids;
-            sh_n_meta["files"] = {"shN_centroids.webp", "shN_labels.webp"};
-        }
+            if (sink) {
+                if (auto result = archive->close(); !result) {
+                    return std::unexpected(result.error());
+                }
+            }
 
-        if (!report_progress(0.90f, "Writing meta")) {
-            return make_error(ErrorCode::CANCELLED, "Export cancelled by user");
+            LOG_INFO("SOG export complete: {} splats", num_rows);
+            LOG_PERF("SOG export stages: {}", times.summary());
+            report_progress(1.0f, "Complete");
+            return {};
         }
 
-        nlohmann::json meta;
-        meta["version"] = 2;
-        meta["asset"]["generator"] = "LichtFeld Studio";
-        meta["count"] = num_rows;
-
-        meta["means"]["mins"] = {means_min_max[0][0], means_min_max[1][0], means_min_max[2][0]};
-        meta["means"]["maxs"] = {means_min_max[0][1], means_min_max[1][1], means_min_max[2][1]};
-        meta["means"]["files"] = {"means_l.webp", "means_u.webp"};
-
-        meta["scales"]["codebook"] = scale_result.centroids;
-        meta["scales"]["files"] = {"scales.webp"};
-
-        meta["quats"]["files"] = {"quats.webp"};
-
-        meta["sh0"]["codebook"] = color_result.centroids;
-        meta["sh0"]["files"] = {"sh0.webp"};
+    } // anonymous namespace
 
-        if (sh_degree > 0) {
-            meta["shN"] = sh_n_meta;
-        }
+    Result<void> save_sog(const SplatData& splat_data, const SogSaveOptions& options) {
+        LFS_TRACE_SCOPE(Export, "save_sog");
+        return write_sog_archive(splat_data, options, nullptr);
+    }
 
-        std::string meta_json = meta.dump();
-        if (auto result = archive.add_file("meta.json", meta_json.c_str(), meta_json.size()); !result) {
+    Result<std::vector<uint8_t>> save_sog_to_memory(const SplatData& splat_data, const SogSaveOptions& options) {
+        std::vector<uint8_t> buffer;
+        if (auto result = write_sog_archive(splat_data, options, &buffer); !result) {
             return std::unexpected(result.error());
         }
-
-        LOG_INFO("SOG export complete: {} splats", num_rows);
-        report_progress(1.0f, "Complete");
-        return {};
+        return buffer;
     }
 
 } // namespace lfs::io
\ No newline at end of file
@@ -12,7 +12,13 @@ namespace lfs::io {
     // Alias for backward compatibility
     using SogProgressCallback = ExportProgressCallback;
 
+    // Internal: Builds the SOG archive in memory instead of writing options.output_path,
+    // which is then only used for error reporting
+    [[nodiscard]] Result<std::vector<uint8_t>> save_sog_to_memory(const SplatData& splat_data,
+                                                                 const SogSaveOptions& options);
+
     // Internal: Loading function (not in public API)
-    std::expected<SplatData, std::string> load_sog(const std::filesystem::path& filepath);
+    std::expected<SplatData, std::string> load_sog(const std::filesystem::path& filepath,
+                                                   lfs::core::Device device = lfs::core::Device::CUDA);
 
 } // namespace lfs::io
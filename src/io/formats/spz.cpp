@@ -5,6 +5,7 @@
 #include "spz.hpp"
 #include "core/logger.hpp"
 #include "core/path_utils.hpp"
+#include "core/perf_trace.hpp"
 #include "core/tensor.hpp"
 #include "load-spz.h"
 #include <chrono>
@@ -22,7 +23,8 @@ namespace lfs::io {
         constexpr int SH_COEFFS_FOR_DEGREE[] = {0, 3, 8, 15};
         constexpr float SCENE_SCALE = 0.5f; // Match PLY loader
 
-        SplatData convert_from_spz(const spz::GaussianCloud& cloud) {
+        // Decodes on the host, then moves to `device` in one transfer per attribute
+        SplatData convert_from_spz(const spz::GaussianCloud& cloud, const Device device) {
             const auto num_points = static_cast<size_t>(cloud.numPoints);
             const int sh_degree = cloud.shDegree;
             const auto sh_coeffs = sh_degree > 0 ? static_cast<size_t>(SH_COEFFS_FOR_DEGREE[sh_degree]) : 0;
@@ -66,6 +68,17 @@ namespace lfs::io {
                 std::copy(cloud.sh.begin(), cloud.sh.end(), shN_ptr);
             }
 
+            if (device != Device::CPU) {
+                means = means.to(device);
+                sh0 = sh0.to(device);
+                scaling = scaling.to(device);
+                rotation = rotation.to(device);
+                opacity = opacity.to(device);
+                if (shN.is_valid()) {
+                    shN = shN.to(device);
+                }
+            }
+
             return SplatData(
                 sh_degree,
                 std::move(means),
@@ -132,7 +145,7 @@ namespace lfs::io {
         }
     } // namespace
 
-    std::expected<SplatData, std::string> load_spz(const std::filesystem::path& filepath) {
+    std::expected<SplatData, std::string> load_spz(const std::filesystem::path& filepath, const Device device) {
         auto start = std::chrono::high_resolution_clock::now();
 
         LOG_INFO("Loading SPZ file: {}", lfs::core::path_to_utf8(filepath));
@@ -148,7 +161,7 @@ namespace lfs::io {
 
         LOG_DEBUG("SPZ loaded: {} points, SH degree {}", cloud.numPoints, cloud.shDegree);
 
-        auto splat = convert_from_spz(cloud);
+        auto splat = convert_from_spz(cloud, device);
 
         auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::high_resolution_clock::now() - start);
@@ -159,6 +172,7 @@ namespace lfs::io {
     }
 
     Result<void> save_spz(const SplatData& splat_data, const SpzSaveOptions& options) {
+        LFS_TRACE_SCOPE(Export, "save_spz");
         auto start = std::chrono::high_resolution_clock::now();
 
         LOG_INFO("Saving SPZ file: {}", lfs::core::path_to_utf8(options.output_path));
@@ -14,7 +14,8 @@ namespace lfs::io {
     using lfs::core::SplatData;
 
     // Load SPZ (Niantic compressed gaussian splat format)
-    std::expected<SplatData, std::string> load_spz(const std::filesystem::path& filepath);
+    std::expected<SplatData, std::string> load_spz(const std::filesystem::path& filepath,
+                                                   lfs::core::Device device = lfs::core::Device::CUDA);
 
     // Save SPZ format
     struct SpzSaveOptions {
@@ -4,7 +4,9 @@
 
 #pragma once
 
-#include <chrono>
+#include "io/decoded_image_pack.hpp"
+#include "io/lru_cache.hpp"
+
 #include <filesystem>
 #include <memory>
 #include <mutex>
@@ -33,6 +35,7 @@ namespace lfs::io {
     inline constexpr int DEFAULT_PRINT_STATUS_FREQ = 500;
     inline constexpr int DEFAULT_DECODER_POOL_SIZE = 8;
     inline constexpr std::string_view CACHE_PREFIX = "lfs_cache_";
+    inline constexpr std::size_t DECODED_CACHE_MAX_BYTES = 16 * BYTES_PER_GB;
 
     struct LoadParams {
         int resize_factor = 1;
@@ -46,7 +49,6 @@ namespace lfs::io {
         int height = 0;
         int channels = 0;
         std::size_t size_bytes = 0;
-        std::chrono::steady_clock::time_point last_access;
     };
 
     struct CachedJpegBlob {
@@ -54,7 +56,6 @@ namespace lfs::io {
         int original_width = 0;
         int original_height = 0;
         std::size_t size_bytes = 0;
-        std::chrono::steady_clock::time_point last_access;
     };
 
     class CacheLoader {
@@ -76,7 +77,6 @@ namespace lfs::io {
 
         [[nodiscard]] lfs::core::Tensor load_cached_image(const std::filesystem::path& path, const LoadParams& params);
 
-        void create_new_cache_folder();
         void reset_cache();
         void clean_cache_folders();
         void clear_cpu_cache();
@@ -88,6 +88,11 @@ namespace lfs::io {
         [[nodiscard]] CacheMode get_cache_mode() const { return cache_mode_; }
         void set_num_expected_images(int num_expected_images) { num_expected_images_ = num_expected_images; }
 
+        [[nodiscard]] LruCacheStats get_cpu_cache_stats() const { return cpu_cache_.stats(); }
+        [[nodiscard]] LruCacheStats get_jpeg_blob_cache_stats() const { return jpeg_blob_cache_.stats(); }
+        // Summed over the packs opened since the last reset_cache()
+        [[nodiscard]] DecodedImagePackStats get_decoded_cache_stats() const;
+
         static std::string to_string(CacheMode mode);
 
     private:
@@ -95,12 +100,12 @@ namespace lfs::io {
 
         [[nodiscard]] lfs::core::Tensor load_cached_image_from_cpu(const std::filesystem::path& path, const LoadParams& params);
         [[nodiscard]] lfs::core::Tensor load_cached_image_from_fs(const std::filesystem::path& path, const LoadParams& params);
+        [[nodiscard]] DecodedImagePack& get_decoded_pack(const std::filesystem::path& image_path);
         [[nodiscard]] lfs::core::Tensor load_jpeg_with_hardware_decode(const std::filesystem::path& path, const LoadParams& params);
 
         [[nodiscard]] std::string generate_cache_key(const std::filesystem::path& path, const LoadParams& params) const;
         [[nodiscard]] bool has_sufficient_memory(std::size_t required_bytes) const;
-        [[nodiscard]] std::size_t get_cpu_cache_size() const;
-        [[nodiscard]] std::size_t get_jpeg_blob_cache_size() const;
+        [[nodiscard]] std::size_t memory_deficit(std::size_t required_bytes) const;
         [[nodiscard]] bool is_jpeg_format(const std::filesystem::path& path) const;
 
         void evict_if_needed(std::size_t required_bytes);
@@ -118,20 +123,23 @@ namespace lfs::io {
         bool use_cpu_memory_;
         float min_cpu_free_memory_ratio_ = DEFAULT_MIN_FREE_MEMORY_RATIO;
         float min_cpu_free_GB_ = DEFAULT_MIN_FREE_GB;
-        std::unordered_map<std::string, CachedImageData> cpu_cache_;
-        std::mutex cpu_cache_mutex_;
+        ShardedLruCache<CachedImageData> cpu_cache_;
+        std::mutex cpu_cache_mutex_; // Guards image_being_loaded_cpu_
         std::set<std::string> image_being_loaded_cpu_;
 
         // JPEG blob cache
-        std::unordered_map<std::string, CachedJpegBlob> jpeg_blob_cache_;
-        std::mutex jpeg_blob_mutex_;
+        ShardedLruCache<std::shared_ptr<const CachedJpegBlob>> jpeg_blob_cache_;
+        std::mutex jpeg_blob_mutex_; // Guards jpeg_being_loaded_
         std::set<std::string> jpeg_being_loaded_;
 
         // FS cache
-        std::filesystem::path cache_folder_;
         bool use_fs_cache_;
         std::mutex cache_mutex_;
         std::set<std::string> image_being_saved_;
+        // Decoded-image packs, one per image directory, together capped at
+        // DECODED_CACHE_MAX_BYTES on disk; reset_cache() closes them but keeps the files
+        std::unordered_map<std::string, std::unique_ptr<DecodedImagePack>> decoded_packs_;
+        mutable std::mutex decoded_packs_mutex_;
 
         // Status
         mutable std::mutex counter_mutex_;
@@ -0,0 +1,177 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace lfs::core {
+    class MappedFile;
+}
+
+namespace lfs::io {
+
+    inline constexpr std::size_t DECODED_PACK_ALIGNMENT = 64;
+    // At open, a pack whose superseded/orphaned bytes exceed both this and the live bytes is reset
+    inline constexpr std::size_t DECODED_PACK_MIN_COMPACT_BYTES = 256ULL * 1024 * 1024;
+
+    /**
+     * @brief Zero-copy view of a cached image: uint8, HWC, rows tightly packed
+     *
+     * `owner` keeps the underlying mapping alive; pass it to
+     * Tensor::from_blob so the tensor can outlive this view.
+     */
+    struct DecodedImageView {
+        const uint8_t* data = nullptr;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::shared_ptr<void> owner;
+
+        [[nodiscard]] std::size_t size_bytes() const {
+            return static_cast<std::size_t>(width) * height * channels;
+        }
+    };
+
+    struct DecodedImagePackStats {
+        std::size_t entries = 0;
+        std::size_t live_bytes = 0;
+        std::size_t pack_bytes = 0;
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t stale = 0; // Lookups rejected because the source file changed
+        std::size_t insertions = 0;
+        std::size_t rejected = 0; // Inserts refused because the pack reached max_bytes
+    };
+
+    /**
+     * @brief Persistent cache of decoded, resized images in one memory-mapped file
+     *
+     * Two append-only files live in the cache directory:
+     * - `<name>.pack`: pixel data, each image 64-byte aligned
+     * - `<name>.idx`:  one checksummed record per image, keyed by source path,
+     *                  resize_factor and max_width, stamped with the source's
+     *                  mtime and size
+     *
+     * Pixels are flushed before their index record, so a crash leaves at worst
+     * a torn index tail, which is dropped on the next open. A later record for
+     * the same key supersedes the earlier one. Lookups stat the source file and
+     * miss if its mtime or size no longer match, so edited images are re-decoded
+     * and re-appended. Superseded bytes are reclaimed by resetting the pack at
+     * open once they outweigh the live data. A pack never grows past the
+     * max_bytes it was opened with; later inserts are refused. Whole packs are
+     * evicted least recently used first by evict().
+     *
+     * Reads go through a MappedFile of the pack; the mapping is replaced when a
+     * lookup reaches past its end, and views keep older mappings alive.
+     *
+     * Thread safety: Protected by mutex. A pack must not be written by more than
+     * one process at a time.
+     */
+    class DecodedImagePack {
+    public:
+        DecodedImagePack(std::filesystem::path directory, std::string name,
+                         std::size_t max_bytes = std::numeric_limits<std::size_t>::max());
+        ~DecodedImagePack();
+
+        DecodedImagePack(const DecodedImagePack&) = delete;
+        DecodedImagePack& operator=(const DecodedImagePack&) = delete;
+
+        /**
+         * @brief Pack name for images in `image_dir`, stable across runs
+         */
+        static std::string name_for(const std::filesystem::path& image_dir);
+
+        /**
+         * @brief Delete packs in `directory`, least recently opened first, until all
+         *        of them fit in `max_bytes`; packs named in `in_use` are kept
+         * @return Bytes still held by all packs in `directory`
+         */
+        static std::size_t evict(const std::filesystem::path& directory, std::size_t max_bytes,
+                                 const std::set<std::string>& in_use);
+
+        // False if the files couldn't be created or a write failed
+        [[nodiscard]] bool is_open() const { return open_.load(); }
+
+        /**
+         * @brief Look up the decoded image for `source` at the given resize parameters
+         * @return nullopt on miss or if `source` changed since it was cached
+         */
+        [[nodiscard]] std::optional<DecodedImageView> find(const std::filesystem::path& source,
+                                                           int resize_factor, int max_width);
+
+        /**
+         * @brief Append decoded HWC uint8 pixels for `source`
+         * @return false if the pack is closed or the write failed
+         */
+        bool insert(const std::filesystem::path& source, int resize_factor, int max_width,
+                    const uint8_t* pixels, int width, int height, int channels);
+
+        /**
+         * @brief Drop every entry and replace both files with empty ones
+         *
+         * Views returned earlier keep the old pages mapped and stay readable.
+         */
+        void clear();
+
+        [[nodiscard]] DecodedImagePackStats stats() const;
+
+    private:
+        struct SourceStamp {
+            int64_t mtime = 0;
+            uint64_t size = 0;
+            bool operator==(const SourceStamp&) const = default;
+        };
+
+        struct Entry {
+            SourceStamp stamp;
+            uint64_t offset = 0;
+            int32_t width = 0;
+            int32_t height = 0;
+            int32_t channels = 0;
+
+            [[nodiscard]] uint64_t bytes() const {
+                return static_cast<uint64_t>(width) * height * channels;
+            }
+        };
+
+        static std::optional<SourceStamp> stamp_source(const std::filesystem::path& source);
+        static std::string make_key(const std::filesystem::path& source, int resize_factor, int max_width);
+
+        bool open_files();
+        bool load_index();
+        bool reset_files();
+        void close_streams();
+
+        std::filesystem::path pack_path_;
+        std::filesystem::path index_path_;
+        const std::size_t max_bytes_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+        std::ofstream pack_out_;
+        std::ofstream index_out_;
+        std::shared_ptr<core::MappedFile> mapping_;
+        uint64_t pack_end_ = 0;
+        uint64_t live_bytes_ = 0;
+        std::atomic<bool> open_{false}; // Cleared if a write fails; lookups keep working
+
+        std::size_t hits_ = 0;
+        std::size_t misses_ = 0;
+        std::size_t stale_ = 0;
+        std::size_t insertions_ = 0;
+        std::size_t rejected_ = 0;
+    };
+
+} // namespace lfs::io
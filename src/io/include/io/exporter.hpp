@@ -50,7 +50,8 @@ namespace lfs::io {
     struct SogSaveOptions {
         std::filesystem::path output_path;
         int kmeans_iterations = 10;
-        bool use_gpu = true;
+        bool use_gpu = true; // false runs the Morton sort and k-means on the host
+        int webp_effort = -1; // Lossless WebP effort 0 (fastest) to 9 (smallest); -1 keeps libwebp's default
         ExportProgressCallback progress_callback = nullptr;
     };
 
@@ -69,6 +70,7 @@ namespace lfs::io {
     struct HtmlExportOptions {
         std::filesystem::path output_path;
         int kmeans_iterations = 10;
+        bool use_gpu = true; // Passed to the embedded SOG encode
         HtmlProgressCallback progress_callback = nullptr;
     };
 
@@ -48,6 +48,8 @@ namespace lfs::io {
         std::string images_folder = "images";
         bool validate_only = false;
         ProgressCallback progress = nullptr;
+        // Where loaded splats and point clouds live; CPU keeps load -> transform -> export on the host
+        lfs::core::Device device = lfs::core::Device::CUDA;
     };
 
     struct LoadedScene {
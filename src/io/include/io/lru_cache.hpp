@@ -0,0 +1,232 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace lfs::io {
+
+    struct LruCacheStats {
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t insertions = 0;
+        size_t evictions = 0;
+        size_t evicted_bytes = 0;
+    };
+
+    /**
+     * @brief Byte-budgeted LRU cache keyed by string, sharded by key hash
+     *
+     * Each shard owns a recency list and a hash index into it, so lookup,
+     * insert, touch and eviction are O(1) and concurrent readers on different
+     * keys rarely contend. Entries carry a global access tick; eviction takes
+     * the oldest tail across shards, which keeps global LRU order at a cost of
+     * O(NumShards) rather than O(entries).
+     *
+     * Values are returned by copy: store shared_ptr (or another cheap handle)
+     * for large payloads.
+     */
+    template <typename Value, size_t NumShards = 16>
+    class ShardedLruCache {
+        static_assert((NumShards & (NumShards - 1)) == 0, "NumShards must be a power of two");
+
+    public:
+        explicit ShardedLruCache(size_t max_bytes = 0) : max_bytes_(max_bytes) {}
+
+        ShardedLruCache(const ShardedLruCache&) = delete;
+        ShardedLruCache& operator=(const ShardedLruCache&) = delete;
+
+        // 0 = unbounded; the caller drives eviction (e.g. on memory pressure)
+        void set_max_bytes(size_t max_bytes) { max_bytes_.store(max_bytes, std::memory_order_relaxed); }
+        size_t max_bytes() const { return max_bytes_.load(std::memory_order_relaxed); }
+
+        std::optional<Value> get(const std::string& key) {
+            auto& shard = shard_for(key);
+            std::lock_guard lock(shard.mutex);
+            const auto it = shard.index.find(key);
+            if (it == shard.index.end()) {
+                misses_.fetch_add(1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+            it->second->tick = next_tick();
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return it->second->value;
+        }
+
+        bool contains(const std::string& key) const {
+            const auto& shard = shard_for(key);
+            std::lock_guard lock(shard.mutex);
+            return shard.index.contains(key);
+        }
+
+        /**
+         * @brief Insert or replace an entry, evicting LRU entries to stay within max_bytes
+         */
+        void put(const std::string& key, Value value, size_t size_bytes) {
+            const size_t budget = max_bytes();
+            if (budget > 0) {
+                const size_t current = bytes();
+                if (current + size_bytes > budget) {
+                    evict_bytes(current + size_bytes - budget);
+                }
+            }
+
+            auto& shard = shard_for(key);
+            std::lock_guard lock(shard.mutex);
+            if (const auto it = shard.index.find(key); it != shard.index.end()) {
+                remove_locked(shard, it->second);
+            }
+            shard.lru.push_front(Entry{key, std::move(value), size_bytes, next_tick()});
+            shard.index.emplace(key, shard.lru.begin());
+            bytes_.fetch_add(size_bytes, std::memory_order_relaxed);
+            entries_.fetch_add(1, std::memory_order_relaxed);
+            insertions_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool erase(const std::string& key) {
+            auto& shard = shard_for(key);
+            std::lock_guard lock(shard.mutex);
+            const auto it = shard.index.find(key);
+            if (it == shard.index.end()) {
+                return false;
+            }
+            remove_locked(shard, it->second);
+            return true;
+        }
+
+        /**
+         * @brief Evict the least recently used entry across all shards
+         * @return false if the cache is empty
+         */
+        bool evict_one() {
+            return evict_oldest().has_value();
+        }
+
+        /**
+         * @brief Evict LRU entries until at least `bytes_to_free` bytes were released
+         * @return Bytes actually released
+         */
+        size_t evict_bytes(size_t bytes_to_free) {
+            size_t freed = 0;
+            while (freed < bytes_to_free) {
+                const auto evicted = evict_oldest();
+                if (!evicted) {
+                    break;
+                }
+                freed += *evicted;
+            }
+            return freed;
+        }
+
+        void clear() {
+            for (auto& shard : shards_) {
+                std::lock_guard lock(shard.mutex);
+                shard.index.clear();
+                shard.lru.clear();
+            }
+            bytes_.store(0, std::memory_order_relaxed);
+            entries_.store(0, std::memory_order_relaxed);
+        }
+
+        size_t size() const { return entries_.load(std::memory_order_relaxed); }
+        size_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+        bool empty() const { return size() == 0; }
+
+        LruCacheStats stats() const {
+            return LruCacheStats{
+                .entries = size(),
+                .bytes = bytes(),
+                .hits = hits_.load(std::memory_order_relaxed),
+                .misses = misses_.load(std::memory_order_relaxed),
+                .insertions = insertions_.load(std::memory_order_relaxed),
+                .evictions = evictions_.load(std::memory_order_relaxed),
+                .evicted_bytes = evicted_bytes_.load(std::memory_order_relaxed)};
+        }
+
+    private:
+        struct Entry {
+            std::string key;
+            Value value;
+            size_t size_bytes;
+            uint64_t tick;
+        };
+        using List = std::list<Entry>;
+
+        struct Shard {
+            mutable std::mutex mutex;
+            List lru; // Front = most recently used
+            std::unordered_map<std::string, typename List::iterator> index;
+        };
+
+        Shard& shard_for(const std::string& key) {
+            return shards_[std::hash<std::string>{}(key) & (NumShards - 1)];
+        }
+        const Shard& shard_for(const std::string& key) const {
+            return shards_[std::hash<std::string>{}(key) & (NumShards - 1)];
+        }
+
+        // Returns the evicted entry's size, or nullopt if the cache is empty
+        std::optional<size_t> evict_oldest() {
+            for (;;) {
+                size_t victim = NumShards;
+                uint64_t oldest = UINT64_MAX;
+                for (size_t i = 0; i < NumShards; ++i) {
+                    std::lock_guard lock(shards_[i].mutex);
+                    if (!shards_[i].lru.empty() && shards_[i].lru.back().tick < oldest) {
+                        oldest = shards_[i].lru.back().tick;
+                        victim = i;
+                    }
+                }
+                if (victim == NumShards) {
+                    return std::nullopt;
+                }
+
+                auto& shard = shards_[victim];
+                std::lock_guard lock(shard.mutex);
+                if (shard.lru.empty()) {
+                    continue; // Raced with another evictor, rescan
+                }
+                const size_t size = shard.lru.back().size_bytes;
+                evicted_bytes_.fetch_add(size, std::memory_order_relaxed);
+                evictions_.fetch_add(1, std::memory_order_relaxed);
+                remove_locked(shard, std::prev(shard.lru.end()));
+                return size;
+            }
+        }
+
+        uint64_t next_tick() { return tick_.fetch_add(1, std::memory_order_relaxed); }
+
+        void remove_locked(Shard& shard, typename List::iterator it) {
+            bytes_.fetch_sub(it->size_bytes, std::memory_order_relaxed);
+            entries_.fetch_sub(1, std::memory_order_relaxed);
+            shard.index.erase(it->key);
+            shard.lru.erase(it);
+        }
+
+        std::array<Shard, NumShards> shards_;
+        std::atomic<size_t> max_bytes_;
+        std::atomic<uint64_t> tick_{0};
+        std::atomic<size_t> bytes_{0};
+        std::atomic<size_t> entries_{0};
+        std::atomic<size_t> hits_{0};
+        std::atomic<size_t> misses_{0};
+        std::atomic<size_t> insertions_{0};
+        std::atomic<size_t> evictions_{0};
+        std::atomic<size_t> evicted_bytes_{0};
+    };
+
+} // namespace lfs::io
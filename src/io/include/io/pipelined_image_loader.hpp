@@ -5,6 +5,7 @@
 
 #include "core/tensor.hpp"
 #include "io/cache_image_loader.hpp"
+#include "io/lru_cache.hpp"
 
 #include <atomic>
 #include <chrono>
@@ -68,6 +69,10 @@ namespace lfs::io {
         struct CacheStats {
             size_t jpeg_cache_entries = 0;
             size_t jpeg_cache_bytes = 0;
+            size_t jpeg_cache_hits = 0;
+            size_t jpeg_cache_misses = 0;
+            size_t jpeg_cache_evictions = 0;
+            size_t jpeg_cache_evicted_bytes = 0;
             size_t hot_path_hits = 0;
             size_t cold_path_misses = 0;
             size_t gpu_batch_decodes = 0;
@@ -207,14 +212,7 @@ namespace lfs::io {
         ThreadSafeQueue<PrefetchedImage> cold_queue_;
         ThreadSafeQueue<ReadyImage> output_queue_;
 
-        struct JpegCacheEntry {
-            std::shared_ptr<std::vector<uint8_t>> data;
-            std::chrono::steady_clock::time_point last_access;
-            size_t size_bytes;
-        };
-        std::unordered_map<std::string, JpegCacheEntry> jpeg_cache_;
-        mutable std::mutex jpeg_cache_mutex_;
-        std::atomic<size_t> jpeg_cache_bytes_{0};
+        ShardedLruCache<std::shared_ptr<std::vector<uint8_t>>> jpeg_cache_;
 
         std::filesystem::path fs_cache_folder_;
         std::mutex fs_cache_mutex_;
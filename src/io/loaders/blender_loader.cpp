@@ -4,10 +4,10 @@
 
 #include "io/loaders/blender_loader.hpp"
 #include "core/camera.hpp"
-#include "core/image_io.hpp"
 #include "core/logger.hpp"
 #include "core/path_utils.hpp"
 #include "core/point_cloud.hpp"
+#include "dataset_index.hpp"
 #include "formats/transforms.hpp"
 #include "io/error.hpp"
 #include "training/dataset.hpp"
@@ -25,43 +25,6 @@ namespace lfs::io {
     using lfs::core::PointCloud;
     using lfs::core::Tensor;
 
-    namespace {
-        constexpr std::array MASK_FOLDERS = {"masks", "mask", "segmentation"};
-        constexpr std::array MASK_EXTENSIONS = {".png", ".jpg", ".jpeg", ".PNG", ".JPG", ".JPEG", ".mask.png"};
-    } // namespace
-
-    // Searches for mask file matching image_name in mask folders.
-    // Priority: exact match, stem+ext (e.g., img.png), full+ext (e.g., img.jpg.png)
-    static std::filesystem::path find_mask_path(const std::filesystem::path& base_path,
-                                                const std::string& image_name) {
-        const std::filesystem::path img_path = lfs::core::utf8_to_path(image_name);
-        const std::filesystem::path stem_path = img_path.parent_path() / img_path.stem();
-
-        for (const auto& folder : MASK_FOLDERS) {
-            const std::filesystem::path mask_dir = base_path / folder;
-            if (!std::filesystem::exists(mask_dir))
-                continue;
-
-            if (const auto exact = mask_dir / img_path; std::filesystem::exists(exact))
-                return exact;
-
-            for (const auto& ext : MASK_EXTENSIONS) {
-                auto path = mask_dir / stem_path;
-                path += ext;
-                if (std::filesystem::exists(path))
-                    return path;
-            }
-
-            for (const auto& ext : MASK_EXTENSIONS) {
-                auto path = mask_dir / img_path;
-                path += ext;
-                if (std::filesystem::exists(path))
-                    return path;
-            }
-        }
-        return {};
-    }
-
     Result<LoadResult> BlenderLoader::load(
         const std::filesystem::path& path,
         const LoadOptions& options) {
@@ -166,28 +129,22 @@ namespace lfs::io {
             std::vector<std::shared_ptr<lfs::core::Camera>> cameras;
             cameras.reserve(camera_infos.size());
 
-            // Get base path for mask lookup
-            std::filesystem::path base_path = transforms_file.parent_path();
+            // Find masks next to the transforms file and validate their sizes
+            std::vector<DatasetImage> dataset_images;
+            dataset_images.reserve(camera_infos.size());
+            for (const auto& info : camera_infos) {
+                dataset_images.push_back({info._image_name, info._image_path});
+            }
+            auto indexed = index_dataset_images(transforms_file.parent_path(), dataset_images);
+            if (!indexed) {
+                return std::unexpected(indexed.error());
+            }
 
             for (size_t i = 0; i < camera_infos.size(); ++i) {
                 const auto& info = camera_infos[i];
 
                 try {
-                    // Find mask path if available
-                    std::filesystem::path mask_path = find_mask_path(base_path, info._image_name);
-
-                    // Validate mask dimensions match image dimensions
-                    if (!mask_path.empty()) {
-                        auto [img_w, img_h, img_c] = lfs::core::get_image_info(info._image_path);
-                        auto [mask_w, mask_h, mask_c] = lfs::core::get_image_info(mask_path);
-                        if (img_w != mask_w || img_h != mask_h) {
-                            return make_error(ErrorCode::MASK_SIZE_MISMATCH,
-                                              std::format("Mask '{}' is {}x{} but image '{}' is {}x{}",
-                                                          mask_path.filename().string(), mask_w, mask_h,
-                                                          info._image_name, img_w, img_h),
-                                              mask_path);
-                        }
-                    }
+                    const std::filesystem::path& mask_path = (*indexed)[i].mask_path;
 
                     auto cam = std::make_shared<lfs::core::Camera>(
                         info._R,
@@ -217,12 +217,12 @@ namespace lfs::io {
             std::shared_ptr<PointCloud> point_cloud;
             if (has_points) {
                 LOG_DEBUG("Loading binary point cloud");
-                auto loaded_pc = read_colmap_point_cloud(path);
+                auto loaded_pc = read_colmap_point_cloud(path, options.device);
                 point_cloud = std::make_shared<PointCloud>(std::move(loaded_pc));
                 LOG_INFO("Loaded {} points from COLMAP", point_cloud->size());
             } else if (has_points_text) {
                 LOG_DEBUG("Loading text point cloud");
-                auto loaded_pc = read_colmap_point_cloud_text(path);
+                auto loaded_pc = read_colmap_point_cloud_text(path, options.device);
                 point_cloud = std::make_shared<PointCloud>(std::move(loaded_pc));
                 LOG_INFO("Loaded {} points from COLMAP text file", point_cloud->size());
             } else {
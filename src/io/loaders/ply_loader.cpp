@@ -85,7 +85,7 @@ namespace lfs::io {
 
         LOG_INFO("Loading PLY file: {}", lfs::core::path_to_utf8(path));
 
-        auto splat_result = load_ply(path);
+        auto splat_result = load_ply(path, options.device);
 
         if (!splat_result) {
             return make_error(ErrorCode::CORRUPTED_DATA,
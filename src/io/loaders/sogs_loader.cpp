@@ -98,7 +98,7 @@ namespace lfs::io {
         }
 
         LOG_INFO("Loading SOG file: {}", lfs::core::path_to_utf8(path));
-        auto splat_result = load_sog(path);
+        auto splat_result = load_sog(path, options.device);
         if (!splat_result) {
             return make_error(ErrorCode::CORRUPTED_DATA,
                               std::format("Failed to load SOG: {}", splat_result.error()), path);
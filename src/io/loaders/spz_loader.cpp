@@ -75,7 +75,7 @@ namespace lfs::io {
         }
 
         LOG_INFO("Loading SPZ file: {}", lfs::core::path_to_utf8(path));
-        auto splat_result = load_spz(path);
+        auto splat_result = load_spz(path, options.device);
         if (!splat_result) {
             return make_error(ErrorCode::CORRUPTED_DATA,
                               std::format("Failed to load SPZ: {}", splat_result.error()), path);
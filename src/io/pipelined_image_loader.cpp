@@ -5,6 +5,7 @@
 #include "core/image_io.hpp"
 #include "core/logger.hpp"
 #include "core/path_utils.hpp"
+#include "core/perf_trace.hpp"
 #include "cuda/image_format_kernels.cuh"
 #include "io/nvcodec_image_loader.hpp"
 
@@ -37,17 +38,6 @@ namespace lfs::io {
             return hash;
         }
 
-        std::filesystem::path get_temp_folder() {
-#ifdef _WIN32
-            const char* temp = std::getenv("TEMP");
-            if (!temp)
-                temp = std::getenv("TMP");
-            return temp ? std::filesystem::path(temp) : std::filesystem::path("C:/Temp");
-#else
-            return std::filesystem::path("/tmp");
-#endif
-        }
-
         std::mutex& get_nvcodec_mutex() {
             static std::mutex mtx;
             return mtx;
@@ -92,7 +82,7 @@ namespace lfs::io {
                  config_.jpeg_batch_size, config_.prefetch_count, config_.io_threads, config_.cold_process_threads);
 
         if (config_.use_filesystem_cache) {
-            const auto cache_base = get_temp_folder() / "LichtFeld" / "pipeline_cache";
+            const auto cache_base = lfs::core::lichtfeld_temp_folder() / "pipeline_cache";
             fs_cache_folder_ = cache_base / ("ppl_" + generate_cache_hash());
 
             std::error_code ec;
@@ -211,8 +201,13 @@ namespace lfs::io {
     PipelinedImageLoader::CacheStats PipelinedImageLoader::get_stats() const {
         std::lock_guard<std::mutex> lock(stats_mutex_);
         CacheStats s = stats_;
-        s.jpeg_cache_entries = jpeg_cache_.size();
-        s.jpeg_cache_bytes = jpeg_cache_bytes_.load();
+        const auto cache = jpeg_cache_.stats();
+        s.jpeg_cache_entries = cache.entries;
+        s.jpeg_cache_bytes = cache.bytes;
+        s.jpeg_cache_hits = cache.hits;
+        s.jpeg_cache_misses = cache.misses;
+        s.jpeg_cache_evictions = cache.evictions;
+        s.jpeg_cache_evicted_bytes = cache.evicted_bytes;
         return s;
     }
 
@@ -247,6 +242,7 @@ namespace lfs::io {
     }
 
     std::vector<uint8_t> PipelinedImageLoader::read_file(const std::filesystem::path& path) const {
+        LFS_TRACE_SCOPE(IO, "read_file");
         std::ifstream file(path, std::ios::binary | std::ios::ate);
         if (!file)
             throw std::runtime_error("Failed to open: " + lfs::core::path_to_utf8(path));
@@ -262,20 +258,14 @@ namespace lfs::io {
     }
 
     std::shared_ptr<std::vector<uint8_t>> PipelinedImageLoader::get_from_jpeg_cache(const std::string& cache_key) {
-        std::lock_guard<std::mutex> lock(jpeg_cache_mutex_);
-        const auto it = jpeg_cache_.find(cache_key);
-        if (it == jpeg_cache_.end())
-            return nullptr;
-        it->second.last_access = std::chrono::steady_clock::now();
-        return it->second.data;
+        auto cached = jpeg_cache_.get(cache_key);
+        return cached ? std::move(*cached) : nullptr;
     }
 
     void PipelinedImageLoader::put_in_jpeg_cache(const std::string& cache_key, std::shared_ptr<std::vector<uint8_t>> data) {
-        std::lock_guard<std::mutex> lock(jpeg_cache_mutex_);
         const size_t size = data->size();
         evict_jpeg_cache_if_needed(size);
-        jpeg_cache_[cache_key] = JpegCacheEntry{std::move(data), std::chrono::steady_clock::now(), size};
-        jpeg_cache_bytes_ += size;
+        jpeg_cache_.put(cache_key, std::move(data), size);
     }
 
     void PipelinedImageLoader::put_in_jpeg_cache(const std::string& cache_key, std::vector<uint8_t>&& data) {
@@ -286,20 +276,14 @@ namespace lfs::io {
         size_t target = config_.max_cache_bytes;
         const size_t available = get_available_physical_memory();
         const size_t min_free = static_cast<size_t>(get_total_physical_memory() * config_.min_free_memory_ratio);
+        const size_t cached = jpeg_cache_.bytes();
 
         if (available < min_free + required_bytes) {
-            target = std::min(target, jpeg_cache_bytes_.load() / 2);
+            target = std::min(target, cached / 2);
         }
 
-        while (jpeg_cache_bytes_ + required_bytes > target && !jpeg_cache_.empty()) {
-            auto oldest = jpeg_cache_.begin();
-            for (auto it = jpeg_cache_.begin(); it != jpeg_cache_.end(); ++it) {
-                if (it->second.last_access < oldest->second.last_access) {
-                    oldest = it;
-                }
-            }
-            jpeg_cache_bytes_ -= oldest->second.size_bytes;
-            jpeg_cache_.erase(oldest);
+        if (cached + required_bytes > target) {
+            jpeg_cache_.evict_bytes(cached + required_bytes - target);
         }
     }
 
@@ -335,6 +319,7 @@ namespace lfs::io {
     }
 
     void PipelinedImageLoader::prefetch_thread_func() {
+        LFS_TRACE_THREAD_NAME("loader prefetch");
         while (running_) {
             ImageRequest request;
             try {
@@ -342,6 +327,7 @@ namespace lfs::io {
             } catch (const std::runtime_error&) {
                 break;
             }
+            LFS_TRACE_SCOPE(Loader, "prefetch");
 
             PrefetchedImage result;
             result.sequence_id = request.sequence_id;
@@ -407,6 +393,7 @@ namespace lfs::io {
     }
 
     void PipelinedImageLoader::gpu_batch_decode_thread_func() {
+        LFS_TRACE_THREAD_NAME("loader gpu decode");
         std::vector<PrefetchedImage> batch;
         batch.reserve(config_.jpeg_batch_size);
 
@@ -437,6 +424,7 @@ namespace lfs::io {
             if (batch.empty())
                 continue;
 
+            LFS_TRACE_SCOPE(Loader, "gpu_decode_batch");
             try {
                 auto& nvcodec = get_nvcodec_loader();
 
@@ -495,6 +483,7 @@ namespace lfs::io {
     }
 
     void PipelinedImageLoader::cold_process_thread_func() {
+        LFS_TRACE_THREAD_NAME("loader cold decode");
         while (running_) {
             PrefetchedImage item;
             try {
@@ -502,6 +491,7 @@ namespace lfs::io {
             } catch (const std::runtime_error&) {
                 break;
             }
+            LFS_TRACE_SCOPE(Loader, "cold_decode");
 
             try {
                 lfs::core::Tensor decoded;
@@ -5,81 +5,412 @@
 #include "components/bilateral_grid.hpp"
 #include "core/logger.hpp"
 #include "core/path_utils.hpp"
+#include "core/perf_trace.hpp"
+#include "core/tensor_archive.hpp"
 #include "strategies/istrategy.hpp"
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <span>
+#include <spanstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace lfs::training {
 
-    std::expected<void, std::string> save_checkpoint(
+    namespace {
+
+        // Growable in-memory sink for the serializers, avoids the copy out of a stringstream
+        class StagingBuffer : public std::streambuf {
+        public:
+            explicit StagingBuffer(std::vector<char>& data) : data_(data) {}
+
+        protected:
+            std::streamsize xsputn(const char* s, const std::streamsize n) override {
+                data_.insert(data_.end(), s, s + n);
+                return n;
+            }
+
+            int_type overflow(const int_type ch) override {
+                if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                    data_.push_back(traits_type::to_char_type(ch));
+                }
+                return traits_type::not_eof(ch);
+            }
+
+            pos_type seekoff(const off_type off, const std::ios_base::seekdir dir,
+                             const std::ios_base::openmode which) override {
+                // Only tellp() is supported
+                if (off == 0 && dir == std::ios_base::cur && (which & std::ios_base::out)) {
+                    return static_cast<pos_type>(data_.size());
+                }
+                return pos_type(off_type(-1));
+            }
+
+        private:
+            std::vector<char>& data_;
+        };
+
+        // Takes host copies of the tensors while the body is serialized, leaving references behind
+        class SnapshotTensors : public lfs::core::TensorRecordSink {
+        public:
+            explicit SnapshotTensors(CheckpointSnapshot& snapshot) : snapshot_(snapshot) {}
+
+            void begin_section(std::string section) {
+                section_ = std::move(section);
+                section_count_ = 0;
+            }
+
+            uint64_t put(const lfs::core::Tensor& tensor) override {
+                snapshot_.tensor_names.push_back(section_ + "/" + std::to_string(section_count_++));
+                snapshot_.tensors.push_back(tensor.device() == lfs::core::Device::CPU ? tensor.clone() : tensor.cpu());
+                return snapshot_.tensors.size() - 1;
+            }
+
+        private:
+            CheckpointSnapshot& snapshot_;
+            std::string section_;
+            size_t section_count_ = 0;
+        };
+
+        // Flush a closed file's data to the device, so a rename never exposes unwritten blocks
+        bool sync_file(const std::filesystem::path& path) {
+#ifdef _WIN32
+            HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                      nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+            const bool ok = FlushFileBuffers(file) != 0;
+            CloseHandle(file);
+            return ok;
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return false;
+            }
+            const bool ok = ::fsync(fd) == 0;
+            ::close(fd);
+            return ok;
+#endif
+        }
+
+        // Persist a rename; NTFS journals it already and Windows cannot open directories for sync
+        void sync_directory(const std::filesystem::path& dir) {
+#ifndef _WIN32
+            const int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY);
+            if (fd < 0) {
+                return;
+            }
+            if (::fsync(fd) != 0) {
+                LOG_WARN("Failed to sync directory {}", lfs::core::path_to_utf8(dir));
+            }
+            ::close(fd);
+#else
+            (void)dir;
+#endif
+        }
+
+        template <typename T>
+        void write_pod(std::ostream& os, const T& value) {
+            os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        /// Checkpoint opened for reading; the v3 body is read into memory
+        struct OpenedCheckpoint {
+            CheckpointHeader header;
+            std::vector<char> body;
+            std::shared_ptr<lfs::core::TensorArchive> archive; // v3, resolves the body's tensor references
+            std::unique_ptr<std::istream> stream;              // Positioned right after the header
+        };
+
+        std::string read_params_json(OpenedCheckpoint& checkpoint) {
+            const auto& header = checkpoint.header;
+            if (header.params_json_size == 0) {
+                return {};
+            }
+            if (checkpoint.archive) {
+                const auto bytes = checkpoint.archive->read_bytes("params");
+                return {bytes.begin(), bytes.end()};
+            }
+
+            auto& file = *checkpoint.stream;
+            file.seekg(static_cast<std::streamoff>(header.params_json_offset));
+            std::string params_str(header.params_json_size, '\0');
+            file.read(params_str.data(), static_cast<std::streamsize>(header.params_json_size));
+            return params_str;
+        }
+
+        // v2 (chunked body) only ever existed in development builds
+        bool supported_version(const uint32_t version) {
+            return version == 1 || version == CHECKPOINT_VERSION;
+        }
+
+        std::expected<OpenedCheckpoint, std::string> open_checkpoint(const std::filesystem::path& path) {
+            auto file = std::make_unique<std::ifstream>();
+            if (!lfs::core::open_file_for_read(path, std::ios::binary, *file)) {
+                return std::unexpected("Failed to open: " + lfs::core::path_to_utf8(path));
+            }
+
+            OpenedCheckpoint checkpoint;
+            file->read(reinterpret_cast<char*>(&checkpoint.header), sizeof(checkpoint.header));
+
+            if (checkpoint.header.magic != CHECKPOINT_MAGIC) {
+                return std::unexpected("Invalid checkpoint: wrong magic");
+            }
+            if (!supported_version(checkpoint.header.version)) {
+                return std::unexpected("Unsupported version: " + std::to_string(checkpoint.header.version));
+            }
+
+            if (checkpoint.header.version == 1) {
+                checkpoint.stream = std::move(file);
+                return checkpoint;
+            }
+
+            file.reset();
+            auto archive = lfs::core::TensorArchive::open(path);
+            if (!archive) {
+                return std::unexpected(archive.error());
+            }
+            checkpoint.archive = std::move(*archive);
+            try {
+                checkpoint.body = checkpoint.archive->read_bytes("body");
+            } catch (const std::exception& e) {
+                return std::unexpected(std::string("Corrupt checkpoint: ") + e.what());
+            }
+            if (checkpoint.body.size() < sizeof(CheckpointHeader)) {
+                return std::unexpected("Corrupt checkpoint: truncated body");
+            }
+
+            checkpoint.stream = std::make_unique<std::ispanstream>(std::span<char>(checkpoint.body));
+            checkpoint.stream->seekg(sizeof(CheckpointHeader));
+            lfs::core::attach_tensor_source(*checkpoint.stream, checkpoint.archive.get());
+            return checkpoint;
+        }
+
+    } // namespace
+
+    std::expected<CheckpointSnapshot, std::string> snapshot_checkpoint(
         const std::filesystem::path& path,
         const int iteration,
         const IStrategy& strategy,
         const lfs::core::param::TrainingParameters& params,
         const BilateralGrid* bilateral_grid) {
+        LFS_TRACE_SCOPE(Export, "snapshot_checkpoint");
 
         try {
-            const auto checkpoint_dir = path / "checkpoints";
-            std::filesystem::create_directories(checkpoint_dir);
-            const auto checkpoint_path = checkpoint_dir / ("checkpoint_" + std::to_string(iteration) + ".resume");
+            const auto start = std::chrono::steady_clock::now();
 
-            std::ofstream file;
-            if (!lfs::core::open_file_for_write(checkpoint_path, std::ios::binary, file)) {
-                return std::unexpected("Failed to open: " + lfs::core::path_to_utf8(checkpoint_path));
-            }
+            CheckpointSnapshot snapshot;
+            snapshot.path = path / "checkpoints" / ("checkpoint_" + std::to_string(iteration) + ".resume");
 
             const auto& model = strategy.get_model();
-            CheckpointHeader header{};
+            auto& header = snapshot.header;
             header.iteration = iteration;
             header.num_gaussians = static_cast<uint32_t>(model.size());
             header.sh_degree = model.get_max_sh_degree();
             header.flags = bilateral_grid ? CheckpointFlags::HAS_BILATERAL_GRID : CheckpointFlags::NONE;
 
-            const auto header_pos = file.tellp();
-            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            // Tensors go to the snapshot's list, the body only holds their layout and references
+            snapshot.body.reserve(64 * 1024);
+            StagingBuffer staging(snapshot.body);
+            std::ostream os(&staging);
+            SnapshotTensors tensors(snapshot);
+            lfs::core::attach_tensor_sink(os, &tensors);
+
+            write_pod(os, header);
 
             // Strategy type
             const char* const strategy_type = strategy.strategy_type();
             const uint32_t type_len = static_cast<uint32_t>(std::strlen(strategy_type));
-            file.write(reinterpret_cast<const char*>(&type_len), sizeof(type_len));
-            file.write(strategy_type, type_len);
+            write_pod(os, type_len);
+            os.write(strategy_type, type_len);
 
             // Model and strategy state
-            model.serialize(file);
-            strategy.serialize(file);
+            tensors.begin_section("model");
+            model.serialize(os);
+            tensors.begin_section("strategy");
+            strategy.serialize(os);
 
             // Bilateral grid (if present)
             if (bilateral_grid) {
-                bilateral_grid->serialize(file);
-                LOG_DEBUG("Bilateral grid state saved (step={}, lr={:.2e})",
+                tensors.begin_section("bilateral_grid");
+                bilateral_grid->serialize(os);
+                LOG_DEBUG("Bilateral grid state captured (step={}, lr={:.2e})",
                           bilateral_grid->get_step(), bilateral_grid->get_lr());
             }
 
             // Training parameters as JSON
-            const auto params_pos = file.tellp();
             nlohmann::json params_json;
             params_json["optimization"] = params.optimization.to_json();
             params_json["dataset"] = params.dataset.to_json();
-            const std::string params_str = params_json.dump();
-            file.write(params_str.data(), static_cast<std::streamsize>(params_str.size()));
-            const auto params_end = file.tellp();
+            snapshot.params_json = params_json.dump();
+            header.params_json_size = snapshot.params_json.size();
 
-            // Update header with JSON offset
-            header.params_json_offset = static_cast<uint64_t>(params_pos);
-            header.params_json_size = static_cast<uint64_t>(params_end - params_pos);
-            file.seekp(header_pos);
-            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            lfs::core::attach_tensor_sink(os, nullptr);
+            if (!os) {
+                return std::unexpected("Snapshot checkpoint failed: staging write error");
+            }
+            std::memcpy(snapshot.body.data(), &header, sizeof(header));
 
+            snapshot.stall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return snapshot;
+
+        } catch (const std::exception& e) {
+            return std::unexpected(std::string("Snapshot checkpoint failed: ") + e.what());
+        }
+    }
+
+    std::expected<void, std::string> write_checkpoint(
+        const CheckpointSnapshot& snapshot,
+        const CheckpointWriteOptions& options) {
+        LFS_TRACE_SCOPE(Export, "write_checkpoint");
+
+        const auto& checkpoint_path = snapshot.path;
+        auto temp_path = checkpoint_path;
+        temp_path += ".tmp";
+
+        try {
+            const auto start = std::chrono::steady_clock::now();
+            std::filesystem::create_directories(checkpoint_path.parent_path());
+
+            std::ofstream file;
+            if (!lfs::core::open_file_for_write(temp_path, std::ios::binary, file)) {
+                return std::unexpected("Failed to open: " + lfs::core::path_to_utf8(temp_path));
+            }
+
+            // The header is rewritten once the params entry's offset is known
+            CheckpointHeader header = snapshot.header;
+            write_pod(file, header);
+
+            lfs::core::TensorArchiveWriter archive(
+                file, {.compress = options.compress, .compression_level = options.compression_level});
+            size_t raw_size = snapshot.body.size() + snapshot.params_json.size();
+            for (size_t i = 0; i < snapshot.tensors.size() && file; ++i) {
+                archive.add(snapshot.tensor_names[i], snapshot.tensors[i]);
+                raw_size += snapshot.tensors[i].bytes();
+            }
+            archive.add_bytes("body", snapshot.body);
+            // Stored, so params_json_offset addresses the JSON directly
+            const auto& params_entry = archive.add_bytes("params", snapshot.params_json, false);
+            header.params_json_offset = params_entry.offset;
+            const bool finished = archive.finish();
+
+            file.seekp(0);
+            write_pod(file, header);
+            file.flush();
+            file.close();
+            if (!finished || !file || !sync_file(temp_path)) {
+                std::error_code ec;
+                std::filesystem::remove(temp_path, ec);
+                return std::unexpected("Failed to write: " + lfs::core::path_to_utf8(temp_path) + " (disk full?)");
+            }
+
+            // Readers only ever see a complete checkpoint, even after a crash
+            std::filesystem::rename(temp_path, checkpoint_path);
+            sync_directory(checkpoint_path.parent_path());
+
+            const double elapsed_ms =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
             LOG_INFO("Checkpoint saved: {} ({} Gaussians, iter {}{})",
-                     lfs::core::path_to_utf8(checkpoint_path), header.num_gaussians, iteration,
-                     bilateral_grid ? ", +bilateral" : "");
+                     lfs::core::path_to_utf8(checkpoint_path), snapshot.header.num_gaussians,
+                     snapshot.header.iteration,
+                     has_flag(snapshot.header.flags, CheckpointFlags::HAS_BILATERAL_GRID) ? ", +bilateral" : "");
+            LOG_PERF("Checkpoint write: {:.1f} MB -> {:.1f} MB in {:.1f} ms (training stalled {:.1f} ms)",
+                     static_cast<double>(raw_size) / (1024 * 1024),
+                     static_cast<double>(archive.stored_bytes()) / (1024 * 1024),
+                     elapsed_ms, snapshot.stall_ms);
             return {};
 
         } catch (const std::exception& e) {
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
             return std::unexpected(std::string("Save checkpoint failed: ") + e.what());
         }
     }
 
+    std::expected<void, std::string> save_checkpoint(
+        const std::filesystem::path& path,
+        const int iteration,
+        const IStrategy& strategy,
+        const lfs::core::param::TrainingParameters& params,
+        const BilateralGrid* bilateral_grid,
+        const CheckpointWriteOptions& options) {
+
+        auto snapshot = snapshot_checkpoint(path, iteration, strategy, params, bilateral_grid);
+        if (!snapshot) {
+            return std::unexpected(snapshot.error());
+        }
+        return write_checkpoint(*snapshot, options);
+    }
+
+    AsyncCheckpointWriter::AsyncCheckpointWriter(CheckpointWriteOptions options)
+        : options_(options) {}
+
+    AsyncCheckpointWriter::~AsyncCheckpointWriter() {
+        if (auto result = wait(); !result) {
+            LOG_ERROR("Checkpoint write failed: {}", result.error());
+        }
+    }
+
+    std::expected<void, std::string> AsyncCheckpointWriter::save(
+        const std::filesystem::path& path,
+        const int iteration,
+        const IStrategy& strategy,
+        const lfs::core::param::TrainingParameters& params,
+        const BilateralGrid* bilateral_grid) {
+
+        const auto start = std::chrono::steady_clock::now();
+        std::lock_guard lock(mutex_);
+
+        // Keep a single staging buffer in flight
+        if (auto previous = wait_locked(); !previous) {
+            LOG_ERROR("Previous checkpoint write failed: {}", previous.error());
+        }
+
+        auto snapshot = snapshot_checkpoint(path, iteration, strategy, params, bilateral_grid);
+        last_stall_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!snapshot) {
+            return std::unexpected(snapshot.error());
+        }
+        snapshot->stall_ms = last_stall_ms_;
+
+        pending_ = std::async(std::launch::async, [snapshot = std::move(*snapshot), options = options_]() {
+            auto result = write_checkpoint(snapshot, options);
+            if (!result) {
+                LOG_ERROR("Async checkpoint save failed for '{}': {}",
+                          lfs::core::path_to_utf8(snapshot.path), result.error());
+            }
+            return result;
+        });
+        return {};
+    }
+
+    std::expected<void, std::string> AsyncCheckpointWriter::wait() {
+        std::lock_guard lock(mutex_);
+        return wait_locked();
+    }
+
+    std::expected<void, std::string> AsyncCheckpointWriter::wait_locked() {
+        if (!pending_.valid()) {
+            return {};
+        }
+        return pending_.get();
+    }
+
+    bool AsyncCheckpointWriter::is_writing() const {
+        std::lock_guard lock(mutex_);
+        return pending_.valid() &&
+               pending_.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    }
+
     std::expected<CheckpointHeader, std::string> load_checkpoint_header(
         const std::filesystem::path& path) {
 
@@ -95,7 +426,7 @@ namespace lfs::training {
             if (header.magic != CHECKPOINT_MAGIC) {
                 return std::unexpected("Invalid checkpoint: wrong magic");
             }
-            if (header.version > CHECKPOINT_VERSION) {
+            if (!supported_version(header.version)) {
                 return std::unexpected("Unsupported version: " + std::to_string(header.version));
             }
             return header;
@@ -112,20 +443,12 @@ namespace lfs::training {
         BilateralGrid* bilateral_grid) {
 
         try {
-            std::ifstream file;
-            if (!lfs::core::open_file_for_read(path, std::ios::binary, file)) {
-                return std::unexpected("Failed to open: " + lfs::core::path_to_utf8(path));
-            }
-
-            CheckpointHeader header{};
-            file.read(reinterpret_cast<char*>(&header), sizeof(header));
-
-            if (header.magic != CHECKPOINT_MAGIC) {
-                return std::unexpected("Invalid checkpoint: wrong magic");
-            }
-            if (header.version > CHECKPOINT_VERSION) {
-                return std::unexpected("Unsupported version: " + std::to_string(header.version));
+            auto checkpoint = open_checkpoint(path);
+            if (!checkpoint) {
+                return std::unexpected(checkpoint.error());
             }
+            const CheckpointHeader& header = checkpoint->header;
+            std::istream& file = *checkpoint->stream;
 
             // Verify strategy compatibility
             uint32_t type_len = 0;
@@ -166,9 +489,7 @@ namespace lfs::training {
 
             // Load params from checkpoint, preserving CLI path overrides
             if (header.params_json_size > 0) {
-                file.seekg(static_cast<std::streamoff>(header.params_json_offset));
-                std::string params_str(header.params_json_size, '\0');
-                file.read(params_str.data(), static_cast<std::streamsize>(header.params_json_size));
+                const std::string params_str = read_params_json(*checkpoint);
 
                 const auto cli_data_path = params.dataset.data_path;
                 const auto cli_output_path = params.dataset.output_path;
@@ -199,23 +520,16 @@ namespace lfs::training {
     }
 
     std::expected<lfs::core::SplatData, std::string> load_checkpoint_splat_data(
-        const std::filesystem::path& path) {
+        const std::filesystem::path& path,
+        const lfs::core::Device device) {
 
         try {
-            std::ifstream file;
-            if (!lfs::core::open_file_for_read(path, std::ios::binary, file)) {
-                return std::unexpected("Failed to open: " + lfs::core::path_to_utf8(path));
-            }
-
-            CheckpointHeader header{};
-            file.read(reinterpret_cast<char*>(&header), sizeof(header));
-
-            if (header.magic != CHECKPOINT_MAGIC) {
-                return std::unexpected("Invalid checkpoint: wrong magic");
-            }
-            if (header.version > CHECKPOINT_VERSION) {
-                return std::unexpected("Unsupported version: " + std::to_string(header.version));
+            auto checkpoint = open_checkpoint(path);
+            if (!checkpoint) {
+                return std::unexpected(checkpoint.error());
             }
+            const CheckpointHeader& header = checkpoint->header;
+            std::istream& file = *checkpoint->stream;
 
             // Skip strategy type
             uint32_t type_len = 0;
@@ -223,7 +537,7 @@ namespace lfs::training {
             file.seekg(type_len, std::ios::cur);
 
             lfs::core::SplatData splat;
-            splat.deserialize(file);
+            splat.deserialize(file, device);
 
             LOG_DEBUG("SplatData loaded: {} Gaussians, iter {}", header.num_gaussians, header.iteration);
             return splat;
@@ -237,26 +551,13 @@ namespace lfs::training {
         const std::filesystem::path& path) {
 
         try {
-            std::ifstream file;
-            if (!lfs::core::open_file_for_read(path, std::ios::binary, file)) {
-                return std::unexpected("Failed to open: " + lfs::core::path_to_utf8(path));
-            }
-
-            CheckpointHeader header{};
-            file.read(reinterpret_cast<char*>(&header), sizeof(header));
-
-            if (header.magic != CHECKPOINT_MAGIC) {
-                return std::unexpected("Invalid checkpoint: wrong magic");
+            auto checkpoint = open_checkpoint(path);
+            if (!checkpoint) {
+                return std::unexpected(checkpoint.error());
             }
-            if (header.version > CHECKPOINT_VERSION) {
-                return std::unexpected("Unsupported version: " + std::to_string(header.version));
-            }
-
             lfs::core::param::TrainingParameters params;
-            if (header.params_json_size > 0) {
-                file.seekg(static_cast<std::streamoff>(header.params_json_offset));
-                std::string params_str(header.params_json_size, '\0');
-                file.read(params_str.data(), static_cast<std::streamsize>(header.params_json_size));
+            if (checkpoint->header.params_json_size > 0) {
+                const std::string params_str = read_params_json(*checkpoint);
 
                 const auto params_json = nlohmann::json::parse(params_str);
                 if (params_json.contains("optimization")) {
@@ -7,11 +7,32 @@
  * @file checkpoint.hpp
  * @brief Training checkpoint format for LichtFeld Studio (.resume files)
  *
- * Binary Format (v1):
+ * Binary Format (v3):
+ * ┌─────────────────────────────────────────────────────────────────┐
+ * │ CheckpointHeader (48 bytes)                                    │
+ * ├─────────────────────────────────────────────────────────────────┤
+ * │ Tensor archive (core/tensor_archive.hpp)                       │
+ * │   - one entry per tensor, named "<section>/<n>" where section  │
+ * │     is model, strategy or bilateral_grid                       │
+ * │   - "body": the v1 body without the params JSON, every tensor  │
+ * │     replaced by a reference to its entry                       │
+ * │   - "params": training parameters JSON, always stored          │
+ * │   - TOC and footer at the end of the file                      │
+ * └─────────────────────────────────────────────────────────────────┘
+ *
+ * The file is memory mapped on load and tensors are only read when the
+ * body references them, so loading just the SplatData never touches the
+ * optimizer state. Uncompressed entries load without a copy.
+ * params_json_offset points at the "params" entry in the file.
+ *
+ * v1 files store the body below directly. Files are written to
+ * "<name>.tmp", synced and renamed into place when complete.
+ *
+ * Body (v1 layout):
  * ┌─────────────────────────────────────────────────────────────────┐
  * │ CheckpointHeader (48 bytes)                                    │
  * │   - magic: uint32 = 0x4C464B50 ("LFKP")                        │
- * │   - version: uint32 = 1                                        │
+ * │   - version: uint32 (1 or 3)                                   │
  * │   - iteration: int32                                           │
  * │   - num_gaussians: uint32                                      │
  * │   - sh_degree: int32                                           │
@@ -51,11 +72,15 @@
 #include "core/parameters.hpp"
 #include "core/splat_data.hpp"
 #include "core/tensor.hpp"
+#include <atomic>
 #include <cstdint>
 #include <expected>
 #include <filesystem>
+#include <future>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace lfs::training {
 
@@ -63,7 +88,7 @@ namespace lfs::training {
     class BilateralGrid;
 
     constexpr uint32_t CHECKPOINT_MAGIC = 0x4C464B50; // "LFKP"
-    constexpr uint32_t CHECKPOINT_VERSION = 1;
+    constexpr uint32_t CHECKPOINT_VERSION = 3;
 
     enum class CheckpointFlags : uint32_t {
         NONE = 0,
@@ -89,14 +114,86 @@ namespace lfs::training {
         uint64_t params_json_size = 0;
     };
 
-    /// Save complete training checkpoint (strategy + optional bilateral grid)
-    std::expected<void, std::string> save_checkpoint(
+    struct CheckpointWriteOptions {
+        bool compress = false;      // zstd per tensor; compressed tensors can no longer be mapped on load
+        int compression_level = 1;  // Favours throughput, optimizer moments compress poorly anyway
+    };
+
+    /// Host copy of everything a checkpoint stores, taken between training steps
+    struct CheckpointSnapshot {
+        std::filesystem::path path; // Final .resume path
+        CheckpointHeader header;
+        std::vector<char> body;     // Header followed by the body with tensor references, see file comment
+        std::vector<std::string> tensor_names;
+        std::vector<lfs::core::Tensor> tensors; // Host copies, in reference order
+        std::string params_json;
+        double stall_ms = 0.0;      // Time the caller was blocked taking the snapshot
+    };
+
+    /// Copy the training state to host memory; the caller may resume training as soon as this returns
+    std::expected<CheckpointSnapshot, std::string> snapshot_checkpoint(
         const std::filesystem::path& path,
         int iteration,
         const IStrategy& strategy,
         const lfs::core::param::TrainingParameters& params,
         const BilateralGrid* bilateral_grid = nullptr);
 
+    /// Write a snapshot as a tensor archive to a temp file, then rename it into place
+    std::expected<void, std::string> write_checkpoint(
+        const CheckpointSnapshot& snapshot,
+        const CheckpointWriteOptions& options = {});
+
+    /// Save complete training checkpoint (strategy + optional bilateral grid), blocking until written
+    std::expected<void, std::string> save_checkpoint(
+        const std::filesystem::path& path,
+        int iteration,
+        const IStrategy& strategy,
+        const lfs::core::param::TrainingParameters& params,
+        const BilateralGrid* bilateral_grid = nullptr,
+        const CheckpointWriteOptions& options = {});
+
+    /**
+     * @brief Writes checkpoints in the background
+     *
+     * save() only blocks for the snapshot, plus any write still in flight from
+     * the previous save, so at most one staging buffer is queued at a time.
+     * All members are safe to call from different threads; save() and wait()
+     * serialize on one mutex.
+     */
+    class AsyncCheckpointWriter {
+    public:
+        explicit AsyncCheckpointWriter(CheckpointWriteOptions options = {});
+        ~AsyncCheckpointWriter();
+
+        AsyncCheckpointWriter(const AsyncCheckpointWriter&) = delete;
+        AsyncCheckpointWriter& operator=(const AsyncCheckpointWriter&) = delete;
+
+        /// Snapshot on the calling thread and queue the write; write errors are reported by wait()
+        std::expected<void, std::string> save(
+            const std::filesystem::path& path,
+            int iteration,
+            const IStrategy& strategy,
+            const lfs::core::param::TrainingParameters& params,
+            const BilateralGrid* bilateral_grid = nullptr);
+
+        /// Block until the pending write (if any) finishes and return its result
+        std::expected<void, std::string> wait();
+
+        [[nodiscard]] bool is_writing() const;
+
+        /// Time the last save() blocked its caller, including waiting on the previous write
+        [[nodiscard]] double last_stall_ms() const { return last_stall_ms_; }
+
+    private:
+        std::expected<void, std::string> wait_locked();
+
+        CheckpointWriteOptions options_;
+        // save() runs on the training thread while Trainer::shutdown() may wait() from another
+        mutable std::mutex mutex_;
+        std::future<std::expected<void, std::string>> pending_;
+        std::atomic<double> last_stall_ms_ = 0.0;
+    };
+
     /// Load checkpoint header only
     std::expected<CheckpointHeader, std::string> load_checkpoint_header(
         const std::filesystem::path& path);
@@ -110,7 +207,8 @@ namespace lfs::training {
 
     /// Load only SplatData from checkpoint
     std::expected<lfs::core::SplatData, std::string> load_checkpoint_splat_data(
-        const std::filesystem::path& path);
+        const std::filesystem::path& path,
+        lfs::core::Device device = lfs::core::Device::CUDA);
 
     /// Load only training parameters from checkpoint
     std::expected<lfs::core::param::TrainingParameters, std::string> load_checkpoint_params(
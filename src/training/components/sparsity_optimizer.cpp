@@ -180,12 +180,8 @@ namespace lfs::training {
                 return lfs::core::Tensor::zeros_bool({opa.shape()[0]}, lfs::core::Device::CUDA);
             }
 
-            // Find indices of smallest opacities using sort
-            // sort returns (values, indices) - we want smallest so ascending=true
-            auto [sorted_values, sorted_indices] = opa.sort(0, /*descending=*/false);
-
-            // Take first n_prune elements (indices only, we don't need the values)
-            auto prune_indices = sorted_indices.slice(0, 0, n_prune).to(lfs::core::DataType::Int64);
+            // Indices of the n_prune smallest opacities; their order does not matter
+            auto prune_indices = opa.topk(static_cast<size_t>(n_prune), 0, /*largest=*/false, /*sorted=*/false).second;
 
             // Create boolean mask and use proper index_put_ (now that it's fixed!)
             auto mask = lfs::core::Tensor::zeros_bool({opa.shape()[0]}, lfs::core::Device::CUDA);
@@ -218,12 +214,8 @@ namespace lfs::training {
             return lfs::core::Tensor::zeros(z.shape(), lfs::core::Device::CUDA);
         }
 
-        // Sort to find threshold
-        auto [z_sorted, _] = z.flatten().sort(0, /*descending=*/false);
-
-        // Get threshold - create tensor containing single element, then extract
-        auto z_threshold_tensor = z_sorted.slice(0, index - 1, index);
-        float z_threshold = z_threshold_tensor.item<float>();
+        // Threshold is the index-th smallest value (1-based)
+        float z_threshold = z.flatten().kthvalue(static_cast<size_t>(index), 0).first.item<float>();
 
         // Apply soft thresholding: result = (z > threshold) * z
         // This keeps values above threshold, zeros out values below
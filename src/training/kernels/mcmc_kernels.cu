@@ -3,10 +3,10 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "core/tensor.hpp"
+#include "core/tensor/internal/philox.hpp"
 #include "mcmc_kernels.hpp"
 #include <cub/cub.cuh>
 #include <cuda_runtime.h>
-#include <curand_kernel.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <thrust/adjacent_difference.h>
@@ -864,6 +864,7 @@ namespace lfs::training::mcmc {
         size_t n_samples,
         float prob_sum,
         uint64_t seed,
+        uint64_t offset,
         int64_t* __restrict__ sampled_global_indices,
         float* __restrict__ sampled_opacities,
         float* __restrict__ sampled_scales,
@@ -873,12 +874,8 @@ namespace lfs::training::mcmc {
         if (idx >= n_samples)
             return;
 
-        // Initialize RNG for this thread
-        curandState state;
-        curand_init(seed, idx, 0, &state);
-
-        // Generate random sample in [0, prob_sum]
-        float u = curand_uniform(&state) * prob_sum;
+        // Word idx of the Philox stream (seed, offset), in (0, prob_sum)
+        const float u = lfs::core::philox::to_uniform_open(lfs::core::philox::word(seed, offset, idx)) * prob_sum;
 
         // Binary search in pre-computed cumsum (O(log n) instead of O(n)!)
         int left = 0;
@@ -915,6 +912,7 @@ namespace lfs::training::mcmc {
         size_t n_alive,
         size_t n_samples,
         uint64_t seed,
+        uint64_t offset,
         int64_t* sampled_global_indices,
         float* sampled_opacities,
         float* sampled_scales,
@@ -993,6 +991,7 @@ namespace lfs::training::mcmc {
             n_samples,
             prob_sum,
             seed,
+            offset,
             sampled_global_indices,
             sampled_opacities,
             sampled_scales,
@@ -1011,6 +1010,7 @@ namespace lfs::training::mcmc {
         size_t n_samples,
         float prob_sum,
         uint64_t seed,
+        uint64_t offset,
         int64_t* __restrict__ sampled_indices,
         float* __restrict__ sampled_opacities,
         float* __restrict__ sampled_scales) {
@@ -1019,12 +1019,8 @@ namespace lfs::training::mcmc {
         if (idx >= n_samples)
             return;
 
-        // Initialize RNG for this thread
-        curandState state;
-        curand_init(seed, idx, 0, &state);
-
-        // Generate random sample in [0, prob_sum]
-        float u = curand_uniform(&state) * prob_sum;
+        // Word idx of the Philox stream (seed, offset), in (0, prob_sum)
+        const float u = lfs::core::philox::to_uniform_open(lfs::core::philox::word(seed, offset, idx)) * prob_sum;
 
         // Binary search in pre-computed cumsum (O(log N) instead of O(N)!)
         int left = 0;
@@ -1089,6 +1085,7 @@ namespace lfs::training::mcmc {
         size_t N,
         size_t n_samples,
         uint64_t seed,
+        uint64_t offset,
         int64_t* sampled_indices,
         float* sampled_opacities,
         float* sampled_scales,
@@ -1157,6 +1154,7 @@ namespace lfs::training::mcmc {
             n_samples,
             prob_sum,
             seed,
+            offset,
             sampled_indices,
             sampled_opacities,
             sampled_scales);
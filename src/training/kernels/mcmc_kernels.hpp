@@ -283,7 +283,7 @@ namespace lfs::training::mcmc {
      * @param alive_indices [n_alive] - Indices of alive Gaussians
      * @param n_alive - Number of alive Gaussians
      * @param n_samples - Number of samples to draw
-     * @param seed - Random seed for sampling
+     * @param seed, offset - Philox stream to sample from (RandomGenerator::next_philox_state())
      * @param sampled_global_indices [n_samples] - Output: sampled global indices
      * @param sampled_opacities [n_samples] - Output: gathered opacities
      * @param sampled_scales [n_samples, 3] - Output: gathered scales
@@ -297,6 +297,7 @@ namespace lfs::training::mcmc {
         size_t n_alive,
         size_t n_samples,
         uint64_t seed,
+        uint64_t offset,
         int64_t* sampled_global_indices,
         float* sampled_opacities,
         float* sampled_scales,
@@ -313,7 +314,7 @@ namespace lfs::training::mcmc {
      * @param scaling_raw [N, 3] - Source raw scales (exp() applied inline)
      * @param N - Number of Gaussians
      * @param n_samples - Number of samples to draw
-     * @param seed - Random seed for sampling
+     * @param seed, offset - Philox stream to sample from (RandomGenerator::next_philox_state())
      * @param sampled_indices [n_samples] - Output: sampled indices
      * @param sampled_opacities [n_samples] - Output: gathered opacities
      * @param sampled_scales [n_samples, 3] - Output: gathered scales
@@ -325,6 +326,7 @@ namespace lfs::training::mcmc {
         size_t N,
         size_t n_samples,
         uint64_t seed,
+        uint64_t offset,
         int64_t* sampled_indices,
         float* sampled_opacities,
         float* sampled_scales,
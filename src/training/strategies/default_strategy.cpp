@@ -569,6 +569,7 @@ namespace lfs::training {
     void DefaultStrategy::step(int iter) {
         if (iter < _params->iterations) {
             _optimizer->step(iter);
+            _splat_data->mark_positions_changed();
             _optimizer->zero_grad(iter);
             _scheduler->step();
         }
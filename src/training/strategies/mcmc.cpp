@@ -7,7 +7,6 @@
 #include "core/tensor/internal/memory_pool.hpp"
 #include "kernels/mcmc_kernels.hpp"
 #include "strategy_utils.hpp"
-#include <chrono>
 #include <cmath>
 
 namespace lfs::training {
@@ -91,9 +90,8 @@ namespace lfs::training {
             sampled_opacities = Tensor::empty({n_dead}, Device::CUDA, DataType::Float32);
             sampled_scales = Tensor::empty({n_dead, 3}, Device::CUDA, DataType::Float32);
 
-            // Generate random seed
-            static uint64_t seed_counter = 0;
-            uint64_t seed = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()) + seed_counter++;
+            // Draw from the global Philox stream so runs are reproducible under manual_seed
+            const auto [seed, offset] = lfs::core::RandomGenerator::instance().next_philox_state();
 
             // does multinomial sampling + gathering in one pass
             mcmc::launch_multinomial_sample_and_gather(
@@ -103,6 +101,7 @@ namespace lfs::training {
                 alive_indices.numel(),
                 n_dead,
                 seed,
+                offset,
                 sampled_idxs.ptr<int64_t>(),
                 sampled_opacities.ptr<float>(),
                 sampled_scales.ptr<float>(),
@@ -250,8 +249,7 @@ namespace lfs::training {
             sampled_opacities = Tensor::empty({n_new}, Device::CUDA, DataType::Float32);
             sampled_scales = Tensor::empty({n_new, 3}, Device::CUDA, DataType::Float32);
 
-            // Generate random seed
-            auto seed = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+            const auto [seed, offset] = lfs::core::RandomGenerator::instance().next_philox_state();
 
             // Call fused CUDA kernel
             mcmc::launch_multinomial_sample_all(
@@ -260,6 +258,7 @@ namespace lfs::training {
                 N,
                 n_new,
                 seed,
+                offset,
                 sampled_idxs.ptr<int64_t>(),
                 sampled_opacities.ptr<float>(),
                 sampled_scales.ptr<float>());
@@ -511,6 +510,7 @@ namespace lfs::training {
             {
                 LOG_TIMER("step_optimizer_step");
                 _optimizer->step(iter);
+                _splat_data->mark_positions_changed();
             }
             {
                 LOG_TIMER("step_zero_grad");
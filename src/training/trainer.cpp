@@ -10,6 +10,7 @@
 #include "core/image_io.hpp"
 #include "core/logger.hpp"
 #include "core/path_utils.hpp"
+#include "core/perf_trace.hpp"
 #include "core/splat_data_export.hpp"
 #include "core/splat_data_transform.hpp"
 #include "core/tensor/internal/memory_pool.hpp"
@@ -522,6 +523,9 @@ namespace lfs::training {
         stop_requested_ = true;
 
         lfs::core::image_io::BatchImageSaver::instance().wait_all();
+        if (auto result = checkpoint_writer_.wait(); !result) {
+            LOG_ERROR("Checkpoint write failed: {}", result.error());
+        }
 
         if (callback_stream_) {
             cudaStreamSynchronize(callback_stream_);
@@ -551,6 +555,50 @@ namespace lfs::training {
         training_complete_ = false;
     }
 
+    void Trainer::publish_render_snapshot() {
+        if (!render_snapshots_.requested()) {
+            return;
+        }
+
+        LFS_TRACE_SCOPE(Training, "publish_render_snapshot");
+        const auto& model = strategy_->get_model();
+        const bool published = render_snapshots_.publish([&model](lfs::core::SplatData& snapshot) {
+            // Reuse the buffer's tensors while shapes match; densification forces a reallocation
+            const auto copy_into = [](lfs::core::Tensor& dst, const lfs::core::Tensor& src) {
+                if (!src.is_valid()) {
+                    dst = lfs::core::Tensor{};
+                } else if (dst.is_valid() && dst.shape() == src.shape() && dst.dtype() == src.dtype()) {
+                    dst.copy_(src);
+                } else {
+                    dst = src.clone();
+                }
+            };
+
+            if (!snapshot.means().is_valid()) {
+                snapshot = lfs::core::SplatData(model.get_max_sh_degree(), {}, {}, {}, {}, {}, {},
+                                                model.get_scene_scale());
+            }
+            copy_into(snapshot.means(), model.means());
+            copy_into(snapshot.sh0(), model.sh0());
+            copy_into(snapshot.shN(), model.shN());
+            copy_into(snapshot.scaling_raw(), model.scaling_raw());
+            copy_into(snapshot.rotation_raw(), model.rotation_raw());
+            copy_into(snapshot.opacity_raw(), model.opacity_raw());
+            copy_into(snapshot.deleted(), model.deleted());
+            snapshot.set_max_sh_degree(model.get_max_sh_degree());
+            snapshot.set_active_sh_degree(model.get_active_sh_degree());
+            snapshot.mark_positions_changed();
+
+            // The viewer reads these on its own stream
+            cudaStreamSynchronize(nullptr);
+        });
+
+        if (published) {
+            LOG_TRACE("Published render snapshot: {} gaussians in {:.2f} ms", model.size(),
+                      render_snapshots_.stats().last_publish_ms);
+        }
+    }
+
     void Trainer::handle_control_requests(int iter, std::stop_token stop_token) {
         // Check stop token first
         if (stop_token.stop_requested()) {
@@ -577,12 +625,9 @@ namespace lfs::training {
         // Handle save request - save a real checkpoint (not just PLY)
         if (save_requested_.exchange(false)) {
             LOG_INFO("Saving checkpoint at iteration {}...", iter);
-            auto result = save_checkpoint(iter);
-            if (result) {
-                auto checkpoint_path = params_.dataset.output_path / "checkpoints" /
-                                       std::format("checkpoint_{}.resume", iter);
-                LOG_INFO("Checkpoint saved to {}", lfs::core::path_to_utf8(checkpoint_path));
-            } else {
+            auto result = checkpoint_writer_.save(
+                params_.dataset.output_path, iter, *strategy_, params_, bilateral_grid_.get());
+            if (!result) {
                 LOG_ERROR("Failed to save checkpoint: {}", result.error());
             }
         }
@@ -693,6 +738,7 @@ namespace lfs::training {
             while (is_paused_.load() && !stop_requested_.load() && !stop_token.stop_requested()) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
                 handle_control_requests(iter, stop_token);
+                publish_render_snapshot();
             }
 
             // Check stop again after potential pause
@@ -700,6 +746,8 @@ namespace lfs::training {
                 return StepResult::Stop;
             }
 
+            LFS_TRACE_SCOPE(Training, "train_step");
+
             nvtxRangePush("background_for_step");
             lfs::core::Tensor& bg = background_for_step(iter);
             nvtxRangePop();
@@ -744,6 +792,7 @@ namespace lfs::training {
                 const int tile_y_offset = tile_row * tile_height;
 
                 nvtxRangePush(std::format("tile_{}x{}", tile_row, tile_col).c_str());
+                LFS_TRACE_SCOPE(Training, "forward_backward");
 
                 // Extract GT image tile
                 lfs::core::Tensor gt_tile;
@@ -1024,8 +1073,7 @@ namespace lfs::training {
             {
                 DeferredEvents deferred;
                 {
-                    std::unique_lock<std::shared_mutex> lock(render_mutex_);
-
+                    LFS_TRACE_SCOPE(Training, "strategy_step");
                     // Skip post_backward during sparsification phase
                     const bool in_sparsification = params_.optimization.enable_sparsity &&
                                                    iter > (params_.optimization.iterations - params_.optimization.sparsify_steps);
@@ -1123,6 +1171,7 @@ namespace lfs::training {
         ready_to_start_ = true; // Skip GUI wait for now
 
         is_running_ = true; // Now we can start
+        LFS_TRACE_THREAD_NAME("training");
         LOG_INFO("Starting training loop with {} workers", params_.optimization.num_workers);
         // initializing image loader
         auto& cache_loader = lfs::io::CacheLoader::getInstance(params_.dataset.loading_params.use_cpu_memory, params_.dataset.loading_params.use_fs_cache);
@@ -1172,6 +1221,22 @@ namespace lfs::training {
             }
             auto train_dataloader = create_infinite_pipelined_dataloader(train_dataset_, pipelined_config);
 
+            // From here the viewer renders published snapshots instead of the live model
+            struct SnapshotSession {
+                lfs::core::SnapshotPublisher<lfs::core::SplatData>& snapshots;
+                ~SnapshotSession() {
+                    snapshots.deactivate();
+                    snapshots.reset();
+                    if (const auto stats = snapshots.stats(); stats.publishes > 0) {
+                        LOG_PERF("Render snapshots: {} published (avg {:.2f} ms, max {:.2f} ms), {} skipped, "
+                                 "reader wait avg {:.2f} us / max {:.2f} us",
+                                 stats.publishes, stats.avg_publish_ms, stats.max_publish_ms, stats.skipped,
+                                 stats.avg_reader_wait_us, stats.max_reader_wait_us);
+                    }
+                }
+            } snapshot_session{render_snapshots_};
+            render_snapshots_.activate();
+
             LOG_DEBUG("Starting training iterations");
             while (iter <= params_.optimization.iterations) {
                 lfs::core::CudaMemoryPool::instance().set_iteration(iter);
@@ -1180,7 +1245,10 @@ namespace lfs::training {
                 if (callback_busy_.load())
                     cudaStreamSynchronize(callback_stream_);
 
-                auto example_opt = train_dataloader->next();
+                auto example_opt = [&] {
+                    LFS_TRACE_SCOPE(Loader, "wait_for_batch");
+                    return train_dataloader->next();
+                }();
                 if (!example_opt) {
                     LOG_ERROR("DataLoader returned nullopt unexpectedly");
                     break;
@@ -1245,6 +1313,9 @@ namespace lfs::training {
                     break;
                 }
 
+                // Step boundary: the model is consistent until the next step starts
+                publish_render_snapshot();
+
                 // Launch callback for async progress update (except first iteration)
                 if (iter > 1 && callback_) {
                     callback_busy_ = true;
@@ -1308,8 +1379,11 @@ namespace lfs::training {
         lfs::core::save_ply(strategy_->get_model(), save_path, iter_num, join_threads);
 
         // Save checkpoint alongside PLY for training resumption
-        auto ckpt_result = lfs::training::save_checkpoint(
+        auto ckpt_result = checkpoint_writer_.save(
             save_path, iter_num, *strategy_, params_, bilateral_grid_.get());
+        if (ckpt_result && join_threads) {
+            ckpt_result = checkpoint_writer_.wait();
+        }
         if (!ckpt_result) {
             LOG_WARN("Failed to save checkpoint: {}", ckpt_result.error());
         }
@@ -1322,9 +1396,12 @@ namespace lfs::training {
             return std::unexpected("Cannot save checkpoint: no strategy initialized");
         }
 
-        return lfs::training::save_checkpoint(
-            params_.dataset.output_path, iteration, *strategy_, params_,
-            bilateral_grid_.get());
+        if (auto result = checkpoint_writer_.save(
+                params_.dataset.output_path, iteration, *strategy_, params_, bilateral_grid_.get());
+            !result) {
+            return result;
+        }
+        return checkpoint_writer_.wait();
     }
 
     std::expected<int, std::string> Trainer::load_checkpoint(const std::filesystem::path& checkpoint_path) {
@@ -9,6 +9,8 @@
 #include "components/sparsity_optimizer.hpp"
 #include "core/camera.hpp"
 #include "core/parameters.hpp"
+#include "core/snapshot_publisher.hpp"
+#include "core/splat_data.hpp"
 #include "core/tensor.hpp"
 #include "dataset.hpp"
 #include "metrics/metrics.hpp"
@@ -19,7 +21,6 @@
 #include <expected>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <stop_token>
 
 // Forward declaration for Scene
@@ -86,8 +87,9 @@ namespace lfs::training {
         // just for viewer to get model
         const IStrategy& get_strategy() const { return *strategy_; }
 
-        // Allow viewer to lock for rendering
-        std::shared_mutex& getRenderMutex() const { return render_mutex_; }
+        // Model snapshots for the viewer: while training runs, pin() yields the latest published
+        // copy instead of the live model; request() asks for a fresh one at the next step boundary
+        const lfs::core::SnapshotPublisher<lfs::core::SplatData>& getRenderSnapshots() const { return render_snapshots_; }
 
         const lfs::core::param::TrainingParameters& getParams() const { return params_; }
         void setParams(const lfs::core::param::TrainingParameters& params) { params_ = params; }
@@ -184,6 +186,9 @@ namespace lfs::training {
         // Handle control requests
         void handle_control_requests(int iter, std::stop_token stop_token = {});
 
+        // Copy the model into the free snapshot buffer if the viewer asked for one
+        void publish_render_snapshot();
+
         void save_ply(const std::filesystem::path& save_path, int iter_num, bool join_threads = true);
 
         // Member variables
@@ -208,8 +213,11 @@ namespace lfs::training {
         // Metrics evaluator - handles all evaluation logic
         std::unique_ptr<lfs::training::MetricsEvaluator> evaluator_;
 
-        // Single mutex that protects the model during training
-        mutable std::shared_mutex render_mutex_;
+        // Periodic checkpoints are snapshotted on the training thread and written in the background
+        AsyncCheckpointWriter checkpoint_writer_;
+
+        // Double-buffered model copies the viewer renders without blocking training
+        lfs::core::SnapshotPublisher<lfs::core::SplatData> render_snapshots_;
 
         // Mutex for initialization to ensure thread safety
         mutable std::mutex init_mutex_;
@@ -4,17 +4,36 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
 namespace lfs::vis::command {
 
+    // Bytes retained by a command for undo/redo
+    struct MemoryUsage {
+        size_t device_bytes = 0;
+        size_t host_bytes = 0;
+
+        [[nodiscard]] size_t total() const { return device_bytes + host_bytes; }
+
+        MemoryUsage& operator+=(const MemoryUsage& other) {
+            device_bytes += other.device_bytes;
+            host_bytes += other.host_bytes;
+            return *this;
+        }
+    };
+
     class Command {
     public:
         virtual ~Command() = default;
         virtual void undo() = 0;
         virtual void redo() = 0;
         virtual std::string getName() const = 0;
+
+        virtual MemoryUsage memoryUsage() const { return {}; }
+        // Move device-resident undo state to host memory; undo/redo keep working
+        virtual void spillToHost() {}
     };
 
     using CommandPtr = std::unique_ptr<Command>;
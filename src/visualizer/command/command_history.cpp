@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "command_history.hpp"
+#include "core/logger.hpp"
 
 namespace lfs::vis::command {
 
@@ -16,6 +17,7 @@ namespace lfs::vis::command {
 
         history_.push_back(std::move(cmd));
         current_index_ = history_.size();
+        enforceBudget();
     }
 
     void CommandHistory::undo() {
@@ -37,4 +39,72 @@ namespace lfs::vis::command {
         current_index_ = 0;
     }
 
+    void CommandHistory::setMemoryBudget(const size_t bytes) {
+        memory_budget_ = bytes;
+        enforceBudget();
+    }
+
+    void CommandHistory::setDeviceBudget(const size_t bytes) {
+        device_budget_ = bytes;
+        enforceBudget();
+    }
+
+    MemoryUsage CommandHistory::memoryUsage() const {
+        MemoryUsage usage;
+        for (const auto& cmd : history_) {
+            usage += cmd->memoryUsage();
+        }
+        return usage;
+    }
+
+    void CommandHistory::enforceBudget() {
+        if (history_.size() <= 1)
+            return;
+
+        std::vector<MemoryUsage> usages;
+        usages.reserve(history_.size());
+        MemoryUsage total;
+        for (const auto& cmd : history_) {
+            usages.push_back(cmd->memoryUsage());
+            total += usages.back();
+        }
+
+        // Spill oldest first; the newest entry stays resident for a fast undo
+        for (size_t i = 0; i + 1 < history_.size() && total.device_bytes > device_budget_; ++i) {
+            if (usages[i].device_bytes == 0)
+                continue;
+            history_[i]->spillToHost();
+            const auto spilled = history_[i]->memoryUsage();
+            total.device_bytes -= usages[i].device_bytes;
+            total.host_bytes -= usages[i].host_bytes;
+            total += spilled;
+            usages[i] = spilled;
+        }
+
+        // Drop the oldest applied entries; entries past current_index_ are still
+        // pending redo and must not be dropped from the front
+        size_t dropped = 0;
+        while (dropped < current_index_ && history_.size() - dropped > 1 && total.total() > memory_budget_) {
+            total.device_bytes -= usages[dropped].device_bytes;
+            total.host_bytes -= usages[dropped].host_bytes;
+            ++dropped;
+        }
+
+        // Still over with every applied entry gone (after undo): trim the newest redo entries
+        size_t kept = history_.size();
+        while (kept > current_index_ && kept - dropped > 1 && total.total() > memory_budget_) {
+            --kept;
+            total.device_bytes -= usages[kept].device_bytes;
+            total.host_bytes -= usages[kept].host_bytes;
+        }
+
+        if (dropped > 0 || kept < history_.size()) {
+            history_.resize(kept);
+            history_.erase(history_.begin(), history_.begin() + static_cast<std::ptrdiff_t>(dropped));
+            current_index_ -= dropped;
+            LOG_DEBUG("Undo history over budget: dropped {} oldest and {} redo entries, {} MB retained",
+                      dropped, usages.size() - kept, total.total() >> 20);
+        }
+    }
+
 } // namespace lfs::vis::command
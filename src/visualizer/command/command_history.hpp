@@ -9,8 +9,18 @@
 
 namespace lfs::vis::command {
 
+    /**
+     * Linear undo/redo stack with a memory budget.
+     *
+     * After each execute, the oldest entries are spilled to host memory while
+     * device-resident undo state exceeds the device budget, then dropped while
+     * the total exceeds the memory budget. The newest entry is always kept.
+     */
     class CommandHistory {
     public:
+        static constexpr size_t DEFAULT_MEMORY_BUDGET = 2ULL << 30;
+        static constexpr size_t DEFAULT_DEVICE_BUDGET = 512ULL << 20;
+
         void execute(CommandPtr cmd);
         void undo();
         void redo();
@@ -20,9 +30,22 @@ namespace lfs::vis::command {
         bool canRedo() const { return current_index_ < history_.size(); }
         size_t size() const { return history_.size(); }
 
+        // Total bytes (device + host) retained by undo/redo entries
+        void setMemoryBudget(size_t bytes);
+        // Device bytes retained before old entries move to host memory; SIZE_MAX disables spilling
+        void setDeviceBudget(size_t bytes);
+        size_t memoryBudget() const { return memory_budget_; }
+        size_t deviceBudget() const { return device_budget_; }
+
+        MemoryUsage memoryUsage() const;
+
     private:
+        void enforceBudget();
+
         std::vector<CommandPtr> history_;
         size_t current_index_ = 0;
+        size_t memory_budget_ = DEFAULT_MEMORY_BUDGET;
+        size_t device_budget_ = DEFAULT_DEVICE_BUDGET;
     };
 
 } // namespace lfs::vis::command
@@ -29,6 +29,20 @@ namespace lfs::vis::command {
             return commands_.empty() ? "Composite" : commands_[0]->getName();
         }
 
+        MemoryUsage memoryUsage() const override {
+            MemoryUsage usage;
+            for (const auto& cmd : commands_) {
+                usage += cmd->memoryUsage();
+            }
+            return usage;
+        }
+
+        void spillToHost() override {
+            for (auto& cmd : commands_) {
+                cmd->spillToHost();
+            }
+        }
+
         [[nodiscard]] bool empty() const { return commands_.empty(); }
 
     private:
@@ -13,8 +13,8 @@ namespace lfs::vis::command {
                              lfs::core::Tensor old_deleted_mask,
                              lfs::core::Tensor new_deleted_mask)
         : node_name_(std::move(node_name)),
-          old_deleted_mask_(std::move(old_deleted_mask)),
-          new_deleted_mask_(std::move(new_deleted_mask)) {
+          old_deleted_mask_(MaskSnapshot::encode(old_deleted_mask)),
+          new_deleted_mask_(MaskSnapshot::encode_delta(new_deleted_mask, old_deleted_mask)) {
     }
 
     void CropCommand::undo() {
@@ -29,7 +29,7 @@ namespace lfs::vis::command {
             return;
         }
 
-        node->model->deleted() = old_deleted_mask_.clone();
+        node->model->deleted() = old_deleted_mask_.decode();
         scene.markDirty();
     }
 
@@ -45,8 +45,14 @@ namespace lfs::vis::command {
             return;
         }
 
-        node->model->deleted() = new_deleted_mask_.clone();
+        node->model->deleted() = new_deleted_mask_.decode_delta(old_deleted_mask_.decode());
         scene.markDirty();
     }
 
+    MemoryUsage CropCommand::memoryUsage() const {
+        auto usage = old_deleted_mask_.memory_usage();
+        usage += new_deleted_mask_.memory_usage();
+        return usage;
+    }
+
 } // namespace lfs::vis::command
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "command/command.hpp"
+#include "command/tensor_snapshot.hpp"
 #include "core/tensor.hpp"
 #include <string>
 
@@ -12,6 +13,7 @@ namespace lfs::vis::command {
 
     // Undo/redo command for soft crop operations using deletion masks
     // Uses services() to access SceneManager - no stored pointer
+    // The old mask is kept run-length encoded and the new one as a delta against it
     class CropCommand : public Command {
     public:
         CropCommand(std::string node_name,
@@ -21,11 +23,12 @@ namespace lfs::vis::command {
         void undo() override;
         void redo() override;
         [[nodiscard]] std::string getName() const override { return "Crop"; }
+        [[nodiscard]] MemoryUsage memoryUsage() const override;
 
     private:
         const std::string node_name_;
-        const lfs::core::Tensor old_deleted_mask_;
-        const lfs::core::Tensor new_deleted_mask_;
+        const MaskSnapshot old_deleted_mask_;
+        const MaskSnapshot new_deleted_mask_; // Delta against old_deleted_mask_
     };
 
 } // namespace lfs::vis::command
@@ -19,11 +19,23 @@ namespace lfs::vis::command {
         : scene_manager_(scene_manager),
           node_name_(std::move(node_name)),
           axis_(axis),
-          center_(center),
-          selection_mask_(std::move(selection_mask)),
-          old_means_(std::move(old_means)),
-          old_rotation_(std::move(old_rotation)),
-          old_shN_(std::move(old_shN)) {}
+          center_(center) {
+        if (!selection_mask || !selection_mask->is_valid())
+            return;
+
+        selection_mask_ = MaskSnapshot::encode(*selection_mask);
+
+        // Mirroring only rewrites the selected rows
+        auto indices = selection_mask->ne(0).nonzero();
+        if (indices.ndim() == 2)
+            indices = indices.squeeze(1);
+        if (old_means && old_means->is_valid())
+            old_means_ = RowDelta::capture_rows(*old_means, indices);
+        if (old_rotation && old_rotation->is_valid())
+            old_rotation_ = RowDelta::capture_rows(*old_rotation, indices);
+        if (old_shN && old_shN->is_valid())
+            old_shN_ = RowDelta::capture_rows(*old_shN, indices);
+    }
 
     void MirrorCommand::restoreState() {
         if (!scene_manager_)
@@ -35,26 +47,38 @@ namespace lfs::vis::command {
 
         auto& model = *node->model;
 
-        if (old_means_ && old_means_->is_valid()) {
-            model.means().copy_from(*old_means_);
-        }
-        if (old_rotation_ && old_rotation_->is_valid()) {
-            model.rotation_raw().copy_from(*old_rotation_);
+        if (old_means_.restore_before(model.means())) {
+            model.mark_positions_changed();
         }
-        if (old_shN_ && old_shN_->is_valid() && model.shN().is_valid()) {
-            model.shN().copy_from(*old_shN_);
+        old_rotation_.restore_before(model.rotation_raw());
+        if (model.shN().is_valid()) {
+            old_shN_.restore_before(model.shN());
         }
     }
 
     void MirrorCommand::applyMirror() {
-        if (!scene_manager_ || !selection_mask_ || !selection_mask_->is_valid())
+        if (!scene_manager_ || !selection_mask_.valid())
             return;
 
         auto* node = scene_manager_->getScene().getMutableNode(node_name_);
         if (!node || !node->model)
             return;
 
-        lfs::core::mirror_gaussians(*node->model, *selection_mask_, axis_, center_);
+        lfs::core::mirror_gaussians(*node->model, selection_mask_.decode(), axis_, center_);
+    }
+
+    MemoryUsage MirrorCommand::memoryUsage() const {
+        auto usage = selection_mask_.memory_usage();
+        usage += old_means_.memory_usage();
+        usage += old_rotation_.memory_usage();
+        usage += old_shN_.memory_usage();
+        return usage;
+    }
+
+    void MirrorCommand::spillToHost() {
+        old_means_.spill_to_host();
+        old_rotation_.spill_to_host();
+        old_shN_.spill_to_host();
     }
 
     void MirrorCommand::undo() { restoreState(); }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "command/command.hpp"
+#include "command/tensor_snapshot.hpp"
 #include "core/splat_data_mirror.hpp"
 #include "core/tensor_fwd.hpp"
 #include <glm/glm.hpp>
@@ -18,6 +19,7 @@ namespace lfs::vis {
 namespace lfs::vis::command {
 
     /// Command for mirroring selected gaussians with undo/redo support
+    /// Keeps only the selected rows of the old attributes; redo re-runs the mirror
     class MirrorCommand final : public Command {
     public:
         MirrorCommand(SceneManager* scene_manager,
@@ -32,6 +34,8 @@ namespace lfs::vis::command {
         void undo() override;
         void redo() override;
         [[nodiscard]] std::string getName() const override;
+        [[nodiscard]] MemoryUsage memoryUsage() const override;
+        void spillToHost() override;
 
     private:
         void restoreState();
@@ -41,10 +45,10 @@ namespace lfs::vis::command {
         const std::string node_name_;
         const lfs::core::MirrorAxis axis_;
         const glm::vec3 center_;
-        const std::shared_ptr<lfs::core::Tensor> selection_mask_;
-        const std::shared_ptr<lfs::core::Tensor> old_means_;
-        const std::shared_ptr<lfs::core::Tensor> old_rotation_;
-        const std::shared_ptr<lfs::core::Tensor> old_shN_;
+        MaskSnapshot selection_mask_;
+        RowDelta old_means_;
+        RowDelta old_rotation_;
+        RowDelta old_shN_;
     };
 
 } // namespace lfs::vis::command
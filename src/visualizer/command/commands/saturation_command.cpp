@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "saturation_command.hpp"
+#include "core/logger.hpp"
 #include "core/splat_data.hpp"
 #include "scene/scene_manager.hpp"
 
@@ -13,12 +14,14 @@ namespace lfs::vis::command {
                                          std::shared_ptr<lfs::core::Tensor> old_sh0,
                                          std::shared_ptr<lfs::core::Tensor> new_sh0)
         : scene_manager_(scene_manager),
-          node_name_(std::move(node_name)),
-          old_sh0_(std::move(old_sh0)),
-          new_sh0_(std::move(new_sh0)) {}
+          node_name_(std::move(node_name)) {
+        if (old_sh0 && new_sh0 && old_sh0->is_valid() && new_sh0->is_valid()) {
+            sh0_delta_ = RowDelta::capture(*old_sh0, *new_sh0);
+        }
+    }
 
-    void SaturationCommand::applySH0(const std::shared_ptr<lfs::core::Tensor>& sh0) {
-        if (!scene_manager_ || !sh0 || !sh0->is_valid())
+    void SaturationCommand::applySH0(const bool after) {
+        if (!scene_manager_ || !sh0_delta_.valid())
             return;
 
         auto* node = scene_manager_->getScene().getMutableNode(node_name_);
@@ -29,16 +32,17 @@ namespace lfs::vis::command {
         if (!model_sh0.is_valid())
             return;
 
-        // Copy the tensor data
-        model_sh0.copy_from(*sh0);
+        if (!(after ? sh0_delta_.restore_after(model_sh0) : sh0_delta_.restore_before(model_sh0))) {
+            LOG_WARN("SaturationCommand: SH0 of '{}' changed shape, cannot restore", node_name_);
+        }
     }
 
     void SaturationCommand::undo() {
-        applySH0(old_sh0_);
+        applySH0(false);
     }
 
     void SaturationCommand::redo() {
-        applySH0(new_sh0_);
+        applySH0(true);
     }
 
 } // namespace lfs::vis::command
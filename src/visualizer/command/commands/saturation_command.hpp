@@ -5,6 +5,7 @@
 #pragma once
 
 #include "command/command.hpp"
+#include "command/tensor_snapshot.hpp"
 #include "core/tensor_fwd.hpp"
 #include <memory>
 #include <string>
@@ -20,6 +21,7 @@ namespace lfs::vis::command {
         // node_name: name of the node whose SH0 was modified
         // old_sh0: SH0 tensor before the saturation adjustment
         // new_sh0: SH0 tensor after the saturation adjustment
+        // Only the rows the stroke changed are kept
         SaturationCommand(SceneManager* scene_manager,
                           std::string node_name,
                           std::shared_ptr<lfs::core::Tensor> old_sh0,
@@ -28,14 +30,15 @@ namespace lfs::vis::command {
         void undo() override;
         void redo() override;
         std::string getName() const override { return "Saturation"; }
+        MemoryUsage memoryUsage() const override { return sh0_delta_.memory_usage(); }
+        void spillToHost() override { sh0_delta_.spill_to_host(); }
 
     private:
-        void applySH0(const std::shared_ptr<lfs::core::Tensor>& sh0);
+        void applySH0(bool after);
 
         SceneManager* scene_manager_;
         std::string node_name_;
-        std::shared_ptr<lfs::core::Tensor> old_sh0_;
-        std::shared_ptr<lfs::core::Tensor> new_sh0_;
+        RowDelta sh0_delta_;
     };
 
 } // namespace lfs::vis::command
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-3.0-or-later */
 
 #include "selection_command.hpp"
+#include "core/tensor.hpp"
 #include "scene/scene_manager.hpp"
 
 namespace lfs::vis::command {
@@ -10,16 +11,21 @@ namespace lfs::vis::command {
     SelectionCommand::SelectionCommand(SceneManager* scene_manager,
                                        std::shared_ptr<lfs::core::Tensor> old_selection,
                                        std::shared_ptr<lfs::core::Tensor> new_selection)
-        : scene_manager_(scene_manager),
-          old_selection_(std::move(old_selection)),
-          new_selection_(std::move(new_selection)) {}
+        : scene_manager_(scene_manager) {
+        const lfs::core::Tensor none;
+        const auto& old_mask = old_selection ? *old_selection : none;
+        old_selection_ = MaskSnapshot::encode(old_mask);
+        if (new_selection) {
+            new_selection_ = MaskSnapshot::encode_delta(*new_selection, old_mask);
+        }
+    }
 
     void SelectionCommand::undo() {
         if (!scene_manager_)
             return;
 
-        if (old_selection_ && old_selection_->is_valid()) {
-            scene_manager_->getScene().setSelectionMask(old_selection_);
+        if (auto mask = old_selection_.decode(); mask.is_valid()) {
+            scene_manager_->getScene().setSelectionMask(std::make_shared<lfs::core::Tensor>(std::move(mask)));
         } else {
             scene_manager_->getScene().clearSelection();
         }
@@ -29,11 +35,17 @@ namespace lfs::vis::command {
         if (!scene_manager_)
             return;
 
-        if (new_selection_ && new_selection_->is_valid()) {
-            scene_manager_->getScene().setSelectionMask(new_selection_);
+        if (auto mask = new_selection_.decode_delta(old_selection_.decode()); mask.is_valid()) {
+            scene_manager_->getScene().setSelectionMask(std::make_shared<lfs::core::Tensor>(std::move(mask)));
         } else {
             scene_manager_->getScene().clearSelection();
         }
     }
 
+    MemoryUsage SelectionCommand::memoryUsage() const {
+        auto usage = old_selection_.memory_usage();
+        usage += new_selection_.memory_usage();
+        return usage;
+    }
+
 } // namespace lfs::vis::command
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "command/command.hpp"
+#include "command/tensor_snapshot.hpp"
 #include "core/tensor_fwd.hpp"
 #include <memory>
 
@@ -14,6 +15,7 @@ namespace lfs::vis {
 
 namespace lfs::vis::command {
 
+    // Masks are stored run-length encoded, the new one as a delta against the old
     class SelectionCommand : public Command {
     public:
         SelectionCommand(SceneManager* scene_manager,
@@ -23,11 +25,12 @@ namespace lfs::vis::command {
         void undo() override;
         void redo() override;
         std::string getName() const override { return "Selection"; }
+        MemoryUsage memoryUsage() const override;
 
     private:
         SceneManager* scene_manager_;
-        std::shared_ptr<lfs::core::Tensor> old_selection_;
-        std::shared_ptr<lfs::core::Tensor> new_selection_;
+        MaskSnapshot old_selection_;
+        MaskSnapshot new_selection_;
     };
 
 } // namespace lfs::vis::command
@@ -0,0 +1,246 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "tensor_snapshot.hpp"
+#include "core/logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace lfs::vis::command {
+
+    using lfs::core::DataType;
+    using lfs::core::Device;
+    using lfs::core::Tensor;
+
+    namespace {
+
+        constexpr size_t BYTES_PER_RUN = sizeof(uint32_t) + sizeof(uint8_t);
+
+        bool is_byte_mask(const Tensor& t) {
+            return t.is_valid() && (t.dtype() == DataType::Bool || t.dtype() == DataType::UInt8);
+        }
+
+        Tensor to_host(const Tensor& t) {
+            return t.device() == Device::CPU ? t.contiguous() : t.cpu().contiguous();
+        }
+
+        Tensor to_device(Tensor t, const Device device) {
+            return device == Device::CPU ? t : t.to(device);
+        }
+
+        void add_bytes(MemoryUsage& usage, const Tensor& t) {
+            if (!t.is_valid())
+                return;
+            (t.device() == Device::CPU ? usage.host_bytes : usage.device_bytes) += t.bytes();
+        }
+
+        // Row numbers of the nonzero entries of a 1-D mask, as Int32 for index_copy_
+        Tensor row_indices(const Tensor& mask) {
+            auto indices = mask.nonzero();
+            if (indices.ndim() == 2)
+                indices = indices.squeeze(1);
+            if (indices.dtype() != DataType::Int32)
+                indices = indices.to(DataType::Int32);
+            return indices;
+        }
+
+    } // namespace
+
+    // ========== MaskSnapshot ==========
+
+    MaskSnapshot MaskSnapshot::encode(const Tensor& mask) {
+        MaskSnapshot snapshot;
+        if (!mask.is_valid())
+            return snapshot;
+        if (!is_byte_mask(mask)) {
+            LOG_ERROR("MaskSnapshot: expected a bool or uint8 mask, got {}", lfs::core::dtype_name(mask.dtype()));
+            return snapshot;
+        }
+
+        const auto host = to_host(mask);
+        snapshot.valid_ = true;
+        snapshot.shape_ = mask.shape();
+        snapshot.dtype_ = mask.dtype();
+        snapshot.device_ = mask.device();
+        snapshot.encode_bytes(host.ptr<uint8_t>(), host.numel());
+        return snapshot;
+    }
+
+    MaskSnapshot MaskSnapshot::encode_delta(const Tensor& mask, const Tensor& base) {
+        if (!mask.is_valid() || !is_byte_mask(base) || base.shape() != mask.shape() || base.dtype() != mask.dtype())
+            return encode(mask);
+        if (!is_byte_mask(mask))
+            return encode(mask);
+
+        const auto host = to_host(mask);
+        const auto host_base = to_host(base);
+        const size_t n = host.numel();
+        std::vector<uint8_t> diff(n);
+        const uint8_t* const a = host.ptr<uint8_t>();
+        const uint8_t* const b = host_base.ptr<uint8_t>();
+        for (size_t i = 0; i < n; ++i)
+            diff[i] = a[i] ^ b[i];
+
+        MaskSnapshot snapshot;
+        snapshot.valid_ = true;
+        snapshot.is_delta_ = true;
+        snapshot.shape_ = mask.shape();
+        snapshot.dtype_ = mask.dtype();
+        snapshot.device_ = mask.device();
+        snapshot.encode_bytes(diff.data(), n);
+        return snapshot;
+    }
+
+    void MaskSnapshot::encode_bytes(const uint8_t* const data, const size_t n) {
+        numel_ = n;
+        run_lengths_.clear();
+        run_values_.clear();
+        raw_.clear();
+
+        size_t i = 0;
+        while (i < n) {
+            const uint8_t value = data[i];
+            size_t j = i + 1;
+            while (j < n && data[j] == value && j - i < std::numeric_limits<uint32_t>::max())
+                ++j;
+            run_lengths_.push_back(static_cast<uint32_t>(j - i));
+            run_values_.push_back(value);
+            i = j;
+
+            // Runs stopped paying off: keep raw bytes instead
+            if (run_lengths_.size() * BYTES_PER_RUN >= n) {
+                run_lengths_.clear();
+                run_values_.clear();
+                raw_.assign(data, data + n);
+                break;
+            }
+        }
+        run_lengths_.shrink_to_fit();
+        run_values_.shrink_to_fit();
+    }
+
+    void MaskSnapshot::decode_bytes(uint8_t* const out) const {
+        if (!raw_.empty()) {
+            std::memcpy(out, raw_.data(), raw_.size());
+            return;
+        }
+        size_t pos = 0;
+        for (size_t r = 0; r < run_lengths_.size(); ++r) {
+            std::memset(out + pos, run_values_[r], run_lengths_[r]);
+            pos += run_lengths_[r];
+        }
+    }
+
+    Tensor MaskSnapshot::decode() const {
+        if (!valid_)
+            return {};
+        if (is_delta_) {
+            LOG_ERROR("MaskSnapshot: delta snapshot decoded without its base");
+            return {};
+        }
+        auto host = Tensor::empty(shape_, Device::CPU, dtype_);
+        decode_bytes(host.ptr<uint8_t>());
+        return to_device(std::move(host), device_);
+    }
+
+    Tensor MaskSnapshot::decode_delta(const Tensor& base) const {
+        if (!is_delta_)
+            return decode();
+        if (!is_byte_mask(base) || base.shape() != shape_ || base.dtype() != dtype_) {
+            LOG_ERROR("MaskSnapshot: delta base does not match the captured mask");
+            return {};
+        }
+
+        auto host = Tensor::empty(shape_, Device::CPU, dtype_);
+        uint8_t* const out = host.ptr<uint8_t>();
+        decode_bytes(out);
+        const auto host_base = to_host(base);
+        const uint8_t* const b = host_base.ptr<uint8_t>();
+        for (size_t i = 0; i < numel_; ++i)
+            out[i] ^= b[i];
+        return to_device(std::move(host), device_);
+    }
+
+    MemoryUsage MaskSnapshot::memory_usage() const {
+        return {.device_bytes = 0,
+                .host_bytes = run_lengths_.capacity() * sizeof(uint32_t) + run_values_.capacity() + raw_.capacity()};
+    }
+
+    // ========== RowDelta ==========
+
+    RowDelta RowDelta::capture(const Tensor& before, const Tensor& after) {
+        RowDelta delta;
+        if (!before.is_valid() || !after.is_valid() || before.ndim() == 0 || before.shape() != after.shape()) {
+            LOG_ERROR("RowDelta: before/after tensors are invalid or differ in shape");
+            return delta;
+        }
+
+        auto changed = before.ne(after);
+        if (changed.ndim() > 1) {
+            std::vector<int> dims = {1};
+            changed = changed.flatten(1).any(std::span<const int>(dims), false);
+        }
+
+        delta.shape_ = before.shape();
+        delta.indices_ = row_indices(changed);
+        if (delta.indices_.numel() > 0) {
+            delta.before_ = before.index_select(0, delta.indices_).contiguous();
+            delta.after_ = after.index_select(0, delta.indices_).contiguous();
+        }
+        return delta;
+    }
+
+    RowDelta RowDelta::capture_rows(const Tensor& before, const Tensor& indices) {
+        RowDelta delta;
+        if (!before.is_valid() || before.ndim() == 0 || !indices.is_valid()) {
+            LOG_ERROR("RowDelta: invalid tensor or indices");
+            return delta;
+        }
+
+        delta.shape_ = before.shape();
+        delta.indices_ = indices.dtype() == DataType::Int32 ? indices : indices.to(DataType::Int32);
+        if (delta.indices_.device() != before.device())
+            delta.indices_ = delta.indices_.to(before.device());
+        if (delta.indices_.numel() > 0)
+            delta.before_ = before.index_select(0, delta.indices_).contiguous();
+        return delta;
+    }
+
+    bool RowDelta::restore(const Tensor& rows, Tensor& target) const {
+        if (!valid() || !target.is_valid() || target.shape() != shape_)
+            return false;
+        if (indices_.numel() == 0)
+            return true;
+        if (!rows.is_valid())
+            return false;
+
+        const auto device = target.device();
+        const auto indices = indices_.device() == device ? indices_ : indices_.to(device);
+        const auto values = rows.device() == device ? rows : rows.to(device);
+        target.index_copy_(0, indices, values);
+        return true;
+    }
+
+    bool RowDelta::restore_before(Tensor& target) const { return restore(before_, target); }
+    bool RowDelta::restore_after(Tensor& target) const { return restore(after_, target); }
+
+    void RowDelta::spill_to_host() {
+        if (indices_.is_valid() && indices_.device() != Device::CPU)
+            indices_ = indices_.cpu();
+        if (before_.is_valid() && before_.device() != Device::CPU)
+            before_ = before_.cpu();
+        if (after_.is_valid() && after_.device() != Device::CPU)
+            after_ = after_.cpu();
+    }
+
+    MemoryUsage RowDelta::memory_usage() const {
+        MemoryUsage usage;
+        add_bytes(usage, indices_);
+        add_bytes(usage, before_);
+        add_bytes(usage, after_);
+        return usage;
+    }
+
+} // namespace lfs::vis::command
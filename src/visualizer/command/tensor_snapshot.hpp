@@ -0,0 +1,90 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "command.hpp"
+#include "core/tensor.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace lfs::vis::command {
+
+    /**
+     * @brief Host-side copy of a bool/uint8 mask, run-length encoded
+     *
+     * Deletion and selection masks are mostly long runs, so a 5M-entry mask
+     * typically shrinks to a few KB. Masks whose runs do not pay off are kept
+     * as raw bytes. A delta snapshot stores `mask ^ base`, which is all zeros
+     * except where an edit touched the mask.
+     */
+    class MaskSnapshot {
+    public:
+        MaskSnapshot() = default;
+
+        static MaskSnapshot encode(const lfs::core::Tensor& mask);
+        // Falls back to a full encode when base is invalid or differs in shape
+        static MaskSnapshot encode_delta(const lfs::core::Tensor& mask, const lfs::core::Tensor& base);
+
+        // Restore on the device the mask was captured from; invalid if nothing was captured
+        [[nodiscard]] lfs::core::Tensor decode() const;
+        // `base` must be the tensor passed to encode_delta (ignored for full snapshots)
+        [[nodiscard]] lfs::core::Tensor decode_delta(const lfs::core::Tensor& base) const;
+
+        [[nodiscard]] bool valid() const { return valid_; }
+        [[nodiscard]] bool is_delta() const { return is_delta_; }
+        [[nodiscard]] MemoryUsage memory_usage() const;
+
+    private:
+        void encode_bytes(const uint8_t* data, size_t n);
+        void decode_bytes(uint8_t* out) const;
+
+        bool valid_ = false;
+        bool is_delta_ = false;
+        lfs::core::TensorShape shape_;
+        lfs::core::DataType dtype_ = lfs::core::DataType::Bool;
+        lfs::core::Device device_ = lfs::core::Device::CPU;
+        size_t numel_ = 0;
+        std::vector<uint32_t> run_lengths_; // Run-length form
+        std::vector<uint8_t> run_values_;
+        std::vector<uint8_t> raw_;          // Used instead when runs would be larger
+    };
+
+    /**
+     * @brief Rows along dim 0 that an edit changed, with their values before and after
+     *
+     * Brush and mirror edits touch a fraction of the gaussians, so keeping only
+     * the touched rows of means/rotation/SH is much smaller than a full copy.
+     * Rows stay on the source device until spill_to_host().
+     */
+    class RowDelta {
+    public:
+        RowDelta() = default;
+
+        // Rows where before and after differ; both must have the same shape
+        static RowDelta capture(const lfs::core::Tensor& before, const lfs::core::Tensor& after);
+        // Given rows of `before` only (redo recomputes the edit); indices are row numbers
+        static RowDelta capture_rows(const lfs::core::Tensor& before, const lfs::core::Tensor& indices);
+
+        // Write the stored rows into `target`; false if the shapes no longer match
+        bool restore_before(lfs::core::Tensor& target) const;
+        bool restore_after(lfs::core::Tensor& target) const;
+
+        void spill_to_host();
+
+        [[nodiscard]] bool valid() const { return indices_.is_valid(); }
+        [[nodiscard]] size_t num_rows() const { return indices_.is_valid() ? indices_.numel() : 0; }
+        [[nodiscard]] bool has_after() const { return after_.is_valid(); }
+        [[nodiscard]] MemoryUsage memory_usage() const;
+
+    private:
+        bool restore(const lfs::core::Tensor& rows, lfs::core::Tensor& target) const;
+
+        lfs::core::TensorShape shape_; // Full shape of the captured tensor
+        lfs::core::Tensor indices_;    // Int32 [K]
+        lfs::core::Tensor before_;     // [K, ...]
+        lfs::core::Tensor after_;      // [K, ...], invalid for capture_rows
+    };
+
+} // namespace lfs::vis::command
@@ -93,7 +93,7 @@ namespace lfs::vis::gui {
 
         // Create components
         file_browser_ = std::make_unique<FileBrowser>();
-        scene_panel_ = std::make_unique<ScenePanel>(viewer->trainer_manager_);
+        scene_panel_ = std::make_unique<ScenePanel>(viewer->trainer_manager_, viewer->options_.persist_thumbnails);
         menu_bar_ = std::make_unique<MenuBar>();
         export_dialog_ = std::make_unique<ExportDialog>();
         notification_popup_ = std::make_unique<NotificationPopup>();
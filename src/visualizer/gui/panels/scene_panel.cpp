@@ -71,9 +71,9 @@ namespace lfs::vis::gui {
         }
     } // namespace
 
-    ScenePanel::ScenePanel(std::shared_ptr<const TrainerManager> trainer_manager)
+    ScenePanel::ScenePanel(std::shared_ptr<const TrainerManager> trainer_manager, const bool persist_thumbnails)
         : m_trainerManager(std::move(trainer_manager)) {
-        m_imagePreview = std::make_unique<ImagePreview>();
+        m_imagePreview = std::make_unique<ImagePreview>(persist_thumbnails);
         setupEventHandlers();
     }
 
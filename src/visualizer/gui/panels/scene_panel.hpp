@@ -27,7 +27,7 @@ namespace lfs::vis {
         // Queries Scene and SceneManager directly - no duplicate state
         class ScenePanel {
         public:
-            explicit ScenePanel(std::shared_ptr<const TrainerManager> trainer_manager);
+            ScenePanel(std::shared_ptr<const TrainerManager> trainer_manager, bool persist_thumbnails);
             ~ScenePanel();
 
             void render(bool* p_open, const UIContext* ctx);
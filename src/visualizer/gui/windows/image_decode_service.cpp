@@ -0,0 +1,428 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "gui/windows/image_decode_service.hpp"
+#include "core/logger.hpp"
+#include "core/path_utils.hpp"
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+namespace lfs::vis::gui {
+
+    namespace {
+
+        constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+        constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+        uint64_t fnv1a(const void* data, const size_t size, uint64_t hash = FNV_OFFSET) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * FNV_PRIME;
+            }
+            return hash;
+        }
+
+        std::tuple<unsigned char*, int, int, int> default_decode(const std::filesystem::path& path, const int max_side) {
+            return lfs::core::load_image(path, -1, max_side);
+        }
+
+        std::pair<int, int> default_probe(const std::filesystem::path& path) {
+            const auto [width, height, channels] = lfs::core::get_image_info(path);
+            return {width, height};
+        }
+
+        ImageData checked_decode(const ImageDecodeService::DecodeFn& decode, const std::filesystem::path& path,
+                                 const int max_side) {
+            auto [data, width, height, channels] = decode(path, max_side);
+            ImageData image(data, width, height, channels);
+            if (!image.valid()) {
+                throw std::runtime_error("Failed to load image data");
+            }
+            if (width <= 0 || height <= 0) {
+                throw std::runtime_error(std::format("Invalid image dimensions: {}x{}", width, height));
+            }
+            if (channels < 1 || channels > 4) {
+                throw std::runtime_error(std::format("Invalid number of channels: {}", channels));
+            }
+            return image;
+        }
+
+    } // namespace
+
+    ImageDecodeService::ImageDecodeService()
+        : ImageDecodeService(Options{}) {}
+
+    ImageDecodeService::ImageDecodeService(Options options)
+        : options_(std::move(options)),
+          cache_(options_.max_bytes) {
+        if (!options_.decode) {
+            options_.decode = default_decode;
+        }
+        if (!options_.probe) {
+            options_.probe = default_probe;
+        }
+
+        if (!options_.thumbnail_dir.empty()) {
+            std::error_code ec;
+            std::filesystem::create_directories(options_.thumbnail_dir, ec);
+            if (ec) {
+                LOG_WARN("Thumbnail cache disabled, cannot create {}: {}",
+                         lfs::core::path_to_utf8(options_.thumbnail_dir), ec.message());
+                options_.thumbnail_dir.clear();
+            } else {
+                trim_thumbnails(options_.max_thumbnail_bytes);
+            }
+        }
+
+        const size_t num_workers = std::max<size_t>(1, options_.num_workers);
+        workers_.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i) {
+            workers_.emplace_back(&ImageDecodeService::worker_loop, this);
+        }
+    }
+
+    ImageDecodeService::~ImageDecodeService() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+            queue_.clear();
+        }
+        work_cv_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    int ImageDecodeService::level_for(const int needed_side, const int max_side) {
+        int level = 0;
+        while (level + 1 < MAX_LEVELS && level_side(level) < needed_side && level_side(level + 1) <= max_side) {
+            ++level;
+        }
+        return level;
+    }
+
+    std::string ImageDecodeService::key_for(const std::filesystem::path& path, const int level) {
+        return std::format("{}#{}", lfs::core::path_to_utf8(path), level);
+    }
+
+    void ImageDecodeService::schedule(std::vector<Request> requests) {
+        std::deque<Job> next;
+        std::unordered_set<std::string> wanted;
+        for (auto& request : requests) {
+            const int level = std::clamp(request.level, 0, MAX_LEVELS - 1);
+            std::string key = key_for(request.path, level);
+            if (!wanted.insert(key).second) {
+                continue;
+            }
+            next.push_back(Job{std::move(key), std::move(request.path), level, request.priority});
+        }
+        std::stable_sort(next.begin(), next.end(),
+                         [](const Job& a, const Job& b) { return a.priority < b.priority; });
+
+        {
+            std::lock_guard lock(mutex_);
+            for (const auto& job : queue_) {
+                if (!wanted.contains(job.key)) {
+                    ++counters_.cancelled;
+                }
+            }
+            // Workers cache a result before leaving running_, so under the lock a key is
+            // in at least one of the two once its decode has started
+            std::erase_if(next, [&](const Job& job) {
+                return running_.contains(job.key) || cache_.contains(job.key);
+            });
+            queue_ = std::move(next);
+            if (queue_.empty() && running_.empty()) {
+                idle_cv_.notify_all();
+            }
+        }
+        work_cv_.notify_all();
+    }
+
+    ImageDecodeService::Handle ImageDecodeService::find(const std::filesystem::path& path, const int level) {
+        auto handle = cache_.get(key_for(path, level));
+        return handle ? std::move(*handle) : nullptr;
+    }
+
+    std::pair<ImageDecodeService::Handle, int> ImageDecodeService::find_best(const std::filesystem::path& path,
+                                                                             int level) {
+        level = std::clamp(level, 0, MAX_LEVELS - 1);
+        for (int l = level; l >= 0; --l) {
+            if (auto handle = find(path, l)) {
+                return {std::move(handle), l};
+            }
+        }
+        for (int l = level + 1; l < MAX_LEVELS; ++l) {
+            if (auto handle = find(path, l)) {
+                return {std::move(handle), l};
+            }
+        }
+        return {nullptr, -1};
+    }
+
+    std::optional<std::string> ImageDecodeService::error(const std::filesystem::path& path) const {
+        std::lock_guard lock(mutex_);
+        if (const auto it = errors_.find(lfs::core::path_to_utf8(path)); it != errors_.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    bool ImageDecodeService::pending(const std::filesystem::path& path) const {
+        const std::string prefix = lfs::core::path_to_utf8(path) + "#";
+        std::lock_guard lock(mutex_);
+        return std::ranges::any_of(queue_, [&](const Job& job) { return job.key.starts_with(prefix); }) ||
+               std::ranges::any_of(running_, [&](const std::string& key) { return key.starts_with(prefix); });
+    }
+
+    void ImageDecodeService::wait_idle() {
+        std::unique_lock lock(mutex_);
+        idle_cv_.wait(lock, [this] { return queue_.empty() && running_.empty(); });
+    }
+
+    void ImageDecodeService::clear() {
+        {
+            std::lock_guard lock(mutex_);
+            counters_.cancelled += queue_.size();
+            queue_.clear();
+            source_sizes_.clear();
+            errors_.clear();
+        }
+        cache_.clear();
+    }
+
+    ImageDecodeService::Stats ImageDecodeService::stats() const {
+        std::lock_guard lock(mutex_);
+        Stats stats = counters_;
+        stats.cache = cache_.stats();
+        return stats;
+    }
+
+    void ImageDecodeService::worker_loop() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock lock(mutex_);
+                work_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (stop_) {
+                    return;
+                }
+                job = std::move(queue_.front());
+                queue_.pop_front();
+                running_.insert(job.key);
+            }
+
+            Handle image;
+            std::string failure;
+            try {
+                LOG_TIMER("ImageDecodeService decode");
+                image = decode(job);
+            } catch (const std::exception& e) {
+                failure = e.what();
+                LOG_WARN("Failed to decode '{}' at level {}: {}", lfs::core::path_to_utf8(job.path), job.level, e.what());
+            }
+
+            if (image) {
+                cache_.put(job.key, image, image->data.bytes());
+            }
+
+            std::lock_guard lock(mutex_);
+            running_.erase(job.key);
+            if (image) {
+                ++counters_.decoded;
+                errors_.erase(lfs::core::path_to_utf8(job.path));
+            } else {
+                ++counters_.failed;
+                errors_[lfs::core::path_to_utf8(job.path)] = std::move(failure);
+            }
+            if (queue_.empty() && running_.empty()) {
+                idle_cv_.notify_all();
+            }
+        }
+    }
+
+    ImageDecodeService::Handle ImageDecodeService::decode(const Job& job) {
+        const auto size = source_size(job.path);
+        if (!size) {
+            throw std::runtime_error("Cannot read image header");
+        }
+        const int side = level_side(job.level);
+
+        // Persist level 0 only where it is actually smaller than the source
+        const bool use_thumbnail = job.level == 0 && !options_.thumbnail_dir.empty() &&
+                                   std::max(size->first, size->second) > side;
+        const auto thumbnail = use_thumbnail ? thumbnail_path(job.path) : std::filesystem::path{};
+
+        auto image = std::make_shared<DecodedImage>();
+        image->source_width = size->first;
+        image->source_height = size->second;
+
+        if (!thumbnail.empty()) {
+            std::error_code ec;
+            if (std::filesystem::exists(thumbnail, ec)) {
+                try {
+                    image->data = checked_decode(options_.decode, thumbnail, side);
+                    // The mtime orders thumbnails for trim_thumbnails()
+                    std::filesystem::last_write_time(thumbnail, std::filesystem::file_time_type::clock::now(), ec);
+                    std::lock_guard lock(mutex_);
+                    ++counters_.thumbnail_hits;
+                    return image;
+                } catch (const std::exception& e) {
+                    LOG_DEBUG("Discarding unreadable thumbnail {}: {}", lfs::core::path_to_utf8(thumbnail), e.what());
+                    std::filesystem::remove(thumbnail, ec);
+                }
+            }
+        }
+
+        image->data = checked_decode(options_.decode, job.path, side);
+
+        if (!thumbnail.empty()) {
+            store_thumbnail(thumbnail, image->data);
+        }
+        return image;
+    }
+
+    void ImageDecodeService::store_thumbnail(const std::filesystem::path& thumbnail, const ImageData& data) {
+        // Write then rename, so a reader never sees a partial file
+        auto partial = thumbnail;
+        partial.replace_extension(".part.jpg");
+        std::error_code ec;
+        std::filesystem::create_directories(thumbnail.parent_path(), ec);
+        if (ec || !lfs::core::save_img_data(partial, {data.data(), data.width(), data.height(), data.channels()})) {
+            std::filesystem::remove(partial, ec);
+            return;
+        }
+        std::filesystem::rename(partial, thumbnail, ec);
+        if (ec) {
+            std::filesystem::remove(partial, ec);
+            return;
+        }
+        const size_t written = std::filesystem::file_size(thumbnail, ec);
+
+        // The folder holds this file's earlier versions, which can no longer be read
+        size_t evicted = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(thumbnail.parent_path(), ec)) {
+            std::error_code remove_ec;
+            if (entry.path().filename() != thumbnail.filename() && std::filesystem::remove(entry.path(), remove_ec)) {
+                ++evicted;
+            }
+        }
+
+        bool over_budget = false;
+        {
+            std::lock_guard lock(mutex_);
+            ++counters_.thumbnail_writes;
+            counters_.thumbnail_evictions += evicted;
+            thumbnail_bytes_ += written;
+            over_budget = thumbnail_bytes_ > options_.max_thumbnail_bytes;
+        }
+        if (over_budget) {
+            // Trim below the budget so the folder is not rescanned on every write
+            trim_thumbnails(options_.max_thumbnail_bytes / 4 * 3);
+        }
+    }
+
+    void ImageDecodeService::trim_thumbnails(const size_t target_bytes) {
+        struct Thumbnail {
+            std::filesystem::path path;
+            std::filesystem::file_time_type used;
+            size_t bytes;
+        };
+        std::vector<Thumbnail> thumbnails;
+        size_t total = 0;
+        size_t evicted = 0;
+
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(options_.thumbnail_dir, ec)) {
+            std::error_code entry_ec;
+            if (!entry.is_regular_file(entry_ec)) {
+                continue;
+            }
+            // Interrupted writes
+            if (lfs::core::path_to_utf8(entry.path().filename()).ends_with(".part.jpg")) {
+                std::filesystem::remove(entry.path(), entry_ec);
+                continue;
+            }
+            const size_t bytes = entry.file_size(entry_ec);
+            const auto used = entry.last_write_time(entry_ec);
+            if (entry_ec) {
+                continue;
+            }
+            thumbnails.push_back({entry.path(), used, bytes});
+            total += bytes;
+        }
+
+        std::ranges::sort(thumbnails, {}, &Thumbnail::used);
+        for (const auto& thumbnail : thumbnails) {
+            if (total <= target_bytes) {
+                break;
+            }
+            std::error_code remove_ec;
+            if (std::filesystem::remove(thumbnail.path, remove_ec)) {
+                total -= thumbnail.bytes;
+                ++evicted;
+                std::filesystem::remove(thumbnail.path.parent_path(), remove_ec); // Only succeeds once empty
+            }
+        }
+        if (evicted > 0) {
+            LOG_DEBUG("Evicted {} preview thumbnails from {}", evicted, lfs::core::path_to_utf8(options_.thumbnail_dir));
+        }
+
+        std::lock_guard lock(mutex_);
+        thumbnail_bytes_ = total;
+        counters_.thumbnail_evictions += evicted;
+    }
+
+    std::optional<std::pair<int, int>> ImageDecodeService::source_size(const std::filesystem::path& path) {
+        const std::string key = lfs::core::path_to_utf8(path);
+        {
+            std::lock_guard lock(mutex_);
+            if (const auto it = source_sizes_.find(key); it != source_sizes_.end()) {
+                return it->second;
+            }
+        }
+
+        std::pair<int, int> size;
+        try {
+            size = options_.probe(path);
+        } catch (const std::exception& e) {
+            LOG_DEBUG("Probe failed for {}: {}", key, e.what());
+            return std::nullopt;
+        }
+        if (size.first <= 0 || size.second <= 0) {
+            return std::nullopt;
+        }
+
+        std::lock_guard lock(mutex_);
+        source_sizes_[key] = size;
+        return size;
+    }
+
+    std::filesystem::path ImageDecodeService::thumbnail_path(const std::filesystem::path& path) const {
+        std::error_code ec;
+        const auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            return {};
+        }
+        const uint64_t file_size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return {};
+        }
+
+        // Any edit to the source changes the name, so stale thumbnails are never read
+        std::error_code abs_ec;
+        const auto absolute = std::filesystem::absolute(path, abs_ec);
+        const std::string name = lfs::core::path_to_utf8((abs_ec ? path : absolute).lexically_normal());
+        const int64_t ticks = mtime.time_since_epoch().count();
+        const uint64_t path_hash = fnv1a(name.data(), name.size());
+        uint64_t version_hash = fnv1a(&ticks, sizeof(ticks), path_hash);
+        version_hash = fnv1a(&file_size, sizeof(file_size), version_hash);
+        return options_.thumbnail_dir / std::format("{:016x}", path_hash) /
+               std::format("{:016x}_{}.jpg", version_hash, THUMBNAIL_SIZE);
+    }
+
+} // namespace lfs::vis::gui
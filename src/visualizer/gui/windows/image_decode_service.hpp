@@ -0,0 +1,226 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#pragma once
+
+#include "core/image_io.hpp"
+#include "io/lru_cache.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace lfs::vis::gui {
+
+    /**
+     * @brief RAII wrapper for raw image data
+     */
+    class ImageData {
+    public:
+        ImageData() = default;
+        ImageData(unsigned char* data, int width, int height, int channels)
+            : data_(data),
+              width_(width),
+              height_(height),
+              channels_(channels) {}
+
+        ~ImageData() {
+            if (data_) {
+                lfs::core::free_image(data_);
+            }
+        }
+
+        // Delete copy operations
+        ImageData(const ImageData&) = delete;
+        ImageData& operator=(const ImageData&) = delete;
+
+        // Move operations
+        ImageData(ImageData&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)),
+              width_(std::exchange(other.width_, 0)),
+              height_(std::exchange(other.height_, 0)),
+              channels_(std::exchange(other.channels_, 0)) {}
+
+        ImageData& operator=(ImageData&& other) noexcept {
+            if (this != &other) {
+                if (data_) {
+                    lfs::core::free_image(data_);
+                }
+                data_ = std::exchange(other.data_, nullptr);
+                width_ = std::exchange(other.width_, 0);
+                height_ = std::exchange(other.height_, 0);
+                channels_ = std::exchange(other.channels_, 0);
+            }
+            return *this;
+        }
+
+        // Accessors
+        unsigned char* data() const { return data_; }
+        int width() const { return width_; }
+        int height() const { return height_; }
+        int channels() const { return channels_; }
+        bool valid() const { return data_ != nullptr; }
+        size_t bytes() const { return static_cast<size_t>(width_) * height_ * channels_; }
+
+        // Release ownership
+        unsigned char* release() {
+            return std::exchange(data_, nullptr);
+        }
+
+    private:
+        unsigned char* data_ = nullptr;
+        int width_ = 0;
+        int height_ = 0;
+        int channels_ = 0;
+    };
+
+    /**
+     * @brief One pyramid level of an image, plus the size of the file it came from
+     */
+    struct DecodedImage {
+        ImageData data;
+        int source_width = 0;
+        int source_height = 0;
+    };
+
+    /**
+     * @brief Decodes preview images at the resolution they are shown at
+     *
+     * Level k of an image is the file decoded with its long side limited to
+     * THUMBNAIL_SIZE << k, so a viewport-sized request reads a fraction of a
+     * large photo (JPEGs are scaled inside the decoder). Decoded levels live in
+     * a byte-budgeted LRU cache. Level 0 can also be persisted as a small JPEG
+     * keyed by path, mtime and size, so reopening a dataset starts from disk
+     * thumbnails instead of full decodes. Persisting is off unless thumbnail_dir
+     * is set. Each source file gets its own folder, so writing a thumbnail
+     * replaces those of older versions of the file; the whole directory is
+     * trimmed least recently used first to max_thumbnail_bytes.
+     *
+     * Work runs on a fixed pool of workers. schedule() replaces the whole queue:
+     * requests are served in priority order and anything the caller no longer
+     * asks for is dropped before it starts. A decode that is already running
+     * finishes and lands in the cache.
+     */
+    class ImageDecodeService {
+    public:
+        // Long side of level 0, which is also the persisted thumbnail
+        static constexpr int THUMBNAIL_SIZE = 256;
+        static constexpr int MAX_LEVELS = 8;
+
+        // decode(path, max_side) with the contract of lfs::core::load_image
+        using DecodeFn = std::function<std::tuple<unsigned char*, int, int, int>(const std::filesystem::path&, int)>;
+        // probe(path) -> (width, height) read from the file header
+        using ProbeFn = std::function<std::pair<int, int>(const std::filesystem::path&)>;
+        using Handle = std::shared_ptr<const DecodedImage>;
+
+        struct Options {
+            size_t max_bytes = size_t{512} << 20;
+            size_t num_workers = 2;
+            std::filesystem::path thumbnail_dir; // Empty disables persistent thumbnails
+            size_t max_thumbnail_bytes = size_t{256} << 20;
+            DecodeFn decode;                     // Defaults to lfs::core::load_image
+            ProbeFn probe;                       // Defaults to lfs::core::get_image_info
+        };
+
+        struct Request {
+            std::filesystem::path path;
+            int level = 0;
+            int priority = 0; // Lower runs first
+        };
+
+        struct Stats {
+            io::LruCacheStats cache;
+            size_t decoded = 0;
+            size_t cancelled = 0;
+            size_t failed = 0;
+            size_t thumbnail_hits = 0;
+            size_t thumbnail_writes = 0;
+            size_t thumbnail_evictions = 0;
+        };
+
+        ImageDecodeService();
+        explicit ImageDecodeService(Options options);
+        ~ImageDecodeService();
+
+        ImageDecodeService(const ImageDecodeService&) = delete;
+        ImageDecodeService& operator=(const ImageDecodeService&) = delete;
+
+        static constexpr int level_side(const int level) { return THUMBNAIL_SIZE << level; }
+
+        // Smallest level covering needed_side pixels whose side stays within max_side
+        static int level_for(int needed_side, int max_side);
+
+        // Replace all pending requests; cached and running ones are skipped
+        void schedule(std::vector<Request> requests);
+        void cancel_pending() { schedule({}); }
+
+        // Exact level, or nullptr if not cached
+        Handle find(const std::filesystem::path& path, int level);
+
+        /**
+         * @brief Best cached level for display at `level`
+         * @return The largest cached level <= level, else the smallest above it;
+         *         {nullptr, -1} if nothing is cached
+         */
+        std::pair<Handle, int> find_best(const std::filesystem::path& path, int level);
+
+        // Last decode error for path, cleared when a later decode succeeds
+        std::optional<std::string> error(const std::filesystem::path& path) const;
+
+        // True while path has any level queued or decoding
+        bool pending(const std::filesystem::path& path) const;
+
+        // Block until the queue is empty and no worker is decoding
+        void wait_idle();
+
+        void clear();
+        Stats stats() const;
+
+    private:
+        struct Job {
+            std::string key;
+            std::filesystem::path path;
+            int level;
+            int priority;
+        };
+
+        static std::string key_for(const std::filesystem::path& path, int level);
+
+        void worker_loop();
+        Handle decode(const Job& job);
+        std::optional<std::pair<int, int>> source_size(const std::filesystem::path& path);
+        std::filesystem::path thumbnail_path(const std::filesystem::path& path) const;
+        void store_thumbnail(const std::filesystem::path& thumbnail, const ImageData& data);
+        // Delete leftovers and the least recently used thumbnails until the folder fits in target_bytes
+        void trim_thumbnails(size_t target_bytes);
+
+        Options options_;
+        io::ShardedLruCache<Handle> cache_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable work_cv_;
+        std::condition_variable idle_cv_;
+        std::deque<Job> queue_; // Sorted by priority, FIFO within a priority
+        std::unordered_set<std::string> running_;
+        std::unordered_map<std::string, std::pair<int, int>> source_sizes_;
+        std::unordered_map<std::string, std::string> errors_;
+        Stats counters_;
+        size_t thumbnail_bytes_ = 0; // Approximate size of thumbnail_dir, refreshed by trim_thumbnails()
+        bool stop_ = false;
+
+        std::vector<std::thread> workers_;
+    };
+
+} // namespace lfs::vis::gui
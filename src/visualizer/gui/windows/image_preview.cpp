@@ -11,13 +11,13 @@
 #include "gui/localization_manager.hpp"
 #include "gui/string_keys.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <format>
 #include <fstream>
-#include <future>
 #include <glad/glad.h>
 #include <stdexcept>
-#include <thread>
 #include <imgui.h>
 
 namespace lfs::vis::gui {
@@ -226,7 +226,14 @@ namespace lfs::vis::gui {
         return result;
     }
 
-    ImagePreview::ImagePreview() = default;
+    ImagePreview::ImagePreview(const bool persist_thumbnails) {
+        ImageDecodeService::Options options;
+        if (persist_thumbnails) {
+            // Beside the image loader's cache folders
+            options.thumbnail_dir = lfs::core::lichtfeld_temp_folder() / "thumbnails";
+        }
+        decoder_ = std::make_unique<ImageDecodeService>(std::move(options));
+    }
 
     ImagePreview::~ImagePreview() {
         close();
@@ -267,14 +274,17 @@ namespace lfs::vis::gui {
         LOG_DEBUG("Opening image preview with {} images, starting at index {}",
                   image_paths.size(), current_index_);
 
-        // Load current image
-        if (!loadImage(image_paths_[current_index_])) {
-            LOG_ERROR("Failed to load initial image: {}", load_error_);
-            throw std::runtime_error(std::format("Failed to load image: {}", load_error_));
+        // The window opens at half the viewport; the first frame refines the level
+        ensureMaxTextureSizeInitialized();
+        float initial_side = 1024.0f;
+        if (ImGui::GetCurrentContext()) {
+            const auto* vp = ImGui::GetMainViewport();
+            initial_side = std::max(vp->Size.x, vp->Size.y) * 0.5f * ImGui::GetIO().DisplayFramebufferScale.x;
         }
+        display_level_ = ImageDecodeService::level_for(static_cast<int>(initial_side), max_texture_size_);
 
-        // Start preloading adjacent images
-        preloadAdjacentImages();
+        // Decoding runs in the background; failures are shown in the window
+        showCurrentImage();
 
         LOG_INFO("Opened image {}/{}: {}",
                  current_index_ + 1,
@@ -291,25 +301,18 @@ namespace lfs::vis::gui {
                                        const size_t initial_index) {
         open(image_paths, initial_index);
         overlay_paths_ = overlay_paths;
-        loadCurrentOverlay();
+        requestDecodes();
     }
 
-    void ImagePreview::loadCurrentOverlay() {
-        overlay_texture_.reset();
+    const std::filesystem::path* ImagePreview::currentOverlayPath() const {
         if (current_index_ < overlay_paths_.size() && !overlay_paths_[current_index_].empty()) {
-            try {
-                auto data = loadImageData(overlay_paths_[current_index_]);
-                overlay_texture_ = createTexture(std::move(*data), overlay_paths_[current_index_]);
-            } catch (const std::exception& e) {
-                LOG_WARN("Failed to load overlay: {}", e.what());
-            }
+            return &overlay_paths_[current_index_];
         }
+        return nullptr;
     }
 
     bool ImagePreview::hasValidOverlay() const {
-        return current_index_ < overlay_paths_.size() &&
-               !overlay_paths_[current_index_].empty() &&
-               overlay_texture_ && overlay_texture_->texture.valid();
+        return currentOverlayPath() && overlay_texture_ && overlay_texture_->texture.valid();
     }
 
     void ImagePreview::close() {
@@ -317,103 +320,28 @@ namespace lfs::vis::gui {
         image_paths_.clear();
         overlay_paths_.clear();
         current_texture_.reset();
-        previous_texture_.reset();
         overlay_texture_.reset();
-        prev_texture_.reset();
-        next_texture_.reset();
-
-        {
-            std::lock_guard lock(preload_mutex_);
-            prev_result_.reset();
-            next_result_.reset();
-        }
+        decoder_->cancel_pending();
 
         load_error_.clear();
         show_overlay_ = false;
     }
 
-    std::unique_ptr<ImageData> ImagePreview::loadImageData(const std::filesystem::path& path) {
-        LOG_TIMER("LoadImageData");
-
-        LOG_TRACE("Loading image data from: {}", lfs::core::path_to_utf8(path));
-
-        // Load image (max_width = -1 disables downscaling for preview)
-        auto [data, width, height, channels] = [&]() {
-            LOG_TIMER("load_image call");
-            return lfs::core::load_image(path, -1, -1);
-        }();
-
-        // Wrap in RAII immediately
-        auto image_data = [&]() {
-            LOG_TIMER("ImageData construction");
-            return std::make_unique<ImageData>(data, width, height, channels);
-        }();
-
-        // Validate
-        {
-            LOG_TIMER("Image validation");
-            if (!image_data->valid()) {
-                LOG_ERROR("Failed to load image data from: {}", lfs::core::path_to_utf8(path));
-                throw std::runtime_error("Failed to load image data");
-            }
-
-            if (width <= 0 || height <= 0) {
-                LOG_ERROR("Invalid image dimensions: {}x{} for: {}", width, height, lfs::core::path_to_utf8(path));
-                throw std::runtime_error(std::format("Invalid image dimensions: {}x{}", width, height));
-            }
-
-            if (channels < 1 || channels > 4) {
-                LOG_ERROR("Invalid number of channels: {} for: {}", channels, lfs::core::path_to_utf8(path));
-                throw std::runtime_error(std::format("Invalid number of channels: {}", channels));
-            }
-        }
-
-        LOG_TRACE("Loaded image: {}x{}, {} channels", width, height, channels);
-        return image_data;
-    }
-
     std::unique_ptr<ImagePreview::ImageTexture> ImagePreview::createTexture(
-        ImageData&& data, const std::filesystem::path& path) {
+        const DecodedImage& image, const std::filesystem::path& path, const int level) {
         LOG_TIMER("CreateTexture");
 
-        {
-            LOG_TIMER("ensureMaxTextureSizeInitialized");
-            ensureMaxTextureSizeInitialized();
-        }
-
-        int width = data.width();
-        int height = data.height();
-        int channels = data.channels();
-
-        // Check if we need to downscale
-        if (width > max_texture_size_ || height > max_texture_size_) {
-            // Calculate scale factor
-            int scale_factor = 1;
-            while (width / scale_factor > max_texture_size_ ||
-                   height / scale_factor > max_texture_size_) {
-                scale_factor *= 2;
-            }
-
-            LOG_DEBUG("Image too large ({}x{}), downscaling by factor of {}",
-                      width, height, scale_factor);
-
-            // Reload at lower resolution
-            auto scaled_data = loadImageData(path);
-            if (!scaled_data) {
-                LOG_ERROR("Failed to reload image at lower resolution");
-                throw std::runtime_error("Failed to reload image at lower resolution");
-            }
-
-            // Move the scaled data
-            data = std::move(*scaled_data);
-            width = data.width();
-            height = data.height();
-            channels = data.channels();
-        }
+        const ImageData& data = image.data;
+        const int width = data.width();
+        const int height = data.height();
+        const int channels = data.channels();
 
         auto texture = std::make_unique<ImageTexture>();
         texture->width = width;
         texture->height = height;
+        texture->source_width = image.source_width;
+        texture->source_height = image.source_height;
+        texture->level = level;
         texture->path = path;
 
         {
@@ -498,220 +426,127 @@ namespace lfs::vis::gui {
         return texture;
     }
 
-    bool ImagePreview::loadImage(const std::filesystem::path& path) {
-        try {
-            is_loading_ = true;
-            load_error_.clear();
-
-            LOG_DEBUG("Loading image: {}", lfs::core::path_to_utf8(path));
-
-            // Load image data with RAII
-            auto image_data = loadImageData(path);
+    void ImagePreview::requestDecodes() {
+        if (image_paths_.empty()) {
+            decoder_->cancel_pending();
+            return;
+        }
 
-            // Create new texture first, then swap (keeps old texture visible during load)
-            auto new_texture = createTexture(std::move(*image_data), path);
-            current_texture_ = std::move(new_texture);
+        std::vector<ImageDecodeService::Request> requests;
+        const auto request = [&](const size_t index, const int level, const int priority) {
+            requests.push_back({image_paths_[index], level, priority});
+            if (index < overlay_paths_.size() && !overlay_paths_[index].empty()) {
+                requests.push_back({overlay_paths_[index], level, priority});
+            }
+        };
 
-            is_loading_ = false;
-            return true;
+        // Current image: a thumbnail first so something shows at once, then the display level
+        const auto& path = image_paths_[current_index_];
+        const bool sharp = current_texture_ && current_texture_->path == path &&
+                           current_texture_->level >= display_level_;
+        if (!sharp) {
+            if (display_level_ > 0 && !decoder_->find(path, display_level_)) {
+                requests.push_back({path, 0, 0});
+            }
+            request(current_index_, display_level_, 1);
+        }
 
-        } catch (const std::exception& e) {
-            load_error_ = e.what();
-            is_loading_ = false;
-            LOG_ERROR("Error loading image '{}': {}", lfs::core::path_to_utf8(path), e.what());
-            return false;
+        // Neighbours, nearest first and forward before backward at equal distance
+        for (size_t d = 1; d <= THUMBNAIL_RADIUS; ++d) {
+            const int level = d <= PREFETCH_RADIUS ? display_level_ : 0;
+            const int priority = 1 + static_cast<int>(d);
+            if (current_index_ + d < image_paths_.size()) {
+                request(current_index_ + d, level, priority);
+            }
+            if (current_index_ >= d) {
+                request(current_index_ - d, level, priority);
+            }
         }
+
+        decoder_->schedule(std::move(requests));
     }
 
-    void ImagePreview::preloadAdjacentImages() {
-        LOG_TIMER("PreloadAdjacentImages");
+    void ImagePreview::updateTexture(std::unique_ptr<ImageTexture>& texture, const std::filesystem::path& path) {
+        const bool same_image = texture && texture->path == path;
+        if (same_image && texture->level >= display_level_) {
+            return; // Already sharp enough
+        }
 
-        // Don't start new preload if one is already in progress
-        bool expected = false;
-        if (!preload_in_progress_.compare_exchange_strong(expected, true)) {
-            LOG_TRACE("Preload already in progress, skipping");
+        auto [image, level] = decoder_->find_best(path, display_level_);
+        if (!image || (same_image && level <= texture->level)) {
             return;
         }
 
-        // Clear existing preloaded data
-        {
-            std::lock_guard<std::mutex> lock(preload_mutex_);
-            prev_result_.reset();
-            next_result_.reset();
+        try {
+            texture = createTexture(*image, path, level);
+        } catch (const std::exception& e) {
+            LOG_WARN("Failed to create texture for '{}': {}", lfs::core::path_to_utf8(path), e.what());
         }
-        prev_texture_.reset();
-        next_texture_.reset();
-
-        // Ensure we have max texture size for the background threads
-        ensureMaxTextureSizeInitialized();
-
-        // Capture needed values
-        GLint max_size = max_texture_size_;
-
-        // Preload previous image
-        if (current_index_ > 0) {
-            LOG_TRACE("Starting preload of previous image (index {})", current_index_ - 1);
-            std::thread([this, prev_idx = current_index_ - 1, max_size]() {
-                try {
-                    LOG_TIMER("Preload prev image data");
-                    auto image_data = loadImageData(image_paths_[prev_idx]);
-
-                    // Check if downscaling is needed
-                    if (image_data->width() > max_size || image_data->height() > max_size) {
-                        int scale = 2;
-                        while (image_data->width() / scale > max_size ||
-                               image_data->height() / scale > max_size) {
-                            scale *= 2;
-                        }
+    }
 
-                        LOG_TRACE("Preloaded image needs downscaling by factor of {}", scale);
-                        // Reload at lower resolution (max_width = -1 disables additional downscaling)
-                        auto [data, w, h, c] = lfs::core::load_image(image_paths_[prev_idx], scale, -1);
-                        image_data = std::make_unique<ImageData>(data, w, h, c);
-                    }
+    void ImagePreview::updateTextures() {
+        if (image_paths_.empty()) {
+            return;
+        }
 
-                    auto result = std::make_unique<LoadResult>();
-                    auto preloaded = std::make_unique<PreloadedImage>();
-                    preloaded->data = std::move(*image_data);
-                    preloaded->path = image_paths_[prev_idx];
-                    result->image = std::move(preloaded);
-
-                    std::lock_guard<std::mutex> lock(preload_mutex_);
-                    prev_result_ = std::move(result);
-                    LOG_TRACE("Successfully preloaded previous image data");
-                } catch (const std::exception& e) {
-                    auto result = std::make_unique<LoadResult>();
-                    result->error = e.what();
-
-                    std::lock_guard<std::mutex> lock(preload_mutex_);
-                    prev_result_ = std::move(result);
-                    LOG_WARN("Failed to preload previous image: {}", e.what());
-                }
-            }).detach();
+        const auto& path = image_paths_[current_index_];
+        updateTexture(current_texture_, path);
+        if (const auto* overlay = currentOverlayPath()) {
+            updateTexture(overlay_texture_, *overlay);
         }
 
-        // Preload next image
-        if (current_index_ + 1 < image_paths_.size()) {
-            LOG_TRACE("Starting preload of next image (index {})", current_index_ + 1);
-            std::thread([this, next_idx = current_index_ + 1, max_size]() {
-                try {
-                    LOG_TIMER("Preload next image data");
-                    auto image_data = loadImageData(image_paths_[next_idx]);
-
-                    // Check if downscaling is needed
-                    if (image_data->width() > max_size || image_data->height() > max_size) {
-                        int scale = 2;
-                        while (image_data->width() / scale > max_size ||
-                               image_data->height() / scale > max_size) {
-                            scale *= 2;
-                        }
+        // An error only counts once no retry for this image is still queued
+        if (!current_texture_ && !decoder_->pending(path)) {
+            if (auto error = decoder_->error(path)) {
+                load_error_ = std::move(*error);
+            }
+        }
+    }
 
-                        LOG_TRACE("Preloaded image needs downscaling by factor of {}", scale);
-                        // Reload at lower resolution (max_width = -1 disables additional downscaling)
-                        auto [data, w, h, c] = lfs::core::load_image(image_paths_[next_idx], scale, -1);
-                        image_data = std::make_unique<ImageData>(data, w, h, c);
-                    }
+    void ImagePreview::updateDisplayLevel(const float display_width, const float display_height) {
+        if (!current_texture_) {
+            return;
+        }
 
-                    auto result = std::make_unique<LoadResult>();
-                    auto preloaded = std::make_unique<PreloadedImage>();
-                    preloaded->data = std::move(*image_data);
-                    preloaded->path = image_paths_[next_idx];
-                    result->image = std::move(preloaded);
-
-                    std::lock_guard<std::mutex> lock(preload_mutex_);
-                    next_result_ = std::move(result);
-                    LOG_TRACE("Successfully preloaded next image data");
-                } catch (const std::exception& e) {
-                    auto result = std::make_unique<LoadResult>();
-                    result->error = e.what();
-
-                    std::lock_guard<std::mutex> lock(preload_mutex_);
-                    next_result_ = std::move(result);
-                    LOG_WARN("Failed to preload next image: {}", e.what());
-                }
+        // On-screen pixels, but never more than the file has
+        const ImVec2 fb_scale = ImGui::GetIO().DisplayFramebufferScale;
+        const float needed = std::max(display_width * fb_scale.x, display_height * fb_scale.y);
+        const int source_side = std::max(current_texture_->source_width, current_texture_->source_height);
+        const int level = ImageDecodeService::level_for(
+            std::min(static_cast<int>(std::ceil(needed)), source_side), max_texture_size_);
 
-                preload_in_progress_ = false;
-            }).detach();
-        } else {
-            preload_in_progress_ = false;
+        if (level != display_level_) {
+            LOG_TRACE("Preview display level {} -> {}", display_level_, level);
+            display_level_ = level;
+            requestDecodes();
         }
     }
 
-    void ImagePreview::checkPreloadedImages() {
-        LOG_TIMER("CheckPreloadedImages");
-        std::lock_guard<std::mutex> lock(preload_mutex_);
-
-        // Check previous image
-        if (prev_result_ && !prev_texture_) {
-            if (prev_result_->image) {
-                try {
-                    LOG_TIMER("Create prev texture");
-                    prev_texture_ = createTexture(
-                        std::move(prev_result_->image->data),
-                        prev_result_->image->path);
-                    LOG_TRACE("Created texture for preloaded previous image");
-                } catch (const std::exception& e) {
-                    LOG_WARN("Failed to create prev texture: {}", e.what());
-                }
-            }
-            prev_result_.reset();
-        }
+    void ImagePreview::showCurrentImage() {
+        current_texture_.reset();
+        overlay_texture_.reset();
+        load_error_.clear();
 
-        // Check next image
-        if (next_result_ && !next_texture_) {
-            if (next_result_->image) {
-                try {
-                    LOG_TIMER("Create next texture");
-                    next_texture_ = createTexture(
-                        std::move(next_result_->image->data),
-                        next_result_->image->path);
-                    LOG_TRACE("Created texture for preloaded next image");
-                } catch (const std::exception& e) {
-                    LOG_WARN("Failed to create next texture: {}", e.what());
-                }
-            }
-            next_result_.reset();
-        }
+        requestDecodes();
+        // Prefetched levels show immediately, without waiting a frame
+        updateTextures();
     }
 
     void ImagePreview::nextImage() {
         if (image_paths_.empty() || current_index_ + 1 >= image_paths_.size()) {
             return;
         }
-        if (!next_texture_ && is_loading_) {
-            return; // Skip if no preload and currently loading
-        }
 
         current_index_++;
-        previous_texture_ = std::move(current_texture_); // Keep old texture in GPU memory
-
-        if (next_texture_) {
-            current_texture_ = std::move(next_texture_);
-        } else {
-            loadImage(image_paths_[current_index_]);
-        }
-
-        loadCurrentOverlay();
-        preloadAdjacentImages();
+        showCurrentImage();
     }
 
     void ImagePreview::previousImage() {
         if (image_paths_.empty() || current_index_ == 0)
             return;
-        if (!prev_texture_ && is_loading_)
-            return;
 
         --current_index_;
-        previous_texture_ = std::move(current_texture_);
-
-        if (prev_texture_) {
-            current_texture_ = std::move(prev_texture_);
-        } else {
-            loadImage(image_paths_[current_index_]);
-        }
-
-        loadCurrentOverlay();
-        preloadAdjacentImages();
+        showCurrentImage();
     }
 
     void ImagePreview::goToImage(const size_t index) {
@@ -723,11 +558,7 @@ namespace lfs::vis::gui {
         pan_x_ = 0.0f;
         pan_y_ = 0.0f;
 
-        previous_texture_ = std::move(current_texture_);
-        loadImage(image_paths_[current_index_]);
-        loadCurrentOverlay();
-
-        preloadAdjacentImages();
+        showCurrentImage();
     }
 
     std::pair<float, float> ImagePreview::calculateDisplaySize(int window_width, int window_height) const {
@@ -735,8 +566,9 @@ namespace lfs::vis::gui {
             return {0.0f, 0.0f};
         }
 
-        float img_width = static_cast<float>(current_texture_->width);
-        float img_height = static_cast<float>(current_texture_->height);
+        // Size by the file, not the texture, so 100% zoom is one image pixel per screen pixel
+        float img_width = static_cast<float>(current_texture_->source_width);
+        float img_height = static_cast<float>(current_texture_->source_height);
 
         if (fit_to_window_) {
             float scale_x = window_width / img_width;
@@ -755,8 +587,8 @@ namespace lfs::vis::gui {
             return;
         }
 
-        // Check for preloaded images and convert to textures
-        checkPreloadedImages();
+        // Pick up decodes finished since the last frame
+        updateTextures();
 
         // Initial size: half viewport, centered
         const auto* vp = ImGui::GetMainViewport();
@@ -838,7 +670,8 @@ namespace lfs::vis::gui {
         }
 
         if (!current_texture_ || !current_texture_->texture.valid()) {
-            ImGui::Text(is_loading_ ? "Loading..." : "No image loaded");
+            const bool loading = !image_paths_.empty() && decoder_->pending(image_paths_[current_index_]);
+            ImGui::Text(loading ? "Loading..." : "No image loaded");
             ImGui::End();
             ImGui::PopStyleColor();
             return;
@@ -849,6 +682,7 @@ namespace lfs::vis::gui {
 
         const auto [display_width, display_height] = calculateDisplaySize(
             static_cast<int>(content_size.x), static_cast<int>(content_size.y));
+        updateDisplayLevel(display_width, display_height);
 
         const float x_offset = (content_size.x - display_width) * 0.5f + pan_x_;
         const float y_offset = (content_size.y - display_height) * 0.5f + pan_y_;
@@ -920,9 +754,9 @@ namespace lfs::vis::gui {
             // Image info section
             ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "IMAGE");
             ImGui::Separator();
-            ImGui::Text("Dimensions: %dx%d", current_texture_->width, current_texture_->height);
+            ImGui::Text("Dimensions: %dx%d", current_texture_->source_width, current_texture_->source_height);
             ImGui::Text(LOC(lichtfeld::Strings::ImagePreview::MEGAPIXELS),
-                        (current_texture_->width * current_texture_->height) / 1e6);
+                        (static_cast<double>(current_texture_->source_width) * current_texture_->source_height) / 1e6);
 
             // Infer channels from extension
             const char* channels = "RGB (3)";
@@ -937,8 +771,8 @@ namespace lfs::vis::gui {
             ImGui::Text(LOC(lichtfeld::Strings::ImagePreview::COLOR_SPACE), color_space);
 
             // Aspect ratio
-            const float aspect = static_cast<float>(current_texture_->width) /
-                                 static_cast<float>(current_texture_->height);
+            const float aspect = static_cast<float>(current_texture_->source_width) /
+                                 static_cast<float>(current_texture_->source_height);
             const char* aspect_name = "Custom";
             if (std::abs(aspect - 16.0f / 9.0f) < 0.01f)
                 aspect_name = "16:9";
@@ -4,12 +4,10 @@
 
 #pragma once
 
-#include "core/image_io.hpp"
-#include <atomic>
+#include "gui/windows/image_decode_service.hpp"
 #include <filesystem>
 #include <glad/glad.h>
 #include <memory>
-#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -36,67 +34,6 @@ namespace lfs::vis::gui {
 
     ExifData parseExifData(const std::filesystem::path& path);
 
-    /**
-     * @brief RAII wrapper for raw image data
-     */
-    class ImageData {
-    public:
-        ImageData() = default;
-        ImageData(unsigned char* data, int width, int height, int channels)
-            : data_(data),
-              width_(width),
-              height_(height),
-              channels_(channels) {}
-
-        ~ImageData() {
-            if (data_) {
-                lfs::core::free_image(data_);
-            }
-        }
-
-        // Delete copy operations
-        ImageData(const ImageData&) = delete;
-        ImageData& operator=(const ImageData&) = delete;
-
-        // Move operations
-        ImageData(ImageData&& other) noexcept
-            : data_(std::exchange(other.data_, nullptr)),
-              width_(std::exchange(other.width_, 0)),
-              height_(std::exchange(other.height_, 0)),
-              channels_(std::exchange(other.channels_, 0)) {}
-
-        ImageData& operator=(ImageData&& other) noexcept {
-            if (this != &other) {
-                if (data_) {
-                    lfs::core::free_image(data_);
-                }
-                data_ = std::exchange(other.data_, nullptr);
-                width_ = std::exchange(other.width_, 0);
-                height_ = std::exchange(other.height_, 0);
-                channels_ = std::exchange(other.channels_, 0);
-            }
-            return *this;
-        }
-
-        // Accessors
-        unsigned char* data() const { return data_; }
-        int width() const { return width_; }
-        int height() const { return height_; }
-        int channels() const { return channels_; }
-        bool valid() const { return data_ != nullptr; }
-
-        // Release ownership
-        unsigned char* release() {
-            return std::exchange(data_, nullptr);
-        }
-
-    private:
-        unsigned char* data_ = nullptr;
-        int width_ = 0;
-        int height_ = 0;
-        int channels_ = 0;
-    };
-
     /**
      * @brief RAII wrapper for OpenGL texture
      */
@@ -161,7 +98,8 @@ namespace lfs::vis::gui {
      */
     class ImagePreview {
     public:
-        ImagePreview();
+        // persist_thumbnails keeps small previews on disk so reopened datasets show up faster
+        explicit ImagePreview(bool persist_thumbnails = false);
         ~ImagePreview();
 
         // Delete copy operations
@@ -194,28 +132,26 @@ namespace lfs::vis::gui {
             GLTexture texture;
             int width = 0;
             int height = 0;
+            int source_width = 0; // Size of the file, for display and info
+            int source_height = 0;
+            int level = -1; // Pyramid level the texture was uploaded from
             std::filesystem::path path;
         };
 
-        // Preloaded image data
-        struct PreloadedImage {
-            ImageData data;
-            std::filesystem::path path;
-        };
-
-        // Thread-safe loading result
-        struct LoadResult {
-            std::unique_ptr<PreloadedImage> image;
-            std::string error;
-        };
+        // Images prefetched on each side of the current one at the display level
+        static constexpr size_t PREFETCH_RADIUS = 1;
+        // Images on each side kept warm as thumbnails
+        static constexpr size_t THUMBNAIL_RADIUS = 4;
 
         // Helper methods
         void ensureMaxTextureSizeInitialized();
-        std::unique_ptr<ImageData> loadImageData(const std::filesystem::path& path);
-        std::unique_ptr<ImageTexture> createTexture(ImageData&& data, const std::filesystem::path& path);
-        bool loadImage(const std::filesystem::path& path);
-        void preloadAdjacentImages();
-        void checkPreloadedImages();
+        std::unique_ptr<ImageTexture> createTexture(const DecodedImage& image, const std::filesystem::path& path,
+                                                    int level);
+        void requestDecodes();
+        void updateTextures();
+        void updateTexture(std::unique_ptr<ImageTexture>& texture, const std::filesystem::path& path);
+        void updateDisplayLevel(float display_width, float display_height);
+        void showCurrentImage();
         std::pair<float, float> calculateDisplaySize(int window_width, int window_height) const;
 
         // State
@@ -226,25 +162,17 @@ namespace lfs::vis::gui {
         bool show_overlay_ = false; // Whether to show overlay on top of current image
 
         std::unique_ptr<ImageTexture> current_texture_;
-        std::unique_ptr<ImageTexture> previous_texture_;
         std::unique_ptr<ImageTexture> overlay_texture_; // Overlay texture (mask)
 
-        // Thread-safe preload results
-        mutable std::mutex preload_mutex_;
-        std::unique_ptr<LoadResult> prev_result_;
-        std::unique_ptr<LoadResult> next_result_;
-
-        // Preloaded textures
-        std::unique_ptr<ImageTexture> prev_texture_;
-        std::unique_ptr<ImageTexture> next_texture_;
+        // Background decoding, shared by the current image, its overlay and prefetches
+        std::unique_ptr<ImageDecodeService> decoder_;
+        int display_level_ = 0; // Pyramid level matching the on-screen size
 
         // Loading state
-        std::atomic<bool> is_loading_{false};
         std::string load_error_;
-        std::atomic<bool> preload_in_progress_{false};
 
         // Overlay helpers
-        void loadCurrentOverlay();
+        [[nodiscard]] const std::filesystem::path* currentOverlayPath() const;
         [[nodiscard]] bool hasValidOverlay() const;
 
         // UI state
@@ -22,6 +22,7 @@ namespace lfs::vis {
         bool antialiasing = false;
         bool enable_cuda_interop = true;
         bool gut = false;
+        bool persist_thumbnails = false; // Keep image preview thumbnails on disk between sessions
         int monitor_x = 0; // Monitor hint for window placement
         int monitor_y = 0;
         int monitor_width = 0;
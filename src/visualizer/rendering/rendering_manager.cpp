@@ -18,7 +18,6 @@
 #include "training/training_manager.hpp"
 #include <cuda_runtime.h>
 #include <glad/glad.h>
-#include <shared_mutex>
 #include <stdexcept>
 
 namespace lfs::vis {
@@ -743,16 +742,23 @@ namespace lfs::vis {
             last_render_size_ = current_size;
         }
 
-        const lfs::core::SplatData* const model = scene_manager ? scene_manager->getModelForRendering() : nullptr;
+        const lfs::core::SplatData* model = scene_manager ? scene_manager->getModelForRendering() : nullptr;
         const size_t model_ptr = reinterpret_cast<size_t>(model);
 
-        // Lock model during render to prevent tensor replacement
-        std::shared_lock<std::shared_mutex> render_lock;
+        // While training runs, render the latest published snapshot instead of the live model;
+        // the pin keeps it alive for this frame without ever blocking the trainer
+        const lfs::core::SnapshotPublisher<lfs::core::SplatData>* snapshots = nullptr;
+        lfs::core::SnapshotPublisher<lfs::core::SplatData>::Pin snapshot;
         if (const auto* tm = scene_manager ? scene_manager->getTrainerManager() : nullptr) {
             if (const auto* trainer = tm->getTrainer()) {
-                render_lock = std::shared_lock{trainer->getRenderMutex()};
+                snapshots = &trainer->getRenderSnapshots();
+                snapshot = snapshots->pin();
             }
         }
+        const bool use_snapshot = snapshots && !snapshot.live();
+        if (use_snapshot) {
+            model = snapshot.get(); // nullptr until the trainer serves the first request
+        }
 
         // Detect model switch
         if (model_ptr != last_model_ptr_) {
@@ -776,10 +782,32 @@ namespace lfs::vis {
             const auto interval = std::chrono::duration<float>(
                 framerate_controller_.getSettings().training_frame_refresh_time_sec);
             if (now - last_training_render_ > interval) {
+                if (use_snapshot) {
+                    // Rendered once the trainer publishes it at its next step boundary
+                    snapshots->request();
+                } else {
+                    should_render = true;
+                    render_texture_valid_ = false;
+                }
+                last_training_render_ = now;
+            }
+        }
+
+        if (use_snapshot) {
+            if (needs_render_now || !model) {
+                snapshots->request();
+            }
+            // Compare sequences, not addresses: the two snapshot buffers alternate
+            if (model && snapshot.sequence() != last_snapshot_sequence_) {
                 should_render = true;
                 render_texture_valid_ = false;
-                last_training_render_ = now;
             }
+            last_snapshot_sequence_ = snapshot.sequence();
+        } else if (last_snapshot_sequence_ != 0) {
+            // Training stopped: show the live model, which may be ahead of the last snapshot
+            should_render = true;
+            render_texture_valid_ = false;
+            last_snapshot_sequence_ = 0;
         }
 
         // GT comparison requires valid render texture
@@ -809,7 +837,13 @@ namespace lfs::vis {
             glEnable(GL_SCISSOR_TEST);
         }
 
-        if (should_render || !model) {
+        // Keep showing the last frame while waiting for the first snapshot
+        const bool awaiting_snapshot = use_snapshot && !model && cached_result_.image;
+        if (should_render && awaiting_snapshot) {
+            should_render = false;
+        }
+
+        if (should_render || (!model && !awaiting_snapshot)) {
             doFullRender(context, scene_manager, model);
         } else if (cached_result_.image) {
             glm::ivec2 viewport_pos(0, 0);
@@ -850,7 +884,7 @@ namespace lfs::vis {
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Check for split view
-        if (auto split_request = createSplitViewRequest(context, scene_manager)) {
+        if (auto split_request = createSplitViewRequest(context, scene_manager, model)) {
             // Update split info
             {
                 std::lock_guard<std::mutex> lock(split_info_mutex_);
@@ -1059,7 +1093,8 @@ namespace lfs::vis {
     }
 
     std::optional<lfs::rendering::SplitViewRequest>
-    RenderingManager::createSplitViewRequest(const RenderContext& context, SceneManager* scene_manager) {
+    RenderingManager::createSplitViewRequest(const RenderContext& context, SceneManager* scene_manager,
+                                             const lfs::core::SplatData* model) {
         if (settings_.split_view_mode == SplitViewMode::Disabled || !scene_manager) {
             return std::nullopt;
         }
@@ -1131,7 +1166,6 @@ namespace lfs::vis {
             // Make sure we have a valid render texture
             if (!render_texture_valid_) {
                 // Force a render to texture
-                const lfs::core::SplatData* model = scene_manager->getModelForRendering();
                 if (model) {
                     renderToTexture(context, scene_manager, model);
                 }
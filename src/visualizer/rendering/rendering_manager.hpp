@@ -284,7 +284,8 @@ namespace lfs::vis {
 
         std::optional<lfs::rendering::SplitViewRequest> createSplitViewRequest(
             const RenderContext& context,
-            SceneManager* scene_manager);
+            SceneManager* scene_manager,
+            const lfs::core::SplatData* model);
 
         // Core components
         std::unique_ptr<lfs::rendering::RenderingEngine> engine_;
@@ -309,6 +310,7 @@ namespace lfs::vis {
         static constexpr float SELECTION_FLASH_DURATION_SEC = 0.5f;
 
         size_t last_model_ptr_ = 0;
+        uint64_t last_snapshot_sequence_ = 0; // Publish sequence of the training snapshot last rendered
         glm::ivec2 last_render_size_{0, 0};
         std::chrono::steady_clock::time_point last_training_render_;
 
@@ -0,0 +1,264 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "io/formats/colmap.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace lfs::io;
+namespace fs = std::filesystem;
+
+namespace {
+
+    struct SyntheticPoint {
+        double xyz[3];
+        uint8_t rgb[3];
+        uint32_t track_length;
+    };
+
+    template <typename T>
+    void put(std::ofstream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    std::vector<SyntheticPoint> make_points(size_t n, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> pos(-50.0, 50.0);
+        std::uniform_int_distribution<int> color(0, 255);
+        std::geometric_distribution<uint32_t> track(0.15); // Mean track length ~6
+        std::vector<SyntheticPoint> points(n);
+        for (auto& p : points) {
+            for (int k = 0; k < 3; ++k) {
+                p.xyz[k] = pos(gen);
+                p.rgb[k] = static_cast<uint8_t>(color(gen));
+            }
+            p.track_length = 2 + track(gen);
+        }
+        return points;
+    }
+
+    void write_model(const fs::path& sparse, const std::vector<SyntheticPoint>& points, size_t num_images) {
+        fs::create_directories(sparse);
+
+        std::ofstream cams_bin(sparse / "cameras.bin", std::ios::binary);
+        put<uint64_t>(cams_bin, 1);
+        put<uint32_t>(cams_bin, 1);
+        put<int32_t>(cams_bin, 1); // PINHOLE
+        put<uint64_t>(cams_bin, 1920);
+        put<uint64_t>(cams_bin, 1080);
+        for (double v : {1500.0, 1500.0, 960.0, 540.0}) {
+            put(cams_bin, v);
+        }
+        std::ofstream cams_txt(sparse / "cameras.txt");
+        cams_txt << "# Camera list\n1 PINHOLE 1920 1080 1500 1500 960 540\n";
+
+        std::ofstream images_bin(sparse / "images.bin", std::ios::binary);
+        std::ofstream images_txt(sparse / "images.txt");
+        images_txt << "# Image list with two lines of data per image:\n";
+        put<uint64_t>(images_bin, num_images);
+        for (size_t i = 0; i < num_images; ++i) {
+            const double angle = 0.001 * static_cast<double>(i);
+            const double q[4] = {std::cos(angle), 0.0, std::sin(angle), 0.0};
+            const double t[3] = {0.5 * i, -1.0, 4.0};
+            const std::string name = std::format("IMG_{:06d}.jpg", i);
+            put<uint32_t>(images_bin, static_cast<uint32_t>(i + 1));
+            for (double v : q)
+                put(images_bin, v);
+            for (double v : t)
+                put(images_bin, v);
+            put<uint32_t>(images_bin, 1);
+            images_bin.write(name.c_str(), static_cast<std::streamsize>(name.size() + 1));
+
+            // Every third image has no observations: its POINTS2D line is blank
+            const uint64_t npts = i % 3 == 0 ? 0 : 4;
+            put(images_bin, npts);
+            images_txt << std::format("{} {} {} {} {} {} {} {} 1 {}\n", i + 1, q[0], q[1], q[2], q[3], t[0], t[1], t[2], name);
+            for (uint64_t k = 0; k < npts; ++k) {
+                put(images_bin, 10.0 * k);
+                put(images_bin, 20.0 * k);
+                put<int64_t>(images_bin, -1);
+                images_txt << std::format("{} {} -1 ", 10.0 * k, 20.0 * k);
+            }
+            images_txt << "\n";
+        }
+
+        std::ofstream points_bin(sparse / "points3D.bin", std::ios::binary);
+        std::ofstream points_txt(sparse / "points3D.txt");
+        points_txt << "# 3D point list with one line of data per point:\n";
+        put<uint64_t>(points_bin, points.size());
+        std::string line;
+        for (size_t i = 0; i < points.size(); ++i) {
+            const auto& p = points[i];
+            put<uint64_t>(points_bin, i + 1);
+            for (double v : p.xyz)
+                put(points_bin, v);
+            points_bin.write(reinterpret_cast<const char*>(p.rgb), 3);
+            put(points_bin, 0.5);
+            put<uint64_t>(points_bin, p.track_length);
+            line = std::format("{} {} {} {} {} {} {} 0.5", i + 1, p.xyz[0], p.xyz[1], p.xyz[2], p.rgb[0], p.rgb[1], p.rgb[2]);
+            for (uint32_t k = 0; k < p.track_length; ++k) {
+                put<uint32_t>(points_bin, k + 1);
+                put<uint32_t>(points_bin, k);
+                line += std::format(" {} {}", k + 1, k);
+            }
+            points_txt << line << '\n';
+        }
+    }
+
+    // Previous loader: ifstream slurp into a vector, serial decode
+    std::vector<float> legacy_read_points_binary(const fs::path& path) {
+        std::ifstream f(path, std::ios::binary | std::ios::ate);
+        std::vector<char> buf(static_cast<size_t>(f.tellg()));
+        f.seekg(0);
+        f.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+        const char* cur = buf.data();
+        uint64_t n;
+        std::memcpy(&n, cur, 8);
+        cur += 8;
+        std::vector<float> positions(n * 3);
+        for (uint64_t i = 0; i < n; ++i) {
+            cur += 8;
+            for (int k = 0; k < 3; ++k) {
+                double v;
+                std::memcpy(&v, cur, 8);
+                cur += 8;
+                positions[i * 3 + k] = static_cast<float>(v);
+            }
+            cur += 3 + 8;
+            uint64_t track;
+            std::memcpy(&track, cur, 8);
+            cur += 8 + track * 8;
+        }
+        return positions;
+    }
+
+    // Previous loader: getline into strings, split into a string per token, stof
+    std::vector<float> legacy_read_points_text(const fs::path& path) {
+        std::ifstream file(path);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line[0] != '#')
+                lines.push_back(line);
+        }
+        std::vector<float> positions(lines.size() * 3);
+        for (size_t i = 0; i < lines.size(); ++i) {
+            std::vector<std::string> tokens;
+            size_t start = 0, end;
+            while ((end = lines[i].find(' ', start)) != std::string::npos) {
+                tokens.push_back(lines[i].substr(start, end - start));
+                start = end + 1;
+            }
+            tokens.push_back(lines[i].substr(start));
+            for (int k = 0; k < 3; ++k)
+                positions[i * 3 + k] = std::stof(tokens[1 + k]);
+        }
+        return positions;
+    }
+
+    template <typename Func>
+    double time_ms(Func&& func) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        func();
+        const auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    std::vector<float> to_vector(const Tensor& t) {
+        const auto cpu = t.cpu().contiguous();
+        return std::vector<float>(cpu.ptr<float>(), cpu.ptr<float>() + cpu.numel());
+    }
+
+} // namespace
+
+class ColmapParserTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / std::format("lfs_colmap_parser_test_{}", ::testing::UnitTest::GetInstance()->random_seed());
+        fs::remove_all(dir_);
+        fs::create_directories(dir_ / "images");
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir_);
+    }
+
+    fs::path dir_;
+};
+
+TEST_F(ColmapParserTest, BinaryAndTextAgree) {
+    const auto points = make_points(50000, 7); // Several decode chunks
+    write_model(dir_ / "sparse" / "0", points, 300);
+
+    const auto binary = read_colmap_point_cloud(dir_);
+    const auto text = read_colmap_point_cloud_text(dir_);
+    ASSERT_EQ(binary.means.shape()[0], points.size());
+    ASSERT_EQ(text.means.shape()[0], points.size());
+
+    const auto bin_pos = to_vector(binary.means);
+    const auto txt_pos = to_vector(text.means);
+    const auto bin_rgb = binary.colors.cpu();
+    const auto txt_rgb = text.colors.cpu();
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (int k = 0; k < 3; ++k) {
+            ASSERT_EQ(bin_pos[i * 3 + k], static_cast<float>(points[i].xyz[k])) << "point " << i;
+            ASSERT_NEAR(txt_pos[i * 3 + k], bin_pos[i * 3 + k], 1e-4f) << "point " << i;
+            ASSERT_EQ(bin_rgb.ptr<uint8_t>()[i * 3 + k], points[i].rgb[k]);
+            ASSERT_EQ(txt_rgb.ptr<uint8_t>()[i * 3 + k], points[i].rgb[k]);
+        }
+    }
+
+    auto bin_cams = read_colmap_cameras_and_images(dir_);
+    auto txt_cams = read_colmap_cameras_and_images_text(dir_);
+    ASSERT_TRUE(bin_cams.has_value());
+    ASSERT_TRUE(txt_cams.has_value());
+    const auto& [bin_list, bin_center] = *bin_cams;
+    const auto& [txt_list, txt_center] = *txt_cams;
+    ASSERT_EQ(bin_list.size(), 300u);
+    ASSERT_EQ(txt_list.size(), 300u);
+    for (size_t i = 0; i < bin_list.size(); ++i) {
+        EXPECT_EQ(bin_list[i]->image_name(), txt_list[i]->image_name());
+    }
+}
+
+TEST_F(ColmapParserTest, TruncatedBinaryThrows) {
+    write_model(dir_ / "sparse" / "0", make_points(1000, 3), 4);
+    const auto path = dir_ / "sparse" / "0" / "points3D.bin";
+    fs::resize_file(path, fs::file_size(path) - 5);
+    EXPECT_THROW(read_colmap_point_cloud(dir_), std::runtime_error);
+}
+
+TEST_F(ColmapParserTest, SyntheticModelBenchmark) {
+    constexpr size_t NUM_POINTS = 2'000'000;
+    const auto points = make_points(NUM_POINTS, 42);
+    const auto sparse = dir_ / "sparse" / "0";
+    write_model(sparse, points, 10);
+
+    std::vector<float> legacy_bin, legacy_txt;
+    lfs::core::PointCloud bin, txt;
+    const double legacy_bin_ms = time_ms([&] { legacy_bin = legacy_read_points_binary(sparse / "points3D.bin"); });
+    const double bin_ms = time_ms([&] { bin = read_colmap_point_cloud(dir_); });
+    const double legacy_txt_ms = time_ms([&] { legacy_txt = legacy_read_points_text(sparse / "points3D.txt"); });
+    const double txt_ms = time_ms([&] { txt = read_colmap_point_cloud_text(dir_); });
+
+    EXPECT_EQ(to_vector(bin.means), legacy_bin);
+    EXPECT_EQ(to_vector(txt.means), legacy_txt);
+
+    std::cout << "\n=== COLMAP points3D, " << NUM_POINTS << " points (includes upload for the new path) ===\n"
+              << std::fixed << std::setprecision(1)
+              << "  binary | legacy " << std::setw(8) << legacy_bin_ms << " ms | mmap+parallel "
+              << std::setw(8) << bin_ms << " ms | " << legacy_bin_ms / bin_ms << "x\n"
+              << "  text   | legacy " << std::setw(8) << legacy_txt_ms << " ms | from_chars+parallel "
+              << std::setw(8) << txt_ms << " ms | " << legacy_txt_ms / txt_ms << "x\n";
+}
@@ -0,0 +1,254 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include "core/tensor/internal/cpu_elementwise.hpp"
+#include "core/tensor/internal/cpu_parallel.hpp"
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace lfs::core;
+using namespace std::chrono;
+
+namespace {
+
+    template <typename Func>
+    double time_ms(Func func, int iters = 5) {
+        func(); // Warmup
+        const auto start = high_resolution_clock::now();
+        for (int i = 0; i < iters; ++i) {
+            func();
+        }
+        const auto end = high_resolution_clock::now();
+        return duration<double, std::milli>(end - start).count() / iters;
+    }
+
+    std::vector<int> thread_counts() {
+        const int max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<int> counts;
+        for (int t = 1; t < max_threads; t *= 2) {
+            counts.push_back(t);
+        }
+        counts.push_back(max_threads);
+        return counts;
+    }
+
+    // Restores the default thread cap even if an assertion fails
+    struct ThreadCapGuard {
+        ~ThreadCapGuard() { cpu_parallel::set_num_threads(0); }
+    };
+
+} // namespace
+
+class CpuElementwiseBenchmark : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Tensor::manual_seed(42);
+    }
+};
+
+TEST_F(CpuElementwiseBenchmark, ArgmaxAndArgminReturnIndices) {
+    std::vector<float> data(1 << 20);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = std::sin(static_cast<float>(i) * 0.001f);
+    }
+    data[777777] = 5.0f;
+    data[123] = -5.0f;
+    const auto t = Tensor::from_vector(data, {data.size()}, Device::CPU);
+
+    const auto amax = t.argmax();
+    const auto amin = t.argmin();
+    ASSERT_EQ(amax.dtype(), DataType::Int64);
+    EXPECT_EQ(amax.item<int64_t>(), 777777);
+    EXPECT_EQ(amin.item<int64_t>(), 123);
+}
+
+TEST_F(CpuElementwiseBenchmark, AxisReductionsMatchSerialReference) {
+    const size_t rows = 50000, cols = 3;
+    const auto t = Tensor::randn({rows, cols}, Device::CPU);
+    const auto values = t.to_vector();
+
+    const auto sum0 = t.sum({0}).to_vector();
+    const auto max1 = t.max({1}).to_vector();
+    const auto var0 = t.var({0}).to_vector();
+    ASSERT_EQ(sum0.size(), cols);
+    ASSERT_EQ(max1.size(), rows);
+
+    for (size_t c = 0; c < cols; ++c) {
+        double sum = 0.0;
+        for (size_t r = 0; r < rows; ++r) {
+            sum += values[r * cols + c];
+        }
+        const double mean = sum / rows;
+        double sq = 0.0;
+        for (size_t r = 0; r < rows; ++r) {
+            const double d = values[r * cols + c] - mean;
+            sq += d * d;
+        }
+        EXPECT_NEAR(sum0[c], sum, 1e-3);
+        EXPECT_NEAR(var0[c], sq / (rows - 1), 1e-4);
+    }
+    for (size_t r = 0; r < rows; ++r) {
+        const float expected = std::max({values[r * 3], values[r * 3 + 1], values[r * 3 + 2]});
+        ASSERT_EQ(max1[r], expected) << "at row " << r;
+    }
+}
+
+TEST_F(CpuElementwiseBenchmark, NonAdjacentAxesAndIntegerReductions) {
+    const auto t = Tensor::randn({4, 5, 6}, Device::CPU);
+    const auto values = t.to_vector();
+    const auto sum02 = t.sum({0, 2}).to_vector();
+    ASSERT_EQ(sum02.size(), 5u);
+    for (size_t j = 0; j < 5; ++j) {
+        double expected = 0.0;
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t k = 0; k < 6; ++k) {
+                expected += values[(i * 5 + j) * 6 + k];
+            }
+        }
+        EXPECT_NEAR(sum02[j], expected, 1e-4);
+    }
+
+    std::vector<int> ints(12);
+    for (int i = 0; i < 12; ++i) {
+        ints[i] = i;
+    }
+    const auto it = Tensor::from_vector(ints, {3, 4}, Device::CPU);
+    const auto row_sums = it.sum({1}).to_vector_int();
+    EXPECT_EQ(row_sums, (std::vector<int>{6, 22, 38}));
+
+    const std::vector<int> rows_axis = {1};
+    const std::vector<int> cols_axis = {0};
+    // Row 0 holds the only zero, so any() is true everywhere and all() fails only there
+    EXPECT_EQ(it.any(rows_axis).to_vector_bool(), (std::vector<bool>{true, true, true}));
+    EXPECT_EQ(it.all(rows_axis).to_vector_bool(), (std::vector<bool>{false, true, true}));
+    EXPECT_EQ(it.all(cols_axis).to_vector_bool(), (std::vector<bool>{false, true, true, true}));
+
+    std::vector<int> sparse(12, 0);
+    sparse[7] = -3;
+    const auto lt = Tensor::from_vector(sparse, {3, 4}, Device::CPU).to(DataType::Int64);
+    EXPECT_EQ(lt.any(rows_axis).to_vector_bool(), (std::vector<bool>{false, true, false}));
+    EXPECT_EQ(lt.all(rows_axis).to_vector_bool(), (std::vector<bool>{false, false, false}));
+    EXPECT_TRUE(lt.any().to_vector_bool()[0]);
+    EXPECT_FALSE(lt.all().to_vector_bool()[0]);
+}
+
+TEST_F(CpuElementwiseBenchmark, ByteKernelsMatchScalarFunctors) {
+    // Odd length so the scalar tail runs after the 32-wide blocks
+    constexpr size_t n = 32 * 40 + 13;
+    std::vector<float> fa(n), fb(n);
+    std::vector<unsigned char> ua(n), ub(n);
+    for (size_t i = 0; i < n; ++i) {
+        fa[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+        fb[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+        ua[i] = static_cast<unsigned char>((i * 37) % 256);
+        ub[i] = static_cast<unsigned char>((i * 91 + 5) % 256);
+    }
+    fa[3] = std::numeric_limits<float>::quiet_NaN();
+    fb[40] = std::numeric_limits<float>::quiet_NaN();
+    ua[10] = ub[10] = 0;
+    ua[11] = ub[11] = 200;
+
+    std::vector<unsigned char> out(n);
+    const auto check_binary = [&](const auto& in_a, const auto& in_b, const auto& op, const char* name) {
+        cpu_elementwise::binary(in_a.data(), in_b.data(), out.data(), n, op);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], static_cast<unsigned char>(op(in_a[i], in_b[i]))) << name << " at " << i;
+        }
+    };
+    const auto check_unary = [&](const auto& in, const auto& op, const char* name) {
+        cpu_elementwise::unary(in.data(), out.data(), n, op);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], static_cast<unsigned char>(op(in[i]))) << name << " at " << i;
+        }
+    };
+
+    check_binary(fa, fb, ops::equal_op{}, "f32 eq");
+    check_binary(fa, fb, ops::not_equal_op{}, "f32 ne");
+    check_binary(fa, fb, ops::less_op{}, "f32 lt");
+    check_binary(fa, fb, ops::less_equal_op{}, "f32 le");
+    check_binary(fa, fb, ops::greater_op{}, "f32 gt");
+    check_binary(fa, fb, ops::greater_equal_op{}, "f32 ge");
+    check_unary(fa, ops::scalar_right_op<ops::less_op, float>(0.5f), "f32 lt scalar");
+    check_unary(fa, ops::scalar_left_op<ops::greater_equal_op, float>(-1.0f), "f32 scalar ge");
+
+    check_binary(ua, ub, ops::equal_op{}, "u8 eq");
+    check_binary(ua, ub, ops::not_equal_op{}, "u8 ne");
+    check_binary(ua, ub, ops::less_op{}, "u8 lt");
+    check_binary(ua, ub, ops::less_equal_op{}, "u8 le");
+    check_binary(ua, ub, ops::greater_op{}, "u8 gt");
+    check_binary(ua, ub, ops::greater_equal_op{}, "u8 ge");
+    check_binary(ua, ub, ops::logical_and_op{}, "u8 and");
+    check_binary(ua, ub, ops::logical_or_op{}, "u8 or");
+    check_binary(ua, ub, ops::logical_xor_op{}, "u8 xor");
+    check_binary(ua, ub, ops::maximum_op{}, "u8 max");
+    check_binary(ua, ub, ops::minimum_op{}, "u8 min");
+    check_unary(ua, ops::logical_not_op{}, "u8 not");
+}
+
+TEST_F(CpuElementwiseBenchmark, ResultsIndependentOfThreadCount) {
+    ThreadCapGuard guard;
+    const auto t = Tensor::randn({1 << 22}, Device::CPU);
+
+    cpu_parallel::set_num_threads(1);
+    const float sum_serial = t.sum().item();
+    const float std_serial = t.std().item();
+
+    cpu_parallel::set_num_threads(0);
+    EXPECT_EQ(t.sum().item(), sum_serial);
+    EXPECT_EQ(t.std().item(), std_serial);
+}
+
+TEST_F(CpuElementwiseBenchmark, ThreadScaling) {
+    ThreadCapGuard guard;
+    const size_t n = 1 << 24; // 16M floats, well past L3
+    const auto a = Tensor::randn({n}, Device::CPU);
+    const auto b = Tensor::randn({n}, Device::CPU);
+    const Tensor mask_a = a.gt(0.0f);
+    const Tensor mask_b = b.lt(0.0f);
+
+    struct Case {
+        const char* name;
+        std::function<void()> fn;
+    };
+    const std::vector<Case> cases = {
+        {"add", [&] { auto r = a + b; }},
+        {"mul scalar", [&] { auto r = a * 2.5f; }},
+        {"exp", [&] { auto r = a.exp(); }},
+        {"sum", [&] { auto r = a.sum(); }},
+        {"max", [&] { auto r = a.max(); }},
+        {"argmax", [&] { auto r = a.argmax(); }},
+        {"std", [&] { auto r = a.std(); }},
+        {"greater", [&] { auto r = a.gt(b); }},
+        {"logical and", [&] { auto r = mask_a.logical_and(mask_b); }},
+    };
+
+    std::cout << "\n=== CPU element-wise / reduction scaling (" << n << " floats) ===\n";
+    std::cout << "  " << std::left << std::setw(12) << "op";
+    const auto counts = thread_counts();
+    for (int t : counts) {
+        std::cout << std::right << std::setw(10) << (std::to_string(t) + "T");
+    }
+    std::cout << std::right << std::setw(10) << "speedup" << "\n";
+
+    for (const auto& c : cases) {
+        std::cout << "  " << std::left << std::setw(12) << c.name;
+        double first = 0.0, last = 0.0;
+        for (int t : counts) {
+            cpu_parallel::set_num_threads(t);
+            last = time_ms(c.fn);
+            if (first == 0.0) {
+                first = last;
+            }
+            std::cout << std::right << std::setw(7) << std::fixed << std::setprecision(2) << last << " ms";
+        }
+        std::cout << std::setw(9) << std::setprecision(1) << first / last << "x\n";
+    }
+}
@@ -0,0 +1,171 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace lfs::core;
+using namespace std::chrono;
+
+namespace {
+
+    // Previous CPU backend: naive i-j-l triple loop
+    void reference_matmul(const float* a, const float* b, float* c,
+                          size_t m, size_t k, size_t n) {
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                float sum = 0.0f;
+                for (size_t l = 0; l < k; ++l) {
+                    sum += a[i * k + l] * b[l * n + j];
+                }
+                c[i * n + j] = sum;
+            }
+        }
+    }
+
+    template <typename Func>
+    double time_ms(Func func, int iters = 3) {
+        func(); // Warmup
+        const auto start = high_resolution_clock::now();
+        for (int i = 0; i < iters; ++i) {
+            func();
+        }
+        const auto end = high_resolution_clock::now();
+        return duration<double, std::milli>(end - start).count() / iters;
+    }
+
+    void print_row(const std::string& label, double ref_ms, double gemm_ms) {
+        std::cout << "  " << std::left << std::setw(34) << label
+                  << " | naive " << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ref_ms << " ms"
+                  << " | gemm " << std::setw(9) << gemm_ms << " ms"
+                  << " | " << std::setprecision(1) << ref_ms / gemm_ms << "x\n";
+    }
+
+    void expect_close(const Tensor& result, const std::vector<float>& expected, size_t k) {
+        const auto values = result.cpu().to_vector();
+        ASSERT_EQ(values.size(), expected.size());
+        const float tol = 1e-4f * static_cast<float>(k) + 1e-4f;
+        for (size_t i = 0; i < values.size(); ++i) {
+            ASSERT_NEAR(values[i], expected[i], tol * (1.0f + std::abs(expected[i]))) << "at index " << i;
+        }
+    }
+
+} // namespace
+
+class CpuGemmBenchmark : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Tensor::manual_seed(42);
+    }
+
+    // Runs A[m,k] @ B[k,n] through Tensor::mm and the naive loop, checks and reports.
+    // transpose_b passes B as the transposed view of an [n,k] tensor.
+    void run_case(const std::string& label, size_t m, size_t k, size_t n, int iters = 3,
+                  bool transpose_b = false) {
+        auto a = Tensor::randn({m, k}, Device::CPU);
+        auto b = transpose_b ? Tensor::randn({n, k}, Device::CPU).t() : Tensor::randn({k, n}, Device::CPU);
+        const auto b_dense = b.contiguous();
+        std::vector<float> expected(m * n);
+
+        const double ref_ms = time_ms([&]() {
+            reference_matmul(a.ptr<float>(), b_dense.ptr<float>(), expected.data(), m, k, n);
+        },
+                                      iters);
+
+        Tensor result;
+        const double gemm_ms = time_ms([&]() { result = a.mm(b); }, iters);
+
+        expect_close(result, expected, k);
+        print_row(label, ref_ms, gemm_ms);
+    }
+};
+
+TEST_F(CpuGemmBenchmark, SmallShapesMatchReference) {
+    // Edge tiles and odd sizes exercise padding in both packed and tiny-K paths
+    const size_t shapes[][3] = {{1, 1, 1}, {3, 3, 3}, {4, 4, 17}, {7, 13, 9}, {37, 129, 65}, {97, 300, 131}};
+    for (const auto& s : shapes) {
+        auto a = Tensor::randn({s[0], s[1]}, Device::CPU);
+        auto b = Tensor::randn({s[1], s[2]}, Device::CPU);
+        std::vector<float> expected(s[0] * s[2]);
+        reference_matmul(a.ptr<float>(), b.ptr<float>(), expected.data(), s[0], s[1], s[2]);
+        expect_close(a.mm(b), expected, s[1]);
+    }
+}
+
+TEST_F(CpuGemmBenchmark, TransposedViewMatchesContiguous) {
+    // Strided operands are packed directly instead of materialized
+    auto a = Tensor::randn({4, 4}, Device::CPU);
+    auto points = Tensor::randn({10000, 4}, Device::CPU);
+    auto b = Tensor::randn({64, 200}, Device::CPU);
+
+    expect_close(a.mm(points.t()), a.mm(points.t().contiguous()).to_vector(), 4);
+    expect_close(b.t().mm(b), b.t().contiguous().mm(b).to_vector(), 64);
+}
+
+TEST_F(CpuGemmBenchmark, TinyKTransposedOperandMatchesReference) {
+    // compute_cropbox_mask multiplies by means_homo.t(), a B with column stride 4.
+    // Sizes cover a partial SIMD tail, a partial column chunk and the parallel path.
+    auto a = Tensor::randn({4, 4}, Device::CPU);
+    for (const size_t n : {size_t{13}, size_t{2049}, size_t{100'003}}) {
+        auto points = Tensor::randn({n, 4}, Device::CPU);
+        const auto b = points.t();
+        ASSERT_FALSE(b.is_contiguous());
+        const auto b_dense = b.contiguous();
+        std::vector<float> expected(4 * n);
+        reference_matmul(a.ptr<float>(), b_dense.ptr<float>(), expected.data(), 4, 4, n);
+        expect_close(a.mm(b), expected, 4);
+    }
+
+    // Both operands transposed, k = 3
+    auto x = Tensor::randn({3, 50}, Device::CPU);
+    auto y = Tensor::randn({300, 3}, Device::CPU);
+    const auto x_dense = x.t().contiguous();
+    const auto y_dense = y.t().contiguous();
+    std::vector<float> expected(50 * 300);
+    reference_matmul(x_dense.ptr<float>(), y_dense.ptr<float>(), expected.data(), 50, 3, 300);
+    expect_close(x.t().mm(y.t()), expected, 3);
+}
+
+TEST_F(CpuGemmBenchmark, BatchedAndDotMatchReference) {
+    const size_t batch = 64, m = 5, k = 7, n = 9;
+    auto a = Tensor::randn({batch, m, k}, Device::CPU);
+    auto b = Tensor::randn({batch, k, n}, Device::CPU);
+    std::vector<float> expected(batch * m * n);
+    for (size_t i = 0; i < batch; ++i) {
+        reference_matmul(a.ptr<float>() + i * m * k, b.ptr<float>() + i * k * n,
+                         expected.data() + i * m * n, m, k, n);
+    }
+    expect_close(a.bmm(b), expected, k);
+
+    auto x = Tensor::randn({100003}, Device::CPU);
+    auto y = Tensor::randn({100003}, Device::CPU);
+    const auto xv = x.to_vector();
+    const auto yv = y.to_vector();
+    double dot = 0.0;
+    for (size_t i = 0; i < xv.size(); ++i) {
+        dot += static_cast<double>(xv[i]) * yv[i];
+    }
+    EXPECT_NEAR(x.dot(y).item(), dot, 1e-2);
+}
+
+TEST_F(CpuGemmBenchmark, SplatScaleShapes) {
+    std::cout << "\n=== CPU GEMM vs naive loop ===\n";
+
+    // compute_cropbox_mask: transform [4,4] @ means_homo^T [4,N]
+    run_case("[4,4] @ [4,1M]", 4, 4, 1'000'000);
+    run_case("[4,4] @ [4,5M]", 4, 4, 5'000'000, 1);
+    run_case("[4,4] @ [1M,4].t()", 4, 4, 1'000'000, 3, true);
+
+    // Row-major point transforms: [N,3] @ [3,3]
+    run_case("[1M,3] @ [3,3]", 1'000'000, 3, 3);
+
+    // Generic dense shapes
+    run_case("[256,256] @ [256,256]", 256, 256, 256);
+    run_case("[512,512] @ [512,512]", 512, 512, 512, 1);
+    run_case("[100k,48] @ [48,16]", 100'000, 48, 16);
+}
@@ -0,0 +1,326 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/image_io.hpp"
+#include "core/tensor.hpp"
+#include "io/cache_image_loader.hpp"
+#include "io/decoded_image_pack.hpp"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace lfs::io;
+namespace fs = std::filesystem;
+
+namespace {
+
+    std::vector<uint8_t> make_pixels(int width, int height, int channels, int seed) {
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * channels);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    pixels[(static_cast<size_t>(y) * width + x) * channels + c] =
+                        static_cast<uint8_t>((x * (c + 1) + y * 3 + seed * 17) & 0xFF);
+                }
+            }
+        }
+        return pixels;
+    }
+
+    void write_file(const fs::path& path, const std::string& contents) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << contents;
+    }
+
+    // Sum over every page so mapped data is actually faulted in
+    uint64_t touch(const uint8_t* data, size_t size) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < size; i += 64) {
+            sum += data[i];
+        }
+        return sum;
+    }
+
+} // namespace
+
+class DecodedImagePackTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / std::format("lfs_decoded_pack_test_{}", ::testing::UnitTest::GetInstance()->random_seed());
+        fs::remove_all(dir_);
+        fs::create_directories(dir_ / "images");
+        source_ = dir_ / "images" / "IMG_0001.JPG";
+        write_file(source_, "original source bytes");
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir_);
+    }
+
+    fs::path cache_dir() const { return dir_ / "cache"; }
+
+    fs::path dir_;
+    fs::path source_;
+};
+
+TEST_F(DecodedImagePackTest, PersistsAcrossReopen) {
+    const auto pixels = make_pixels(37, 23, 3, 1); // Odd size: next entry must still be aligned
+    {
+        DecodedImagePack pack(cache_dir(), "images");
+        ASSERT_TRUE(pack.is_open());
+        EXPECT_FALSE(pack.find(source_, 2, 0));
+        ASSERT_TRUE(pack.insert(source_, 2, 0, pixels.data(), 37, 23, 3));
+        ASSERT_TRUE(pack.insert(source_, 4, 0, pixels.data(), 18, 11, 3));
+    }
+
+    DecodedImagePack pack(cache_dir(), "images");
+    EXPECT_EQ(pack.stats().entries, 2u);
+
+    const auto view = pack.find(source_, 2, 0);
+    ASSERT_TRUE(view);
+    EXPECT_EQ(view->width, 37);
+    EXPECT_EQ(view->height, 23);
+    EXPECT_EQ(view->channels, 3);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view->data) % DECODED_PACK_ALIGNMENT, 0u);
+    EXPECT_TRUE(std::equal(pixels.begin(), pixels.end(), view->data));
+
+    const auto quarter = pack.find(source_, 4, 0);
+    ASSERT_TRUE(quarter);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(quarter->data) % DECODED_PACK_ALIGNMENT, 0u);
+    EXPECT_FALSE(pack.find(source_, 2, 1600)); // Different max_width is a different entry
+}
+
+TEST_F(DecodedImagePackTest, InvalidatesWhenSourceChanges) {
+    DecodedImagePack pack(cache_dir(), "images");
+    const auto pixels = make_pixels(16, 16, 3, 2);
+    ASSERT_TRUE(pack.insert(source_, 1, 0, pixels.data(), 16, 16, 3));
+    ASSERT_TRUE(pack.find(source_, 1, 0));
+
+    // Same size, newer mtime
+    write_file(source_, "modified source bytes");
+    fs::last_write_time(source_, fs::last_write_time(source_) + std::chrono::seconds(5));
+    EXPECT_FALSE(pack.find(source_, 1, 0));
+
+    const auto updated = make_pixels(16, 16, 3, 3);
+    ASSERT_TRUE(pack.insert(source_, 1, 0, updated.data(), 16, 16, 3));
+    auto view = pack.find(source_, 1, 0);
+    ASSERT_TRUE(view);
+    EXPECT_TRUE(std::equal(updated.begin(), updated.end(), view->data));
+
+    // Different size, same mtime
+    const auto mtime = fs::last_write_time(source_);
+    write_file(source_, "modified source bytes, now longer");
+    fs::last_write_time(source_, mtime);
+    EXPECT_FALSE(pack.find(source_, 1, 0));
+
+    fs::remove(source_);
+    EXPECT_FALSE(pack.find(source_, 1, 0));
+
+    const auto stats = pack.stats();
+    EXPECT_EQ(stats.stale, 2u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_EQ(stats.live_bytes, 16u * 16u * 3u);
+}
+
+TEST_F(DecodedImagePackTest, DropsTornIndexTail) {
+    const auto pixels = make_pixels(8, 8, 3, 4);
+    {
+        DecodedImagePack pack(cache_dir(), "images");
+        ASSERT_TRUE(pack.insert(source_, 1, 0, pixels.data(), 8, 8, 3));
+    }
+    const auto index_path = cache_dir() / "images.idx";
+    const auto good_size = fs::file_size(index_path);
+    {
+        std::ofstream out(index_path, std::ios::binary | std::ios::app);
+        out << "half a record";
+    }
+
+    DecodedImagePack pack(cache_dir(), "images");
+    EXPECT_EQ(fs::file_size(index_path), good_size);
+    ASSERT_TRUE(pack.find(source_, 1, 0));
+
+    // Appends after recovery land on a clean record boundary
+    ASSERT_TRUE(pack.insert(source_, 2, 0, pixels.data(), 4, 4, 3));
+    DecodedImagePack reopened(cache_dir(), "images");
+    EXPECT_EQ(reopened.stats().entries, 2u);
+}
+
+TEST_F(DecodedImagePackTest, StopsGrowingAtMaxBytes) {
+    const auto pixels = make_pixels(32, 32, 3, 4);
+    const size_t bytes = pixels.size();
+    DecodedImagePack pack(cache_dir(), "images", bytes * 5 / 2); // Room for two plus the header
+    ASSERT_TRUE(pack.insert(source_, 1, 0, pixels.data(), 32, 32, 3));
+    ASSERT_TRUE(pack.insert(source_, 2, 0, pixels.data(), 32, 32, 3));
+    EXPECT_FALSE(pack.insert(source_, 4, 0, pixels.data(), 32, 32, 3));
+
+    const auto stats = pack.stats();
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_EQ(stats.rejected, 1u);
+    EXPECT_LE(stats.pack_bytes, bytes * 5 / 2);
+    EXPECT_TRUE(pack.find(source_, 2, 0));
+}
+
+TEST_F(DecodedImagePackTest, EvictsLeastRecentlyOpenedPacks) {
+    const auto pixels = make_pixels(64, 64, 3, 5);
+    for (const char* name : {"old", "recent", "open"}) {
+        DecodedImagePack pack(cache_dir(), name);
+        ASSERT_TRUE(pack.insert(source_, 1, 0, pixels.data(), 64, 64, 3));
+    }
+    const auto now = fs::file_time_type::clock::now();
+    fs::last_write_time(cache_dir() / "old.idx", now - std::chrono::hours(2));
+    fs::last_write_time(cache_dir() / "recent.idx", now - std::chrono::hours(1));
+    fs::last_write_time(cache_dir() / "open.idx", now - std::chrono::hours(3));
+
+    const size_t one_pack = fs::file_size(cache_dir() / "old.pack") + fs::file_size(cache_dir() / "old.idx");
+    const size_t remaining = DecodedImagePack::evict(cache_dir(), one_pack * 2, {"open"});
+
+    // The oldest pack is in use, so the next oldest goes instead
+    EXPECT_EQ(remaining, one_pack * 2);
+    EXPECT_FALSE(fs::exists(cache_dir() / "old.pack"));
+    EXPECT_FALSE(fs::exists(cache_dir() / "old.idx"));
+    EXPECT_TRUE(fs::exists(cache_dir() / "recent.pack"));
+    EXPECT_TRUE(fs::exists(cache_dir() / "open.pack"));
+
+    // Reopening a pack marks it as recently used
+    { DecodedImagePack reopened(cache_dir(), "open"); }
+    EXPECT_EQ(DecodedImagePack::evict(cache_dir(), one_pack, {}), one_pack);
+    EXPECT_TRUE(fs::exists(cache_dir() / "open.pack"));
+    EXPECT_FALSE(fs::exists(cache_dir() / "recent.pack"));
+}
+
+TEST_F(DecodedImagePackTest, TensorViewOutlivesPack) {
+    const auto pixels = make_pixels(32, 8, 3, 5);
+    lfs::core::Tensor tensor;
+    {
+        DecodedImagePack pack(cache_dir(), "images");
+        ASSERT_TRUE(pack.insert(source_, 1, 0, pixels.data(), 32, 8, 3));
+        auto view = pack.find(source_, 1, 0);
+        ASSERT_TRUE(view);
+        tensor = lfs::core::Tensor::from_blob(const_cast<uint8_t*>(view->data), lfs::core::TensorShape({8, 32, 3}),
+                                              lfs::core::Device::CPU, lfs::core::DataType::UInt8, std::move(view->owner));
+
+        // Growing the pack remaps; the earlier view stays valid
+        const auto more = make_pixels(64, 64, 3, 6);
+        ASSERT_TRUE(pack.insert(source_, 2, 0, more.data(), 64, 64, 3));
+        ASSERT_TRUE(pack.find(source_, 2, 0));
+    }
+    const auto* data = tensor.ptr<uint8_t>();
+    EXPECT_TRUE(std::equal(pixels.begin(), pixels.end(), data));
+    EXPECT_EQ(tensor.to(lfs::core::DataType::Float32).sum().item(),
+              static_cast<float>(std::accumulate(pixels.begin(), pixels.end(), uint64_t{0})));
+}
+
+TEST_F(DecodedImagePackTest, ClearKeepsEarlierViewsReadable) {
+    const auto pixels = make_pixels(128, 64, 3, 7);
+    DecodedImagePack pack(cache_dir(), "images");
+    ASSERT_TRUE(pack.insert(source_, 1, 0, pixels.data(), 128, 64, 3));
+    const auto view = pack.find(source_, 1, 0);
+    ASSERT_TRUE(view);
+
+    // Truncating the mapped file in place would make these reads fault
+    pack.clear();
+    EXPECT_EQ(pack.stats().entries, 0u);
+    EXPECT_EQ(touch(view->data, view->size_bytes()), touch(pixels.data(), pixels.size()));
+    EXPECT_TRUE(std::equal(pixels.begin(), pixels.end(), view->data));
+
+    ASSERT_TRUE(pack.insert(source_, 2, 0, pixels.data(), 128, 64, 3));
+    EXPECT_TRUE(pack.find(source_, 2, 0));
+}
+
+TEST_F(DecodedImagePackTest, CacheLoaderHitsWarmPackAfterReset) {
+    constexpr int NUM_IMAGES = 3;
+    std::vector<fs::path> images;
+    for (int i = 0; i < NUM_IMAGES; ++i) {
+        auto pixels = make_pixels(64, 48, 3, i);
+        images.push_back(dir_ / "images" / std::format("frame_{}.png", i));
+        ASSERT_TRUE(lfs::core::save_img_data(images.back(), {pixels.data(), 64, 48, 3}));
+    }
+
+    auto& loader = CacheLoader::getInstance(false, true);
+    const LoadParams params{.resize_factor = 2};
+    auto run = [&] {
+        loader.reset_cache();
+        loader.update_cache_params(false, true, NUM_IMAGES, 0.0f, 0.0f, false, 1);
+        std::vector<lfs::core::Tensor> loaded;
+        for (const auto& image : images) {
+            loaded.push_back(loader.load_cached_image(image, params));
+        }
+        return loaded;
+    };
+
+    const auto cold = run();
+    ASSERT_EQ(loader.get_cache_mode(), CacheLoader::CacheMode::FileSystem);
+    EXPECT_EQ(loader.get_decoded_cache_stats().insertions, static_cast<size_t>(NUM_IMAGES));
+
+    // A new training run resets the loader; the pack on disk must still serve it
+    const auto warm = run();
+    const auto stats = loader.get_decoded_cache_stats();
+    EXPECT_EQ(stats.hits, static_cast<size_t>(NUM_IMAGES));
+    EXPECT_EQ(stats.insertions, 0u);
+    for (int i = 0; i < NUM_IMAGES; ++i) {
+        EXPECT_EQ((cold[i] - warm[i]).abs().max().item(), 0.0f) << images[i];
+    }
+    loader.reset_cache();
+}
+
+TEST_F(DecodedImagePackTest, ColdVsWarmLoad) {
+    constexpr int NUM_IMAGES = 24;
+    constexpr int WIDTH = 1920;
+    constexpr int HEIGHT = 1080;
+    constexpr int RESIZE_FACTOR = 2;
+
+    std::vector<fs::path> images;
+    for (int i = 0; i < NUM_IMAGES; ++i) {
+        auto pixels = make_pixels(WIDTH, HEIGHT, 3, i);
+        images.push_back(dir_ / "images" / std::format("IMG_{:04d}.jpg", i));
+        ASSERT_TRUE(lfs::core::save_img_data(images.back(), {pixels.data(), WIDTH, HEIGHT, 3}));
+    }
+
+    // Cold: decode + resize through OIIO and populate the pack
+    uint64_t cold_sum = 0;
+    const auto cold_start = std::chrono::high_resolution_clock::now();
+    {
+        DecodedImagePack pack(cache_dir(), DecodedImagePack::name_for(dir_ / "images"));
+        for (const auto& path : images) {
+            auto [data, w, h, c] = lfs::core::load_image(path, RESIZE_FACTOR, 0);
+            ASSERT_NE(data, nullptr);
+            cold_sum += touch(data, static_cast<size_t>(w) * h * c);
+            ASSERT_TRUE(pack.insert(path, RESIZE_FACTOR, 0, data, w, h, c));
+            lfs::core::free_image(data);
+        }
+    }
+    const auto cold_end = std::chrono::high_resolution_clock::now();
+
+    // Warm: a fresh run opens the pack and reads every image through the mapping
+    uint64_t warm_sum = 0;
+    const auto warm_start = std::chrono::high_resolution_clock::now();
+    {
+        DecodedImagePack pack(cache_dir(), DecodedImagePack::name_for(dir_ / "images"));
+        for (const auto& path : images) {
+            const auto view = pack.find(path, RESIZE_FACTOR, 0);
+            ASSERT_TRUE(view);
+            warm_sum += touch(view->data, view->size_bytes());
+        }
+        EXPECT_EQ(pack.stats().hits, static_cast<size_t>(NUM_IMAGES));
+    }
+    const auto warm_end = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(cold_sum, warm_sum);
+
+    const double cold_ms = std::chrono::duration<double, std::milli>(cold_end - cold_start).count();
+    const double warm_ms = std::chrono::duration<double, std::milli>(warm_end - warm_start).count();
+    std::cout << "\n=== Decoded image pack: " << NUM_IMAGES << " x " << WIDTH << "x" << HEIGHT
+              << " JPEG, resize_factor " << RESIZE_FACTOR << " ===\n"
+              << "  cold (OIIO decode + resize + append) " << std::fixed << std::setprecision(2)
+              << std::setw(9) << cold_ms / NUM_IMAGES << " ms/image\n"
+              << "  warm (mapped pack)                   " << std::setw(9) << warm_ms / NUM_IMAGES
+              << " ms/image | " << std::setprecision(1) << cold_ms / warm_ms << "x\n";
+    EXPECT_LT(warm_ms, cold_ms);
+}
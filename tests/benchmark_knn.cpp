@@ -0,0 +1,242 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/knn.hpp"
+#include "nanoflann.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    // Dense blobs, uniform background, far outliers and exact duplicates, like a COLMAP sparse cloud
+    Tensor make_points(const size_t n, const uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> uniform(-50.0f, 50.0f);
+        std::normal_distribution<float> blob(0.0f, 2.0f);
+
+        auto points = Tensor::empty({n, 3}, Device::CPU, DataType::Float32);
+        float* const p = points.ptr<float>();
+        for (size_t i = 0; i < n; ++i) {
+            float x, y, z;
+            if (i % 4 == 0) {
+                x = uniform(gen), y = uniform(gen), z = uniform(gen);
+            } else {
+                x = blob(gen) + static_cast<float>(i % 8) * 5.0f;
+                y = blob(gen) * 0.3f;
+                z = blob(gen) - static_cast<float>(i % 8) * 3.0f;
+            }
+            if (i % 1000 == 7) {
+                x *= 200.0f;
+                y *= 300.0f;
+            }
+            p[i * 3 + 0] = x;
+            p[i * 3 + 1] = y;
+            p[i * 3 + 2] = z;
+        }
+        for (size_t i = 0; i + 1 < n; i += 97)
+            std::copy_n(p + i * 3, 3, p + (i + 1) * 3);
+        return points;
+    }
+
+    Tensor make_uniform(const size_t n, const uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+        auto points = Tensor::empty({n, 3}, Device::CPU, DataType::Float32);
+        float* const p = points.ptr<float>();
+        for (size_t i = 0; i < n * 3; ++i)
+            p[i] = uniform(gen);
+        return points;
+    }
+
+    // Sorted squared distances from point q to every other point
+    std::vector<float> brute_force(const Tensor& points, const size_t q, const float min_distance_sq) {
+        const float* const p = points.ptr<float>();
+        std::vector<float> d;
+        for (size_t j = 0; j < points.size(0); ++j) {
+            const float d0 = p[q * 3 + 0] - p[j * 3 + 0];
+            const float d1 = p[q * 3 + 1] - p[j * 3 + 1];
+            const float d2 = p[q * 3 + 2] - p[j * 3 + 2];
+            const float dist = d0 * d0 + d1 * d1 + d2 * d2;
+            if (j != q && dist > min_distance_sq)
+                d.push_back(dist);
+        }
+        std::sort(d.begin(), d.end());
+        return d;
+    }
+
+    void expect_exact(const Tensor& points, const KnnResult& result, const int k, const float min_distance_sq) {
+        ASSERT_EQ(result.indices.dtype(), DataType::Int32);
+        ASSERT_EQ(result.distances_sq.shape(), TensorShape({points.size(0), static_cast<size_t>(k)}));
+        const float* const p = points.ptr<float>();
+        const int32_t* const indices = result.indices.ptr<int32_t>();
+        const float* const distances = result.distances_sq.ptr<float>();
+
+        for (size_t q = 0; q < points.size(0); q += 211) {
+            const auto expected = brute_force(points, q, min_distance_sq);
+            for (int j = 0; j < k; ++j) {
+                ASSERT_FLOAT_EQ(distances[q * k + j], expected[j]) << "point " << q << " neighbor " << j;
+                // The index must point at a neighbor with that distance
+                const int32_t n = indices[q * k + j];
+                ASSERT_GE(n, 0);
+                ASSERT_NE(static_cast<size_t>(n), q);
+                const float d0 = p[q * 3 + 0] - p[n * 3 + 0];
+                const float d1 = p[q * 3 + 1] - p[n * 3 + 1];
+                const float d2 = p[q * 3 + 2] - p[n * 3 + 2];
+                ASSERT_FLOAT_EQ(d0 * d0 + d1 * d1 + d2 * d2, expected[j]);
+            }
+        }
+    }
+
+    // The initializer this module replaced: nanoflann queries split across OpenMP
+    // threads, two heap vectors per point and eps = 10 (approximate)
+    struct LegacyCloud {
+        const float* points;
+        size_t num_points;
+        size_t kdtree_get_point_count() const { return num_points; }
+        float kdtree_get_pt(const size_t idx, const size_t dim) const { return points[idx * 3 + dim]; }
+        template <class BBOX>
+        bool kdtree_get_bbox(BBOX&) const { return false; }
+    };
+
+    std::vector<float> legacy_mean_neighbor_distances(const Tensor& points) {
+        const int num_points = static_cast<int>(points.size(0));
+        const float* data = points.ptr<float>();
+        LegacyCloud cloud{data, static_cast<size_t>(num_points)};
+        nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<float, LegacyCloud>, LegacyCloud, 3>
+            index(3, cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10));
+        index.buildIndex();
+
+        std::vector<float> result(num_points);
+#pragma omp parallel for if (num_points > 1000)
+        for (int i = 0; i < num_points; i++) {
+            const float query_pt[3] = {data[i * 3 + 0], data[i * 3 + 1], data[i * 3 + 2]};
+            const size_t num_results = std::min(4, num_points);
+            std::vector<size_t> ret_indices(num_results);
+            std::vector<float> out_dists_sqr(num_results);
+            nanoflann::KNNResultSet<float> resultSet(num_results);
+            resultSet.init(&ret_indices[0], &out_dists_sqr[0]);
+            index.findNeighbors(resultSet, &query_pt[0], nanoflann::SearchParameters(10));
+
+            float sum_dist = 0.0f;
+            int valid_neighbors = 0;
+            for (size_t j = 0; j < num_results && valid_neighbors < 3; j++) {
+                if (out_dists_sqr[j] > 1e-8f) {
+                    sum_dist += std::sqrt(out_dists_sqr[j]);
+                    valid_neighbors++;
+                }
+            }
+            result[i] = (valid_neighbors > 0) ? (sum_dist / valid_neighbors) : 0.01f;
+        }
+        return result;
+    }
+
+    template <typename F>
+    double time_ms(F&& f) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+} // namespace
+
+TEST(KnnTest, KdTreeMatchesBruteForce) {
+    const auto points = make_points(40'000, 1);
+    for (const int k : {1, 3, 8}) {
+        SCOPED_TRACE(k);
+        expect_exact(points, knn_self(points, k), k, -1.0f);
+    }
+}
+
+TEST(KnnTest, GridMatchesBruteForce) {
+    // Clustered input sends many queries to the tree fallback; both must stay exact
+    for (const auto& points : {make_points(40'000, 2), make_uniform(40'000, 3)}) {
+        for (const int k : {1, 3, 8}) {
+            SCOPED_TRACE(k);
+            expect_exact(points, knn_self(points, k, {.method = KnnMethod::Grid}), k, -1.0f);
+        }
+    }
+}
+
+TEST(KnnTest, MinDistanceSkipsDuplicates) {
+    const auto points = make_points(20'000, 4);
+    for (const auto method : {KnnMethod::KdTree, KnnMethod::Grid}) {
+        const auto result = knn_self(points, 3, {.method = method, .min_distance_sq = 1e-8f});
+        expect_exact(points, result, 3, 1e-8f);
+        // Point 1 is a copy of point 0
+        EXPECT_GT(result.distances_sq.ptr<float>()[0], 1e-8f);
+    }
+}
+
+TEST(KnnTest, PadsWhenTooFewPoints) {
+    const auto points = Tensor::from_vector({0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 2.0f, 0.0f}, TensorShape({3, 3}), Device::CPU);
+    for (const auto method : {KnnMethod::KdTree, KnnMethod::Grid}) {
+        const auto result = knn_self(points, 4, {.method = method});
+        const int32_t* const indices = result.indices.ptr<int32_t>();
+        const float* const distances = result.distances_sq.ptr<float>();
+        EXPECT_EQ(indices[0], 1);
+        EXPECT_FLOAT_EQ(distances[0], 1.0f);
+        EXPECT_EQ(indices[1], 2);
+        EXPECT_FLOAT_EQ(distances[1], 4.0f);
+        EXPECT_EQ(indices[2], -1);
+        EXPECT_EQ(distances[3], std::numeric_limits<float>::infinity());
+    }
+}
+
+TEST(KnnTest, MeanNeighborDistance) {
+    const auto points = make_points(30'000, 5);
+    const auto tree = mean_neighbor_distance(points);
+    const auto grid = mean_neighbor_distance(points, 3, KnnMethod::Grid);
+    ASSERT_EQ(tree.numel(), 30'000u);
+    EXPECT_EQ(tree.device(), Device::CPU);
+
+    for (size_t i = 0; i < 30'000; i += 97) {
+        const auto expected = brute_force(points, i, 1e-8f);
+        const float mean = (std::sqrt(expected[0]) + std::sqrt(expected[1]) + std::sqrt(expected[2])) / 3.0f;
+        EXPECT_NEAR(tree.ptr<float>()[i], mean, 1e-5f * mean) << i;
+        EXPECT_NEAR(grid.ptr<float>()[i], mean, 1e-5f * mean) << i;
+    }
+
+    // Single points and bad input keep the previous behavior
+    const auto one = mean_neighbor_distance(Tensor::zeros({1, 3}, Device::CPU));
+    EXPECT_FLOAT_EQ(one.ptr<float>()[0], 0.01f);
+    EXPECT_FALSE(mean_neighbor_distance(Tensor::zeros({4, 2}, Device::CPU)).is_valid());
+}
+
+TEST(KnnBenchmark, InitialScaleEstimation) {
+    std::cout << "\nmean_neighbor_distance (k = 3):\n"
+              << std::setw(12) << "points" << std::setw(14) << "OpenMP ms" << std::setw(14) << "k-d tree ms"
+              << std::setw(14) << "grid ms" << std::setw(18) << "uniform grid ms" << "\n";
+
+    for (const size_t n : {500'000ul, 2'000'000ul}) {
+        const auto points = make_points(n, 6);
+        const auto uniform = make_uniform(n, 7);
+        std::vector<float> legacy;
+        Tensor tree, grid, uniform_grid;
+
+        const double legacy_ms = time_ms([&] { legacy = legacy_mean_neighbor_distances(points); });
+        const double tree_ms = time_ms([&] { tree = mean_neighbor_distance(points); });
+        const double grid_ms = time_ms([&] { grid = mean_neighbor_distance(points, 3, KnnMethod::Grid); });
+        const double uniform_ms = time_ms([&] { uniform_grid = mean_neighbor_distance(uniform, 3, KnnMethod::Grid); });
+
+        std::cout << std::setw(12) << n << std::fixed << std::setprecision(1)
+                  << std::setw(14) << legacy_ms << std::setw(14) << tree_ms
+                  << std::setw(14) << grid_ms << std::setw(18) << uniform_ms << "\n";
+
+        // The legacy search was approximate (eps = 10); the grid and the tree are exact
+        size_t tighter = 0;
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_FLOAT_EQ(tree.ptr<float>()[i], grid.ptr<float>()[i]) << i;
+            tighter += tree.ptr<float>()[i] < legacy[i] * (1.0f - 1e-5f);
+        }
+        std::cout << "    " << tighter << " points closer than the approximate legacy estimate\n";
+    }
+}
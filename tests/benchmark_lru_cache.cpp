@@ -0,0 +1,175 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "io/lru_cache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace lfs::io;
+
+namespace {
+
+    using Blob = std::shared_ptr<std::vector<uint8_t>>;
+
+    // Previous implementation: unordered_map + timestamp, victim found with a linear scan
+    class LinearScanCache {
+    public:
+        explicit LinearScanCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+        Blob get(const std::string& key) {
+            std::lock_guard lock(mutex_);
+            auto it = map_.find(key);
+            if (it == map_.end())
+                return nullptr;
+            it->second.last_access = std::chrono::steady_clock::now();
+            return it->second.data;
+        }
+
+        void put(const std::string& key, Blob data, size_t size) {
+            std::lock_guard lock(mutex_);
+            while (bytes_ + size > max_bytes_ && !map_.empty()) {
+                auto oldest = std::min_element(map_.begin(), map_.end(),
+                                               [](const auto& a, const auto& b) { return a.second.last_access < b.second.last_access; });
+                bytes_ -= oldest->second.size;
+                map_.erase(oldest);
+            }
+            map_[key] = Entry{std::move(data), std::chrono::steady_clock::now(), size};
+            bytes_ += size;
+        }
+
+    private:
+        struct Entry {
+            Blob data;
+            std::chrono::steady_clock::time_point last_access;
+            size_t size;
+        };
+        std::unordered_map<std::string, Entry> map_;
+        std::mutex mutex_;
+        size_t bytes_ = 0;
+        size_t max_bytes_;
+    };
+
+    std::string image_key(size_t i) {
+        return std::format("/data/dataset/images/IMG_{:06d}.JPG:rf2_mw0", i);
+    }
+
+    // Zipf-like access pattern over a synthetic dataset
+    std::vector<size_t> make_trace(size_t num_images, size_t length, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        std::vector<size_t> trace(length);
+        for (auto& idx : trace) {
+            idx = static_cast<size_t>(std::pow(u(gen), 2.0) * static_cast<double>(num_images));
+        }
+        return trace;
+    }
+
+    template <typename Cache>
+    double run_trace(Cache& cache, const std::vector<size_t>& trace, size_t blob_size) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (size_t idx : trace) {
+            const auto key = image_key(idx);
+            if (!cache.get(key)) {
+                cache.put(key, std::make_shared<std::vector<uint8_t>>(), blob_size);
+            }
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+} // namespace
+
+TEST(ShardedLruCacheTest, EvictsLeastRecentlyUsed) {
+    ShardedLruCache<int> cache(300);
+    cache.put("a", 1, 100);
+    cache.put("b", 2, 100);
+    cache.put("c", 3, 100);
+
+    ASSERT_TRUE(cache.get("a")); // a becomes most recent, b is now LRU
+    cache.put("d", 4, 100);
+
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_FALSE(cache.contains("b"));
+    EXPECT_TRUE(cache.contains("c"));
+    EXPECT_TRUE(cache.contains("d"));
+    EXPECT_EQ(cache.bytes(), 300u);
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.evicted_bytes, 100u);
+}
+
+TEST(ShardedLruCacheTest, ReplaceAndEvictBytesKeepAccounting) {
+    ShardedLruCache<int> cache;
+    for (int i = 0; i < 100; ++i) {
+        cache.put(image_key(i), i, 10);
+    }
+    cache.put(image_key(5), 55, 30); // Replace: +20 bytes, same entry count
+    EXPECT_EQ(cache.size(), 100u);
+    EXPECT_EQ(cache.bytes(), 1020u);
+    EXPECT_EQ(*cache.get(image_key(5)), 55);
+
+    EXPECT_GE(cache.evict_bytes(95), 95u);
+    EXPECT_EQ(cache.size(), 90u);
+    EXPECT_FALSE(cache.contains(image_key(0))); // Oldest went first
+    EXPECT_TRUE(cache.contains(image_key(5)));  // Touched, survives
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.bytes(), 0u);
+    EXPECT_FALSE(cache.get(image_key(5)));
+}
+
+TEST(ShardedLruCacheTest, ConcurrentAccessStaysWithinBudget) {
+    constexpr size_t BUDGET = 500 * 1024;
+    ShardedLruCache<Blob> cache(BUDGET);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            run_trace(cache, make_trace(5000, 20000, t), 1024);
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 8u * 20000u);
+    // Concurrent puts may overshoot by at most one entry each
+    EXPECT_LE(cache.bytes(), BUDGET + 8 * 1024);
+    EXPECT_EQ(stats.entries * 1024, stats.bytes);
+}
+
+TEST(ShardedLruCacheTest, SyntheticDatasetBenchmark) {
+    constexpr size_t BLOB = 256 * 1024; // Typical resized JPEG
+
+    std::cout << "\n=== Image cache eviction: linear scan vs sharded LRU ===\n";
+    for (size_t num_images : {1000, 5000, 10000}) {
+        // Budget holds half the dataset so the cache churns continuously
+        const size_t budget = num_images / 2 * BLOB;
+        const auto trace = make_trace(num_images, 50000, 42);
+
+        LinearScanCache linear(budget);
+        ShardedLruCache<Blob> sharded(budget);
+        const double linear_ms = run_trace(linear, trace, BLOB);
+        const double sharded_ms = run_trace(sharded, trace, BLOB);
+
+        const auto stats = sharded.stats();
+        std::cout << "  " << std::setw(6) << num_images << " images | linear " << std::fixed << std::setprecision(1)
+                  << std::setw(9) << linear_ms << " ms | sharded " << std::setw(7) << sharded_ms << " ms | "
+                  << std::setw(6) << linear_ms / sharded_ms << "x | hit rate "
+                  << 100.0 * stats.hits / (stats.hits + stats.misses) << "%\n";
+        EXPECT_LE(sharded.bytes(), budget);
+    }
+}
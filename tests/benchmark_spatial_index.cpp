@@ -0,0 +1,326 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/spatial_index.hpp"
+#include "core/splat_data.hpp"
+#include "core/splat_data_mirror.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cuda_runtime.h>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    // Clustered points: a few dense blobs plus uniform background, like a captured scene
+    Tensor make_means(size_t n, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> uniform(-50.0f, 50.0f);
+        std::normal_distribution<float> blob(0.0f, 2.0f);
+        std::vector<glm::vec3> centers(8);
+        for (auto& c : centers)
+            c = {uniform(gen), uniform(gen) * 0.2f, uniform(gen)};
+
+        auto means = Tensor::empty({n, 3}, Device::CPU, DataType::Float32);
+        float* const p = means.ptr<float>();
+        for (size_t i = 0; i < n; ++i) {
+            glm::vec3 v;
+            if (i % 4 == 0) {
+                v = {uniform(gen), uniform(gen), uniform(gen)};
+            } else {
+                v = centers[i % centers.size()] + glm::vec3(blob(gen), blob(gen), blob(gen));
+            }
+            p[i * 3 + 0] = v.x;
+            p[i * 3 + 1] = v.y;
+            p[i * 3 + 2] = v.z;
+        }
+        return means;
+    }
+
+    glm::vec3 point(const Tensor& means, size_t i) {
+        const float* const p = means.ptr<float>();
+        return {p[i * 3 + 0], p[i * 3 + 1], p[i * 3 + 2]};
+    }
+
+    template <typename Region>
+    std::vector<bool> brute_force(const Tensor& means, const Region& region) {
+        std::vector<bool> inside(means.size(0));
+        for (size_t i = 0; i < inside.size(); ++i)
+            inside[i] = region.contains(point(means, i));
+        return inside;
+    }
+
+    // Query and mask must both agree with testing every point
+    template <typename Region>
+    void expect_matches(const SpatialIndex& index, const Tensor& means, const Region& region) {
+        const auto expected = brute_force(means, region);
+
+        std::vector<bool> queried(expected.size(), false);
+        for (const uint32_t i : index.query(region)) {
+            ASSERT_LT(i, queried.size());
+            ASSERT_FALSE(queried[i]) << "duplicate index " << i;
+            queried[i] = true;
+        }
+
+        const Tensor mask = index.query_mask(region);
+        ASSERT_EQ(mask.dtype(), DataType::Bool);
+        ASSERT_EQ(mask.numel(), expected.size());
+        size_t count = 0;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(queried[i], expected[i]) << "point " << i;
+            ASSERT_EQ(mask.ptr<bool>()[i], expected[i]) << "point " << i;
+            count += expected[i];
+        }
+        EXPECT_GT(count, 0u);
+        EXPECT_LT(count, expected.size());
+    }
+
+    OrientedBox make_box() {
+        // Rotated, non-uniformly scaled box around one of the blobs
+        glm::mat4 box_to_world = glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, -1.0f, 2.0f));
+        box_to_world = glm::rotate(box_to_world, 0.7f, glm::normalize(glm::vec3(1.0f, 2.0f, -0.5f)));
+        box_to_world = glm::scale(box_to_world, glm::vec3(2.0f, 0.5f, 1.5f));
+        return {glm::inverse(box_to_world), glm::vec3(-10.0f, -8.0f, -6.0f), glm::vec3(12.0f, 8.0f, 9.0f)};
+    }
+
+    Frustum make_frustum() {
+        const glm::mat4 view = glm::lookAt(glm::vec3(-60.0f, 10.0f, -40.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4 proj = glm::perspective(glm::radians(35.0f), 16.0f / 9.0f, 1.0f, 80.0f);
+        return Frustum::from_view_projection(proj * view);
+    }
+
+    template <typename F>
+    double time_ms(F&& f) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // The cropbox path the index replaces: homogeneous transform via mm, then compare
+    Tensor tensor_box_mask(const Tensor& means, const OrientedBox& box) {
+        const auto& m = box.world_to_box;
+        const auto transform = Tensor::from_vector(
+            {m[0][0], m[1][0], m[2][0], m[3][0],
+             m[0][1], m[1][1], m[2][1], m[3][1],
+             m[0][2], m[1][2], m[2][2], m[3][2],
+             m[0][3], m[1][3], m[2][3], m[3][3]},
+            TensorShape({4, 4}), means.device());
+        const auto ones = Tensor::ones({means.size(0), 1}, means.device());
+        const auto local = transform.mm(means.cat(ones, 1).t()).t().slice(1, 0, 3);
+        const auto lo = Tensor::from_vector({box.min.x, box.min.y, box.min.z}, TensorShape({3}), means.device());
+        const auto hi = Tensor::from_vector({box.max.x, box.max.y, box.max.z}, TensorShape({3}), means.device());
+        const auto inside = local.ge(lo.unsqueeze(0)) && local.le(hi.unsqueeze(0));
+        std::vector<int> dims = {1};
+        return inside.all(std::span<const int>(dims), false);
+    }
+
+} // namespace
+
+TEST(SpatialIndexTest, BoxMatchesBruteForce) {
+    const auto means = make_means(200'000, 1);
+    const SpatialIndex index(means);
+    ASSERT_EQ(index.size(), 200'000u);
+    expect_matches(index, means, make_box());
+}
+
+TEST(SpatialIndexTest, SphereMatchesBruteForce) {
+    const auto means = make_means(200'000, 2);
+    const SpatialIndex index(means);
+    expect_matches(index, means, Sphere{point(means, 17), 6.0f});
+    expect_matches(index, means, Sphere{{0.0f, 0.0f, 0.0f}, 30.0f});
+}
+
+TEST(SpatialIndexTest, FrustumMatchesBruteForce) {
+    const auto means = make_means(200'000, 3);
+    const SpatialIndex index(means);
+    expect_matches(index, means, make_frustum());
+}
+
+TEST(SpatialIndexTest, RaycastReturnsNearestWithinRadius) {
+    const auto means = make_means(100'000, 4);
+    const SpatialIndex index(means);
+    constexpr float RADIUS = 0.25f;
+
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> dir(-1.0f, 1.0f);
+    for (int ray = 0; ray < 50; ++ray) {
+        const glm::vec3 origin(dir(gen) * 80.0f, dir(gen) * 80.0f, dir(gen) * 80.0f);
+        // Aim at a known point so most rays hit something
+        const glm::vec3 direction = point(means, ray * 997) - origin;
+        const glm::vec3 d = glm::normalize(direction);
+
+        std::optional<RayHit> expected;
+        for (size_t i = 0; i < means.size(0); ++i) {
+            const glm::vec3 v = point(means, i) - origin;
+            const float t = glm::dot(v, d);
+            const float perp2 = std::max(glm::dot(v, v) - t * t, 0.0f);
+            if (t >= 0.0f && perp2 <= RADIUS * RADIUS && (!expected || t < expected->t))
+                expected = RayHit{static_cast<uint32_t>(i), t, std::sqrt(perp2)};
+        }
+
+        const auto hit = index.raycast(origin, direction, RADIUS);
+        ASSERT_EQ(hit.has_value(), expected.has_value()) << "ray " << ray;
+        if (hit) {
+            EXPECT_NEAR(hit->t, expected->t, 1e-3f) << "ray " << ray;
+            EXPECT_LE(hit->distance, RADIUS);
+        }
+    }
+
+    EXPECT_FALSE(index.raycast({0.0f, 1000.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, RADIUS).has_value());
+}
+
+TEST(SpatialIndexTest, RefitTracksMovedPoints) {
+    auto means = make_means(100'000, 6);
+    SpatialIndex index(means);
+    const size_t nodes = index.node_count();
+
+    float* const p = means.ptr<float>();
+    for (size_t i = 0; i < means.numel(); ++i)
+        p[i] = p[i] * 1.5f + 4.0f;
+
+    ASSERT_TRUE(index.refit(means));
+    EXPECT_EQ(index.node_count(), nodes);
+    expect_matches(index, means, Sphere{point(means, 3), 8.0f});
+    expect_matches(index, means, make_box());
+
+    EXPECT_FALSE(index.refit(make_means(10, 7)));
+}
+
+TEST(SpatialIndexTest, SmallAndEmptyInputs) {
+    const auto means = make_means(5, 8);
+    const SpatialIndex index(means);
+    EXPECT_EQ(index.node_count(), 1u);
+    EXPECT_EQ(index.query(Sphere{{0.0f, 0.0f, 0.0f}, 1000.0f}).size(), 5u);
+
+    const SpatialIndex empty(Tensor::empty({0, 3}, Device::CPU, DataType::Float32));
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.query(make_box()).empty());
+    EXPECT_EQ(empty.query_mask(make_box()).numel(), 0u);
+    EXPECT_FALSE(empty.raycast({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 1.0f).has_value());
+}
+
+TEST(SpatialIndexTest, SplatDataKeepsIndexInSync) {
+    constexpr size_t N = 50'000;
+    SplatData splat(0, make_means(N, 9),
+                    Tensor::zeros({N, 1, 3}, Device::CPU, DataType::Float32), Tensor{},
+                    Tensor::zeros({N, 3}, Device::CPU, DataType::Float32),
+                    Tensor::zeros({N, 4}, Device::CPU, DataType::Float32),
+                    Tensor::zeros({N, 1}, Device::CPU, DataType::Float32), 1.0f);
+
+    const SpatialIndex* const first = &splat.spatial_index();
+    EXPECT_EQ(&splat.spatial_index(), first); // Cached while means are untouched
+    EXPECT_EQ(first->size(), N);
+
+    // In-place move: refit on the next query
+    float* const p = splat.means().ptr<float>();
+    for (size_t i = 0; i < N * 3; ++i)
+        p[i] += 100.0f;
+    splat.mark_positions_changed();
+    expect_matches(splat.spatial_index(), splat.means(), Sphere{point(splat.means(), 0), 5.0f});
+
+    // Replaced means with a different count: rebuild
+    splat.means() = make_means(N / 2, 10);
+    EXPECT_EQ(splat.spatial_index().size(), N / 2);
+    expect_matches(splat.spatial_index(), splat.means(), make_box());
+}
+
+TEST(SpatialIndexTest, CudaBoxMaskMatchesHost) {
+    const auto means = make_means(200'000, 11);
+    const SpatialIndex index(means.to(Device::CUDA));
+
+    // Rotated box, a box whose faces pass exactly through a point, and boxes
+    // where every leaf is inside or outside
+    const glm::vec3 corner = point(means, 7);
+    const std::vector<OrientedBox> boxes = {
+        make_box(),
+        {glm::mat4(1.0f), corner, corner + glm::vec3(20.0f)},
+        {glm::mat4(1.0f), glm::vec3(-1000.0f), glm::vec3(1000.0f)},
+        {glm::mat4(1.0f), glm::vec3(500.0f), glm::vec3(600.0f)},
+    };
+    for (const auto& box : boxes) {
+        const auto expected = brute_force(means, box);
+        const Tensor mask = index.query_mask(box, Device::CUDA);
+        ASSERT_EQ(mask.device(), Device::CUDA);
+        ASSERT_EQ(mask.numel(), expected.size());
+        const Tensor host = mask.cpu();
+        for (size_t i = 0; i < expected.size(); ++i)
+            ASSERT_EQ(host.ptr<bool>()[i], expected[i]) << "point " << i;
+    }
+}
+
+TEST(SpatialIndexTest, CentroidFollowsRefitAndServesSelectionCenter) {
+    constexpr size_t N = 20'000;
+    SplatData splat(0, make_means(N, 12),
+                    Tensor::zeros({N, 1, 3}, Device::CPU, DataType::Float32), Tensor{},
+                    Tensor::zeros({N, 3}, Device::CPU, DataType::Float32),
+                    Tensor::zeros({N, 4}, Device::CPU, DataType::Float32),
+                    Tensor::zeros({N, 1}, Device::CPU, DataType::Float32), 1.0f);
+    const auto all = Tensor::ones({N}, Device::CPU, DataType::UInt8);
+    const glm::vec3 brute = compute_selection_center(splat, all); // No index yet: masked sum
+    EXPECT_FALSE(splat.has_spatial_index());
+
+    const glm::vec3 centroid = splat.spatial_index().centroid();
+    EXPECT_TRUE(splat.has_spatial_index());
+    EXPECT_NEAR(glm::distance(centroid, brute), 0.0f, 1e-3f);
+    EXPECT_EQ(compute_selection_center(splat, all), centroid);
+
+    float* const p = splat.means().ptr<float>();
+    for (size_t i = 0; i < N * 3; ++i)
+        p[i] += 10.0f;
+    splat.mark_positions_changed();
+    EXPECT_FALSE(splat.has_spatial_index());
+    EXPECT_NEAR(glm::distance(splat.spatial_index().centroid(), centroid + glm::vec3(10.0f)), 0.0f, 1e-3f);
+}
+
+TEST(SpatialIndexTest, LargeSceneBenchmark) {
+    const auto box = make_box();
+    const auto sphere = Sphere{{5.0f, 0.0f, 5.0f}, 10.0f};
+    const auto frustum = make_frustum();
+
+    std::cout << "\n=== SpatialIndex vs brute force (host, and CUDA box) ===\n"
+              << std::fixed << std::setprecision(1);
+    for (const size_t n : {1'000'000ul, 5'000'000ul, 10'000'000ul}) {
+        const auto means = make_means(n, 11);
+
+        std::unique_ptr<SpatialIndex> index;
+        const double build_ms = time_ms([&] { index = std::make_unique<SpatialIndex>(means); });
+
+        Tensor indexed, brute;
+        const double box_index_ms = time_ms([&] { indexed = index->query_mask(box); });
+        const double box_brute_ms = time_ms([&] { brute = tensor_box_mask(means, box); });
+        ASSERT_EQ(indexed.sum_scalar(), brute.sum_scalar());
+
+        std::vector<bool> expected;
+        const double sphere_index_ms = time_ms([&] { indexed = index->query_mask(sphere); });
+        const double sphere_brute_ms = time_ms([&] { expected = brute_force(means, sphere); });
+        const double frustum_index_ms = time_ms([&] { indexed = index->query_mask(frustum); });
+        const double frustum_brute_ms = time_ms([&] { expected = brute_force(means, frustum); });
+
+        // Device-resident means: first query uploads the index, later ones only traverse
+        const auto device_means = means.to(Device::CUDA);
+        ASSERT_EQ(index->query_mask(box, Device::CUDA).sum_scalar(), brute.sum_scalar());
+        const double box_cuda_index_ms = time_ms([&] {
+            indexed = index->query_mask(box, Device::CUDA);
+            cudaDeviceSynchronize();
+        });
+        const double box_cuda_brute_ms = time_ms([&] {
+            brute = tensor_box_mask(device_means, box);
+            cudaDeviceSynchronize();
+        });
+
+        std::cout << "  " << std::setw(9) << n << " points | build " << std::setw(7) << build_ms << " ms"
+                  << " | box " << box_index_ms << " vs " << box_brute_ms << " ms"
+                  << " | sphere " << sphere_index_ms << " vs " << sphere_brute_ms << " ms"
+                  << " | frustum " << frustum_index_ms << " vs " << frustum_brute_ms << " ms"
+                  << " | box (CUDA) " << box_cuda_index_ms << " vs " << box_cuda_brute_ms << " ms\n";
+    }
+}
@@ -0,0 +1,254 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/splat_data.hpp"
+#include "core/splat_data_transform.hpp"
+#include <chrono>
+#include <cmath>
+#include <cuda_runtime.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    constexpr int SH_DEGREE = 3;
+    constexpr size_t SH_REST = 15;
+
+    Tensor random_tensor(const std::vector<size_t>& shape, std::mt19937& gen, const float lo, const float hi) {
+        size_t count = 1;
+        for (const size_t s : shape)
+            count *= s;
+        std::uniform_real_distribution<float> dist(lo, hi);
+        std::vector<float> data(count);
+        for (auto& v : data)
+            v = dist(gen);
+        return Tensor::from_vector(data, TensorShape(shape), Device::CPU);
+    }
+
+    // Initial scene scale is tiny so both paths always overwrite it with the new median
+    SplatData make_splats(const size_t n, const Device device, const uint32_t seed) {
+        std::mt19937 gen(seed);
+        auto means = random_tensor({n, 3}, gen, -20.0f, 20.0f);
+        auto rotation = random_tensor({n, 4}, gen, -1.0f, 1.0f);
+        float* const q = rotation.ptr<float>();
+        for (size_t i = 0; i < n; ++i) {
+            const float len = std::sqrt(q[i * 4] * q[i * 4] + q[i * 4 + 1] * q[i * 4 + 1] +
+                                        q[i * 4 + 2] * q[i * 4 + 2] + q[i * 4 + 3] * q[i * 4 + 3]);
+            for (int k = 0; k < 4; ++k)
+                q[i * 4 + k] /= len;
+        }
+        return SplatData(SH_DEGREE,
+                         means.to(device),
+                         random_tensor({n, 1, 3}, gen, -1.0f, 1.0f).to(device),
+                         random_tensor({n, SH_REST, 3}, gen, -0.5f, 0.5f).to(device),
+                         random_tensor({n, 3}, gen, -5.0f, -1.0f).to(device),
+                         rotation.to(device),
+                         random_tensor({n, 1}, gen, -2.0f, 2.0f).to(device),
+                         1e-6f);
+    }
+
+    glm::mat4 make_transform() {
+        glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, -2.0f, 7.5f));
+        m = glm::rotate(m, glm::radians(37.0f), glm::normalize(glm::vec3(0.3f, 1.0f, -0.4f)));
+        return glm::scale(m, glm::vec3(1.7f));
+    }
+
+    // The tensor-op implementation this replaced, kept as the reference and benchmark baseline;
+    // returns the scene scale it computed
+    float legacy_transform(SplatData& splat_data, const glm::mat4& transform_matrix) {
+        const int num_points = splat_data.means_raw().size(0);
+        const auto device = splat_data.means_raw().device();
+
+        const std::vector<float> transform_data = {
+            transform_matrix[0][0], transform_matrix[1][0], transform_matrix[2][0], transform_matrix[3][0],
+            transform_matrix[0][1], transform_matrix[1][1], transform_matrix[2][1], transform_matrix[3][1],
+            transform_matrix[0][2], transform_matrix[1][2], transform_matrix[2][2], transform_matrix[3][2],
+            transform_matrix[0][3], transform_matrix[1][3], transform_matrix[2][3], transform_matrix[3][3]};
+        const auto transform_tensor = Tensor::from_vector(transform_data, TensorShape({4, 4}), device);
+        const auto ones = Tensor::ones({static_cast<size_t>(num_points), 1}, device);
+        const auto means_homo = splat_data.means_raw().cat(ones, 1);
+        splat_data.means_raw() = transform_tensor.mm(means_homo.t()).t().slice(1, 0, 3).contiguous();
+
+        glm::mat3 rot_mat(transform_matrix);
+        glm::vec3 scale;
+        for (int i = 0; i < 3; ++i) {
+            scale[i] = glm::length(rot_mat[i]);
+            rot_mat[i] /= scale[i];
+        }
+        const glm::quat rotation_quat = glm::quat_cast(rot_mat);
+
+        const std::vector<float> rot_data = {rotation_quat.w, rotation_quat.x, rotation_quat.y, rotation_quat.z};
+        const auto rot_tensor = Tensor::from_vector(rot_data, TensorShape({4}), device);
+        const auto q = splat_data.rotation_raw();
+        const std::vector<int> expand_shape = {num_points, 4};
+        const auto q_rot = rot_tensor.unsqueeze(0).expand(std::span<const int>(expand_shape));
+        const auto w1 = q_rot.slice(1, 0, 1).squeeze(1), x1 = q_rot.slice(1, 1, 2).squeeze(1);
+        const auto y1 = q_rot.slice(1, 2, 3).squeeze(1), z1 = q_rot.slice(1, 3, 4).squeeze(1);
+        const auto w2 = q.slice(1, 0, 1).squeeze(1), x2 = q.slice(1, 1, 2).squeeze(1);
+        const auto y2 = q.slice(1, 2, 3).squeeze(1), z2 = q.slice(1, 3, 4).squeeze(1);
+        std::vector<Tensor> components = {
+            w1.mul(w2).sub(x1.mul(x2)).sub(y1.mul(y2)).sub(z1.mul(z2)).unsqueeze(1),
+            w1.mul(x2).add(x1.mul(w2)).add(y1.mul(z2)).sub(z1.mul(y2)).unsqueeze(1),
+            w1.mul(y2).sub(x1.mul(z2)).add(y1.mul(w2)).add(z1.mul(x2)).unsqueeze(1),
+            w1.mul(z2).add(x1.mul(y2)).sub(y1.mul(x2)).add(z1.mul(w2)).unsqueeze(1)};
+        splat_data.rotation_raw() = Tensor::cat(components, 1);
+
+        splat_data.scaling_raw() = splat_data.scaling_raw().add(std::log((scale.x + scale.y + scale.z) / 3.0f));
+
+        const Tensor center = splat_data.means_raw().mean({0}, false);
+        const Tensor dists = splat_data.means_raw().sub(center).norm(2.0f, {1}, false);
+        return dists.sort(0, false).first[num_points / 2].item();
+    }
+
+    // Degree 1-3 part of the rasterizer's SH evaluation for one channel
+    float eval_sh_rest(const float* coeffs, const glm::vec3& dir) {
+        const float x = dir.x, y = dir.y, z = dir.z;
+        const float z2 = z * z, fC1 = x * x - y * y, fS1 = 2.f * x * y;
+        const float fTmp0B = -1.092548430592079f * z;
+        const float fTmp0C = -2.285228997322329f * z2 + 0.4570457994644658f;
+        const float fTmp1B = 1.445305721320277f * z;
+        const float fC2 = x * fC1 - y * fS1, fS2 = x * fS1 + y * fC1;
+        const float basis[SH_REST] = {
+            -0.48860251190292f * y, 0.48860251190292f * z, -0.48860251190292f * x,
+            0.5462742152960395f * fS1, fTmp0B * y, 0.9461746957575601f * z2 - 0.3153915652525201f,
+            fTmp0B * x, 0.5462742152960395f * fC1,
+            -0.5900435899266435f * fS2, fTmp1B * fS1, fTmp0C * y,
+            z * (1.865881662950577f * z2 - 1.119528997770346f), fTmp0C * x, fTmp1B * fC1,
+            -0.5900435899266435f * fC2};
+        float result = 0.0f;
+        for (size_t k = 0; k < SH_REST; ++k)
+            result += basis[k] * coeffs[k * 3];
+        return result;
+    }
+
+    void expect_close(const Tensor& a, const Tensor& b, const float tol, const char* what) {
+        const auto ca = a.cpu().contiguous();
+        const auto cb = b.cpu().contiguous();
+        ASSERT_EQ(ca.numel(), cb.numel()) << what;
+        const float* const pa = ca.ptr<float>();
+        const float* const pb = cb.ptr<float>();
+        float max_err = 0.0f;
+        for (size_t i = 0; i < ca.numel(); ++i)
+            max_err = std::max(max_err, std::abs(pa[i] - pb[i]));
+        EXPECT_LT(max_err, tol) << what;
+    }
+
+    void check_against_legacy(const Device device) {
+        constexpr size_t N = 20'001;
+        const glm::mat4 m = make_transform();
+        auto fused = make_splats(N, device, 3);
+        auto legacy = make_splats(N, device, 3);
+
+        transform(fused, m);
+        const float legacy_scale = legacy_transform(legacy, m);
+
+        expect_close(fused.means_raw(), legacy.means_raw(), 1e-3f, "means");
+        expect_close(fused.rotation_raw(), legacy.rotation_raw(), 1e-5f, "rotation");
+        expect_close(fused.scaling_raw(), legacy.scaling_raw(), 1e-5f, "scaling");
+        EXPECT_NEAR(fused.get_scene_scale(), legacy_scale, 1e-4f * legacy_scale);
+    }
+
+    void check_sh_rotation(const Device device) {
+        // Not a multiple of the CPU's 8-gaussian SH blocks, so the per-gaussian tail runs too
+        constexpr size_t N = 67;
+        const glm::mat4 m = make_transform();
+        auto splats = make_splats(N, device, 11);
+        const auto before = splats.shN_raw().cpu().contiguous();
+        transform(splats, m);
+        const auto after = splats.shN_raw().cpu().contiguous();
+
+        // Color seen from R d after the transform equals color seen from d before it
+        const glm::mat3 R = glm::mat3_cast(glm::quat_cast(glm::mat3(glm::scale(m, glm::vec3(1.0f / 1.7f)))));
+        std::mt19937 gen(5);
+        std::normal_distribution<float> normal;
+        float max_err = 0.0f;
+        for (size_t i = 0; i < N; ++i) {
+            for (int trial = 0; trial < 8; ++trial) {
+                const glm::vec3 d = glm::normalize(glm::vec3(normal(gen), normal(gen), normal(gen)));
+                for (int c = 0; c < 3; ++c) {
+                    const float old_color = eval_sh_rest(before.ptr<float>() + i * SH_REST * 3 + c, d);
+                    const float new_color = eval_sh_rest(after.ptr<float>() + i * SH_REST * 3 + c, R * d);
+                    max_err = std::max(max_err, std::abs(old_color - new_color));
+                }
+            }
+        }
+        EXPECT_LT(max_err, 1e-4f);
+    }
+
+    bool has_cuda() {
+        int count = 0;
+        return cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+    }
+
+} // namespace
+
+TEST(SplatTransformTest, MatchesLegacyCpu) {
+    check_against_legacy(Device::CPU);
+}
+
+TEST(SplatTransformTest, MatchesLegacyCuda) {
+    if (!has_cuda())
+        GTEST_SKIP() << "No CUDA device";
+    check_against_legacy(Device::CUDA);
+}
+
+TEST(SplatTransformTest, RotatesShCpu) {
+    check_sh_rotation(Device::CPU);
+}
+
+TEST(SplatTransformTest, RotatesShCuda) {
+    if (!has_cuda())
+        GTEST_SKIP() << "No CUDA device";
+    check_sh_rotation(Device::CUDA);
+}
+
+TEST(SplatTransformTest, TranslationLeavesShAndRotation) {
+    auto splats = make_splats(1000, Device::CPU, 7);
+    const auto rotation = splats.rotation_raw().clone();
+    const auto shN = splats.shN_raw().clone();
+    transform(splats, glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f)));
+    expect_close(splats.rotation_raw(), rotation, 1e-12f, "rotation");
+    expect_close(splats.shN_raw(), shN, 1e-12f, "shN");
+}
+
+TEST(SplatTransformBenchmark, FusedVersusTensorOps) {
+    const glm::mat4 m = make_transform();
+    std::cout << "\n"
+              << std::setw(8) << "device" << std::setw(12) << "gaussians"
+              << std::setw(14) << "legacy ms" << std::setw(14) << "fused ms" << std::setw(10) << "speedup\n";
+
+    for (const Device device : {Device::CPU, Device::CUDA}) {
+        if (device == Device::CUDA && !has_cuda())
+            continue;
+        for (const size_t n : {size_t{100'000}, size_t{1'000'000}}) {
+            auto fused = make_splats(n, device, 1);
+            auto legacy = make_splats(n, device, 1);
+
+            const auto time_ms = [&](auto&& fn) {
+                fn(); // Warm up allocator and kernels
+                cudaDeviceSynchronize();
+                constexpr int REPEATS = 5;
+                const auto start = std::chrono::steady_clock::now();
+                for (int r = 0; r < REPEATS; ++r)
+                    fn();
+                cudaDeviceSynchronize();
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / REPEATS;
+            };
+            const double legacy_ms = time_ms([&] { legacy_transform(legacy, m); });
+            const double fused_ms = time_ms([&] { transform(fused, m); });
+
+            std::cout << std::setw(8) << (device == Device::CUDA ? "cuda" : "cpu") << std::setw(12) << n
+                      << std::setw(14) << std::fixed << std::setprecision(2) << legacy_ms
+                      << std::setw(14) << fused_ms << std::setw(9) << legacy_ms / fused_ms << "x\n";
+            EXPECT_LT(fused_ms, legacy_ms);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include <chrono>
+#include <cuda_runtime.h>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    constexpr size_t N = 10'000'000;
+    // Sparsity pruning at a typical prune_ratio
+    constexpr float PRUNE_RATIO = 0.6f;
+
+    bool has_cuda() {
+        int count = 0;
+        return cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+    }
+
+    Tensor make_values(const size_t n, const Device device) {
+        std::mt19937 gen(42);
+        std::normal_distribution<float> dist(0.0f, 1.0f);
+        std::vector<float> v(n);
+        for (auto& x : v)
+            x = dist(gen);
+        return Tensor::from_vector(v, {n}, device);
+    }
+
+    template <typename Fn>
+    double time_ms(Fn&& fn) {
+        fn(); // Warm up allocator and kernels
+        cudaDeviceSynchronize();
+        constexpr int REPEATS = 3;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEATS; ++r)
+            fn();
+        cudaDeviceSynchronize();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / REPEATS;
+    }
+
+    void print_row(const Device device, const char* op, const double sort_ms, const double select_ms) {
+        std::cout << std::setw(8) << (device == Device::CUDA ? "cuda" : "cpu") << std::setw(14) << op
+                  << std::setw(14) << std::fixed << std::setprecision(2) << sort_ms
+                  << std::setw(14) << select_ms << std::setw(9) << sort_ms / select_ms << "x\n";
+    }
+
+} // namespace
+
+TEST(TensorSelectBenchmark, SelectVersusFullSort) {
+    std::cout << "\n"
+              << std::setw(8) << "device" << std::setw(14) << "op"
+              << std::setw(14) << "sort ms" << std::setw(14) << "select ms" << std::setw(10) << "speedup\n";
+
+    const size_t k = static_cast<size_t>(PRUNE_RATIO * N);
+    for (const Device device : {Device::CPU, Device::CUDA}) {
+        if (device == Device::CUDA && !has_cuda())
+            continue;
+        const auto values = make_values(N, device);
+
+        // Baselines read the same answers out of a full sort
+        const double sort_ms = time_ms([&] { (void)values.sort(0, false); });
+        const double kth_ms = time_ms([&] { (void)values.kthvalue(k, 0); });
+        const double quantile_ms = time_ms([&] { (void)values.quantile(0.5f, 0); });
+        const double topk_ms = time_ms([&] { (void)values.topk(k, 0, false, false); });
+        const double argpartition_ms = time_ms([&] { (void)values.argpartition(k, 0); });
+
+        print_row(device, "kthvalue", sort_ms, kth_ms);
+        print_row(device, "quantile", sort_ms, quantile_ms);
+        print_row(device, "topk", sort_ms, topk_ms);
+        print_row(device, "argpartition", sort_ms, argpartition_ms);
+
+        EXPECT_LT(kth_ms, sort_ms);
+        EXPECT_LT(quantile_ms, sort_ms);
+
+        const float threshold = values.kthvalue(k, 0).first.item();
+        const float sorted_threshold = values.sort(0, false).first.slice(0, k - 1, k).item();
+        EXPECT_EQ(threshold, sorted_threshold);
+    }
+}
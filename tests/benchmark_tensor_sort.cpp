@@ -0,0 +1,106 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    // A large scene's worth of splats
+    constexpr size_t N = 5'000'000;
+
+    template <typename Fn>
+    double time_ms(Fn&& fn) {
+        fn(); // Warm up allocations
+        constexpr int REPEATS = 3;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEATS; ++r)
+            fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / REPEATS;
+    }
+
+    void print_row(const char* op, const double baseline_ms, const double tensor_ms) {
+        std::cout << std::setw(16) << op << std::setw(14) << std::fixed << std::setprecision(2) << baseline_ms
+                  << std::setw(14) << tensor_ms << std::setw(9) << baseline_ms / tensor_ms << "x\n";
+    }
+
+} // namespace
+
+TEST(TensorSortBenchmark, CpuOpsVersusSerialBaselines) {
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<float> depth_dist(0.1f, 100.0f);
+    std::vector<float> depths(N);
+    for (auto& d : depths)
+        d = depth_dist(gen);
+
+    // 30-bit Morton-like codes with duplicates, as produced for spatial ordering
+    auto codes = Tensor::empty({N}, Device::CPU, DataType::Int64);
+    int64_t* const code_ptr = codes.ptr<int64_t>();
+    for (size_t i = 0; i < N; ++i)
+        code_ptr[i] = static_cast<int64_t>(gen() & ((int64_t{1} << 30) - 1)) >> 4;
+
+    const auto depth_tensor = Tensor::from_vector(depths, {N}, Device::CPU);
+    const auto mask = depth_tensor > 50.0f;
+
+    std::cout << "\n"
+              << std::setw(16) << "op" << std::setw(14) << "baseline ms" << std::setw(14) << "tensor ms"
+              << std::setw(10) << "speedup\n";
+
+    // Baseline: the previous std::sort over indices with a comparator lambda
+    const double float_baseline = time_ms([&] {
+        std::vector<size_t> idx(N);
+        std::iota(idx.begin(), idx.end(), size_t{0});
+        std::sort(idx.begin(), idx.end(), [&](const size_t a, const size_t b) { return depths[a] < depths[b]; });
+    });
+    print_row("sort float", float_baseline, time_ms([&] { (void)depth_tensor.sort(0); }));
+    print_row("argsort float", float_baseline, time_ms([&] { (void)depth_tensor.argsort(0); }));
+
+    const double code_baseline = time_ms([&] {
+        std::vector<size_t> idx(N);
+        std::iota(idx.begin(), idx.end(), size_t{0});
+        std::stable_sort(idx.begin(), idx.end(),
+                         [&](const size_t a, const size_t b) { return code_ptr[a] < code_ptr[b]; });
+    });
+    print_row("argsort int64", code_baseline, time_ms([&] { (void)codes.argsort(0); }));
+
+    const double unique_baseline = time_ms([&] {
+        std::vector<int64_t> sorted(code_ptr, code_ptr + N);
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    });
+    print_row("unique int64", unique_baseline, time_ms([&] { (void)codes.unique(); }));
+
+    const unsigned char* const mask_ptr = mask.ptr<unsigned char>();
+    const double nonzero_baseline = time_ms([&] {
+        std::vector<int64_t> out;
+        out.reserve(N);
+        for (size_t i = 0; i < N; ++i) {
+            if (mask_ptr[i])
+                out.push_back(static_cast<int64_t>(i));
+        }
+    });
+    print_row("nonzero", nonzero_baseline, time_ms([&] { (void)mask.nonzero(); }));
+
+    const double masked_baseline = time_ms([&] {
+        std::vector<float> out;
+        out.reserve(N);
+        for (size_t i = 0; i < N; ++i) {
+            if (mask_ptr[i])
+                out.push_back(depths[i]);
+        }
+    });
+    print_row("masked_select", masked_baseline, time_ms([&] { (void)depth_tensor.masked_select(mask); }));
+
+    const auto order = depth_tensor.argsort(0).to_vector_int64();
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end(),
+                               [&](const int64_t a, const int64_t b) { return depths[a] < depths[b]; }));
+}
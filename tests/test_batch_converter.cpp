@@ -0,0 +1,162 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/converter.hpp"
+#include "core/splat_data.hpp"
+#include "io/exporter.hpp"
+#include "io/loader.hpp"
+#include <filesystem>
+#include <format>
+#include <gtest/gtest.h>
+
+using namespace lfs::core;
+namespace fs = std::filesystem;
+
+namespace {
+
+    SplatData make_splat(size_t n, float offset) {
+        auto means = Tensor::empty({n, 3}, Device::CPU, DataType::Float32);
+        auto sh0 = Tensor::zeros({n, 1, 3}, Device::CPU, DataType::Float32);
+        auto shN = Tensor::full({n, 15, 3}, 0.05f, Device::CPU, DataType::Float32);
+        auto scaling = Tensor::full({n, 3}, -3.0f, Device::CPU, DataType::Float32);
+        auto rotation = Tensor::zeros({n, 4}, Device::CPU, DataType::Float32);
+        auto opacity = Tensor::zeros({n, 1}, Device::CPU, DataType::Float32);
+        for (size_t i = 0; i < n; ++i) {
+            means.ptr<float>()[i * 3 + 0] = offset + static_cast<float>(i);
+            means.ptr<float>()[i * 3 + 1] = 0.5f * static_cast<float>(i);
+            means.ptr<float>()[i * 3 + 2] = -1.0f;
+            rotation.ptr<float>()[i * 4] = 1.0f;
+        }
+        return SplatData(3, std::move(means), std::move(sh0), std::move(shN),
+                         std::move(scaling), std::move(rotation), std::move(opacity), 0.5f);
+    }
+
+} // namespace
+
+class BatchConverterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / std::format("lfs_batch_converter_test_{}", ::testing::UnitTest::GetInstance()->random_seed());
+        fs::remove_all(dir_);
+        fs::create_directories(dir_ / "in");
+        fs::create_directories(dir_ / "out");
+        for (size_t i = 0; i < NUM_FILES; ++i) {
+            const auto path = dir_ / "in" / std::format("scan_{:02d}.ply", i);
+            ASSERT_TRUE(lfs::io::save_ply(make_splat(100 + 10 * i, static_cast<float>(i)), {.output_path = path}));
+        }
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir_);
+    }
+
+    static constexpr size_t NUM_FILES = 12;
+    fs::path dir_;
+};
+
+TEST_F(BatchConverterTest, ConvertsDirectoryConcurrently) {
+    param::ConvertParameters params;
+    params.input_path = dir_ / "in";
+    params.output_path = dir_ / "out";
+    params.format = param::OutputFormat::PLY;
+    params.sh_degree = 1;
+    params.overwrite = true;
+    params.jobs = 4;
+    ASSERT_EQ(run_converter(params), 0);
+
+    const auto loader = lfs::io::Loader::create();
+    for (size_t i = 0; i < NUM_FILES; ++i) {
+        const auto output = dir_ / "out" / std::format("scan_{:02d}_converted.ply", i);
+        ASSERT_TRUE(fs::exists(output)) << output;
+
+        auto result = loader->load(output, {.device = Device::CPU});
+        ASSERT_TRUE(result.has_value());
+        const auto& splat = *std::get<std::shared_ptr<SplatData>>(result->data);
+        EXPECT_EQ(splat.size(), 100 + 10 * i);
+        EXPECT_EQ(splat.get_max_sh_degree(), 1);
+        EXPECT_FLOAT_EQ(splat.means_raw().ptr<float>()[0], static_cast<float>(i)); // Each output came from its own input
+    }
+}
+
+TEST_F(BatchConverterTest, SingleJobMatchesParallel) {
+    param::ConvertParameters params;
+    params.input_path = dir_ / "in";
+    params.output_path = dir_ / "out";
+    params.format = param::OutputFormat::SPZ;
+    params.overwrite = true;
+
+    params.jobs = 1;
+    ASSERT_EQ(run_converter(params), 0);
+    std::vector<uintmax_t> serial_sizes;
+    for (size_t i = 0; i < NUM_FILES; ++i) {
+        serial_sizes.push_back(fs::file_size(dir_ / "out" / std::format("scan_{:02d}_converted.spz", i)));
+    }
+
+    params.jobs = 8;
+    ASSERT_EQ(run_converter(params), 0);
+    for (size_t i = 0; i < NUM_FILES; ++i) {
+        EXPECT_EQ(fs::file_size(dir_ / "out" / std::format("scan_{:02d}_converted.spz", i)), serial_sizes[i]);
+    }
+}
+
+TEST_F(BatchConverterTest, CollidingOutputsFailInsteadOfRacing) {
+    param::ConvertParameters params;
+    params.input_path = dir_ / "in";
+    params.output_path = dir_ / "out" / "merged.ply"; // Every input maps to the same file
+    params.format = param::OutputFormat::PLY;
+    params.overwrite = true;
+    params.jobs = 4;
+
+    EXPECT_EQ(run_converter(params), 1);
+    EXPECT_TRUE(fs::exists(params.output_path));
+}
+
+TEST_F(BatchConverterTest, UnreadableInputIsCountedAsFailure) {
+    fs::resize_file(dir_ / "in" / "scan_03.ply", 64);
+
+    param::ConvertParameters params;
+    params.input_path = dir_ / "in";
+    params.output_path = dir_ / "out";
+    params.format = param::OutputFormat::PLY;
+    params.overwrite = true;
+    params.jobs = 3;
+
+    EXPECT_EQ(run_converter(params), 1);
+    EXPECT_FALSE(fs::exists(dir_ / "out" / "scan_03_converted.ply"));
+    EXPECT_TRUE(fs::exists(dir_ / "out" / "scan_04_converted.ply"));
+}
+
+TEST_F(BatchConverterTest, CpuSogConvertsWithLimitedWriters) {
+    param::ConvertParameters params;
+    params.input_path = dir_ / "in";
+    params.output_path = dir_ / "out";
+    params.format = param::OutputFormat::SOG;
+    params.sog_iterations = 2;
+    params.overwrite = true;
+    params.use_gpu = false;
+    params.jobs = 4;
+    params.writers = 2;
+    ASSERT_EQ(run_converter(params), 0);
+
+    const auto loader = lfs::io::Loader::create();
+    for (size_t i = 0; i < NUM_FILES; ++i) {
+        const auto output = dir_ / "out" / std::format("scan_{:02d}_converted.sog", i);
+        ASSERT_TRUE(fs::exists(output)) << output;
+
+        auto result = loader->load(output, {.device = Device::CPU});
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(std::get<std::shared_ptr<SplatData>>(result->data)->size(), 100 + 10 * i);
+    }
+}
+
+TEST_F(BatchConverterTest, CpuHtmlExportEmbedsHostEncodedSog) {
+    param::ConvertParameters params;
+    params.input_path = dir_ / "in" / "scan_00.ply";
+    params.output_path = dir_ / "out" / "viewer.html";
+    params.format = param::OutputFormat::HTML;
+    params.sog_iterations = 2;
+    params.overwrite = true;
+    params.use_gpu = false;
+    ASSERT_EQ(run_converter(params), 0);
+    EXPECT_GT(fs::file_size(params.output_path), 0u);
+}
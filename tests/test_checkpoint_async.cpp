@@ -0,0 +1,269 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file test_checkpoint_async.cpp
+ * @brief Snapshot-then-write checkpoints (AsyncCheckpointWriter, format v3)
+ *
+ * A checkpoint must capture the state at save() time even though training
+ * keeps mutating the model while it is written, must resume into a fresh
+ * strategy, and must never leave a partial or silently corrupt file.
+ * Loading only the SplatData must not read the optimizer state.
+ */
+
+#include "core/parameters.hpp"
+#include "core/splat_data.hpp"
+#include "core/tensor.hpp"
+#include "core/tensor_archive.hpp"
+#include "optimizer/adam_optimizer.hpp"
+#include "strategies/mcmc.hpp"
+#include "training/checkpoint.hpp"
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace lfs::core;
+using namespace lfs::training;
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr int SH_DEGREE = 3;
+
+    std::unique_ptr<SplatData> make_splat(const size_t n) {
+        return std::make_unique<SplatData>(
+            SH_DEGREE,
+            Tensor::randn({n, 3}, Device::CUDA),
+            Tensor::randn({n, 1, 3}, Device::CUDA),
+            Tensor::randn({n, 15, 3}, Device::CUDA),
+            Tensor::randn({n, 3}, Device::CUDA),
+            Tensor::randn({n, 4}, Device::CUDA),
+            Tensor::randn({n, 1}, Device::CUDA),
+            1.0f);
+    }
+
+    // One optimizer step with random gradients, so parameters and Adam moments change
+    void train_step(MCMC& strategy, const int iter) {
+        auto& model = strategy.get_model();
+        auto& optimizer = strategy.get_optimizer();
+        optimizer.get_grad(ParamType::Means) = Tensor::randn(model.means_raw().shape(), Device::CUDA);
+        optimizer.get_grad(ParamType::Sh0) = Tensor::randn(model.sh0_raw().shape(), Device::CUDA);
+        optimizer.get_grad(ParamType::ShN) = Tensor::randn(model.shN_raw().shape(), Device::CUDA);
+        optimizer.get_grad(ParamType::Scaling) = Tensor::randn(model.scaling_raw().shape(), Device::CUDA);
+        optimizer.get_grad(ParamType::Rotation) = Tensor::randn(model.rotation_raw().shape(), Device::CUDA);
+        optimizer.get_grad(ParamType::Opacity) = Tensor::randn(model.opacity_raw().shape(), Device::CUDA);
+        optimizer.step(iter);
+        optimizer.zero_grad(iter);
+    }
+
+    // Flip one byte inside a named entry of a v3 checkpoint
+    void corrupt_entry(const fs::path& path, const std::string& name) {
+        uint64_t offset = 0;
+        {
+            auto archive = TensorArchive::open(path);
+            ASSERT_TRUE(archive.has_value()) << archive.error();
+            const auto* const entry = (*archive)->find(name);
+            ASSERT_NE(entry, nullptr) << name;
+            ASSERT_GT(entry->stored_size, 16u);
+            offset = entry->offset + entry->stored_size / 2;
+        }
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(static_cast<std::streamoff>(offset));
+        char byte = 0;
+        file.read(&byte, 1);
+        byte = static_cast<char>(byte ^ 0x5A);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(&byte, 1);
+    }
+
+    class CheckpointAsyncTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            output_path_ = fs::temp_directory_path() / "lfs_test_checkpoint_async";
+            fs::create_directories(output_path_);
+            params_.optimization.sh_degree = SH_DEGREE;
+            params_.optimization.max_cap = 0;
+        }
+
+        void TearDown() override {
+            std::error_code ec;
+            fs::remove_all(output_path_, ec);
+        }
+
+        std::unique_ptr<MCMC> make_strategy(SplatData& splat) const {
+            auto strategy = std::make_unique<MCMC>(splat);
+            strategy->initialize(params_.optimization);
+            return strategy;
+        }
+
+        fs::path checkpoint_path(const int iteration) const {
+            return output_path_ / "checkpoints" / std::format("checkpoint_{}.resume", iteration);
+        }
+
+        fs::path output_path_;
+        param::TrainingParameters params_;
+    };
+
+} // namespace
+
+TEST_F(CheckpointAsyncTest, AsyncSaveCapturesStateAtSnapshotAndResumes) {
+    constexpr int ITER = 100;
+    auto splat = make_splat(20'000);
+    auto strategy = make_strategy(*splat);
+    train_step(*strategy, 1);
+
+    const auto means_at_save = strategy->get_model().means_raw().cpu().to_vector();
+    const auto exp_avg_at_save = strategy->get_optimizer().get_state(ParamType::Means)->exp_avg.cpu().to_vector();
+
+    AsyncCheckpointWriter writer;
+    ASSERT_TRUE(writer.save(output_path_, ITER, *strategy, params_).has_value());
+
+    // Training continues while the write is in flight
+    train_step(*strategy, 2);
+    ASSERT_NE(strategy->get_model().means_raw().cpu().to_vector(), means_at_save);
+
+    auto written = writer.wait();
+    ASSERT_TRUE(written.has_value()) << written.error();
+    EXPECT_FALSE(fs::exists(fs::path(checkpoint_path(ITER)) += ".tmp"));
+
+    auto header = load_checkpoint_header(checkpoint_path(ITER));
+    ASSERT_TRUE(header.has_value()) << header.error();
+    EXPECT_EQ(header->version, CHECKPOINT_VERSION);
+    EXPECT_EQ(header->iteration, ITER);
+    EXPECT_EQ(header->num_gaussians, 20'000u);
+
+    auto loaded_splat = load_checkpoint_splat_data(checkpoint_path(ITER));
+    ASSERT_TRUE(loaded_splat.has_value()) << loaded_splat.error();
+    EXPECT_EQ(loaded_splat->means_raw().cpu().to_vector(), means_at_save);
+
+    // Resume into a fresh strategy
+    auto resumed_splat = make_splat(20'000);
+    auto resumed = make_strategy(*resumed_splat);
+    auto resumed_params = params_;
+    auto iteration = load_checkpoint(checkpoint_path(ITER), *resumed, resumed_params);
+    ASSERT_TRUE(iteration.has_value()) << iteration.error();
+    EXPECT_EQ(*iteration, ITER);
+    EXPECT_EQ(resumed->get_model().means_raw().cpu().to_vector(), means_at_save);
+    EXPECT_EQ(resumed->get_optimizer().get_state(ParamType::Means)->exp_avg.cpu().to_vector(), exp_avg_at_save);
+    EXPECT_EQ(resumed_params.optimization.sh_degree, SH_DEGREE);
+}
+
+TEST_F(CheckpointAsyncTest, StoredAndCompressedTensorsRoundTrip) {
+    auto splat = make_splat(5'000);
+    auto strategy = make_strategy(*splat);
+    train_step(*strategy, 1);
+    const auto sh_at_save = strategy->get_model().shN_raw().cpu().to_vector();
+
+    for (const bool compress : {false, true}) {
+        const CheckpointWriteOptions options{.compress = compress};
+        const int iter = compress ? 2 : 1;
+        auto saved = save_checkpoint(output_path_, iter, *strategy, params_, nullptr, options);
+        ASSERT_TRUE(saved.has_value()) << saved.error();
+
+        auto loaded = load_checkpoint_splat_data(checkpoint_path(iter));
+        ASSERT_TRUE(loaded.has_value()) << loaded.error();
+        EXPECT_EQ(loaded->shN_raw().cpu().to_vector(), sh_at_save) << "compress=" << compress;
+
+        auto params = load_checkpoint_params(checkpoint_path(iter));
+        ASSERT_TRUE(params.has_value()) << params.error();
+        EXPECT_EQ(params->optimization.sh_degree, SH_DEGREE);
+    }
+}
+
+TEST_F(CheckpointAsyncTest, CorruptTensorIsRejected) {
+    auto splat = make_splat(5'000);
+    auto strategy = make_strategy(*splat);
+    ASSERT_TRUE(save_checkpoint(output_path_, 1, *strategy, params_, nullptr, {.compress = false}).has_value());
+
+    const auto path = checkpoint_path(1);
+    corrupt_entry(path, "model/0");
+
+    auto loaded = load_checkpoint_splat_data(path);
+    ASSERT_FALSE(loaded.has_value());
+    EXPECT_NE(loaded.error().find("checksum"), std::string::npos) << loaded.error();
+}
+
+TEST_F(CheckpointAsyncTest, ChunkedV2CheckpointIsRejected) {
+    auto splat = make_splat(1'000);
+    auto strategy = make_strategy(*splat);
+    ASSERT_TRUE(save_checkpoint(output_path_, 1, *strategy, params_).has_value());
+
+    const auto path = checkpoint_path(1);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        const uint32_t version = 2;
+        file.seekp(offsetof(CheckpointHeader, version));
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+
+    auto header = load_checkpoint_header(path);
+    ASSERT_FALSE(header.has_value());
+    EXPECT_NE(header.error().find("Unsupported version"), std::string::npos) << header.error();
+    EXPECT_FALSE(load_checkpoint_splat_data(path).has_value());
+}
+
+TEST_F(CheckpointAsyncTest, SplatOnlyLoadSkipsOptimizerState) {
+    auto splat = make_splat(5'000);
+    auto strategy = make_strategy(*splat);
+    train_step(*strategy, 1);
+    const auto means_at_save = strategy->get_model().means_raw().cpu().to_vector();
+    ASSERT_TRUE(save_checkpoint(output_path_, 1, *strategy, params_).has_value());
+
+    const auto path = checkpoint_path(1);
+    {
+        auto archive = TensorArchive::open(path);
+        ASSERT_TRUE(archive.has_value()) << archive.error();
+        ASSERT_NE((*archive)->find("strategy/0"), nullptr);
+        const auto* const params_entry = (*archive)->find("params");
+        ASSERT_NE(params_entry, nullptr);
+        auto header = load_checkpoint_header(path);
+        ASSERT_TRUE(header.has_value());
+        EXPECT_EQ(header->params_json_offset, params_entry->offset);
+    }
+
+    // A damaged optimizer moment only matters when resuming
+    corrupt_entry(path, "strategy/0");
+
+    auto loaded = load_checkpoint_splat_data(path, Device::CPU);
+    ASSERT_TRUE(loaded.has_value()) << loaded.error();
+    EXPECT_EQ(loaded->means_raw().to_vector(), means_at_save);
+    EXPECT_TRUE(load_checkpoint_params(path).has_value());
+
+    auto resumed_splat = make_splat(5'000);
+    auto resumed = make_strategy(*resumed_splat);
+    auto resumed_params = params_;
+    auto iteration = load_checkpoint(path, *resumed, resumed_params);
+    ASSERT_FALSE(iteration.has_value());
+    EXPECT_NE(iteration.error().find("checksum"), std::string::npos) << iteration.error();
+}
+
+TEST_F(CheckpointAsyncTest, TrainingStallBenchmark) {
+    constexpr size_t N = 1'000'000;
+    auto splat = make_splat(N);
+    auto strategy = make_strategy(*splat);
+    train_step(*strategy, 1);
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(save_checkpoint(output_path_, 1, *strategy, params_).has_value());
+    const double sync_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    AsyncCheckpointWriter writer;
+    ASSERT_TRUE(writer.save(output_path_, 2, *strategy, params_).has_value());
+    const double stall_ms = writer.last_stall_ms();
+    ASSERT_TRUE(writer.wait().has_value());
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "\n=== Checkpoint stall, " << N << " Gaussians (SH" << SH_DEGREE << ") ===\n"
+              << "  blocking save:   " << sync_ms << " ms\n"
+              << "  snapshot stall:  " << stall_ms << " ms\n"
+              << "  file size:       " << static_cast<double>(fs::file_size(checkpoint_path(2))) / (1024 * 1024)
+              << " MB\n";
+    EXPECT_LT(stall_ms, sync_ms);
+}
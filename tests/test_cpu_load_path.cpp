@@ -0,0 +1,205 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/splat_data.hpp"
+#include "io/exporter.hpp"
+#include "io/formats/colmap.hpp"
+#include "io/loader.hpp"
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+using namespace lfs::core;
+using namespace lfs::io;
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr float SPZ_TOLERANCE = 0.15f; // SPZ quantizes to 8-12 bits
+
+    SplatData make_splat(size_t n, int sh_degree) {
+        const size_t sh_coeffs = static_cast<size_t>((sh_degree + 1) * (sh_degree + 1) - 1);
+        auto means = Tensor::empty({n, 3}, Device::CPU, DataType::Float32);
+        auto sh0 = Tensor::empty({n, 1, 3}, Device::CPU, DataType::Float32);
+        auto shN = Tensor::empty({n, sh_coeffs, 3}, Device::CPU, DataType::Float32);
+        auto scaling = Tensor::empty({n, 3}, Device::CPU, DataType::Float32);
+        auto rotation = Tensor::empty({n, 4}, Device::CPU, DataType::Float32);
+        auto opacity = Tensor::empty({n, 1}, Device::CPU, DataType::Float32);
+
+        for (size_t i = 0; i < n; ++i) {
+            const float f = static_cast<float>(i);
+            for (int k = 0; k < 3; ++k) {
+                means.ptr<float>()[i * 3 + k] = 0.25f * f - 3.0f * k;
+                sh0.ptr<float>()[i * 3 + k] = 0.1f * static_cast<float>((i + k) % 7) - 0.3f;
+                scaling.ptr<float>()[i * 3 + k] = -4.0f + 0.02f * static_cast<float>((i + k) % 50);
+            }
+            for (size_t j = 0; j < sh_coeffs * 3; ++j) {
+                shN.ptr<float>()[i * sh_coeffs * 3 + j] = 0.01f * static_cast<float>((i + j) % 11) - 0.05f;
+            }
+            rotation.ptr<float>()[i * 4 + 0] = 1.0f;
+            rotation.ptr<float>()[i * 4 + 1] = 0.0f;
+            rotation.ptr<float>()[i * 4 + 2] = 0.0f;
+            rotation.ptr<float>()[i * 4 + 3] = 0.0f;
+            opacity.ptr<float>()[i] = -2.0f + 0.03f * static_cast<float>(i % 100);
+        }
+
+        return SplatData(sh_degree, std::move(means), std::move(sh0), std::move(shN),
+                         std::move(scaling), std::move(rotation), std::move(opacity), 0.5f);
+    }
+
+    void expect_on_cpu(const SplatData& splat) {
+        EXPECT_EQ(splat.means_raw().device(), Device::CPU);
+        EXPECT_EQ(splat.sh0_raw().device(), Device::CPU);
+        EXPECT_EQ(splat.scaling_raw().device(), Device::CPU);
+        EXPECT_EQ(splat.rotation_raw().device(), Device::CPU);
+        EXPECT_EQ(splat.opacity_raw().device(), Device::CPU);
+        if (splat.shN_raw().is_valid()) {
+            EXPECT_EQ(splat.shN_raw().device(), Device::CPU);
+        }
+    }
+
+    void expect_near(const Tensor& actual, const Tensor& expected, float tolerance, const char* what) {
+        ASSERT_EQ(actual.shape(), expected.shape()) << what;
+        const auto a = actual.contiguous();
+        const auto e = expected.contiguous();
+        for (size_t i = 0; i < a.numel(); ++i) {
+            ASSERT_NEAR(a.ptr<float>()[i], e.ptr<float>()[i], tolerance) << what << " element " << i;
+        }
+    }
+
+    std::shared_ptr<SplatData> load_splat_on_cpu(const fs::path& path) {
+        const auto loader = Loader::create();
+        auto result = loader->load(path, {.device = Device::CPU});
+        EXPECT_TRUE(result.has_value()) << (result ? "" : result.error().format());
+        if (!result) {
+            return nullptr;
+        }
+        auto* splat = std::get_if<std::shared_ptr<SplatData>>(&result->data);
+        return splat ? *splat : nullptr;
+    }
+
+    template <typename T>
+    void put(std::ofstream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+} // namespace
+
+class CpuLoadPathTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / std::format("lfs_cpu_load_path_test_{}", ::testing::UnitTest::GetInstance()->random_seed());
+        fs::remove_all(dir_);
+        fs::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir_);
+    }
+
+    fs::path dir_;
+};
+
+TEST_F(CpuLoadPathTest, PlyRoundTrip) {
+    const auto original = make_splat(257, 3);
+    const auto path = dir_ / "splat.ply";
+    ASSERT_TRUE(save_ply(original, {.output_path = path, .binary = true}));
+
+    const auto loaded = load_splat_on_cpu(path);
+    ASSERT_TRUE(loaded);
+    expect_on_cpu(*loaded);
+    ASSERT_EQ(loaded->size(), original.size());
+    EXPECT_EQ(loaded->get_max_sh_degree(), 3);
+
+    expect_near(loaded->means_raw(), original.means_raw(), 0.0f, "means");
+    expect_near(loaded->sh0_raw(), original.sh0_raw(), 0.0f, "sh0");
+    expect_near(loaded->shN_raw(), original.shN_raw(), 0.0f, "shN");
+    expect_near(loaded->scaling_raw(), original.scaling_raw(), 0.0f, "scaling");
+    expect_near(loaded->opacity_raw(), original.opacity_raw(), 0.0f, "opacity");
+    expect_near(loaded->rotation_raw(), original.rotation_raw(), 1e-6f, "rotation");
+}
+
+TEST_F(CpuLoadPathTest, SpzRoundTrip) {
+    const auto original = make_splat(500, 1);
+    const auto path = dir_ / "splat.spz";
+    ASSERT_TRUE(save_spz(original, {.output_path = path}));
+
+    const auto loaded = load_splat_on_cpu(path);
+    ASSERT_TRUE(loaded);
+    expect_on_cpu(*loaded);
+    ASSERT_EQ(loaded->size(), original.size());
+    expect_near(loaded->means_raw(), original.means_raw(), 0.01f, "means");
+    expect_near(loaded->scaling_raw(), original.scaling_raw(), SPZ_TOLERANCE, "scaling");
+    expect_near(loaded->opacity_raw(), original.opacity_raw(), SPZ_TOLERANCE, "opacity");
+}
+
+TEST_F(CpuLoadPathTest, PlyToSpzPipelineStaysOnHost) {
+    const auto ply_path = dir_ / "input.ply";
+    const auto spz_path = dir_ / "output.spz";
+    ASSERT_TRUE(save_ply(make_splat(128, 2), {.output_path = ply_path, .binary = true}));
+
+    // load -> transform -> export without touching the device
+    auto splat = load_splat_on_cpu(ply_path);
+    ASSERT_TRUE(splat);
+    splat->means() = splat->means() * 2.0f + 1.0f;
+    expect_on_cpu(*splat);
+    ASSERT_TRUE(save_spz(*splat, {.output_path = spz_path}));
+
+    const auto reloaded = load_splat_on_cpu(spz_path);
+    ASSERT_TRUE(reloaded);
+    expect_on_cpu(*reloaded);
+    expect_near(reloaded->means_raw(), splat->means_raw(), 0.02f, "means");
+}
+
+TEST_F(CpuLoadPathTest, SplatDataDeserializeOnCpu) {
+    const auto original = make_splat(64, 2);
+    std::stringstream buffer;
+    original.serialize(buffer);
+
+    SplatData restored;
+    restored.deserialize(buffer, Device::CPU);
+    expect_on_cpu(restored);
+    expect_near(restored.means_raw(), original.means_raw(), 0.0f, "means");
+    expect_near(restored.shN_raw(), original.shN_raw(), 0.0f, "shN");
+}
+
+TEST_F(CpuLoadPathTest, ColmapPointsOnCpu) {
+    const auto sparse = dir_ / "sparse" / "0";
+    fs::create_directories(sparse);
+    constexpr size_t N = 40;
+    {
+        std::ofstream bin(sparse / "points3D.bin", std::ios::binary);
+        std::ofstream txt(sparse / "points3D.txt");
+        put<uint64_t>(bin, N);
+        for (size_t i = 0; i < N; ++i) {
+            const double xyz[3] = {0.5 * i, -0.25 * i, 2.0};
+            const uint8_t rgb[3] = {static_cast<uint8_t>(i), 128, static_cast<uint8_t>(255 - i)};
+            put<uint64_t>(bin, i + 1);
+            for (double v : xyz)
+                put(bin, v);
+            bin.write(reinterpret_cast<const char*>(rgb), 3);
+            put(bin, 0.1);
+            put<uint64_t>(bin, 1);
+            put<uint32_t>(bin, 1);
+            put<uint32_t>(bin, static_cast<uint32_t>(i));
+            txt << std::format("{} {} {} {} {} {} {} 0.1 1 {}\n", i + 1, xyz[0], xyz[1], xyz[2], rgb[0], rgb[1], rgb[2], i);
+        }
+    }
+
+    const PointCloud clouds[] = {read_colmap_point_cloud(dir_, Device::CPU), read_colmap_point_cloud_text(dir_, Device::CPU)};
+    for (const auto& pc : clouds) {
+        ASSERT_EQ(pc.means.device(), Device::CPU);
+        ASSERT_EQ(pc.colors.device(), Device::CPU);
+        ASSERT_EQ(pc.size(), static_cast<int64_t>(N));
+        for (size_t i = 0; i < N; ++i) {
+            EXPECT_FLOAT_EQ(pc.means.ptr<float>()[i * 3 + 0], 0.5f * i);
+            EXPECT_FLOAT_EQ(pc.means.ptr<float>()[i * 3 + 1], -0.25f * i);
+            EXPECT_EQ(pc.colors.ptr<uint8_t>()[i * 3 + 0], static_cast<uint8_t>(i));
+            EXPECT_EQ(pc.colors.ptr<uint8_t>()[i * 3 + 2], static_cast<uint8_t>(255 - i));
+        }
+    }
+}
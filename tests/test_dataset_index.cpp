@@ -0,0 +1,156 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/image_io.hpp"
+#include "io/dataset_index.hpp"
+#include <chrono>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace lfs::io;
+namespace fs = std::filesystem;
+
+class DatasetIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        base_ = fs::temp_directory_path() / "lfs_test_dataset_index";
+        index_dir_ = fs::temp_directory_path() / "lfs_test_dataset_index_cache";
+        fs::remove_all(base_);
+        fs::remove_all(index_dir_);
+        fs::create_directories(base_ / "images");
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove_all(base_, ec);
+        fs::remove_all(index_dir_, ec);
+    }
+
+    DatasetIndexOptions options() const { return {.use_sidecar = true, .index_dir = index_dir_}; }
+
+    // Nothing but the images and masks the test wrote may appear in the dataset
+    bool dataset_untouched() const {
+        for (const auto& entry : fs::recursive_directory_iterator(base_)) {
+            const auto ext = entry.path().extension();
+            if (entry.is_regular_file() && ext != ".png" && ext != ".jpg") {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void write_image(const fs::path& path, const int width, const int height) const {
+        fs::create_directories(path.parent_path());
+        std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3, 128);
+        ASSERT_TRUE(lfs::core::save_img_data(path, {pixels.data(), width, height, 3})) << path;
+    }
+
+    DatasetImage add_image(const std::string& name, const int width = 32, const int height = 24) {
+        DatasetImage image{name, base_ / "images" / name};
+        write_image(image.path, width, height);
+        return image;
+    }
+
+    fs::path base_;
+    fs::path index_dir_;
+};
+
+TEST_F(DatasetIndexTest, FindsMasksInPriorityOrder) {
+    const std::vector<DatasetImage> images = {
+        add_image("exact.png"),
+        add_image("stem.jpg"),
+        add_image("full.jpg"),
+        add_image("sub/nested.jpg"),
+        add_image("fallback.jpg"),
+        add_image("unmasked.jpg"),
+    };
+    write_image(base_ / "masks" / "exact.png", 32, 24);
+    write_image(base_ / "masks" / "stem.png", 32, 24);
+    write_image(base_ / "masks" / "stem.jpg.png", 32, 24); // Lower priority than stem + ext
+    write_image(base_ / "masks" / "full.jpg.png", 32, 24);
+    write_image(base_ / "masks" / "sub" / "nested.png", 32, 24);
+    write_image(base_ / "segmentation" / "fallback.png", 32, 24);
+
+    auto indexed = index_dataset_images(base_, images, {.use_sidecar = false, .index_dir = index_dir_});
+    ASSERT_TRUE(indexed.has_value()) << indexed.error().format();
+    ASSERT_EQ(indexed->size(), images.size());
+
+    EXPECT_EQ((*indexed)[0].mask_path, base_ / "masks" / "exact.png");
+    EXPECT_EQ((*indexed)[1].mask_path, base_ / "masks" / "stem.png");
+    EXPECT_EQ((*indexed)[2].mask_path, base_ / "masks" / "full.jpg.png");
+    EXPECT_EQ((*indexed)[3].mask_path, base_ / "masks" / "sub" / "nested.png");
+    EXPECT_EQ((*indexed)[4].mask_path, base_ / "segmentation" / "fallback.png");
+    EXPECT_TRUE((*indexed)[5].mask_path.empty());
+
+    EXPECT_EQ((*indexed)[0].width, 32);
+    EXPECT_EQ((*indexed)[0].mask_height, 24);
+    EXPECT_FALSE(fs::exists(dataset_index_path(base_, options())));
+}
+
+TEST_F(DatasetIndexTest, NoMaskFoldersMeansNoMasks) {
+    const std::vector<DatasetImage> images = {add_image("a.jpg"), add_image("b.jpg")};
+
+    auto indexed = index_dataset_images(base_, images, options());
+    ASSERT_TRUE(indexed.has_value());
+    for (const auto& entry : *indexed) {
+        EXPECT_TRUE(entry.mask_path.empty());
+    }
+    EXPECT_FALSE(fs::exists(dataset_index_path(base_, options())));
+}
+
+TEST_F(DatasetIndexTest, MaskSizeMismatchReportsFirstImage) {
+    std::vector<DatasetImage> images;
+    for (int i = 0; i < 64; ++i) {
+        images.push_back(add_image("img" + std::to_string(i) + ".jpg"));
+        write_image(base_ / "masks" / ("img" + std::to_string(i) + ".png"), i % 7 == 3 ? 16 : 32, 24);
+    }
+
+    auto indexed = index_dataset_images(base_, images, options());
+    ASSERT_FALSE(indexed.has_value());
+    EXPECT_EQ(indexed.error().code, ErrorCode::MASK_SIZE_MISMATCH);
+    EXPECT_NE(indexed.error().message.find("img3.png"), std::string::npos) << indexed.error().message;
+}
+
+TEST_F(DatasetIndexTest, SidecarIsReusedAndInvalidatedByChanges) {
+    const std::vector<DatasetImage> images = {add_image("a.jpg"), add_image("b.jpg")};
+    write_image(base_ / "masks" / "a.png", 32, 24);
+    write_image(base_ / "masks" / "b.png", 32, 24);
+
+    ASSERT_TRUE(index_dataset_images(base_, images, options()).has_value());
+    const auto sidecar = dataset_index_path(base_, options());
+    ASSERT_TRUE(fs::exists(sidecar));
+    EXPECT_EQ(sidecar.parent_path(), index_dir_);
+    EXPECT_TRUE(dataset_untouched());
+    const auto first_write = fs::last_write_time(sidecar);
+
+    // Warm reload with nothing changed leaves the index alone
+    auto warm = index_dataset_images(base_, images, options());
+    ASSERT_TRUE(warm.has_value());
+    EXPECT_EQ((*warm)[1].mask_path, base_ / "masks" / "b.png");
+    EXPECT_EQ((*warm)[1].mask_width, 32);
+    EXPECT_EQ(fs::last_write_time(sidecar), first_write);
+
+    // A replaced mask must be probed again rather than trusted from the index
+    write_image(base_ / "masks" / "b.png", 16, 24);
+    fs::last_write_time(base_ / "masks" / "b.png", first_write + std::chrono::seconds(10));
+    auto changed = index_dataset_images(base_, images, options());
+    ASSERT_FALSE(changed.has_value());
+    EXPECT_EQ(changed.error().code, ErrorCode::MASK_SIZE_MISMATCH);
+}
+
+TEST_F(DatasetIndexTest, MatchesMaskCaseLikeTheFilesystem) {
+    const std::vector<DatasetImage> images = {add_image("photo.jpg")};
+    write_image(base_ / "masks" / "PHOTO.PNG", 32, 24);
+    const bool case_insensitive = fs::exists(base_ / "masks" / "photo.png");
+
+    auto indexed = index_dataset_images(base_, images, {.use_sidecar = false, .index_dir = index_dir_});
+    ASSERT_TRUE(indexed.has_value()) << indexed.error().format();
+    if (case_insensitive) {
+        EXPECT_TRUE(fs::equivalent((*indexed)[0].mask_path, base_ / "masks" / "PHOTO.PNG"));
+        EXPECT_EQ((*indexed)[0].mask_width, 32);
+    } else {
+        EXPECT_TRUE((*indexed)[0].mask_path.empty());
+    }
+}
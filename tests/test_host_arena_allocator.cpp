@@ -0,0 +1,150 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include "core/tensor/internal/host_arena_allocator.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    template <typename Func>
+    double time_ms(Func func, int iters) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iters; ++i) {
+            func();
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / iters;
+    }
+
+} // namespace
+
+class HostArenaAllocatorTest : public ::testing::Test {
+protected:
+    HostArenaAllocator& pool = HostArenaAllocator::instance();
+};
+
+TEST_F(HostArenaAllocatorTest, PointersAreAlignedAndWritable) {
+    std::vector<void*> ptrs;
+    for (size_t bytes : {1ul, 3ul, 64ul, 1000ul, 4096ul, 1ul << 20, 20ul << 20}) {
+        void* p = pool.allocate(bytes);
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % HOST_ALLOC_ALIGNMENT, 0u) << bytes << " bytes";
+        std::memset(p, 0xAB, bytes);
+        ptrs.push_back(p);
+    }
+    for (void* p : ptrs) {
+        pool.deallocate(p);
+    }
+}
+
+TEST_F(HostArenaAllocatorTest, FreedMemoryIsReused) {
+    pool.reset_stats();
+
+    void* small = pool.allocate(256 * 1024);
+    pool.deallocate(small);
+    void* small_again = pool.allocate(256 * 1024);
+    EXPECT_EQ(small, small_again);
+    pool.deallocate(small_again);
+
+    // Slightly different large sizes land in the same size class
+    void* large = pool.allocate(48 << 20);
+    pool.deallocate(large);
+    void* large_again = pool.allocate((48 << 20) - 4096);
+    EXPECT_EQ(large, large_again);
+    pool.deallocate(large_again);
+
+    const auto stats = pool.get_stats();
+    EXPECT_EQ(stats.num_allocs, 4u);
+    EXPECT_EQ(stats.num_deallocs, 4u);
+    EXPECT_GE(stats.cache_hits, 2u);
+}
+
+TEST_F(HostArenaAllocatorTest, StatsTrackLiveCpuTensors) {
+    const auto before = MemoryInfo::cpu();
+    {
+        auto t = Tensor::empty({1024, 1024}, Device::CPU);
+        const auto during = MemoryInfo::cpu();
+        EXPECT_EQ(during.allocated_bytes, before.allocated_bytes + t.bytes());
+        EXPECT_GE(during.total_bytes, during.allocated_bytes);
+    }
+    EXPECT_EQ(MemoryInfo::cpu().allocated_bytes, before.allocated_bytes);
+}
+
+TEST_F(HostArenaAllocatorTest, TrimReleasesCachedBlocks) {
+    void* p = pool.allocate(64 << 20);
+    pool.deallocate(p);
+    EXPECT_GT(pool.get_stats().cached_bytes, 0u);
+
+    pool.trim();
+    EXPECT_EQ(pool.get_stats().cached_bytes, 0u);
+}
+
+TEST_F(HostArenaAllocatorTest, IdleMemoryIsBounded) {
+    pool.trim();
+    const auto before = pool.get_stats();
+
+    // Spill small allocations over three arenas, then free them all
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 40; ++i) {
+        ptrs.push_back(pool.allocate(15 << 20));
+        ASSERT_NE(ptrs.back(), nullptr);
+    }
+    const auto peak = pool.get_stats();
+    ASSERT_GE(peak.num_arenas, before.num_arenas + 3);
+    for (void* p : ptrs) {
+        pool.deallocate(p);
+    }
+    EXPECT_LE(pool.get_stats().num_arenas, before.num_arenas + HOST_MAX_IDLE_ARENAS);
+
+    // Large blocks beyond the cache cap go straight back to the OS
+    ptrs.clear();
+    for (int i = 0; i < 4; ++i) {
+        ptrs.push_back(pool.allocate(256 << 20));
+        ASSERT_NE(ptrs.back(), nullptr);
+    }
+    for (void* p : ptrs) {
+        pool.deallocate(p);
+    }
+    EXPECT_LE(pool.get_stats().cached_bytes, HOST_MAX_CACHED_BYTES);
+
+    pool.trim();
+    EXPECT_EQ(pool.get_stats().reserved_bytes, before.reserved_bytes);
+}
+
+TEST_F(HostArenaAllocatorTest, PooledVsSystemAllocation) {
+    constexpr int ITERS = 2000;
+    const std::vector<size_t> sizes = {4 << 10, 256 << 10, 4 << 20, 32 << 20};
+
+    std::cout << "\n=== Host allocation + first touch (" << ITERS << " iters) ===\n";
+    for (size_t bytes : sizes) {
+        const double system_ms = time_ms([&] {
+            auto* p = static_cast<char*>(std::malloc(bytes));
+            for (size_t i = 0; i < bytes; i += 4096) {
+                p[i] = 1;
+            }
+            std::free(p);
+        },
+                                         ITERS);
+        const double pool_ms = time_ms([&] {
+            auto* p = static_cast<char*>(pool.allocate(bytes));
+            for (size_t i = 0; i < bytes; i += 4096) {
+                p[i] = 1;
+            }
+            pool.deallocate(p);
+        },
+                                       ITERS);
+        std::cout << "  " << std::setw(10) << (bytes >> 10) << " KB | malloc " << std::fixed << std::setprecision(4)
+                  << system_ms << " ms | pool " << pool_ms << " ms | " << std::setprecision(1)
+                  << system_ms / pool_ms << "x\n";
+    }
+}
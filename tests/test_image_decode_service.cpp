@@ -0,0 +1,298 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/image_io.hpp"
+#include "visualizer/gui/windows/image_decode_service.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <future>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace lfs::vis::gui;
+namespace fs = std::filesystem;
+
+namespace {
+
+    // Every fake source is a 45MP-class photo
+    constexpr int SOURCE_WIDTH = 8192;
+    constexpr int SOURCE_HEIGHT = 5464;
+
+    // Decoder that fits the fake source into max_side, records call order and can hold one path
+    class FakeDecoder {
+    public:
+        explicit FakeDecoder(std::string blocking = {}) : blocking_(std::move(blocking)) {}
+
+        ImageDecodeService::Options options(const size_t num_workers = 1) {
+            ImageDecodeService::Options options;
+            options.num_workers = num_workers;
+            options.decode = [this](const fs::path& path, const int max_side) { return decode(path, max_side); };
+            options.probe = [](const fs::path&) { return std::pair{SOURCE_WIDTH, SOURCE_HEIGHT}; };
+            return options;
+        }
+
+        void wait_blocked() { started_.get_future().wait(); }
+        void release() { release_.set_value(); }
+
+        std::vector<std::string> calls() {
+            std::lock_guard lock(mutex_);
+            return calls_;
+        }
+
+    private:
+        std::tuple<unsigned char*, int, int, int> decode(const fs::path& path, const int max_side) {
+            const std::string name = path.string();
+            if (name == "broken.jpg") {
+                throw std::runtime_error("corrupt file");
+            }
+            {
+                std::lock_guard lock(mutex_);
+                calls_.push_back(name);
+            }
+            if (name == blocking_) {
+                started_.set_value();
+                release_future_.wait();
+            }
+            const int width = std::min(SOURCE_WIDTH, max_side);
+            const int height = std::max(1, width * SOURCE_HEIGHT / SOURCE_WIDTH);
+            auto* pixels = static_cast<unsigned char*>(std::calloc(static_cast<size_t>(width) * height * 3, 1));
+            return {pixels, width, height, 3};
+        }
+
+        std::string blocking_;
+        std::promise<void> started_;
+        std::promise<void> release_;
+        std::shared_future<void> release_future_ = release_.get_future().share();
+        std::mutex mutex_;
+        std::vector<std::string> calls_;
+    };
+
+    size_t level_bytes(const int level) {
+        const int width = ImageDecodeService::level_side(level);
+        return static_cast<size_t>(width) * (width * SOURCE_HEIGHT / SOURCE_WIDTH) * 3;
+    }
+
+} // namespace
+
+TEST(ImageDecodeServiceTest, LevelCoversViewportWithinTextureLimit) {
+    EXPECT_EQ(ImageDecodeService::level_for(100, 16384), 0);
+    EXPECT_EQ(ImageDecodeService::level_for(256, 16384), 0);
+    EXPECT_EQ(ImageDecodeService::level_for(1920, 16384), 3);
+    EXPECT_EQ(ImageDecodeService::level_side(3), 2048);
+    // Actual-size zoom on a 45MP photo stops at the texture limit
+    EXPECT_EQ(ImageDecodeService::level_side(ImageDecodeService::level_for(SOURCE_WIDTH, 4096)), 4096);
+    EXPECT_EQ(ImageDecodeService::level_side(ImageDecodeService::level_for(SOURCE_WIDTH, 16384)), 8192);
+}
+
+TEST(ImageDecodeServiceTest, DecodesAtRequestedLevelOnce) {
+    FakeDecoder decoder;
+    ImageDecodeService service(decoder.options());
+
+    service.schedule({{"a.jpg", 3, 0}});
+    service.wait_idle();
+
+    const auto image = service.find("a.jpg", 3);
+    ASSERT_TRUE(image);
+    EXPECT_EQ(image->data.width(), 2048);
+    EXPECT_EQ(image->source_width, SOURCE_WIDTH);
+    EXPECT_EQ(image->source_height, SOURCE_HEIGHT);
+    EXPECT_FALSE(service.find("a.jpg", 2));
+
+    // Cached levels are not decoded again
+    service.schedule({{"a.jpg", 3, 0}});
+    service.wait_idle();
+    EXPECT_EQ(decoder.calls().size(), 1u);
+    EXPECT_EQ(service.stats().decoded, 1u);
+}
+
+TEST(ImageDecodeServiceTest, FindBestPrefersSharpestLevelAtOrBelowRequest) {
+    FakeDecoder decoder;
+    ImageDecodeService service(decoder.options());
+
+    service.schedule({{"a.jpg", 0, 0}, {"a.jpg", 4, 0}});
+    service.wait_idle();
+
+    EXPECT_EQ(service.find_best("a.jpg", 3).second, 0);
+    EXPECT_EQ(service.find_best("a.jpg", 5).second, 4);
+    EXPECT_EQ(service.find_best("a.jpg", 4).second, 4);
+    EXPECT_EQ(service.find_best("b.jpg", 3).second, -1);
+}
+
+TEST(ImageDecodeServiceTest, ServesLowestPriorityValueFirst) {
+    FakeDecoder decoder("blocker.jpg");
+    ImageDecodeService service(decoder.options());
+
+    service.schedule({{"blocker.jpg", 0, 0}});
+    decoder.wait_blocked();
+    service.schedule({{"far.jpg", 0, 5}, {"current.jpg", 3, 1}, {"next.jpg", 3, 2}, {"prev.jpg", 3, 2}});
+    decoder.release();
+    service.wait_idle();
+
+    const std::vector<std::string> expected{"blocker.jpg", "current.jpg", "next.jpg", "prev.jpg", "far.jpg"};
+    EXPECT_EQ(decoder.calls(), expected);
+}
+
+TEST(ImageDecodeServiceTest, RescheduleDropsStaleRequests) {
+    FakeDecoder decoder("blocker.jpg");
+    ImageDecodeService service(decoder.options());
+
+    service.schedule({{"blocker.jpg", 0, 0}});
+    decoder.wait_blocked();
+    // The user skips ahead before the first batch starts
+    service.schedule({{"1.jpg", 3, 1}, {"2.jpg", 3, 2}, {"3.jpg", 3, 2}});
+    EXPECT_TRUE(service.pending("2.jpg"));
+    service.schedule({{"3.jpg", 3, 1}, {"blocker.jpg", 0, 0}});
+    EXPECT_FALSE(service.pending("2.jpg"));
+    decoder.release();
+    service.wait_idle();
+
+    const std::vector<std::string> expected{"blocker.jpg", "3.jpg"};
+    EXPECT_EQ(decoder.calls(), expected);
+    EXPECT_EQ(service.stats().cancelled, 2u);
+    EXPECT_FALSE(service.find("1.jpg", 3));
+    // The running decode was not repeated and still landed in the cache
+    EXPECT_TRUE(service.find("blocker.jpg", 0));
+}
+
+TEST(ImageDecodeServiceTest, EvictsLeastRecentlyUsedWithinBudget) {
+    FakeDecoder decoder;
+    auto options = decoder.options();
+    options.max_bytes = level_bytes(2) * 5 / 2;
+    ImageDecodeService service(std::move(options));
+
+    for (const char* name : {"a.jpg", "b.jpg"}) {
+        service.schedule({{name, 2, 0}});
+        service.wait_idle();
+    }
+    ASSERT_TRUE(service.find("a.jpg", 2)); // Touch a, leaving b the oldest
+    service.schedule({{"c.jpg", 2, 0}});
+    service.wait_idle();
+
+    EXPECT_TRUE(service.find("a.jpg", 2));
+    EXPECT_FALSE(service.find("b.jpg", 2));
+    EXPECT_TRUE(service.find("c.jpg", 2));
+    const auto stats = service.stats();
+    EXPECT_LE(stats.cache.bytes, level_bytes(2) * 5 / 2);
+    EXPECT_EQ(stats.cache.evictions, 1u);
+}
+
+TEST(ImageDecodeServiceTest, ReportsDecodeErrors) {
+    FakeDecoder decoder;
+    ImageDecodeService service(decoder.options());
+
+    service.schedule({{"broken.jpg", 3, 0}});
+    service.wait_idle();
+
+    const auto error = service.error("broken.jpg");
+    ASSERT_TRUE(error);
+    EXPECT_NE(error->find("corrupt"), std::string::npos);
+    EXPECT_FALSE(service.pending("broken.jpg"));
+    EXPECT_FALSE(service.error("a.jpg"));
+    EXPECT_EQ(service.stats().failed, 1u);
+}
+
+TEST(ImageDecodeServiceTest, PersistsThumbnailsAcrossInstances) {
+    const fs::path dir = fs::temp_directory_path() / "lfs_test_image_decode_service";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    constexpr int WIDTH = 1200;
+    constexpr int HEIGHT = 800;
+    std::vector<unsigned char> pixels(static_cast<size_t>(WIDTH) * HEIGHT * 3);
+    for (size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = static_cast<unsigned char>((i / 3) % 251);
+    const fs::path source = dir / "photo.jpg";
+    ASSERT_TRUE(lfs::core::save_img_data(source, {pixels.data(), WIDTH, HEIGHT, 3}));
+
+    ImageDecodeService::Options options;
+    options.thumbnail_dir = dir / "thumbnails";
+    {
+        ImageDecodeService service(options);
+        service.schedule({{source, 0, 0}});
+        service.wait_idle();
+        ASSERT_TRUE(service.find(source, 0));
+        EXPECT_EQ(service.stats().thumbnail_writes, 1u);
+    }
+
+    ImageDecodeService service(options);
+    service.schedule({{source, 0, 0}});
+    service.wait_idle();
+    const auto thumbnail = service.find(source, 0);
+    ASSERT_TRUE(thumbnail);
+    EXPECT_EQ(service.stats().thumbnail_hits, 1u);
+    EXPECT_LE(std::max(thumbnail->data.width(), thumbnail->data.height()), ImageDecodeService::THUMBNAIL_SIZE);
+    EXPECT_EQ(thumbnail->source_width, WIDTH);
+    EXPECT_EQ(thumbnail->source_height, HEIGHT);
+
+    fs::remove_all(dir);
+}
+
+TEST(ImageDecodeServiceTest, ReplacesThumbnailOfEditedSourceAndTrimsToBudget) {
+    const fs::path dir = fs::temp_directory_path() / "lfs_test_image_decode_service_trim";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    constexpr int WIDTH = 1200;
+    constexpr int HEIGHT = 800;
+    std::vector<unsigned char> pixels(static_cast<size_t>(WIDTH) * HEIGHT * 3);
+    for (size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = static_cast<unsigned char>((i * 7) % 253);
+    std::vector<fs::path> sources;
+    for (const char* name : {"a.jpg", "b.jpg", "c.jpg"}) {
+        sources.push_back(dir / name);
+        ASSERT_TRUE(lfs::core::save_img_data(sources.back(), {pixels.data(), WIDTH, HEIGHT, 3}));
+    }
+
+    const auto thumbnails = [&] {
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::recursive_directory_iterator(dir / "thumbnails"))
+            if (entry.is_regular_file())
+                files.push_back(entry.path());
+        return files;
+    };
+
+    ImageDecodeService::Options options;
+    options.thumbnail_dir = dir / "thumbnails";
+    {
+        ImageDecodeService service(options);
+        service.schedule({{sources[0], 0, 0}});
+        service.wait_idle();
+        ASSERT_EQ(thumbnails().size(), 1u);
+
+        // Editing the source supersedes its old thumbnail
+        fs::last_write_time(sources[0], fs::last_write_time(sources[0]) + std::chrono::seconds(5));
+        service.clear();
+        service.schedule({{sources[0], 0, 0}});
+        service.wait_idle();
+        EXPECT_EQ(thumbnails().size(), 1u);
+        EXPECT_EQ(service.stats().thumbnail_evictions, 1u);
+    }
+
+    {
+        ImageDecodeService service(options);
+        service.schedule({{sources[1], 0, 0}, {sources[2], 0, 0}});
+        service.wait_idle();
+        ASSERT_EQ(thumbnails().size(), 3u);
+    }
+    // Age the first two so the order does not depend on file time resolution
+    const auto now = fs::file_time_type::clock::now();
+    for (const auto& file : thumbnails())
+        fs::last_write_time(file, now - std::chrono::hours(1));
+    const fs::path newest = thumbnails().front();
+    fs::last_write_time(newest, now);
+
+    const size_t one = fs::file_size(newest);
+    options.max_thumbnail_bytes = one + one / 2;
+    ImageDecodeService trimmed(options);
+    const auto kept = thumbnails();
+    ASSERT_EQ(kept.size(), 1u);
+    EXPECT_EQ(kept.front(), newest);
+    EXPECT_GE(trimmed.stats().thumbnail_evictions, 2u);
+
+    fs::remove_all(dir);
+}
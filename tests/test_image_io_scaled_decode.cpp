@@ -0,0 +1,165 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/image_io.hpp"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+using namespace lfs::core;
+namespace fs = std::filesystem;
+
+namespace {
+
+    struct Image {
+        unsigned char* data = nullptr;
+        int width = 0, height = 0, channels = 0;
+
+        explicit Image(const std::tuple<unsigned char*, int, int, int>& loaded) {
+            std::tie(data, width, height, channels) = loaded;
+        }
+        ~Image() { free_image(data); }
+        Image(const Image&) = delete;
+        Image& operator=(const Image&) = delete;
+    };
+
+    double psnr(const Image& a, const Image& b) {
+        const size_t n = static_cast<size_t>(a.width) * a.height * a.channels;
+        double sse = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const double d = static_cast<double>(a.data[i]) - b.data[i];
+            sse += d * d;
+        }
+        const double mse = sse / static_cast<double>(n);
+        return mse == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+    // Smooth content so DCT scaling and the resampler agree closely
+    std::vector<unsigned char> make_pixels(const int width, const int height) {
+        std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                auto* const p = &pixels[(static_cast<size_t>(y) * width + x) * 3];
+                p[0] = static_cast<unsigned char>(127.5 + 127.5 * std::sin(x * 0.004));
+                p[1] = static_cast<unsigned char>(127.5 + 127.5 * std::cos(y * 0.006));
+                p[2] = static_cast<unsigned char>((x + y) * 255 / (width + height));
+            }
+        }
+        return pixels;
+    }
+
+    double elapsed_ms(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace
+
+class ScaledJpegDecodeTest : public ::testing::Test {
+protected:
+    static constexpr int WIDTH = 3000;
+    static constexpr int HEIGHT = 2000;
+
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / "lfs_test_scaled_jpeg";
+        fs::remove_all(dir_);
+        fs::create_directories(dir_);
+
+        auto pixels = make_pixels(WIDTH, HEIGHT);
+        jpeg_ = dir_ / "scene.jpg";
+        ASSERT_TRUE(save_img_data(jpeg_, {pixels.data(), WIDTH, HEIGHT, 3}));
+
+        // Reference: full decode of the same JPEG (OIIO path), stored lossless so
+        // load_image(png_, f) reproduces the old decode-then-resample result
+        const Image full(load_image(jpeg_, 1, 0));
+        ASSERT_EQ(full.width, WIDTH);
+        png_ = dir_ / "reference.png";
+        ASSERT_TRUE(save_img_data(png_, {full.data, full.width, full.height, 3}));
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove_all(dir_, ec);
+    }
+
+    fs::path dir_, jpeg_, png_;
+};
+
+TEST_F(ScaledJpegDecodeTest, MatchesFullDecodeAndResample) {
+    for (const int factor : {2, 4, 8}) {
+        const Image scaled(load_image(jpeg_, factor, 0));
+        const Image reference(load_image(png_, factor, 0));
+        ASSERT_EQ(scaled.width, WIDTH / factor);
+        ASSERT_EQ(scaled.height, HEIGHT / factor);
+        ASSERT_EQ(scaled.width, reference.width);
+        ASSERT_EQ(scaled.height, reference.height);
+        EXPECT_EQ(scaled.channels, 3);
+        EXPECT_GT(psnr(scaled, reference), 35.0) << "factor " << factor;
+    }
+}
+
+TEST_F(ScaledJpegDecodeTest, MaxWidthUsesDctScalePlusRemainder) {
+    // 3000 -> 1000 is 1/2 in the DCT, then 1500 -> 1000 in the resampler
+    const Image scaled(load_image(jpeg_, 1, 1000));
+    const Image reference(load_image(png_, 1, 1000));
+    ASSERT_EQ(scaled.width, 1000);
+    ASSERT_EQ(scaled.height, 666);
+    ASSERT_EQ(reference.width, scaled.width);
+    ASSERT_EQ(reference.height, scaled.height);
+    EXPECT_GT(psnr(scaled, reference), 35.0);
+
+    // Combined with a resize factor the clamp still applies to the reduced size
+    const Image both(load_image(jpeg_, 2, 600));
+    EXPECT_EQ(both.width, 600);
+    EXPECT_EQ(both.height, 400);
+}
+
+TEST_F(ScaledJpegDecodeTest, OddSizeCropsSpareDctPixel) {
+    // 3001x2001 at 1/2 decodes to 1501x1001 in the DCT; the spare row and column
+    // are cropped instead of resampled, and the size still matches the full path
+    auto pixels = make_pixels(3001, 2001);
+    const fs::path odd = dir_ / "odd.jpg";
+    ASSERT_TRUE(save_img_data(odd, {pixels.data(), 3001, 2001, 3}));
+    const Image full(load_image(odd, 1, 0));
+    const fs::path odd_png = dir_ / "odd.png";
+    ASSERT_TRUE(save_img_data(odd_png, {full.data, full.width, full.height, 3}));
+
+    const Image scaled(load_image(odd, 2, 0));
+    const Image reference(load_image(odd_png, 2, 0));
+    ASSERT_EQ(scaled.width, 1500);
+    ASSERT_EQ(scaled.height, 1000);
+    ASSERT_EQ(reference.width, scaled.width);
+    ASSERT_EQ(reference.height, scaled.height);
+    EXPECT_GT(psnr(scaled, reference), 35.0);
+}
+
+TEST_F(ScaledJpegDecodeTest, FullResolutionIsUnchanged) {
+    const Image jpeg(load_image(jpeg_, 1, 0));
+    const Image png(load_image(png_, 1, 0));
+    ASSERT_EQ(jpeg.width, WIDTH);
+    EXPECT_EQ(psnr(jpeg, png), 100.0);
+}
+
+TEST_F(ScaledJpegDecodeTest, Benchmark) {
+    constexpr int ITERATIONS = 5;
+    std::cout << "\nJPEG " << WIDTH << "x" << HEIGHT << " load_image timings (avg of " << ITERATIONS << "):\n";
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        const Image full(load_image(jpeg_, 1, 0));
+    }
+    const double full_ms = elapsed_ms(start) / ITERATIONS;
+    std::cout << "  full decode:            " << full_ms << " ms\n";
+
+    for (const int factor : {2, 4, 8}) {
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            const Image scaled(load_image(jpeg_, factor, 0));
+        }
+        const double scaled_ms = elapsed_ms(start) / ITERATIONS;
+        std::cout << "  resize_factor " << factor << " (DCT):    " << scaled_ms << " ms ("
+                  << full_ms / scaled_ms << "x vs full decode)\n";
+    }
+}
@@ -0,0 +1,177 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/logger.hpp"
+#include "core/perf_trace.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lfs::core;
+namespace fs = std::filesystem;
+
+#if LFS_PERF_TRACING
+
+class PerfTraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        trace::stop();
+        trace::clear();
+        path_ = fs::temp_directory_path() / "lfs_test_trace.json";
+    }
+
+    void TearDown() override {
+        trace::stop();
+        trace::clear();
+        std::error_code ec;
+        fs::remove(path_, ec);
+    }
+
+    nlohmann::json read_trace() const {
+        std::ifstream file(path_);
+        return nlohmann::json::parse(file);
+    }
+
+    static std::vector<nlohmann::json> complete_events(const nlohmann::json& trace) {
+        std::vector<nlohmann::json> events;
+        for (const auto& e : trace["traceEvents"]) {
+            if (e["ph"] == "X")
+                events.push_back(e);
+        }
+        return events;
+    }
+
+    fs::path path_;
+};
+
+TEST_F(PerfTraceTest, NothingRecordedWhileStopped) {
+    {
+        LFS_TRACE_SCOPE(IO, "ignored");
+    }
+    EXPECT_EQ(trace::stats().events, 0u);
+}
+
+TEST_F(PerfTraceTest, WritesNestedScopesAsChromeTrace) {
+    trace::start();
+    trace::set_thread_name("test \"main\"");
+    {
+        LFS_TRACE_SCOPE(Training, "outer");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        {
+            LFS_TRACE_SCOPE(Export, "inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    ASSERT_TRUE(trace::write_chrome_trace(path_));
+
+    const auto trace = read_trace();
+    const auto events = complete_events(trace);
+    ASSERT_EQ(events.size(), 2u);
+
+    // Inner closes first
+    EXPECT_EQ(events[0]["name"], "inner");
+    EXPECT_EQ(events[0]["cat"], "export");
+    EXPECT_EQ(events[1]["name"], "outer");
+    EXPECT_EQ(events[1]["cat"], "training");
+    EXPECT_EQ(events[0]["tid"], events[1]["tid"]);
+
+    const double outer_ts = events[1]["ts"], outer_dur = events[1]["dur"];
+    const double inner_ts = events[0]["ts"], inner_dur = events[0]["dur"];
+    EXPECT_GE(outer_dur, 3000.0); // Microseconds
+    EXPECT_GE(inner_ts, outer_ts);
+    EXPECT_LE(inner_ts + inner_dur, outer_ts + outer_dur);
+
+    bool named = false;
+    for (const auto& e : trace["traceEvents"]) {
+        named |= e["ph"] == "M" && e["name"] == "thread_name" && e["args"]["name"] == "test \"main\"";
+    }
+    EXPECT_TRUE(named);
+}
+
+TEST_F(PerfTraceTest, LogTimerFeedsTrace) {
+    trace::start();
+    {
+        LOG_TIMER_TRACE("timed scope");
+    }
+    ASSERT_TRUE(trace::write_chrome_trace(path_));
+    const auto events = complete_events(read_trace());
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0]["name"], "timed scope");
+}
+
+TEST_F(PerfTraceTest, ThreadsGetSeparateTracks) {
+    trace::start();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            trace::set_thread_name("worker " + std::to_string(t));
+            for (int i = 0; i < 100; ++i) {
+                LFS_TRACE_SCOPE(Loader, "work");
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    ASSERT_TRUE(trace::write_chrome_trace(path_));
+    const auto events = complete_events(read_trace());
+    EXPECT_EQ(events.size(), 400u);
+    std::set<int> tids;
+    for (const auto& e : events)
+        tids.insert(e["tid"].get<int>());
+    EXPECT_EQ(tids.size(), 4u);
+}
+
+TEST_F(PerfTraceTest, RingBufferKeepsNewestEvents) {
+    trace::start(8);
+    for (int i = 0; i < 20; ++i) {
+        trace::record(trace::Category::Core, "event " + std::to_string(i), i * 1000, i * 1000 + 10);
+    }
+    const auto stats = trace::stats();
+    EXPECT_EQ(stats.events, 8u);
+    EXPECT_EQ(stats.dropped, 12u);
+
+    ASSERT_TRUE(trace::write_chrome_trace(path_));
+    const auto events = complete_events(read_trace());
+    ASSERT_EQ(events.size(), 8u);
+    EXPECT_EQ(events.front()["name"], "event 12");
+    EXPECT_EQ(events.back()["name"], "event 19");
+}
+
+TEST_F(PerfTraceTest, DumpUsesConfiguredOutput) {
+    trace::start();
+    {
+        LFS_TRACE_SCOPE(IO, "read");
+    }
+    trace::set_output(path_);
+    ASSERT_TRUE(trace::dump());
+    EXPECT_EQ(complete_events(read_trace()).size(), 1u);
+    trace::set_output({});
+    EXPECT_FALSE(trace::dump());
+}
+
+TEST_F(PerfTraceTest, ScopeOverhead) {
+    constexpr int N = 1'000'000;
+    const auto time_ns = [&] {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < N; ++i) {
+            LFS_TRACE_SCOPE(Core, "overhead");
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / N;
+    };
+
+    const double disabled = time_ns();
+    trace::start(1 << 12);
+    const double enabled = time_ns();
+    std::cout << "\nLFS_TRACE_SCOPE cost: " << disabled << " ns stopped, " << enabled << " ns recording\n";
+    EXPECT_LT(disabled, 20.0);
+}
+
+#endif // LFS_PERF_TRACING
@@ -0,0 +1,258 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/snapshot_publisher.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    // Every element carries the publish number, so a torn read shows up as a mismatch
+    struct Stamped {
+        std::vector<uint64_t> values;
+    };
+
+    void fill_stamped(Stamped& s, const uint64_t stamp, const size_t size = 4096) {
+        s.values.resize(size);
+        std::fill(s.values.begin(), s.values.end(), stamp);
+    }
+
+    bool consistent(const Stamped& s) {
+        return std::all_of(s.values.begin(), s.values.end(), [&](const uint64_t v) { return v == s.values.front(); });
+    }
+
+} // namespace
+
+TEST(SnapshotPublisherTest, InactivePinsAreLive) {
+    SnapshotPublisher<Stamped> publisher;
+    const auto pin = publisher.pin();
+    EXPECT_TRUE(pin.live());
+    EXPECT_EQ(pin.get(), nullptr);
+}
+
+TEST(SnapshotPublisherTest, ActiveWithoutPublishIsEmpty) {
+    SnapshotPublisher<Stamped> publisher;
+    publisher.activate();
+    const auto pin = publisher.pin();
+    EXPECT_FALSE(pin.live());
+    EXPECT_EQ(pin.get(), nullptr);
+}
+
+TEST(SnapshotPublisherTest, PublishAlternatesBuffers) {
+    SnapshotPublisher<Stamped> publisher;
+    publisher.activate();
+
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 1); }));
+    const Stamped* first = publisher.pin().get();
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->values.front(), 1u);
+
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 2); }));
+    const Stamped* second = publisher.pin().get();
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second->values.front(), 2u);
+
+    // The third publish reuses the first buffer and sees its old contents
+    ASSERT_TRUE(publisher.publish([](Stamped& s) {
+        EXPECT_EQ(s.values.front(), 1u);
+        fill_stamped(s, 3);
+    }));
+    EXPECT_EQ(publisher.pin().get(), first);
+}
+
+TEST(SnapshotPublisherTest, SequenceDistinguishesReusedBuffers) {
+    SnapshotPublisher<Stamped> publisher;
+    EXPECT_EQ(publisher.pin().sequence(), 0u); // Live
+    publisher.activate();
+    EXPECT_EQ(publisher.pin().sequence(), 0u); // Nothing published yet
+
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 1); }));
+    const Stamped* first = publisher.pin().get();
+    EXPECT_EQ(publisher.pin().sequence(), 1u);
+
+    // The third publish reuses the first buffer; only the sequence tells them apart
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 2); }));
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 3); }));
+    auto pin = publisher.pin();
+    EXPECT_EQ(pin.get(), first);
+    EXPECT_EQ(pin.sequence(), 3u);
+
+    auto moved = std::move(pin);
+    EXPECT_EQ(moved.sequence(), 3u);
+    EXPECT_EQ(pin.sequence(), 0u);
+}
+
+TEST(SnapshotPublisherTest, SkipsInsteadOfBlockingWhenBothPinned) {
+    SnapshotPublisher<Stamped> publisher;
+    publisher.activate();
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 1); }));
+    const auto old_pin = publisher.pin();
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 2); }));
+    const auto new_pin = publisher.pin();
+
+    // The free buffer is the one old_pin holds
+    EXPECT_FALSE(publisher.publish([](Stamped&) { ADD_FAILURE() << "wrote a pinned buffer"; }));
+    EXPECT_EQ(old_pin->values.front(), 1u);
+    EXPECT_EQ(new_pin->values.front(), 2u);
+    EXPECT_EQ(publisher.stats().skipped, 1u);
+}
+
+TEST(SnapshotPublisherTest, RequestIsClearedByPublish) {
+    SnapshotPublisher<Stamped> publisher;
+    publisher.activate();
+    EXPECT_FALSE(publisher.requested());
+    publisher.request();
+    EXPECT_TRUE(publisher.requested());
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 1); }));
+    EXPECT_FALSE(publisher.requested());
+}
+
+TEST(SnapshotPublisherTest, ActivateWaitsForLiveReaders) {
+    SnapshotPublisher<Stamped> publisher;
+    auto live = std::make_unique<SnapshotPublisher<Stamped>::Pin>(publisher.pin());
+    ASSERT_TRUE(live->live());
+
+    std::atomic<bool> activated{false};
+    std::thread writer([&] {
+        publisher.activate();
+        activated = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(activated.load());
+
+    // New readers already see the active state while the writer waits
+    EXPECT_FALSE(publisher.pin().live());
+
+    live.reset();
+    writer.join();
+    EXPECT_TRUE(activated.load());
+    EXPECT_GE(publisher.stats().activate_wait_ms, 40.0);
+}
+
+TEST(SnapshotPublisherTest, ResetWaitsForPinsAndFallsBackToLive) {
+    SnapshotPublisher<Stamped> publisher;
+    publisher.activate();
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 7); }));
+    auto pin = std::make_unique<SnapshotPublisher<Stamped>::Pin>(publisher.pin());
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        publisher.deactivate();
+        publisher.reset();
+        done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(done.load());
+    EXPECT_EQ((*pin)->values.front(), 7u); // Still valid while pinned
+
+    pin.reset();
+    writer.join();
+    EXPECT_TRUE(publisher.pin().live());
+}
+
+TEST(SnapshotPublisherTest, ConcurrentReadersNeverSeeTornSnapshots) {
+    SnapshotPublisher<Stamped> publisher;
+    publisher.activate();
+    ASSERT_TRUE(publisher.publish([](Stamped& s) { fill_stamped(s, 0); }));
+
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> reads{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            uint64_t last = 0;
+            while (!stop.load()) {
+                const auto pin = publisher.pin();
+                ASSERT_NE(pin.get(), nullptr);
+                if (!consistent(*pin.get()) || pin->values.front() < last)
+                    ++torn;
+                last = pin->values.front();
+                ++reads;
+            }
+        });
+    }
+
+    uint64_t published = 0;
+    for (uint64_t stamp = 1; stamp <= 2000; ++stamp) {
+        published += publisher.publish([stamp](Stamped& s) { fill_stamped(s, stamp); });
+    }
+    stop = true;
+    for (auto& t : readers)
+        t.join();
+
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_GT(reads.load(), 0u);
+    const auto stats = publisher.stats();
+    EXPECT_EQ(stats.publishes, published + 1);
+    EXPECT_EQ(stats.publishes + stats.skipped, 2001u);
+}
+
+TEST(SnapshotPublisherBenchmark, WriterStallVersusSharedMutex) {
+    // A reader that renders for 5 ms every frame against a writer stepping every 1 ms;
+    // with the shared mutex each mutation waits for the frame in progress
+    constexpr int STEPS = 300;
+    constexpr auto FRAME = std::chrono::milliseconds(5);
+    constexpr auto STEP = std::chrono::milliseconds(1);
+
+    const auto run = [&](auto&& mutate, auto&& read) {
+        std::atomic<bool> stop{false};
+        std::thread reader([&] {
+            while (!stop.load())
+                read();
+        });
+        double max_stall_ms = 0.0, total_ms = 0.0;
+        for (int i = 0; i < STEPS; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            mutate(i);
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            max_stall_ms = std::max(max_stall_ms, ms);
+            total_ms += ms;
+            std::this_thread::sleep_for(STEP);
+        }
+        stop = true;
+        reader.join();
+        return std::pair{total_ms / STEPS, max_stall_ms};
+    };
+
+    Stamped live;
+    fill_stamped(live, 0);
+    std::shared_mutex mutex;
+    const auto [mutex_avg, mutex_max] = run(
+        [&](const int i) {
+            std::unique_lock lock(mutex);
+            fill_stamped(live, i);
+        },
+        [&] {
+            std::shared_lock lock(mutex);
+            std::this_thread::sleep_for(FRAME);
+        });
+
+    SnapshotPublisher<Stamped> publisher;
+    publisher.activate();
+    const auto [rcu_avg, rcu_max] = run(
+        [&](const int i) {
+            fill_stamped(live, i);
+            publisher.publish([&](Stamped& s) { s.values = live.values; });
+        },
+        [&] {
+            const auto pin = publisher.pin();
+            std::this_thread::sleep_for(FRAME);
+        });
+
+    const auto stats = publisher.stats();
+    std::cout << "\nWriter time per step with a reader rendering " << FRAME.count() << " ms frames:\n"
+              << "  shared_mutex:       avg " << mutex_avg << " ms, max " << mutex_max << " ms\n"
+              << "  snapshot publisher: avg " << rcu_avg << " ms, max " << rcu_max << " ms ("
+              << stats.publishes << " published, " << stats.skipped << " skipped, reader wait max "
+              << stats.max_reader_wait_us << " us)\n";
+    EXPECT_LT(rcu_avg, mutex_avg);
+}
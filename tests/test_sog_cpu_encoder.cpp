@@ -0,0 +1,399 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+/**
+ * @file test_sog_cpu_encoder.cpp
+ * @brief Host SOG encoder (SogSaveOptions::use_gpu = false)
+ *
+ * The host Morton sort must reproduce the GPU ordering exactly, and a CPU
+ * export must produce the same archive layout and meta.json schema as a GPU
+ * export so viewers cannot tell them apart.
+ */
+
+#include "core/splat_data.hpp"
+#include "core/tensor.hpp"
+#include "io/cpu/kmeans_cpu.hpp"
+#include "io/cpu/morton_encoding_cpu.hpp"
+#include "io/cuda/kmeans.hpp"
+#include "io/cuda/morton_encoding.hpp"
+#include "io/exporter.hpp"
+#include "io/formats/sogs.hpp"
+#include <algorithm>
+#include <archive.h>
+#include <archive_entry.h>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <numeric>
+#include <random>
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+#include <vector>
+#include <webp/decode.h>
+
+using namespace lfs::core;
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+    SplatData make_splat(size_t n, int sh_degree, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        const auto fill = [&](Tensor& t, float scale, float offset) {
+            float* const p = t.ptr<float>();
+            for (size_t i = 0; i < t.numel(); ++i)
+                p[i] = offset + scale * normal(gen);
+        };
+
+        const size_t sh_coeffs = static_cast<size_t>((sh_degree + 1) * (sh_degree + 1) - 1);
+        auto means = Tensor::empty({n, 3}, Device::CPU, DataType::Float32);
+        auto sh0 = Tensor::empty({n, 1, 3}, Device::CPU, DataType::Float32);
+        auto shN = Tensor::empty({n, sh_coeffs, 3}, Device::CPU, DataType::Float32);
+        auto scaling = Tensor::empty({n, 3}, Device::CPU, DataType::Float32);
+        auto rotation = Tensor::empty({n, 4}, Device::CPU, DataType::Float32);
+        auto opacity = Tensor::empty({n, 1}, Device::CPU, DataType::Float32);
+        fill(means, 5.0f, 0.0f);
+        fill(sh0, 0.5f, 0.0f);
+        fill(shN, 0.1f, 0.0f);
+        fill(scaling, 1.0f, -4.0f);
+        fill(rotation, 1.0f, 0.0f);
+        fill(opacity, 2.0f, 0.0f);
+
+        return SplatData(sh_degree, std::move(means), std::move(sh0), std::move(shN),
+                         std::move(scaling), std::move(rotation), std::move(opacity), 1.0f);
+    }
+
+    std::map<std::string, std::vector<uint8_t>> extract_zip_files(const fs::path& path) {
+        std::map<std::string, std::vector<uint8_t>> files;
+        archive* a = archive_read_new();
+        archive_read_support_format_zip(a);
+
+        if (archive_read_open_filename(a, path.c_str(), 10240) != ARCHIVE_OK) {
+            archive_read_free(a);
+            return files;
+        }
+
+        archive_entry* entry;
+        while (archive_read_next_header(a, &entry) == ARCHIVE_OK) {
+            const char* name = archive_entry_pathname(entry);
+            const size_t size = archive_entry_size(entry);
+            std::vector<uint8_t> data(size);
+            archive_read_data(a, data.data(), size);
+            files[name] = std::move(data);
+        }
+
+        archive_read_free(a);
+        return files;
+    }
+
+    // Same keys, value types and array lengths at every level; values may differ
+    void expect_same_layout(const json& a, const json& b, const std::string& path) {
+        ASSERT_EQ(a.type(), b.type()) << "type differs at " << path;
+        if (a.is_object()) {
+            std::vector<std::string> keys_a, keys_b;
+            for (const auto& [key, value] : a.items())
+                keys_a.push_back(key);
+            for (const auto& [key, value] : b.items())
+                keys_b.push_back(key);
+            ASSERT_EQ(keys_a, keys_b) << "keys differ at " << path;
+            for (const auto& key : keys_a)
+                expect_same_layout(a[key], b[key], path + "." + key);
+        } else if (a.is_array()) {
+            ASSERT_EQ(a.size(), b.size()) << "array length differs at " << path;
+            for (size_t i = 0; i < a.size(); ++i)
+                expect_same_layout(a[i], b[i], path + "[" + std::to_string(i) + "]");
+        } else if (a.is_string()) {
+            EXPECT_EQ(a, b) << "string differs at " << path;
+        }
+    }
+
+    std::vector<uint8_t> decode_webp(const std::vector<uint8_t>& data) {
+        int width = 0, height = 0;
+        uint8_t* rgba = WebPDecodeRGBA(data.data(), data.size(), &width, &height);
+        if (!rgba)
+            return {};
+        std::vector<uint8_t> pixels(rgba, rgba + static_cast<size_t>(width) * height * 4);
+        WebPFree(rgba);
+        return pixels;
+    }
+
+    template <typename F>
+    double time_ms(F&& f) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+} // namespace
+
+TEST(SogCpuEncoderTest, MortonCodesMatchGpu) {
+    auto splat = make_splat(200'000, 0, 1);
+    const auto& means = splat.means_raw();
+
+    const auto cpu_codes = lfs::io::morton_encode_cpu(means);
+    const auto gpu_codes = lfs::io::morton_encode(means.cuda()).cpu();
+    ASSERT_TRUE(cpu_codes.is_valid());
+    ASSERT_EQ(cpu_codes.numel(), gpu_codes.numel());
+    for (size_t i = 0; i < cpu_codes.numel(); ++i)
+        ASSERT_EQ(cpu_codes.ptr<int64_t>()[i], gpu_codes.ptr<int64_t>()[i]) << "point " << i;
+
+    const auto cpu_order = lfs::io::morton_sort_indices_cpu(cpu_codes);
+    const auto gpu_order = lfs::io::morton_sort_indices(gpu_codes.cuda()).cpu();
+    for (size_t i = 0; i < cpu_order.numel(); ++i)
+        ASSERT_EQ(cpu_order.ptr<int64_t>()[i], gpu_order.ptr<int64_t>()[i]) << "rank " << i;
+}
+
+TEST(SogCpuEncoderTest, RadixSortIsStable) {
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int64_t> digit(0, (int64_t{1} << 30) - 1);
+    std::vector<int64_t> codes(300'001);
+    for (size_t i = 0; i < codes.size(); ++i)
+        codes[i] = (i % 3 == 0) ? 12345 : digit(gen); // Many duplicates
+
+    const auto tensor = Tensor::from_blob(codes.data(), {codes.size()}, Device::CPU, DataType::Int64);
+    const auto order = lfs::io::morton_sort_indices_cpu(tensor);
+
+    std::vector<int64_t> expected(codes.size());
+    std::iota(expected.begin(), expected.end(), int64_t{0});
+    std::stable_sort(expected.begin(), expected.end(), [&](int64_t a, int64_t b) { return codes[a] < codes[b]; });
+    for (size_t i = 0; i < expected.size(); ++i)
+        ASSERT_EQ(order.ptr<int64_t>()[i], expected[i]) << "rank " << i;
+
+    // All-zero keys need no passes and keep the input order
+    std::vector<int64_t> zeros(100, 0);
+    const auto identity = lfs::io::morton_sort_indices_cpu(
+        Tensor::from_blob(zeros.data(), {zeros.size()}, Device::CPU, DataType::Int64));
+    for (size_t i = 0; i < zeros.size(); ++i)
+        EXPECT_EQ(identity.ptr<int64_t>()[i], static_cast<int64_t>(i));
+}
+
+TEST(SogCpuEncoderTest, Kmeans1dLabelsAreNearestSortedCentroid) {
+    std::mt19937 gen(3);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::vector<float> values(100'000);
+    for (auto& v : values)
+        v = normal(gen);
+    const auto data = Tensor::from_blob(values.data(), {values.size(), 1}, Device::CPU, DataType::Float32);
+
+    auto [centroids, labels] = lfs::io::kmeans_1d_cpu(data, 256, 10);
+    ASSERT_EQ(centroids.shape()[0], 256u);
+    ASSERT_EQ(labels.dtype(), DataType::Int32);
+    const float* const c = centroids.ptr<float>();
+    EXPECT_TRUE(std::is_sorted(c, c + 256));
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        const int label = labels.ptr<int>()[i];
+        ASSERT_GE(label, 0);
+        ASSERT_LT(label, 256);
+        const float own = std::abs(values[i] - c[label]);
+        for (int k = 0; k < 256; ++k)
+            ASSERT_LE(own, std::abs(values[i] - c[k])) << "value " << i;
+    }
+
+    // Same initialization and update rule as the GPU version
+    auto [gpu_centroids, gpu_labels] = lfs::io::kmeans_1d(data.cuda(), 256, 10);
+    const auto gpu_c = gpu_centroids.cpu();
+    const float range = c[255] - c[0];
+    for (int k = 0; k < 256; ++k)
+        EXPECT_NEAR(c[k], gpu_c.ptr<float>()[k], 0.01f * range) << "centroid " << k;
+
+    // Fewer values than clusters: one centroid per value, padded to k
+    std::vector<float> tiny = {3.0f, -1.0f, 2.0f};
+    auto [tiny_c, tiny_l] = lfs::io::kmeans_1d_cpu(
+        Tensor::from_blob(tiny.data(), {tiny.size()}, Device::CPU, DataType::Float32), 256, 10);
+    ASSERT_EQ(tiny_c.shape()[0], 256u);
+    for (size_t i = 0; i < tiny.size(); ++i)
+        EXPECT_EQ(tiny_c.ptr<float>()[tiny_l.ptr<int>()[i]], tiny[i]);
+}
+
+TEST(SogCpuEncoderTest, KmeansRecoversSeparatedClusters) {
+    constexpr int K = 32;
+    constexpr int DIMS = 9;
+    constexpr size_t N = 64'000;
+    constexpr float NOISE = 0.05f;
+
+    std::mt19937 gen(4);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::vector<float> centers(K * DIMS);
+    for (auto& c : centers)
+        c = 10.0f * normal(gen);
+    std::vector<float> points(N * DIMS);
+    for (size_t i = 0; i < N; ++i)
+        for (int d = 0; d < DIMS; ++d)
+            points[i * DIMS + d] = centers[(i % K) * DIMS + d] + NOISE * normal(gen);
+
+    const auto data = Tensor::from_blob(points.data(), {N, DIMS}, Device::CPU, DataType::Float32);
+    auto [centroids, labels] = lfs::io::kmeans_cpu(data, K, 10);
+    ASSERT_EQ(centroids.shape()[0], static_cast<size_t>(K));
+    ASSERT_EQ(centroids.shape()[1], static_cast<size_t>(DIMS));
+
+    // k-means++ seeding finds every blob, so each point sits at noise distance
+    double error = 0.0;
+    for (size_t i = 0; i < N; ++i) {
+        const float* const c = centroids.ptr<float>() + labels.ptr<int>()[i] * DIMS;
+        for (int d = 0; d < DIMS; ++d)
+            error += (points[i * DIMS + d] - c[d]) * (points[i * DIMS + d] - c[d]);
+    }
+    EXPECT_LT(error / N, 2.0 * DIMS * NOISE * NOISE);
+
+    // Deterministic: a second run gives identical labels
+    auto [centroids2, labels2] = lfs::io::kmeans_cpu(data, K, 10);
+    for (size_t i = 0; i < N; ++i)
+        ASSERT_EQ(labels.ptr<int>()[i], labels2.ptr<int>()[i]);
+}
+
+TEST(SogCpuEncoderTest, HierarchicalKmeansLabelsAreValid) {
+    constexpr int K = 4096;
+    constexpr size_t N = 40'000;
+    const auto data = Tensor::randn({N, 24}, Device::CPU);
+
+    auto [centroids, labels] = lfs::io::kmeans_cpu(data, K, 3);
+    ASSERT_EQ(centroids.shape()[0], static_cast<size_t>(K));
+    ASSERT_EQ(labels.numel(), N);
+    for (size_t i = 0; i < N; ++i) {
+        ASSERT_GE(labels.ptr<int>()[i], 0);
+        ASSERT_LT(labels.ptr<int>()[i], K);
+    }
+}
+
+TEST(SogCpuEncoderTest, CpuExportMatchesGpuLayout) {
+    const auto splat = make_splat(20'000, 2, 5);
+    const fs::path gpu_path = fs::temp_directory_path() / "lfs_sog_gpu.sog";
+    const fs::path cpu_path = fs::temp_directory_path() / "lfs_sog_cpu.sog";
+
+    ASSERT_TRUE(lfs::io::save_sog(splat, {.output_path = gpu_path, .kmeans_iterations = 5, .use_gpu = true}).has_value());
+    ASSERT_TRUE(lfs::io::save_sog(splat, {.output_path = cpu_path, .kmeans_iterations = 5, .use_gpu = false}).has_value());
+
+    auto gpu_files = extract_zip_files(gpu_path);
+    auto cpu_files = extract_zip_files(cpu_path);
+    auto reloaded = lfs::io::load_sog(cpu_path, Device::CPU);
+    fs::remove(gpu_path);
+    fs::remove(cpu_path);
+
+    ASSERT_TRUE(reloaded.has_value()) << reloaded.error();
+    EXPECT_EQ(reloaded->size(), splat.size());
+
+    std::vector<std::string> gpu_names, cpu_names;
+    for (const auto& [name, data] : gpu_files)
+        gpu_names.push_back(name);
+    for (const auto& [name, data] : cpu_files)
+        cpu_names.push_back(name);
+    ASSERT_EQ(gpu_names, cpu_names);
+
+    const auto gpu_meta = json::parse(gpu_files["meta.json"].begin(), gpu_files["meta.json"].end());
+    const auto cpu_meta = json::parse(cpu_files["meta.json"].begin(), cpu_files["meta.json"].end());
+    expect_same_layout(gpu_meta, cpu_meta, "meta");
+    EXPECT_EQ(cpu_meta["count"], gpu_meta["count"]);
+    EXPECT_EQ(cpu_meta["means"], gpu_meta["means"]);
+    EXPECT_EQ(cpu_meta["shN"]["count"], gpu_meta["shN"]["count"]);
+
+    // Positions and rotations do not go through k-means: same Morton order gives identical textures
+    EXPECT_EQ(cpu_files["means_l.webp"], gpu_files["means_l.webp"]);
+    EXPECT_EQ(cpu_files["means_u.webp"], gpu_files["means_u.webp"]);
+    EXPECT_EQ(cpu_files["quats.webp"], gpu_files["quats.webp"]);
+}
+
+TEST(SogCpuEncoderTest, WebpEffortKeepsPixelsAndOrder) {
+    // Transparent splats exercise RGB under zero alpha in sh0.webp
+    const auto splat = make_splat(30'000, 1, 7);
+    const auto export_files = [&](int effort) {
+        const fs::path path = fs::temp_directory_path() / std::format("lfs_sog_effort_{}.sog", effort + 1);
+        auto result = lfs::io::save_sog(splat, {.output_path = path, .kmeans_iterations = 3, .use_gpu = false, .webp_effort = effort});
+        EXPECT_TRUE(result.has_value()) << (result ? "" : result.error().format());
+        auto files = extract_zip_files(path);
+        fs::remove(path);
+        return files;
+    };
+
+    auto reference = export_files(-1);
+    ASSERT_EQ(reference.size(), 8u);
+    for (const int effort : {0, 9}) {
+        auto files = export_files(effort);
+        ASSERT_EQ(files.size(), reference.size());
+        EXPECT_EQ(files["meta.json"], reference["meta.json"]) << "effort " << effort;
+        for (const auto& [name, data] : reference) {
+            if (name.ends_with(".webp")) {
+                EXPECT_EQ(decode_webp(files[name]), decode_webp(data)) << name << " at effort " << effort;
+            }
+        }
+    }
+}
+
+TEST(SogCpuEncoderTest, InMemoryArchiveMatchesFileExport) {
+    const auto splat = make_splat(10'000, 1, 8);
+    const lfs::io::SogSaveOptions options{
+        .output_path = fs::temp_directory_path() / "lfs_sog_file.sog", .kmeans_iterations = 3, .use_gpu = false};
+
+    ASSERT_TRUE(lfs::io::save_sog(splat, options).has_value());
+    auto memory = lfs::io::save_sog_to_memory(splat, options);
+    ASSERT_TRUE(memory.has_value()) << memory.error().format();
+
+    const fs::path memory_path = fs::temp_directory_path() / "lfs_sog_memory.sog";
+    {
+        std::ofstream out(memory_path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(memory->data()), static_cast<std::streamsize>(memory->size()));
+    }
+    const auto file_contents = extract_zip_files(options.output_path);
+    const auto memory_contents = extract_zip_files(memory_path);
+    fs::remove(options.output_path);
+    fs::remove(memory_path);
+
+    ASSERT_EQ(file_contents.size(), 8u);
+    EXPECT_EQ(memory_contents, file_contents);
+}
+
+TEST(SogCpuEncoderTest, ExportCompletesWithoutTbbWorkers) {
+    // A single-slot arena, as on a 1-CPU container: only the calling thread can run encode tasks
+    const auto splat = make_splat(5'000, 1, 9);
+    const fs::path path = fs::temp_directory_path() / "lfs_sog_single_thread.sog";
+    const tbb::global_control limit(tbb::global_control::max_allowed_parallelism, 1);
+    tbb::task_arena arena(1);
+
+    lfs::io::Result<void> result;
+    arena.execute([&] { result = lfs::io::save_sog(splat, {.output_path = path, .kmeans_iterations = 2, .use_gpu = false}); });
+    ASSERT_TRUE(result.has_value()) << result.error().format();
+    EXPECT_EQ(extract_zip_files(path).size(), 8u);
+    fs::remove(path);
+}
+
+TEST(SogCpuEncoderTest, EncoderThroughputBenchmark) {
+    std::cout << "\n=== SOG encoder stages: CPU vs GPU ===\n"
+              << std::fixed << std::setprecision(1);
+    for (const size_t n : {1'000'000ul, 5'000'000ul}) {
+        const auto splat = make_splat(n, 1, 6);
+        const auto& means = splat.means_raw();
+        const auto scales = splat.scaling_raw().reshape({static_cast<int>(n * 3), 1});
+        const auto shN = splat.shN_raw().reshape({static_cast<int>(n), 9});
+        const int palette = std::clamp(
+            std::min(64, static_cast<int>(std::pow(2, std::floor(std::log2(n / 1024.0))))) * 1024, 1024, static_cast<int>(n));
+
+        const double morton_cpu = time_ms([&] {
+            lfs::io::morton_sort_indices_cpu(lfs::io::morton_encode_cpu(means));
+        });
+        const auto means_cuda = means.cuda();
+        const double morton_gpu = time_ms([&] {
+            lfs::io::morton_sort_indices(lfs::io::morton_encode(means_cuda)).cpu();
+        });
+
+        const double cluster_cpu = time_ms([&] { lfs::io::kmeans_1d_cpu(scales, 256, 10); });
+        const auto scales_cuda = scales.cuda();
+        const double cluster_gpu = time_ms([&] { std::get<1>(lfs::io::kmeans_1d(scales_cuda, 256, 10)).cpu(); });
+
+        const double sh_cpu = time_ms([&] { lfs::io::kmeans_cpu(shN, palette, 1); });
+        const auto shN_cuda = shN.cuda();
+        const double sh_gpu = time_ms([&] { std::get<1>(lfs::io::kmeans(shN_cuda, palette, 1)).cpu(); });
+
+        std::cout << "  " << std::setw(9) << n << " splats"
+                  << " | morton+sort " << morton_cpu << " vs " << morton_gpu << " ms"
+                  << " | scales k-means (3N, 10 it) " << cluster_cpu << " vs " << cluster_gpu << " ms"
+                  << " | shN k-means (k=" << palette << ", 1 it) " << sh_cpu << " vs " << sh_gpu << " ms\n";
+    }
+}
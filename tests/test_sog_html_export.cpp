@@ -429,6 +429,35 @@ TEST_F(HtmlExportTest, UsesSogExtension) {
         << "Should not use .compressed.ply extension";
 }
 
+// Test: io::export_html streams a SOG that decodes and loads back
+TEST_F(HtmlExportTest, EmbeddedSogRoundtrip) {
+    if (!fs::exists(TEST_PLY)) {
+        GTEST_SKIP() << "Test PLY not found: " << TEST_PLY;
+    }
+
+    auto ply_result = lfs::io::load_ply(TEST_PLY);
+    ASSERT_TRUE(ply_result.has_value());
+
+    auto result = lfs::io::export_html(*ply_result, {.output_path = temp_html_});
+    ASSERT_TRUE(result.has_value()) << result.error().format();
+
+    const std::string base64_sog = extract_base64_sog(read_file(temp_html_));
+    ASSERT_FALSE(base64_sog.empty()) << "Could not extract base64 SOG";
+    EXPECT_EQ(base64_sog.size() % 4, 0u);
+
+    const auto sog_data = base64_decode(base64_sog);
+    const fs::path sog_path = fs::temp_directory_path() / "test_export_embedded.sog";
+    {
+        std::ofstream out(sog_path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(sog_data.data()), static_cast<std::streamsize>(sog_data.size()));
+    }
+    auto loaded = lfs::io::load_sog(sog_path);
+    fs::remove(sog_path);
+
+    ASSERT_TRUE(loaded.has_value()) << loaded.error();
+    EXPECT_EQ(loaded->size(), ply_result->size());
+}
+
 // ============================================================================
 // Cluster1D Tests (K-means for SOG SH data)
 // ============================================================================
@@ -0,0 +1,211 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include "core/tensor_archive.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace lfs::core;
+namespace fs = std::filesystem;
+
+namespace {
+
+    // Records the tensors handed to it, like the checkpoint snapshot does
+    class CollectingSink : public TensorRecordSink {
+    public:
+        uint64_t put(const Tensor& tensor) override {
+            tensors.push_back(tensor.cpu());
+            return tensors.size() - 1;
+        }
+
+        std::vector<Tensor> tensors;
+    };
+
+} // namespace
+
+class TensorArchiveTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_dir_ = fs::temp_directory_path() / "tensor_archive_test";
+        fs::create_directories(temp_dir_);
+        Tensor::manual_seed(42);
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove_all(temp_dir_, ec);
+    }
+
+    fs::path write_archive(const std::string& name, const std::vector<std::pair<std::string, Tensor>>& tensors,
+                           const bool compress, const std::string& prefix = {}) const {
+        const auto path = temp_dir_ / name;
+        std::ofstream file(path, std::ios::binary);
+        file.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+        TensorArchiveWriter writer(file, {.compress = compress});
+        for (const auto& [entry_name, tensor] : tensors) {
+            writer.add(entry_name, tensor);
+        }
+        EXPECT_TRUE(writer.finish());
+        return path;
+    }
+
+    fs::path temp_dir_;
+};
+
+TEST_F(TensorArchiveTest, TocDescribesEntries) {
+    const auto means = Tensor::randn({1000, 3}, Device::CPU);
+    const auto ids = Tensor::from_vector(std::vector<int>{1, 2, 3, 4, 5, 6}, {2, 3}, Device::CPU);
+    const auto path = write_archive("toc.lfta", {{"means", means}, {"ids", ids}}, false, "HEAD");
+
+    auto archive = TensorArchive::open(path);
+    ASSERT_TRUE(archive.has_value()) << archive.error();
+    const auto& entries = (*archive)->entries();
+    ASSERT_EQ(entries.size(), 2u);
+
+    EXPECT_EQ(entries[0].name, "means");
+    EXPECT_EQ(entries[0].dtype, DataType::Float32);
+    EXPECT_EQ(entries[0].shape, (std::vector<size_t>{1000, 3}));
+    EXPECT_EQ(entries[1].name, "ids");
+    EXPECT_EQ(entries[1].dtype, DataType::Int32);
+    EXPECT_EQ(entries[1].shape, (std::vector<size_t>{2, 3}));
+    for (const auto& entry : entries) {
+        EXPECT_EQ(entry.offset % TENSOR_ARCHIVE_ALIGNMENT, 0u) << entry.name;
+        EXPECT_EQ(entry.codec, TensorCodec::Stored);
+    }
+
+    ASSERT_GE((*archive)->prefix().size(), 4u);
+    EXPECT_EQ(std::string((*archive)->prefix().data(), 4), "HEAD");
+    EXPECT_EQ((*archive)->find("missing"), nullptr);
+}
+
+TEST_F(TensorArchiveTest, StoredEntriesAreMappedInPlace) {
+    const auto means = Tensor::randn({4096, 3}, Device::CPU);
+    const auto path = write_archive("mapped.lfta", {{"means", means}}, false);
+
+    Tensor loaded;
+    {
+        auto archive = TensorArchive::open(path);
+        ASSERT_TRUE(archive.has_value()) << archive.error();
+        loaded = (*archive)->load(0);
+        EXPECT_EQ((*archive)->load(0).ptr<float>(), loaded.ptr<float>());
+    }
+
+    // The view keeps the mapping alive after the archive is gone
+    EXPECT_EQ(loaded.device(), Device::CPU);
+    EXPECT_EQ(loaded.to_vector(), means.to_vector());
+
+    // Copy-on-write: modifying the view does not touch the file
+    loaded.fill_(0.0f);
+    auto reopened = TensorArchive::open(path);
+    ASSERT_TRUE(reopened.has_value());
+    EXPECT_EQ((*reopened)->load(0).to_vector(), means.to_vector());
+}
+
+TEST_F(TensorArchiveTest, CompressedEntriesRoundTrip) {
+    const auto zeros = Tensor::zeros({100'000}, Device::CPU);
+    const auto noise = Tensor::randn({256, 4}, Device::CPU);
+    const auto path = write_archive("compressed.lfta", {{"zeros", zeros}, {"noise", noise}}, true);
+
+    auto archive = TensorArchive::open(path);
+    ASSERT_TRUE(archive.has_value()) << archive.error();
+    const auto* const zeros_entry = (*archive)->find("zeros");
+    ASSERT_NE(zeros_entry, nullptr);
+    EXPECT_EQ(zeros_entry->codec, TensorCodec::Zstd);
+    EXPECT_LT(zeros_entry->stored_size, zeros_entry->raw_size / 10);
+
+    EXPECT_EQ((*archive)->load(0).to_vector(), zeros.to_vector());
+    EXPECT_EQ((*archive)->load(1).to_vector(), noise.to_vector());
+}
+
+TEST_F(TensorArchiveTest, CorruptEntryFailsOnlyWhenLoaded) {
+    const auto a = Tensor::randn({1024}, Device::CPU);
+    const auto b = Tensor::randn({1024}, Device::CPU);
+    const auto path = write_archive("corrupt.lfta", {{"a", a}, {"b", b}}, false);
+
+    uint64_t offset = 0;
+    {
+        auto archive = TensorArchive::open(path);
+        ASSERT_TRUE(archive.has_value());
+        offset = (*archive)->find("b")->offset + 100;
+    }
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.put('\x7f');
+    }
+
+    auto archive = TensorArchive::open(path);
+    ASSERT_TRUE(archive.has_value()) << archive.error();
+    EXPECT_EQ((*archive)->load(0).to_vector(), a.to_vector());
+    EXPECT_THROW((*archive)->load(1), std::runtime_error);
+}
+
+TEST_F(TensorArchiveTest, RejectsFilesWithoutFooter) {
+    const auto path = temp_dir_ / "not_an_archive.bin";
+    std::ofstream(path, std::ios::binary) << "definitely not a tensor archive";
+
+    auto archive = TensorArchive::open(path);
+    ASSERT_FALSE(archive.has_value());
+    EXPECT_NE(archive.error().find("Not a tensor archive"), std::string::npos) << archive.error();
+}
+
+TEST_F(TensorArchiveTest, StreamReferencesResolveThroughArchive) {
+    const auto first = Tensor::randn({64, 3}, Device::CPU);
+    const auto second = Tensor::from_vector(std::vector<int>{7, 8, 9}, {3}, Device::CPU);
+
+    // Structure stream with references, tensors collected out of line
+    CollectingSink sink;
+    std::stringstream structure;
+    attach_tensor_sink(structure, &sink);
+    const int32_t marker = 1234;
+    structure.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
+    structure << first << second;
+    attach_tensor_sink(structure, nullptr);
+    ASSERT_EQ(sink.tensors.size(), 2u);
+    EXPECT_LT(structure.str().size(), first.bytes());
+
+    const auto path = write_archive("refs.lfta", {{"0", sink.tensors[0]}, {"1", sink.tensors[1]}}, false);
+    auto archive = TensorArchive::open(path);
+    ASSERT_TRUE(archive.has_value()) << archive.error();
+
+    attach_tensor_source(structure, archive->get());
+    int32_t read_marker = 0;
+    structure.read(reinterpret_cast<char*>(&read_marker), sizeof(read_marker));
+    Tensor loaded_first, loaded_second;
+    structure >> loaded_first >> loaded_second;
+    EXPECT_EQ(read_marker, marker);
+    EXPECT_EQ(loaded_first.to_vector(), first.to_vector());
+    EXPECT_EQ(loaded_second.shape(), second.shape());
+    EXPECT_EQ(loaded_second.to_vector_int(), second.to_vector_int());
+}
+
+TEST_F(TensorArchiveTest, InlineRecordsStillReadWithSourceAttached) {
+    const auto t = Tensor::randn({32}, Device::CPU);
+    std::stringstream ss;
+    ss << t;
+
+    const auto path = write_archive("unused.lfta", {}, false);
+    auto archive = TensorArchive::open(path);
+    ASSERT_TRUE(archive.has_value()) << archive.error();
+    attach_tensor_source(ss, archive->get());
+
+    Tensor loaded;
+    ss >> loaded;
+    EXPECT_EQ(loaded.to_vector(), t.to_vector());
+}
+
+TEST_F(TensorArchiveTest, ReferenceWithoutSourceThrows) {
+    CollectingSink sink;
+    std::stringstream ss;
+    attach_tensor_sink(ss, &sink);
+    ss << Tensor::randn({8}, Device::CPU);
+    attach_tensor_sink(ss, nullptr);
+
+    Tensor loaded;
+    EXPECT_THROW(ss >> loaded, std::runtime_error);
+}
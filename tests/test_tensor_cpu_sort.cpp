@@ -0,0 +1,218 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    // Long enough for the parallel radix and compaction paths
+    constexpr size_t LARGE = 300'000;
+
+    std::vector<float> make_floats(const size_t n, const uint32_t seed, const bool ties) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<float> dist(0.0f, 1.0f);
+        std::vector<float> v(n);
+        for (auto& x : v)
+            x = ties ? std::round(dist(gen) * 3.0f) : dist(gen);
+        return v;
+    }
+
+    Tensor make_int64(const std::vector<int64_t>& values, const TensorShape& shape) {
+        auto t = Tensor::empty(shape, Device::CPU, DataType::Int64);
+        std::copy(values.begin(), values.end(), t.ptr<int64_t>());
+        return t;
+    }
+
+    // Reference stable argsort of one row; NaN counts as the largest value
+    template <typename T>
+    std::vector<int64_t> reference_argsort(const T* row, const size_t len, const bool descending) {
+        const auto less = [](const T a, const T b) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (std::isnan(a))
+                    return false;
+                if (std::isnan(b))
+                    return true;
+            }
+            return a < b;
+        };
+        std::vector<int64_t> order(len);
+        std::iota(order.begin(), order.end(), int64_t{0});
+        std::stable_sort(order.begin(), order.end(), [&](const int64_t a, const int64_t b) {
+            return descending ? less(row[b], row[a]) : less(row[a], row[b]);
+        });
+        return order;
+    }
+
+} // namespace
+
+TEST(TensorCpuSortTest, FloatSortMatchesStableSort) {
+    for (const size_t n : {size_t{1}, size_t{100}, size_t{5000}, LARGE}) {
+        for (const bool ties : {false, true}) {
+            auto v = make_floats(n, static_cast<uint32_t>(n), ties);
+            if (n > 10) {
+                v[1] = std::numeric_limits<float>::quiet_NaN();
+                v[2] = -0.0f;
+                v[3] = 0.0f;
+                v[4] = -std::numeric_limits<float>::infinity();
+            }
+            const auto t = Tensor::from_vector(v, {n}, Device::CPU);
+
+            for (const bool descending : {false, true}) {
+                const auto [values, indices] = t.sort(0, descending);
+                const auto vals = values.to_vector();
+                const auto idx = indices.to_vector_int64();
+                const auto expected = reference_argsort(v.data(), n, descending);
+                ASSERT_EQ(idx, expected) << "n=" << n << " descending=" << descending;
+                for (size_t i = 0; i < n; ++i) {
+                    if (std::isnan(v[expected[i]])) {
+                        EXPECT_TRUE(std::isnan(vals[i]));
+                    } else {
+                        ASSERT_EQ(vals[i], v[expected[i]]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(TensorCpuSortTest, IntegerSortMatchesStableSort) {
+    std::mt19937_64 gen(3);
+    for (const size_t n : {size_t{100}, LARGE}) {
+        std::vector<int> v32(n);
+        std::vector<int64_t> v64(n);
+        for (size_t i = 0; i < n; ++i) {
+            v32[i] = static_cast<int>(gen() % 2001) - 1000;
+            v64[i] = static_cast<int64_t>(gen());
+        }
+        const auto t32 = Tensor::from_vector(v32, {n}, Device::CPU);
+        const auto t64 = make_int64(v64, {n});
+
+        for (const bool descending : {false, true}) {
+            const auto [values32, indices32] = t32.sort(0, descending);
+            EXPECT_EQ(values32.dtype(), DataType::Int32);
+            EXPECT_EQ(indices32.to_vector_int64(), reference_argsort(v32.data(), n, descending));
+
+            const auto [values64, indices64] = t64.sort(0, descending);
+            const auto expected = reference_argsort(v64.data(), n, descending);
+            ASSERT_EQ(indices64.to_vector_int64(), expected);
+            const auto sorted64 = values64.to_vector_int64();
+            for (size_t i = 0; i < n; ++i)
+                ASSERT_EQ(sorted64[i], v64[expected[i]]);
+        }
+    }
+}
+
+TEST(TensorCpuSortTest, SortsAlongAnyDimension) {
+    const size_t a = 7, b = 300, c = 5;
+    const auto v = make_floats(a * b * c, 11, /*ties=*/true);
+    const auto t = Tensor::from_vector(v, {a, b, c}, Device::CPU);
+
+    const auto [values, indices] = t.sort(1);
+    ASSERT_EQ(values.shape(), t.shape());
+    const auto vals = values.to_vector();
+    const auto idx = indices.to_vector_int64();
+    for (size_t i = 0; i < a; ++i) {
+        for (size_t k = 0; k < c; ++k) {
+            std::vector<float> column(b);
+            for (size_t j = 0; j < b; ++j)
+                column[j] = v[(i * b + j) * c + k];
+            const auto expected = reference_argsort(column.data(), b, false);
+            for (size_t j = 0; j < b; ++j) {
+                ASSERT_EQ(idx[(i * b + j) * c + k], expected[j]);
+                ASSERT_EQ(vals[(i * b + j) * c + k], column[expected[j]]);
+            }
+        }
+    }
+    EXPECT_EQ(t.argsort(1).to_vector_int64(), idx);
+}
+
+TEST(TensorCpuSortTest, ArgsortMatchesSortIndices) {
+    const auto v = make_floats(LARGE, 5, /*ties=*/true);
+    const auto t = Tensor::from_vector(v, {LARGE}, Device::CPU);
+    const auto indices = t.argsort(0, /*descending=*/true);
+    EXPECT_EQ(indices.dtype(), DataType::Int64);
+    EXPECT_EQ(indices.to_vector_int64(), t.sort(0, true).second.to_vector_int64());
+}
+
+TEST(TensorCpuSortTest, UniqueWithInverseAndCounts) {
+    for (const size_t n : {size_t{1}, size_t{1000}, LARGE}) {
+        auto v = make_floats(n, 13, /*ties=*/true);
+        const auto t = Tensor::from_vector(v, {n}, Device::CPU);
+
+        auto expected = v;
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+        EXPECT_EQ(t.unique().to_vector(), expected);
+
+        const auto [values, inverse, counts] = t.unique_with_inverse_counts();
+        const auto vals = values.to_vector();
+        const auto inv = inverse.to_vector_int64();
+        const auto cnt = counts.to_vector_int64();
+        ASSERT_EQ(vals, expected);
+        ASSERT_EQ(cnt.size(), expected.size());
+        for (size_t i = 0; i < n; ++i)
+            ASSERT_EQ(vals[inv[i]], v[i]);
+        for (size_t j = 0; j < expected.size(); ++j)
+            ASSERT_EQ(cnt[j], std::count(v.begin(), v.end(), expected[j]));
+    }
+}
+
+TEST(TensorCpuSortTest, UniqueKeepsInverseShape) {
+    const auto t = Tensor::from_vector({3, 1, 3, 2, 1, 3}, {2, 3}, Device::CPU);
+    const auto [values, inverse, counts] = t.unique_with_inverse_counts();
+    EXPECT_EQ(values.to_vector_int(), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(inverse.shape(), t.shape());
+    EXPECT_EQ(inverse.to_vector_int64(), (std::vector<int64_t>{2, 0, 2, 1, 0, 2}));
+    EXPECT_EQ(counts.to_vector_int64(), (std::vector<int64_t>{2, 1, 3}));
+}
+
+TEST(TensorCpuSortTest, ParallelNonzeroAndMaskedSelectKeepOrder) {
+    const size_t rows = LARGE / 4, cols = 4;
+    const auto v = make_floats(rows * cols, 17, /*ties=*/true);
+    const auto t = Tensor::from_vector(v, {rows * cols}, Device::CPU);
+    const auto mask = t > 0.0f;
+
+    std::vector<float> expected_values;
+    std::vector<int64_t> expected_indices;
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (v[i] > 0.0f) {
+            expected_values.push_back(v[i]);
+            expected_indices.push_back(static_cast<int64_t>(i));
+        }
+    }
+
+    EXPECT_EQ(t.masked_select(mask).to_vector(), expected_values);
+    EXPECT_EQ(mask.nonzero().to_vector_int64(), expected_indices);
+
+    // Multi-dimensional nonzero returns one coordinate row per element
+    const auto coords = mask.reshape({static_cast<int>(rows), static_cast<int>(cols)}).nonzero();
+    ASSERT_EQ(coords.shape(), TensorShape({expected_indices.size(), size_t{2}}));
+    const auto c = coords.to_vector_int64();
+    for (size_t k = 0; k < expected_indices.size(); ++k) {
+        ASSERT_EQ(c[k * 2 + 0], expected_indices[k] / static_cast<int64_t>(cols));
+        ASSERT_EQ(c[k * 2 + 1], expected_indices[k] % static_cast<int64_t>(cols));
+    }
+}
+
+TEST(TensorCpuSortTest, ParallelIndexSelectMatchesGather) {
+    const size_t n = LARGE / 3;
+    const auto v = make_floats(n * 3, 19, /*ties=*/false);
+    const auto t = Tensor::from_vector(v, {n, 3}, Device::CPU);
+    const auto order = t.slice(1, 0, 1).squeeze(1).argsort();
+
+    const auto selected = t.index_select(0, order).to_vector();
+    const auto idx = order.to_vector_int64();
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t d = 0; d < 3; ++d)
+            ASSERT_EQ(selected[i * 3 + d], v[idx[i] * 3 + d]);
+    }
+}
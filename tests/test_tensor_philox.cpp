@@ -0,0 +1,156 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include "core/tensor/internal/philox.hpp"
+#include <cmath>
+#include <cstring>
+#include <cuda_runtime.h>
+#include <functional>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    // Odd and not a multiple of four, and long enough to split across threads
+    constexpr size_t N = 1'000'003;
+
+    bool has_cuda() {
+        int count = 0;
+        return cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+    }
+
+    // Runs make(device) after the same seed on CPU and CUDA and expects identical bytes
+    void expect_same_stream(const std::function<Tensor(Device)>& make, const char* what) {
+        Tensor::manual_seed(2024);
+        const Tensor cpu = make(Device::CPU);
+        Tensor::manual_seed(2024);
+        const Tensor cuda = make(Device::CUDA).cpu();
+
+        ASSERT_TRUE(cpu.is_valid() && cuda.is_valid()) << what;
+        ASSERT_EQ(cpu.dtype(), cuda.dtype()) << what;
+        ASSERT_EQ(cpu.shape(), cuda.shape()) << what;
+        EXPECT_EQ(std::memcmp(cpu.data_ptr(), cuda.data_ptr(), cpu.bytes()), 0)
+            << what << ": CPU and CUDA streams differ";
+    }
+
+    class TensorPhiloxDeviceTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            if (!has_cuda())
+                GTEST_SKIP() << "No CUDA devices available";
+        }
+    };
+
+} // namespace
+
+TEST(TensorPhiloxTest, KnownAnswerVectors) {
+    // Random123 kat_vectors for philox4x32-10
+    const auto b0 = philox::philox4x32_10({{0u, 0u, 0u, 0u}}, 0u, 0u);
+    EXPECT_EQ(b0.x[0], 0x6627E8D5u);
+    EXPECT_EQ(b0.x[1], 0xE169C58Du);
+    EXPECT_EQ(b0.x[2], 0xBC57AC4Cu);
+    EXPECT_EQ(b0.x[3], 0x9B00DBD8u);
+
+    const auto b1 = philox::philox4x32_10({{~0u, ~0u, ~0u, ~0u}}, ~0u, ~0u);
+    EXPECT_EQ(b1.x[0], 0x408F276Du);
+    EXPECT_EQ(b1.x[1], 0x41C83B0Eu);
+    EXPECT_EQ(b1.x[2], 0xA20BC7C6u);
+    EXPECT_EQ(b1.x[3], 0x6D5451FDu);
+
+    const auto b2 = philox::philox4x32_10({{0x243F6A88u, 0x85A308D3u, 0x13198A2Eu, 0x03707344u}},
+                                          0xA4093822u, 0x299F31D0u);
+    EXPECT_EQ(b2.x[0], 0xD16CFE09u);
+    EXPECT_EQ(b2.x[1], 0x94FDCCEBu);
+    EXPECT_EQ(b2.x[2], 0x5001E420u);
+    EXPECT_EQ(b2.x[3], 0x24126EA1u);
+}
+
+TEST(TensorPhiloxTest, CpuRandReadsSerialStream) {
+    // The first op after seeding reads offset 0; rand keeps the top 24 bits of each word
+    Tensor::manual_seed(7);
+    const auto values = Tensor::rand({N}, Device::CPU).to_vector();
+    for (size_t i = 0; i < N; ++i) {
+        ASSERT_EQ(static_cast<uint32_t>(values[i] * 16777216.0f), philox::word(7, 0, i) >> 8) << "i=" << i;
+    }
+}
+
+TEST(TensorPhiloxTest, EachOpTakesTheNextOffset) {
+    Tensor::manual_seed(11);
+    const auto first = Tensor::rand({64}, Device::CPU).to_vector();
+    const auto second = Tensor::rand({64}, Device::CPU).to_vector();
+    EXPECT_NE(first, second);
+
+    Tensor::manual_seed(11);
+    EXPECT_EQ(Tensor::rand({64}, Device::CPU).to_vector(), first);
+    EXPECT_EQ(Tensor::rand({64}, Device::CPU).to_vector(), second);
+}
+
+TEST(TensorPhiloxTest, CpuNormalMoments) {
+    Tensor::manual_seed(3);
+    const auto values = Tensor::normal({N}, 2.0f, 3.0f, Device::CPU).to_vector();
+    double sum = 0.0, sq = 0.0;
+    for (const float v : values) {
+        sum += v;
+        sq += static_cast<double>(v) * v;
+    }
+    const double mean = sum / N;
+    EXPECT_NEAR(mean, 2.0, 0.02);
+    EXPECT_NEAR(std::sqrt(sq / N - mean * mean), 3.0, 0.02);
+}
+
+TEST_F(TensorPhiloxDeviceTest, UniformMatchesBitwise) {
+    expect_same_stream([](const Device d) { return Tensor::rand({N}, d); }, "rand");
+    expect_same_stream([](const Device d) { return Tensor::uniform({N}, -3.5f, 7.25f, d); }, "uniform");
+    expect_same_stream([](const Device d) { return Tensor::empty({N}, d).uniform_(-1.0f, 1.0f); }, "uniform_");
+}
+
+TEST_F(TensorPhiloxDeviceTest, NormalMatchesBitwise) {
+    expect_same_stream([](const Device d) { return Tensor::randn({N}, d); }, "randn");
+    expect_same_stream([](const Device d) { return Tensor::normal({N}, 0.5f, 0.01f, d); }, "normal");
+    // Odd sizes used to overrun the buffer on CUDA
+    expect_same_stream([](const Device d) { return Tensor::empty({54275, 3}, d).normal_(0.0f, 1.0f); }, "normal_");
+}
+
+TEST_F(TensorPhiloxDeviceTest, DiscreteMatchesBitwise) {
+    expect_same_stream([](const Device d) { return Tensor::randint({N}, -5, 1000, d, DataType::Int32); },
+                       "randint int32");
+    expect_same_stream([](const Device d) { return Tensor::randint({N}, 0, 10, d, DataType::Float32); },
+                       "randint float32");
+    expect_same_stream([](const Device d) { return Tensor::randint({N}, 0, 256, d, DataType::UInt8); },
+                       "randint uint8");
+    expect_same_stream([](const Device d) { return Tensor::bernoulli({N}, 0.3f, d); }, "bernoulli");
+}
+
+TEST_F(TensorPhiloxDeviceTest, MultinomialMatchesBitwise) {
+    // Opacity-like weights with zeros, spanning several CDF blocks
+    std::vector<float> w(200'000);
+    for (size_t i = 0; i < w.size(); ++i)
+        w[i] = (i % 17 == 0) ? 0.0f : static_cast<float>((i * 2654435761u) % 1000) / 1000.0f;
+
+    expect_same_stream([&](const Device d) { return Tensor::multinomial(Tensor::from_vector(w, {w.size()}, d), 50'000, true); },
+                       "multinomial with replacement");
+    expect_same_stream([&](const Device d) { return Tensor::multinomial(Tensor::from_vector(w, {w.size()}, d), 5'000, false); },
+                       "multinomial without replacement");
+}
+
+TEST_F(TensorPhiloxDeviceTest, InterleavedOpsReplayOnCpu) {
+    // An MCMC-like step sequence replays on CPU from the same seed
+    const auto step = [](const Device d) {
+        auto noise = Tensor::randn({9999, 3}, d);
+        auto picks = Tensor::multinomial(Tensor::rand({4096}, d), 512, true);
+        auto jitter = Tensor::uniform({777}, -1.0f, 1.0f, d);
+        return std::vector<Tensor>{noise.cpu(), picks.cpu(), jitter.cpu()};
+    };
+
+    Tensor::manual_seed(99);
+    const auto cpu = step(Device::CPU);
+    Tensor::manual_seed(99);
+    const auto cuda = step(Device::CUDA);
+    for (size_t k = 0; k < cpu.size(); ++k) {
+        ASSERT_EQ(cpu[k].bytes(), cuda[k].bytes());
+        EXPECT_EQ(std::memcmp(cpu[k].data_ptr(), cuda[k].data_ptr(), cpu[k].bytes()), 0) << "output " << k;
+    }
+}
@@ -0,0 +1,232 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace lfs::core;
+
+namespace {
+
+    // Normal values, optionally rounded so that many ties land on the selected ranks
+    std::vector<float> make_values(const size_t n, const uint32_t seed, const bool ties) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<float> dist(0.0f, 1.0f);
+        std::vector<float> v(n);
+        for (auto& x : v)
+            x = ties ? std::round(dist(gen) * 4.0f) : dist(gen);
+        return v;
+    }
+
+    std::vector<float> sorted_row(const std::vector<float>& v, const size_t row, const size_t len) {
+        std::vector<float> s(v.begin() + row * len, v.begin() + (row + 1) * len);
+        std::sort(s.begin(), s.end());
+        return s;
+    }
+
+    float reference_quantile(const std::vector<float>& sorted, const double q) {
+        const double pos = q * static_cast<double>(sorted.size() - 1);
+        const auto lo = static_cast<size_t>(std::floor(pos));
+        const size_t hi = std::min(lo + 1, sorted.size() - 1);
+        return static_cast<float>(sorted[lo] + (static_cast<double>(sorted[hi]) - sorted[lo]) * (pos - lo));
+    }
+
+    struct SelectCase {
+        size_t rows;
+        size_t len;
+        bool ties;
+    };
+
+    // Single long rows take the split-row paths, many short rows the per-row paths
+    const std::vector<SelectCase> CASES = {
+        {1, 1, false},
+        {1, 1000, false},
+        {1, 1000, true},
+        {1, 300000, false},
+        {1, 300000, true},
+        {64, 257, false},
+        {64, 257, true},
+    };
+
+} // namespace
+
+class TensorSelectTest : public ::testing::TestWithParam<Device> {};
+
+TEST_P(TensorSelectTest, TopkMatchesFullSort) {
+    const Device device = GetParam();
+    for (const auto& c : CASES) {
+        const auto v = make_values(c.rows * c.len, static_cast<uint32_t>(c.len), c.ties);
+        const auto t = Tensor::from_vector(v, {c.rows, c.len}, device);
+        const size_t k = std::max<size_t>(1, c.len / 3);
+
+        for (const bool largest : {true, false}) {
+            auto [values, indices] = t.topk(k, -1, largest, /*sorted=*/true);
+            ASSERT_TRUE(values.is_valid());
+            ASSERT_EQ(values.shape(), TensorShape({c.rows, k}));
+            ASSERT_EQ(indices.dtype(), DataType::Int64);
+            const auto vals = values.cpu().to_vector();
+            const auto idx = indices.cpu().to_vector_int64();
+
+            for (size_t r = 0; r < c.rows; ++r) {
+                const auto s = sorted_row(v, r, c.len);
+                for (size_t i = 0; i < k; ++i) {
+                    const float expected = largest ? s[c.len - 1 - i] : s[i];
+                    ASSERT_EQ(vals[r * k + i], expected) << "len=" << c.len << " row=" << r << " i=" << i;
+                    ASSERT_EQ(v[r * c.len + idx[r * k + i]], expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_P(TensorSelectTest, UnsortedTopkSelectsDistinctIndices) {
+    const Device device = GetParam();
+    const size_t n = 300000;
+    const size_t k = 1234;
+    const auto v = make_values(n, 7, /*ties=*/true);
+    const auto t = Tensor::from_vector(v, {n}, device);
+
+    auto [values, indices] = t.topk(k, 0, /*largest=*/false, /*sorted=*/false);
+    auto idx = indices.cpu().to_vector_int64();
+    const auto vals = values.cpu().to_vector();
+
+    std::vector<float> picked(k);
+    for (size_t i = 0; i < k; ++i) {
+        picked[i] = v[idx[i]];
+        EXPECT_EQ(vals[i], picked[i]);
+    }
+    std::sort(picked.begin(), picked.end());
+    const auto s = sorted_row(v, 0, n);
+    EXPECT_TRUE(std::equal(picked.begin(), picked.end(), s.begin()));
+
+    std::sort(idx.begin(), idx.end());
+    EXPECT_EQ(std::adjacent_find(idx.begin(), idx.end()), idx.end());
+}
+
+TEST_P(TensorSelectTest, KthvalueMatchesFullSort) {
+    const Device device = GetParam();
+    for (const auto& c : CASES) {
+        const auto v = make_values(c.rows * c.len, static_cast<uint32_t>(c.len) + 1, c.ties);
+        const auto t = Tensor::from_vector(v, {c.rows, c.len}, device);
+
+        for (const size_t k : {size_t{1}, c.len / 2 + 1, c.len}) {
+            auto [values, indices] = t.kthvalue(k, 1);
+            ASSERT_EQ(values.shape(), TensorShape({c.rows}));
+            const auto vals = values.cpu().to_vector();
+            const auto idx = indices.cpu().to_vector_int64();
+            for (size_t r = 0; r < c.rows; ++r) {
+                const float expected = sorted_row(v, r, c.len)[k - 1];
+                ASSERT_EQ(vals[r], expected) << "len=" << c.len << " k=" << k;
+                ASSERT_EQ(v[r * c.len + idx[r]], expected);
+            }
+        }
+    }
+}
+
+TEST_P(TensorSelectTest, QuantileMatchesFullSort) {
+    const Device device = GetParam();
+    for (const auto& c : CASES) {
+        const auto v = make_values(c.rows * c.len, static_cast<uint32_t>(c.len) + 2, c.ties);
+        const auto t = Tensor::from_vector(v, {c.rows, c.len}, device);
+
+        for (const float q : {0.0f, 0.01f, 0.5f, 0.77f, 1.0f}) {
+            const auto out = t.quantile(q, -1, /*keepdim=*/true);
+            ASSERT_EQ(out.shape(), TensorShape({c.rows, 1}));
+            const auto vals = out.cpu().to_vector();
+            for (size_t r = 0; r < c.rows; ++r) {
+                const float expected = reference_quantile(sorted_row(v, r, c.len), q);
+                ASSERT_NEAR(vals[r], expected, 1e-5f * (1.0f + std::abs(expected)))
+                    << "len=" << c.len << " q=" << q;
+            }
+        }
+    }
+}
+
+TEST_P(TensorSelectTest, ArgpartitionSplitsAroundKth) {
+    const Device device = GetParam();
+    for (const auto& c : CASES) {
+        const auto v = make_values(c.rows * c.len, static_cast<uint32_t>(c.len) + 3, c.ties);
+        const auto t = Tensor::from_vector(v, {c.rows, c.len}, device);
+        const size_t kth = c.len / 4;
+
+        const auto indices = t.argpartition(kth);
+        ASSERT_EQ(indices.shape(), t.shape());
+        const auto idx = indices.cpu().to_vector_int64();
+
+        for (size_t r = 0; r < c.rows; ++r) {
+            const int64_t* const row = idx.data() + r * c.len;
+            const float* const src = v.data() + r * c.len;
+            const float pivot = src[row[kth]];
+            ASSERT_EQ(pivot, sorted_row(v, r, c.len)[kth]);
+            for (size_t i = 0; i < kth; ++i)
+                ASSERT_LE(src[row[i]], pivot);
+            for (size_t i = kth + 1; i < c.len; ++i)
+                ASSERT_GE(src[row[i]], pivot);
+
+            std::vector<int64_t> perm(row, row + c.len);
+            std::sort(perm.begin(), perm.end());
+            for (size_t i = 0; i < c.len; ++i)
+                ASSERT_EQ(perm[i], static_cast<int64_t>(i));
+        }
+    }
+}
+
+TEST_P(TensorSelectTest, SelectsAlongLeadingDimension) {
+    const Device device = GetParam();
+    const size_t n = 1000;
+    const auto v = make_values(n * 3, 11, /*ties=*/false);
+    const auto t = Tensor::from_vector(v, {n, 3}, device);
+
+    const auto [values, indices] = t.kthvalue(n / 10, 0);
+    ASSERT_EQ(values.shape(), TensorShape({3}));
+    const auto vals = values.cpu().to_vector();
+    const auto median = t.quantile(0.5f, 0).cpu().to_vector();
+    for (size_t col = 0; col < 3; ++col) {
+        std::vector<float> column(n);
+        for (size_t i = 0; i < n; ++i)
+            column[i] = v[i * 3 + col];
+        std::sort(column.begin(), column.end());
+        EXPECT_EQ(vals[col], column[n / 10 - 1]);
+        EXPECT_NEAR(median[col], reference_quantile(column, 0.5), 1e-6f);
+    }
+
+    const auto [top, top_idx] = t.topk(5, 0);
+    EXPECT_EQ(top.shape(), TensorShape({5, 3}));
+}
+
+TEST_P(TensorSelectTest, HandlesInfinitiesAndSignedZero) {
+    const Device device = GetParam();
+    const float inf = std::numeric_limits<float>::infinity();
+    const std::vector<float> v = {3.0f, -inf, 0.0f, -0.0f, inf, -2.5f, 1e-30f, -1e-30f};
+    const auto t = Tensor::from_vector(v, {v.size()}, device);
+
+    const auto vals = t.topk(v.size(), 0, /*largest=*/false).first.cpu().to_vector();
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(vals.size(), expected.size());
+    EXPECT_EQ(vals.front(), -inf);
+    EXPECT_EQ(vals.back(), inf);
+    for (size_t i = 0; i < vals.size(); ++i)
+        EXPECT_EQ(vals[i], expected[i]);
+    EXPECT_FLOAT_EQ(t.quantile_scalar(0.0f), -inf);
+}
+
+TEST_P(TensorSelectTest, RejectsInvalidArguments) {
+    const Device device = GetParam();
+    const auto t = Tensor::from_vector({1.0f, 2.0f, 3.0f}, {3}, device);
+    EXPECT_FALSE(t.topk(4).first.is_valid());
+    EXPECT_FALSE(t.kthvalue(0).first.is_valid());
+    EXPECT_FALSE(t.kthvalue(4).first.is_valid());
+    EXPECT_FALSE(t.quantile(1.5f).is_valid());
+    EXPECT_FALSE(t.argpartition(3).is_valid());
+    EXPECT_FALSE(t.to(DataType::Int32).topk(1).first.is_valid());
+}
+
+INSTANTIATE_TEST_SUITE_P(Devices, TensorSelectTest,
+                         ::testing::Values(Device::CPU, Device::CUDA),
+                         [](const auto& info) { return info.param == Device::CPU ? "CPU" : "CUDA"; });
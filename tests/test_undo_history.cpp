@@ -0,0 +1,305 @@
+/* SPDX-FileCopyrightText: 2025 LichtFeld Studio Authors
+ * SPDX-License-Identifier: GPL-3.0-or-later */
+
+#include "core/tensor.hpp"
+#include "visualizer/command/command_history.hpp"
+#include "visualizer/command/commands/crop_command.hpp"
+#include "visualizer/command/commands/mirror_command.hpp"
+#include "visualizer/command/commands/saturation_command.hpp"
+#include "visualizer/command/commands/selection_command.hpp"
+#include "visualizer/command/tensor_snapshot.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace lfs::core;
+using namespace lfs::vis::command;
+
+namespace {
+
+    constexpr size_t NUM_SPLATS = 5'000'000;
+    constexpr size_t TOUCHED_ROWS = 20'000; // A brush stroke or small selection
+
+    // Mask with a few contiguous true ranges, like a crop of spatially sorted data
+    Tensor range_mask(size_t n, DataType dtype, std::initializer_list<std::pair<size_t, size_t>> ranges) {
+        auto mask = Tensor::zeros({n}, Device::CPU, dtype);
+        uint8_t* const p = static_cast<uint8_t*>(mask.data_ptr());
+        for (const auto& [begin, end] : ranges) {
+            std::fill(p + begin, p + end, uint8_t{1});
+        }
+        return mask;
+    }
+
+    // Scattered rows, as a brush or screen-space selection produces
+    std::vector<int> scattered_rows(size_t n, size_t count, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        std::vector<uint8_t> taken(n, 0);
+        std::vector<int> rows;
+        while (rows.size() < count) {
+            const size_t i = pick(gen);
+            if (!taken[i]) {
+                taken[i] = 1;
+                rows.push_back(static_cast<int>(i));
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    std::vector<uint8_t> bytes_of(const Tensor& t) {
+        const auto host = t.cpu().contiguous();
+        const auto* p = static_cast<const uint8_t*>(host.data_ptr());
+        return {p, p + host.bytes()};
+    }
+
+    class FakeCommand : public Command {
+    public:
+        FakeCommand(size_t device_bytes, size_t host_bytes) : usage_{device_bytes, host_bytes} {}
+
+        void undo() override {}
+        void redo() override {}
+        std::string getName() const override { return "Fake"; }
+        MemoryUsage memoryUsage() const override { return usage_; }
+
+        void spillToHost() override {
+            usage_.host_bytes += usage_.device_bytes;
+            usage_.device_bytes = 0;
+            spilled_ = true;
+        }
+
+        bool spilled_ = false;
+
+    private:
+        MemoryUsage usage_;
+    };
+
+    // Records which entry each redo replays
+    class RecordingCommand : public FakeCommand {
+    public:
+        RecordingCommand(int id, size_t host_bytes, std::vector<int>& redone)
+            : FakeCommand(0, host_bytes),
+              id_(id),
+              redone_(redone) {}
+
+        void redo() override { redone_.push_back(id_); }
+
+    private:
+        int id_;
+        std::vector<int>& redone_;
+    };
+
+} // namespace
+
+TEST(MaskSnapshotTest, RunsRoundTrip) {
+    const auto mask = range_mask(NUM_SPLATS, DataType::Bool, {{1000, 250'000}, {3'000'000, 3'100'000}});
+    const auto snapshot = MaskSnapshot::encode(mask);
+
+    ASSERT_TRUE(snapshot.valid());
+    EXPECT_LT(snapshot.memory_usage().total(), 64u);
+    const auto decoded = snapshot.decode();
+    EXPECT_EQ(decoded.dtype(), DataType::Bool);
+    EXPECT_EQ(decoded.device(), Device::CPU);
+    EXPECT_EQ(bytes_of(decoded), bytes_of(mask));
+}
+
+TEST(MaskSnapshotTest, NoisyMaskFallsBackToRawBytes) {
+    constexpr size_t N = 100'000;
+    auto mask = Tensor::zeros({N}, Device::CPU, DataType::UInt8);
+    std::mt19937 gen(1);
+    for (size_t i = 0; i < N; ++i) {
+        mask.ptr<uint8_t>()[i] = static_cast<uint8_t>(gen() % 3); // Selection group ids
+    }
+
+    const auto snapshot = MaskSnapshot::encode(mask);
+    EXPECT_LE(snapshot.memory_usage().total(), N);
+    EXPECT_EQ(bytes_of(snapshot.decode()), bytes_of(mask));
+}
+
+TEST(MaskSnapshotTest, DeltaStoresOnlyTheEdit) {
+    const auto base = range_mask(NUM_SPLATS, DataType::UInt8, {{0, 2'000'000}});
+    const auto edited = range_mask(NUM_SPLATS, DataType::UInt8, {{0, 2'000'000}, {4'000'000, 4'000'500}});
+
+    const auto delta = MaskSnapshot::encode_delta(edited, base);
+    ASSERT_TRUE(delta.is_delta());
+    EXPECT_LT(delta.memory_usage().total(), 64u);
+    EXPECT_EQ(bytes_of(delta.decode_delta(base)), bytes_of(edited));
+
+    // No base to diff against: full snapshot
+    const auto full = MaskSnapshot::encode_delta(edited, Tensor{});
+    EXPECT_FALSE(full.is_delta());
+    EXPECT_EQ(bytes_of(full.decode_delta(Tensor{})), bytes_of(edited));
+}
+
+TEST(RowDeltaTest, RestoresChangedRowsOnly) {
+    constexpr size_t N = 10'000;
+    auto before = Tensor::zeros({N, 1, 3}, Device::CPU, DataType::Float32);
+    for (size_t i = 0; i < N * 3; ++i) {
+        before.ptr<float>()[i] = static_cast<float>(i);
+    }
+    auto after = before.clone();
+    const auto rows = scattered_rows(N, 100, 2);
+    for (const int r : rows) {
+        after.ptr<float>()[r * 3 + 1] += 0.5f;
+    }
+
+    const auto delta = RowDelta::capture(before, after);
+    ASSERT_EQ(delta.num_rows(), rows.size());
+    EXPECT_EQ(delta.memory_usage().total(), rows.size() * (sizeof(int32_t) + 2 * 3 * sizeof(float)));
+
+    auto target = after.clone();
+    ASSERT_TRUE(delta.restore_before(target));
+    EXPECT_EQ(bytes_of(target), bytes_of(before));
+    ASSERT_TRUE(delta.restore_after(target));
+    EXPECT_EQ(bytes_of(target), bytes_of(after));
+
+    auto wrong_shape = Tensor::zeros({N + 1, 1, 3}, Device::CPU, DataType::Float32);
+    EXPECT_FALSE(delta.restore_before(wrong_shape));
+}
+
+TEST(RowDeltaTest, SpillMovesRowsToHost) {
+    constexpr size_t N = 4096;
+    const auto before = Tensor::zeros({N, 3}, Device::CUDA, DataType::Float32);
+    const auto after = Tensor::ones({N, 3}, Device::CUDA, DataType::Float32);
+
+    auto delta = RowDelta::capture(before, after);
+    const auto resident = delta.memory_usage();
+    EXPECT_GT(resident.device_bytes, 0u);
+
+    delta.spill_to_host();
+    const auto spilled = delta.memory_usage();
+    EXPECT_EQ(spilled.device_bytes, 0u);
+    EXPECT_EQ(spilled.host_bytes, resident.total());
+
+    auto target = after.clone();
+    ASSERT_TRUE(delta.restore_before(target));
+    EXPECT_EQ(target.device(), Device::CUDA);
+    EXPECT_EQ(bytes_of(target), bytes_of(before));
+}
+
+TEST(UndoMemoryTest, ResidentBytesPerCommand) {
+    const auto rows = scattered_rows(NUM_SPLATS, TOUCHED_ROWS, 3);
+    auto touched = Tensor::zeros({NUM_SPLATS}, Device::CPU, DataType::UInt8);
+    for (const int r : rows) {
+        touched.ptr<uint8_t>()[r] = 1;
+    }
+
+    // Crop: deletion mask grows by one contiguous block
+    const auto old_deleted = range_mask(NUM_SPLATS, DataType::Bool, {{0, 100'000}});
+    const auto new_deleted = range_mask(NUM_SPLATS, DataType::Bool, {{0, 100'000}, {2'500'000, 3'500'000}});
+    const CropCommand crop("node", old_deleted, new_deleted);
+    const size_t crop_full = old_deleted.bytes() + new_deleted.bytes();
+
+    // Selection: scattered brush hits added to an empty selection
+    const SelectionCommand selection(nullptr, nullptr, std::make_shared<Tensor>(touched.clone()));
+    const size_t selection_full = touched.bytes();
+
+    // Saturation: SH0 changed on the touched rows
+    auto sh0_before = Tensor::zeros({NUM_SPLATS, 1, 3}, Device::CPU, DataType::Float32);
+    auto sh0_after = sh0_before.clone();
+    for (const int r : rows) {
+        sh0_after.ptr<float>()[r * 3] = 1.0f;
+    }
+    const SaturationCommand saturation(nullptr, "node", std::make_shared<Tensor>(sh0_before),
+                                       std::make_shared<Tensor>(sh0_after));
+    const size_t saturation_full = sh0_before.bytes() + sh0_after.bytes();
+
+    // Mirror: old means/rotation/shN of the touched rows
+    auto means = std::make_shared<Tensor>(Tensor::zeros({NUM_SPLATS, 3}, Device::CPU, DataType::Float32));
+    auto rotation = std::make_shared<Tensor>(Tensor::zeros({NUM_SPLATS, 4}, Device::CPU, DataType::Float32));
+    auto shN = std::make_shared<Tensor>(Tensor::zeros({NUM_SPLATS, 15, 3}, Device::CPU, DataType::Float32));
+    const MirrorCommand mirror(nullptr, "node", MirrorAxis::X, glm::vec3(0.0f),
+                               std::make_shared<Tensor>(touched.clone()), means, rotation, shN);
+    const size_t mirror_full = touched.bytes() + means->bytes() + rotation->bytes() + shN->bytes();
+
+    const size_t crop_bytes = crop.memoryUsage().total();
+    const size_t selection_bytes = selection.memoryUsage().total();
+    const size_t saturation_bytes = saturation.memoryUsage().total();
+    const size_t mirror_bytes = mirror.memoryUsage().total();
+
+    std::cout << "\n=== Undo state per command, " << NUM_SPLATS << " gaussians, "
+              << TOUCHED_ROWS << " touched ===\n"
+              << std::fixed << std::setprecision(1);
+    const auto report = [](const char* name, size_t bytes, size_t full) {
+        std::cout << "  " << std::setw(10) << name << " | " << std::setw(10) << bytes / 1024.0 << " KB | full copies "
+                  << std::setw(8) << full / (1024.0 * 1024.0) << " MB\n";
+    };
+    report("crop", crop_bytes, crop_full);
+    report("selection", selection_bytes, selection_full);
+    report("saturation", saturation_bytes, saturation_full);
+    report("mirror", mirror_bytes, mirror_full);
+
+    EXPECT_LT(crop_bytes, 1024u);
+    // Scattered hits cost at most one run per hit boundary
+    EXPECT_LE(selection_bytes, 2 * TOUCHED_ROWS * 5 + 64);
+    EXPECT_EQ(saturation_bytes, TOUCHED_ROWS * (sizeof(int32_t) + 2 * 3 * sizeof(float)));
+    EXPECT_LT(mirror_bytes, mirror_full / 20);
+}
+
+TEST(CommandHistoryTest, DropsOldestEntriesBeyondBudget) {
+    CommandHistory history;
+    history.setDeviceBudget(SIZE_MAX);
+    history.setMemoryBudget(1000);
+
+    for (int i = 0; i < 10; ++i) {
+        history.execute(std::make_unique<FakeCommand>(0, 300));
+    }
+    EXPECT_EQ(history.size(), 3u);
+    EXPECT_EQ(history.memoryUsage().total(), 900u);
+    EXPECT_TRUE(history.canUndo());
+
+    // An entry larger than the whole budget is still kept so it can be undone
+    history.execute(std::make_unique<FakeCommand>(0, 5000));
+    EXPECT_EQ(history.size(), 1u);
+    history.undo();
+    EXPECT_FALSE(history.canUndo());
+    EXPECT_TRUE(history.canRedo());
+}
+
+TEST(CommandHistoryTest, BudgetAfterUndoKeepsRedoOrder) {
+    CommandHistory history;
+    history.setDeviceBudget(SIZE_MAX);
+    history.setMemoryBudget(SIZE_MAX);
+
+    std::vector<int> redone;
+    for (int i = 0; i < 5; ++i) {
+        history.execute(std::make_unique<RecordingCommand>(i, 300, redone));
+    }
+    for (int i = 0; i < 4; ++i) {
+        history.undo();
+    }
+
+    // Only entry 0 is applied; the rest must trim from the redo tail, not the front
+    history.setMemoryBudget(1000);
+    EXPECT_EQ(history.size(), 3u);
+    EXPECT_LE(history.memoryUsage().total(), 1000u);
+    EXPECT_FALSE(history.canUndo());
+
+    while (history.canRedo()) {
+        history.redo();
+    }
+    EXPECT_EQ(redone, (std::vector<int>{1, 2, 3}));
+    EXPECT_TRUE(history.canUndo());
+}
+
+TEST(CommandHistoryTest, SpillsOldestBeforeDropping) {
+    CommandHistory history;
+    history.setMemoryBudget(SIZE_MAX);
+    history.setDeviceBudget(250);
+
+    std::vector<FakeCommand*> commands;
+    for (int i = 0; i < 5; ++i) {
+        auto cmd = std::make_unique<FakeCommand>(100, 0);
+        commands.push_back(cmd.get());
+        history.execute(std::move(cmd));
+    }
+
+    EXPECT_EQ(history.size(), 5u);
+    EXPECT_LE(history.memoryUsage().device_bytes, 250u);
+    EXPECT_EQ(history.memoryUsage().total(), 500u);
+    EXPECT_TRUE(commands[0]->spilled_);
+    EXPECT_FALSE(commands[4]->spilled_); // Newest stays resident
+}